@@ -57,6 +57,10 @@ typedef struct
                         * deficient.  -1 if not computed.  n if the matrix has
                         * full structural rank */
 
+    /* blob from klu_deserialize_symbolic that holds P, Q, R and Lnz, if the
+     * object was created from it without copying.  NULL otherwise. */
+    void *blob ;
+
 } klu_symbolic ;
 
 typedef struct          /* 64-bit version (otherwise same as above) */
@@ -65,6 +69,7 @@ typedef struct          /* 64-bit version (otherwise same as above) */
     double *Lnz ;
     int64_t n, nz, *P, *Q, *R, nzoff, nblocks, maxblock, ordering,
         do_btf, structural_rank ;
+    void *blob ;
 
 } klu_l_symbolic ;
 
@@ -110,6 +115,18 @@ typedef struct
     void *Offx ;        /* size nzoff, numerical values */
     int32_t nzoff ;
 
+    /* dense lower right submatrix of the LU factors of each block */
+    int32_t *Dstart ;       /* size nblocks.  Columns Dstart [b] to nk-1 of
+        * block b (of size nk) have dense L and U, and are refactorized with a
+        * dense kernel by klu_refactor.  Dstart [b] is nk if block b has no
+        * such submatrix.  L and U are stored in LUbx as usual, so the dense
+        * part needs no special handling elsewhere. */
+
+    /* blob from klu_deserialize_numeric that holds all the arrays above except
+     * LUbx and Work, if the object was created from it without copying.  NULL
+     * otherwise. */
+    void *blob ;
+
 } klu_numeric ;
 
 typedef struct          /* 64-bit version (otherwise same as above) */
@@ -126,6 +143,8 @@ typedef struct          /* 64-bit version (otherwise same as above) */
     int64_t *Offp, *Offi ;
     void *Offx ;
     int64_t nzoff ;
+    int64_t *Dstart ;
+    void *blob ;
 
 } klu_l_numeric ;
 
@@ -203,14 +222,48 @@ typedef struct klu_common_struct
     int32_t noffdiag ;      /* # of off-diagonal pivots, -1 if not computed */
 
     double flops ;      /* actual factorization flop count, from klu_flops */
-    double rcond ;      /* crude reciprocal condition est., from klu_rcond */
+    double rcond ;      /* crude reciprocal condition est., from klu_rcond
+                         * and klu_refactor */
     double condest ;    /* accurate condition est., from klu_condest */
-    double rgrowth ;    /* reciprocal pivot rgrowth, from klu_rgrowth */
+    double rgrowth ;    /* reciprocal pivot rgrowth, from klu_rgrowth, or
+                         * estimated by klu_refactor */
     double work ;       /* actual work done in BTF, in klu_analyze */
 
     size_t memusage ;   /* current memory usage, in bytes */
     size_t mempeak ;    /* peak memory usage, in bytes */
 
+    /* ---------------------------------------------------------------------- */
+    /* parameters (continued) */
+    /* ---------------------------------------------------------------------- */
+
+    int nthreads ;      /* number of threads used by klu_factor and
+        * klu_refactor to factorize the diagonal blocks of the BTF form in
+        * parallel, largest block first, by klu_analyze to order the blocks
+        * in parallel, and by klu_solve to solve for groups of right-hand
+        * sides in parallel.  1: sequential (the default).  If <= 0, the
+        * default number of OpenMP threads is used.  Ignored if KLU is
+        * compiled without OpenMP.  The results do not depend on the number
+        * of threads. */
+
+    void *cache ;       /* cache of Symbolic objects for klu_analyze, from
+        * klu_alloc_cache.  NULL (the default) if none. */
+
+    double repivot_tol ;    /* klu_refactor factorizes a block of the BTF
+        * form again with partial pivoting, as klu_factor does, if its
+        * estimate of the reciprocal pivot growth falls below repivot_tol, or
+        * if it has a zero pivot.  0: never (the default).  A value of about
+        * 1e-8 repivots only the blocks whose old pivots have become
+        * unstable.  Ignored for a Numeric object held in a blob from
+        * klu_deserialize_numeric. */
+
+    /* ---------------------------------------------------------------------- */
+    /* statistics (continued) */
+    /* ---------------------------------------------------------------------- */
+
+    int nrefine ;       /* # of refinement steps taken by klu_s_refine */
+    double berr ;       /* componentwise backward error, from klu_s_refine */
+    int nrepivot ;      /* # of blocks repivoted by klu_refactor */
+
 } klu_common ;
 
 typedef struct klu_l_common_struct /* 64-bit version (otherwise same as above)*/
@@ -225,6 +278,12 @@ typedef struct klu_l_common_struct /* 64-bit version (otherwise same as above)*/
     int64_t structural_rank, numerical_rank, singular_col, noffdiag ;
     double flops, rcond, condest, rgrowth, work ;
     size_t memusage, mempeak ;
+    int nthreads ;
+    void *cache ;
+    double repivot_tol ;
+    int nrefine ;
+    double berr ;
+    int nrepivot ;
 
 } klu_l_common ;
 
@@ -282,6 +341,38 @@ klu_l_symbolic *klu_l_analyze_given (int64_t, int64_t *, int64_t *, int64_t *,
     int64_t *, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_alloc_cache: creates a cache of Symbolic objects for klu_analyze */
+/* -------------------------------------------------------------------------- */
+
+/* klu_alloc_cache creates a cache that holds up to size results of
+ * klu_analyze, in Common->cache, replacing any cache already there.  When
+ * klu_analyze is given a matrix with the same pattern (the same n, Ap, and
+ * Ai, entry for entry) and the same Common->btf, ordering, maxwork,
+ * user_order, and user_data as a matrix analyzed earlier, it returns a copy
+ * of the earlier Symbolic object, without ordering the matrix again.  Each
+ * cached result keeps a copy of its pattern.  When the cache is full, the
+ * oldest result is replaced.  klu_analyze_given does not use the cache.
+ *
+ * The cache belongs to the Common object and must be freed with
+ * klu_free_cache before Common is discarded or passed to klu_defaults.  Like
+ * the rest of Common, it must not be used by more than one thread at a time.
+ * Returns TRUE if successful, or FALSE otherwise. */
+
+int klu_alloc_cache
+(
+    int32_t size,           /* max # of Symbolic objects in the cache */
+    klu_common *Common
+) ;
+
+int klu_l_alloc_cache (int64_t, klu_l_common *) ;
+
+/* klu_free_cache: frees Common->cache, if present */
+int klu_free_cache (klu_common *Common) ;
+
+int klu_l_free_cache (klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_factor:  factors a matrix using the klu_analyze results */
 /* -------------------------------------------------------------------------- */
@@ -319,6 +410,11 @@ klu_l_numeric *klu_zl_factor (int64_t *, int64_t *, double *,
 /* klu_solve: solves Ax=b using the Symbolic and Numeric objects */
 /* -------------------------------------------------------------------------- */
 
+/* If nrhs > 4, the right-hand sides are solved in groups of 8, 16, or 32 at a
+ * time, using n*32 entries of workspace per group that is allocated and freed
+ * by klu_solve.  If that workspace is not available, 4 columns are solved at
+ * a time in the workspace of the Numeric object instead. */
+
 int klu_solve
 (
     /* inputs, not modified */
@@ -352,6 +448,82 @@ int klu_zl_solve (klu_l_symbolic *, klu_l_numeric *,
     int64_t, int64_t, double *, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_solve_sparse: solves Ax=b for a sparse b */
+/* -------------------------------------------------------------------------- */
+
+/* Solves Ax=b where b is sparse, with bnz entries: b (Bi [k]) = Bx [k] for
+ * k = 0 to bnz-1 (duplicates are summed).  Only the blocks and the columns
+ * of L and U reachable from the entries of b are used.
+ *
+ * If Out is NULL, x is returned as a sparse vector with *xnz entries, in no
+ * particular order: x (Xi [k]) = Xx [k] for k = 0 to *xnz-1.  Xi and Xx must
+ * be of size n.  Otherwise, only the entries of x listed in Out [0..nout-1]
+ * are computed: Xx [k] = x (Out [k]) and *xnz = nout, and Xi (which may be
+ * NULL) is a copy of Out.  Only the blocks that these entries depend on are
+ * solved.  For the complex versions, Bx and Xx hold the real and imaginary
+ * parts of each entry, interleaved, as in klu_z_solve.
+ *
+ * The workspace Wi (of size 4*n + nblocks + 4*maxblock, from the Symbolic
+ * object) and W (of size n, or 2*n for the complex versions) is provided by
+ * the caller, and must be all zero before the first call.  Each call returns
+ * it in a state fit for the next call with the same Symbolic object, in time
+ * proportional to the number of entries of x, so that no O(n) work is done
+ * per call.  If Out is present, the first call takes O(n) time to keep the
+ * inverse of Q in Wi.  Wi must be cleared again before it is used with
+ * another Symbolic object.  The workspace is what makes concurrent calls
+ * with the same Numeric object safe: each thread needs its own.  There is no
+ * klu_tsolve_sparse: the transposed solve would need the rows of L and U. */
+
+int klu_solve_sparse        /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int32_t bnz,                /* number of entries in b */
+    int32_t Bi [ ],             /* size bnz, row indices of b */
+    double Bx [ ],              /* size bnz, values of b */
+    int32_t nout,               /* number of entries of x requested */
+    int32_t Out [ ],            /* size nout; NULL to get all of x */
+    /* outputs */
+    int32_t *xnz,               /* number of entries in x */
+    int32_t Xi [ ],             /* size n, or nout: indices of x */
+    double Xx [ ],              /* size n, or nout: values of x */
+    /* workspace, all zero before the first call */
+    int32_t Wi [ ],             /* size 4*n + nblocks + 4*maxblock */
+    double W [ ],               /* size n */
+    klu_common *Common
+) ;
+
+int klu_z_solve_sparse      /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,
+    int32_t bnz,                /* number of entries in b */
+    int32_t Bi [ ],             /* size bnz, row indices of b */
+    double Bx [ ],              /* size 2*bnz, values of b */
+    int32_t nout,               /* number of entries of x requested */
+    int32_t Out [ ],            /* size nout; NULL to get all of x */
+    /* outputs */
+    int32_t *xnz,               /* number of entries in x */
+    int32_t Xi [ ],             /* size n, or nout: indices of x */
+    double Xx [ ],              /* size 2*n, or 2*nout: values of x */
+    /* workspace, all zero before the first call */
+    int32_t Wi [ ],             /* size 4*n + nblocks + 4*maxblock */
+    double W [ ],               /* size 2*n */
+    klu_common *Common
+) ;
+
+int klu_l_solve_sparse (klu_l_symbolic *, klu_l_numeric *, int64_t,
+    int64_t *, double *, int64_t, int64_t *, int64_t *, int64_t *, double *,
+    int64_t *, double *, klu_l_common *) ;
+
+int klu_zl_solve_sparse (klu_l_symbolic *, klu_l_numeric *, int64_t,
+    int64_t *, double *, int64_t, int64_t *, int64_t *, int64_t *, double *,
+    int64_t *, double *, klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_tsolve: solves A'x=b using the Symbolic and Numeric objects */
 /* -------------------------------------------------------------------------- */
@@ -395,6 +567,16 @@ int klu_zl_tsolve (klu_l_symbolic *, klu_l_numeric *,
 /* klu_refactor: refactorizes matrix with same ordering as klu_factor */
 /* -------------------------------------------------------------------------- */
 
+/* klu_refactor keeps the pivots found by klu_factor.  As it refactorizes each
+ * block, it estimates the reciprocal pivot growth of the block, and returns
+ * the smallest estimate in Common->rgrowth and the cheap reciprocal condition
+ * estimate of klu_rcond in Common->rcond, with no extra pass over the
+ * factors.  If Common->repivot_tol > 0, the blocks whose estimate falls below
+ * it, or that have a zero pivot, are factorized again with partial pivoting;
+ * the number of such blocks is returned in Common->nrepivot.  The Numeric
+ * object is then the same as klu_factor would give for those blocks.  If out
+ * of memory while repivoting, the Numeric object can only be freed. */
+
 int klu_refactor            /* return TRUE if successful, FALSE otherwise */
 (
     /* inputs, not modified */
@@ -426,6 +608,108 @@ int klu_zl_refactor (int64_t *, int64_t *,
     double *, klu_l_symbolic *, klu_l_numeric *, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* klu_refactor_partial: refactorizes only the blocks that have changed */
+/* -------------------------------------------------------------------------- */
+
+/* Same as klu_refactor, except that only the columns listed in Changed have
+ * new values.  Only the diagonal blocks of the BTF form that contain those
+ * columns are refactorized, so the time taken depends on the size of those
+ * blocks rather than on the whole matrix.  If the matrix is scaled
+ * (Common->scale > 0), the scale factors are recomputed, and blocks with rows
+ * whose scale factor has changed are refactorized as well.  Common->rgrowth
+ * and Common->nrepivot only account for the blocks that are refactorized. */
+
+int klu_refactor_partial    /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int32_t Ap [ ],         /* size n+1, column pointers */
+    int32_t Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz, numerical values */
+    klu_symbolic *Symbolic,
+    int32_t nchanged,       /* number of columns that have changed */
+    int32_t Changed [ ],    /* size nchanged, the columns that have changed */
+    /* input, and numerical values modified on output */
+    klu_numeric *Numeric,
+    klu_common *Common
+) ;
+
+int klu_z_refactor_partial  /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int32_t Ap [ ],         /* size n+1, column pointers */
+    int32_t Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size 2*nz, numerical values */
+    klu_symbolic *Symbolic,
+    int32_t nchanged,       /* number of columns that have changed */
+    int32_t Changed [ ],    /* size nchanged, the columns that have changed */
+    /* input, and numerical values modified on output */
+    klu_numeric *Numeric,
+    klu_common *Common
+) ;
+
+int klu_l_refactor_partial (int64_t *, int64_t *, double *, klu_l_symbolic *,
+    int64_t, int64_t *, klu_l_numeric *, klu_l_common *) ;
+
+int klu_zl_refactor_partial (int64_t *, int64_t *, double *, klu_l_symbolic *,
+    int64_t, int64_t *, klu_l_numeric *, klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_refactor_solve_batch: refactorize and solve many matrices at once */
+/* -------------------------------------------------------------------------- */
+
+/* Refactorizes and solves A_k x_k = b_k for k = 0 to nbatch-1, where all the
+ * matrices A_k have the same pattern as the matrix given to klu_factor.  The
+ * result agrees with klu_refactor and klu_solve for each matrix up to
+ * rounding, not bitwise, but the Numeric object is only used for its pivot
+ * order and is not modified, and groups of matrices are refactorized
+ * together, in parallel if Common->nthreads is not 1.  The values of A_k are
+ * held in Ax [k*nz ... (k+1)*nz-1], and b_k in B [k*n ... (k+1)*n-1]
+ * (twice that for the complex versions).  If present, Singular [k] is the
+ * first zero pivot of A_k, or -1 if there is none.  Common->status is
+ * KLU_SINGULAR if any A_k has a zero pivot, and Common->numerical_rank and
+ * Common->singular_col are then set for the first such matrix. */
+
+int klu_refactor_solve_batch    /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int32_t Ap [ ],         /* size n+1, column pointers */
+    int32_t Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz*nbatch, numerical values */
+    int32_t nbatch,         /* number of matrices */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* from klu_factor, not modified */
+    /* right-hand-sides on input, overwritten with solutions on output */
+    double B [ ],       /* size n*nbatch */
+    /* output, may be NULL */
+    int32_t Singular [ ],   /* size nbatch */
+    klu_common *Common
+) ;
+
+int klu_z_refactor_solve_batch  /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int32_t Ap [ ],         /* size n+1, column pointers */
+    int32_t Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size 2*nz*nbatch, numerical values */
+    int32_t nbatch,         /* number of matrices */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* from klu_z_factor, not modified */
+    /* right-hand-sides on input, overwritten with solutions on output */
+    double B [ ],       /* size 2*n*nbatch */
+    /* output, may be NULL */
+    int32_t Singular [ ],   /* size nbatch */
+    klu_common *Common
+) ;
+
+int klu_l_refactor_solve_batch (int64_t *, int64_t *, double *, int64_t,
+    klu_l_symbolic *, klu_l_numeric *, double *, int64_t *, klu_l_common *) ;
+
+int klu_zl_refactor_solve_batch (int64_t *, int64_t *, double *, int64_t,
+    klu_l_symbolic *, klu_l_numeric *, double *, int64_t *, klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_free_symbolic: destroys the Symbolic object */
 /* -------------------------------------------------------------------------- */
@@ -462,6 +746,212 @@ int klu_l_free_numeric (klu_l_numeric **, klu_l_common *) ;
 int klu_zl_free_numeric (klu_l_numeric **, klu_l_common *) ;
 
 
+/* -------------------------------------------------------------------------- */
+/* single precision: klu_s_factor, klu_s_refactor, klu_s_solve, klu_s_refine */
+/* -------------------------------------------------------------------------- */
+
+/* klu_s_factor, klu_s_refactor, klu_s_refactor_partial, klu_s_solve, and
+ * klu_s_free_numeric are the same as klu_factor, ..., except that the
+ * numerical values of A and B, and the LU factors in the Numeric object, are
+ * single precision (float).  The klu_c_* versions are for complex single
+ * precision, with the real and imaginary parts of each entry held as a pair
+ * of floats, and the klu_sl_* and klu_cl_* versions use int64_t integers.
+ * The Symbolic object from klu_analyze is shared with the double precision
+ * versions.  A Numeric object from klu_s_factor can only be used with the
+ * other klu_s_* functions, and must be freed with klu_s_free_numeric.  The
+ * row scale factors (Numeric->Rs) are kept in double precision.
+ *
+ * klu_s_refine solves Ax=b in double precision with the single precision
+ * factors of A, using mixed precision iterative refinement: A and B are
+ * given in double precision, the residual b-A*x is computed in double, and
+ * the correction is found with the single precision factors.  Each column of
+ * B is refined until its componentwise backward error is at the level of
+ * double precision roundoff, until a step fails to halve it, or after maxiter
+ * steps, and the iterate with the smallest backward error is returned.  The
+ * largest number of steps taken is returned in Common->nrefine, and the
+ * largest backward error in Common->berr.  With a well-conditioned A,
+ * this gives a solution as accurate as the double precision solve, while
+ * moving half as many bytes of L and U in each solve. */
+
+klu_numeric *klu_s_factor (int32_t *, int32_t *, float *, klu_symbolic *,
+    klu_common *) ;
+klu_numeric *klu_c_factor (int32_t *, int32_t *, float *, klu_symbolic *,
+    klu_common *) ;
+klu_l_numeric *klu_sl_factor (int64_t *, int64_t *, float *,
+    klu_l_symbolic *, klu_l_common *) ;
+klu_l_numeric *klu_cl_factor (int64_t *, int64_t *, float *,
+    klu_l_symbolic *, klu_l_common *) ;
+
+int klu_s_refactor (int32_t *, int32_t *, float *, klu_symbolic *,
+    klu_numeric *, klu_common *) ;
+int klu_c_refactor (int32_t *, int32_t *, float *, klu_symbolic *,
+    klu_numeric *, klu_common *) ;
+int klu_sl_refactor (int64_t *, int64_t *, float *, klu_l_symbolic *,
+    klu_l_numeric *, klu_l_common *) ;
+int klu_cl_refactor (int64_t *, int64_t *, float *, klu_l_symbolic *,
+    klu_l_numeric *, klu_l_common *) ;
+
+int klu_s_refactor_partial (int32_t *, int32_t *, float *, klu_symbolic *,
+    int32_t, int32_t *, klu_numeric *, klu_common *) ;
+int klu_c_refactor_partial (int32_t *, int32_t *, float *, klu_symbolic *,
+    int32_t, int32_t *, klu_numeric *, klu_common *) ;
+int klu_sl_refactor_partial (int64_t *, int64_t *, float *, klu_l_symbolic *,
+    int64_t, int64_t *, klu_l_numeric *, klu_l_common *) ;
+int klu_cl_refactor_partial (int64_t *, int64_t *, float *, klu_l_symbolic *,
+    int64_t, int64_t *, klu_l_numeric *, klu_l_common *) ;
+
+int klu_s_solve (klu_symbolic *, klu_numeric *, int32_t, int32_t, float *,
+    klu_common *) ;
+int klu_c_solve (klu_symbolic *, klu_numeric *, int32_t, int32_t, float *,
+    klu_common *) ;
+int klu_sl_solve (klu_l_symbolic *, klu_l_numeric *, int64_t, int64_t,
+    float *, klu_l_common *) ;
+int klu_cl_solve (klu_l_symbolic *, klu_l_numeric *, int64_t, int64_t,
+    float *, klu_l_common *) ;
+
+int klu_s_free_numeric (klu_numeric **, klu_common *) ;
+int klu_c_free_numeric (klu_numeric **, klu_common *) ;
+int klu_sl_free_numeric (klu_l_numeric **, klu_l_common *) ;
+int klu_cl_free_numeric (klu_l_numeric **, klu_l_common *) ;
+
+int klu_s_refine            /* return TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    int32_t Ap [ ],         /* size n+1, column pointers */
+    int32_t Ai [ ],         /* size nz, row indices */
+    double Ax [ ],          /* size nz, numerical values of A in double */
+    klu_symbolic *Symbolic,
+    klu_numeric *Numeric,   /* from klu_s_factor or klu_s_refactor */
+    int32_t ldim,           /* leading dimension of B */
+    int32_t nrhs,           /* number of right-hand-sides */
+    int32_t maxiter,        /* max # of refinement steps for each column */
+
+    /* right-hand-side on input, overwritten with solution to Ax=b on output */
+    double B [ ],           /* size ldim*nrhs */
+    klu_common *Common
+) ;
+
+int klu_c_refine (int32_t *, int32_t *, double *, klu_symbolic *,
+    klu_numeric *, int32_t, int32_t, int32_t, double *, klu_common *) ;
+int klu_sl_refine (int64_t *, int64_t *, double *, klu_l_symbolic *,
+    klu_l_numeric *, int64_t, int64_t, int64_t, double *, klu_l_common *) ;
+int klu_cl_refine (int64_t *, int64_t *, double *, klu_l_symbolic *,
+    klu_l_numeric *, int64_t, int64_t, int64_t, double *, klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_serialize_symbolic: saves the Symbolic object in a blob */
+/* -------------------------------------------------------------------------- */
+
+/* A Symbolic or Numeric object can be saved in a single contiguous array of
+ * bytes (the "blob"), which can be written to a file, or shared with another
+ * process, and then read back with klu_deserialize_symbolic or
+ * klu_deserialize_numeric.  Each array in the blob starts at an offset that
+ * is a multiple of 64 bytes from the start of the blob.  The blob can only be
+ * read back by the same version of KLU, on a machine with the same integer and
+ * pointer sizes and byte order.
+ *
+ * klu_serialize_*_size returns the size of the blob, in bytes, in *blobsize.
+ * klu_serialize_* then fills a blob of at least that size.
+ *
+ * klu_deserialize_* creates a new object from the blob.  If wrap is false,
+ * the contents of the blob are copied, and the blob can be freed afterwards.
+ * If wrap is true, the arrays of the new object point into the blob instead
+ * (which can be a file mapped into memory with mmap), and only a small amount
+ * of memory is allocated.  The blob must then start on an 8-byte boundary
+ * (otherwise Common->status is KLU_INVALID), and must not be freed or unmapped
+ * until the object is freed with klu_free_symbolic or klu_free_numeric, which
+ * do not free the blob.  The blob is not modified by klu_solve, klu_tsolve,
+ * klu_condest, klu_rgrowth, klu_rcond or klu_flops, so a read-only mapping
+ * can be shared by many processes.  klu_refactor and klu_refactor_partial
+ * overwrite the numerical values in a Numeric blob (use a private,
+ * copy-on-write mapping for this), and cannot change whether or not the
+ * matrix is scaled (Common->scale > 0 or <= 0) from the time of klu_factor. */
+
+int klu_serialize_symbolic_size     /* return TRUE if OK, FALSE otherwise */
+(
+    klu_symbolic *Symbolic,
+    int64_t *blobsize,          /* output: size of the blob, in bytes */
+    klu_common *Common
+) ;
+
+int klu_l_serialize_symbolic_size (klu_l_symbolic *, int64_t *,
+    klu_l_common *) ;
+
+int klu_serialize_symbolic          /* return TRUE if OK, FALSE otherwise */
+(
+    klu_symbolic *Symbolic,
+    int8_t *blob,               /* output: blob of size blobsize */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    klu_common *Common
+) ;
+
+int klu_l_serialize_symbolic (klu_l_symbolic *, int8_t *, int64_t,
+    klu_l_common *) ;
+
+klu_symbolic *klu_deserialize_symbolic  /* returns NULL if error */
+(
+    int8_t *blob,               /* blob from klu_serialize_symbolic */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    int wrap,                   /* if true, point into the blob instead of
+                                 * copying it */
+    klu_common *Common
+) ;
+
+klu_l_symbolic *klu_l_deserialize_symbolic (int8_t *, int64_t, int,
+    klu_l_common *) ;
+
+
+/* -------------------------------------------------------------------------- */
+/* klu_serialize_numeric: saves the Numeric object in a blob */
+/* -------------------------------------------------------------------------- */
+
+/* See klu_serialize_symbolic.  The complex versions must be used for a Numeric
+ * object from klu_z_factor. */
+
+int klu_serialize_numeric_size      /* return TRUE if OK, FALSE otherwise */
+(
+    klu_numeric *Numeric,
+    int64_t *blobsize,          /* output: size of the blob, in bytes */
+    klu_common *Common
+) ;
+
+int klu_z_serialize_numeric_size (klu_numeric *, int64_t *, klu_common *) ;
+int klu_l_serialize_numeric_size (klu_l_numeric *, int64_t *,
+    klu_l_common *) ;
+int klu_zl_serialize_numeric_size (klu_l_numeric *, int64_t *,
+    klu_l_common *) ;
+
+int klu_serialize_numeric           /* return TRUE if OK, FALSE otherwise */
+(
+    klu_numeric *Numeric,
+    int8_t *blob,               /* output: blob of size blobsize */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    klu_common *Common
+) ;
+
+int klu_z_serialize_numeric (klu_numeric *, int8_t *, int64_t, klu_common *) ;
+int klu_l_serialize_numeric (klu_l_numeric *, int8_t *, int64_t,
+    klu_l_common *) ;
+int klu_zl_serialize_numeric (klu_l_numeric *, int8_t *, int64_t,
+    klu_l_common *) ;
+
+klu_numeric *klu_deserialize_numeric    /* returns NULL if error */
+(
+    int8_t *blob,               /* blob from klu_serialize_numeric */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    int wrap,                   /* if true, point into the blob instead of
+                                 * copying it */
+    klu_common *Common
+) ;
+
+klu_numeric *klu_z_deserialize_numeric (int8_t *, int64_t, int, klu_common *) ;
+klu_l_numeric *klu_l_deserialize_numeric (int8_t *, int64_t, int,
+    klu_l_common *) ;
+klu_l_numeric *klu_zl_deserialize_numeric (int8_t *, int64_t, int,
+    klu_l_common *) ;
+
+
 /* -------------------------------------------------------------------------- */
 /* klu_sort: sorts the columns of the LU factorization */
 /* -------------------------------------------------------------------------- */
@@ -654,6 +1144,19 @@ int klu_l_scale (int, int64_t, int64_t *, int64_t *, double *,
 int klu_zl_scale (int, int64_t, int64_t *, int64_t *, double *,
     double *, int64_t *, klu_l_common *) ;
 
+/* single precision versions; the scale factors Rs are double */
+int klu_s_scale (int, int32_t, int32_t *, int32_t *, float *,
+    double *, int32_t *, klu_common *) ;
+
+int klu_c_scale (int, int32_t, int32_t *, int32_t *, float *,
+    double *, int32_t *, klu_common *) ;
+
+int klu_sl_scale (int, int64_t, int64_t *, int64_t *, float *,
+    double *, int64_t *, klu_l_common *) ;
+
+int klu_cl_scale (int, int64_t, int64_t *, int64_t *, float *,
+    double *, int64_t *, klu_l_common *) ;
+
 
 /* -------------------------------------------------------------------------- */
 /* klu_extract  */
@@ -823,33 +1326,33 @@ void klu_version (int version [3]) ;
  *      #endif
  */
 
-#define KLU_DATE "Mar 22, 2024"
-#define KLU_MAIN_VERSION   2
-#define KLU_SUB_VERSION    3
-#define KLU_SUBSUB_VERSION 3
+#define KLU_DATE "Oct 18, 2026"
+#define KLU_MAIN_VERSION   3
+#define KLU_SUB_VERSION    0
+#define KLU_SUBSUB_VERSION 0
 
 #define KLU_VERSION_CODE(main,sub) SUITESPARSE_VER_CODE(main,sub)
-#define KLU_VERSION KLU_VERSION_CODE(2,3)
+#define KLU_VERSION KLU_VERSION_CODE(3,0)
 
-#define KLU__VERSION SUITESPARSE__VERCODE(2,3,3)
+#define KLU__VERSION SUITESPARSE__VERCODE(3,0,0)
 #if !defined (SUITESPARSE__VERSION) || \
     (SUITESPARSE__VERSION < SUITESPARSE__VERCODE(7,7,0))
-#error "KLU 2.3.3 requires SuiteSparse_config 7.7.0 or later"
+#error "KLU 3.0.0 requires SuiteSparse_config 7.7.0 or later"
 #endif
 
 #if !defined (AMD__VERSION) || \
     (AMD__VERSION < SUITESPARSE__VERCODE(3,3,2))
-#error "KLU 2.3.3 requires AMD 3.3.2 or later"
+#error "KLU 3.0.0 requires AMD 3.3.2 or later"
 #endif
 
 #if !defined (COLAMD__VERSION) || \
     (COLAMD__VERSION < SUITESPARSE__VERCODE(3,3,3))
-#error "KLU 2.3.3 requires COLAMD 3.3.3 or later"
+#error "KLU 3.0.0 requires COLAMD 3.3.3 or later"
 #endif
 
 #if !defined (BTF__VERSION) || \
     (BTF__VERSION < SUITESPARSE__VERCODE(2,3,2))
-#error "KLU 2.3.3 requires BTF 2.3.2 or later"
+#error "KLU 3.0.0 requires BTF 2.3.2 or later"
 #endif
 
 #endif
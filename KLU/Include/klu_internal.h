@@ -78,6 +78,42 @@
 #define FLIP(i) (-(i)-2)
 #define UNFLIP(i) (((i) < EMPTY) ? FLIP (i) : (i))
 
+/* smallest dense lower right submatrix of the LU factors of a block that
+ * KLU_refactor factorizes with a dense kernel */
+#define KLU_DENSE_MIN 16
+
+/* panel width of the dense kernel in KLU_refactor */
+#define KLU_DENSE_PANEL 32
+
+/* the pivot growth of each block, used by KLU_refactor, is held in the last
+ * nblocks doubles of Numeric->Work, so that it needs no allocation of its own
+ * once the scale factors have been changed */
+#define KLU_GROWTH(Numeric) \
+    ((double *) ((int8_t *) (Numeric)->Work + (Numeric)->worksize) \
+    - (Numeric)->nblocks)
+
+/* serialized Symbolic and Numeric objects: each array in the blob starts
+ * KLU_BLOB_ALIGN bytes (or a multiple of that) from the start of the blob, a
+ * blob to be wrapped must start on a KLU_BLOB_START byte boundary, and the
+ * blob is tagged with its kind */
+#define KLU_BLOB_ALIGN 64
+#define KLU_BLOB_START 8
+#define KLU_SYMBOLIC_BLOB 0x4b4c5553
+#define KLU_NUMERIC_BLOB 0x4b4c554e
+
+/* the first bytes of a serialized Symbolic or Numeric object */
+typedef struct
+{
+    int64_t blobsize ;      /* size of the whole blob, in bytes */
+    int32_t kind ;          /* KLU_SYMBOLIC_BLOB or KLU_NUMERIC_BLOB */
+    int32_t version [3] ;   /* KLU main, sub, and subsub version */
+    int32_t object_size ;   /* sizeof (KLU_symbolic) or sizeof (KLU_numeric) */
+    int32_t int_size ;      /* sizeof (Int) */
+    int32_t entry_size ;    /* sizeof (Entry), or sizeof (double) for Symbolic */
+    int32_t pointer_size ;  /* sizeof (void *) */
+    int32_t scaled ;        /* Numeric only: TRUE if Rs is present */
+} klu_blob_header ;
+
 
 size_t KLU_kernel   /* final size of LU on output */
 (
@@ -118,7 +154,7 @@ size_t KLU_kernel   /* final size of LU on output */
     double Rs [ ],      /* scale factors for A */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal column pointers (not modified) */
     Int Offi [ ],
     Entry Offx [ ],
     KLU_common *Common  /* the control input/output structure */
@@ -156,12 +192,27 @@ size_t KLU_kernel_factor            /* 0 if failure, size of LU if OK */
     double Rs [ ],      /* scale factors for A */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal column pointers (not modified) */
     Int Offi [ ],
     Entry Offx [ ],
     KLU_common *Common  /* the control input/output structure */
 ) ;
 
+void KLU_repivot_block
+(
+    /* inputs, not modified */
+    Int block,
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Ax [ ],
+    KLU_symbolic *Symbolic,
+    double Rs [ ],      /* size n, row scale factors in original order */
+
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+) ;
+
 void KLU_lsolve
 (
     /* inputs, not modified: */
@@ -240,6 +291,22 @@ size_t KLU_add_size_t (size_t a, size_t b, Int *ok) ;
 
 size_t KLU_mult_size_t (size_t a, size_t k, Int *ok) ;
 
+size_t KLU_blob_array (size_t offset, size_t n, size_t size, size_t *next,
+    Int *ok) ;
+
+void *KLU_blob_read (int8_t *blob, size_t offset, size_t n, size_t size,
+    int wrap, KLU_common *Common) ;
+
 KLU_symbolic *KLU_alloc_symbolic (Int n, Int *Ap, Int *Ai, KLU_common *Common) ;
 
+Int KLU_parallel_threads (Int nblocks, KLU_common *Common) ;
+
+Int *KLU_block_order (KLU_symbolic *Symbolic, KLU_common *Common) ;
+
+KLU_symbolic *KLU_cache_lookup (Int n, Int Ap [ ], Int Ai [ ], uint64_t *hash,
+    KLU_common *Common) ;
+
+void KLU_cache_insert (Int n, Int Ap [ ], Int Ai [ ], uint64_t hash,
+    KLU_symbolic *Symbolic, KLU_common *Common) ;
+
 #endif
@@ -47,6 +47,148 @@
 }
 
 /* function names */
+#ifdef SINGLE
+
+#ifdef COMPLEX
+
+#ifdef DLONG
+
+// cl: complex float, int64_t
+#define KLU_scale klu_cl_scale
+#define KLU_solve klu_cl_solve
+#define KLU_solve_sparse klu_cl_solve_sparse
+#define KLU_tsolve klu_cl_tsolve
+#define KLU_free_numeric klu_cl_free_numeric
+#define KLU_serialize_numeric_size klu_cl_serialize_numeric_size
+#define KLU_serialize_numeric klu_cl_serialize_numeric
+#define KLU_deserialize_numeric klu_cl_deserialize_numeric
+#define KLU_factor klu_cl_factor
+#define KLU_refactor klu_cl_refactor
+#define KLU_refactor_partial klu_cl_refactor_partial
+#define KLU_refactor_solve_batch klu_cl_refactor_solve_batch
+#define KLU_kernel_factor klu_cl_kernel_factor
+#define KLU_repivot_block klu_cl_repivot_block
+#define KLU_lsolve klu_cl_lsolve
+#define KLU_ltsolve klu_cl_ltsolve
+#define KLU_usolve klu_cl_usolve
+#define KLU_utsolve klu_cl_utsolve
+#define KLU_kernel klu_cl_kernel
+#define KLU_valid klu_cl_valid
+#define KLU_valid_LU klu_cl_valid_LU
+#define KLU_sort klu_cl_sort
+#define KLU_rgrowth klu_cl_rgrowth
+#define KLU_rcond klu_cl_rcond
+#define KLU_extract klu_cl_extract
+#define KLU_condest klu_cl_condest
+#define KLU_flops klu_cl_flops
+#define KLU_refine klu_cl_refine
+
+#else
+
+// c: complex float, int32_t
+#define KLU_scale klu_c_scale
+#define KLU_solve klu_c_solve
+#define KLU_solve_sparse klu_c_solve_sparse
+#define KLU_tsolve klu_c_tsolve
+#define KLU_free_numeric klu_c_free_numeric
+#define KLU_serialize_numeric_size klu_c_serialize_numeric_size
+#define KLU_serialize_numeric klu_c_serialize_numeric
+#define KLU_deserialize_numeric klu_c_deserialize_numeric
+#define KLU_factor klu_c_factor
+#define KLU_refactor klu_c_refactor
+#define KLU_refactor_partial klu_c_refactor_partial
+#define KLU_refactor_solve_batch klu_c_refactor_solve_batch
+#define KLU_kernel_factor klu_c_kernel_factor
+#define KLU_repivot_block klu_c_repivot_block
+#define KLU_lsolve klu_c_lsolve
+#define KLU_ltsolve klu_c_ltsolve
+#define KLU_usolve klu_c_usolve
+#define KLU_utsolve klu_c_utsolve
+#define KLU_kernel klu_c_kernel
+#define KLU_valid klu_c_valid
+#define KLU_valid_LU klu_c_valid_LU
+#define KLU_sort klu_c_sort
+#define KLU_rgrowth klu_c_rgrowth
+#define KLU_rcond klu_c_rcond
+#define KLU_extract klu_c_extract
+#define KLU_condest klu_c_condest
+#define KLU_flops klu_c_flops
+#define KLU_refine klu_c_refine
+
+#endif
+
+#else
+
+#ifdef DLONG
+
+// sl: float, int64_t
+#define KLU_scale klu_sl_scale
+#define KLU_solve klu_sl_solve
+#define KLU_solve_sparse klu_sl_solve_sparse
+#define KLU_tsolve klu_sl_tsolve
+#define KLU_free_numeric klu_sl_free_numeric
+#define KLU_serialize_numeric_size klu_sl_serialize_numeric_size
+#define KLU_serialize_numeric klu_sl_serialize_numeric
+#define KLU_deserialize_numeric klu_sl_deserialize_numeric
+#define KLU_factor klu_sl_factor
+#define KLU_refactor klu_sl_refactor
+#define KLU_refactor_partial klu_sl_refactor_partial
+#define KLU_refactor_solve_batch klu_sl_refactor_solve_batch
+#define KLU_kernel_factor klu_sl_kernel_factor
+#define KLU_repivot_block klu_sl_repivot_block
+#define KLU_lsolve klu_sl_lsolve
+#define KLU_ltsolve klu_sl_ltsolve
+#define KLU_usolve klu_sl_usolve
+#define KLU_utsolve klu_sl_utsolve
+#define KLU_kernel klu_sl_kernel
+#define KLU_valid klu_sl_valid
+#define KLU_valid_LU klu_sl_valid_LU
+#define KLU_sort klu_sl_sort
+#define KLU_rgrowth klu_sl_rgrowth
+#define KLU_rcond klu_sl_rcond
+#define KLU_extract klu_sl_extract
+#define KLU_condest klu_sl_condest
+#define KLU_flops klu_sl_flops
+#define KLU_refine klu_sl_refine
+
+#else
+
+// s: float, int32_t
+#define KLU_scale klu_s_scale
+#define KLU_solve klu_s_solve
+#define KLU_solve_sparse klu_s_solve_sparse
+#define KLU_tsolve klu_s_tsolve
+#define KLU_free_numeric klu_s_free_numeric
+#define KLU_serialize_numeric_size klu_s_serialize_numeric_size
+#define KLU_serialize_numeric klu_s_serialize_numeric
+#define KLU_deserialize_numeric klu_s_deserialize_numeric
+#define KLU_factor klu_s_factor
+#define KLU_refactor klu_s_refactor
+#define KLU_refactor_partial klu_s_refactor_partial
+#define KLU_refactor_solve_batch klu_s_refactor_solve_batch
+#define KLU_kernel_factor klu_s_kernel_factor
+#define KLU_repivot_block klu_s_repivot_block
+#define KLU_lsolve klu_s_lsolve
+#define KLU_ltsolve klu_s_ltsolve
+#define KLU_usolve klu_s_usolve
+#define KLU_utsolve klu_s_utsolve
+#define KLU_kernel klu_s_kernel
+#define KLU_valid klu_s_valid
+#define KLU_valid_LU klu_s_valid_LU
+#define KLU_sort klu_s_sort
+#define KLU_rgrowth klu_s_rgrowth
+#define KLU_rcond klu_s_rcond
+#define KLU_extract klu_s_extract
+#define KLU_condest klu_s_condest
+#define KLU_flops klu_s_flops
+#define KLU_refine klu_s_refine
+
+#endif
+
+#endif
+
+#else
+
 #ifdef COMPLEX 
 
 #ifdef DLONG
@@ -54,11 +196,18 @@
 // zl: complex int64_t
 #define KLU_scale klu_zl_scale
 #define KLU_solve klu_zl_solve
+#define KLU_solve_sparse klu_zl_solve_sparse
 #define KLU_tsolve klu_zl_tsolve
 #define KLU_free_numeric klu_zl_free_numeric
+#define KLU_serialize_numeric_size klu_zl_serialize_numeric_size
+#define KLU_serialize_numeric klu_zl_serialize_numeric
+#define KLU_deserialize_numeric klu_zl_deserialize_numeric
 #define KLU_factor klu_zl_factor
 #define KLU_refactor klu_zl_refactor
+#define KLU_refactor_partial klu_zl_refactor_partial
+#define KLU_refactor_solve_batch klu_zl_refactor_solve_batch
 #define KLU_kernel_factor klu_zl_kernel_factor 
+#define KLU_repivot_block klu_zl_repivot_block 
 #define KLU_lsolve klu_zl_lsolve
 #define KLU_ltsolve klu_zl_ltsolve
 #define KLU_usolve klu_zl_usolve
@@ -78,11 +227,18 @@
 // z: complex int32_t
 #define KLU_scale klu_z_scale
 #define KLU_solve klu_z_solve
+#define KLU_solve_sparse klu_z_solve_sparse
 #define KLU_tsolve klu_z_tsolve
 #define KLU_free_numeric klu_z_free_numeric
+#define KLU_serialize_numeric_size klu_z_serialize_numeric_size
+#define KLU_serialize_numeric klu_z_serialize_numeric
+#define KLU_deserialize_numeric klu_z_deserialize_numeric
 #define KLU_factor klu_z_factor
 #define KLU_refactor klu_z_refactor
+#define KLU_refactor_partial klu_z_refactor_partial
+#define KLU_refactor_solve_batch klu_z_refactor_solve_batch
 #define KLU_kernel_factor klu_z_kernel_factor 
+#define KLU_repivot_block klu_z_repivot_block 
 #define KLU_lsolve klu_z_lsolve
 #define KLU_ltsolve klu_z_ltsolve
 #define KLU_usolve klu_z_usolve
@@ -106,11 +262,18 @@
 // l: int64_t
 #define KLU_scale klu_l_scale
 #define KLU_solve klu_l_solve
+#define KLU_solve_sparse klu_l_solve_sparse
 #define KLU_tsolve klu_l_tsolve
 #define KLU_free_numeric klu_l_free_numeric
+#define KLU_serialize_numeric_size klu_l_serialize_numeric_size
+#define KLU_serialize_numeric klu_l_serialize_numeric
+#define KLU_deserialize_numeric klu_l_deserialize_numeric
 #define KLU_factor klu_l_factor
 #define KLU_refactor klu_l_refactor
+#define KLU_refactor_partial klu_l_refactor_partial
+#define KLU_refactor_solve_batch klu_l_refactor_solve_batch
 #define KLU_kernel_factor klu_l_kernel_factor 
+#define KLU_repivot_block klu_l_repivot_block 
 #define KLU_lsolve klu_l_lsolve
 #define KLU_ltsolve klu_l_ltsolve
 #define KLU_usolve klu_l_usolve
@@ -130,11 +293,18 @@
 // no prefix: int32_t
 #define KLU_scale klu_scale
 #define KLU_solve klu_solve
+#define KLU_solve_sparse klu_solve_sparse
 #define KLU_tsolve klu_tsolve
 #define KLU_free_numeric klu_free_numeric
+#define KLU_serialize_numeric_size klu_serialize_numeric_size
+#define KLU_serialize_numeric klu_serialize_numeric
+#define KLU_deserialize_numeric klu_deserialize_numeric
 #define KLU_factor klu_factor
 #define KLU_refactor klu_refactor
+#define KLU_refactor_partial klu_refactor_partial
+#define KLU_refactor_solve_batch klu_refactor_solve_batch
 #define KLU_kernel_factor klu_kernel_factor 
+#define KLU_repivot_block klu_repivot_block 
 #define KLU_lsolve klu_lsolve
 #define KLU_ltsolve klu_ltsolve
 #define KLU_usolve klu_usolve
@@ -153,6 +323,8 @@
 
 #endif
 
+#endif
+
 
 #ifdef DLONG
 
@@ -161,12 +333,23 @@
 #define KLU_analyze_given klu_l_analyze_given
 #define KLU_alloc_symbolic klu_l_alloc_symbolic
 #define KLU_free_symbolic klu_l_free_symbolic
+#define KLU_serialize_symbolic_size klu_l_serialize_symbolic_size
+#define KLU_serialize_symbolic klu_l_serialize_symbolic
+#define KLU_deserialize_symbolic klu_l_deserialize_symbolic
 #define KLU_defaults klu_l_defaults
 #define KLU_free klu_l_free
 #define KLU_malloc klu_l_malloc
 #define KLU_realloc klu_l_realloc
 #define KLU_add_size_t klu_l_add_size_t
 #define KLU_mult_size_t klu_l_mult_size_t
+#define KLU_blob_array klu_l_blob_array
+#define KLU_blob_read klu_l_blob_read
+#define KLU_parallel_threads klu_l_parallel_threads
+#define KLU_block_order klu_l_block_order
+#define KLU_alloc_cache klu_l_alloc_cache
+#define KLU_free_cache klu_l_free_cache
+#define KLU_cache_lookup klu_l_cache_lookup
+#define KLU_cache_insert klu_l_cache_insert
 
 #define KLU_symbolic klu_l_symbolic
 #define KLU_numeric klu_l_numeric
@@ -186,12 +369,23 @@
 #define KLU_analyze_given klu_analyze_given
 #define KLU_alloc_symbolic klu_alloc_symbolic
 #define KLU_free_symbolic klu_free_symbolic
+#define KLU_serialize_symbolic_size klu_serialize_symbolic_size
+#define KLU_serialize_symbolic klu_serialize_symbolic
+#define KLU_deserialize_symbolic klu_deserialize_symbolic
 #define KLU_defaults klu_defaults
 #define KLU_free klu_free
 #define KLU_malloc klu_malloc
 #define KLU_realloc klu_realloc
 #define KLU_add_size_t klu_add_size_t
 #define KLU_mult_size_t klu_mult_size_t
+#define KLU_blob_array klu_blob_array
+#define KLU_blob_read klu_blob_read
+#define KLU_parallel_threads klu_parallel_threads
+#define KLU_block_order klu_block_order
+#define KLU_alloc_cache klu_alloc_cache
+#define KLU_free_cache klu_free_cache
+#define KLU_cache_lookup klu_cache_lookup
+#define KLU_cache_insert klu_cache_insert
 
 #define KLU_symbolic klu_symbolic
 #define KLU_numeric klu_numeric
@@ -266,8 +460,17 @@ SCALAR_IS_LTZERO(x):
 
 #ifndef COMPLEX
 
+#ifdef SINGLE
+/* Unit is wider than Entry, so that the Int row indices of L and U, which are
+ * held in the same Unit array as their values, are always aligned */
+typedef double Unit ;
+#define Entry float
+#define Scalar float
+#else
 typedef double Unit ;
 #define Entry double
+#define Scalar double
+#endif
 
 #define SPLIT(s)                    (1)
 #define REAL(c)                     (c)
@@ -335,6 +538,20 @@ typedef double Unit ;
 
 */
 
+#ifdef SINGLE
+
+typedef struct
+{
+    float component [2] ;       /* real and imaginary parts */
+
+} Float_Complex ;
+
+typedef Float_Complex Unit ;
+#define Entry Float_Complex
+#define Scalar float
+
+#else
+
 typedef struct
 {
     double component [2] ;      /* real and imaginary parts */
@@ -343,6 +560,9 @@ typedef struct
 
 typedef Double_Complex Unit ;
 #define Entry Double_Complex
+#define Scalar double
+
+#endif
 #define Real component [0]
 #define Imag component [1]
 
@@ -194,7 +194,10 @@ klu_src = {
     '../Source/klu_l_defaults', ...
     '../Source/klu_l_analyze_given', ...
     '../Source/klu_l_analyze', ...
-    '../Source/klu_l_memory' } ;
+    '../Source/klu_l_cache', ...
+    '../Source/klu_l_memory', ...
+    '../Source/klu_l_parallel', ...
+    '../Source/klu_l_serialize_symbolic' } ;
 
 if (with_cholmod)
     klu_src = [klu_src { '../User/klu_l_cholmod' }] ;                       %#ok
@@ -207,12 +210,24 @@ klu_zlsrc = {
     '../Source/klu_zl_factor', ...
     '../Source/klu_zl_free_numeric', ...
     '../Source/klu_zl_solve', ...
+    '../Source/klu_zl_solve_sparse', ...
     '../Source/klu_zl_scale', ...
     '../Source/klu_zl_refactor', ...
+    '../Source/klu_zl_refactor_solve_batch', ...
+    '../Source/klu_zl_serialize_numeric', ...
     '../Source/klu_zl_tsolve', ...
     '../Source/klu_zl_diagnostics', ...
     '../Source/klu_zl_sort', ...
     '../Source/klu_zl_extract', ...
+    '../Source/klu_cl', ...
+    '../Source/klu_cl_dump', ...
+    '../Source/klu_cl_factor', ...
+    '../Source/klu_cl_free_numeric', ...
+    '../Source/klu_cl_kernel', ...
+    '../Source/klu_cl_refactor', ...
+    '../Source/klu_cl_refine', ...
+    '../Source/klu_cl_scale', ...
+    '../Source/klu_cl_solve', ...
     } ;
 
 klu_lsrc = {
@@ -222,12 +237,24 @@ klu_lsrc = {
     '../Source/klu_l_factor', ...
     '../Source/klu_l_free_numeric', ...
     '../Source/klu_l_solve', ...
+    '../Source/klu_l_solve_sparse', ...
     '../Source/klu_l_scale', ...
     '../Source/klu_l_refactor', ...
+    '../Source/klu_l_refactor_solve_batch', ...
+    '../Source/klu_l_serialize_numeric', ...
     '../Source/klu_l_tsolve', ...
     '../Source/klu_l_diagnostics', ...
     '../Source/klu_l_sort', ...
     '../Source/klu_l_extract', ...
+    '../Source/klu_sl', ...
+    '../Source/klu_sl_dump', ...
+    '../Source/klu_sl_factor', ...
+    '../Source/klu_sl_free_numeric', ...
+    '../Source/klu_sl_kernel', ...
+    '../Source/klu_sl_refactor', ...
+    '../Source/klu_sl_refine', ...
+    '../Source/klu_sl_scale', ...
+    '../Source/klu_sl_solve', ...
     } ;
 
 try
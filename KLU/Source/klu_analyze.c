@@ -10,245 +10,463 @@
 
 /* Order the matrix using BTF (or not), and then AMD, COLAMD, the natural
  * ordering, or the user-provided-function on the blocks.  Does not support
- * using a given ordering (use klu_analyze_given for that case). */
+ * using a given ordering (use klu_analyze_given for that case).
+ *
+ * If KLU is compiled with OpenMP and Common->nthreads is not 1, the blocks
+ * are ordered with AMD or COLAMD in parallel; the result does not depend on
+ * the number of threads.  If Common->cache holds a cache from
+ * KLU_alloc_cache, a copy of an earlier result for the same pattern and
+ * parameters is returned instead of analyzing the matrix again. */
 
 #include "klu_internal.h"
 
+/* statistics for one block, combined in block order by add_block_info */
+typedef struct
+{
+    double lnz ;        /* estimated nnz(L) of the block, or EMPTY */
+    double flops ;      /* estimated flop count of the block, or EMPTY */
+    double symmetry ;   /* symmetry of the block from AMD, or EMPTY */
+    double memory ;     /* memory used by AMD, or 0 */
+    Int nz ;            /* # of entries in the block */
+    Int nzoff ;         /* # of entries in the columns of the block that are
+                         * in the off-diagonal blocks */
+    Int status ;        /* KLU_OK, or < 0 if the ordering failed */
+} block_info ;
+
 /* ========================================================================== */
-/* === analyze_worker ======================================================= */
+/* === order_block ========================================================== */
 /* ========================================================================== */
 
-static Int analyze_worker       /* returns KLU_OK or < 0 if error */
+/* Order one block of the BTF form, and combine its ordering with the BTF
+ * ordering in P [k1..k2-1] and Q [k1..k2-1].  Different blocks can be
+ * ordered at the same time, each with its own workspace. */
+
+static void order_block
 (
     /* inputs, not modified */
-    Int n,              /* A is n-by-n */
+    Int block,          /* the block to order */
     Int Ap [ ],         /* size n+1, column pointers */
     Int Ai [ ],         /* size nz, row indices */
-    Int nblocks,        /* # of blocks */
     Int Pbtf [ ],       /* BTF row permutation */
     Int Qbtf [ ],       /* BTF col permutation */
     Int R [ ],          /* size n+1, but only Rbtf [0..nblocks] is used */
+    Int Pinv [ ],       /* size n, inverse of Pbtf */
     Int ordering,       /* what ordering to use (0, 1, or 3 for this routine) */
 
     /* output only, not defined on input */
     Int P [ ],          /* size n */
     Int Q [ ],          /* size n */
     double Lnz [ ],     /* size n, but only Lnz [0..nblocks-1] is used */
+    block_info *Info,   /* statistics for this block */
 
     /* workspace, not defined on input or output */
     Int Pblk [ ],       /* size maxblock */
     Int Cp [ ],         /* size maxblock+1 */
     Int Ci [ ],         /* size MAX (nz+1, Cilen) */
-    Int Cilen,          /* nz+1, or COLAMD_recommend(nz,n,n) for COLAMD */
-    Int Pinv [ ],       /* size maxblock */
+    Int Cilen,          /* nz+1, or COLAMD_recommended(nz,n,n) for COLAMD */
 
-    /* input/output */
-    KLU_symbolic *Symbolic,
     KLU_common *Common
 )
 {
-    double amd_Info [AMD_INFO], lnz, lnz1, flops, flops1 ;
-    Int k1, k2, nk, k, block, oldcol, pend, newcol, result, pc, p, newrow,
-        maxnz, nzoff, cstats [COLAMD_STATS], ok, err = KLU_INVALID ;
+    double amd_Info [AMD_INFO], lnz1, flops1 ;
+    Int k1, k2, nk, k, oldcol, pend, newcol, result, pc, p, newrow,
+        nzoff, cstats [COLAMD_STATS], ok, err = KLU_INVALID ;
+
+    Info->symmetry = EMPTY ;
+    Info->memory = 0 ;
 
     /* ---------------------------------------------------------------------- */
-    /* initializations */
+    /* the block is from rows/columns k1 to k2-1 */
     /* ---------------------------------------------------------------------- */
 
-    /* compute the inverse of Pbtf */
-#ifndef NDEBUG
-    for (k = 0 ; k < n ; k++)
-    {
-        P [k] = EMPTY ;
-        Q [k] = EMPTY ;
-        Pinv [k] = EMPTY ;
-    }
-#endif
-    for (k = 0 ; k < n ; k++)
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    PRINTF (("BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1, k2-1, nk)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct the kth block, C */
+    /* ---------------------------------------------------------------------- */
+
+    Lnz [block] = EMPTY ;
+    pc = 0 ;
+    nzoff = 0 ;
+    for (k = k1 ; k < k2 ; k++)
     {
-        ASSERT (Pbtf [k] >= 0 && Pbtf [k] < n) ;
-        Pinv [Pbtf [k]] = k ;
+        newcol = k-k1 ;
+        Cp [newcol] = pc ;
+        oldcol = Qbtf [k] ;
+        pend = Ap [oldcol+1] ;
+        for (p = Ap [oldcol] ; p < pend ; p++)
+        {
+            newrow = Pinv [Ai [p]] ;
+            if (newrow < k1)
+            {
+                nzoff++ ;
+            }
+            else
+            {
+                /* (newrow,newcol) is an entry in the block */
+                ASSERT (newrow < k2) ;
+                newrow -= k1 ;
+                Ci [pc++] = newrow ;
+            }
+        }
     }
-#ifndef NDEBUG
-    for (k = 0 ; k < n ; k++) ASSERT (Pinv [k] != EMPTY) ;
-#endif
-    nzoff = 0 ;
-    lnz = 0 ;
-    maxnz = 0 ;
-    flops = 0 ;
-    Symbolic->symmetry = EMPTY ;        /* only computed by AMD */
+    Cp [nk] = pc ;
+    Info->nz = pc ;
+    Info->nzoff = nzoff ;
+    ASSERT (KLU_valid (nk, Cp, Ci, NULL)) ;
 
     /* ---------------------------------------------------------------------- */
-    /* order each block */
+    /* order the block C */
     /* ---------------------------------------------------------------------- */
 
-    for (block = 0 ; block < nblocks ; block++)
+    if (nk <= 3)
     {
 
         /* ------------------------------------------------------------------ */
-        /* the block is from rows/columns k1 to k2-1 */
+        /* use natural ordering for tiny blocks (3-by-3 or less) */
         /* ------------------------------------------------------------------ */
 
-        k1 = R [block] ;
-        k2 = R [block+1] ;
-        nk = k2 - k1 ;
-        PRINTF (("BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1, k2-1, nk)) ;
+        for (k = 0 ; k < nk ; k++)
+        {
+            Pblk [k] = k ;
+        }
+        lnz1 = nk * (nk + 1) / 2 ;
+        flops1 = nk * (nk - 1) / 2 + (nk-1)*nk*(2*nk-1) / 6 ;
+        ok = TRUE ;
+
+    }
+    else if (ordering == 0)
+    {
 
         /* ------------------------------------------------------------------ */
-        /* construct the kth block, C */
+        /* order the block with AMD (C+C') */
         /* ------------------------------------------------------------------ */
 
-        Lnz [block] = EMPTY ;
-        pc = 0 ;
-        for (k = k1 ; k < k2 ; k++)
+        result = AMD_order (nk, Cp, Ci, Pblk, NULL, amd_Info) ;
+        ok = (result >= AMD_OK) ;
+        if (result == AMD_OUT_OF_MEMORY)
         {
-            newcol = k-k1 ;
-            Cp [newcol] = pc ;
-            oldcol = Qbtf [k] ;
-            pend = Ap [oldcol+1] ;
-            for (p = Ap [oldcol] ; p < pend ; p++)
-            {
-                newrow = Pinv [Ai [p]] ;
-                if (newrow < k1)
-                {
-                    nzoff++ ;
-                }
-                else
-                {
-                    /* (newrow,newcol) is an entry in the block */
-                    ASSERT (newrow < k2) ;
-                    newrow -= k1 ;
-                    Ci [pc++] = newrow ;
-                }
-            }
+            err = KLU_OUT_OF_MEMORY ;
         }
-        Cp [nk] = pc ;
-        maxnz = MAX (maxnz, pc) ;
-        ASSERT (KLU_valid (nk, Cp, Ci, NULL)) ;
+
+        /* memory usage and ordering statistics from AMD */
+        Info->memory = amd_Info [AMD_MEMORY] ;
+        Info->symmetry = amd_Info [AMD_SYMMETRY] ;
+        lnz1 = (Int) (amd_Info [AMD_LNZ]) + nk ;
+        flops1 = 2 * amd_Info [AMD_NMULTSUBS_LU] + amd_Info [AMD_NDIV] ;
+
+    }
+    else if (ordering == 1)
+    {
 
         /* ------------------------------------------------------------------ */
-        /* order the block C */
+        /* order the block with COLAMD (C) */
         /* ------------------------------------------------------------------ */
 
-        if (nk <= 3)
+        /* order (and destroy) Ci, returning column permutation in Cp.
+         * COLAMD "cannot" fail since the matrix has already been checked,
+         * and Ci allocated. */
+
+        ok = COLAMD (nk, nk, Cilen, Ci, Cp, NULL, cstats) ;
+        lnz1 = EMPTY ;
+        flops1 = EMPTY ;
+
+        /* copy the permutation from Cp to Pblk */
+        for (k = 0 ; k < nk ; k++)
         {
+            Pblk [k] = Cp [k] ;
+        }
 
-            /* -------------------------------------------------------------- */
-            /* use natural ordering for tiny blocks (3-by-3 or less) */
-            /* -------------------------------------------------------------- */
+    }
+    else
+    {
 
-            for (k = 0 ; k < nk ; k++)
-            {
-                Pblk [k] = k ;
-            }
-            lnz1 = nk * (nk + 1) / 2 ;
-            flops1 = nk * (nk - 1) / 2 + (nk-1)*nk*(2*nk-1) / 6 ;
-            ok = TRUE ;
+        /* ------------------------------------------------------------------ */
+        /* pass the block to the user-provided ordering function */
+        /* ------------------------------------------------------------------ */
 
-        }
-        else if (ordering == 0)
-        {
+        lnz1 = (Common->user_order) (nk, Cp, Ci, Pblk, Common) ;
+        flops1 = EMPTY ;
+        ok = (lnz1 != 0) ;
+    }
 
-            /* -------------------------------------------------------------- */
-            /* order the block with AMD (C+C') */
-            /* -------------------------------------------------------------- */
+    if (!ok)
+    {
+        Info->status = err ;    /* ordering method failed */
+        return ;
+    }
+    Info->status = KLU_OK ;
+    Info->lnz = lnz1 ;
+    Info->flops = flops1 ;
+    Lnz [block] = lnz1 ;
 
-            result = AMD_order (nk, Cp, Ci, Pblk, NULL, amd_Info) ;
-            ok = (result >= AMD_OK) ;
-            if (result == AMD_OUT_OF_MEMORY)
-            {
-                err = KLU_OUT_OF_MEMORY ;
-            }
+    /* ---------------------------------------------------------------------- */
+    /* combine the preordering with the BTF ordering */
+    /* ---------------------------------------------------------------------- */
 
-            /* account for memory usage in AMD */
-            Common->mempeak = MAX (Common->mempeak,
-                Common->memusage + amd_Info [AMD_MEMORY]) ;
+    PRINTF (("Pblk, 1-based:\n")) ;
+    for (k = 0 ; k < nk ; k++)
+    {
+        ASSERT (Pblk [k] + k1 < R [block+1]) ;
+        Q [k + k1] = Qbtf [Pblk [k] + k1] ;
+    }
+    for (k = 0 ; k < nk ; k++)
+    {
+        ASSERT (Pblk [k] + k1 < R [block+1]) ;
+        P [k + k1] = Pbtf [Pblk [k] + k1] ;
+    }
+}
 
-            /* get the ordering statistics from AMD */
-            lnz1 = (Int) (amd_Info [AMD_LNZ]) + nk ;
-            flops1 = 2 * amd_Info [AMD_NMULTSUBS_LU] + amd_Info [AMD_NDIV] ;
-            if (pc == maxnz)
-            {
-                /* get the symmetry of the biggest block */
-                Symbolic->symmetry = amd_Info [AMD_SYMMETRY] ;
-            }
 
-        }
-        else if (ordering == 1)
-        {
+/* ========================================================================== */
+/* === add_block_info ======================================================= */
+/* ========================================================================== */
 
-            /* -------------------------------------------------------------- */
-            /* order the block with COLAMD (C) */
-            /* -------------------------------------------------------------- */
+/* Add the statistics of one block to the totals.  The blocks are added in
+ * order, so the totals do not depend on the order in which the blocks were
+ * ordered. */
 
-            /* order (and destroy) Ci, returning column permutation in Cp.
-             * COLAMD "cannot" fail since the matrix has already been checked,
-             * and Ci allocated. */
+static void add_block_info
+(
+    block_info *Info,
+    double *lnz,
+    double *flops,
+    Int *maxnz,
+    Int *nzoff,
+    KLU_symbolic *Symbolic,
+    KLU_common *Common
+)
+{
+    *nzoff += Info->nzoff ;
+    *maxnz = MAX (*maxnz, Info->nz) ;
 
-            ok = COLAMD (nk, nk, Cilen, Ci, Cp, NULL, cstats) ;
-            lnz1 = EMPTY ;
-            flops1 = EMPTY ;
+    /* account for memory usage in AMD */
+    Common->mempeak = MAX (Common->mempeak, Common->memusage + Info->memory) ;
 
-            /* copy the permutation from Cp to Pblk */
-            for (k = 0 ; k < nk ; k++)
-            {
-                Pblk [k] = Cp [k] ;
-            }
+    /* get the symmetry of the biggest block */
+    if (Info->symmetry != EMPTY && Info->nz == *maxnz)
+    {
+        Symbolic->symmetry = Info->symmetry ;
+    }
 
-        }
-        else
-        {
+    /* keep track of nnz(L) and flops statistics */
+    *lnz = (*lnz == EMPTY || Info->lnz == EMPTY) ? EMPTY : (*lnz + Info->lnz) ;
+    *flops = (*flops == EMPTY || Info->flops == EMPTY) ? EMPTY :
+        (*flops + Info->flops) ;
+}
 
-            /* -------------------------------------------------------------- */
-            /* pass the block to the user-provided ordering function */
-            /* -------------------------------------------------------------- */
 
-            lnz1 = (Common->user_order) (nk, Cp, Ci, Pblk, Common) ;
-            flops1 = EMPTY ;
-            ok = (lnz1 != 0) ;
-        }
+/* ========================================================================== */
+/* === analyze_worker ======================================================= */
+/* ========================================================================== */
+
+/* Order each block, one at a time. */
+
+static Int analyze_worker       /* returns KLU_OK or < 0 if error */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Int nblocks,        /* # of blocks */
+    Int Pbtf [ ],       /* BTF row permutation */
+    Int Qbtf [ ],       /* BTF col permutation */
+    Int R [ ],          /* size n+1, but only Rbtf [0..nblocks] is used */
+    Int Pinv [ ],       /* size n, inverse of Pbtf */
+    Int ordering,       /* what ordering to use (0, 1, or 3 for this routine) */
+
+    /* output only, not defined on input */
+    Int P [ ],          /* size n */
+    Int Q [ ],          /* size n */
+    double Lnz [ ],     /* size n, but only Lnz [0..nblocks-1] is used */
+
+    /* workspace, not defined on input or output */
+    Int Pblk [ ],       /* size maxblock */
+    Int Cp [ ],         /* size maxblock+1 */
+    Int Ci [ ],         /* size MAX (nz+1, Cilen) */
+    Int Cilen,          /* nz+1, or COLAMD_recommended(nz,n,n) for COLAMD */
+
+    /* input/output */
+    KLU_symbolic *Symbolic,
+    KLU_common *Common
+)
+{
+    block_info Info ;
+    double lnz, flops ;
+    Int block, maxnz, nzoff ;
 
-        if (!ok)
+    nzoff = 0 ;
+    lnz = 0 ;
+    maxnz = 0 ;
+    flops = 0 ;
+    Symbolic->symmetry = EMPTY ;        /* only computed by AMD */
+
+    /* ---------------------------------------------------------------------- */
+    /* order each block */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        order_block (block, Ap, Ai, Pbtf, Qbtf, R, Pinv, ordering, P, Q, Lnz,
+            &Info, Pblk, Cp, Ci, Cilen, Common) ;
+        if (Info.status < KLU_OK)
         {
-            return (err) ;  /* ordering method failed */
+            return (Info.status) ;  /* ordering method failed */
         }
+        add_block_info (&Info, &lnz, &flops, &maxnz, &nzoff, Symbolic,
+            Common) ;
+    }
 
-        /* ------------------------------------------------------------------ */
-        /* keep track of nnz(L) and flops statistics */
-        /* ------------------------------------------------------------------ */
+    PRINTF (("nzoff %d  Ap[n] %d\n", nzoff, Ap [n])) ;
+    ASSERT (nzoff >= 0 && nzoff <= Ap [n]) ;
 
-        Lnz [block] = lnz1 ;
-        lnz = (lnz == EMPTY || lnz1 == EMPTY) ? EMPTY : (lnz + lnz1) ;
-        flops = (flops == EMPTY || flops1 == EMPTY) ? EMPTY : (flops + flops1) ;
+    /* return estimates of # of nonzeros in L including diagonal */
+    Symbolic->lnz = lnz ;           /* EMPTY if COLAMD used */
+    Symbolic->unz = lnz ;
+    Symbolic->nzoff = nzoff ;
+    Symbolic->est_flops = flops ;   /* EMPTY if COLAMD or user-ordering used */
+    return (KLU_OK) ;
+}
 
-        /* ------------------------------------------------------------------ */
-        /* combine the preordering with the BTF ordering */
-        /* ------------------------------------------------------------------ */
 
-        PRINTF (("Pblk, 1-based:\n")) ;
-        for (k = 0 ; k < nk ; k++)
+/* ========================================================================== */
+/* === analyze_parallel ===================================================== */
+/* ========================================================================== */
+
+/* Order the blocks in parallel, largest block first, with each thread using
+ * its own workspace.  The workspace of each thread is sized for the largest
+ * block rather than for the whole matrix.  The user ordering function is
+ * never called in parallel, since it need not be thread-safe.  The result
+ * is the same as analyze_worker. */
+
+static Int analyze_parallel     /* returns KLU_OK or < 0 if error */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Int nblocks,        /* # of blocks */
+    Int Pbtf [ ],       /* BTF row permutation */
+    Int Qbtf [ ],       /* BTF col permutation */
+    Int R [ ],          /* size n+1, but only Rbtf [0..nblocks] is used */
+    Int Pinv [ ],       /* size n, inverse of Pbtf */
+    Int ordering,       /* what ordering to use (0 or 1 for this routine) */
+    Int nthreads,       /* number of threads to use */
+
+    /* output only, not defined on input */
+    Int P [ ],          /* size n */
+    Int Q [ ],          /* size n */
+    double Lnz [ ],     /* size n, but only Lnz [0..nblocks-1] is used */
+
+    /* input/output */
+    KLU_symbolic *Symbolic,
+    KLU_common *Common
+)
+{
+    block_info *Info ;
+    double lnz, flops ;
+    Int *Order, *Twork ;
+    size_t wsize, cilen, clen ;
+    Int k1, k2, k, block, maxblock, maxnz, nzoff, pc, p, pend, b, status,
+        ok = TRUE ;
+
+    maxblock = Symbolic->maxblock ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the workspace needed for Ci, from the # of entries in each block */
+    /* ---------------------------------------------------------------------- */
+
+    cilen = 1 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        pc = 0 ;
+        for (k = k1 ; k < k2 ; k++)
         {
-            ASSERT (k + k1 < n) ;
-            ASSERT (Pblk [k] + k1 < n) ;
-            Q [k + k1] = Qbtf [Pblk [k] + k1] ;
+            pend = Ap [Qbtf [k] + 1] ;
+            for (p = Ap [Qbtf [k]] ; p < pend ; p++)
+            {
+                pc += (Pinv [Ai [p]] >= k1) ;
+            }
         }
-        for (k = 0 ; k < nk ; k++)
+        clen = (ordering == 1) ? COLAMD_recommended (pc, k2-k1, k2-k1) :
+            (size_t) (pc+1) ;
+        ok = ok && (clen > 0) ;
+        cilen = MAX (cilen, clen) ;
+    }
+
+    /* Pblk of size maxblock, Cp of size maxblock+1, and Ci for each thread */
+    wsize = KLU_add_size_t (KLU_mult_size_t (maxblock, 2, &ok) + 1, cilen,
+        &ok) ;
+    (void) KLU_mult_size_t (wsize, nthreads, &ok) ;
+    if (!ok || cilen >= Int_MAX)
+    {
+        return (KLU_TOO_LARGE) ;
+    }
+
+    Order = KLU_block_order (Symbolic, Common) ;
+    Info = KLU_malloc (nblocks, sizeof (block_info), Common) ;
+    Twork = KLU_malloc (wsize * nthreads, sizeof (Int), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Order, nblocks, sizeof (Int), Common) ;
+        KLU_free (Info, nblocks, sizeof (block_info), Common) ;
+        KLU_free (Twork, wsize * nthreads, sizeof (Int), Common) ;
+        return (Common->status) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* order the blocks, largest first */
+    /* ---------------------------------------------------------------------- */
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        Int me = SUITESPARSE_OPENMP_GET_THREAD_ID ;
+        Int *Pblk = Twork + me * wsize ;
+        Int *Cp = Pblk + maxblock ;
+        Int *Ci = Cp + maxblock + 1 ;
+        order_block (Order [b], Ap, Ai, Pbtf, Qbtf, R, Pinv, ordering, P, Q,
+            Lnz, &(Info [Order [b]]), Pblk, Cp, Ci, (Int) cilen, Common) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* combine the statistics of each block, in order */
+    /* ---------------------------------------------------------------------- */
+
+    status = KLU_OK ;
+    nzoff = 0 ;
+    lnz = 0 ;
+    maxnz = 0 ;
+    flops = 0 ;
+    Symbolic->symmetry = EMPTY ;        /* only computed by AMD */
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        if (Info [block].status < KLU_OK)
         {
-            ASSERT (k + k1 < n) ;
-            ASSERT (Pblk [k] + k1 < n) ;
-            P [k + k1] = Pbtf [Pblk [k] + k1] ;
+            /* ordering method failed */
+            status = Info [block].status ;
+            break ;
         }
+        add_block_info (&(Info [block]), &lnz, &flops, &maxnz, &nzoff,
+            Symbolic, Common) ;
     }
 
+    KLU_free (Order, nblocks, sizeof (Int), Common) ;
+    KLU_free (Info, nblocks, sizeof (block_info), Common) ;
+    KLU_free (Twork, wsize * nthreads, sizeof (Int), Common) ;
+
     PRINTF (("nzoff %d  Ap[n] %d\n", nzoff, Ap [n])) ;
-    ASSERT (nzoff >= 0 && nzoff <= Ap [n]) ;
+    ASSERT (status < KLU_OK || (nzoff >= 0 && nzoff <= Ap [n])) ;
 
     /* return estimates of # of nonzeros in L including diagonal */
     Symbolic->lnz = lnz ;           /* EMPTY if COLAMD used */
     Symbolic->unz = lnz ;
     Symbolic->nzoff = nzoff ;
     Symbolic->est_flops = flops ;   /* EMPTY if COLAMD or user-ordering used */
-    return (KLU_OK) ;
+    return (status) ;
 }
 
 
@@ -276,7 +494,7 @@ static KLU_symbolic *order_and_analyze  /* returns NULL if error, or a valid
     double *Lnz ;
     Int *Qbtf, *Cp, *Ci, *Pinv, *Pblk, *Pbtf, *P, *Q, *R ;
     Int nblocks, nz, block, maxblock, k1, k2, nk, do_btf, ordering, k, Cilen,
-        *Work ;
+        nthreads, *Work ;
 
     /* ---------------------------------------------------------------------- */
     /* allocate the Symbolic object, and check input matrix */
@@ -401,24 +619,49 @@ static KLU_symbolic *order_and_analyze  /* returns NULL if error, or a valid
     Symbolic->maxblock = maxblock ;
 
     /* ---------------------------------------------------------------------- */
-    /* allocate more workspace, for analyze_worker */
+    /* compute the inverse of Pbtf */
     /* ---------------------------------------------------------------------- */
 
-    Pblk = KLU_malloc (maxblock, sizeof (Int), Common) ;
-    Cp   = KLU_malloc (maxblock + 1, sizeof (Int), Common) ;
-    Ci   = KLU_malloc (MAX (Cilen, nz+1), sizeof (Int), Common) ;
     Pinv = KLU_malloc (n, sizeof (Int), Common) ;
+    if (Common->status == KLU_OK)
+    {
+        for (k = 0 ; k < n ; k++)
+        {
+            ASSERT (Pbtf [k] >= 0 && Pbtf [k] < n) ;
+            Pinv [Pbtf [k]] = k ;
+        }
+    }
 
     /* ---------------------------------------------------------------------- */
     /* order each block of the BTF ordering, and a fill-reducing ordering */
     /* ---------------------------------------------------------------------- */
 
-    if (Common->status == KLU_OK)
+    /* the user ordering function is not assumed to be thread-safe */
+    nthreads = (ordering == 3) ? 1 : KLU_parallel_threads (nblocks, Common) ;
+    Pblk = NULL ;
+    Cp = NULL ;
+    Ci = NULL ;
+
+    if (Common->status == KLU_OK && nthreads > 1)
     {
-        PRINTF (("calling analyze_worker\n")) ;
-        Common->status = analyze_worker (n, Ap, Ai, nblocks, Pbtf, Qbtf, R,
-            ordering, P, Q, Lnz, Pblk, Cp, Ci, Cilen, Pinv, Symbolic, Common) ;
-        PRINTF (("analyze_worker done\n")) ;
+        PRINTF (("calling analyze_parallel\n")) ;
+        Common->status = analyze_parallel (Ap, Ai, nblocks, Pbtf, Qbtf, R,
+            Pinv, ordering, nthreads, P, Q, Lnz, Symbolic, Common) ;
+    }
+    else if (Common->status == KLU_OK)
+    {
+        /* allocate more workspace, for analyze_worker */
+        Pblk = KLU_malloc (maxblock, sizeof (Int), Common) ;
+        Cp   = KLU_malloc (maxblock + 1, sizeof (Int), Common) ;
+        Ci   = KLU_malloc (MAX (Cilen, nz+1), sizeof (Int), Common) ;
+        if (Common->status == KLU_OK)
+        {
+            PRINTF (("calling analyze_worker\n")) ;
+            Common->status = analyze_worker (Ap, Ai, nblocks, Pbtf, Qbtf, R,
+                Pinv, ordering, P, Q, Lnz, Pblk, Cp, Ci, Cilen, Symbolic,
+                Common) ;
+            PRINTF (("analyze_worker done\n")) ;
+        }
     }
 
     /* ---------------------------------------------------------------------- */
@@ -459,6 +702,8 @@ KLU_symbolic *KLU_analyze       /* returns NULL if error, or a valid
     KLU_common *Common
 )
 {
+    KLU_symbolic *Symbolic ;
+    uint64_t hash = 0 ;
 
     /* ---------------------------------------------------------------------- */
     /* get the control parameters for BTF and ordering method */
@@ -471,6 +716,21 @@ KLU_symbolic *KLU_analyze       /* returns NULL if error, or a valid
     Common->status = KLU_OK ;
     Common->structural_rank = EMPTY ;
 
+    /* ---------------------------------------------------------------------- */
+    /* return a copy of an earlier result for the same pattern, if cached */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common->cache != NULL)
+    {
+        Symbolic = KLU_cache_lookup (n, Ap, Ai, &hash, Common) ;
+        if (Symbolic != NULL)
+        {
+            Common->structural_rank = Symbolic->structural_rank ;
+            Common->work = 0 ;
+            return (Symbolic) ;
+        }
+    }
+
     /* ---------------------------------------------------------------------- */
     /* order and analyze */
     /* ---------------------------------------------------------------------- */
@@ -478,11 +738,21 @@ KLU_symbolic *KLU_analyze       /* returns NULL if error, or a valid
     if (Common->ordering == 2)
     {
         /* natural ordering */
-        return (KLU_analyze_given (n, Ap, Ai, NULL, NULL, Common)) ;
+        Symbolic = KLU_analyze_given (n, Ap, Ai, NULL, NULL, Common) ;
     }
     else
     {
         /* order with P and Q */
-        return (order_and_analyze (n, Ap, Ai, Common)) ;
+        Symbolic = order_and_analyze (n, Ap, Ai, Common) ;
     }
+
+    /* ---------------------------------------------------------------------- */
+    /* add the result to the cache */
+    /* ---------------------------------------------------------------------- */
+
+    if (Symbolic != NULL && Common->cache != NULL)
+    {
+        KLU_cache_insert (n, Ap, Ai, hash, Symbolic, Common) ;
+    }
+    return (Symbolic) ;
 }
@@ -121,6 +121,8 @@ KLU_symbolic *KLU_alloc_symbolic
     Symbolic->Q = Q ;
     Symbolic->R = R ;
     Symbolic->Lnz = Lnz ;
+    Symbolic->structural_rank = EMPTY ;     /* only computed by BTF_order */
+    Symbolic->blob = NULL ;
 
     if (Common->status < KLU_OK)
     {
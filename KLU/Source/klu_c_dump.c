@@ -0,0 +1,11 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_c_dump.c: complex float int32_t version of klu_dump
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (C) 2004-2022, University of Florida, All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+#define SINGLE
+#define COMPLEX
+#include "klu_dump.c"
@@ -0,0 +1,334 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_cache: cache of Symbolic objects for KLU_analyze
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (c) 2004-2022, University of Florida.  All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+//------------------------------------------------------------------------------
+
+/* A cache of the Symbolic objects computed by KLU_analyze, so that analyzing
+ * a matrix with the same pattern as one analyzed before, with the same
+ * ordering parameters, returns a copy of the earlier result without
+ * ordering the matrix again.  The cache is attached to Common->cache.
+ *
+ * Each entry keeps a copy of the pattern (Ap and Ai) and of the Symbolic
+ * object.  A pattern is found by its hash, and then compared entry by entry
+ * with the pattern in the cache.  When the cache is full, the oldest entry is
+ * replaced.  The cache is not thread-safe: it should be used by only one
+ * thread at a time, like the rest of the Common object.
+ *
+ * KLU_alloc_cache      create the cache (user-callable)
+ * KLU_free_cache       free the cache (user-callable)
+ * KLU_cache_lookup     find a pattern in the cache
+ * KLU_cache_insert     add a Symbolic object to the cache
+ */
+
+#include "klu_internal.h"
+
+/* one entry in the cache */
+typedef struct
+{
+    uint64_t hash ;             /* hash of the pattern */
+    Int n ;                     /* A is n-by-n */
+    Int *Ap ;                   /* size n+1, column pointers of A */
+    Int *Ai ;                   /* size Ap [n], row indices of A */
+    KLU_common Params ;         /* parameters used by KLU_analyze */
+    KLU_symbolic *Symbolic ;    /* the result of KLU_analyze */
+} cache_entry ;
+
+/* the cache */
+typedef struct
+{
+    Int size ;                  /* max # of entries */
+    Int next ;                  /* entry to replace next, when full */
+    cache_entry *Item ;         /* size size */
+} symbolic_cache ;
+
+/* ========================================================================== */
+/* === pattern_hash ========================================================= */
+/* ========================================================================== */
+
+/* FNV-1a hash of n, Ap, and Ai */
+
+static uint64_t pattern_hash (Int n, Int Ap [ ], Int Ai [ ])
+{
+    uint64_t hash = 14695981039346656037ULL ;
+    Int k, nz = Ap [n] ;
+    hash = (hash ^ (uint64_t) n) * 1099511628211ULL ;
+    for (k = 0 ; k <= n ; k++)
+    {
+        hash = (hash ^ (uint64_t) Ap [k]) * 1099511628211ULL ;
+    }
+    for (k = 0 ; k < nz ; k++)
+    {
+        hash = (hash ^ (uint64_t) Ai [k]) * 1099511628211ULL ;
+    }
+    return (hash) ;
+}
+
+/* ========================================================================== */
+/* === same_params ========================================================== */
+/* ========================================================================== */
+
+/* Return TRUE if KLU_analyze would give the same result with both sets of
+ * parameters */
+
+static Int same_params (KLU_common *A, KLU_common *B)
+{
+    return (A->btf == B->btf && A->ordering == B->ordering &&
+        A->maxwork == B->maxwork && A->user_order == B->user_order &&
+        A->user_data == B->user_data) ;
+}
+
+/* ========================================================================== */
+/* === copy_symbolic ======================================================== */
+/* ========================================================================== */
+
+/* Return a copy of a Symbolic object, or NULL if out of memory */
+
+static KLU_symbolic *copy_symbolic
+(
+    KLU_symbolic *Symbolic,
+    KLU_common *Common
+)
+{
+    KLU_symbolic *S ;
+    Int n = Symbolic->n ;
+
+    S = KLU_malloc (1, sizeof (KLU_symbolic), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        return (NULL) ;
+    }
+    *S = *Symbolic ;
+    S->blob = NULL ;
+    S->P = KLU_malloc (n, sizeof (Int), Common) ;
+    S->Q = KLU_malloc (n, sizeof (Int), Common) ;
+    S->R = KLU_malloc (n+1, sizeof (Int), Common) ;
+    S->Lnz = KLU_malloc (n, sizeof (double), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free_symbolic (&S, Common) ;
+        return (NULL) ;
+    }
+    memcpy (S->P, Symbolic->P, n * sizeof (Int)) ;
+    memcpy (S->Q, Symbolic->Q, n * sizeof (Int)) ;
+    memcpy (S->R, Symbolic->R, (n+1) * sizeof (Int)) ;
+    memcpy (S->Lnz, Symbolic->Lnz, n * sizeof (double)) ;
+    return (S) ;
+}
+
+/* ========================================================================== */
+/* === free_entry =========================================================== */
+/* ========================================================================== */
+
+static void free_entry
+(
+    cache_entry *E,
+    KLU_common *Common
+)
+{
+    if (E->Symbolic != NULL)
+    {
+        KLU_free (E->Ai, E->Ap [E->n], sizeof (Int), Common) ;
+        KLU_free (E->Ap, E->n + 1, sizeof (Int), Common) ;
+        KLU_free_symbolic (&(E->Symbolic), Common) ;
+    }
+    E->Ap = NULL ;
+    E->Ai = NULL ;
+    E->Symbolic = NULL ;
+}
+
+/* ========================================================================== */
+/* === KLU_alloc_cache ====================================================== */
+/* ========================================================================== */
+
+/* Create a cache of up to size Symbolic objects in Common->cache, freeing any
+ * cache already there. */
+
+int KLU_alloc_cache
+(
+    Int size,
+    KLU_common *Common
+)
+{
+    symbolic_cache *Cache ;
+    Int k ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (size <= 0)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    KLU_free_cache (Common) ;
+    Common->status = KLU_OK ;
+
+    Cache = KLU_malloc (1, sizeof (symbolic_cache), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        return (FALSE) ;
+    }
+    Cache->Item = KLU_malloc (size, sizeof (cache_entry), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Cache, 1, sizeof (symbolic_cache), Common) ;
+        return (FALSE) ;
+    }
+    Cache->size = size ;
+    Cache->next = 0 ;
+    for (k = 0 ; k < size ; k++)
+    {
+        Cache->Item [k].Ap = NULL ;
+        Cache->Item [k].Ai = NULL ;
+        Cache->Item [k].Symbolic = NULL ;
+    }
+    Common->cache = Cache ;
+    return (TRUE) ;
+}
+
+/* ========================================================================== */
+/* === KLU_free_cache ======================================================= */
+/* ========================================================================== */
+
+/* Free the cache in Common->cache, if any, and all the objects in it. */
+
+int KLU_free_cache
+(
+    KLU_common *Common
+)
+{
+    symbolic_cache *Cache ;
+    Int k ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Cache = (symbolic_cache *) Common->cache ;
+    if (Cache == NULL)
+    {
+        return (TRUE) ;
+    }
+    for (k = 0 ; k < Cache->size ; k++)
+    {
+        free_entry (&(Cache->Item [k]), Common) ;
+    }
+    KLU_free (Cache->Item, Cache->size, sizeof (cache_entry), Common) ;
+    KLU_free (Cache, 1, sizeof (symbolic_cache), Common) ;
+    Common->cache = NULL ;
+    return (TRUE) ;
+}
+
+/* ========================================================================== */
+/* === KLU_cache_lookup ===================================================== */
+/* ========================================================================== */
+
+/* Return a copy of the Symbolic object for the pattern of A from the cache in
+ * Common->cache, or NULL if it is not there (or if out of memory).  The hash
+ * of the pattern is returned in *hash, for KLU_cache_insert.  Common->status
+ * is not changed.  The pattern of A is not checked; if it is not valid, it
+ * will not be found in the cache. */
+
+KLU_symbolic *KLU_cache_lookup
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    uint64_t *hash,
+    KLU_common *Common
+)
+{
+    symbolic_cache *Cache ;
+    cache_entry *E ;
+    KLU_symbolic *Symbolic ;
+    Int k, nz, status ;
+
+    Cache = (symbolic_cache *) Common->cache ;
+    if (Cache == NULL || n <= 0 || Ap == NULL || Ai == NULL || Ap [0] != 0 ||
+        Ap [n] < 0)
+    {
+        return (NULL) ;
+    }
+    nz = Ap [n] ;
+    *hash = pattern_hash (n, Ap, Ai) ;
+
+    for (k = 0 ; k < Cache->size ; k++)
+    {
+        E = &(Cache->Item [k]) ;
+        if (E->Symbolic != NULL && E->hash == *hash && E->n == n &&
+            E->Ap [n] == nz && same_params (&(E->Params), Common) &&
+            memcmp (E->Ap, Ap, (n+1) * sizeof (Int)) == 0 &&
+            memcmp (E->Ai, Ai, nz * sizeof (Int)) == 0)
+        {
+            status = Common->status ;
+            Symbolic = copy_symbolic (E->Symbolic, Common) ;
+            Common->status = status ;
+            return (Symbolic) ;
+        }
+    }
+    return (NULL) ;
+}
+
+/* ========================================================================== */
+/* === KLU_cache_insert ===================================================== */
+/* ========================================================================== */
+
+/* Add a copy of the pattern of A, and of the Symbolic object that
+ * KLU_analyze found for it, to the cache in Common->cache.  The oldest entry
+ * is replaced if the cache is full.  If out of memory, the Symbolic object is
+ * not added.  Common->status is not changed. */
+
+void KLU_cache_insert
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    uint64_t hash,
+    KLU_symbolic *Symbolic,
+    KLU_common *Common
+)
+{
+    symbolic_cache *Cache ;
+    cache_entry *E ;
+    Int *Ap2, *Ai2, nz, status ;
+    KLU_symbolic *S ;
+
+    Cache = (symbolic_cache *) Common->cache ;
+    if (Cache == NULL)
+    {
+        return ;
+    }
+    nz = Ap [n] ;
+    status = Common->status ;
+
+    /* copy the pattern and the Symbolic object */
+    Ap2 = KLU_malloc (n+1, sizeof (Int), Common) ;
+    Ai2 = KLU_malloc (nz, sizeof (Int), Common) ;
+    S = (Common->status < KLU_OK) ? NULL : copy_symbolic (Symbolic, Common) ;
+    if (S == NULL)
+    {
+        KLU_free (Ap2, n+1, sizeof (Int), Common) ;
+        KLU_free (Ai2, nz, sizeof (Int), Common) ;
+        Common->status = status ;
+        return ;
+    }
+    memcpy (Ap2, Ap, (n+1) * sizeof (Int)) ;
+    memcpy (Ai2, Ai, nz * sizeof (Int)) ;
+
+    /* replace the oldest entry */
+    E = &(Cache->Item [Cache->next]) ;
+    Cache->next = (Cache->next + 1) % Cache->size ;
+    free_entry (E, Common) ;
+    E->hash = hash ;
+    E->n = n ;
+    E->Ap = Ap2 ;
+    E->Ai = Ai2 ;
+    E->Params = *Common ;
+    E->Symbolic = S ;
+}
@@ -0,0 +1,12 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_cl.c: complex float int64_t version of klu
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (C) 2004-2022, University of Florida, All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+#define SINGLE
+#define COMPLEX
+#define DLONG
+#include "klu.c"
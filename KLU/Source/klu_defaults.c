@@ -36,11 +36,16 @@ int KLU_defaults
                                  * 0: none, but check for errors,
                                  * 1: sum, 2: max */
     Common->halt_if_singular = TRUE ;   /* quick halt if matrix is singular */
+    Common->nthreads = 1 ;      /* factorize the BTF blocks sequentially */
+    Common->repivot_tol = 0 ;   /* klu_refactor never changes the pivots */
 
     /* user ordering function and optional argument */
     Common->user_order = NULL ;
     Common->user_data = NULL ;
 
+    /* no cache of Symbolic objects for klu_analyze */
+    Common->cache = NULL ;
+
     /* statistics */
     Common->status = KLU_OK ;
     Common->nrealloc = 0 ;
@@ -52,6 +57,9 @@ int KLU_defaults
     Common->condest = EMPTY ;
     Common->rgrowth = EMPTY ;
     Common->work = 0 ;          /* work done by btf_order */
+    Common->nrefine = 0 ;       /* refinement steps taken by klu_s_refine */
+    Common->berr = EMPTY ;
+    Common->nrepivot = 0 ;      /* blocks repivoted by klu_refactor */
 
     Common->memusage = 0 ;
     Common->mempeak = 0 ;
@@ -15,63 +15,582 @@
 #include "klu_internal.h"
 
 /* ========================================================================== */
-/* === KLU_factor2 ========================================================== */
+/* === dense_start ========================================================== */
 /* ========================================================================== */
 
-static void factor2
+/* Find the largest dense lower right submatrix of the LU factors of a block,
+ * where L (ks:nk-1,ks:nk-1) and U (ks:nk-1,ks:nk-1) have no zero entries.
+ * These often appear in circuit matrices from fill-in.  Returns ks, or nk if
+ * there is no such submatrix of order KLU_DENSE_MIN or more.  KLU_refactor
+ * refactorizes that part of the block with a dense kernel. */
+
+static Int dense_start
+(
+    Int nk,             /* the block is nk-by-nk */
+    Int Llen [ ],       /* size nk, column counts of L */
+    Int Uip [ ],        /* size nk, column pointers of U in LU */
+    Int Ulen [ ],       /* size nk, column counts of U */
+    Unit LU [ ],        /* LU factors of the block */
+    Int Urow [ ]        /* workspace of size nk */
+)
+{
+    Int *Ui ;
+    Int k, p, ks, ulen ;
+
+    /* count the entries in each row of U, excluding the diagonal */
+    for (k = 0 ; k < nk ; k++)
+    {
+        Urow [k] = 0 ;
+    }
+    for (k = 0 ; k < nk ; k++)
+    {
+        /* only the row indices of U (:,k) are needed */
+        Ui = (Int *) (LU + Uip [k]) ;
+        ulen = Ulen [k] ;
+        for (p = 0 ; p < ulen ; p++)
+        {
+            Urow [Ui [p]]++ ;
+        }
+    }
+
+    /* L (:,k) and U (k,:) must be full below and to the right of U (k,k) */
+    for (ks = nk ; ks > 0 ; ks--)
+    {
+        k = ks - 1 ;
+        if (Llen [k] != nk-1-k || Urow [k] != nk-1-k)
+        {
+            break ;
+        }
+    }
+    return ((nk - ks >= KLU_DENSE_MIN) ? ks : nk) ;
+}
+
+
+/* ========================================================================== */
+/* === factor_block ========================================================= */
+/* ========================================================================== */
+
+/* Factorize a single diagonal block of the BTF form.  This depends only on the
+ * entries of A in the block and the off-diagonal entries in the same columns,
+ * so the blocks can be factorized in any order, or in parallel with each
+ * thread using its own X, Iwork, and Common.  Numeric->Pinv must hold the
+ * inverse of Symbolic->P, at least for the rows in this block and the blocks
+ * before it.  The off-diagonal entries in the columns of the block are left
+ * in Offi with their original row indices. */
+
+static void factor_block
 (
     /* inputs, not modified */
+    Int block,
     Int Ap [ ],         /* size n+1, column pointers */
     Int Ai [ ],         /* size nz, row indices */
     Entry Ax [ ],
     KLU_symbolic *Symbolic,
+    double Rs [ ],      /* size n, row scale factors in original order */
 
     /* inputs, modified on output: */
     KLU_numeric *Numeric,
+
+    /* workspace */
+    Entry X [ ],        /* size maxblock */
+    Int Iwork [ ],      /* size 6*maxblock */
+
+    /* outputs */
+    Int *lnz_block,
+    Int *unz_block,
     KLU_common *Common
 )
 {
     double lsize ;
-    double *Lnz, *Rs ;
-    Int *P, *Q, *R, *Pnum, *Offp, *Offi, *Pblock, *Pinv, *Iwork,
-        *Lip, *Uip, *Llen, *Ulen ;
-    Entry *Offx, *X, s, *Udiag ;
+    double *Lnz ;
+    Int *P, *Q, *R, *Pnum, *Offp, *Offi, *Pblock, *Pinv, *Lip, *Uip, *Llen,
+        *Ulen ;
+    Entry *Offx, s, *Udiag ;
     Unit **LUbx ;
-    Int k1, k2, nk, k, block, oldcol, pend, oldrow, n, lnz, unz, p, newrow,
-        nblocks, poff, nzoff, lnz_block, unz_block, scale, max_lnz_block,
-        max_unz_block ;
+    Int k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, poff, scale ;
 
-    /* ---------------------------------------------------------------------- */
-    /* initializations */
-    /* ---------------------------------------------------------------------- */
-
-    /* get the contents of the Symbolic object */
-    n = Symbolic->n ;
     P = Symbolic->P ;
     Q = Symbolic->Q ;
     R = Symbolic->R ;
     Lnz = Symbolic->Lnz ;
-    nblocks = Symbolic->nblocks ;
-    nzoff = Symbolic->nzoff ;
 
     Pnum = Numeric->Pnum ;
     Offp = Numeric->Offp ;
     Offi = Numeric->Offi ;
     Offx = (Entry *) Numeric->Offx ;
-
     Lip = Numeric->Lip ;
     Uip = Numeric->Uip ;
     Llen = Numeric->Llen ;
     Ulen = Numeric->Ulen ;
     LUbx = (Unit **) Numeric->LUbx ;
     Udiag = Numeric->Udiag ;
+    Pinv = Numeric->Pinv ;
+    Pblock = Iwork + 5*((size_t) Symbolic->maxblock) ;
+    scale = Common->scale ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the block is from rows/columns k1 to k2-1 */
+    /* ---------------------------------------------------------------------- */
+
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    PRINTF (("FACTOR BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1,k2-1,nk)) ;
+
+    if (nk == 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* singleton case */
+        /* ------------------------------------------------------------------ */
+
+        poff = Offp [k1] ;
+        oldcol = Q [k1] ;
+        pend = Ap [oldcol+1] ;
+        CLEAR (s) ;
+
+        if (scale <= 0)
+        {
+            /* no scaling */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] ;
+                if (newrow < k1)
+                {
+                    Offi [poff] = oldrow ;
+                    Offx [poff] = Ax [p] ;
+                    poff++ ;
+                }
+                else
+                {
+                    ASSERT (newrow == k1) ;
+                    PRINTF (("singleton block %d", block)) ;
+                    PRINT_ENTRY (Ax [p]) ;
+                    s = Ax [p] ;
+                }
+            }
+        }
+        else
+        {
+            /* row scaling.  NOTE: scale factors are not yet permuted
+             * according to the pivot row permutation, so Rs [oldrow] is
+             * used below.  When the factorization is done, the scale
+             * factors are permuted, so that Rs [newrow] will be used in
+             * klu_solve, klu_tsolve, and klu_rgrowth */
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                oldrow = Ai [p] ;
+                newrow = Pinv [oldrow] ;
+                if (newrow < k1)
+                {
+                    Offi [poff] = oldrow ;
+                    /* Offx [poff] = Ax [p] / Rs [oldrow] ; */
+                    SCALE_DIV_ASSIGN (Offx [poff], Ax [p], Rs [oldrow]) ;
+                    poff++ ;
+                }
+                else
+                {
+                    ASSERT (newrow == k1) ;
+                    PRINTF (("singleton block %d ", block)) ;
+                    PRINT_ENTRY (Ax[p]) ;
+                    SCALE_DIV_ASSIGN (s, Ax [p], Rs [oldrow]) ;
+                }
+            }
+        }
+
+        Udiag [k1] = s ;
+
+        if (IS_ZERO (s))
+        {
+            /* singular singleton */
+            Common->status = KLU_SINGULAR ;
+            if (Common->numerical_rank == EMPTY)
+            {
+                Common->numerical_rank = k1 ;
+                Common->singular_col = oldcol ;
+            }
+            if (Common->halt_if_singular)
+            {
+                return ;
+            }
+        }
+
+        ASSERT (Offp [k1+1] == poff) ;
+        Pnum [k1] = P [k1] ;
+        Numeric->Dstart [block] = 1 ;
+        *lnz_block = 1 ;
+        *unz_block = 1 ;
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* construct and factorize the kth block */
+        /* ------------------------------------------------------------------ */
+
+        if (Lnz [block] < 0)
+        {
+            /* COLAMD was used - no estimate of fill-in */
+            /* use 10 times the nnz in A, plus n */
+            lsize = -(Common->initmem) ;
+        }
+        else
+        {
+            lsize = Common->initmem_amd * Lnz [block] + nk ;
+        }
+
+        /* allocates 1 arrays: LUbx [block] */
+        Numeric->LUsize [block] = KLU_kernel_factor (nk, Ap, Ai, Ax, Q,
+                lsize, &LUbx [block], Udiag + k1, Llen + k1, Ulen + k1,
+                Lip + k1, Uip + k1, Pblock, lnz_block, unz_block,
+                X, Iwork, k1, Pinv, Rs, Offp, Offi, Offx, Common) ;
+
+        if (Common->status < KLU_OK ||
+           (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+        {
+            /* out of memory, invalid inputs, or singular */
+            return ;
+        }
+
+        PRINTF (("\n----------------------- L %d:\n", block)) ;
+        ASSERT (KLU_valid_LU (nk, TRUE, Lip+k1, Llen+k1, LUbx [block])) ;
+        PRINTF (("\n----------------------- U %d:\n", block)) ;
+        ASSERT (KLU_valid_LU (nk, FALSE, Uip+k1, Ulen+k1, LUbx [block])) ;
+
+        if (Lnz [block] == EMPTY)
+        {
+            /* revise estimate for subsequent factorization */
+            Lnz [block] = MAX (*lnz_block, *unz_block) ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* combine the klu row ordering with the symbolic pre-ordering */
+        /* ------------------------------------------------------------------ */
+
+        PRINTF (("Pnum, 1-based:\n")) ;
+        for (k = 0 ; k < nk ; k++)
+        {
+            ASSERT (k + k1 < Symbolic->n) ;
+            ASSERT (Pblock [k] + k1 < Symbolic->n) ;
+            Pnum [k + k1] = P [Pblock [k] + k1] ;
+            PRINTF (("Pnum (%d + %d + 1 = %d) = %d + 1 = %d\n",
+                k, k1, k+k1+1, Pnum [k+k1], Pnum [k+k1]+1)) ;
+        }
+
+        /* the local pivot row permutation Pblock is no longer needed */
+
+        /* ------------------------------------------------------------------ */
+        /* find the dense lower right submatrix of L and U, if any */
+        /* ------------------------------------------------------------------ */
+
+        Numeric->Dstart [block] = dense_start (nk, Llen + k1, Uip + k1,
+            Ulen + k1, LUbx [block], Iwork) ;
+        PRINTF (("block %d dense from column %d\n", block,
+            Numeric->Dstart [block])) ;
+    }
+}
+
+
+/* ========================================================================== */
+/* === factor_parallel ====================================================== */
+/* ========================================================================== */
+
+/* Factorize all the blocks in parallel, largest block first, with each thread
+ * using its own workspace and its own copy of Common.  Returns FALSE if the
+ * workspace cannot be allocated, in which case nothing has been done and the
+ * blocks should be factorized sequentially instead. */
+
+static Int factor_parallel
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Ax [ ],
+    KLU_symbolic *Symbolic,
+    Int nthreads,
+
+    /* inputs, modified on output: */
+    KLU_numeric *Numeric,
+
+    /* outputs */
+    Int *lnz,
+    Int *unz,
+    Int *max_lnz_block,
+    Int *max_unz_block,
+    KLU_common *Common
+)
+{
+    KLU_common *Tcommon ;
+    Int *Order ;
+    Unit *Twork ;
+    size_t wsize, nunits ;
+    Int nblocks, maxblock, tid, b, ok = TRUE, halt = FALSE, status,
+        numerical_rank, singular_col ;
+    Int lnz_all, unz_all, max_lnz, max_unz ;
+
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the workspace for each thread */
+    /* ---------------------------------------------------------------------- */
+
+    /* X of size maxblock, and Iwork of size 6*maxblock, for each thread */
+    wsize = KLU_add_size_t (
+        KLU_mult_size_t (UNITS (Entry, maxblock), sizeof (Unit), &ok),
+        KLU_mult_size_t (maxblock, 6 * sizeof (Int), &ok), &ok) ;
+    nunits = ok ? ((wsize + sizeof (Unit) - 1) / sizeof (Unit)) : 0 ;
+    (void) KLU_mult_size_t (nunits, nthreads, &ok) ;
+    if (!ok)
+    {
+        return (FALSE) ;
+    }
+    status = Common->status ;
+    Order = KLU_block_order (Symbolic, Common) ;
+    Tcommon = KLU_malloc (nthreads, sizeof (KLU_common), Common) ;
+    Twork = KLU_malloc (nunits * nthreads, sizeof (Unit), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Order, nblocks, sizeof (Int), Common) ;
+        KLU_free (Tcommon, nthreads, sizeof (KLU_common), Common) ;
+        KLU_free (Twork, nunits * nthreads, sizeof (Unit), Common) ;
+        Common->status = status ;
+        return (FALSE) ;
+    }
+
+    for (tid = 0 ; tid < nthreads ; tid++)
+    {
+        Tcommon [tid] = *Common ;
+        Tcommon [tid].status = KLU_OK ;
+        Tcommon [tid].nrealloc = 0 ;
+        Tcommon [tid].noffdiag = 0 ;
+        Tcommon [tid].numerical_rank = EMPTY ;
+        Tcommon [tid].singular_col = EMPTY ;
+        Tcommon [tid].memusage = 0 ;
+        Tcommon [tid].mempeak = 0 ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the blocks, largest first */
+    /* ---------------------------------------------------------------------- */
+
+    lnz_all = 0 ;
+    unz_all = 0 ;
+    max_lnz = 1 ;
+    max_unz = 1 ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+        reduction(+:lnz_all,unz_all) reduction(max:max_lnz,max_unz)
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        Int lnz_block = 0, unz_block = 0, rank, col, stop ;
+        Int me = SUITESPARSE_OPENMP_GET_THREAD_ID ;
+        KLU_common *C = &(Tcommon [me]) ;
+        Unit *W = Twork + me * nunits ;
+        Entry *X = (Entry *) W ;
+        Int *Iwork = (Int *) (W + UNITS (Entry, maxblock)) ;
+
+        #pragma omp atomic read
+        stop = halt ;
+        if (stop) continue ;
+
+        /* keep the first singular column found by this thread */
+        rank = C->numerical_rank ;
+        col = C->singular_col ;
+        C->numerical_rank = EMPTY ;
+        factor_block (Order [b], Ap, Ai, Ax, Symbolic, Numeric->Rs, Numeric,
+            X, Iwork, &lnz_block, &unz_block, C) ;
+        if (C->numerical_rank == EMPTY ||
+            (rank != EMPTY && rank < C->numerical_rank))
+        {
+            C->numerical_rank = rank ;
+            C->singular_col = col ;
+        }
+
+        if (C->status < KLU_OK ||
+           (C->status == KLU_SINGULAR && C->halt_if_singular))
+        {
+            /* out of memory, invalid inputs, or singular */
+            #pragma omp atomic write
+            halt = TRUE ;
+            continue ;
+        }
+
+        lnz_all += lnz_block ;
+        unz_all += unz_block ;
+        max_lnz = MAX (max_lnz, lnz_block) ;
+        max_unz = MAX (max_unz, unz_block) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* combine the statistics of each thread */
+    /* ---------------------------------------------------------------------- */
+
+    numerical_rank = EMPTY ;
+    singular_col = EMPTY ;
+    for (tid = 0 ; tid < nthreads ; tid++)
+    {
+        KLU_common *C = &(Tcommon [tid]) ;
+        if (C->status < KLU_OK)
+        {
+            Common->status = C->status ;
+        }
+        else if (C->status == KLU_SINGULAR && Common->status == KLU_OK)
+        {
+            Common->status = KLU_SINGULAR ;
+        }
+        if (C->numerical_rank != EMPTY &&
+            (numerical_rank == EMPTY || C->numerical_rank < numerical_rank))
+        {
+            numerical_rank = C->numerical_rank ;
+            singular_col = C->singular_col ;
+        }
+        Common->nrealloc += C->nrealloc ;
+        Common->noffdiag += C->noffdiag ;
+        /* the peak is an upper bound, since the threads need not reach their
+         * peak usage at the same time */
+        Common->mempeak = MAX (Common->mempeak,
+            Common->memusage + C->mempeak) ;
+        Common->memusage += C->memusage ;
+    }
+    if (numerical_rank != EMPTY)
+    {
+        Common->numerical_rank = numerical_rank ;
+        Common->singular_col = singular_col ;
+    }
+
+    KLU_free (Order, nblocks, sizeof (Int), Common) ;
+    KLU_free (Tcommon, nthreads, sizeof (KLU_common), Common) ;
+    KLU_free (Twork, nunits * nthreads, sizeof (Unit), Common) ;
+
+    *lnz = lnz_all ;
+    *unz = unz_all ;
+    *max_lnz_block = max_lnz ;
+    *max_unz_block = max_unz ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_repivot_block ==================================================== */
+/* ========================================================================== */
+
+/* Factorize a single block again with partial pivoting, for KLU_refactor,
+ * when the pivots found by KLU_factor are no longer stable for the new values
+ * of A.  The old LU factors of the block are freed and replaced; the rest of
+ * the Numeric object is left as KLU_factor would leave it.  On input,
+ * Numeric->Pinv must hold the inverse of Symbolic->P, and Rs (NULL if the
+ * matrix is not scaled) the row scale factors in their original order.  On
+ * output, Pnum holds the new pivot rows of the block, and Offi the original
+ * row indices of the off-diagonal entries in its columns; the caller must
+ * then recompute Pinv and apply it to Offi.  Numeric->Xwork and Numeric->Iwork
+ * are used as workspace.  Not for singletons, or for a Numeric object held in
+ * a blob from KLU_deserialize_numeric. */
+
+void KLU_repivot_block
+(
+    /* inputs, not modified */
+    Int block,
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Ax [ ],
+    KLU_symbolic *Symbolic,
+    double Rs [ ],      /* size n, row scale factors in original order */
+
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    Int *Llen, *Ulen ;
+    Int k1, k2, k, lnz_old, unz_old, lnz_block, unz_block ;
+
+    k1 = Symbolic->R [block] ;
+    k2 = Symbolic->R [block+1] ;
+    ASSERT (k2 - k1 > 1 && Numeric->blob == NULL) ;
+    Llen = Numeric->Llen ;
+    Ulen = Numeric->Ulen ;
+
+    /* free the old LU factors of the block */
+    lnz_old = 0 ;
+    unz_old = 0 ;
+    for (k = k1 ; k < k2 ; k++)
+    {
+        lnz_old += Llen [k] + 1 ;
+        unz_old += Ulen [k] + 1 ;
+    }
+    Numeric->LUbx [block] = KLU_free (Numeric->LUbx [block],
+        Numeric->LUsize [block], sizeof (Unit), Common) ;
+    Numeric->LUsize [block] = 0 ;
+
+    /* factorize the block with partial pivoting */
+    lnz_block = 0 ;
+    unz_block = 0 ;
+    factor_block (block, Ap, Ai, Ax, Symbolic, Rs, Numeric,
+        (Entry *) Numeric->Xwork, Numeric->Iwork, &lnz_block, &unz_block,
+        Common) ;
+    if (Common->status < KLU_OK)
+    {
+        return ;
+    }
+
+    /* update the statistics */
+    Numeric->lnz += lnz_block - lnz_old ;
+    Numeric->unz += unz_block - unz_old ;
+    Numeric->max_lnz_block = MAX (Numeric->max_lnz_block, lnz_block) ;
+    Numeric->max_unz_block = MAX (Numeric->max_unz_block, unz_block) ;
+}
+
+
+/* ========================================================================== */
+/* === KLU_factor2 ========================================================== */
+/* ========================================================================== */
+
+static void factor2
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Ax [ ],
+    KLU_symbolic *Symbolic,
+
+    /* inputs, modified on output: */
+    KLU_numeric *Numeric,
+    KLU_common *Common
+)
+{
+    double *Rs ;
+    Int *P, *Q, *R, *Pnum, *Offp, *Offi, *Pinv, *Iwork ;
+    Entry *X ;
+    Int k1, k2, k, block, oldcol, pend, n, lnz, unz, p, nblocks, poff, nzoff,
+        lnz_block, unz_block, scale, max_lnz_block, max_unz_block, nthreads ;
+#ifndef NDEBUG
+    Entry *Offx = (Entry *) Numeric->Offx ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* initializations */
+    /* ---------------------------------------------------------------------- */
+
+    /* get the contents of the Symbolic object */
+    n = Symbolic->n ;
+    P = Symbolic->P ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    nzoff = Symbolic->nzoff ;
+
+    Pnum = Numeric->Pnum ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
 
     Rs = Numeric->Rs ;
     Pinv = Numeric->Pinv ;
     X = (Entry *) Numeric->Xwork ;              /* X is of size n */
     Iwork = Numeric->Iwork ;                    /* 5*maxblock for KLU_factor */
                                                 /* 1*maxblock for Pblock */
-    Pblock = Iwork + 5*((size_t) Symbolic->maxblock) ;
     Common->nrealloc = 0 ;
     scale = Common->scale ;
     max_lnz_block = 1 ;
@@ -98,7 +617,6 @@ static void factor2
     lnz = 0 ;
     unz = 0 ;
     Common->noffdiag = 0 ;
-    Offp [0] = 0 ;
 
     /* ---------------------------------------------------------------------- */
     /* optionally check input matrix and compute scale factors */
@@ -113,7 +631,7 @@ static void factor2
          * the scale factors are permuted according to the final pivot row
          * permutation, so that Rs [k] is the scale factor for the kth row of
          * A(p,q) where p and q are the final row and column permutations. */
-        KLU_scale (scale, n, Ap, Ai, (double *) Ax, Rs, Pnum, Common) ;
+        KLU_scale (scale, n, Ap, Ai, (Scalar *) Ax, Rs, Pnum, Common) ;
         if (Common->status < KLU_OK)
         {
             /* matrix is invalid */
@@ -129,126 +647,54 @@ static void factor2
 #endif
 
     /* ---------------------------------------------------------------------- */
-    /* factor each block using klu */
+    /* find the column pointers of the off-diagonal part */
     /* ---------------------------------------------------------------------- */
 
+    /* The pattern of the off-diagonal part depends only on the symbolic
+     * analysis, so Offp can be found before any block is factorized.  Each
+     * block then writes only to its own part of Offi and Offx. */
+    Offp [0] = 0 ;
     for (block = 0 ; block < nblocks ; block++)
     {
-
-        /* ------------------------------------------------------------------ */
-        /* the block is from rows/columns k1 to k2-1 */
-        /* ------------------------------------------------------------------ */
-
         k1 = R [block] ;
         k2 = R [block+1] ;
-        nk = k2 - k1 ;
-        PRINTF (("FACTOR BLOCK %d, k1 %d k2-1 %d nk %d\n", block, k1,k2-1,nk)) ;
-
-        if (nk == 1)
+        for (k = k1 ; k < k2 ; k++)
         {
-
-            /* -------------------------------------------------------------- */
-            /* singleton case */
-            /* -------------------------------------------------------------- */
-
-            poff = Offp [k1] ;
-            oldcol = Q [k1] ;
+            oldcol = Q [k] ;
             pend = Ap [oldcol+1] ;
-            CLEAR (s) ;
-
-            if (scale <= 0)
+            poff = Offp [k] ;
+            for (p = Ap [oldcol] ; p < pend ; p++)
             {
-                /* no scaling */
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] ;
-                    if (newrow < k1)
-                    {
-                        Offi [poff] = oldrow ;
-                        Offx [poff] = Ax [p] ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        ASSERT (newrow == k1) ;
-                        PRINTF (("singleton block %d", block)) ;
-                        PRINT_ENTRY (Ax [p]) ;
-                        s = Ax [p] ;
-                    }
-                }
-            }
-            else
-            {
-                /* row scaling.  NOTE: scale factors are not yet permuted
-                 * according to the pivot row permutation, so Rs [oldrow] is
-                 * used below.  When the factorization is done, the scale
-                 * factors are permuted, so that Rs [newrow] will be used in
-                 * klu_solve, klu_tsolve, and klu_rgrowth */
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] ;
-                    if (newrow < k1)
-                    {
-                        Offi [poff] = oldrow ;
-                        /* Offx [poff] = Ax [p] / Rs [oldrow] ; */
-                        SCALE_DIV_ASSIGN (Offx [poff], Ax [p], Rs [oldrow]) ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        ASSERT (newrow == k1) ;
-                        PRINTF (("singleton block %d ", block)) ;
-                        PRINT_ENTRY (Ax[p]) ;
-                        SCALE_DIV_ASSIGN (s, Ax [p], Rs [oldrow]) ;
-                    }
-                }
-            }
-
-            Udiag [k1] = s ;
-
-            if (IS_ZERO (s))
-            {
-                /* singular singleton */
-                Common->status = KLU_SINGULAR ;
-                Common->numerical_rank = k1 ;
-                Common->singular_col = oldcol ;
-                if (Common->halt_if_singular)
+                if (Pinv [Ai [p]] < k1)
                 {
-                    return ;
+                    poff++ ;
                 }
             }
+            Offp [k+1] = poff ;
+        }
+    }
 
-            Offp [k1+1] = poff ;
-            Pnum [k1] = P [k1] ;
-            lnz++ ;
-            unz++ ;
+    /* ---------------------------------------------------------------------- */
+    /* factor each block using klu */
+    /* ---------------------------------------------------------------------- */
 
+    nthreads = KLU_parallel_threads (nblocks, Common) ;
+    if (nthreads > 1 && factor_parallel (Ap, Ai, Ax, Symbolic, nthreads,
+        Numeric, &lnz, &unz, &max_lnz_block, &max_unz_block, Common))
+    {
+        if (Common->status < KLU_OK ||
+           (Common->status == KLU_SINGULAR && Common->halt_if_singular))
+        {
+            /* out of memory, invalid inputs, or singular */
+            return ;
         }
-        else
+    }
+    else
+    {
+        for (block = 0 ; block < nblocks ; block++)
         {
-
-            /* -------------------------------------------------------------- */
-            /* construct and factorize the kth block */
-            /* -------------------------------------------------------------- */
-
-            if (Lnz [block] < 0)
-            {
-                /* COLAMD was used - no estimate of fill-in */
-                /* use 10 times the nnz in A, plus n */
-                lsize = -(Common->initmem) ;
-            }
-            else
-            {
-                lsize = Common->initmem_amd * Lnz [block] + nk ;
-            }
-
-            /* allocates 1 arrays: LUbx [block] */
-            Numeric->LUsize [block] = KLU_kernel_factor (nk, Ap, Ai, Ax, Q,
-                    lsize, &LUbx [block], Udiag + k1, Llen + k1, Ulen + k1,
-                    Lip + k1, Uip + k1, Pblock, &lnz_block, &unz_block,
-                    X, Iwork, k1, Pinv, Rs, Offp, Offi, Offx, Common) ;
+            factor_block (block, Ap, Ai, Ax, Symbolic, Rs, Numeric, X, Iwork,
+                &lnz_block, &unz_block, Common) ;
 
             if (Common->status < KLU_OK ||
                (Common->status == KLU_SINGULAR && Common->halt_if_singular))
@@ -257,41 +703,17 @@ static void factor2
                 return ;
             }
 
-            PRINTF (("\n----------------------- L %d:\n", block)) ;
-            ASSERT (KLU_valid_LU (nk, TRUE, Lip+k1, Llen+k1, LUbx [block])) ;
-            PRINTF (("\n----------------------- U %d:\n", block)) ;
-            ASSERT (KLU_valid_LU (nk, FALSE, Uip+k1, Ulen+k1, LUbx [block])) ;
-
             /* -------------------------------------------------------------- */
             /* get statistics */
             /* -------------------------------------------------------------- */
 
             lnz += lnz_block ;
             unz += unz_block ;
-            max_lnz_block = MAX (max_lnz_block, lnz_block) ;
-            max_unz_block = MAX (max_unz_block, unz_block) ;
-
-            if (Lnz [block] == EMPTY)
+            if (R [block+1] - R [block] > 1)
             {
-                /* revise estimate for subsequent factorization */
-                Lnz [block] = MAX (lnz_block, unz_block) ;
+                max_lnz_block = MAX (max_lnz_block, lnz_block) ;
+                max_unz_block = MAX (max_unz_block, unz_block) ;
             }
-
-            /* -------------------------------------------------------------- */
-            /* combine the klu row ordering with the symbolic pre-ordering */
-            /* -------------------------------------------------------------- */
-
-            PRINTF (("Pnum, 1-based:\n")) ;
-            for (k = 0 ; k < nk ; k++)
-            {
-                ASSERT (k + k1 < n) ;
-                ASSERT (Pblock [k] + k1 < n) ;
-                Pnum [k + k1] = P [Pblock [k] + k1] ;
-                PRINTF (("Pnum (%d + %d + 1 = %d) = %d + 1 = %d\n",
-                    k, k1, k+k1+1, Pnum [k+k1], Pnum [k+k1]+1)) ;
-            }
-
-            /* the local pivot row permutation Pblock is no longer needed */
         }
     }
     ASSERT (nzoff == Offp [n]) ;
@@ -349,6 +771,7 @@ static void factor2
     {
         PRINTF (("\n ------------ KLU_BTF_FACTOR done, nblocks %d\n",nblocks));
         Entry ss, *Udiag = Numeric->Udiag ;
+        Int nk ;
         for (block = 0 ; block < nblocks && Common->status == KLU_OK ; block++)
         {
             k1 = R [block] ;
@@ -393,7 +816,7 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     /* --- inputs --- */
     Int Ap [ ],         /* size n+1, column pointers */
     Int Ai [ ],         /* size nz, row indices */
-    double Ax [ ],
+    Scalar Ax [ ],
     KLU_symbolic *Symbolic,
     /* -------------- */
     KLU_common *Common
@@ -401,7 +824,7 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
 {
     Int n, nzoff, nblocks, maxblock, k, ok = TRUE ;
     KLU_numeric *Numeric ;
-    size_t n1, nzoff1, s, b6, n3 ;
+    size_t n1, nzoff1, s, b6, n3, w, g ;
 
     if (Common == NULL)
     {
@@ -457,6 +880,7 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     Numeric->n = n ;
     Numeric->nblocks = nblocks ;
     Numeric->nzoff = nzoff ;
+    Numeric->blob = NULL ;
     Numeric->Pnum = KLU_malloc (n, sizeof (Int), Common) ;
     Numeric->Offp = KLU_malloc (n1, sizeof (Int), Common) ;
     Numeric->Offi = KLU_malloc (nzoff1, sizeof (Int), Common) ;
@@ -468,6 +892,14 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     Numeric->Ulen = KLU_malloc (n, sizeof (Int), Common) ;
 
     Numeric->LUsize = KLU_malloc (nblocks, sizeof (size_t), Common) ;
+    if (Numeric->LUsize != NULL)
+    {
+        for (k = 0 ; k < nblocks ; k++)
+        {
+            /* singletons have no LUbx [k] */
+            Numeric->LUsize [k] = 0 ;
+        }
+    }
 
     Numeric->LUbx = KLU_malloc (nblocks, sizeof (Unit *), Common) ;
     if (Numeric->LUbx != NULL)
@@ -479,6 +911,7 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
     }
 
     Numeric->Udiag = KLU_malloc (n, sizeof (Entry), Common) ;
+    Numeric->Dstart = KLU_malloc (nblocks, sizeof (Int), Common) ;
 
     if (Common->scale > 0)
     {
@@ -498,14 +931,23 @@ KLU_numeric *KLU_factor         /* returns NULL if error, or a valid
      * uses an Xwork of size 2n.  Total size is:
      *
      *    n*sizeof(Entry) + max (6*maxblock*sizeof(Int), 3*n*sizeof(Entry))
+     *      + nblocks*sizeof(double)
+     *
+     * with the first two terms rounded up to a whole Unit and double,
+     * respectively, so that Iwork is aligned even if an Entry is smaller than
+     * an Int.  The last term holds the pivot growth of each block for
+     * KLU_refactor (see KLU_GROWTH).
      */
-    s = KLU_mult_size_t (n, sizeof (Entry), &ok) ;
+    s = KLU_mult_size_t (UNITS (Entry, n), sizeof (Unit), &ok) ;
     n3 = KLU_mult_size_t (n, 3 * sizeof (Entry), &ok) ;
     b6 = KLU_mult_size_t (maxblock, 6 * sizeof (Int), &ok) ;
-    Numeric->worksize = KLU_add_size_t (s, MAX (n3, b6), &ok) ;
+    w = KLU_add_size_t (MAX (n3, b6), sizeof (double) - 1, &ok) ;
+    w -= w % sizeof (double) ;
+    g = KLU_mult_size_t (nblocks, sizeof (double), &ok) ;
+    Numeric->worksize = KLU_add_size_t (KLU_add_size_t (s, w, &ok), g, &ok) ;
     Numeric->Work = KLU_malloc (Numeric->worksize, 1, Common) ;
     Numeric->Xwork = Numeric->Work ;
-    Numeric->Iwork = (Int *) ((Entry *) Numeric->Xwork + n) ;
+    Numeric->Iwork = (Int *) ((Unit *) Numeric->Xwork + UNITS (Entry, n)) ;
     if (!ok || Common->status < KLU_OK)
     {
         /* out of memory or problem too large */
@@ -40,6 +40,17 @@ int KLU_free_numeric
     LUsize = Numeric->LUsize ;
 
     LUbx = (Unit **) Numeric->LUbx ;
+    if (Numeric->blob != NULL)
+    {
+        /* the arrays are held in a blob owned by the user, except for the
+         * LUbx array of pointers into the blob, and the workspace */
+        KLU_free (Numeric->LUbx, nblocks, sizeof (Unit *), Common) ;
+        KLU_free (Numeric->Work, Numeric->worksize, 1, Common) ;
+        KLU_free (Numeric, 1, sizeof (KLU_numeric), Common) ;
+        *NumericHandle = NULL ;
+        return (TRUE) ;
+    }
+
     if (LUbx != NULL)
     {
         for (block = 0 ; block < nblocks ; block++)
@@ -68,6 +79,8 @@ int KLU_free_numeric
     KLU_free (Numeric->Rs,   n, sizeof (double), Common) ;
     KLU_free (Numeric->Pinv, n, sizeof (Int), Common) ;
 
+    KLU_free (Numeric->Dstart, nblocks, sizeof (Int), Common) ;
+
     KLU_free (Numeric->Work, Numeric->worksize, 1, Common) ;
 
     KLU_free (Numeric, 1, sizeof (KLU_numeric), Common) ;
@@ -30,10 +30,14 @@ int KLU_free_symbolic
     }
     Symbolic = *SymbolicHandle ;
     n = Symbolic->n ;
-    KLU_free (Symbolic->P, n, sizeof (Int), Common) ;
-    KLU_free (Symbolic->Q, n, sizeof (Int), Common) ;
-    KLU_free (Symbolic->R, n+1, sizeof (Int), Common) ;
-    KLU_free (Symbolic->Lnz, n, sizeof (double), Common) ;
+    if (Symbolic->blob == NULL)
+    {
+        /* the arrays are not held in a blob owned by the user */
+        KLU_free (Symbolic->P, n, sizeof (Int), Common) ;
+        KLU_free (Symbolic->Q, n, sizeof (Int), Common) ;
+        KLU_free (Symbolic->R, n+1, sizeof (Int), Common) ;
+        KLU_free (Symbolic->Lnz, n, sizeof (double), Common) ;
+    }
     KLU_free (Symbolic, 1, sizeof (KLU_symbolic), Common) ;
     *SymbolicHandle = NULL ;
     return (TRUE) ;
@@ -232,7 +232,7 @@ static void construct_column
     Int scale,      /* 0: no scaling, nonzero: scale the rows with Rs */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal column pointers (not modified) */
     Int Offi [ ],
     Entry Offx [ ]
 )
@@ -295,7 +295,9 @@ static void construct_column
         }
     }
 
-    Offp [kglobal+1] = poff ;   /* start of the next col of off-diag part */
+    /* Offp is computed by KLU_factor before any block is factorized, so that
+     * the blocks can be factorized in any order */
+    ASSERT (Offp [kglobal+1] == poff) ;
 }
 
 
@@ -670,7 +672,7 @@ size_t KLU_kernel   /* final size of LU on output */
     double Rs [ ],      /* scale factors for A */
 
     /* inputs, modified on output */
-    Int Offp [ ],   /* off-diagonal matrix (modified by this routine) */
+    Int Offp [ ],   /* off-diagonal column pointers (not modified) */
     Int Offi [ ],
     Entry Offx [ ],
     /* --------------- */
@@ -730,9 +732,6 @@ size_t KLU_kernel   /* final size of LU on output */
         P [k] = k ;
         Pinv [k] = FLIP (k) ;   /* mark all rows as non-pivotal */
     }
-    /* initialize the construction of the off-diagonal matrix */
-    Offp [0] = 0 ;
-
     /* P [k] = row means that UNFLIP (Pinv [row]) = k, and visa versa.
      * If row is pivotal, then Pinv [row] >= 0.  A row is initially "flipped"
      * (Pinv [k] < EMPTY), and then marked "unflipped" when it becomes
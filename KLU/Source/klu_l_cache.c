@@ -0,0 +1,10 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_l_cache.c: int64_t version of klu_cache
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (C) 2004-2022, University of Florida, All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+#define DLONG
+#include "klu_cache.c"
@@ -13,6 +13,8 @@
  * KLU_malloc                   malloc wrapper
  * KLU_free                     free wrapper
  * KLU_realloc                  realloc wrapper
+ * KLU_blob_array               place an array in a serialized blob
+ * KLU_blob_read                get an array from a serialized blob
  */
 
 #include "klu_internal.h"
@@ -45,6 +47,62 @@ size_t KLU_mult_size_t (size_t a, size_t k, Int *ok)
     return ((*ok) ? s : ((size_t) -1)) ;
 }
 
+/* ========================================================================== */
+/* === KLU_blob_array ======================================================= */
+/* ========================================================================== */
+
+/* Returns the offset of an array of n items of the given size in a serialized
+ * Symbolic or Numeric object, if the array is placed after the byte at the
+ * given offset, on a KLU_BLOB_ALIGN boundary.  The offset of the first byte
+ * after the array is returned in *next.  *ok is set to FALSE on overflow. */
+
+size_t KLU_blob_array
+(
+    size_t offset,
+    size_t n,
+    size_t size,
+    size_t *next,
+    Int *ok
+)
+{
+    offset = KLU_add_size_t (offset, KLU_BLOB_ALIGN - 1, ok) ;
+    offset -= offset % KLU_BLOB_ALIGN ;
+    (*next) = KLU_add_size_t (offset, KLU_mult_size_t (n, size, ok), ok) ;
+    return (offset) ;
+}
+
+/* ========================================================================== */
+/* === KLU_blob_read ======================================================== */
+/* ========================================================================== */
+
+/* Returns an array of n items of the given size, held at the given offset in
+ * a serialized Symbolic or Numeric object.  If wrap is true, this is a
+ * pointer into the blob itself.  Otherwise the array is copied into newly
+ * allocated space, and NULL is returned if out of memory. */
+
+void *KLU_blob_read
+(
+    int8_t *blob,
+    size_t offset,
+    size_t n,
+    size_t size,
+    int wrap,
+    KLU_common *Common
+)
+{
+    void *p ;
+    if (wrap)
+    {
+        return ((void *) (blob + offset)) ;
+    }
+    p = KLU_malloc (n, size, Common) ;
+    if (p != NULL)
+    {
+        memcpy (p, blob + offset, n * size) ;
+    }
+    return (p) ;
+}
+
 /* ========================================================================== */
 /* === KLU_malloc =========================================================== */
 /* ========================================================================== */
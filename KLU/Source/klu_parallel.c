@@ -0,0 +1,101 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_parallel: support for factorizing BTF blocks in parallel
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (c) 2004-2022, University of Florida.  All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+//------------------------------------------------------------------------------
+
+/* The diagonal blocks of the BTF form are independent of each other in
+ * KLU_factor and KLU_refactor, so they can be factorized in parallel.
+ *
+ * KLU_parallel_threads         number of threads to use
+ * KLU_block_order              blocks in order of decreasing size
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === KLU_parallel_threads ================================================= */
+/* ========================================================================== */
+
+/* Returns the number of threads to use to factorize nblocks blocks, from
+ * Common->nthreads.  Returns 1 if KLU is compiled without OpenMP. */
+
+Int KLU_parallel_threads
+(
+    Int nblocks,
+    KLU_common *Common
+)
+{
+    Int nthreads = 1 ;
+#ifdef _OPENMP
+    nthreads = Common->nthreads ;
+    if (nthreads <= 0)
+    {
+        nthreads = SUITESPARSE_OPENMP_MAX_THREADS ;
+    }
+    nthreads = MIN (nthreads, nblocks) ;
+    nthreads = MAX (nthreads, 1) ;
+#endif
+    return (nthreads) ;
+}
+
+/* ========================================================================== */
+/* === KLU_block_order ====================================================== */
+/* ========================================================================== */
+
+/* Returns a list of the blocks in order of decreasing size, so that the
+ * largest blocks are started first when they are factorized in parallel.
+ * Blocks of the same size are kept in their natural order.  The list is of
+ * size nblocks, and must be freed with KLU_free.  Returns NULL if out of
+ * memory. */
+
+Int *KLU_block_order
+(
+    KLU_symbolic *Symbolic,
+    KLU_common *Common
+)
+{
+    Int *Order, *Head, *R, nblocks, maxblock, block, nk, k ;
+
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+    R = Symbolic->R ;
+
+    Order = KLU_malloc (nblocks, sizeof (Int), Common) ;
+    Head = KLU_malloc (maxblock + 2, sizeof (Int), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Order, nblocks, sizeof (Int), Common) ;
+        KLU_free (Head, maxblock + 2, sizeof (Int), Common) ;
+        return (NULL) ;
+    }
+
+    /* count the blocks of each size, largest size first */
+    for (nk = 0 ; nk <= maxblock + 1 ; nk++)
+    {
+        Head [nk] = 0 ;
+    }
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        nk = R [block+1] - R [block] ;
+        Head [maxblock - nk + 1]++ ;
+    }
+    for (k = 1 ; k <= maxblock + 1 ; k++)
+    {
+        Head [k] += Head [k-1] ;
+    }
+
+    /* place the blocks in order */
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        nk = R [block+1] - R [block] ;
+        Order [Head [maxblock - nk]++] = block ;
+    }
+
+    KLU_free (Head, maxblock + 2, sizeof (Int), Common) ;
+    return (Order) ;
+}
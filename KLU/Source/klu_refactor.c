@@ -10,12 +10,954 @@
 
 /* Factor the matrix, after ordering and analyzing it with KLU_analyze, and
  * factoring it once with KLU_factor.  This routine cannot do any numerical
- * pivoting.  The pattern of the input matrix (Ap, Ai) must be identical to
- * the pattern given to KLU_factor.
+ * pivoting, unless Common->repivot_tol > 0.  The pattern of the input matrix
+ * (Ap, Ai) must be identical to the pattern given to KLU_factor.
+ *
+ * While each block is refactorized, the reciprocal pivot growth of the block
+ * is estimated from the largest entries of each column of A and U, as in
+ * KLU_rgrowth, but without another pass over A and U.  The smallest estimate
+ * is returned in Common->rgrowth, and the cheap estimate of the reciprocal
+ * condition number (as in KLU_rcond) in Common->rcond.  If Common->repivot_tol
+ * is greater than zero, each block whose estimate falls below it, or that has
+ * a zero pivot, is factorized again with partial pivoting, as KLU_factor
+ * would do.  The other blocks keep their pivots.
  */
 
 #include "klu_internal.h"
 
+/* magnitude of an entry, for the pivot growth estimate.  For the complex case,
+ * this is abs (real) + abs (imag), which is cheaper than abs and within a
+ * factor of sqrt (2) of it. */
+#ifdef COMPLEX
+#define MAGNITUDE(a) (SCALAR_ABS (REAL (a)) + SCALAR_ABS (IMAG (a)))
+#else
+#define MAGNITUDE(a) SCALAR_ABS (a)
+#endif
+
+
+/* ========================================================================== */
+/* === dense_lu ============================================================= */
+/* ========================================================================== */
+
+/* LU factorization of a dense nd-by-nd matrix D, held by column, with no
+ * pivoting, in panels of KLU_DENSE_PANEL columns.  Each panel is factorized
+ * and then applied to each column to its right, all at once, so that the
+ * column stays in cache.  On output, the strictly lower part of D holds L
+ * (with a unit diagonal not stored) and the upper part holds U.  Returns the
+ * index of the first zero pivot, or EMPTY if there is none.  If
+ * halt_if_singular is true, D is not factorized past the first zero pivot. */
+
+static Int dense_lu
+(
+    Int nd,
+    Entry D [ ],        /* size nd*nd */
+    Int halt_if_singular
+)
+{
+    Entry ukk, ujk, *Dk, *Dj ;
+    Int i, j, k, kb, kend, singular ;
+
+    singular = EMPTY ;
+    for (kb = 0 ; kb < nd ; kb += KLU_DENSE_PANEL)
+    {
+        kend = MIN (kb + KLU_DENSE_PANEL, nd) ;
+
+        /* factorize the panel D (kb:nd-1, kb:kend-1) */
+        for (k = kb ; k < kend ; k++)
+        {
+            Dk = D + k*nd ;
+            ukk = Dk [k] ;
+            if (IS_ZERO (ukk))
+            {
+                /* matrix is numerically singular */
+                if (singular == EMPTY)
+                {
+                    singular = k ;
+                }
+                if (halt_if_singular)
+                {
+                    /* do not continue the factorization */
+                    return (singular) ;
+                }
+            }
+            for (i = k+1 ; i < nd ; i++)
+            {
+                /* L (i,k) = D (i,k) / U (k,k) */
+                DIV (Dk [i], Dk [i], ukk) ;
+            }
+            for (j = k+1 ; j < kend ; j++)
+            {
+                Dj = D + j*nd ;
+                ujk = Dj [k] ;
+                for (i = k+1 ; i < nd ; i++)
+                {
+                    /* D (i,j) -= L (i,k) * U (k,j) */
+                    MULT_SUB (Dj [i], Dk [i], ujk) ;
+                }
+            }
+        }
+
+        /* apply the panel to the columns to its right */
+        for (j = kend ; j < nd ; j++)
+        {
+            Dj = D + j*nd ;
+            for (k = kb ; k < kend ; k++)
+            {
+                Dk = D + k*nd ;
+                ujk = Dj [k] ;
+                for (i = k+1 ; i < nd ; i++)
+                {
+                    /* D (i,j) -= L (i,k) * U (k,j) */
+                    MULT_SUB (Dj [i], Dk [i], ujk) ;
+                }
+            }
+        }
+    }
+    return (singular) ;
+}
+
+
+/* ========================================================================== */
+/* === column_amax ========================================================== */
+/* ========================================================================== */
+
+/* Return the largest magnitude of the scaled entries of A in column k of a
+ * block, from rows and columns k1 on.  Rs is NULL if the matrix is not
+ * scaled. */
+
+static double column_amax
+(
+    Int k,
+    Int k1,
+    Int Ap [ ],
+    Int Ai [ ],
+    Entry Az [ ],
+    Int Q [ ],
+    Int Pinv [ ],
+    double Rs [ ]
+)
+{
+    double amax ;
+    Entry aik ;
+    Int p, pend, oldcol, oldrow ;
+
+    amax = 0 ;
+    oldcol = Q [k+k1] ;
+    pend = Ap [oldcol+1] ;
+    for (p = Ap [oldcol] ; p < pend ; p++)
+    {
+        oldrow = Ai [p] ;
+        if (Pinv [oldrow] < k1)
+        {
+            /* skip entry outside the block */
+            continue ;
+        }
+        if (Rs == NULL)
+        {
+            aik = Az [p] ;
+        }
+        else
+        {
+            /* aik = Az [p] / Rs [oldrow] */
+            SCALE_DIV_ASSIGN (aik, Az [p], Rs [oldrow]) ;
+        }
+        amax = MAX (amax, MAGNITUDE (aik)) ;
+    }
+    return (amax) ;
+}
+
+
+/* ========================================================================== */
+/* === block_rgrowth ======================================================== */
+/* ========================================================================== */
+
+/* Return the reciprocal pivot growth of a block of the LU factors, estimated
+ * as in refactor_block, for a block factorized again with partial pivoting.
+ * Pinv need only map the rows of A to the right blocks. */
+
+static double block_rgrowth
+(
+    Int block,
+    Int Ap [ ],
+    Int Ai [ ],
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+    double Rs [ ],
+    KLU_numeric *Numeric
+)
+{
+    double amax, umax, growth ;
+    Entry *Ux, *Udiag ;
+    Int *Uip, *Ulen ;
+    Unit *LU ;
+    Int k1, k, p, ulen, nk ;
+
+    k1 = Symbolic->R [block] ;
+    nk = Symbolic->R [block+1] - k1 ;
+    LU = ((Unit **) Numeric->LUbx) [block] ;
+    Uip = Numeric->Uip + k1 ;
+    Ulen = Numeric->Ulen + k1 ;
+    Udiag = ((Entry *) Numeric->Udiag) + k1 ;
+    growth = 1 ;
+    for (k = 0 ; k < nk ; k++)
+    {
+        /* only the numerical values of U (:,k) are needed */
+        ulen = Ulen [k] ;
+        Ux = (Entry *) (LU + Uip [k] + UNITS (Int, ulen)) ;
+        umax = MAGNITUDE (Udiag [k]) ;
+        for (p = 0 ; p < ulen ; p++)
+        {
+            umax = MAX (umax, MAGNITUDE (Ux [p])) ;
+        }
+        if (umax > 0)
+        {
+            amax = column_amax (k, k1, Ap, Ai, Az, Symbolic->Q,
+                Numeric->Pinv, Rs) ;
+            growth = MIN (growth, amax / umax) ;
+        }
+    }
+    return (growth) ;
+}
+
+
+/* ========================================================================== */
+/* === refactor_block ======================================================= */
+/* ========================================================================== */
+
+/* Refactorize a single diagonal block of the BTF form, with the pivot order
+ * and the pattern of L and U found by KLU_factor.  The blocks are independent
+ * of each other, so they can be refactorized in any order, or in parallel with
+ * each thread using its own workspace X.  Rs is NULL if the matrix is not
+ * scaled.  Returns the index k of the first zero pivot U(k,k) found in the
+ * block, or EMPTY if there is none.  If halt_if_singular is true, the block is
+ * not refactorized past the first zero pivot.
+ *
+ * The reciprocal pivot growth of the block, min (max (abs (A (:,k))) ./
+ * max (abs (U (:,k)))) over its columns (with A scaled, and U including its
+ * diagonal), is returned in *rgrowth.  It is found as the columns of A are
+ * scattered and those of U are computed, so it costs one comparison for each
+ * entry.  It is 1 for a singleton, and 0 if the block has a zero pivot.
+ *
+ * If D is not NULL, the dense lower right submatrix of L and U found by
+ * KLU_factor, from column ks = Numeric->Dstart [block] on, is refactorized
+ * with a dense kernel.  Columns 0 to ks-1 are refactorized as usual.  Those
+ * columns then update the columns from ks on, which are gathered into D and
+ * factorized there, and the result is put back into LU. */
+
+static Int refactor_block
+(
+    /* inputs, not modified */
+    Int block,
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+    double Rs [ ],      /* size n, row scale factors, or NULL */
+    Int halt_if_singular,
+
+    /* input/output */
+    KLU_numeric *Numeric,
+
+    /* workspace */
+    Entry X [ ],        /* size maxblock, zero on input and output */
+    Entry D [ ],        /* size (nk-ks)^2, or NULL */
+
+    /* output */
+    double *rgrowth     /* reciprocal pivot growth of the block */
+)
+{
+    double amax, umax, growth ;
+    Entry ukk, ujk, s ;
+    Entry *Offx, *Lx, *Ux, *Udiag, *Dk ;
+    Int *Q, *R, *Ui, *Li, *Pinv, *Lip, *Uip, *Llen, *Ulen ;
+    Unit *LU ;
+    Int k1, k2, nk, k, oldcol, pend, oldrow, p, newrow, poff, i, j, up, ulen,
+        llen, nzoff, singular, ks, nd ;
+
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nzoff = Symbolic->nzoff ;
+    Offx = (Entry *) Numeric->Offx ;
+    Pinv = Numeric->Pinv ;
+    Udiag = Numeric->Udiag ;
+    singular = EMPTY ;
+    growth = 1 ;
+    *rgrowth = 0 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the block is from rows/columns k1 to k2-1 */
+    /* ---------------------------------------------------------------------- */
+
+    k1 = R [block] ;
+    k2 = R [block+1] ;
+    nk = k2 - k1 ;
+    poff = Numeric->Offp [k1] ;
+
+    if (nk == 1)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* singleton case */
+        /* ------------------------------------------------------------------ */
+
+        oldcol = Q [k1] ;
+        pend = Ap [oldcol+1] ;
+        CLEAR (s) ;
+        for (p = Ap [oldcol] ; p < pend ; p++)
+        {
+            oldrow = Ai [p] ;
+            newrow = Pinv [oldrow] - k1 ;
+            if (newrow < 0 && poff < nzoff)
+            {
+                /* entry in off-diagonal block */
+                if (Rs == NULL)
+                {
+                    Offx [poff] = Az [p] ;
+                }
+                else
+                {
+                    /* Offx [poff] = Az [p] / Rs [oldrow] */
+                    SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
+                }
+                poff++ ;
+            }
+            else if (Rs == NULL)
+            {
+                /* singleton */
+                s = Az [p] ;
+            }
+            else
+            {
+                /* singleton */
+                /* s = Az [p] / Rs [oldrow] */
+                SCALE_DIV_ASSIGN (s, Az [p], Rs [oldrow]) ;
+            }
+        }
+        Udiag [k1] = s ;
+
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* construct and factor the kth block */
+        /* ------------------------------------------------------------------ */
+
+        Lip  = Numeric->Lip  + k1 ;
+        Llen = Numeric->Llen + k1 ;
+        Uip  = Numeric->Uip  + k1 ;
+        Ulen = Numeric->Ulen + k1 ;
+        LU = ((Unit **) Numeric->LUbx) [block] ;
+        ks = (D != NULL) ? Numeric->Dstart [block] : nk ;
+        nd = nk - ks ;
+
+        for (k = 0 ; k < nk ; k++)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* scatter kth column of the block into workspace X */
+            /* -------------------------------------------------------------- */
+
+            oldcol = Q [k+k1] ;
+            pend = Ap [oldcol+1] ;
+            amax = 0 ;
+            if (Rs == NULL)
+            {
+                for (p = Ap [oldcol] ; p < pend ; p++)
+                {
+                    newrow = Pinv [Ai [p]] - k1 ;
+                    if (newrow < 0 && poff < nzoff)
+                    {
+                        /* entry in off-diagonal block */
+                        Offx [poff] = Az [p] ;
+                        poff++ ;
+                    }
+                    else
+                    {
+                        /* (newrow,k) is an entry in the block */
+                        X [newrow] = Az [p] ;
+                        amax = MAX (amax, MAGNITUDE (X [newrow])) ;
+                    }
+                }
+            }
+            else
+            {
+                for (p = Ap [oldcol] ; p < pend ; p++)
+                {
+                    oldrow = Ai [p] ;
+                    newrow = Pinv [oldrow] - k1 ;
+                    if (newrow < 0 && poff < nzoff)
+                    {
+                        /* entry in off-diagonal part */
+                        /* Offx [poff] = Az [p] / Rs [oldrow] */
+                        SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]);
+                        poff++ ;
+                    }
+                    else
+                    {
+                        /* (newrow,k) is an entry in the block */
+                        /* X [newrow] = Az [p] / Rs [oldrow] */
+                        SCALE_DIV_ASSIGN (X [newrow], Az [p], Rs [oldrow]) ;
+                        amax = MAX (amax, MAGNITUDE (X [newrow])) ;
+                    }
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* compute kth column of U, and update kth column of A */
+            /* -------------------------------------------------------------- */
+
+            GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
+            umax = 0 ;
+            for (up = 0 ; up < ulen ; up++)
+            {
+                j = Ui [up] ;
+                if (j >= ks)
+                {
+                    /* U (j,k) is in the dense submatrix */
+                    continue ;
+                }
+                ujk = X [j] ;
+                /* X [j] = 0 */
+                CLEAR (X [j]) ;
+                Ux [up] = ujk ;
+                umax = MAX (umax, MAGNITUDE (ujk)) ;
+                GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
+                for (p = 0 ; p < llen ; p++)
+                {
+                    /* X [Li [p]] -= Lx [p] * ujk */
+                    MULT_SUB (X [Li [p]], Lx [p], ujk) ;
+                }
+            }
+            if (k >= ks)
+            {
+                /* gather the rest of the column into D */
+                Dk = D + (k-ks)*nd ;
+                for (i = ks ; i < nk ; i++)
+                {
+                    Dk [i-ks] = X [i] ;
+                    CLEAR (X [i]) ;
+                }
+                continue ;
+            }
+            /* get the diagonal entry of U */
+            ukk = X [k] ;
+            /* X [k] = 0 */
+            CLEAR (X [k]) ;
+            /* singular case */
+            if (IS_ZERO (ukk))
+            {
+                /* matrix is numerically singular */
+                if (singular == EMPTY)
+                {
+                    singular = k+k1 ;
+                }
+                if (halt_if_singular)
+                {
+                    /* do not continue the factorization */
+                    for (i = 0 ; i < nk ; i++)
+                    {
+                        CLEAR (X [i]) ;
+                    }
+                    return (singular) ;
+                }
+            }
+            Udiag [k+k1] = ukk ;
+            umax = MAX (umax, MAGNITUDE (ukk)) ;
+            if (umax > 0)
+            {
+                growth = MIN (growth, amax / umax) ;
+            }
+            /* gather and divide by pivot to get kth column of L */
+            GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
+            for (p = 0 ; p < llen ; p++)
+            {
+                i = Li [p] ;
+                DIV (Lx [p], X [i], ukk) ;
+                CLEAR (X [i]) ;
+            }
+        }
+
+        if (nd > 0)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* factorize the dense submatrix and put it back into LU */
+            /* -------------------------------------------------------------- */
+
+            k = dense_lu (nd, D, halt_if_singular) ;
+            if (k != EMPTY)
+            {
+                /* matrix is numerically singular */
+                if (singular == EMPTY)
+                {
+                    singular = k+ks+k1 ;
+                }
+                if (halt_if_singular)
+                {
+                    /* do not continue the factorization */
+                    return (singular) ;
+                }
+            }
+            for (k = ks ; k < nk ; k++)
+            {
+                Dk = D + (k-ks)*nd ;
+                GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
+                umax = 0 ;
+                for (up = 0 ; up < ulen ; up++)
+                {
+                    j = Ui [up] ;
+                    if (j >= ks)
+                    {
+                        Ux [up] = Dk [j-ks] ;
+                    }
+                    umax = MAX (umax, MAGNITUDE (Ux [up])) ;
+                }
+                Udiag [k+k1] = Dk [k-ks] ;
+                umax = MAX (umax, MAGNITUDE (Udiag [k+k1])) ;
+                if (umax > 0)
+                {
+                    /* A (:,k) was scattered before the dense kernel, so its
+                     * largest entry is found again */
+                    amax = column_amax (k, k1, Ap, Ai, Az, Q, Pinv, Rs) ;
+                    growth = MIN (growth, amax / umax) ;
+                }
+                GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
+                for (p = 0 ; p < llen ; p++)
+                {
+                    Lx [p] = Dk [Li [p]-ks] ;
+                }
+            }
+        }
+    }
+
+    ASSERT (poff == Numeric->Offp [k2]) ;
+    *rgrowth = (singular == EMPTY) ? growth : 0 ;
+    return (singular) ;
+}
+
+
+/* ========================================================================== */
+/* === refactor_parallel ==================================================== */
+/* ========================================================================== */
+
+/* Refactorize all the blocks in parallel (or only those marked in Dirty, if
+ * Dirty is not NULL), largest block first, with each thread using its own
+ * workspace.  Returns the first zero pivot found, or
+ * EMPTY if there is none, in *singular, and the pivot growth of each block in
+ * Growth.  If repivot is true, a zero pivot does not stop the other blocks.
+ * Returns FALSE if the workspace cannot
+ * be allocated, in which case nothing has been done and the blocks should be
+ * refactorized sequentially instead. */
+
+static Int refactor_parallel
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+    double Rs [ ],      /* size n, row scale factors, or NULL */
+    Int Dirty [ ],      /* size nblocks, blocks to refactorize, or NULL */
+    Int nthreads,
+    size_t dsize,       /* size of the dense workspace D for each thread */
+    Int repivot,        /* if true, blocks with a zero pivot are repivoted */
+
+    /* input/output */
+    KLU_numeric *Numeric,
+
+    /* output */
+    double Growth [ ],  /* size nblocks, pivot growth of each block */
+    Int *singular,
+    KLU_common *Common
+)
+{
+    Entry *Xthreads ;
+    Int *Order ;
+    size_t xsize, wsize ;
+    Int nblocks, maxblock, b, k, halt_if_singular, first, halt = FALSE,
+        status, ok = TRUE ;
+
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+    halt_if_singular = Common->halt_if_singular ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the workspace for each thread */
+    /* ---------------------------------------------------------------------- */
+
+    /* X of size maxblock, and D of size dsize, for each thread */
+    wsize = KLU_add_size_t (maxblock, dsize, &ok) ;
+    xsize = KLU_mult_size_t (wsize, nthreads, &ok) ;
+    if (!ok)
+    {
+        return (FALSE) ;
+    }
+    status = Common->status ;
+    Order = KLU_block_order (Symbolic, Common) ;
+    Xthreads = KLU_malloc (xsize, sizeof (Entry), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Order, nblocks, sizeof (Int), Common) ;
+        KLU_free (Xthreads, xsize, sizeof (Entry), Common) ;
+        Common->status = status ;
+        return (FALSE) ;
+    }
+    for (b = 0 ; b < nthreads ; b++)
+    {
+        for (k = 0 ; k < maxblock ; k++)
+        {
+            /* X [k] = 0 */
+            CLEAR (Xthreads [b * wsize + k]) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* refactorize the blocks, largest first */
+    /* ---------------------------------------------------------------------- */
+
+    first = EMPTY ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+    for (b = 0 ; b < nblocks ; b++)
+    {
+        Int s, stop ;
+        Entry *X = Xthreads + SUITESPARSE_OPENMP_GET_THREAD_ID * wsize ;
+        Entry *D = (dsize > 0) ? (X + maxblock) : NULL ;
+
+        #pragma omp atomic read
+        stop = halt ;
+        if (stop || (Dirty != NULL && !Dirty [Order [b]])) continue ;
+
+        s = refactor_block (Order [b], Ap, Ai, Az, Symbolic, Rs,
+            halt_if_singular, Numeric, X, D, &Growth [Order [b]]) ;
+
+        if (s != EMPTY)
+        {
+            #pragma omp critical (klu_refactor_parallel)
+            {
+                if (first == EMPTY || s < first)
+                {
+                    first = s ;
+                }
+            }
+            if (halt_if_singular && !repivot)
+            {
+                /* do not continue the factorization */
+                #pragma omp atomic write
+                halt = TRUE ;
+            }
+        }
+    }
+
+    KLU_free (Order, nblocks, sizeof (Int), Common) ;
+    KLU_free (Xthreads, xsize, sizeof (Entry), Common) ;
+    *singular = first ;
+    return (TRUE) ;
+}
+
+
+/* ========================================================================== */
+/* === repivot_blocks ======================================================= */
+/* ========================================================================== */
+
+/* Factorize again, with partial pivoting, each block with more than one row
+ * whose pivot growth estimate in Growth is less than Common->repivot_tol (a
+ * block with a zero pivot has an estimate of zero).  Growth is updated for
+ * those blocks, and the number of blocks factorized again is returned in
+ * Common->nrepivot.  Returns FALSE if out of memory, in which case the LU
+ * factors of the block that failed are lost, or if a block is still singular
+ * and Common->halt_if_singular is true. */
+
+static Int repivot_blocks
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+    double Rs [ ],      /* size n, row scale factors, or NULL */
+
+    /* input/output */
+    double Growth [ ],  /* size nblocks, pivot growth of each block */
+    KLU_numeric *Numeric,
+    KLU_common  *Common
+)
+{
+    double tol ;
+    Int *P, *R, *Pnum, *Pinv, *Offi ;
+    Int n, k, p, block, nblocks, nzoff, nrepivot, ok ;
+
+    n = Symbolic->n ;
+    P = Symbolic->P ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    nzoff = Symbolic->nzoff ;
+    Pnum = Numeric->Pnum ;
+    Pinv = Numeric->Pinv ;
+    Offi = Numeric->Offi ;
+    tol = Common->repivot_tol ;
+
+    nrepivot = 0 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        if (R [block+1] - R [block] > 1 && Growth [block] < tol)
+        {
+            nrepivot++ ;
+        }
+    }
+    Common->nrepivot = nrepivot ;
+    if (nrepivot == 0)
+    {
+        return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* put Offi and Pinv in the form KLU_factor uses while factorizing */
+    /* ---------------------------------------------------------------------- */
+
+    for (p = 0 ; p < nzoff ; p++)
+    {
+        Offi [p] = Pnum [Offi [p]] ;
+    }
+    for (k = 0 ; k < n ; k++)
+    {
+        Pinv [P [k]] = k ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize the blocks again */
+    /* ---------------------------------------------------------------------- */
+
+    ok = TRUE ;
+    for (block = 0 ; ok && block < nblocks ; block++)
+    {
+        if (R [block+1] - R [block] == 1 || Growth [block] >= tol)
+        {
+            continue ;
+        }
+        PRINTF (("repivot block %d, rgrowth %g\n", block, Growth [block])) ;
+        KLU_repivot_block (block, Ap, Ai, Az, Symbolic, Rs, Numeric, Common) ;
+        ok = (Common->status == KLU_OK ||
+             (Common->status == KLU_SINGULAR && !Common->halt_if_singular)) ;
+        if (ok)
+        {
+            Growth [block] = block_rgrowth (block, Ap, Ai, Az, Symbolic, Rs,
+                Numeric) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* apply the new pivot row order to Pinv and Offi */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        Pinv [Pnum [k]] = k ;
+    }
+    for (p = 0 ; p < nzoff ; p++)
+    {
+        Offi [p] = Pinv [Offi [p]] ;
+    }
+    return (ok) ;
+}
+
+
+/* ========================================================================== */
+/* === refactor_blocks ====================================================== */
+/* ========================================================================== */
+
+/* Refactorize all the blocks, or only those marked in Dirty if Dirty is not
+ * NULL, in parallel if Common->nthreads allows it, and repivot the blocks
+ * that need it if Common->repivot_tol > 0.  Rs holds the row scale
+ * factors in their original order, or is NULL if the matrix is not scaled.
+ * The pivot growth and rcond estimates are returned in Common->rgrowth and
+ * Common->rcond.  Returns FALSE if the matrix is singular and
+ * Common->halt_if_singular is true, or if out of memory, TRUE otherwise. */
+
+static Int refactor_blocks
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+    double Rs [ ],      /* size n, row scale factors, or NULL */
+    Int Dirty [ ],      /* size nblocks, blocks to refactorize, or NULL */
+
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common  *Common
+)
+{
+    double ukk, umin, umax ;
+    double *Growth ;
+    Entry *X, *D, *Udiag ;
+    Int *Q, *R ;
+    size_t dsize ;
+    Int n, nk, nd, k, block, nblocks, maxblock, singular, nthreads, halt,
+        repivot ;
+
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+    X = (Entry *) Numeric->Xwork ;
+    Udiag = (Entry *) Numeric->Udiag ;
+    Common->rgrowth = 0 ;
+    Common->rcond = 0 ;
+    Common->nrepivot = 0 ;
+
+    /* the LU factors of a Numeric object held in a blob cannot be
+     * reallocated, so its blocks cannot be repivoted */
+    repivot = (Common->repivot_tol > 0 && Numeric->blob == NULL) ;
+
+    /* pivot growth of each block, 1 for blocks not refactorized */
+    Growth = KLU_GROWTH (Numeric) ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        Growth [block] = 1 ;
+    }
+
+    /* workspace for the largest dense submatrix of the LU factors */
+    dsize = 0 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        if (Dirty != NULL && !Dirty [block])
+        {
+            continue ;
+        }
+        nk = R [block+1] - R [block] ;
+        nd = (nk > 1) ? (nk - Numeric->Dstart [block]) : 0 ;
+        dsize = MAX (dsize, ((size_t) nd) * ((size_t) nd)) ;
+    }
+
+    halt = FALSE ;
+    nthreads = KLU_parallel_threads (nblocks, Common) ;
+    if (nthreads > 1 && refactor_parallel (Ap, Ai, Az, Symbolic, Rs, Dirty,
+        nthreads, dsize, repivot, Numeric, Growth, &singular, Common))
+    {
+        if (singular != EMPTY && !repivot)
+        {
+            /* matrix is numerically singular */
+            Common->status = KLU_SINGULAR ;
+            Common->numerical_rank = singular ;
+            Common->singular_col = Q [singular] ;
+            /* do not continue the factorization if halt_if_singular */
+            halt = Common->halt_if_singular ;
+        }
+    }
+    else
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* clear workspace X, and allocate workspace D */
+        /* ------------------------------------------------------------------ */
+
+        for (k = 0 ; k < maxblock ; k++)
+        {
+            /* X [k] = 0 */
+            CLEAR (X [k]) ;
+        }
+
+        D = NULL ;
+        if (dsize > 0)
+        {
+            /* if out of memory, use the sparse kernel for the whole block */
+            D = KLU_malloc (dsize, sizeof (Entry), Common) ;
+            Common->status = KLU_OK ;
+        }
+
+        for (block = 0 ; block < nblocks && !halt ; block++)
+        {
+            if (Dirty != NULL && !Dirty [block])
+            {
+                continue ;
+            }
+            singular = refactor_block (block, Ap, Ai, Az, Symbolic, Rs,
+                Common->halt_if_singular, Numeric, X, D, &Growth [block]) ;
+            if (singular != EMPTY && !repivot)
+            {
+                /* matrix is numerically singular */
+                Common->status = KLU_SINGULAR ;
+                if (Common->numerical_rank == EMPTY)
+                {
+                    Common->numerical_rank = singular ;
+                    Common->singular_col = Q [singular] ;
+                }
+                /* do not continue the factorization if halt_if_singular */
+                halt = Common->halt_if_singular ;
+            }
+        }
+
+        KLU_free (D, dsize, sizeof (Entry), Common) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* repivot the blocks whose pivots are no longer stable */
+    /* ---------------------------------------------------------------------- */
+
+    if (!halt && repivot)
+    {
+        halt = !repivot_blocks (Ap, Ai, Az, Symbolic, Rs, Growth, Numeric,
+            Common) ;
+    }
+    if (halt)
+    {
+        return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* find the pivot growth and rcond estimates */
+    /* ---------------------------------------------------------------------- */
+
+    Common->rgrowth = 1 ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        Common->rgrowth = MIN (Common->rgrowth, Growth [block]) ;
+    }
+
+    /* rcond = min (abs (diag (U))) / max (abs (diag (U))), as in KLU_rcond */
+    umin = 0 ;
+    umax = 0 ;
+    singular = EMPTY ;
+    for (k = 0 ; k < n ; k++)
+    {
+        ABS (ukk, Udiag [k]) ;
+        if (SCALAR_IS_NAN (ukk) || SCALAR_IS_ZERO (ukk))
+        {
+            singular = k ;
+            break ;
+        }
+        umin = (k == 0) ? ukk : MIN (umin, ukk) ;
+        umax = (k == 0) ? ukk : MAX (umax, ukk) ;
+    }
+    if (singular == EMPTY && n > 0)
+    {
+        Common->rcond = umin / umax ;
+        if (SCALAR_IS_NAN (Common->rcond))
+        {
+            Common->rcond = 0 ;
+        }
+    }
+
+    if (repivot && singular != EMPTY && IS_ZERO (Udiag [singular]))
+    {
+        /* matrix is still numerically singular, or has a singular
+         * singleton, after repivoting */
+        Common->status = KLU_SINGULAR ;
+        Common->numerical_rank = singular ;
+        Common->singular_col = Q [singular] ;
+        if (Common->halt_if_singular)
+        {
+            return (FALSE) ;
+        }
+    }
+
+    return (TRUE) ;
+}
+
 
 /* ========================================================================== */
 /* === KLU_refactor ========================================================= */
@@ -26,7 +968,7 @@ int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     /* inputs, not modified */
     Int Ap [ ],         /* size n+1, column pointers */
     Int Ai [ ],         /* size nz, row indices */
-    double Ax [ ],
+    Scalar Ax [ ],
     KLU_symbolic *Symbolic,
 
     /* input/output */
@@ -34,14 +976,16 @@ int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     KLU_common  *Common
 )
 {
-    Entry ukk, ujk, s ;
-    Entry *Offx, *Lx, *Ux, *X, *Az, *Udiag ;
+    Entry *X, *Az ;
     double *Rs ;
-    Int *Q, *R, *Pnum, *Ui, *Li, *Pinv, *Lip, *Uip, *Llen, *Ulen ;
-    Unit **LUbx ;
+    Int *Pnum ;
+    Int k, n, scale ;
+#ifndef NDEBUG
+    Entry *Offx ;
+    Int *R, *Lip, *Uip, *Llen, *Ulen ;
     Unit *LU ;
-    Int k1, k2, nk, k, block, oldcol, pend, oldrow, n, p, newrow, scale,
-        nblocks, poff, i, j, up, ulen, llen, maxblock, nzoff ;
+    Int k1, k2, nk, block, nblocks ;
+#endif
 
     /* ---------------------------------------------------------------------- */
     /* check inputs */
@@ -69,22 +1013,22 @@ int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     /* get the contents of the Symbolic object */
     /* ---------------------------------------------------------------------- */
 
-    n = Symbolic->n ;
-    Q = Symbolic->Q ;
-    R = Symbolic->R ;
-    nblocks = Symbolic->nblocks ;
-    maxblock = Symbolic->maxblock ;
-
+    n = Symbolic->n ;
+
     /* ---------------------------------------------------------------------- */
     /* get the contents of the Numeric object */
     /* ---------------------------------------------------------------------- */
 
     Pnum = Numeric->Pnum ;
-    Offx = (Entry *) Numeric->Offx ;
-
-    LUbx = (Unit **) Numeric->LUbx ;
 
     scale = Common->scale ;
+    if (Numeric->blob != NULL && (scale > 0) != (Numeric->Rs != NULL))
+    {
+        /* the scale factors of a Numeric object held in a blob from
+         * KLU_deserialize_numeric cannot be allocated or freed */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
     if (scale > 0)
     {
         /* factorization was not scaled, but refactorization is scaled */
@@ -106,11 +1050,8 @@ int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     }
     Rs = Numeric->Rs ;
 
-    Pinv = Numeric->Pinv ;
     X = (Entry *) Numeric->Xwork ;
     Common->nrealloc = 0 ;
-    Udiag = Numeric->Udiag ;
-    nzoff = Symbolic->nzoff ;
 
     /* ---------------------------------------------------------------------- */
     /* check the input matrix compute the row scale factors, Rs */
@@ -127,354 +1068,285 @@ int KLU_refactor        /* returns TRUE if successful, FALSE otherwise */
     }
 
     /* ---------------------------------------------------------------------- */
-    /* clear workspace X */
+    /* factor each block */
     /* ---------------------------------------------------------------------- */
 
-    for (k = 0 ; k < maxblock ; k++)
+    if (!refactor_blocks (Ap, Ai, Az, Symbolic, (scale > 0) ? Rs : NULL, NULL,
+        Numeric, Common))
     {
-        /* X [k] = 0 */
-        CLEAR (X [k]) ;
+        return (FALSE) ;
     }
 
-    poff = 0 ;
-
     /* ---------------------------------------------------------------------- */
-    /* factor each block */
+    /* permute scale factors Rs according to pivotal row order */
     /* ---------------------------------------------------------------------- */
 
-    if (scale <= 0)
+    if (scale > 0)
     {
+        for (k = 0 ; k < n ; k++)
+        {
+            REAL (X [k]) = Rs [Pnum [k]] ;
+        }
+        for (k = 0 ; k < n ; k++)
+        {
+            Rs [k] = REAL (X [k]) ;
+        }
+    }
 
-        /* ------------------------------------------------------------------ */
-        /* no scaling */
-        /* ------------------------------------------------------------------ */
-
+#ifndef NDEBUG
+    Offx = (Entry *) Numeric->Offx ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    ASSERT (Symbolic->nzoff == Numeric->Offp [n]) ;
+    PRINTF (("\n------------------- Off diagonal entries, new:\n")) ;
+    ASSERT (KLU_valid (n, Numeric->Offp, Numeric->Offi, Offx)) ;
+    if (Common->status == KLU_OK)
+    {
+        PRINTF (("\n ----------- KLU_BTF_REFACTOR done, nblocks %d\n",nblocks));
         for (block = 0 ; block < nblocks ; block++)
         {
-
-            /* -------------------------------------------------------------- */
-            /* the block is from rows/columns k1 to k2-1 */
-            /* -------------------------------------------------------------- */
-
             k1 = R [block] ;
             k2 = R [block+1] ;
             nk = k2 - k1 ;
-
+            PRINTF ((
+                "\n--------------- KLU_refactor output: k1 %d k2 %d nk %d\n",
+                k1, k2, nk)) ;
             if (nk == 1)
             {
-
-                /* ---------------------------------------------------------- */
-                /* singleton case */
-                /* ---------------------------------------------------------- */
-
-                oldcol = Q [k1] ;
-                pend = Ap [oldcol+1] ;
-                CLEAR (s) ;
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    newrow = Pinv [Ai [p]] - k1 ;
-                    if (newrow < 0 && poff < nzoff)
-                    {
-                        /* entry in off-diagonal block */
-                        Offx [poff] = Az [p] ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        /* singleton */
-                        s = Az [p] ;
-                    }
-                }
-                Udiag [k1] = s ;
-
+                PRINTF (("singleton  ")) ;
+                PRINT_ENTRY (((Entry *) Numeric->Udiag) [k1]) ;
             }
             else
             {
-
-                /* ---------------------------------------------------------- */
-                /* construct and factor the kth block */
-                /* ---------------------------------------------------------- */
-
-                Lip  = Numeric->Lip  + k1 ;
+                Lip = Numeric->Lip + k1 ;
                 Llen = Numeric->Llen + k1 ;
-                Uip  = Numeric->Uip  + k1 ;
+                LU = (Unit *) Numeric->LUbx [block] ;
+                PRINTF (("\n---- L block %d\n", block)) ;
+                ASSERT (KLU_valid_LU (nk, TRUE, Lip, Llen, LU)) ;
+                Uip = Numeric->Uip + k1 ;
                 Ulen = Numeric->Ulen + k1 ;
-                LU = LUbx [block] ;
+                PRINTF (("\n---- U block %d\n", block)) ;
+                ASSERT (KLU_valid_LU (nk, FALSE, Uip, Ulen, LU)) ;
+            }
+        }
+    }
+#endif
 
-                for (k = 0 ; k < nk ; k++)
-                {
+    return (TRUE) ;
+}
 
-                    /* ------------------------------------------------------ */
-                    /* scatter kth column of the block into workspace X */
-                    /* ------------------------------------------------------ */
 
-                    oldcol = Q [k+k1] ;
-                    pend = Ap [oldcol+1] ;
-                    for (p = Ap [oldcol] ; p < pend ; p++)
-                    {
-                        newrow = Pinv [Ai [p]] - k1 ;
-                        if (newrow < 0 && poff < nzoff)
-                        {
-                            /* entry in off-diagonal block */
-                            Offx [poff] = Az [p] ;
-                            poff++ ;
-                        }
-                        else
-                        {
-                            /* (newrow,k) is an entry in the block */
-                            X [newrow] = Az [p] ;
-                        }
-                    }
+/* ========================================================================== */
+/* === KLU_refactor_partial ================================================= */
+/* ========================================================================== */
 
-                    /* ------------------------------------------------------ */
-                    /* compute kth column of U, and update kth column of A */
-                    /* ------------------------------------------------------ */
+/* Refactorize only the diagonal blocks of the BTF form that hold a column
+ * whose values have changed since the last KLU_factor or KLU_refactor, given
+ * in the list Changed [0..nchanged-1].  The off-diagonal entries of those
+ * columns are updated as well.  All other blocks keep their LU factors.
+ *
+ * If the matrix is scaled (Common->scale > 0), the scale factors are
+ * recomputed, in time proportional to nnz (A).  A block is then also
+ * refactorized if the scale factor of any of its rows has changed, and the
+ * off-diagonal entries in those rows are rescaled.  If Common->scale > 0 but
+ * the last factorization was not scaled, or the other way around, the whole
+ * matrix is refactorized with KLU_refactor. */
 
-                    GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
-                    for (up = 0 ; up < ulen ; up++)
-                    {
-                        j = Ui [up] ;
-                        ujk = X [j] ;
-                        /* X [j] = 0 */
-                        CLEAR (X [j]) ;
-                        Ux [up] = ujk ;
-                        GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
-                        for (p = 0 ; p < llen ; p++)
-                        {
-                            /* X [Li [p]] -= Lx [p] * ujk */
-                            MULT_SUB (X [Li [p]], Lx [p], ujk) ;
-                        }
-                    }
-                    /* get the diagonal entry of U */
-                    ukk = X [k] ;
-                    /* X [k] = 0 */
-                    CLEAR (X [k]) ;
-                    /* singular case */
-                    if (IS_ZERO (ukk))
-                    {
-                        /* matrix is numerically singular */
-                        Common->status = KLU_SINGULAR ;
-                        if (Common->numerical_rank == EMPTY)
-                        {
-                            Common->numerical_rank = k+k1 ;
-                            Common->singular_col = Q [k+k1] ;
-                        }
-                        if (Common->halt_if_singular)
-                        {
-                            /* do not continue the factorization */
-                            return (FALSE) ;
-                        }
-                    }
-                    Udiag [k+k1] = ukk ;
-                    /* gather and divide by pivot to get kth column of L */
-                    GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
-                    for (p = 0 ; p < llen ; p++)
-                    {
-                        i = Li [p] ;
-                        DIV (Lx [p], X [i], ukk) ;
-                        CLEAR (X [i]) ;
-                    }
+int KLU_refactor_partial    /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    Scalar Ax [ ],
+    KLU_symbolic *Symbolic,
+    Int nchanged,       /* number of columns that have changed */
+    Int Changed [ ],    /* size nchanged, the columns of A that have changed */
 
-                }
-            }
-        }
+    /* input/output */
+    KLU_numeric *Numeric,
+    KLU_common  *Common
+)
+{
+    Entry *Offx, *Az ;
+    double *Rs, *Rnew ;
+    Int *Q, *R, *Pnum, *Pinv, *Offp, *Dirty, *Mark ;
+    Int k1, k2, k, i, j, p, poff, block, n, scale, nblocks, rescaled, ok ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
 
+    if (Common == NULL)
+    {
+        return (FALSE) ;
     }
-    else
+    Common->status = KLU_OK ;
+
+    if (Numeric == NULL || nchanged < 0 || (nchanged > 0 && Changed == NULL))
     {
+        /* invalid Numeric object or list of changed columns */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
 
-        /* ------------------------------------------------------------------ */
-        /* scaling */
-        /* ------------------------------------------------------------------ */
+    n = Symbolic->n ;
+    scale = Common->scale ;
+    if ((scale > 0) != (Numeric->Rs != NULL))
+    {
+        /* the scaling has changed, so refactorize the whole matrix */
+        return (KLU_refactor (Ap, Ai, Ax, Symbolic, Numeric, Common)) ;
+    }
 
-        for (block = 0 ; block < nblocks ; block++)
+    for (k = 0 ; k < nchanged ; k++)
+    {
+        j = Changed [k] ;
+        if (j < 0 || j >= n)
         {
+            Common->status = KLU_INVALID ;
+            return (FALSE) ;
+        }
+    }
 
-            /* -------------------------------------------------------------- */
-            /* the block is from rows/columns k1 to k2-1 */
-            /* -------------------------------------------------------------- */
+    Common->numerical_rank = EMPTY ;
+    Common->singular_col = EMPTY ;
+    Common->nrealloc = 0 ;
 
-            k1 = R [block] ;
-            k2 = R [block+1] ;
-            nk = k2 - k1 ;
+    Az = (Entry *) Ax ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    Pnum = Numeric->Pnum ;
+    Pinv = Numeric->Pinv ;
+    Offp = Numeric->Offp ;
+    Offx = (Entry *) Numeric->Offx ;
+    Rs = Numeric->Rs ;
 
-            if (nk == 1)
-            {
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* ---------------------------------------------------------------------- */
 
-                /* ---------------------------------------------------------- */
-                /* singleton case */
-                /* ---------------------------------------------------------- */
+    Dirty = KLU_malloc (nblocks, sizeof (Int), Common) ;
+    Mark = KLU_malloc (n, sizeof (Int), Common) ;
+    Rnew = (scale > 0) ? KLU_malloc (n, sizeof (double), Common) : NULL ;
+    if (Common->status < KLU_OK)
+    {
+        KLU_free (Dirty, nblocks, sizeof (Int), Common) ;
+        KLU_free (Mark, n, sizeof (Int), Common) ;
+        KLU_free (Rnew, n, sizeof (double), Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (FALSE) ;
+    }
 
-                oldcol = Q [k1] ;
-                pend = Ap [oldcol+1] ;
-                CLEAR (s) ;
-                for (p = Ap [oldcol] ; p < pend ; p++)
-                {
-                    oldrow = Ai [p] ;
-                    newrow = Pinv [oldrow] - k1 ;
-                    if (newrow < 0 && poff < nzoff)
-                    {
-                        /* entry in off-diagonal block */
-                        /* Offx [poff] = Az [p] / Rs [oldrow] */
-                        SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]) ;
-                        poff++ ;
-                    }
-                    else
-                    {
-                        /* singleton */
-                        /* s = Az [p] / Rs [oldrow] */
-                        SCALE_DIV_ASSIGN (s, Az [p], Rs [oldrow]) ;
-                    }
-                }
-                Udiag [k1] = s ;
+    /* ---------------------------------------------------------------------- */
+    /* check the input matrix and compute the new row scale factors */
+    /* ---------------------------------------------------------------------- */
 
-            }
-            else
-            {
+    if (scale >= 0)
+    {
+        /* check for out-of-range indices, but do not check for duplicates */
+        if (!KLU_scale (scale, n, Ap, Ai, Ax, Rnew, NULL, Common))
+        {
+            KLU_free (Dirty, nblocks, sizeof (Int), Common) ;
+            KLU_free (Mark, n, sizeof (Int), Common) ;
+            KLU_free (Rnew, n, sizeof (double), Common) ;
+            return (FALSE) ;
+        }
+    }
 
-                /* ---------------------------------------------------------- */
-                /* construct and factor the kth block */
-                /* ---------------------------------------------------------- */
+    /* ---------------------------------------------------------------------- */
+    /* find the blocks to refactorize */
+    /* ---------------------------------------------------------------------- */
 
-                Lip  = Numeric->Lip  + k1 ;
-                Llen = Numeric->Llen + k1 ;
-                Uip  = Numeric->Uip  + k1 ;
-                Ulen = Numeric->Ulen + k1 ;
-                LU = LUbx [block] ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Mark [j] = FALSE ;
+    }
+    for (k = 0 ; k < nchanged ; k++)
+    {
+        Mark [Changed [k]] = TRUE ;
+    }
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        Dirty [block] = FALSE ;
+        for (k = R [block] ; k < R [block+1] ; k++)
+        {
+            if (Mark [Q [k]])
+            {
+                Dirty [block] = TRUE ;
+                break ;
+            }
+        }
+    }
 
-                for (k = 0 ; k < nk ; k++)
-                {
+    /* Mark [i] is now TRUE if the scale factor of row i has changed */
+    rescaled = FALSE ;
+    for (block = 0 ; block < nblocks ; block++)
+    {
+        for (k = R [block] ; k < R [block+1] ; k++)
+        {
+            i = Pnum [k] ;
+            Mark [i] = (Rnew != NULL && Rnew [i] != Rs [k]) ;
+            if (Mark [i])
+            {
+                Dirty [block] = TRUE ;
+                rescaled = TRUE ;
+            }
+        }
+    }
 
-                    /* ------------------------------------------------------ */
-                    /* scatter kth column of the block into workspace X */
-                    /* ------------------------------------------------------ */
+    /* ---------------------------------------------------------------------- */
+    /* refactorize the blocks that have changed */
+    /* ---------------------------------------------------------------------- */
 
-                    oldcol = Q [k+k1] ;
-                    pend = Ap [oldcol+1] ;
-                    for (p = Ap [oldcol] ; p < pend ; p++)
-                    {
-                        oldrow = Ai [p] ;
-                        newrow = Pinv [oldrow] - k1 ;
-                        if (newrow < 0 && poff < nzoff)
-                        {
-                            /* entry in off-diagonal part */
-                            /* Offx [poff] = Az [p] / Rs [oldrow] */
-                            SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rs [oldrow]);
-                            poff++ ;
-                        }
-                        else
-                        {
-                            /* (newrow,k) is an entry in the block */
-                            /* X [newrow] = Az [p] / Rs [oldrow] */
-                            SCALE_DIV_ASSIGN (X [newrow], Az [p], Rs [oldrow]) ;
-                        }
-                    }
+    ok = refactor_blocks (Ap, Ai, Az, Symbolic, Rnew, Dirty, Numeric, Common) ;
 
-                    /* ------------------------------------------------------ */
-                    /* compute kth column of U, and update kth column of A */
-                    /* ------------------------------------------------------ */
+    /* ---------------------------------------------------------------------- */
+    /* rescale the off-diagonal entries of the other blocks, if needed */
+    /* ---------------------------------------------------------------------- */
 
-                    GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, ulen) ;
-                    for (up = 0 ; up < ulen ; up++)
-                    {
-                        j = Ui [up] ;
-                        ujk = X [j] ;
-                        /* X [j] = 0 */
-                        CLEAR (X [j]) ;
-                        Ux [up] = ujk ;
-                        GET_POINTER (LU, Lip, Llen, Li, Lx, j, llen) ;
-                        for (p = 0 ; p < llen ; p++)
-                        {
-                            /* X [Li [p]] -= Lx [p] * ujk */
-                            MULT_SUB (X [Li [p]], Lx [p], ujk) ;
-                        }
-                    }
-                    /* get the diagonal entry of U */
-                    ukk = X [k] ;
-                    /* X [k] = 0 */
-                    CLEAR (X [k]) ;
-                    /* singular case */
-                    if (IS_ZERO (ukk))
-                    {
-                        /* matrix is numerically singular */
-                        Common->status = KLU_SINGULAR ;
-                        if (Common->numerical_rank == EMPTY)
-                        {
-                            Common->numerical_rank = k+k1 ;
-                            Common->singular_col = Q [k+k1] ;
-                        }
-                        if (Common->halt_if_singular)
-                        {
-                            /* do not continue the factorization */
-                            return (FALSE) ;
-                        }
-                    }
-                    Udiag [k+k1] = ukk ;
-                    /* gather and divide by pivot to get kth column of L */
-                    GET_POINTER (LU, Lip, Llen, Li, Lx, k, llen) ;
-                    for (p = 0 ; p < llen ; p++)
+    for (block = 0 ; ok && rescaled && block < nblocks ; block++)
+    {
+        if (Dirty [block])
+        {
+            continue ;
+        }
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            poff = Offp [k] ;
+            j = Q [k] ;
+            for (p = Ap [j] ; p < Ap [j+1] ; p++)
+            {
+                i = Ai [p] ;
+                if (Pinv [i] < k1)
+                {
+                    if (Mark [i])
                     {
-                        i = Li [p] ;
-                        DIV (Lx [p], X [i], ukk) ;
-                        CLEAR (X [i]) ;
+                        /* Offx [poff] = Az [p] / Rnew [i] */
+                        SCALE_DIV_ASSIGN (Offx [poff], Az [p], Rnew [i]) ;
                     }
+                    poff++ ;
                 }
             }
+            ASSERT (poff == Offp [k+1]) ;
         }
     }
 
     /* ---------------------------------------------------------------------- */
-    /* permute scale factors Rs according to pivotal row order */
+    /* save the new scale factors in pivotal row order */
     /* ---------------------------------------------------------------------- */
 
-    if (scale > 0)
+    if (ok && Rnew != NULL)
     {
         for (k = 0 ; k < n ; k++)
         {
-            REAL (X [k]) = Rs [Pnum [k]] ;
-        }
-        for (k = 0 ; k < n ; k++)
-        {
-            Rs [k] = REAL (X [k]) ;
-        }
-    }
-
-#ifndef NDEBUG
-    ASSERT (Numeric->Offp [n] == poff) ;
-    ASSERT (Symbolic->nzoff == poff) ;
-    PRINTF (("\n------------------- Off diagonal entries, new:\n")) ;
-    ASSERT (KLU_valid (n, Numeric->Offp, Numeric->Offi, Offx)) ;
-    if (Common->status == KLU_OK)
-    {
-        PRINTF (("\n ----------- KLU_BTF_REFACTOR done, nblocks %d\n",nblocks));
-        for (block = 0 ; block < nblocks ; block++)
-        {
-            k1 = R [block] ;
-            k2 = R [block+1] ;
-            nk = k2 - k1 ;
-            PRINTF ((
-                "\n--------------- KLU_refactor output: k1 %d k2 %d nk %d\n",
-                k1, k2, nk)) ;
-            if (nk == 1)
-            {
-                PRINTF (("singleton  ")) ;
-                PRINT_ENTRY (Udiag [k1]) ;
-            }
-            else
-            {
-                Lip = Numeric->Lip + k1 ;
-                Llen = Numeric->Llen + k1 ;
-                LU = (Unit *) Numeric->LUbx [block] ;
-                PRINTF (("\n---- L block %d\n", block)) ;
-                ASSERT (KLU_valid_LU (nk, TRUE, Lip, Llen, LU)) ;
-                Uip = Numeric->Uip + k1 ;
-                Ulen = Numeric->Ulen + k1 ;
-                PRINTF (("\n---- U block %d\n", block)) ;
-                ASSERT (KLU_valid_LU (nk, FALSE, Uip, Ulen, LU)) ;
-            }
+            Rs [k] = Rnew [Pnum [k]] ;
         }
     }
-#endif
 
-    return (TRUE) ;
+    KLU_free (Dirty, nblocks, sizeof (Int), Common) ;
+    KLU_free (Mark, n, sizeof (Int), Common) ;
+    KLU_free (Rnew, n, sizeof (double), Common) ;
+    return (ok) ;
 }
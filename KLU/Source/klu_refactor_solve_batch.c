@@ -0,0 +1,604 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_refactor_solve_batch: refactor and solve a batch of matrices
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (c) 2004-2022, University of Florida.  All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+//------------------------------------------------------------------------------
+
+/* Refactorize and solve A_k x_k = b_k for a batch of matrices A_0 ...
+ * A_{nbatch-1} that all have the same nonzero pattern (Ap, Ai) as the matrix
+ * given to KLU_factor, using the ordering in the Symbolic object and the
+ * pivot order and pattern of L and U in a template Numeric object.  This is
+ * like calling KLU_refactor and then KLU_solve for each matrix, except that
+ * the Numeric object is not modified and the factors of each matrix are
+ * discarded once its system has been solved.  The pivot order of the
+ * template is always used as is.  The result agrees with KLU_refactor and
+ * KLU_solve up to rounding, but is not guaranteed to be bitwise identical,
+ * since the floating-point operations are grouped and vectorized differently.
+ *
+ * The work that depends only on the pattern (finding where each entry of A
+ * goes, and the columns of L and U in the LU factors of each block) is done
+ * once for the whole batch.  The matrices are then handled KLU_BATCH at a
+ * time, in lock step, with the values of each entry stored contiguously for
+ * the KLU_BATCH matrices so that the innermost loops can be vectorized.  If
+ * KLU is compiled with OpenMP and Common->nthreads is not 1, each group of
+ * KLU_BATCH matrices is done by a single thread.
+ *
+ * Each block is refactorized and then used right away to solve its part of
+ * the system, so the values of L and U are needed for only one block at a
+ * time.  Entries of A with a zero pivot give Inf or NaN in the solution for
+ * that matrix, as they do in KLU_refactor and KLU_solve;
+ * Common->halt_if_singular is ignored.
+ */
+
+#include "klu_internal.h"
+
+/* number of matrices refactorized at the same time */
+#define KLU_BATCH 4
+
+/* ========================================================================== */
+/* === batch_group ========================================================== */
+/* ========================================================================== */
+
+/* Refactorize and solve for the matrices kfirst to kfirst+KLU_BATCH-1.  If
+ * there are fewer than that left in the batch, the last matrix is repeated
+ * to fill the group, but its solution is only returned once. */
+
+static void batch_group
+(
+    /* inputs, not modified */
+    Int kfirst,
+    Int nbatch,
+    Int Ap [ ],
+    Int Ai [ ],
+    Entry Az [ ],
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int Map [ ],        /* size nz, where each entry of A goes */
+    Int *Lcol [ ],      /* size n, row indices of each column of L */
+    Int *Ucol [ ],      /* size n, row indices of each column of U */
+    Int Lv [ ],         /* size n, position of column k of L in Lx */
+    Int Uv [ ],         /* size n, position of column k of U in Ux */
+
+    /* input/output */
+    Entry Bz [ ],
+    Int Singular [ ],
+
+    /* workspace */
+    double Rs [ ],      /* size n*KLU_BATCH if scale > 0, NULL otherwise */
+    Entry X [ ],        /* size n*KLU_BATCH */
+    Entry W [ ],        /* size maxblock*KLU_BATCH */
+    Entry Lx [ ],       /* size (max entries of L in any block)*KLU_BATCH */
+    Entry Ux [ ],       /* size (max entries of U in any block)*KLU_BATCH */
+    Entry Udiag [ ],    /* size maxblock*KLU_BATCH */
+    KLU_common *Common
+)
+{
+    Entry a [KLU_BATCH], x [KLU_BATCH] ;
+    Entry *Ak [KLU_BATCH], *Bk [KLU_BATCH] ;
+    double *Rk [KLU_BATCH] ;
+    Entry *Xb, *Xi, *Wi, *Lxp, *Uxp ;
+    Int first [KLU_BATCH], found [KLU_BATCH] ;
+    Int *Q, *R, *Pnum, *Llen, *Ulen, *Li, *Ui ;
+    Int n, nz, nblocks, scale, block, k1, k2, nk, k, kk, j, p, pend, m, i,
+        l, len, oldcol ;
+
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    Pnum = Numeric->Pnum ;
+    Llen = Numeric->Llen ;
+    Ulen = Numeric->Ulen ;
+    nz = Ap [n] ;
+    scale = Common->scale ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the matrices in this group, and their scale factors */
+    /* ---------------------------------------------------------------------- */
+
+    for (l = 0 ; l < KLU_BATCH ; l++)
+    {
+        kk = MIN (kfirst + l, nbatch - 1) ;
+        Ak [l] = Az + ((size_t) kk) * nz ;
+        Bk [l] = Bz + ((size_t) kk) * n ;
+        Rk [l] = (scale > 0) ? (Rs + l * n) : NULL ;
+        first [l] = EMPTY ;
+        if (scale > 0)
+        {
+            /* the pattern has already been checked */
+            (void) KLU_scale (scale, n, Ap, Ai, (double *) Ak [l], Rk [l],
+                NULL, Common) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* scale and permute the right-hand sides, X = P*(R\B) */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        i = Pnum [k] ;
+        for (l = 0 ; l < KLU_BATCH ; l++)
+        {
+            if (scale > 0)
+            {
+                SCALE_DIV_ASSIGN (X [k*KLU_BATCH + l], Bk [l][i], Rk [l][i]) ;
+            }
+            else
+            {
+                X [k*KLU_BATCH + l] = Bk [l][i] ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* refactorize and solve each block, last block first */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = nblocks-1 ; block >= 0 ; block--)
+    {
+
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        for (l = 0 ; l < KLU_BATCH ; l++)
+        {
+            found [l] = FALSE ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* refactorize the block */
+        /* ------------------------------------------------------------------ */
+
+        for (k = 0 ; k < nk ; k++)
+        {
+
+            /* scatter kth column of the block into workspace W */
+            oldcol = Q [k+k1] ;
+            pend = Ap [oldcol+1] ;
+            for (p = Ap [oldcol] ; p < pend ; p++)
+            {
+                m = Map [p] ;
+                if (m < 0) continue ;   /* entry in off-diagonal part */
+                i = Ai [p] ;
+                for (l = 0 ; l < KLU_BATCH ; l++)
+                {
+                    if (scale > 0)
+                    {
+                        /* W [m] = Az [p] / Rs [i] */
+                        SCALE_DIV_ASSIGN (W [m*KLU_BATCH + l], Ak [l][p],
+                            Rk [l][i]) ;
+                    }
+                    else
+                    {
+                        W [m*KLU_BATCH + l] = Ak [l][p] ;
+                    }
+                }
+            }
+
+            if (nk == 1)
+            {
+                /* singleton */
+                for (l = 0 ; l < KLU_BATCH ; l++)
+                {
+                    Udiag [l] = W [l] ;
+                    CLEAR (W [l]) ;
+                }
+            }
+            else
+            {
+                /* compute kth column of U, and update kth column of A */
+                Ui = Ucol [k1+k] ;
+                len = Ulen [k1+k] ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Uxp = Ux + (Uv [k1+k] + p) * KLU_BATCH ;
+                    j = Ui [p] ;
+                    for (l = 0 ; l < KLU_BATCH ; l++)
+                    {
+                        x [l] = W [j*KLU_BATCH + l] ;
+                        CLEAR (W [j*KLU_BATCH + l]) ;
+                        Uxp [l] = x [l] ;
+                    }
+                    Li = Lcol [k1+j] ;
+                    m = Llen [k1+j] ;
+                    for (i = 0 ; i < m ; i++)
+                    {
+                        Lxp = Lx + (Lv [k1+j] + i) * KLU_BATCH ;
+                        Wi = W + Li [i] * KLU_BATCH ;
+                        for (l = 0 ; l < KLU_BATCH ; l++)
+                        {
+                            /* W [Li [i]] -= Lx [i] * x */
+                            MULT_SUB (Wi [l], Lxp [l], x [l]) ;
+                        }
+                    }
+                }
+
+                /* get the diagonal entry of U */
+                for (l = 0 ; l < KLU_BATCH ; l++)
+                {
+                    Udiag [k*KLU_BATCH + l] = W [k*KLU_BATCH + l] ;
+                    CLEAR (W [k*KLU_BATCH + l]) ;
+                }
+
+                /* gather and divide by pivot to get kth column of L */
+                Li = Lcol [k1+k] ;
+                len = Llen [k1+k] ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Lxp = Lx + (Lv [k1+k] + p) * KLU_BATCH ;
+                    Wi = W + Li [p] * KLU_BATCH ;
+                    for (l = 0 ; l < KLU_BATCH ; l++)
+                    {
+                        DIV (Lxp [l], Wi [l], Udiag [k*KLU_BATCH + l]) ;
+                        CLEAR (Wi [l]) ;
+                    }
+                }
+            }
+
+            /* check for a zero pivot */
+            for (l = 0 ; l < KLU_BATCH ; l++)
+            {
+                if (IS_ZERO (Udiag [k*KLU_BATCH + l]) && !found [l])
+                {
+                    /* the blocks are done last block first, so this is the
+                     * first zero pivot so far */
+                    first [l] = k+k1 ;
+                    found [l] = TRUE ;
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* solve the block system */
+        /* ------------------------------------------------------------------ */
+
+        if (nk == 1)
+        {
+            for (l = 0 ; l < KLU_BATCH ; l++)
+            {
+                DIV (X [k1*KLU_BATCH + l], X [k1*KLU_BATCH + l], Udiag [l]) ;
+            }
+        }
+        else
+        {
+            Xb = X + k1 * KLU_BATCH ;
+
+            /* solve Lx=b; the unit diagonal of L is not stored */
+            for (k = 0 ; k < nk ; k++)
+            {
+                Li = Lcol [k1+k] ;
+                len = Llen [k1+k] ;
+                for (l = 0 ; l < KLU_BATCH ; l++)
+                {
+                    x [l] = Xb [k*KLU_BATCH + l] ;
+                }
+                for (p = 0 ; p < len ; p++)
+                {
+                    Lxp = Lx + (Lv [k1+k] + p) * KLU_BATCH ;
+                    Xi = Xb + Li [p] * KLU_BATCH ;
+                    for (l = 0 ; l < KLU_BATCH ; l++)
+                    {
+                        /* X [Li [p]] -= Lx [p] * x */
+                        MULT_SUB (Xi [l], Lxp [l], x [l]) ;
+                    }
+                }
+            }
+
+            /* solve Ux=b */
+            for (k = nk-1 ; k >= 0 ; k--)
+            {
+                Ui = Ucol [k1+k] ;
+                len = Ulen [k1+k] ;
+                for (l = 0 ; l < KLU_BATCH ; l++)
+                {
+                    /* x = X [k] / Udiag [k] */
+                    DIV (x [l], Xb [k*KLU_BATCH + l], Udiag [k*KLU_BATCH + l]) ;
+                    Xb [k*KLU_BATCH + l] = x [l] ;
+                }
+                for (p = 0 ; p < len ; p++)
+                {
+                    Uxp = Ux + (Uv [k1+k] + p) * KLU_BATCH ;
+                    Xi = Xb + Ui [p] * KLU_BATCH ;
+                    for (l = 0 ; l < KLU_BATCH ; l++)
+                    {
+                        /* X [Ui [p]] -= Ux [p] * x */
+                        MULT_SUB (Xi [l], Uxp [l], x [l]) ;
+                    }
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* block back-substitution for the off-diagonal-block entries */
+        /* ------------------------------------------------------------------ */
+
+        if (block > 0)
+        {
+            for (k = k1 ; k < k2 ; k++)
+            {
+                oldcol = Q [k] ;
+                pend = Ap [oldcol+1] ;
+                for (l = 0 ; l < KLU_BATCH ; l++)
+                {
+                    x [l] = X [k*KLU_BATCH + l] ;
+                }
+                for (p = Ap [oldcol] ; p < pend ; p++)
+                {
+                    m = Map [p] ;
+                    if (m >= 0) continue ;  /* entry in the diagonal block */
+                    Xi = X + FLIP (m) * KLU_BATCH ;
+                    i = Ai [p] ;
+                    for (l = 0 ; l < KLU_BATCH ; l++)
+                    {
+                        if (scale > 0)
+                        {
+                            /* a = Az [p] / Rs [i] */
+                            SCALE_DIV_ASSIGN (a [l], Ak [l][p], Rk [l][i]) ;
+                        }
+                        else
+                        {
+                            a [l] = Ak [l][p] ;
+                        }
+                        /* X [FLIP (m)] -= a * x */
+                        MULT_SUB (Xi [l], a [l], x [l]) ;
+                    }
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute the result, B = Q*X, and return the zero pivots */
+    /* ---------------------------------------------------------------------- */
+
+    for (l = 0 ; l < KLU_BATCH && kfirst + l < nbatch ; l++)
+    {
+        for (k = 0 ; k < n ; k++)
+        {
+            Bk [l][Q [k]] = X [k*KLU_BATCH + l] ;
+        }
+        Singular [kfirst + l] = first [l] ;
+    }
+}
+
+
+/* ========================================================================== */
+/* === KLU_refactor_solve_batch ============================================= */
+/* ========================================================================== */
+
+int KLU_refactor_solve_batch    /* returns TRUE if successful, FALSE otherwise */
+(
+    /* inputs, not modified */
+    Int Ap [ ],         /* size n+1, column pointers */
+    Int Ai [ ],         /* size nz, row indices */
+    double Ax [ ],      /* size nz*nbatch, values of each matrix in turn */
+    Int nbatch,         /* number of matrices */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,       /* pivot order and pattern, not modified */
+
+    /* right-hand-sides on input, overwritten with the solutions on output */
+    double B [ ],       /* size n*nbatch, b_k in B [k*n ... (k+1)*n-1] */
+
+    /* output, optional */
+    Int Singular [ ],   /* size nbatch, first zero pivot of each matrix */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    KLU_common *Tcommon ;
+    Entry *Az, *Bz, *Work ;
+    double *Rwork ;
+    Int **Lcol, **Ucol ;
+    Unit **LUbx ;
+    Int *Map, *Lv, *Uv, *Pinv, *Q, *R, *Lip, *Uip, *Llen, *Ulen, *Li, *Ui,
+        *Sing ;
+    size_t wsize, rsize ;
+    Int n, nz, nblocks, maxblock, block, k1, k2, nk, k, p, pend, newrow,
+        lsize, usize, maxl, maxu, ngroups, nthreads, tid, g, ok = TRUE,
+        singular ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Numeric == NULL || Symbolic == NULL || Ap == NULL || Ai == NULL ||
+        Ax == NULL || B == NULL || nbatch < 0)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+    Common->numerical_rank = EMPTY ;
+    Common->singular_col = EMPTY ;
+    if (nbatch == 0)
+    {
+        return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get the contents of the Symbolic and Numeric objects */
+    /* ---------------------------------------------------------------------- */
+
+    n = Symbolic->n ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+
+    Pinv = Numeric->Pinv ;
+    Lip  = Numeric->Lip ;
+    Llen = Numeric->Llen ;
+    Uip  = Numeric->Uip ;
+    Ulen = Numeric->Ulen ;
+    LUbx = (Unit **) Numeric->LUbx ;
+
+    Az = (Entry *) Ax ;
+    Bz = (Entry *) B ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check the pattern of the input matrix */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common->scale >= 0)
+    {
+        /* check for out-of-range indices, but do not check for duplicates */
+        if (!KLU_scale (0, n, Ap, Ai, Ax, NULL, NULL, Common))
+        {
+            return (FALSE) ;
+        }
+    }
+    nz = Ap [n] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the workspace shared by all matrices */
+    /* ---------------------------------------------------------------------- */
+
+    Map  = KLU_malloc (nz, sizeof (Int), Common) ;
+    Lv   = KLU_malloc (n, sizeof (Int), Common) ;
+    Uv   = KLU_malloc (n, sizeof (Int), Common) ;
+    Lcol = KLU_malloc (n, sizeof (Int *), Common) ;
+    Ucol = KLU_malloc (n, sizeof (Int *), Common) ;
+    Sing = (Singular != NULL) ? Singular :
+        KLU_malloc (nbatch, sizeof (Int), Common) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find where each entry goes, and the columns of L and U */
+    /* ---------------------------------------------------------------------- */
+
+    maxl = 0 ;
+    maxu = 0 ;
+    for (block = 0 ; Common->status == KLU_OK && block < nblocks ; block++)
+    {
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+        lsize = 0 ;
+        usize = 0 ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            /* the entries of column Q [k] of A */
+            pend = Ap [Q [k]+1] ;
+            for (p = Ap [Q [k]] ; p < pend ; p++)
+            {
+                newrow = Pinv [Ai [p]] - k1 ;
+                /* FLIP of the row in X, or the row in the block */
+                Map [p] = (newrow < 0) ? FLIP (newrow + k1) : newrow ;
+            }
+
+            /* the columns of L and U */
+            if (nk > 1)
+            {
+                GET_I_POINTER (LUbx [block], Lip, Li, k) ;
+                GET_I_POINTER (LUbx [block], Uip, Ui, k) ;
+                Lcol [k] = Li ;
+                Ucol [k] = Ui ;
+                Lv [k] = lsize ;
+                Uv [k] = usize ;
+                lsize += Llen [k] ;
+                usize += Ulen [k] ;
+            }
+        }
+        maxl = MAX (maxl, lsize) ;
+        maxu = MAX (maxu, usize) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate the workspace for each thread */
+    /* ---------------------------------------------------------------------- */
+
+    ngroups = (nbatch + KLU_BATCH - 1) / KLU_BATCH ;
+    nthreads = KLU_parallel_threads (ngroups, Common) ;
+
+    /* X (n), W (maxblock), Lx (maxl), Ux (maxu), Udiag (maxblock) */
+    wsize = KLU_add_size_t (n, maxblock, &ok) ;
+    wsize = KLU_add_size_t (wsize, maxl, &ok) ;
+    wsize = KLU_add_size_t (wsize, maxu, &ok) ;
+    wsize = KLU_add_size_t (wsize, maxblock, &ok) ;
+    wsize = KLU_mult_size_t (wsize, KLU_BATCH, &ok) ;
+    rsize = (Common->scale > 0) ? KLU_mult_size_t (n, KLU_BATCH, &ok) : 0 ;
+    if (!ok)
+    {
+        Common->status = KLU_TOO_LARGE ;
+    }
+    Work = KLU_malloc (KLU_mult_size_t (wsize, nthreads, &ok), sizeof (Entry),
+        Common) ;
+    Rwork = KLU_malloc (KLU_mult_size_t (rsize, nthreads, &ok),
+        sizeof (double), Common) ;
+    Tcommon = KLU_malloc (nthreads, sizeof (KLU_common), Common) ;
+
+    if (Common->status == KLU_OK)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* refactorize and solve each group of matrices */
+        /* ------------------------------------------------------------------ */
+
+        for (tid = 0 ; tid < nthreads ; tid++)
+        {
+            Tcommon [tid] = *Common ;
+            for (k = 0 ; k < (Int) wsize ; k++)
+            {
+                CLEAR (Work [tid * wsize + k]) ;
+            }
+        }
+
+        #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+        for (g = 0 ; g < ngroups ; g++)
+        {
+            Int me = SUITESPARSE_OPENMP_GET_THREAD_ID ;
+            Entry *X = Work + me * wsize ;
+            Entry *W = X + ((size_t) n) * KLU_BATCH ;
+            Entry *Lxw = W + ((size_t) maxblock) * KLU_BATCH ;
+            Entry *Uxw = Lxw + ((size_t) maxl) * KLU_BATCH ;
+            Entry *Udiag = Uxw + ((size_t) maxu) * KLU_BATCH ;
+            double *Rs = (rsize > 0) ? (Rwork + me * rsize) : NULL ;
+            batch_group (g * KLU_BATCH, nbatch, Ap, Ai, Az, Symbolic, Numeric,
+                Map, Lcol, Ucol, Lv, Uv, Bz, Sing, Rs, X, W, Lxw, Uxw, Udiag,
+                &(Tcommon [me])) ;
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* find the first matrix with a zero pivot */
+        /* ------------------------------------------------------------------ */
+
+        for (k = 0 ; k < nbatch ; k++)
+        {
+            singular = Sing [k] ;
+            if (singular != EMPTY)
+            {
+                /* matrix k is numerically singular */
+                Common->status = KLU_SINGULAR ;
+                Common->numerical_rank = singular ;
+                Common->singular_col = Q [singular] ;
+                break ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* free workspace and return result */
+    /* ---------------------------------------------------------------------- */
+
+    KLU_free (Map, nz, sizeof (Int), Common) ;
+    KLU_free (Lv, n, sizeof (Int), Common) ;
+    KLU_free (Uv, n, sizeof (Int), Common) ;
+    KLU_free (Lcol, n, sizeof (Int *), Common) ;
+    KLU_free (Ucol, n, sizeof (Int *), Common) ;
+    if (Singular == NULL)
+    {
+        KLU_free (Sing, nbatch, sizeof (Int), Common) ;
+    }
+    KLU_free (Work, wsize * nthreads, sizeof (Entry), Common) ;
+    KLU_free (Rwork, rsize * nthreads, sizeof (double), Common) ;
+    KLU_free (Tcommon, nthreads, sizeof (KLU_common), Common) ;
+    return (Common->status >= KLU_OK) ;
+}
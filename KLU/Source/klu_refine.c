@@ -0,0 +1,320 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_refine: solve Ax=b with single precision LU factors
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (c) 2004-2022, University of Florida.  All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+//------------------------------------------------------------------------------
+
+/* Solve Ax=b in double precision, using the single precision LU factors of A
+ * from KLU_factor or KLU_refactor (klu_s_factor, klu_c_factor, ...) and
+ * mixed precision iterative refinement.  A and B are held in double
+ * precision; only the solves with L and U are done in single precision.
+ *
+ * The solution x is first found with the single precision factors.  Then, for
+ * each column of B, the residual r = b-A*x is computed in double precision,
+ * along with the componentwise backward error
+ *
+ *      berr = max (abs (r) ./ (abs (A)*abs (x) + abs (b)))
+ *
+ * If berr is not yet at the level of the double precision roundoff, the
+ * correction A\r is found with the single precision factors and added to x.
+ * Refinement of a column stops when berr reaches that level, when a step
+ * fails to reduce berr by at least a factor of two, or after maxiter steps.
+ * The columns that still need refinement are solved together.  The iterate
+ * with the smallest berr is returned for each column, so a last step that
+ * makes berr worse is undone.
+ *
+ * The largest number of refinement steps taken for any column is returned in
+ * Common->nrefine, and the largest berr of the returned iterates in
+ * Common->berr.
+ * Only compiled for the single precision versions of KLU.
+ */
+
+#include "klu_internal.h"
+
+#ifdef SINGLE
+
+#include <float.h>
+
+#ifdef COMPLEX
+#define XSIZE 2
+#else
+#define XSIZE 1
+#endif
+
+/* ========================================================================== */
+/* === residual ============================================================= */
+/* ========================================================================== */
+
+/* Compute r = b-A*x for one column, in double precision, and return the
+ * componentwise backward error.  D is workspace of size n. */
+
+static double residual
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],
+    double B [ ],       /* size n*XSIZE */
+    double X [ ],       /* size n*XSIZE */
+    double R [ ],       /* size n*XSIZE, residual on output */
+    double D [ ]        /* size n, workspace */
+)
+{
+    double berr, ri, di, xabs ;
+#ifdef COMPLEX
+    double xr, xi, ar, ai ;
+#else
+    double xj ;
+#endif
+    Int i, j, p, pend ;
+
+    for (i = 0 ; i < n*XSIZE ; i++)
+    {
+        R [i] = B [i] ;
+    }
+    for (i = 0 ; i < n ; i++)
+    {
+#ifdef COMPLEX
+        D [i] = fabs (B [2*i]) + fabs (B [2*i+1]) ;
+#else
+        D [i] = fabs (B [i]) ;
+#endif
+    }
+
+    for (j = 0 ; j < n ; j++)
+    {
+        pend = Ap [j+1] ;
+#ifdef COMPLEX
+        xr = X [2*j] ;
+        xi = X [2*j+1] ;
+        xabs = fabs (xr) + fabs (xi) ;
+        for (p = Ap [j] ; p < pend ; p++)
+        {
+            ar = Ax [2*p] ;
+            ai = Ax [2*p+1] ;
+            i = Ai [p] ;
+            R [2*i  ] -= ar * xr - ai * xi ;
+            R [2*i+1] -= ai * xr + ar * xi ;
+            D [i] += (fabs (ar) + fabs (ai)) * xabs ;
+        }
+#else
+        xj = X [j] ;
+        xabs = fabs (xj) ;
+        for (p = Ap [j] ; p < pend ; p++)
+        {
+            i = Ai [p] ;
+            R [i] -= Ax [p] * xj ;
+            D [i] += fabs (Ax [p]) * xabs ;
+        }
+#endif
+    }
+
+    /* berr = max (abs (r) ./ (abs (A)*abs (x) + abs (b))), with 0/0 = 0 */
+    berr = 0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+#ifdef COMPLEX
+        ri = fabs (R [2*i]) + fabs (R [2*i+1]) ;
+#else
+        ri = fabs (R [i]) ;
+#endif
+        di = D [i] ;
+        if (ri > 0)
+        {
+            berr = MAX (berr, (di > 0) ? (ri / di) : INFINITY) ;
+        }
+    }
+    return (berr) ;
+}
+
+/* ========================================================================== */
+/* === KLU_refine =========================================================== */
+/* ========================================================================== */
+
+int KLU_refine
+(
+    /* inputs, not modified */
+    Int Ap [ ],             /* size n+1, column pointers */
+    Int Ai [ ],             /* size nz, row indices */
+    double Ax [ ],          /* size nz (2*nz if complex), values of A */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,   /* single precision factors of A */
+    Int d,                  /* leading dimension of B */
+    Int nrhs,               /* number of right-hand-sides */
+    Int maxiter,            /* max # of refinement steps for each column */
+
+    /* right-hand-side on input, overwritten with solution to Ax=b on output */
+    double B [ ],           /* size d*nrhs (2*d*nrhs if complex) */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    double eps, berr, *X, *Xlast, *R, *D, *Lastberr ;
+    Scalar *W ;
+    Int *Active ;
+    size_t nx ;
+    Int n, i, j, k, iter, nactive, nleft, ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Numeric == NULL || Symbolic == NULL || Ap == NULL || Ai == NULL ||
+        Ax == NULL || d < Symbolic->n || nrhs < 0 || maxiter < 0 ||
+        B == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+    Common->nrefine = 0 ;
+    Common->berr = 0 ;
+    n = Symbolic->n ;
+    if (nrhs == 0)
+    {
+        return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate workspace */
+    /* ---------------------------------------------------------------------- */
+
+    /* X and R hold the solution and residual of each column, Xlast the
+     * solution before the last step, and W the residual in single precision */
+    nx = KLU_mult_size_t (KLU_mult_size_t (n, XSIZE, &ok), nrhs, &ok) ;
+    if (!ok)
+    {
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    X = KLU_malloc (nx, sizeof (double), Common) ;
+    Xlast = KLU_malloc (nx, sizeof (double), Common) ;
+    R = KLU_malloc (nx, sizeof (double), Common) ;
+    W = KLU_malloc (nx, sizeof (Scalar), Common) ;
+    D = KLU_malloc (n, sizeof (double), Common) ;
+    Lastberr = KLU_malloc (nrhs, sizeof (double), Common) ;
+    Active = KLU_malloc (nrhs, sizeof (Int), Common) ;
+    ok = (Common->status == KLU_OK) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* solve Ax=b with the single precision factors */
+    /* ---------------------------------------------------------------------- */
+
+    for (j = 0 ; ok && j < nrhs ; j++)
+    {
+        for (i = 0 ; i < n*XSIZE ; i++)
+        {
+            W [j*n*XSIZE + i] = (Scalar) B [j*d*XSIZE + i] ;
+        }
+        Active [j] = j ;
+        Lastberr [j] = INFINITY ;
+    }
+    ok = ok && KLU_solve (Symbolic, Numeric, n, nrhs, W, Common) ;
+    for (k = 0 ; ok && k < (Int) nx ; k++)
+    {
+        X [k] = (double) W [k] ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* refine the columns until they converge */
+    /* ---------------------------------------------------------------------- */
+
+    eps = DBL_EPSILON ;
+    nactive = nrhs ;
+    for (iter = 0 ; ok && nactive > 0 ; iter++)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* compute the residual of each active column, and keep the columns
+         * that need another step */
+        /* ------------------------------------------------------------------ */
+
+        nleft = 0 ;
+        for (k = 0 ; k < nactive ; k++)
+        {
+            j = Active [k] ;
+            berr = residual (n, Ap, Ai, Ax, B + j*d*XSIZE, X + j*n*XSIZE,
+                R + j*n*XSIZE, D) ;
+            if (berr > eps && iter < maxiter && berr <= Lastberr [j] / 2)
+            {
+                /* refine this column again */
+                Active [nleft++] = j ;
+                Lastberr [j] = berr ;
+            }
+            else
+            {
+                /* this column is done */
+                if (iter > 0 && !(berr <= Lastberr [j]))
+                {
+                    /* the last step made x worse; go back to the prior x */
+                    for (i = 0 ; i < n*XSIZE ; i++)
+                    {
+                        X [j*n*XSIZE + i] = Xlast [j*n*XSIZE + i] ;
+                    }
+                    berr = Lastberr [j] ;
+                }
+                Common->berr = MAX (Common->berr, berr) ;
+            }
+        }
+        nactive = nleft ;
+        if (nactive == 0)
+        {
+            break ;
+        }
+        Common->nrefine = iter + 1 ;
+
+        /* ------------------------------------------------------------------ */
+        /* solve A*dx = r for the active columns, and update x */
+        /* ------------------------------------------------------------------ */
+
+        for (k = 0 ; k < nactive ; k++)
+        {
+            j = Active [k] ;
+            for (i = 0 ; i < n*XSIZE ; i++)
+            {
+                W [k*n*XSIZE + i] = (Scalar) R [j*n*XSIZE + i] ;
+            }
+        }
+        ok = KLU_solve (Symbolic, Numeric, n, nactive, W, Common) ;
+        for (k = 0 ; ok && k < nactive ; k++)
+        {
+            j = Active [k] ;
+            for (i = 0 ; i < n*XSIZE ; i++)
+            {
+                Xlast [j*n*XSIZE + i] = X [j*n*XSIZE + i] ;
+                X [j*n*XSIZE + i] += (double) W [k*n*XSIZE + i] ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* return the solution in B */
+    /* ---------------------------------------------------------------------- */
+
+    for (j = 0 ; ok && j < nrhs ; j++)
+    {
+        for (i = 0 ; i < n*XSIZE ; i++)
+        {
+            B [j*d*XSIZE + i] = X [j*n*XSIZE + i] ;
+        }
+    }
+
+    KLU_free (X, nx, sizeof (double), Common) ;
+    KLU_free (Xlast, nx, sizeof (double), Common) ;
+    KLU_free (R, nx, sizeof (double), Common) ;
+    KLU_free (W, nx, sizeof (Scalar), Common) ;
+    KLU_free (D, n, sizeof (double), Common) ;
+    KLU_free (Lastberr, nrhs, sizeof (double), Common) ;
+    KLU_free (Active, nrhs, sizeof (Int), Common) ;
+    return (ok) ;
+}
+
+#endif
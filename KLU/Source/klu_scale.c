@@ -29,7 +29,7 @@ int KLU_scale           /* return TRUE if successful, FALSE otherwise */
     Int n,
     Int Ap [ ],         /* size n+1, column pointers */
     Int Ai [ ],         /* size nz, row indices */
-    double Ax [ ],
+    Scalar Ax [ ],
     /* outputs, not defined on input */
     double Rs [ ],      /* size n, can be NULL if scale <= 0 */
     /* workspace, not defined on input or output */
@@ -0,0 +1,441 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_serialize_numeric: save and load a Numeric object
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (c) 2004-2022, University of Florida.  All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+//------------------------------------------------------------------------------
+
+/* Saves a Numeric object into a single array of bytes (the "blob"), or
+ * creates a Numeric object from such a blob, either by copying it or by
+ * pointing into it.
+ *
+ * The blob holds a klu_blob_header, a copy of the KLU_numeric struct, the
+ * arrays Pnum, Pinv, Lip, Uip, Llen, Ulen, LUsize, Udiag, Rs (if present),
+ * Offp, Offi, Offx, and Dstart, and then the LU factors LUbx [block] of each
+ * block that is not a singleton.  Each array starts on a KLU_BLOB_ALIGN byte
+ * boundary.  The workspace Numeric->Work is not saved.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === numeric_blob ========================================================= */
+/* ========================================================================== */
+
+/* Finds where each part of a serialized Numeric object is held in the blob,
+ * and returns the size of the blob.  Offset [0] is the offset of the
+ * KLU_numeric struct, Offset [1..13] are the offsets of the arrays Pnum to
+ * Dstart, in the order listed above, and Offset [14] is the end of Dstart.
+ * The LU factors of each block follow, if LUsize is not NULL.  Otherwise, the
+ * size up to the end of Dstart is returned.  *ok is set to FALSE on overflow.
+ */
+
+static size_t numeric_blob
+(
+    KLU_numeric *Numeric,
+    int scaled,
+    size_t LUsize [ ],
+    size_t Offset [15],
+    Int *ok
+)
+{
+    size_t n, nblocks, nzoff, next ;
+    Int block ;
+
+    n = Numeric->n ;
+    nblocks = Numeric->nblocks ;
+    nzoff = Numeric->nzoff ;
+
+    Offset [0]  = KLU_blob_array (sizeof (klu_blob_header), 1,
+        sizeof (KLU_numeric), &next, ok) ;
+    Offset [1]  = KLU_blob_array (next, n,       sizeof (Int),    &next, ok) ;
+    Offset [2]  = KLU_blob_array (next, n,       sizeof (Int),    &next, ok) ;
+    Offset [3]  = KLU_blob_array (next, n,       sizeof (Int),    &next, ok) ;
+    Offset [4]  = KLU_blob_array (next, n,       sizeof (Int),    &next, ok) ;
+    Offset [5]  = KLU_blob_array (next, n,       sizeof (Int),    &next, ok) ;
+    Offset [6]  = KLU_blob_array (next, n,       sizeof (Int),    &next, ok) ;
+    Offset [7]  = KLU_blob_array (next, nblocks, sizeof (size_t), &next, ok) ;
+    Offset [8]  = KLU_blob_array (next, n,       sizeof (Entry),  &next, ok) ;
+    Offset [9]  = KLU_blob_array (next, scaled ? n : 0, sizeof (double),
+        &next, ok) ;
+    Offset [10] = KLU_blob_array (next, n+1,     sizeof (Int),    &next, ok) ;
+    Offset [11] = KLU_blob_array (next, nzoff+1, sizeof (Int),    &next, ok) ;
+    Offset [12] = KLU_blob_array (next, nzoff+1, sizeof (Entry),  &next, ok) ;
+    Offset [13] = KLU_blob_array (next, nblocks, sizeof (Int),    &next, ok) ;
+    Offset [14] = next ;
+
+    if (LUsize != NULL)
+    {
+        for (block = 0 ; block < (Int) nblocks ; block++)
+        {
+            (void) KLU_blob_array (next, LUsize [block], sizeof (Unit), &next,
+                ok) ;
+        }
+    }
+    (*ok) = (*ok) && (next <= (size_t) INT64_MAX) ;
+    return (next) ;
+}
+
+/* ========================================================================== */
+/* === numeric_header ======================================================= */
+/* ========================================================================== */
+
+static void numeric_header
+(
+    klu_blob_header *Header,
+    size_t blobsize,
+    int scaled
+)
+{
+    memset (Header, 0, sizeof (klu_blob_header)) ;
+    Header->blobsize = (int64_t) blobsize ;
+    Header->kind = KLU_NUMERIC_BLOB ;
+    Header->version [0] = KLU_MAIN_VERSION ;
+    Header->version [1] = KLU_SUB_VERSION ;
+    Header->version [2] = KLU_SUBSUB_VERSION ;
+    Header->object_size = sizeof (KLU_numeric) ;
+    Header->int_size = sizeof (Int) ;
+    Header->entry_size = sizeof (Entry) ;
+    Header->pointer_size = sizeof (void *) ;
+    Header->scaled = scaled ;
+}
+
+/* ========================================================================== */
+/* === KLU_serialize_numeric_size =========================================== */
+/* ========================================================================== */
+
+int KLU_serialize_numeric_size      /* returns TRUE if OK, FALSE otherwise */
+(
+    KLU_numeric *Numeric,
+    int64_t *blobsize,          /* output: size of the blob, in bytes */
+    KLU_common *Common
+)
+{
+    size_t Offset [15], size ;
+    Int ok = TRUE ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+    if (Numeric == NULL || blobsize == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    size = numeric_blob (Numeric, Numeric->Rs != NULL, Numeric->LUsize,
+        Offset, &ok) ;
+    if (!ok)
+    {
+        /* the blob would be too large */
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    (*blobsize) = (int64_t) size ;
+    return (TRUE) ;
+}
+
+/* ========================================================================== */
+/* === KLU_serialize_numeric ================================================ */
+/* ========================================================================== */
+
+int KLU_serialize_numeric           /* returns TRUE if OK, FALSE otherwise */
+(
+    KLU_numeric *Numeric,
+    int8_t *blob,               /* output: blob of size blobsize */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    KLU_common *Common
+)
+{
+    klu_blob_header Header ;
+    KLU_numeric S ;
+    Unit **LUbx ;
+    size_t Offset [15], size, n, nblocks, nzoff, next, p ;
+    Int block, scaled, ok = TRUE ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+    if (Numeric == NULL || blob == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    scaled = (Numeric->Rs != NULL) ;
+    size = numeric_blob (Numeric, scaled, Numeric->LUsize, Offset, &ok) ;
+    if (!ok)
+    {
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    if (blobsize < 0 || (size_t) blobsize < size)
+    {
+        /* the blob is too small */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    /* the padding between the arrays is zero */
+    memset (blob, 0, size) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the header, and the Numeric struct without its pointers */
+    /* ---------------------------------------------------------------------- */
+
+    numeric_header (&Header, size, scaled) ;
+    memcpy (blob, &Header, sizeof (klu_blob_header)) ;
+    S = *Numeric ;
+    S.Pnum = NULL ;
+    S.Pinv = NULL ;
+    S.Lip = NULL ;
+    S.Uip = NULL ;
+    S.Llen = NULL ;
+    S.Ulen = NULL ;
+    S.LUbx = NULL ;
+    S.LUsize = NULL ;
+    S.Udiag = NULL ;
+    S.Rs = NULL ;
+    S.Work = NULL ;
+    S.Xwork = NULL ;
+    S.Iwork = NULL ;
+    S.Offp = NULL ;
+    S.Offi = NULL ;
+    S.Offx = NULL ;
+    S.Dstart = NULL ;
+    S.blob = NULL ;
+    memcpy (blob + Offset [0], &S, sizeof (KLU_numeric)) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* the arrays */
+    /* ---------------------------------------------------------------------- */
+
+    n = Numeric->n ;
+    nblocks = Numeric->nblocks ;
+    nzoff = Numeric->nzoff ;
+    memcpy (blob + Offset [1],  Numeric->Pnum,   n * sizeof (Int)) ;
+    memcpy (blob + Offset [2],  Numeric->Pinv,   n * sizeof (Int)) ;
+    memcpy (blob + Offset [3],  Numeric->Lip,    n * sizeof (Int)) ;
+    memcpy (blob + Offset [4],  Numeric->Uip,    n * sizeof (Int)) ;
+    memcpy (blob + Offset [5],  Numeric->Llen,   n * sizeof (Int)) ;
+    memcpy (blob + Offset [6],  Numeric->Ulen,   n * sizeof (Int)) ;
+    memcpy (blob + Offset [7],  Numeric->LUsize, nblocks * sizeof (size_t)) ;
+    memcpy (blob + Offset [8],  Numeric->Udiag,  n * sizeof (Entry)) ;
+    if (scaled)
+    {
+        memcpy (blob + Offset [9], Numeric->Rs,  n * sizeof (double)) ;
+    }
+    memcpy (blob + Offset [10], Numeric->Offp,   (n+1) * sizeof (Int)) ;
+    memcpy (blob + Offset [11], Numeric->Offi,   (nzoff+1) * sizeof (Int)) ;
+    memcpy (blob + Offset [12], Numeric->Offx,   (nzoff+1) * sizeof (Entry)) ;
+    memcpy (blob + Offset [13], Numeric->Dstart, nblocks * sizeof (Int)) ;
+
+    /* the LU factors of each block */
+    LUbx = (Unit **) Numeric->LUbx ;
+    next = Offset [14] ;
+    for (block = 0 ; block < (Int) nblocks ; block++)
+    {
+        p = KLU_blob_array (next, Numeric->LUsize [block], sizeof (Unit),
+            &next, &ok) ;
+        if (Numeric->LUsize [block] > 0)
+        {
+            memcpy (blob + p, LUbx [block],
+                Numeric->LUsize [block] * sizeof (Unit)) ;
+        }
+    }
+    ASSERT (next == size) ;
+    return (TRUE) ;
+}
+
+/* ========================================================================== */
+/* === KLU_deserialize_numeric ============================================== */
+/* ========================================================================== */
+
+KLU_numeric *KLU_deserialize_numeric    /* returns NULL if error */
+(
+    int8_t *blob,               /* blob from KLU_serialize_numeric */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    int wrap,                   /* if true, point into the blob instead of
+                                 * copying it */
+    KLU_common *Common
+)
+{
+    klu_blob_header Header, Expected ;
+    KLU_numeric *Numeric, S ;
+    Unit **LUbx ;
+    size_t Offset [15], size, n, nblocks, nzoff, next, p ;
+    Int block, scaled, ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (NULL) ;
+    }
+    Common->status = KLU_OK ;
+    if (blob == NULL || blobsize < (int64_t) sizeof (klu_blob_header)
+        || (wrap && ((size_t) blob) % KLU_BLOB_START != 0))
+    {
+        /* blob missing, too small, or not aligned */
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* the blob must be a Numeric object of this kind, from this version of
+     * KLU */
+    memcpy (&Header, blob, sizeof (klu_blob_header)) ;
+    scaled = (Header.scaled != 0) ;
+    numeric_header (&Expected, Header.blobsize, scaled) ;
+    if (memcmp (&Header, &Expected, sizeof (klu_blob_header)) != 0
+        || Header.blobsize > blobsize)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* get the Numeric struct, and make sure the arrays fit in the blob */
+    Offset [0] = KLU_blob_array (sizeof (klu_blob_header), 1,
+        sizeof (KLU_numeric), &size, &ok) ;
+    if (size > (size_t) Header.blobsize)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+    memcpy (&S, blob + Offset [0], sizeof (KLU_numeric)) ;
+    if (S.n < 0 || S.nblocks < 0 || S.nblocks > S.n || S.nzoff < 0
+        || (S.n > 0 && S.nblocks == 0)
+        || S.worksize % sizeof (double) != 0
+        || S.worksize < ((size_t) S.nblocks) * sizeof (double)
+        || (S.worksize - ((size_t) S.nblocks) * sizeof (double)) / 4
+            < ((size_t) S.n) * sizeof (Entry))
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+    size = numeric_blob (&S, scaled, NULL, Offset, &ok) ;
+    if (!ok || size > (size_t) Header.blobsize)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* create the Numeric object */
+    /* ---------------------------------------------------------------------- */
+
+    Numeric = KLU_malloc (1, sizeof (KLU_numeric), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory */
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    n = S.n ;
+    nblocks = S.nblocks ;
+    nzoff = S.nzoff ;
+    *Numeric = S ;
+    Numeric->Pnum = NULL ;
+    Numeric->Pinv = NULL ;
+    Numeric->Lip = NULL ;
+    Numeric->Uip = NULL ;
+    Numeric->Llen = NULL ;
+    Numeric->Ulen = NULL ;
+    Numeric->LUbx = NULL ;
+    Numeric->LUsize = NULL ;
+    Numeric->Udiag = NULL ;
+    Numeric->Rs = NULL ;
+    Numeric->Work = NULL ;
+    Numeric->Offp = NULL ;
+    Numeric->Offi = NULL ;
+    Numeric->Offx = NULL ;
+    Numeric->Dstart = NULL ;
+    Numeric->blob = wrap ? blob : NULL ;
+
+    /* the size of each LUbx [block] */
+    Numeric->LUsize = KLU_blob_read (blob, Offset [7], nblocks,
+        sizeof (size_t), wrap, Common) ;
+    Numeric->LUbx = KLU_malloc (nblocks, sizeof (Unit *), Common) ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    if (LUbx != NULL)
+    {
+        /* clear LUbx first, since KLU_free_numeric frees each LUbx [block] */
+        for (block = 0 ; block < (Int) nblocks ; block++)
+        {
+            LUbx [block] = NULL ;
+        }
+    }
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory */
+        KLU_free_numeric (&Numeric, Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    size = numeric_blob (&S, scaled, Numeric->LUsize, Offset, &ok) ;
+    if (!ok || size != (size_t) Header.blobsize)
+    {
+        KLU_free_numeric (&Numeric, Common) ;
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* the arrays */
+    Numeric->Pnum   = KLU_blob_read (blob, Offset [1],  n, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Pinv   = KLU_blob_read (blob, Offset [2],  n, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Lip    = KLU_blob_read (blob, Offset [3],  n, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Uip    = KLU_blob_read (blob, Offset [4],  n, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Llen   = KLU_blob_read (blob, Offset [5],  n, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Ulen   = KLU_blob_read (blob, Offset [6],  n, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Udiag  = KLU_blob_read (blob, Offset [8],  n, sizeof (Entry),
+        wrap, Common) ;
+    Numeric->Rs     = scaled ? KLU_blob_read (blob, Offset [9], n,
+        sizeof (double), wrap, Common) : NULL ;
+    Numeric->Offp   = KLU_blob_read (blob, Offset [10], n+1, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Offi   = KLU_blob_read (blob, Offset [11], nzoff+1, sizeof (Int),
+        wrap, Common) ;
+    Numeric->Offx   = KLU_blob_read (blob, Offset [12], nzoff+1,
+        sizeof (Entry), wrap, Common) ;
+    Numeric->Dstart = KLU_blob_read (blob, Offset [13], nblocks, sizeof (Int),
+        wrap, Common) ;
+
+    /* the LU factors of each block */
+    next = Offset [14] ;
+    for (block = 0 ; block < (Int) nblocks ; block++)
+    {
+        p = KLU_blob_array (next, Numeric->LUsize [block], sizeof (Unit),
+            &next, &ok) ;
+        if (Numeric->LUsize [block] > 0)
+        {
+            LUbx [block] = KLU_blob_read (blob, p, Numeric->LUsize [block],
+                sizeof (Unit), wrap, Common) ;
+        }
+    }
+
+    /* the workspace, which is never held in the blob */
+    Numeric->Work = KLU_malloc (Numeric->worksize, 1, Common) ;
+    Numeric->Xwork = Numeric->Work ;
+    Numeric->Iwork = (Int *) ((Unit *) Numeric->Xwork + UNITS (Entry, n)) ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory */
+        KLU_free_numeric (&Numeric, Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    return (Numeric) ;
+}
@@ -0,0 +1,266 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_serialize_symbolic: save and load a Symbolic object
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (c) 2004-2022, University of Florida.  All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+//------------------------------------------------------------------------------
+
+/* Saves a Symbolic object into a single array of bytes (the "blob"), or
+ * creates a Symbolic object from such a blob, either by copying it or by
+ * pointing into it.
+ *
+ * The blob holds a klu_blob_header, a copy of the KLU_symbolic struct, and
+ * then P, Q, R and Lnz, each starting on a KLU_BLOB_ALIGN byte boundary.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === symbolic_blob ======================================================== */
+/* ========================================================================== */
+
+/* Finds where each part of a serialized Symbolic object is held in the blob,
+ * and returns the size of the blob.  Offset [0] is the offset of the
+ * KLU_symbolic struct, and Offset [1..4] are the offsets of P, Q, R, and Lnz.
+ * *ok is set to FALSE on overflow. */
+
+static size_t symbolic_blob
+(
+    KLU_symbolic *Symbolic,
+    size_t Offset [5],
+    Int *ok
+)
+{
+    size_t n, next ;
+    n = Symbolic->n ;
+    Offset [0] = KLU_blob_array (sizeof (klu_blob_header), 1,
+        sizeof (KLU_symbolic), &next, ok) ;
+    Offset [1] = KLU_blob_array (next, n,   sizeof (Int),    &next, ok) ;
+    Offset [2] = KLU_blob_array (next, n,   sizeof (Int),    &next, ok) ;
+    Offset [3] = KLU_blob_array (next, n+1, sizeof (Int),    &next, ok) ;
+    Offset [4] = KLU_blob_array (next, n,   sizeof (double), &next, ok) ;
+    (*ok) = (*ok) && (next <= (size_t) INT64_MAX) ;
+    return (next) ;
+}
+
+/* ========================================================================== */
+/* === symbolic_header ====================================================== */
+/* ========================================================================== */
+
+static void symbolic_header
+(
+    klu_blob_header *Header,
+    size_t blobsize
+)
+{
+    memset (Header, 0, sizeof (klu_blob_header)) ;
+    Header->blobsize = (int64_t) blobsize ;
+    Header->kind = KLU_SYMBOLIC_BLOB ;
+    Header->version [0] = KLU_MAIN_VERSION ;
+    Header->version [1] = KLU_SUB_VERSION ;
+    Header->version [2] = KLU_SUBSUB_VERSION ;
+    Header->object_size = sizeof (KLU_symbolic) ;
+    Header->int_size = sizeof (Int) ;
+    Header->entry_size = sizeof (double) ;
+    Header->pointer_size = sizeof (void *) ;
+}
+
+/* ========================================================================== */
+/* === KLU_serialize_symbolic_size ========================================== */
+/* ========================================================================== */
+
+int KLU_serialize_symbolic_size     /* returns TRUE if OK, FALSE otherwise */
+(
+    KLU_symbolic *Symbolic,
+    int64_t *blobsize,          /* output: size of the blob, in bytes */
+    KLU_common *Common
+)
+{
+    size_t Offset [5], size ;
+    Int ok = TRUE ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+    if (Symbolic == NULL || blobsize == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    size = symbolic_blob (Symbolic, Offset, &ok) ;
+    if (!ok)
+    {
+        /* the blob would be too large */
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    (*blobsize) = (int64_t) size ;
+    return (TRUE) ;
+}
+
+/* ========================================================================== */
+/* === KLU_serialize_symbolic =============================================== */
+/* ========================================================================== */
+
+int KLU_serialize_symbolic          /* returns TRUE if OK, FALSE otherwise */
+(
+    KLU_symbolic *Symbolic,
+    int8_t *blob,               /* output: blob of size blobsize */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    KLU_common *Common
+)
+{
+    klu_blob_header Header ;
+    KLU_symbolic S ;
+    size_t Offset [5], size, n ;
+    Int ok = TRUE ;
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+    if (Symbolic == NULL || blob == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    size = symbolic_blob (Symbolic, Offset, &ok) ;
+    if (!ok)
+    {
+        Common->status = KLU_TOO_LARGE ;
+        return (FALSE) ;
+    }
+    if (blobsize < 0 || (size_t) blobsize < size)
+    {
+        /* the blob is too small */
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+
+    /* the padding between the arrays is zero */
+    memset (blob, 0, size) ;
+
+    /* the header, and the Symbolic struct without its pointers */
+    symbolic_header (&Header, size) ;
+    memcpy (blob, &Header, sizeof (klu_blob_header)) ;
+    S = *Symbolic ;
+    S.P = NULL ;
+    S.Q = NULL ;
+    S.R = NULL ;
+    S.Lnz = NULL ;
+    S.blob = NULL ;
+    memcpy (blob + Offset [0], &S, sizeof (KLU_symbolic)) ;
+
+    /* the arrays */
+    n = Symbolic->n ;
+    memcpy (blob + Offset [1], Symbolic->P,   n     * sizeof (Int)) ;
+    memcpy (blob + Offset [2], Symbolic->Q,   n     * sizeof (Int)) ;
+    memcpy (blob + Offset [3], Symbolic->R,   (n+1) * sizeof (Int)) ;
+    memcpy (blob + Offset [4], Symbolic->Lnz, n     * sizeof (double)) ;
+    return (TRUE) ;
+}
+
+/* ========================================================================== */
+/* === KLU_deserialize_symbolic ============================================= */
+/* ========================================================================== */
+
+KLU_symbolic *KLU_deserialize_symbolic  /* returns NULL if error */
+(
+    int8_t *blob,               /* blob from KLU_serialize_symbolic */
+    int64_t blobsize,           /* size of the blob, in bytes */
+    int wrap,                   /* if true, point into the blob instead of
+                                 * copying it */
+    KLU_common *Common
+)
+{
+    klu_blob_header Header, Expected ;
+    KLU_symbolic *Symbolic, S ;
+    size_t Offset [5], size, n ;
+    Int ok = TRUE ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (NULL) ;
+    }
+    Common->status = KLU_OK ;
+    if (blob == NULL || blobsize < (int64_t) sizeof (klu_blob_header)
+        || (wrap && ((size_t) blob) % KLU_BLOB_START != 0))
+    {
+        /* blob missing, too small, or not aligned */
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* the blob must be a Symbolic object from this version of KLU */
+    memcpy (&Header, blob, sizeof (klu_blob_header)) ;
+    symbolic_header (&Expected, Header.blobsize) ;
+    if (memcmp (&Header, &Expected, sizeof (klu_blob_header)) != 0
+        || Header.blobsize > blobsize)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* get the Symbolic struct, and make sure the arrays fit in the blob */
+    Offset [0] = KLU_blob_array (sizeof (klu_blob_header), 1,
+        sizeof (KLU_symbolic), &size, &ok) ;
+    if (size > (size_t) Header.blobsize)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+    memcpy (&S, blob + Offset [0], sizeof (KLU_symbolic)) ;
+    if (S.n < 0 || S.nblocks < 0 || S.nblocks > S.n)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+    size = symbolic_blob (&S, Offset, &ok) ;
+    if (!ok || size != (size_t) Header.blobsize)
+    {
+        Common->status = KLU_INVALID ;
+        return (NULL) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* create the Symbolic object */
+    /* ---------------------------------------------------------------------- */
+
+    Symbolic = KLU_malloc (1, sizeof (KLU_symbolic), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory */
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    n = S.n ;
+    *Symbolic = S ;
+    Symbolic->P   = KLU_blob_read (blob, Offset [1], n,   sizeof (Int),
+        wrap, Common) ;
+    Symbolic->Q   = KLU_blob_read (blob, Offset [2], n,   sizeof (Int),
+        wrap, Common) ;
+    Symbolic->R   = KLU_blob_read (blob, Offset [3], n+1, sizeof (Int),
+        wrap, Common) ;
+    Symbolic->Lnz = KLU_blob_read (blob, Offset [4], n,   sizeof (double),
+        wrap, Common) ;
+    Symbolic->blob = wrap ? blob : NULL ;
+    if (Common->status < KLU_OK)
+    {
+        /* out of memory */
+        KLU_free_symbolic (&Symbolic, Common) ;
+        Common->status = KLU_OUT_OF_MEMORY ;
+        return (NULL) ;
+    }
+    return (Symbolic) ;
+}
@@ -13,10 +13,279 @@
  * performed.  Uses Numeric->Xwork as workspace (undefined on input and output),
  * of size 4n Entry's (note that columns 2 to 4 of Xwork overlap with
  * Numeric->Iwork).
+ *
+ * If nrhs > 4, the columns of B are instead solved in chunks of 8, 16, or 32
+ * columns at a time, in workspace allocated here, so that L, U, and the
+ * off-diagonal blocks are traversed once per chunk rather than once for every
+ * 4 columns, and the innermost loops run across the columns of the chunk.
+ * If KLU is compiled with OpenMP and Common->nthreads is not 1, the chunks
+ * are solved in parallel.  The result is the same as solving 4 columns at a
+ * time.  If the workspace cannot be allocated, 4 columns are solved at a time
+ * instead.
  */
 
 #include "klu_internal.h"
 
+/* the widest chunk of columns solved at once when nrhs > 4 */
+#define KLU_SOLVE_CHUNK 32
+
+/* ========================================================================== */
+/* === solve_chunk ========================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b for nr columns of B at once, where 1 <= nr <= KLU_SOLVE_CHUNK.
+ * X is workspace of size n*nr, which holds the nr columns in row form. */
+
+static void solve_chunk
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,
+    Int nr,
+
+    /* right-hand-side on input, solution to Ax=b on output */
+    Entry Bz [ ],
+
+    /* workspace */
+    Entry X [ ]
+)
+{
+    Entry x [KLU_SOLVE_CHUNK], lik, s ;
+    double rs, *Rs ;
+    Entry *Offx, *Udiag, *Xk, *Xi, *Lx, *Ux ;
+    Int *Q, *R, *Pnum, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen, *Li, *Ui ;
+    Unit **LUbx, *LU ;
+    Int k1, k2, nk, k, block, pend, n, p, nblocks, len, i, l ;
+
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+    Pnum = Numeric->Pnum ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Offx = (Entry *) Numeric->Offx ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    Udiag = Numeric->Udiag ;
+    Rs = Numeric->Rs ;
+
+    /* ---------------------------------------------------------------------- */
+    /* scale and permute the right hand side, X = P*(R\B) */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        i = Pnum [k] ;
+        Xk = X + ((size_t) nr) * k ;
+        if (Rs == NULL)
+        {
+            for (l = 0 ; l < nr ; l++)
+            {
+                Xk [l] = Bz [i + ((size_t) d) * l] ;
+            }
+        }
+        else
+        {
+            rs = Rs [k] ;
+            for (l = 0 ; l < nr ; l++)
+            {
+                SCALE_DIV_ASSIGN (Xk [l], Bz [i + ((size_t) d) * l], rs) ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve X = (L*U + Off)\X */
+    /* ---------------------------------------------------------------------- */
+
+    for (block = nblocks-1 ; block >= 0 ; block--)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* the block of size nk is from rows/columns k1 to k2-1 */
+        /* ------------------------------------------------------------------ */
+
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+
+        /* solve the block system */
+        if (nk == 1)
+        {
+            s = Udiag [k1] ;
+            Xk = X + ((size_t) nr) * k1 ;
+            for (l = 0 ; l < nr ; l++)
+            {
+                DIV (Xk [l], Xk [l], s) ;
+            }
+        }
+        else
+        {
+            LU = LUbx [block] ;
+            Lip = Numeric->Lip + k1 ;
+            Llen = Numeric->Llen + k1 ;
+            Uip = Numeric->Uip + k1 ;
+            Ulen = Numeric->Ulen + k1 ;
+
+            /* solve Lx=b, where L has a unit diagonal that is not stored */
+            for (k = 0 ; k < nk ; k++)
+            {
+                Xk = X + ((size_t) nr) * (k1+k) ;
+                for (l = 0 ; l < nr ; l++)
+                {
+                    x [l] = Xk [l] ;
+                }
+                GET_POINTER (LU, Lip, Llen, Li, Lx, k, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Xi = X + ((size_t) nr) * (k1 + Li [p]) ;
+                    lik = Lx [p] ;
+                    for (l = 0 ; l < nr ; l++)
+                    {
+                        MULT_SUB (Xi [l], lik, x [l]) ;
+                    }
+                }
+            }
+
+            /* solve Ux=b, where the diagonal of U is in Udiag */
+            for (k = nk-1 ; k >= 0 ; k--)
+            {
+                Xk = X + ((size_t) nr) * (k1+k) ;
+                s = Udiag [k1+k] ;
+                for (l = 0 ; l < nr ; l++)
+                {
+                    DIV (x [l], Xk [l], s) ;
+                    Xk [l] = x [l] ;
+                }
+                GET_POINTER (LU, Uip, Ulen, Ui, Ux, k, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    Xi = X + ((size_t) nr) * (k1 + Ui [p]) ;
+                    lik = Ux [p] ;
+                    for (l = 0 ; l < nr ; l++)
+                    {
+                        MULT_SUB (Xi [l], lik, x [l]) ;
+                    }
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* block back-substitution for the off-diagonal-block entries */
+        /* ------------------------------------------------------------------ */
+
+        if (block > 0)
+        {
+            for (k = k1 ; k < k2 ; k++)
+            {
+                Xk = X + ((size_t) nr) * k ;
+                for (l = 0 ; l < nr ; l++)
+                {
+                    x [l] = Xk [l] ;
+                }
+                pend = Offp [k+1] ;
+                for (p = Offp [k] ; p < pend ; p++)
+                {
+                    Xi = X + ((size_t) nr) * Offi [p] ;
+                    lik = Offx [p] ;
+                    for (l = 0 ; l < nr ; l++)
+                    {
+                        MULT_SUB (Xi [l], lik, x [l]) ;
+                    }
+                }
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* permute the result, Bz = Q*X */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = 0 ; k < n ; k++)
+    {
+        i = Q [k] ;
+        Xk = X + ((size_t) nr) * k ;
+        for (l = 0 ; l < nr ; l++)
+        {
+            Bz [i + ((size_t) d) * l] = Xk [l] ;
+        }
+    }
+}
+
+/* ========================================================================== */
+/* === solve_wide =========================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b for nrhs > 4 right-hand sides, in chunks of 8, 16, or 32
+ * columns.  The chunks are narrowed if that gives more of them to spread
+ * across the threads.  Returns FALSE, with Common->status unchanged, if the
+ * workspace cannot be allocated. */
+
+static Int solve_wide
+(
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int d,
+    Int nrhs,
+    Entry Bz [ ],
+    KLU_common *Common
+)
+{
+    Entry *W ;
+    size_t wsize ;
+    Int n, nb, nchunks, nthreads, chunk, status, ok = TRUE ;
+
+    n = Symbolic->n ;
+
+    /* ---------------------------------------------------------------------- */
+    /* determine the chunk width and the number of threads */
+    /* ---------------------------------------------------------------------- */
+
+    nthreads = KLU_parallel_threads (nrhs, Common) ;
+    nb = (nrhs >= 32) ? 32 : ((nrhs >= 16) ? 16 : 8) ;
+    while (nb > 8 && (nrhs + nb - 1) / nb < nthreads)
+    {
+        nb = nb / 2 ;
+    }
+    nchunks = (nrhs + nb - 1) / nb ;
+    nthreads = MIN (nthreads, nchunks) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* allocate n*nb entries of workspace for each thread */
+    /* ---------------------------------------------------------------------- */
+
+    wsize = KLU_mult_size_t (n, nb, &ok) ;
+    (void) KLU_mult_size_t (wsize, nthreads, &ok) ;
+    if (!ok)
+    {
+        return (FALSE) ;
+    }
+    status = Common->status ;
+    W = KLU_malloc (wsize * nthreads, sizeof (Entry), Common) ;
+    if (Common->status < KLU_OK)
+    {
+        Common->status = status ;
+        return (FALSE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve each chunk */
+    /* ---------------------------------------------------------------------- */
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1)
+    for (chunk = 0 ; chunk < nchunks ; chunk++)
+    {
+        Int me = SUITESPARSE_OPENMP_GET_THREAD_ID ;
+        Int first = chunk * nb ;
+        solve_chunk (Symbolic, Numeric, d, MIN (nrhs - first, nb),
+            Bz + ((size_t) first) * d, W + me * wsize) ;
+    }
+
+    KLU_free (W, wsize * nthreads, sizeof (Entry), Common) ;
+    return (TRUE) ;
+}
+
 int KLU_solve
 (
     /* inputs, not modified */
@@ -26,7 +295,7 @@ int KLU_solve
     Int nrhs,               /* number of right-hand-sides */
 
     /* right-hand-side on input, overwritten with solution to Ax=b on output */
-    double B [ ],           /* size n*nrhs, in column-oriented form, with
+    Scalar B [ ],           /* size n*nrhs, in column-oriented form, with
                              * leading dimension d. */
     /* --------------- */
     KLU_common *Common
@@ -87,6 +356,15 @@ int KLU_solve
 
     ASSERT (KLU_valid (n, Offp, Offi, Offx)) ;
 
+    /* ---------------------------------------------------------------------- */
+    /* solve in wider chunks if there are more than 4 columns */
+    /* ---------------------------------------------------------------------- */
+
+    if (nrhs > 4 && solve_wide (Symbolic, Numeric, d, nrhs, Bz, Common))
+    {
+        return (TRUE) ;
+    }
+
     /* ---------------------------------------------------------------------- */
     /* solve in chunks of 4 columns at a time */
     /* ---------------------------------------------------------------------- */
@@ -0,0 +1,484 @@
+//------------------------------------------------------------------------------
+// KLU/Source/klu_solve_sparse: solve x=A\b for a sparse right-hand side
+//------------------------------------------------------------------------------
+
+// KLU, Copyright (c) 2004-2022, University of Florida.  All Rights Reserved.
+// Authors: Timothy A. Davis and Ekanathan Palamadai.
+// SPDX-License-Identifier: LGPL-2.1+
+
+//------------------------------------------------------------------------------
+
+/* Solve Ax=b where b is sparse, using the symbolic and numeric objects from
+ * KLU_analyze (or KLU_analyze_given) and KLU_factor, and return x as a sparse
+ * vector, or just the entries of x listed in Out.  No iterative refinement is
+ * performed.
+ *
+ * The blocks of the BTF form are solved from last to first, as in KLU_solve,
+ * but a block is skipped entirely unless b or an earlier solved block has a
+ * nonzero in it.  Within a block, the columns of L and then U that are needed
+ * are found by a depth-first search from the nonzeros in the block (their
+ * reach), and only those columns are used, in topological order.  The
+ * off-diagonal entries are then applied only from the columns in that reach.
+ * If Out is present, the blocks before the first block holding an entry in
+ * Out are not needed, and are not solved.
+ *
+ * The workspace is provided by the caller, and the parts of it that must be
+ * zero on input are cleared again on return, so that no O(n) work is done
+ * per call.  The inverse of Q, needed only if Out is present, is kept in the
+ * workspace: it takes O(n) time on the first such call, and none after that.
+ * All other work is proportional to the number of entries of L, U, and the
+ * off-diagonal blocks in the columns that are reached.
+ *
+ * There is no transposed version: the reach in the graph of U' and L' would
+ * need the rows of U and L, which are not held in the Numeric object.
+ */
+
+#include "klu_internal.h"
+
+/* ========================================================================== */
+/* === find_block =========================================================== */
+/* ========================================================================== */
+
+/* Returns the block that holds row/column k, by binary search in R */
+
+static Int find_block
+(
+    Int k,
+    Int R [ ],
+    Int nblocks
+)
+{
+    Int lo = 0, hi = nblocks - 1, mid ;
+    while (lo < hi)
+    {
+        mid = (lo + hi + 1) / 2 ;
+        if (R [mid] <= k)
+        {
+            lo = mid ;
+        }
+        else
+        {
+            hi = mid - 1 ;
+        }
+    }
+    return (lo) ;
+}
+
+/* ========================================================================== */
+/* === reach ================================================================ */
+/* ========================================================================== */
+
+/* Depth-first search in the graph of L or U of one block, whose columns are
+ * given by Xip, Xlen and LU, starting at the nodes Start [0..nstart-1] (local
+ * to the block).  There is an edge from j to i if L(i,j) or U(i,j) is
+ * nonzero.  The nodes reached are placed in List [0..nlist-1] in postorder,
+ * so List [nlist-1] down to List [0] is a topological order.  Node i has been
+ * visited if Visit [k1+i] is stamp.  Returns nlist. */
+
+static Int reach
+(
+    Int k1,             /* the block starts at row/column k1 */
+    Int Xip [ ],
+    Int Xlen [ ],
+    Unit LU [ ],
+    Int nstart,
+    Int Start [ ],
+    Int stamp,
+
+    /* workspace and output */
+    Int Visit [ ],      /* size n */
+    Int Stack [ ],      /* size nk */
+    Int Pstack [ ],     /* size nk */
+    Int List [ ]        /* size nk */
+)
+{
+    Int *Xi ;
+    Int s, head, j, i, p, len, nlist, done ;
+
+    nlist = 0 ;
+    for (s = 0 ; s < nstart ; s++)
+    {
+        j = Start [s] ;
+        if (Visit [k1+j] == stamp)
+        {
+            continue ;
+        }
+        Visit [k1+j] = stamp ;
+        head = 0 ;
+        Stack [0] = j ;
+        Pstack [0] = 0 ;
+        while (head >= 0)
+        {
+            j = Stack [head] ;
+            GET_I_POINTER (LU, Xip, Xi, j) ;
+            len = Xlen [j] ;
+            done = TRUE ;
+            for (p = Pstack [head] ; p < len ; p++)
+            {
+                i = Xi [p] ;
+                if (Visit [k1+i] != stamp)
+                {
+                    /* descend to node i */
+                    Visit [k1+i] = stamp ;
+                    Pstack [head] = p + 1 ;
+                    head++ ;
+                    Stack [head] = i ;
+                    Pstack [head] = 0 ;
+                    done = FALSE ;
+                    break ;
+                }
+            }
+            if (done)
+            {
+                /* all of the nodes reachable from j have been visited */
+                head-- ;
+                List [nlist++] = j ;
+            }
+        }
+    }
+    return (nlist) ;
+}
+
+/* ========================================================================== */
+/* === KLU_solve_sparse ===================================================== */
+/* ========================================================================== */
+
+/* Node k (a row/column of the permuted matrix) becomes nonzero in X when b
+ * or an off-diagonal entry is applied to it.  It is then placed in the linked
+ * list Head [block], Next of the nonzeros of its block that are known before
+ * the block is solved, which holds k+1 so that an empty list is zero.
+ * Visit [k] is zero for a node that is still zero, 1 once it is marked, and
+ * the stamp of the last search that reached it after that. */
+
+#define MARK(k)                                                     \
+{                                                                   \
+    Int b = find_block (k, R, nblocks) ;                            \
+    Visit [k] = 1 ;                                                 \
+    Next [k] = Head [b] ;                                           \
+    Head [b] = k+1 ;                                                \
+}
+
+int KLU_solve_sparse
+(
+    /* inputs, not modified */
+    KLU_symbolic *Symbolic,
+    KLU_numeric *Numeric,
+    Int bnz,                /* number of entries in b */
+    Int Bi [ ],             /* size bnz, row indices of b */
+    double Bx [ ],          /* size bnz, values of b */
+    Int nout,               /* number of entries of x requested */
+    Int Out [ ],            /* size nout, entries of x requested, or NULL */
+
+    /* outputs */
+    Int *xnz,               /* number of entries in x */
+    Int Xi [ ],             /* size n, or nout if Out present: indices of x */
+    double Xx [ ],          /* size n, or nout if Out present: values of x */
+
+    /* workspace, zero on input, and cleared again on output (see klu.h) */
+    Int Wi [ ],             /* size 4*n + nblocks + 4*maxblock */
+    double W [ ],           /* size n */
+    /* --------------- */
+    KLU_common *Common
+)
+{
+    Entry xk ;
+    Entry *X, *Bz, *Xz, *Udiag, *Offx, *Lx, *Ux ;
+    double *Rs ;
+    Int *Q, *R, *Pinv, *Offp, *Offi, *Lip, *Uip, *Llen, *Ulen, *Li, *Ui,
+        *Visit, *Next, *Head, *Nz, *Stack, *Pstack, *List1, *List2, *Qinv ;
+    Unit **LUbx ;
+    Int n, nblocks, maxblock, block, bmin, k1, k2, nk, k, i, j, p, t, nz,
+        nlist1, nlist2, stamp, len, kstart, first ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (Common == NULL)
+    {
+        return (FALSE) ;
+    }
+    if (Numeric == NULL || Symbolic == NULL || bnz < 0 || nout < 0 ||
+        (bnz > 0 && (Bi == NULL || Bx == NULL)) ||
+        (Out != NULL && nout > 0 && (Xx == NULL)) ||
+        (Out == NULL && (Xi == NULL || Xx == NULL)) || xnz == NULL ||
+        Wi == NULL || W == NULL)
+    {
+        Common->status = KLU_INVALID ;
+        return (FALSE) ;
+    }
+    Common->status = KLU_OK ;
+
+    n = Symbolic->n ;
+    nblocks = Symbolic->nblocks ;
+    maxblock = Symbolic->maxblock ;
+    Q = Symbolic->Q ;
+    R = Symbolic->R ;
+
+    for (t = 0 ; t < bnz ; t++)
+    {
+        if (Bi [t] < 0 || Bi [t] >= n)
+        {
+            Common->status = KLU_INVALID ;
+            return (FALSE) ;
+        }
+    }
+    for (t = 0 ; Out != NULL && t < nout ; t++)
+    {
+        if (Out [t] < 0 || Out [t] >= n)
+        {
+            Common->status = KLU_INVALID ;
+            return (FALSE) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get the contents of the Numeric object */
+    /* ---------------------------------------------------------------------- */
+
+    ASSERT (nblocks == Numeric->nblocks) ;
+    Pinv = Numeric->Pinv ;
+    Offp = Numeric->Offp ;
+    Offi = Numeric->Offi ;
+    Offx = (Entry *) Numeric->Offx ;
+    LUbx = (Unit **) Numeric->LUbx ;
+    Udiag = Numeric->Udiag ;
+    Rs = Numeric->Rs ;
+    Bz = (Entry *) Bx ;
+    Xz = (Entry *) Xx ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the workspace */
+    /* ---------------------------------------------------------------------- */
+
+    /* Visit, Qinv and Head must be zero on input (or Qinv must be from an
+     * earlier call with the same Symbolic object), and are returned that way.
+     * Next, Nz, Stack, Pstack, List1 and List2 are not defined on input. */
+    X      = (Entry *) W ;
+    Visit  = Wi ;
+    Qinv   = Visit + n ;
+    Head   = Qinv + n ;
+    Next   = Head + nblocks ;
+    Nz     = Next + n ;
+    Stack  = Nz + n ;
+    Pstack = Stack + maxblock ;
+    List1  = Pstack + maxblock ;
+    List2  = List1 + maxblock ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the first block that is needed */
+    /* ---------------------------------------------------------------------- */
+
+    bmin = 0 ;
+    if (Out != NULL)
+    {
+        if (n > 0 && Qinv [Q [0]] != 1)
+        {
+            /* Qinv [Q [k]] = k+1, kept in Wi for the next call */
+            for (k = 0 ; k < n ; k++)
+            {
+                Qinv [Q [k]] = k+1 ;
+            }
+        }
+        bmin = nblocks ;
+        for (t = 0 ; t < nout ; t++)
+        {
+            bmin = MIN (bmin, find_block (Qinv [Out [t]] - 1, R, nblocks)) ;
+        }
+    }
+    kstart = (bmin < nblocks) ? R [bmin] : n ;
+
+    /* ---------------------------------------------------------------------- */
+    /* scale and permute the right hand side, X = P*(R\b) */
+    /* ---------------------------------------------------------------------- */
+
+    for (t = 0 ; t < bnz ; t++)
+    {
+        i = Bi [t] ;
+        k = Pinv [i] ;
+        if (k < kstart)
+        {
+            /* x does not depend on this entry of b */
+            continue ;
+        }
+        if (Visit [k] == 0)
+        {
+            MARK (k) ;
+        }
+        if (Rs == NULL)
+        {
+            /* X [k] += Bz [t] */
+            ASSEMBLE (X [k], Bz [t]) ;
+        }
+        else
+        {
+            /* X [k] += Bz [t] / Rs [k] */
+            SCALE_DIV_ASSIGN (xk, Bz [t], Rs [k]) ;
+            ASSEMBLE (X [k], xk) ;
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* solve X = (L*U + Off)\X, for the blocks that are needed */
+    /* ---------------------------------------------------------------------- */
+
+    stamp = 1 ;
+    nz = 0 ;
+    for (block = nblocks-1 ; block >= bmin ; block--)
+    {
+        if (Head [block] == 0)
+        {
+            /* X is zero in this block */
+            continue ;
+        }
+        first = Head [block] - 1 ;
+        Head [block] = 0 ;
+
+        k1 = R [block] ;
+        k2 = R [block+1] ;
+        nk = k2 - k1 ;
+
+        if (nk == 1)
+        {
+
+            /* -------------------------------------------------------------- */
+            /* singleton */
+            /* -------------------------------------------------------------- */
+
+            DIV (X [k1], X [k1], Udiag [k1]) ;
+            List2 [0] = 0 ;
+            nlist2 = 1 ;
+
+        }
+        else
+        {
+
+            Lip  = Numeric->Lip  + k1 ;
+            Llen = Numeric->Llen + k1 ;
+            Uip  = Numeric->Uip  + k1 ;
+            Ulen = Numeric->Ulen + k1 ;
+
+            /* -------------------------------------------------------------- */
+            /* the nonzeros of the block that are already known */
+            /* -------------------------------------------------------------- */
+
+            nlist2 = 0 ;
+            for (k = first ; k != EMPTY ; k = Next [k] - 1)
+            {
+                List2 [nlist2++] = k - k1 ;
+            }
+
+            /* -------------------------------------------------------------- */
+            /* solve with L, in the reach of X in the graph of L */
+            /* -------------------------------------------------------------- */
+
+            nlist1 = reach (k1, Lip, Llen, LUbx [block], nlist2,
+                List2, ++stamp, Visit, Stack, Pstack, List1) ;
+            for (t = nlist1-1 ; t >= 0 ; t--)
+            {
+                j = List1 [t] ;
+                xk = X [k1+j] ;
+                GET_POINTER (LUbx [block], Lip, Llen, Li, Lx, j, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    /* X [k1+Li [p]] -= Lx [p] * xk */
+                    MULT_SUB (X [k1 + Li [p]], Lx [p], xk) ;
+                }
+            }
+
+            /* -------------------------------------------------------------- */
+            /* solve with U, in the reach of X in the graph of U */
+            /* -------------------------------------------------------------- */
+
+            nlist2 = reach (k1, Uip, Ulen, LUbx [block], nlist1,
+                List1, ++stamp, Visit, Stack, Pstack, List2) ;
+            for (t = nlist2-1 ; t >= 0 ; t--)
+            {
+                j = List2 [t] ;
+                /* X [k1+j] /= Udiag [k1+j] */
+                DIV (X [k1+j], X [k1+j], Udiag [k1+j]) ;
+                xk = X [k1+j] ;
+                GET_POINTER (LUbx [block], Uip, Ulen, Ui, Ux, j, len) ;
+                for (p = 0 ; p < len ; p++)
+                {
+                    /* X [k1+Ui [p]] -= Ux [p] * xk */
+                    MULT_SUB (X [k1 + Ui [p]], Ux [p], xk) ;
+                }
+            }
+        }
+
+        /* ------------------------------------------------------------------ */
+        /* block back-substitution for the off-diagonal-block entries */
+        /* ------------------------------------------------------------------ */
+
+        for (t = 0 ; t < nlist2 ; t++)
+        {
+            k = k1 + List2 [t] ;
+            Nz [nz++] = k ;
+            xk = X [k] ;
+            for (p = Offp [k] ; p < Offp [k+1] ; p++)
+            {
+                i = Offi [p] ;
+                if (i < kstart)
+                {
+                    /* x does not depend on this row */
+                    continue ;
+                }
+                if (Visit [i] == 0)
+                {
+                    MARK (i) ;
+                }
+                /* X [i] -= Offx [p] * xk */
+                MULT_SUB (X [i], Offx [p], xk) ;
+            }
+        }
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* gather the solution, x (Q) = X */
+    /* ---------------------------------------------------------------------- */
+
+    if (Out != NULL)
+    {
+        for (t = 0 ; t < nout ; t++)
+        {
+            k = Qinv [Out [t]] - 1 ;
+            if (Xi != NULL)
+            {
+                Xi [t] = Out [t] ;
+            }
+            if (Visit [k] == 0)
+            {
+                CLEAR (Xz [t]) ;
+            }
+            else
+            {
+                Xz [t] = X [k] ;
+            }
+        }
+        *xnz = nout ;
+    }
+    else
+    {
+        for (t = 0 ; t < nz ; t++)
+        {
+            k = Nz [t] ;
+            Xi [t] = Q [k] ;
+            Xz [t] = X [k] ;
+        }
+        *xnz = nz ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* clear the workspace, in the nonzero pattern of X */
+    /* ---------------------------------------------------------------------- */
+
+    for (t = 0 ; t < nz ; t++)
+    {
+        k = Nz [t] ;
+        /* X [k] = 0 */
+        CLEAR (X [k]) ;
+        Visit [k] = 0 ;
+    }
+    return (TRUE) ;
+}
@@ -40,6 +40,21 @@
 #define klu_z_free_numeric klu_zl_free_numeric
 #define klu_z_factor klu_zl_factor
 #define klu_z_refactor klu_zl_refactor
+#define klu_z_refactor_partial klu_zl_refactor_partial
+#define klu_z_serialize_numeric_size klu_zl_serialize_numeric_size
+#define klu_z_serialize_numeric klu_zl_serialize_numeric
+#define klu_z_deserialize_numeric klu_zl_deserialize_numeric
+#define klu_z_solve_sparse klu_zl_solve_sparse
+#define klu_z_refactor_solve_batch klu_zl_refactor_solve_batch
+#define klu_alloc_cache klu_l_alloc_cache
+#define klu_free_cache klu_l_free_cache
+
+#define klu_s_factor klu_sl_factor
+#define klu_s_refine klu_sl_refine
+#define klu_s_free_numeric klu_sl_free_numeric
+#define klu_c_factor klu_cl_factor
+#define klu_c_refine klu_cl_refine
+#define klu_c_free_numeric klu_cl_free_numeric
 #define klu_z_lsolve klu_zl_lsolve
 #define klu_z_ltsolve klu_zl_ltsolve
 #define klu_z_usolve klu_zl_usolve
@@ -57,6 +72,15 @@
 #define klu_free_numeric klu_l_free_numeric
 #define klu_factor klu_l_factor
 #define klu_refactor klu_l_refactor
+#define klu_refactor_partial klu_l_refactor_partial
+#define klu_serialize_numeric_size klu_l_serialize_numeric_size
+#define klu_serialize_numeric klu_l_serialize_numeric
+#define klu_deserialize_numeric klu_l_deserialize_numeric
+#define klu_serialize_symbolic_size klu_l_serialize_symbolic_size
+#define klu_serialize_symbolic klu_l_serialize_symbolic
+#define klu_deserialize_symbolic klu_l_deserialize_symbolic
+#define klu_solve_sparse klu_l_solve_sparse
+#define klu_refactor_solve_batch klu_l_refactor_solve_batch
 #define klu_lsolve klu_l_lsolve
 #define klu_ltsolve klu_l_ltsolve
 #define klu_usolve klu_l_usolve
@@ -147,25 +171,35 @@ void *my_realloc (void *p, size_t size) ;
 void my_free (void *p) ;
 
 Int my_tries = -1 ;
+Int my_once = FALSE ;   /* if TRUE, only one allocation fails */
 
-void *my_malloc (size_t size)
+static Int my_fail ( void )
 {
-    if (my_tries == 0) return (NULL) ;      /* pretend to fail */
+    if (my_tries == 0)
+    {
+        /* pretend to fail */
+        if (my_once) my_tries = -1 ;
+        return (TRUE) ;
+    }
     if (my_tries > 0) my_tries-- ;
+    return (FALSE) ;
+}
+
+void *my_malloc (size_t size)
+{
+    if (my_fail ( )) return (NULL) ;
     return (malloc (size)) ;
 }
 
 void *my_calloc (size_t n, size_t size)
 {
-    if (my_tries == 0) return (NULL) ;      /* pretend to fail */
-    if (my_tries > 0) my_tries-- ;
+    if (my_fail ( )) return (NULL) ;
     return (calloc (n, size)) ;
 }
 
 void *my_realloc (void *p, size_t size)
 {
-    if (my_tries == 0) return (NULL) ;      /* pretend to fail */
-    if (my_tries > 0) my_tries-- ;
+    if (my_fail ( )) return (NULL) ;
     return (realloc (p, size)) ;
 }
 
@@ -838,101 +872,1750 @@ static double do_solves (cholmod_sparse *A, cholmod_dense *B, cholmod_dense *X,
 
 
 /* ========================================================================== */
-/* === main ================================================================= */
+/* === same_lu ============================================================== */
 /* ========================================================================== */
 
-int main (void)
+/* Return TRUE if two factorizations of the same matrix have identical L and U.
+ * Only the entries are compared, since the LU arrays of each block can hold
+ * padding and unused space at the end.  Singletons are held in Udiag.  The
+ * LU arrays of a complex factorization are in units of two doubles. */
+
+static Int same_lu (KLU_numeric *A, KLU_numeric *B, Int *R, Int xsize)
 {
-    KLU_common Common ;
-    cholmod_sparse *A, *A2 ;
-    cholmod_dense *X, *B ;
-    cholmod_common ch ;
-    Int *Ap, *Ai, *Puser, *Quser, *Gunk ;
-    double *Ax, *Xx, *A2x ;
-    double one [2], zero [2], xsave, maxerr ;
-    Int n, i, j, nz, save, isreal, k, isnan ;
-    KLU_symbolic *Symbolic, *Symbolic2 ;
-    KLU_numeric *Numeric ;
+    char *LUa, *LUb ;
+    Int *Xip, *Xlen, *Yip, *Ylen ;
+    Int b, k, k1, k2, len, lu ;
+    size_t unit, ilen, xlen ;
 
-    one [0] = 1 ;
-    one [1] = 0 ;
-    zero [0] = 0 ;
-    zero [1] = 0 ;
+    unit = xsize * sizeof (double) ;
+    for (b = 0 ; b < A->nblocks ; b++)
+    {
+        k1 = R [b] ;
+        k2 = R [b+1] ;
+        if (k2 - k1 == 1) continue ;
+        for (k = k1 ; k < k2 ; k++)
+        {
+            for (lu = 0 ; lu <= 1 ; lu++)
+            {
+                Xip = lu ? A->Uip : A->Lip ;
+                Xlen = lu ? A->Ulen : A->Llen ;
+                Yip = lu ? B->Uip : B->Lip ;
+                Ylen = lu ? B->Ulen : B->Llen ;
+                len = Xlen [k] ;
+                if (Xip [k] != Yip [k] || len != Ylen [k])
+                {
+                    return (FALSE) ;
+                }
+                /* row indices, then values, of column k of L or U */
+                LUa = (char *) (A->LUbx [b]) + Xip [k] * unit ;
+                LUb = (char *) (B->LUbx [b]) + Xip [k] * unit ;
+                ilen = len * sizeof (Int) ;
+                xlen = len * unit ;
+                if (memcmp (LUa, LUb, ilen) != 0 ||
+                    memcmp (LUa + ((ilen + unit - 1) / unit) * unit,
+                            LUb + ((ilen + unit - 1) / unit) * unit, xlen) != 0)
+                {
+                    return (FALSE) ;
+                }
+            }
+        }
+    }
+    return (TRUE) ;
+}
 
-    printf ("klu test: -------------------------------------------------\n") ;
-    OK (klu_defaults (&Common)) ;
-    CHOLMOD_start (&ch) ;
-    ch.print = 0 ;
-    normal_memory_handler ( ) ;
 
-    /* ---------------------------------------------------------------------- */
-    /* read in a sparse matrix from stdin */
-    /* ---------------------------------------------------------------------- */
+/* ========================================================================== */
+/* === same_symbolic ======================================================== */
+/* ========================================================================== */
 
-    A = CHOLMOD_read_sparse (stdin, &ch) ;
+/* Return TRUE if two Symbolic objects are identical */
 
-    // error: only square unsymmetric matrices handled
-    FAIL (A->nrow != A->ncol || A->stype != 0) ;
-    // error: only real or complex matrices handled
-    FAIL (!(A->xtype == CHOLMOD_REAL || A->xtype == CHOLMOD_COMPLEX)) ;
+static Int same_symbolic (KLU_symbolic *A, KLU_symbolic *B)
+{
+    Int n = A->n ;
+    return (A->n == B->n && A->nz == B->nz && A->nblocks == B->nblocks &&
+        A->maxblock == B->maxblock && A->nzoff == B->nzoff &&
+        A->ordering == B->ordering && A->do_btf == B->do_btf &&
+        A->structural_rank == B->structural_rank &&
+        memcmp (&(A->symmetry), &(B->symmetry), sizeof (double)) == 0 &&
+        memcmp (&(A->est_flops), &(B->est_flops), sizeof (double)) == 0 &&
+        memcmp (&(A->lnz), &(B->lnz), sizeof (double)) == 0 &&
+        memcmp (&(A->unz), &(B->unz), sizeof (double)) == 0 &&
+        memcmp (A->P, B->P, n * sizeof (Int)) == 0 &&
+        memcmp (A->Q, B->Q, n * sizeof (Int)) == 0 &&
+        memcmp (A->R, B->R, (A->nblocks+1) * sizeof (Int)) == 0 &&
+        memcmp (A->Lnz, B->Lnz, A->nblocks * sizeof (double)) == 0) ;
+}
 
-    n = A->nrow ;
-    Ap = A->p ;
-    Ai = A->i ;
-    Ax = A->x ;
-    nz = Ap [n] ;
-    isreal = (A->xtype == CHOLMOD_REAL) ;
 
-    /* ---------------------------------------------------------------------- */
-    /* construct random permutations */
-    /* ---------------------------------------------------------------------- */
+/* ========================================================================== */
+/* === do_parallel_analyze ================================================== */
+/* ========================================================================== */
 
-    Puser = randperm (n, n) ;
-    Quser = randperm (n, n) ;
+/* Analyze A with AMD and with COLAMD, with 1 thread, 2 threads, and the
+ * default number of threads.  The Symbolic objects must be identical. */
 
-    /* ---------------------------------------------------------------------- */
-    /* select known solution to Ax=b */
-    /* ---------------------------------------------------------------------- */
+static void do_parallel_analyze
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    KLU_common *Common
+)
+{
+    KLU_symbolic *Symbolic [3] ;
+    Int ordering, save, trial ;
 
-    X = CHOLMOD_allocate_dense (n, NRHS, n, A->xtype, &ch) ;
-    Xx = X->x ;
-    for (j = 0 ; j < NRHS ; j++)
+    save = Common->nthreads ;
+    ordering = Common->ordering ;
+    for (Common->ordering = 0 ; Common->ordering <= 1 ; Common->ordering++)
     {
-        for (i = 0 ; i < n ; i++)
+        for (trial = 0 ; trial <= 2 ; trial++)
         {
-            if (isreal)
+            /* trial 0: 1 thread, 1: 2 threads, 2: default */
+            Common->nthreads = (trial == 0) ? 1 : ((trial == 1) ? 2 : 0) ;
+            Symbolic [trial] = klu_analyze (n, Ap, Ai, Common) ;
+            OK (Symbolic [trial]) ;
+        }
+        printf ("parallel analyze: ordering %d nblocks "ID"\n",
+            Common->ordering, Symbolic [0]->nblocks) ;
+        for (trial = 0 ; trial <= 2 ; trial++)
+        {
+            OK (same_symbolic (Symbolic [trial], Symbolic [0])) ;
+        }
+        for (trial = 0 ; trial <= 2 ; trial++)
+        {
+            klu_free_symbolic (&Symbolic [trial], Common) ;
+        }
+    }
+    Common->ordering = ordering ;
+    Common->nthreads = save ;
+}
+
+
+/* ========================================================================== */
+/* === do_cache ============================================================= */
+/* ========================================================================== */
+
+/* A user ordering that leaves the matrix as is, and counts how often it is
+ * called, so that a hit in the cache of Symbolic objects can be told from a
+ * miss. */
+
+static Int count_order (Int n, Int Ap [ ], Int Ai [ ], Int Perm [ ],
+    KLU_common *Common)
+{
+    Int k ;
+    for (k = 0 ; k < Ap [n] ; k++)
+    {
+        OK (Ai [k] >= 0 && Ai [k] < n) ;
+    }
+    for (k = 0 ; k < n ; k++)
+    {
+        Perm [k] = k ;
+    }
+    (*((Int *) Common->user_data))++ ;
+    return (Ap [n] + n) ;
+}
+
+/* Analyze the tridiagonal matrix of order n with the cache in Common, and
+ * check that the result is correct, and that the user ordering is called
+ * only if the matrix is not in the cache (hit = FALSE).  With BTF disabled,
+ * the ordering is called once per analysis. */
+
+static void cache_analyze (Int n, Int hit, Int Ap [ ], Int Ai [ ],
+    KLU_common *C)
+{
+    KLU_symbolic *Symbolic, *S2 ;
+    void *cache ;
+    Int calls, j, p ;
+
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Ap [j] = p ;
+        if (j > 0) Ai [p++] = j-1 ;
+        Ai [p++] = j ;
+        if (j < n-1) Ai [p++] = j+1 ;
+    }
+    Ap [n] = p ;
+
+    calls = *((Int *) C->user_data) ;
+    Symbolic = klu_analyze (n, Ap, Ai, C) ;
+    OK (Symbolic) ;
+    OK (*((Int *) C->user_data) == calls + (hit ? 0 : 1)) ;
+
+    /* compare with the result without the cache */
+    cache = C->cache ;
+    C->cache = NULL ;
+    S2 = klu_analyze (n, Ap, Ai, C) ;
+    C->cache = cache ;
+    *((Int *) C->user_data) = calls + (hit ? 0 : 1) ;
+    OK (S2 && same_symbolic (Symbolic, S2)) ;
+    klu_free_symbolic (&Symbolic, C) ;
+    klu_free_symbolic (&S2, C) ;
+}
+
+/* Test the cache of Symbolic objects: hits, misses, the replacement of the
+ * oldest entry when the cache is full, the parameters that must match, and
+ * the memory it uses, which must be freed by klu_free_cache. */
+
+static void do_cache (void)
+{
+    KLU_common C ;
+    KLU_symbolic *Symbolic, *S2 ;
+    Int Ap [13], Ai [3*12] ;
+    Int calls ;
+
+    OK (klu_defaults (&C)) ;
+    C.btf = FALSE ;
+    C.ordering = 3 ;
+    C.user_order = count_order ;
+    calls = 0 ;
+    C.user_data = &calls ;
+    FAIL (klu_alloc_cache (0, &C)) ;
+    OK (C.status == KLU_INVALID) ;
+
+    /* a cache with room for 2 patterns */
+    OK (klu_alloc_cache (2, &C)) ;
+    cache_analyze (10, FALSE, Ap, Ai, &C) ;     /* miss: 10 */
+    cache_analyze (10, TRUE,  Ap, Ai, &C) ;     /* hit */
+    cache_analyze (11, FALSE, Ap, Ai, &C) ;     /* miss: 10, 11 */
+    cache_analyze (10, TRUE,  Ap, Ai, &C) ;     /* hit */
+    cache_analyze (12, FALSE, Ap, Ai, &C) ;     /* miss, 10 replaced: 12, 11 */
+    cache_analyze (11, TRUE,  Ap, Ai, &C) ;     /* hit */
+    cache_analyze (12, TRUE,  Ap, Ai, &C) ;     /* hit */
+    cache_analyze (10, FALSE, Ap, Ai, &C) ;     /* miss, 11 replaced: 12, 10 */
+    cache_analyze (11, FALSE, Ap, Ai, &C) ;     /* miss, 12 replaced: 11, 10 */
+    OK (C.memusage > 0) ;
+
+    /* a new cache, with room for 4 patterns */
+    OK (klu_alloc_cache (4, &C)) ;
+    cache_analyze (10, FALSE, Ap, Ai, &C) ;
+
+    /* the same pattern with BTF is a miss, but then a hit */
+    C.btf = TRUE ;
+    cache_analyze (10, FALSE, Ap, Ai, &C) ;
+    cache_analyze (10, TRUE,  Ap, Ai, &C) ;
+    C.btf = FALSE ;
+    cache_analyze (10, TRUE,  Ap, Ai, &C) ;
+
+    /* the same pattern with AMD must not return the user ordering */
+    C.ordering = 0 ;
+    Symbolic = klu_analyze (10, Ap, Ai, &C) ;
+    OK (Symbolic && Symbolic->ordering == 0) ;
+    S2 = klu_analyze (10, Ap, Ai, &C) ;         /* hit */
+    OK (S2 && same_symbolic (Symbolic, S2)) ;
+    klu_free_symbolic (&Symbolic, &C) ;
+    klu_free_symbolic (&S2, &C) ;
+    C.ordering = 3 ;
+    cache_analyze (10, TRUE,  Ap, Ai, &C) ;
+    OK (calls == 7) ;
+
+    /* all the memory is freed with the cache */
+    OK (C.memusage > 0) ;
+    OK (klu_free_cache (&C)) ;
+    OK (C.cache == NULL) ;
+    OK (C.memusage == 0) ;
+    OK (klu_free_cache (&C)) ;
+    FAIL (klu_free_cache (NULL)) ;
+    printf ("cache: OK\n") ;
+}
+
+
+/* ========================================================================== */
+/* === do_parallel_factor =================================================== */
+/* ========================================================================== */
+
+/* Factorize and refactorize a matrix with 6 diagonal blocks of different sizes
+ * in its BTF form, with 1 thread, 2 threads, and the default number of
+ * threads.  The LU factors, the diagonal of U, and the off-diagonal entries
+ * must be identical.  Then make the matrix singular in two blocks, so that
+ * more than one thread finds a singular column: every thread count must report
+ * the numerical rank and singular column of the first one.  klu_factor only
+ * reports a structurally singular matrix when halt_if_singular is false, and
+ * klu_refactor does not check the singletons that this leads to, so each is
+ * tested with a matrix of its own. */
+
+static void do_parallel_factor (Int isreal, KLU_common *Common)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric [3] ;
+    Int *Ap, *Ai, *R ;
+    double *Ax, *Ax2 ;
+    Int n, nz, i, j, p, k, b, xsize, trial, save, halt, singular, rank [3],
+        col [3], status [3] ;
+
+    /* blocks of size 4, 9, 14, 19, 24, and 29 */
+    n = 99 ;
+    nz = 4 * n ;
+    xsize = isreal ? 1 : 2 ;
+    Ap = malloc ((n+1) * sizeof (Int)) ;
+    Ai = malloc (nz * sizeof (Int)) ;
+    Ax = malloc (xsize * nz * sizeof (double)) ;
+    Ax2 = malloc (xsize * nz * sizeof (double)) ;
+    R = malloc (7 * sizeof (Int)) ;
+    OK (Ap && Ai && Ax && Ax2 && R) ;
+    R [0] = 0 ;
+    for (b = 0 ; b < 6 ; b++)
+    {
+        R [b+1] = R [b] + 4 + 5*b ;
+    }
+    OK (R [6] == n) ;
+
+    save = Common->nthreads ;
+    halt = Common->halt_if_singular ;
+    Common->halt_if_singular = FALSE ;
+
+    for (singular = 0 ; singular <= 2 ; singular++)
+    {
+
+        /* ------------------------------------------------------------------ */
+        /* construct the matrix */
+        /* ------------------------------------------------------------------ */
+
+        p = 0 ;
+        b = 0 ;
+        for (j = 0 ; j < n ; j++)
+        {
+            Ap [j] = p ;
+            if (j == R [b+1]) b++ ;
+            if (singular == 1 && (j == R [2] + 2 || j == R [4] + 2))
             {
-                Xx [i] = 1 + ((double) i) / ((double) n) + j * 100;
+                /* structurally singular in the 3rd and 5th blocks */
+                continue ;
             }
-            else
+            for (i = 0 ; i < n ; i++)
             {
-                Xx [2*i  ] = 1 + ((double) i) / ((double) n) + j * 100 ;
-                Xx [2*i+1] =  - ((double) i+1) / ((double) n + j) ;
-                if (j == NRHS-1)
+                /* tridiagonal blocks, each coupled to the next one */
+                if (!((i >= R [b] && i < R [b+1] && i >= j-1 && i <= j+1) ||
+                      (j == R [b] && j > 0 && i == j-1)))
                 {
-                    Xx [2*i+1] = 0 ;    /* zero imaginary part */
+                    continue ;
                 }
-                else if (j == NRHS-2)
+                Ai [p] = i ;
+                for (k = 0 ; k < xsize ; k++)
                 {
-                    Xx [2*i] = 0 ;      /* zero real part */
+                    /* small diagonal entries, so that some rows are pivoted */
+                    Ax [xsize*p+k] = (i == j) ? (0.1 * (1 + j % 3) + k) :
+                        (1 + (i + 2*j + k) % 5) ;
+                    Ax2 [xsize*p+k] = Ax [xsize*p+k] * (1 + 0.25 * (j % 4)) ;
+                    if (singular == 2 && (j == R [2] + 2 || j == R [4] + 2))
+                    {
+                        /* numerically singular in the 3rd and 5th blocks */
+                        Ax2 [xsize*p+k] = 0 ;
+                    }
                 }
+                p++ ;
             }
         }
-        Xx += isreal ? n : 2*n ;
+        Ap [n] = p ;
+
+        Common->nthreads = 1 ;
+        Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+        OK (Symbolic) ;
+        OK (singular == 1 || Symbolic->nblocks == 6) ;
+
+        /* ------------------------------------------------------------------ */
+        /* factorize and refactorize with 1, 2, and the default # of threads */
+        /* ------------------------------------------------------------------ */
+
+        for (trial = 0 ; trial <= 2 ; trial++)
+        {
+            Common->nthreads = (trial == 0) ? 1 : ((trial == 1) ? 2 : 0) ;
+            Numeric [trial] = isreal ?
+                klu_factor (Ap, Ai, Ax, Symbolic, Common) :
+                klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+            OK (Numeric [trial]) ;
+            status [trial] = Common->status ;
+            rank [trial] = Common->numerical_rank ;
+            col [trial] = Common->singular_col ;
+        }
+        printf ("parallel factor: isreal "ID" nblocks "ID" rank "ID" col "ID
+            "\n", isreal, Symbolic->nblocks, rank [0], col [0]) ;
+        OK (status [0] == ((singular == 1) ? KLU_SINGULAR : KLU_OK)) ;
+        OK ((singular == 1) ? (rank [0] < n) : (rank [0] == n && col [0] == n));
+
+        for (k = 0 ; k <= 1 ; k++)
+        {
+            /* k = 0: after klu_factor, k = 1: after klu_refactor */
+            if (k == 1)
+            {
+                for (trial = 0 ; trial <= 2 ; trial++)
+                {
+                    Common->nthreads = (trial == 0) ? 1 : ((trial == 1) ? 2 :0);
+                    OK (isreal ?
+                        klu_refactor (Ap, Ai, Ax2, Symbolic, Numeric [trial],
+                            Common) :
+                        klu_z_refactor (Ap, Ai, Ax2, Symbolic,
+                            Numeric [trial], Common)) ;
+                    status [trial] = Common->status ;
+                    rank [trial] = Common->numerical_rank ;
+                    col [trial] = Common->singular_col ;
+                }
+                printf ("parallel refactor: isreal "ID" rank "ID" col "ID"\n",
+                    isreal, rank [0], col [0]) ;
+                OK (singular != 2 ||
+                    (status [0] == KLU_SINGULAR && rank [0] < n)) ;
+            }
+            for (trial = 1 ; trial <= 2 ; trial++)
+            {
+                OK (status [trial] == status [0]) ;
+                OK (rank [trial] == rank [0]) ;
+                OK (col [trial] == col [0]) ;
+                OK (same_lu (Numeric [trial], Numeric [0], Symbolic->R, xsize)) ;
+                OK (memcmp (Numeric [trial]->Pnum, Numeric [0]->Pnum,
+                    n * sizeof (Int)) == 0) ;
+                OK (memcmp (Numeric [trial]->Udiag, Numeric [0]->Udiag,
+                    xsize * n * sizeof (double)) == 0) ;
+                OK (memcmp (Numeric [trial]->Offi, Numeric [0]->Offi,
+                    Symbolic->nzoff * sizeof (Int)) == 0) ;
+                OK (memcmp (Numeric [trial]->Offx, Numeric [0]->Offx,
+                    xsize * Symbolic->nzoff * sizeof (double)) == 0) ;
+            }
+        }
+
+        for (trial = 0 ; trial <= 2 ; trial++)
+        {
+            if (isreal)
+            {
+                klu_free_numeric (&Numeric [trial], Common) ;
+            }
+            else
+            {
+                klu_z_free_numeric (&Numeric [trial], Common) ;
+            }
+        }
+        klu_free_symbolic (&Symbolic, Common) ;
     }
 
-    /* B = A*X */
-    B = CHOLMOD_allocate_dense (n, NRHS, n, A->xtype, &ch) ;
-    CHOLMOD_sdmult (A, 0, one, zero, X, B, &ch) ;
-    /* Bx = B->x ; */
+    Common->nthreads = save ;
+    Common->halt_if_singular = halt ;
+    Common->status = KLU_OK ;
+    free (Ap) ;
+    free (Ai) ;
+    free (Ax) ;
+    free (Ax2) ;
+    free (R) ;
+}
 
-    /* ---------------------------------------------------------------------- */
-    /* test KLU */
-    /* ---------------------------------------------------------------------- */
 
-    test_memory_handler ( ) ;
-    maxerr = do_solves (A, B, X, Puser, Quser, &Common, &ch, &isnan) ;
-    printf ("dosolves err %g\n\n", maxerr) ;
+/* ========================================================================== */
+/* === do_dense_refactor ==================================================== */
+/* ========================================================================== */
+
+/* Refactorize a matrix whose LU factors have a dense lower right submatrix,
+ * which klu_refactor factorizes with its dense kernel, and compare the factors
+ * and the solution with those from klu_factor, which uses only the sparse
+ * kernel.  The matrix is tridiagonal, plus a dense trailing submatrix of order
+ * 40, and is diagonally dominant so that both use the same pivots. */
+
+static double do_dense_refactor (Int isreal, KLU_common *Common)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric, *Numeric2 ;
+    Int *Ap, *Ai ;
+    double *Ax, *Ax2, *X, *X2, *U, *U2 ;
+    double err, xnorm ;
+    Int n, nd, i, j, p, k, xsize ;
+
+    n = 60 ;
+    nd = 40 ;
+    xsize = isreal ? 1 : 2 ;
+    Ap = malloc ((n+1) * sizeof (Int)) ;
+    Ai = malloc (n * n * sizeof (Int)) ;
+    Ax = malloc (xsize * n * n * sizeof (double)) ;
+    Ax2 = malloc (xsize * n * n * sizeof (double)) ;
+    X = malloc (xsize * n * sizeof (double)) ;
+    X2 = malloc (xsize * n * sizeof (double)) ;
+    OK (Ap && Ai && Ax && Ax2 && X && X2) ;
+
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Ap [j] = p ;
+        for (i = 0 ; i < n ; i++)
+        {
+            if ((i < j-1 || i > j+1) && (i < n-nd || j < n-nd)) continue ;
+            Ai [p] = i ;
+            for (k = 0 ; k < xsize ; k++)
+            {
+                Ax [xsize*p+k] = (i == j) ? (2*n + j) : (1. / (1 + i + j + k)) ;
+                Ax2 [xsize*p+k] = (i == j) ? Ax [xsize*p+k] :
+                    (-2 * Ax [xsize*p+k]) ;
+            }
+            p++ ;
+        }
+    }
+    Ap [n] = p ;
+
+    /* factorize A, and refactorize with the values Ax2 */
+    Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+    OK (Symbolic && Symbolic->nblocks == 1) ;
+    if (isreal)
+    {
+        Numeric = klu_factor (Ap, Ai, Ax, Symbolic, Common) ;
+        OK (Numeric) ;
+        OK (klu_refactor (Ap, Ai, Ax2, Symbolic, Numeric, Common)) ;
+        Numeric2 = klu_factor (Ap, Ai, Ax2, Symbolic, Common) ;
+    }
+    else
+    {
+        Numeric = klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+        OK (Numeric) ;
+        OK (klu_z_refactor (Ap, Ai, Ax2, Symbolic, Numeric, Common)) ;
+        Numeric2 = klu_z_factor (Ap, Ai, Ax2, Symbolic, Common) ;
+    }
+    OK (Numeric2) ;
+
+    /* the dense kernel was used for at least the trailing submatrix */
+    printf ("dense refactor: isreal "ID" Dstart "ID"\n", isreal,
+        Numeric->Dstart [0]) ;
+    OK (n - Numeric->Dstart [0] >= KLU_DENSE_MIN) ;
+
+    /* the pivots are the same, and so are the factors, up to rounding */
+    err = 0 ;
+    for (k = 0 ; k < n ; k++)
+    {
+        OK (Numeric->Pnum [k] == Numeric2->Pnum [k]) ;
+    }
+    U = (double *) Numeric->Udiag ;
+    U2 = (double *) Numeric2->Udiag ;
+    for (k = 0 ; k < xsize * n ; k++)
+    {
+        err = MAX (err, fabs (U [k] - U2 [k]) / fabs (U2 [k - k % xsize])) ;
+    }
+
+    /* the solutions are the same, up to rounding */
+    for (k = 0 ; k < xsize * n ; k++)
+    {
+        X [k] = X2 [k] = 1 + k % 7 ;
+    }
+    if (isreal)
+    {
+        OK (klu_solve (Symbolic, Numeric, n, 1, X, Common)) ;
+        OK (klu_solve (Symbolic, Numeric2, n, 1, X2, Common)) ;
+    }
+    else
+    {
+        OK (klu_z_solve (Symbolic, Numeric, n, 1, X, Common)) ;
+        OK (klu_z_solve (Symbolic, Numeric2, n, 1, X2, Common)) ;
+    }
+    xnorm = 0 ;
+    for (k = 0 ; k < xsize * n ; k++)
+    {
+        xnorm = MAX (xnorm, fabs (X2 [k])) ;
+    }
+    for (k = 0 ; k < xsize * n ; k++)
+    {
+        err = MAX (err, fabs (X [k] - X2 [k]) / xnorm) ;
+    }
+    printf ("dense refactor err %g\n", err) ;
+    OK (err < 1e-12) ;
+
+    if (isreal)
+    {
+        klu_free_numeric (&Numeric, Common) ;
+        klu_free_numeric (&Numeric2, Common) ;
+    }
+    else
+    {
+        klu_z_free_numeric (&Numeric, Common) ;
+        klu_z_free_numeric (&Numeric2, Common) ;
+    }
+    klu_free_symbolic (&Symbolic, Common) ;
+    free (Ap) ;
+    free (Ai) ;
+    free (Ax) ;
+    free (Ax2) ;
+    free (X) ;
+    free (X2) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_refactor_partial ================================================== */
+/* ========================================================================== */
+
+/* Refactorize a matrix with 3 diagonal blocks in its BTF form, of which only
+ * the middle one has changed, with klu_refactor_partial, and compare the
+ * factors and the solution with those from klu_refactor.  The matrix is
+ * tridiagonal within each block, and each block is coupled to the next one by
+ * an entry above the diagonal. */
+
+static double do_refactor_partial (Int isreal, KLU_common *Common)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric, *Numeric2 ;
+    Int *Ap, *Ai, Changed [2] ;
+    double *Ax, *Ax2, *X, *X2, *U, *U2 ;
+    double err, xnorm ;
+    Int n, nb, i, j, p, k, xsize, nz, save ;
+
+    nb = 10 ;
+    n = 3 * nb ;
+    xsize = isreal ? 1 : 2 ;
+    nz = 4 * n ;
+    Ap = malloc ((n+1) * sizeof (Int)) ;
+    Ai = malloc (nz * sizeof (Int)) ;
+    Ax = malloc (xsize * nz * sizeof (double)) ;
+    Ax2 = malloc (xsize * nz * sizeof (double)) ;
+    X = malloc (xsize * n * sizeof (double)) ;
+    X2 = malloc (xsize * n * sizeof (double)) ;
+    OK (Ap && Ai && Ax && Ax2 && X && X2) ;
+
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Ap [j] = p ;
+        for (i = 0 ; i < n ; i++)
+        {
+            if (!((i / nb == j / nb && i >= j-1 && i <= j+1) ||
+                  (j % nb == 0 && j > 0 && i == j-1)))
+            {
+                continue ;
+            }
+            Ai [p] = i ;
+            for (k = 0 ; k < xsize ; k++)
+            {
+                Ax [xsize*p+k] = (i == j) ? (4 + k) : (-1. / (1 + i + k)) ;
+                Ax2 [xsize*p+k] = Ax [xsize*p+k] ;
+            }
+            p++ ;
+        }
+    }
+    Ap [n] = p ;
+
+    /* change two columns of the middle block */
+    Changed [0] = nb + 2 ;
+    Changed [1] = nb + 7 ;
+    for (k = 0 ; k < 2 ; k++)
+    {
+        j = Changed [k] ;
+        for (p = Ap [j] ; p < Ap [j+1] ; p++)
+        {
+            for (i = 0 ; i < xsize ; i++)
+            {
+                Ax2 [xsize*p+i] *= (Ai [p] == j) ? 3 : -2 ;
+            }
+        }
+    }
+
+    save = Common->scale ;
+    err = 0 ;
+    for (Common->scale = 0 ; Common->scale <= 2 ; Common->scale++)
+    {
+
+        /* factorize A, then refactorize with the values Ax2 both ways */
+        Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+        OK (Symbolic && Symbolic->nblocks == 3) ;
+        if (isreal)
+        {
+            Numeric = klu_factor (Ap, Ai, Ax, Symbolic, Common) ;
+            Numeric2 = klu_factor (Ap, Ai, Ax, Symbolic, Common) ;
+            OK (Numeric && Numeric2) ;
+            OK (klu_refactor_partial (Ap, Ai, Ax2, Symbolic, 2, Changed,
+                Numeric, Common)) ;
+            OK (klu_refactor (Ap, Ai, Ax2, Symbolic, Numeric2, Common)) ;
+        }
+        else
+        {
+            Numeric = klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+            Numeric2 = klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+            OK (Numeric && Numeric2) ;
+            OK (klu_z_refactor_partial (Ap, Ai, Ax2, Symbolic, 2, Changed,
+                Numeric, Common)) ;
+            OK (klu_z_refactor (Ap, Ai, Ax2, Symbolic, Numeric2, Common)) ;
+        }
+
+        /* the diagonal of U is the same, up to rounding */
+        U = (double *) Numeric->Udiag ;
+        U2 = (double *) Numeric2->Udiag ;
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            err = MAX (err, fabs (U [k] - U2 [k]) / fabs (U2 [k - k % xsize])) ;
+        }
+
+        /* the solutions are the same, up to rounding */
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            X [k] = X2 [k] = 1 + k % 5 ;
+        }
+        if (isreal)
+        {
+            OK (klu_solve (Symbolic, Numeric, n, 1, X, Common)) ;
+            OK (klu_solve (Symbolic, Numeric2, n, 1, X2, Common)) ;
+        }
+        else
+        {
+            OK (klu_z_solve (Symbolic, Numeric, n, 1, X, Common)) ;
+            OK (klu_z_solve (Symbolic, Numeric2, n, 1, X2, Common)) ;
+        }
+        xnorm = 0 ;
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            xnorm = MAX (xnorm, fabs (X2 [k])) ;
+        }
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            err = MAX (err, fabs (X [k] - X2 [k]) / xnorm) ;
+        }
+
+        if (isreal)
+        {
+            klu_free_numeric (&Numeric, Common) ;
+            klu_free_numeric (&Numeric2, Common) ;
+        }
+        else
+        {
+            klu_z_free_numeric (&Numeric, Common) ;
+            klu_z_free_numeric (&Numeric2, Common) ;
+        }
+        klu_free_symbolic (&Symbolic, Common) ;
+    }
+    Common->scale = save ;
+    printf ("refactor partial err %g\n", err) ;
+    OK (err < 1e-12) ;
+
+    free (Ap) ;
+    free (Ai) ;
+    free (Ax) ;
+    free (Ax2) ;
+    free (X) ;
+    free (X2) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_serialize ========================================================= */
+/* ========================================================================== */
+
+/* Serialize the Symbolic and Numeric objects of the input matrix, read them
+ * back both by copying and by wrapping the blobs, and check that the solution
+ * with the deserialized objects is identical to the one with the originals.
+ * Running out of memory while reading back the Numeric object is handled
+ * cleanly.  A blob that is too small, corrupted, or (if wrapped) not aligned
+ * is rejected. */
+
+static void do_serialize
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],
+    Int isreal,
+    KLU_common *Common
+)
+{
+    KLU_symbolic *Symbolic, *Symbolic2 ;
+    KLU_numeric *Numeric, *Numeric2 ;
+    int8_t *sblob, *nblob ;
+    int64_t ssize, nsize ;
+    double *B, *X ;
+    Int k, xsize, wrap, tries ;
+
+    Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+    OK (Symbolic) ;
+    Numeric = isreal ? klu_factor (Ap, Ai, Ax, Symbolic, Common) :
+        klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+    if (Numeric == NULL)
+    {
+        /* the matrix is singular and Common->halt_if_singular is true */
+        klu_free_symbolic (&Symbolic, Common) ;
+        return ;
+    }
+
+    /* serialize the Symbolic and Numeric objects */
+    OK (klu_serialize_symbolic_size (Symbolic, &ssize, Common)) ;
+    OK (isreal ? klu_serialize_numeric_size (Numeric, &nsize, Common) :
+        klu_z_serialize_numeric_size (Numeric, &nsize, Common)) ;
+    sblob = malloc (ssize) ;
+    nblob = malloc (nsize) ;
+    OK (sblob && nblob) ;
+    FAIL (klu_serialize_symbolic (Symbolic, sblob, ssize-1, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    OK (klu_serialize_symbolic (Symbolic, sblob, ssize, Common)) ;
+    FAIL (isreal ? klu_serialize_numeric (Numeric, nblob, nsize-1, Common) :
+        klu_z_serialize_numeric (Numeric, nblob, nsize-1, Common)) ;
+    OK (isreal ? klu_serialize_numeric (Numeric, nblob, nsize, Common) :
+        klu_z_serialize_numeric (Numeric, nblob, nsize, Common)) ;
+
+    /* solve with the original objects */
+    xsize = isreal ? 1 : 2 ;
+    B = malloc (xsize * n * sizeof (double)) ;
+    X = malloc (xsize * n * sizeof (double)) ;
+    OK (B && X) ;
+    for (k = 0 ; k < xsize * n ; k++)
+    {
+        B [k] = 1 + k % 3 ;
+    }
+    OK (isreal ? klu_solve (Symbolic, Numeric, n, 1, B, Common) :
+        klu_z_solve (Symbolic, Numeric, n, 1, B, Common)) ;
+
+    for (wrap = 0 ; wrap <= 1 ; wrap++)
+    {
+        /* read back the objects, and solve with them */
+        Symbolic2 = klu_deserialize_symbolic (sblob, ssize, wrap, Common) ;
+        OK (Symbolic2) ;
+        Numeric2 = isreal ?
+            klu_deserialize_numeric (nblob, nsize, wrap, Common) :
+            klu_z_deserialize_numeric (nblob, nsize, wrap, Common) ;
+        OK (Numeric2) ;
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            X [k] = 1 + k % 3 ;
+        }
+        OK (isreal ? klu_solve (Symbolic2, Numeric2, n, 1, X, Common) :
+            klu_z_solve (Symbolic2, Numeric2, n, 1, X, Common)) ;
+        OK (memcmp (B, X, xsize * n * sizeof (double)) == 0) ;
+        if (isreal)
+        {
+            klu_free_numeric (&Numeric2, Common) ;
+        }
+        else
+        {
+            klu_z_free_numeric (&Numeric2, Common) ;
+        }
+        klu_free_symbolic (&Symbolic2, Common) ;
+    }
+
+    /* out of memory while reading back the Numeric object.  Only the tries-th
+     * allocation fails, so that the ones after it succeed. */
+    my_once = TRUE ;
+    for (wrap = 0 ; wrap <= 1 ; wrap++)
+    {
+        for (tries = 0 ; my_tries == -1 ; tries++)
+        {
+            my_tries = tries ;
+            Numeric2 = isreal ?
+                klu_deserialize_numeric (nblob, nsize, wrap, Common) :
+                klu_z_deserialize_numeric (nblob, nsize, wrap, Common) ;
+            if (my_tries == -1)
+            {
+                /* an allocation failed */
+                FAIL (Numeric2) ;
+                OK (Common->status == KLU_OUT_OF_MEMORY) ;
+            }
+            else
+            {
+                OK (Numeric2) ;
+                if (isreal)
+                {
+                    klu_free_numeric (&Numeric2, Common) ;
+                }
+                else
+                {
+                    klu_z_free_numeric (&Numeric2, Common) ;
+                }
+            }
+        }
+        my_tries = -1 ;
+    }
+    my_once = FALSE ;
+
+    /* a blob that is too small or corrupted is rejected */
+    FAIL (klu_deserialize_symbolic (sblob, ssize-1, FALSE, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (klu_deserialize_symbolic (nblob, nsize, FALSE, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (isreal ? klu_deserialize_numeric (nblob, nsize-1, FALSE, Common) :
+        klu_z_deserialize_numeric (nblob, nsize-1, FALSE, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (isreal ? klu_z_deserialize_numeric (nblob, nsize, FALSE, Common) :
+        klu_deserialize_numeric (nblob, nsize, FALSE, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+
+    /* a wrapped blob must start on an 8-byte boundary */
+    FAIL (klu_deserialize_symbolic (sblob + 1, ssize-1, TRUE, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    FAIL (isreal ? klu_deserialize_numeric (nblob + 4, nsize-4, TRUE, Common) :
+        klu_z_deserialize_numeric (nblob + 4, nsize-4, TRUE, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+
+    if (isreal)
+    {
+        klu_free_numeric (&Numeric, Common) ;
+    }
+    else
+    {
+        klu_z_free_numeric (&Numeric, Common) ;
+    }
+    klu_free_symbolic (&Symbolic, Common) ;
+    free (sblob) ;
+    free (nblob) ;
+    free (B) ;
+    free (X) ;
+}
+
+
+/* ========================================================================== */
+/* === do_solve_sparse ====================================================== */
+/* ========================================================================== */
+
+/* Solve Ax=b for a sparse b with klu_solve_sparse, both for all of x and for
+ * a few entries of x, and compare with klu_solve of the same b held in dense
+ * form.  Entries of x not returned by klu_solve_sparse must be zero.  Each
+ * solve is done twice with the same workspace, which must be clean again
+ * after each call.  Returns the largest difference, relative to the largest
+ * entry of x. */
+
+static double do_solve_sparse
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],
+    Int isreal,
+    KLU_common *Common
+)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric ;
+    double *X, *Xx, *Yx, *Bx, *W, err, xnorm ;
+    Int *Xi, *Mark, *Wi, Bi [3], Out [3], xnz, k, i, d, xsize, nout, trial,
+        nblocks ;
+
+    Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+    OK (Symbolic) ;
+    Numeric = isreal ? klu_factor (Ap, Ai, Ax, Symbolic, Common) :
+        klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+    if (Numeric == NULL || Common->status != KLU_OK)
+    {
+        /* skip singular matrices */
+        if (isreal)
+        {
+            klu_free_numeric (&Numeric, Common) ;
+        }
+        else
+        {
+            klu_z_free_numeric (&Numeric, Common) ;
+        }
+        klu_free_symbolic (&Symbolic, Common) ;
+        return (0) ;
+    }
+
+    xsize = isreal ? 1 : 2 ;
+    X = calloc (xsize * n, sizeof (double)) ;
+    Xx = malloc (xsize * n * sizeof (double)) ;
+    Yx = malloc (xsize * n * sizeof (double)) ;
+    Bx = malloc (xsize * 3 * sizeof (double)) ;
+    Xi = malloc (n * sizeof (Int)) ;
+    Mark = calloc (n, sizeof (Int)) ;
+    nblocks = Symbolic->nblocks ;
+    Wi = calloc (4*n + nblocks + 4*Symbolic->maxblock, sizeof (Int)) ;
+    W = calloc (xsize * n, sizeof (double)) ;
+    OK (X && Xx && Yx && Bx && Xi && Mark && Wi && W) ;
+
+    /* b has entries in rows 0 and n-1, with a duplicate in row 0 */
+    Bi [0] = 0 ;
+    Bi [1] = n-1 ;
+    Bi [2] = 0 ;
+    for (k = 0 ; k < xsize * 3 ; k++)
+    {
+        Bx [k] = 1 + k ;
+    }
+    for (k = 0 ; k < 3 ; k++)
+    {
+        for (d = 0 ; d < xsize ; d++)
+        {
+            X [xsize*Bi [k] + d] += Bx [xsize*k + d] ;
+        }
+    }
+    OK (isreal ? klu_solve (Symbolic, Numeric, n, 1, X, Common) :
+        klu_z_solve (Symbolic, Numeric, n, 1, X, Common)) ;
+    xnorm = 0 ;
+    for (k = 0 ; k < xsize * n ; k++)
+    {
+        xnorm = MAX (xnorm, fabs (X [k])) ;
+    }
+    if (xnorm == 0)
+    {
+        xnorm = 1 ;
+    }
+
+    err = 0 ;
+    nout = (n > 1) ? 3 : 1 ;
+    Out [0] = n-1 ;
+    Out [1] = 0 ;
+    Out [2] = n/2 ;
+    for (trial = 0 ; trial < 4 ; trial++)
+    {
+        if (trial % 2 == 0)
+        {
+
+            /* all of x */
+            OK (isreal ?
+                klu_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, 0, NULL, &xnz,
+                    Xi, Xx, Wi, W, Common) :
+                klu_z_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, 0, NULL,
+                    &xnz, Xi, Xx, Wi, W, Common)) ;
+            OK (xnz >= 0 && xnz <= n) ;
+            for (i = 0 ; i < n ; i++)
+            {
+                Mark [i] = FALSE ;
+            }
+            for (k = 0 ; k < xnz ; k++)
+            {
+                i = Xi [k] ;
+                OK (i >= 0 && i < n && !Mark [i]) ;
+                Mark [i] = TRUE ;
+                for (d = 0 ; d < xsize ; d++)
+                {
+                    err = MAX (err, fabs (Xx [xsize*k+d] - X [xsize*i+d])
+                        / xnorm) ;
+                }
+            }
+            for (i = 0 ; i < n ; i++)
+            {
+                for (d = 0 ; d < xsize && !Mark [i] ; d++)
+                {
+                    OK (X [xsize*i+d] == 0) ;
+                }
+            }
+
+        }
+        else
+        {
+
+            /* a few entries of x */
+            OK (isreal ?
+                klu_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, nout, Out,
+                    &xnz, Xi, Yx, Wi, W, Common) :
+                klu_z_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, nout, Out,
+                    &xnz, Xi, Yx, Wi, W, Common)) ;
+            OK (xnz == nout) ;
+            for (k = 0 ; k < nout ; k++)
+            {
+                OK (Xi [k] == Out [k]) ;
+                for (d = 0 ; d < xsize ; d++)
+                {
+                    err = MAX (err, fabs (Yx [xsize*k+d] - X [xsize*Out [k]+d])
+                        / xnorm) ;
+                }
+            }
+        }
+
+        /* the workspace must be clean again, except for the inverse of Q */
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            OK (W [k] == 0) ;
+        }
+        for (k = 0 ; k < n ; k++)
+        {
+            OK (Wi [k] == 0) ;
+            OK (Wi [n + Symbolic->Q [k]] == ((trial == 0) ? 0 : 1 + k)) ;
+        }
+        for (k = 0 ; k < nblocks ; k++)
+        {
+            OK (Wi [2*n+k] == 0) ;
+        }
+    }
+
+    /* invalid row index in b, and missing workspace */
+    Bi [1] = n ;
+    FAIL (isreal ?
+        klu_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, 0, NULL, &xnz, Xi, Xx,
+            Wi, W, Common) :
+        klu_z_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, 0, NULL, &xnz, Xi,
+            Xx, Wi, W, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    Bi [1] = n-1 ;
+    FAIL (isreal ?
+        klu_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, 0, NULL, &xnz, Xi, Xx,
+            NULL, W, Common) :
+        klu_z_solve_sparse (Symbolic, Numeric, 3, Bi, Bx, 0, NULL, &xnz, Xi,
+            Xx, Wi, NULL, Common)) ;
+    OK (Common->status == KLU_INVALID) ;
+    Common->status = KLU_OK ;
+
+    printf ("solve sparse err %g\n", err) ;
+    OK (err < 1e-10) ;
+
+    if (isreal)
+    {
+        klu_free_numeric (&Numeric, Common) ;
+    }
+    else
+    {
+        klu_z_free_numeric (&Numeric, Common) ;
+    }
+    klu_free_symbolic (&Symbolic, Common) ;
+    free (X) ;
+    free (Xx) ;
+    free (Yx) ;
+    free (Bx) ;
+    free (Xi) ;
+    free (Mark) ;
+    free (Wi) ;
+    free (W) ;
+    return (err) ;
+}
+
+
+/* ========================================================================== */
+/* === do_wide_solve ======================================================== */
+/* ========================================================================== */
+
+/* Solve with many right-hand sides at once, which klu_solve does in chunks of
+ * up to 32 columns, with one thread, with several threads, and with the
+ * 4-column code it falls back to when out of memory.  All must be identical
+ * to solving one column at a time. */
+
+static void do_wide_solve
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],
+    Int isreal,
+    KLU_common *Common
+)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric ;
+    double *B, *X ;
+    Int k, j, xsize, ldim, nrhs, save, trial ;
+
+    Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+    OK (Symbolic) ;
+    Numeric = isreal ? klu_factor (Ap, Ai, Ax, Symbolic, Common) :
+        klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+    if (Numeric == NULL)
+    {
+        /* the matrix is singular and Common->halt_if_singular is true */
+        klu_free_symbolic (&Symbolic, Common) ;
+        return ;
+    }
+
+    xsize = isreal ? 1 : 2 ;
+    nrhs = 37 ;
+    ldim = n + 1 ;
+    B = malloc (xsize * ldim * nrhs * sizeof (double)) ;
+    X = malloc (xsize * ldim * nrhs * sizeof (double)) ;
+    OK (B && X) ;
+    for (k = 0 ; k < xsize * ldim * nrhs ; k++)
+    {
+        B [k] = 1 + (k % 11) ;
+    }
+
+    /* solve one column at a time */
+    for (j = 0 ; j < nrhs ; j++)
+    {
+        OK (isreal ?
+            klu_solve (Symbolic, Numeric, ldim, 1, B + j*ldim, Common) :
+            klu_z_solve (Symbolic, Numeric, ldim, 1, B + 2*j*ldim, Common)) ;
+    }
+
+    /* solve all the columns at once */
+    save = Common->nthreads ;
+    for (trial = 0 ; trial <= 3 ; trial++)
+    {
+        /* trial 0: 1 thread, 1: 2 threads, 2: default, 3: out of memory */
+        Common->nthreads = (trial == 0) ? 1 : ((trial == 1) ? 2 : 0) ;
+        for (k = 0 ; k < xsize * ldim * nrhs ; k++)
+        {
+            X [k] = 1 + (k % 11) ;
+        }
+        my_tries = (trial == 3) ? 0 : -1 ;
+        OK (isreal ? klu_solve (Symbolic, Numeric, ldim, nrhs, X, Common) :
+            klu_z_solve (Symbolic, Numeric, ldim, nrhs, X, Common)) ;
+        my_tries = -1 ;
+        for (j = 0 ; j < nrhs ; j++)
+        {
+            OK (memcmp (B + xsize*j*ldim, X + xsize*j*ldim,
+                xsize * n * sizeof (double)) == 0) ;
+        }
+    }
+    Common->nthreads = save ;
+
+    if (isreal)
+    {
+        klu_free_numeric (&Numeric, Common) ;
+    }
+    else
+    {
+        klu_z_free_numeric (&Numeric, Common) ;
+    }
+    klu_free_symbolic (&Symbolic, Common) ;
+    free (B) ;
+    free (X) ;
+}
+
+
+/* ========================================================================== */
+/* === do_refactor_solve_batch ============================================== */
+/* ========================================================================== */
+
+/* Refactorize and solve a batch of 7 matrices with the pattern of A, with and
+ * without scaling, and with one and two threads.  klu_refactor_solve_batch
+ * does the matrices 4 at a time, so the last group is padded.  The solutions
+ * must match klu_refactor and klu_solve for each matrix up to rounding, and
+ * the right-hand side after the last one must not be touched. */
+
+static double do_refactor_solve_batch
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],
+    Int isreal,
+    KLU_common *Common
+)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric ;
+    double *Abatch, *B, *X, *Ak ;
+    double err, maxerr, xnorm, rtol ;
+    Int *Singular ;
+    Int k, p, i, nz, xsize, nbatch, save, scale, trial, ok ;
+
+    Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+    OK (Symbolic) ;
+    nz = Ap [n] ;
+    xsize = isreal ? 1 : 2 ;
+    nbatch = 7 ;
+    Abatch = malloc (xsize * nz * nbatch * sizeof (double)) ;
+    B = malloc (xsize * n * (nbatch+1) * sizeof (double)) ;
+    X = malloc (xsize * n * sizeof (double)) ;
+    Singular = malloc (nbatch * sizeof (Int)) ;
+    OK (Abatch && B && X && Singular) ;
+
+    /* the kth matrix is A with each entry scaled by 1, 1.01, ... 1.04 */
+    for (k = 0 ; k < nbatch ; k++)
+    {
+        for (p = 0 ; p < xsize * nz ; p++)
+        {
+            Abatch [k*xsize*nz + p] = Ax [p] * (1 + 0.01 * ((k + p/xsize) % 5));
+        }
+    }
+
+    save = Common->nthreads ;
+    scale = Common->scale ;
+    rtol = Common->repivot_tol ;
+    Common->repivot_tol = 0 ;
+    maxerr = 0 ;
+    for (trial = 0 ; trial <= 3 ; trial++)
+    {
+        /* trial 0: unscaled, 1 thread, 1: unscaled, 2 threads,
+         * trial 2: scaled, 1 thread, 3: scaled, 2 threads */
+        Common->scale = (trial < 2) ? 0 : 2 ;
+        Common->nthreads = (trial % 2 == 0) ? 1 : 2 ;
+        Numeric = isreal ? klu_factor (Ap, Ai, Ax, Symbolic, Common) :
+            klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+        if (Numeric == NULL)
+        {
+            /* the matrix is singular and Common->halt_if_singular is true */
+            break ;
+        }
+
+        for (k = 0 ; k < xsize * n * (nbatch+1) ; k++)
+        {
+            B [k] = 1 + (k % 7) ;
+        }
+        ok = isreal ?
+            klu_refactor_solve_batch (Ap, Ai, Abatch, nbatch, Symbolic,
+                Numeric, B, Singular, Common) :
+            klu_z_refactor_solve_batch (Ap, Ai, Abatch, nbatch, Symbolic,
+                Numeric, B, Singular, Common) ;
+        OK (ok) ;
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            /* the padding of the last group is not returned */
+            OK (B [xsize*n*nbatch + k] == 1 + ((xsize*n*nbatch + k) % 7)) ;
+        }
+
+        for (k = 0 ; k < nbatch ; k++)
+        {
+            Ak = Abatch + k*xsize*nz ;
+            OK (isreal ?
+                klu_refactor (Ap, Ai, Ak, Symbolic, Numeric, Common) :
+                klu_z_refactor (Ap, Ai, Ak, Symbolic, Numeric, Common)) ;
+            if (Common->status != KLU_OK || Singular [k] != EMPTY)
+            {
+                continue ;
+            }
+            for (i = 0 ; i < xsize * n ; i++)
+            {
+                X [i] = 1 + ((xsize*n*k + i) % 7) ;
+            }
+            OK (isreal ?
+                klu_solve (Symbolic, Numeric, n, 1, X, Common) :
+                klu_z_solve (Symbolic, Numeric, n, 1, X, Common)) ;
+            err = 0 ;
+            xnorm = 0 ;
+            for (i = 0 ; i < xsize * n ; i++)
+            {
+                err = MAX (err, fabs (X [i] - B [xsize*n*k + i])) ;
+                xnorm = MAX (xnorm, fabs (X [i])) ;
+            }
+            if (xnorm > 0) err /= xnorm ;
+            maxerr = MAX (maxerr, err) ;
+        }
+
+        if (isreal)
+        {
+            klu_free_numeric (&Numeric, Common) ;
+        }
+        else
+        {
+            klu_z_free_numeric (&Numeric, Common) ;
+        }
+    }
+    printf ("refactor solve batch: isreal "ID" err %g\n", isreal, maxerr) ;
+
+    Common->nthreads = save ;
+    Common->scale = scale ;
+    Common->repivot_tol = rtol ;
+    klu_free_symbolic (&Symbolic, Common) ;
+    free (Abatch) ;
+    free (B) ;
+    free (X) ;
+    free (Singular) ;
+    return (maxerr) ;
+}
+
+
+/* ========================================================================== */
+/* === do_refine ============================================================ */
+/* ========================================================================== */
+
+/* Solve Ax=b with single precision factors and mixed precision iterative
+ * refinement (klu_s_refine or klu_c_refine), where A is (1+i/2) times the
+ * Hilbert matrix of order 5, whose condition number is about 5e5.  The single
+ * precision solve alone is only accurate to a few digits, but refinement must
+ * reach a backward error at the level of double precision roundoff in a few
+ * steps.  With maxiter = 1, only one step is taken. */
+
+static void do_refine (Int isreal, KLU_common *Common)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric ;
+    Int Ap [6], Ai [25], n, i, j, p, k, xsize, maxiter ;
+    double Ax [50], B [10], X [10], err, berr [2] ;
+    float Sx [50] ;
+    int nrefine [2] ;
+
+    n = 5 ;
+    xsize = isreal ? 1 : 2 ;
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Ap [j] = p ;
+        for (i = 0 ; i < n ; i++)
+        {
+            Ai [p] = i ;
+            Ax [xsize*p] = 1. / (i+j+1) ;
+            if (!isreal)
+            {
+                Ax [xsize*p+1] = 0.5 / (i+j+1) ;
+            }
+            p++ ;
+        }
+    }
+    Ap [n] = p ;
+    for (k = 0 ; k < xsize * p ; k++)
+    {
+        Sx [k] = (float) Ax [k] ;
+    }
+
+    Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+    OK (Symbolic) ;
+    Numeric = isreal ? klu_s_factor (Ap, Ai, Sx, Symbolic, Common) :
+        klu_c_factor (Ap, Ai, Sx, Symbolic, Common) ;
+    OK (Numeric) ;
+
+    for (maxiter = 1 ; maxiter <= 10 ; maxiter += 9)
+    {
+        /* b = A*x, where x is all ones */
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            B [k] = 0 ;
+        }
+        for (j = 0 ; j < n ; j++)
+        {
+            for (p = Ap [j] ; p < Ap [j+1] ; p++)
+            {
+                for (k = 0 ; k < xsize ; k++)
+                {
+                    B [xsize*Ai [p]+k] += Ax [xsize*p+k] ;
+                }
+            }
+        }
+        memcpy (X, B, xsize * n * sizeof (double)) ;
+        OK (isreal ?
+            klu_s_refine (Ap, Ai, Ax, Symbolic, Numeric, n, 1, maxiter, X,
+                Common) :
+            klu_c_refine (Ap, Ai, Ax, Symbolic, Numeric, n, 1, maxiter, X,
+                Common)) ;
+        err = 0 ;
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            err = MAX (err, fabs (X [k] - ((k % xsize) ? 0 : 1))) ;
+        }
+        k = (maxiter == 1) ? 0 : 1 ;
+        nrefine [k] = Common->nrefine ;
+        berr [k] = Common->berr ;
+        printf ("refine: isreal "ID" maxiter "ID" nrefine %d berr %g err %g\n",
+            isreal, maxiter, Common->nrefine, Common->berr, err) ;
+    }
+
+    /* one step is not enough, but a few are */
+    OK (nrefine [0] == 1 && berr [0] > 1e-14) ;
+    OK (nrefine [1] > 1 && nrefine [1] < 10 && berr [1] < 1e-14) ;
+    OK (err < 1e-9) ;
+
+    if (isreal)
+    {
+        klu_s_free_numeric (&Numeric, Common) ;
+    }
+    else
+    {
+        klu_c_free_numeric (&Numeric, Common) ;
+    }
+    klu_free_symbolic (&Symbolic, Common) ;
+}
+
+
+/* ========================================================================== */
+/* === do_refine_hilbert ==================================================== */
+/* ========================================================================== */
+
+/* Refine with (1+i/2) times the Hilbert matrices of order 6 to 12, whose
+ * single precision factors are too inaccurate for refinement to always
+ * converge.  A step that makes the backward error worse must be undone, so
+ * the backward error with maxiter = 10 can be no larger than with
+ * maxiter = 0. */
+
+static void do_refine_hilbert (Int isreal, KLU_common *Common)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric ;
+    Int Ap [13], Ai [144], n, i, j, p, k, xsize, maxiter ;
+    double Ax [288], B [24], X [24], berr [2] ;
+    float Sx [288] ;
+
+    xsize = isreal ? 1 : 2 ;
+    for (n = 6 ; n <= 12 ; n++)
+    {
+        p = 0 ;
+        for (j = 0 ; j < n ; j++)
+        {
+            Ap [j] = p ;
+            for (i = 0 ; i < n ; i++)
+            {
+                Ai [p] = i ;
+                Ax [xsize*p] = 1. / (i+j+1) ;
+                if (!isreal)
+                {
+                    Ax [xsize*p+1] = 0.5 / (i+j+1) ;
+                }
+                p++ ;
+            }
+        }
+        Ap [n] = p ;
+        for (k = 0 ; k < xsize * p ; k++)
+        {
+            Sx [k] = (float) Ax [k] ;
+        }
+
+        Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+        OK (Symbolic) ;
+        Numeric = isreal ? klu_s_factor (Ap, Ai, Sx, Symbolic, Common) :
+            klu_c_factor (Ap, Ai, Sx, Symbolic, Common) ;
+        OK (Numeric) ;
+
+        for (maxiter = 0 ; maxiter <= 10 ; maxiter += 10)
+        {
+            /* b = A*x, where x is all ones */
+            for (k = 0 ; k < xsize * n ; k++)
+            {
+                B [k] = 0 ;
+            }
+            for (j = 0 ; j < n ; j++)
+            {
+                for (p = Ap [j] ; p < Ap [j+1] ; p++)
+                {
+                    for (k = 0 ; k < xsize ; k++)
+                    {
+                        B [xsize*Ai [p]+k] += Ax [xsize*p+k] ;
+                    }
+                }
+            }
+            memcpy (X, B, xsize * n * sizeof (double)) ;
+            OK (isreal ?
+                klu_s_refine (Ap, Ai, Ax, Symbolic, Numeric, n, 1, maxiter, X,
+                    Common) :
+                klu_c_refine (Ap, Ai, Ax, Symbolic, Numeric, n, 1, maxiter, X,
+                    Common)) ;
+            berr [maxiter == 0 ? 0 : 1] = Common->berr ;
+        }
+        printf ("refine hilbert: isreal "ID" n "ID" berr %g %g\n",
+            isreal, n, berr [0], berr [1]) ;
+        OK (berr [1] <= berr [0]) ;
+
+        if (isreal)
+        {
+            klu_s_free_numeric (&Numeric, Common) ;
+        }
+        else
+        {
+            klu_c_free_numeric (&Numeric, Common) ;
+        }
+        klu_free_symbolic (&Symbolic, Common) ;
+    }
+}
+
+
+/* ========================================================================== */
+/* === do_repivot =========================================================== */
+/* ========================================================================== */
+
+/* Factorize a matrix with 2 diagonal blocks in its BTF form, each tridiagonal
+ * and diagonally dominant, then refactorize it with the diagonal of the second
+ * block made tiny, so that the old pivots are unstable.  With
+ * Common->repivot_tol = 1e-8, klu_refactor must repivot exactly that block,
+ * and the solution must have a small residual.  With repivot_tol = 0 no block
+ * is repivoted, and the residual is large.  Returns the relative residual
+ * after repivoting. */
+
+static double do_repivot (Int isreal, KLU_common *Common)
+{
+    KLU_symbolic *Symbolic ;
+    KLU_numeric *Numeric ;
+    Int Ap [13], Ai [40], n, nb, i, j, p, k, xsize, trial ;
+    double Ax [80], Ax2 [80], B [24], X [24], R [24], savetol, resid, rnorm,
+        anorm, xnorm, bnorm, xr, xi ;
+
+    nb = 6 ;
+    n = 2 * nb ;
+    xsize = isreal ? 1 : 2 ;
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+        Ap [j] = p ;
+        for (i = 0 ; i < n ; i++)
+        {
+            if (!((i / nb == j / nb && i >= j-1 && i <= j+1) ||
+                  (j == nb && i == nb-1)))
+            {
+                continue ;
+            }
+            Ai [p] = i ;
+            for (k = 0 ; k < xsize ; k++)
+            {
+                Ax [xsize*p+k] = (i == j) ? (4 - 3*k) : (-1 - 0.5*k) ;
+                Ax2 [xsize*p+k] = (i == j && j >= nb) ? 1e-12 :
+                    Ax [xsize*p+k] ;
+            }
+            p++ ;
+        }
+    }
+    Ap [n] = p ;
+
+    savetol = Common->repivot_tol ;
+    Symbolic = klu_analyze (n, Ap, Ai, Common) ;
+    OK (Symbolic && Symbolic->nblocks == 2) ;
+    resid = 0 ;
+
+    for (trial = 0 ; trial <= 1 ; trial++)
+    {
+        /* trial 0: repivot_tol = 0, trial 1: repivot_tol = 1e-8 */
+        Numeric = isreal ? klu_factor (Ap, Ai, Ax, Symbolic, Common) :
+            klu_z_factor (Ap, Ai, Ax, Symbolic, Common) ;
+        OK (Numeric) ;
+        Common->repivot_tol = (trial == 0) ? 0 : 1e-8 ;
+        OK (isreal ? klu_refactor (Ap, Ai, Ax2, Symbolic, Numeric, Common) :
+            klu_z_refactor (Ap, Ai, Ax2, Symbolic, Numeric, Common)) ;
+        printf ("repivot: isreal "ID" tol %g nrepivot %d rgrowth %g\n",
+            isreal, Common->repivot_tol, Common->nrepivot, Common->rgrowth) ;
+        OK (Common->nrepivot == trial) ;
+        OK (trial == 0 || Common->rgrowth >= 1e-8) ;
+
+        /* solve Ax=b with b all ones, and find the residual r = b-A*x */
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            B [k] = (k % xsize) ? 0 : 1 ;
+            X [k] = B [k] ;
+            R [k] = B [k] ;
+        }
+        OK (isreal ? klu_solve (Symbolic, Numeric, n, 1, X, Common) :
+            klu_z_solve (Symbolic, Numeric, n, 1, X, Common)) ;
+        anorm = 0 ;
+        for (j = 0 ; j < n ; j++)
+        {
+            for (p = Ap [j] ; p < Ap [j+1] ; p++)
+            {
+                i = Ai [p] ;
+                if (isreal)
+                {
+                    R [i] -= Ax2 [p] * X [j] ;
+                }
+                else
+                {
+                    xr = X [2*j] ;
+                    xi = X [2*j+1] ;
+                    R [2*i  ] -= Ax2 [2*p] * xr - Ax2 [2*p+1] * xi ;
+                    R [2*i+1] -= Ax2 [2*p] * xi + Ax2 [2*p+1] * xr ;
+                }
+                anorm = MAX (anorm, fabs (Ax2 [xsize*p])) ;
+            }
+        }
+        rnorm = 0 ;
+        xnorm = 0 ;
+        bnorm = 1 ;
+        for (k = 0 ; k < xsize * n ; k++)
+        {
+            rnorm = MAX (rnorm, fabs (R [k])) ;
+            xnorm = MAX (xnorm, fabs (X [k])) ;
+        }
+        rnorm /= (n * anorm * xnorm + bnorm) ;
+        printf ("repivot resid %g\n", rnorm) ;
+        OK (trial == 1 || rnorm > 1e-10) ;
+        if (trial == 1)
+        {
+            resid = rnorm ;
+        }
+
+        if (isreal)
+        {
+            klu_free_numeric (&Numeric, Common) ;
+        }
+        else
+        {
+            klu_z_free_numeric (&Numeric, Common) ;
+        }
+    }
+
+    OK (resid < 1e-14) ;
+    Common->repivot_tol = savetol ;
+    klu_free_symbolic (&Symbolic, Common) ;
+    return (resid) ;
+}
+
+
+/* ========================================================================== */
+/* === main ================================================================= */
+/* ========================================================================== */
+
+int main (void)
+{
+    KLU_common Common ;
+    cholmod_sparse *A, *A2 ;
+    cholmod_dense *X, *B ;
+    cholmod_common ch ;
+    Int *Ap, *Ai, *Puser, *Quser, *Gunk ;
+    double *Ax, *Xx, *A2x ;
+    double one [2], zero [2], xsave, maxerr, err ;
+    Int n, i, j, nz, save, isreal, k, isnan ;
+    KLU_symbolic *Symbolic, *Symbolic2 ;
+    KLU_numeric *Numeric ;
+
+    one [0] = 1 ;
+    one [1] = 0 ;
+    zero [0] = 0 ;
+    zero [1] = 0 ;
+
+    printf ("klu test: -------------------------------------------------\n") ;
+    OK (klu_defaults (&Common)) ;
+    CHOLMOD_start (&ch) ;
+    ch.print = 0 ;
+    normal_memory_handler ( ) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* read in a sparse matrix from stdin */
+    /* ---------------------------------------------------------------------- */
+
+    A = CHOLMOD_read_sparse (stdin, &ch) ;
+
+    // error: only square unsymmetric matrices handled
+    FAIL (A->nrow != A->ncol || A->stype != 0) ;
+    // error: only real or complex matrices handled
+    FAIL (!(A->xtype == CHOLMOD_REAL || A->xtype == CHOLMOD_COMPLEX)) ;
+
+    n = A->nrow ;
+    Ap = A->p ;
+    Ai = A->i ;
+    Ax = A->x ;
+    nz = Ap [n] ;
+    isreal = (A->xtype == CHOLMOD_REAL) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* construct random permutations */
+    /* ---------------------------------------------------------------------- */
+
+    Puser = randperm (n, n) ;
+    Quser = randperm (n, n) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* select known solution to Ax=b */
+    /* ---------------------------------------------------------------------- */
+
+    X = CHOLMOD_allocate_dense (n, NRHS, n, A->xtype, &ch) ;
+    Xx = X->x ;
+    for (j = 0 ; j < NRHS ; j++)
+    {
+        for (i = 0 ; i < n ; i++)
+        {
+            if (isreal)
+            {
+                Xx [i] = 1 + ((double) i) / ((double) n) + j * 100;
+            }
+            else
+            {
+                Xx [2*i  ] = 1 + ((double) i) / ((double) n) + j * 100 ;
+                Xx [2*i+1] =  - ((double) i+1) / ((double) n + j) ;
+                if (j == NRHS-1)
+                {
+                    Xx [2*i+1] = 0 ;    /* zero imaginary part */
+                }
+                else if (j == NRHS-2)
+                {
+                    Xx [2*i] = 0 ;      /* zero real part */
+                }
+            }
+        }
+        Xx += isreal ? n : 2*n ;
+    }
+
+    /* B = A*X */
+    B = CHOLMOD_allocate_dense (n, NRHS, n, A->xtype, &ch) ;
+    CHOLMOD_sdmult (A, 0, one, zero, X, B, &ch) ;
+    /* Bx = B->x ; */
+
+    /* ---------------------------------------------------------------------- */
+    /* test KLU */
+    /* ---------------------------------------------------------------------- */
+
+    test_memory_handler ( ) ;
+    maxerr = do_solves (A, B, X, Puser, Quser, &Common, &ch, &isnan) ;
+    printf ("dosolves err %g\n\n", maxerr) ;
+
+    /* ---------------------------------------------------------------------- */
+    /* test the features of the Numeric object on other matrices */
+    /* ---------------------------------------------------------------------- */
+
+    do_serialize (n, Ap, Ai, Ax, isreal, &Common) ;
+    err = do_solve_sparse (n, Ap, Ai, Ax, isreal, &Common) ;
+    maxerr = MAX (maxerr, err) ;
+    do_wide_solve (n, Ap, Ai, Ax, isreal, &Common) ;
+    do_parallel_analyze (n, Ap, Ai, &Common) ;
+    err = do_refactor_solve_batch (n, Ap, Ai, Ax, isreal, &Common) ;
+    maxerr = MAX (maxerr, err) ;
+    for (k = 0 ; k <= 1 ; k++)
+    {
+        /* k = 0: real, k = 1: complex */
+        do_parallel_factor (k == 0, &Common) ;
+        err = do_dense_refactor (k == 0, &Common) ;
+        maxerr = MAX (maxerr, err) ;
+        err = do_refactor_partial (k == 0, &Common) ;
+        maxerr = MAX (maxerr, err) ;
+        do_refine (k == 0, &Common) ;
+        do_refine_hilbert (k == 0, &Common) ;
+        err = do_repivot (k == 0, &Common) ;
+        maxerr = MAX (maxerr, err) ;
+    }
+    do_cache ( ) ;
     int64_t *pp = my_calloc (2, 4) ;
     pp [0] = 1 ;
     OK (pp) ;
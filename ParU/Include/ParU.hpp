@@ -301,6 +301,7 @@ struct ParU_Numeric
     double min_udiag;
     double max_udiag;
     ParU_Ret res;  // returning value of numeric phase
+    double growth;  // pivot growth, max |U| / max |S|, S scaled as in Sx
 };
 //------------------------------------------------------------------------------
 // ParU_Version:
@@ -339,6 +340,26 @@ ParU_Ret ParU_Factorize(
     // control:
     ParU_Control *Control);
 
+//------------------------------------------------------------------------------
+// ParU_Refactorize: Numeric refactorization of a matrix A with the same pattern
+// as the one factorized by ParU_Factorize.  The pivot order, the row and
+// column lists of each front and the memory of the factors in Num are reused;
+// only the numerical values are computed again, in place, without any pivot
+// search.  On output Num->growth holds the pivot growth; if it is large, or if
+// the return value is PARU_SINGULAR or PARU_PATTERN_CHANGED (the values of A
+// need entries outside the pattern of the factors in Num), the pivot order of
+// Num is no longer suitable for A and A should be factorized again with
+// ParU_Factorize.  Num is not freed on error.
+//------------------------------------------------------------------------------
+
+ParU_Ret ParU_Refactorize(
+    // input:
+    cholmod_sparse *A, ParU_Symbolic *Sym,
+    // input/output:
+    ParU_Numeric *Num,
+    // control:
+    ParU_Control *Control);
+
 //------------------------------------------------------------------------------
 //--------------------- Solve routines -----------------------------------------
 //------------------------------------------------------------------------------
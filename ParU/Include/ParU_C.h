@@ -73,6 +73,7 @@ typedef struct ParU_C_Numeric_struct
     int64_t *Pfin ;         // or P?
     double *Rs ;
     void *num_handle;
+    double growth;          // pivot growth, see ParU_Numeric
 } ParU_C_Numeric;
 
 #ifdef __cplusplus
@@ -124,6 +125,19 @@ ParU_Ret ParU_C_Factorize(
         // control:
         ParU_C_Control *Control);
 
+//------------------------------------------------------------------------------
+// ParU_C_Refactorize: Numeric refactorization of a matrix with the same
+// pattern, reusing the pivot order and the memory of Num; see ParU_Refactorize.
+//------------------------------------------------------------------------------
+
+ParU_Ret ParU_C_Refactorize(
+        // input:
+        cholmod_sparse *A, ParU_C_Symbolic *Sym,
+        // input/output:
+        ParU_C_Numeric *Num,
+        // control:
+        ParU_C_Control *Control);
+
 //------------------------------------------------------------------------------
 //--------------------- Solve routines -----------------------------------------
 //------------------------------------------------------------------------------
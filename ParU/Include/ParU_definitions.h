@@ -20,30 +20,31 @@ typedef enum ParU_Ret
     PARU_OUT_OF_MEMORY = -1,  
     PARU_INVALID = -2,
     PARU_SINGULAR = -3,
-    PARU_TOO_LARGE = -4
+    PARU_TOO_LARGE = -4,
+    PARU_PATTERN_CHANGED = -5   // from ParU_Refactorize: A does not fit Num
 } ParU_Ret;
 
 #define PARU_MEM_CHUNK (1024*1024)
 
-#define PARU_DATE "Mar 22, 2024"
+#define PARU_DATE "Oct 18, 2026"
 #define PARU_VERSION_MAJOR  0
-#define PARU_VERSION_MINOR  1
-#define PARU_VERSION_UPDATE 3
+#define PARU_VERSION_MINOR  2
+#define PARU_VERSION_UPDATE 0
 
-#define PARU__VERSION SUITESPARSE__VERCODE(0,1,3)
+#define PARU__VERSION SUITESPARSE__VERCODE(0,2,0)
 #if !defined (SUITESPARSE__VERSION) || \
     (SUITESPARSE__VERSION < SUITESPARSE__VERCODE(7,7,0))
-#error "ParU 0.1.3 requires SuiteSparse_config 7.7.0 or later"
+#error "ParU 0.2.0 requires SuiteSparse_config 7.7.0 or later"
 #endif
 
 #if !defined (UMFPACK__VERSION) || \
     (UMFPACK__VERSION < SUITESPARSE__VERCODE(6,3,3))
-#error "ParU 0.1.3 requires UMFPACK 6.3.3 or later"
+#error "ParU 0.2.0 requires UMFPACK 6.3.3 or later"
 #endif
 
 #if !defined (CHOLMOD__VERSION) || \
     (CHOLMOD__VERSION < SUITESPARSE__VERCODE(5,2,1))
-#error "ParU 0.1.3 requires CHOLMOD 5.2.1 or later"
+#error "ParU 0.2.0 requires CHOLMOD 5.2.1 or later"
 #endif
 
 //  the same values as UMFPACK_STRATEGY defined in UMFPACK/Include/umfpack.h
@@ -153,6 +153,31 @@ ParU_Ret ParU_C_Factorize (
     Num_C->num_handle = static_cast<void*>(Num);
     *Num_handle_C = Num_C;
     Num_C->rcond = Num->rcond;
+    Num_C->growth = Num->growth;
+    return info;
+}
+
+//------------------------------------------------------------------------------
+// ParU_C_Refactorize: Numeric refactorization of a matrix with the same
+// pattern, reusing the pivot order and the memory of Num; see ParU_Refactorize.
+//------------------------------------------------------------------------------
+
+ParU_Ret ParU_C_Refactorize (
+        // input:
+        cholmod_sparse *A, ParU_C_Symbolic *Sym_C,
+        // input/output:
+        ParU_C_Numeric *Num_C,
+        // control:
+    ParU_C_Control *Control_C)
+{ 
+    if (!Num_C) return PARU_INVALID;
+    ParU_Control Control;
+    paru_cp_control (&Control, Control_C);
+    ParU_Symbolic *Sym = static_cast<ParU_Symbolic*>(Sym_C->sym_handle);
+    ParU_Numeric *Num = static_cast<ParU_Numeric*>(Num_C->num_handle);
+    ParU_Ret info = ParU_Refactorize(A, Sym, Num, &Control);
+    Num_C->rcond = Num->rcond;
+    Num_C->growth = Num->growth;
     return info;
 }
 
@@ -552,6 +552,7 @@ ParU_Ret ParU_Factorize(cholmod_sparse *A, ParU_Symbolic *Sym,
     Num->min_udiag = min_udiag;
     Num->max_udiag = max_udiag;
     Num->rcond = min_udiag / max_udiag;
+    Num->growth = paru_pivot_growth(Sym, Num, Control);
 #ifndef NTIME
     double time = PARU_OPENMP_GET_WTIME;
     time -= my_start_time;
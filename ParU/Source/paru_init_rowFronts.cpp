@@ -126,10 +126,7 @@ ParU_Ret paru_init_rowFronts(paru_work *Work,
     int64_t snz = Num->snz = Sym->snz;
     double *Sx = NULL;
     Sx = Num->Sx = static_cast<double*>(paru_alloc(snz, sizeof(double)));
-    int64_t *cSp = NULL;  // copy of Sp, temporary for making Sx
-    cSp = static_cast<int64_t*>(paru_alloc(m + 1, sizeof(int64_t)));
     double *Sux = NULL;
-    int64_t *cSup = NULL;  // copy of Sup temporary for making Sux
     int64_t cs1 = Sym->cs1;
     int64_t rs1 = Sym->rs1;
     int64_t sunz = 0;
@@ -137,17 +134,14 @@ ParU_Ret paru_init_rowFronts(paru_work *Work,
     {
         sunz = Sym->ustons.nnz;
         Sux = static_cast<double*>(paru_alloc(sunz, sizeof(double)));
-        cSup = static_cast<int64_t*>(paru_alloc(cs1 + 1, sizeof(int64_t)));
     }
     Num->Sux = Sux;
     double *Slx = NULL;
-    int64_t *cSlp = NULL;  // copyf of Slp temporary, for making Slx
     int64_t slnz = 0;
     if (rs1 > 0)
     {
         slnz = Sym->lstons.nnz;
         Slx = static_cast<double*>(paru_alloc(slnz, sizeof(double)));
-        cSlp = static_cast<int64_t*>(paru_alloc(rs1 + 1, sizeof(int64_t)));
     }
     Num->sunz = sunz;
     Num->slnz = slnz;
@@ -169,12 +163,8 @@ ParU_Ret paru_init_rowFronts(paru_work *Work,
 
         // stuff that can be allocated even when nf==0
         Sx == NULL || (scale == 1 && Rs == NULL) ||
-        (cs1 > 0 && (Sux == NULL || cSup == NULL)) ||
-        (rs1 > 0 && (Slx == NULL || cSlp == NULL)) || cSp == NULL)
+        (cs1 > 0 && Sux == NULL) || (rs1 > 0 && Slx == NULL))
     {
-        paru_free(m + 1, sizeof(int64_t), cSp);
-        if (cs1 > 0) paru_free((cs1 + 1), sizeof(int64_t), cSup);
-        if (rs1 > 0) paru_free((rs1 + 1), sizeof(int64_t), cSlp);
         return PARU_OUT_OF_MEMORY;
     }
 
@@ -199,153 +189,10 @@ ParU_Ret paru_init_rowFronts(paru_work *Work,
     }
 
     //////////////////Initializing numerics Sx, Sux and Slx //////////////////{
-    int64_t *Ap = static_cast<int64_t*>(A->p);
-    int64_t *Ai = static_cast<int64_t*>(A->i);
-    double *Ax = static_cast<double*>(A->x);
-    int64_t *Sp = Sym->Sp;
-    int64_t *Slp = NULL;
-    int64_t *Sup = NULL;
-    paru_memcpy(cSp, Sp, (m + 1) * sizeof(int64_t), Control);
-    if (cs1 > 0)
-    {
-        Sup = Sym->ustons.Sup;
-        paru_memcpy(cSup, Sup, (cs1 + 1) * sizeof(int64_t), Control);
-    }
-    if (rs1 > 0)
-    {
-        Slp = Sym->lstons.Slp;
-        paru_memcpy(cSlp, Slp, (rs1 + 1) * sizeof(int64_t), Control);
-    }
-#ifndef NDEBUG
-    PR = 1;
-    PRLEVEL(PR, ("Init Sup and Slp in the middle\n"));
-    if (cs1 > 0)
-    {
-        PRLEVEL(PR, ("(" LD ") Sup =", sunz));
-        for (int64_t k = 0; k <= cs1; k++)
-        {
-            PRLEVEL(PR, ("" LD " ", Sup[k]));
-            PRLEVEL(PR + 2, ("c" LD " ", cSup[k]));
-            if (Sup[k] != cSup[k])
-                PRLEVEL(PR, ("Sup[" LD "] =" LD ", cSup=" LD "", k, Sup[k], cSup[k]));
-            ASSERT(Sup[k] == cSup[k]);
-        }
-        PRLEVEL(PR, ("\n"));
-    }
-    if (rs1 > 0)
-    {
-        PRLEVEL(PR, ("(" LD ") Slp =", slnz));
-        for (int64_t k = 0; k <= rs1; k++)
-        {
-            PRLEVEL(PR, ("" LD " ", Slp[k]));
-            PRLEVEL(PR + 2, ("o" LD " ", cSlp[k]));
-            if (Slp[k] != cSlp[k])
-                PRLEVEL(PR,
-                        ("\nSup[" LD "] =" LD ", cSup=" LD "\n", k, Slp[k], cSlp[k]));
-            ASSERT(Slp[k] == cSlp[k]);
-        }
-        PRLEVEL(PR, ("\n"));
-    }
-#endif
-
-    int64_t n1 = Sym->n1;
-
-    int64_t *Qinit = Sym->Qfill;
-    int64_t *Pinv = Sym->Pinv;
-#ifndef NDEBUG
-    PR = 1;
-    PRLEVEL(PR, ("Iniit Pinv =\n"));
-    for (int64_t i = 0; i < m; i++) PRLEVEL(PR, ("" LD " ", Pinv[i]));
-    PRLEVEL(PR, ("\n"));
-#endif
-
-    if (Rs)
-    {
-        for (int64_t newcol = 0; newcol < Sym->n; newcol++)
-        {
-            int64_t oldcol = Qinit[newcol];
-            for (int64_t p = Ap[oldcol]; p < Ap[oldcol + 1]; p++)
-            {
-                int64_t oldrow = Ai[p];
-                Rs[oldrow] = std::max(Rs[oldrow], fabs(Ax[p]));
-            }
-        }
-    }
-
-    PRLEVEL(PR, ("%% Rs:\n["));
-    if (Rs)
-    {  // making sure that every row has at most one element more than zero
-        for (int64_t k = 0; k < m; k++)
-        {
-            PRLEVEL(PR, ("%lf ", Rs[k]));
-            if (Rs[k] <= 0)
-            {
-                PRLEVEL(1, ("ParU: Matrix is singular, row " LD " is zero\n", k));
-                Num->res = PARU_SINGULAR;
-                return PARU_SINGULAR;
-            }
-        }
-    }
-    PRLEVEL(PR, ("]\n"));
+    ParU_Ret info = paru_init_values(A, Sym, Num, Control);
+    if (info != PARU_SUCCESS) return info;
+    //////////////////Initializing numerics Sx, Sux and Slx //////////////////}
 
-    for (int64_t newcol = 0; newcol < Sym->n; newcol++)
-    {
-        int64_t oldcol = Qinit[newcol];
-        for (int64_t p = Ap[oldcol]; p < Ap[oldcol + 1]; p++)
-        {
-            int64_t oldrow = Ai[p];
-            int64_t newrow = Pinv[oldrow];
-            int64_t srow = newrow - n1;
-            int64_t scol = newcol - n1;
-            if (srow >= 0 && scol >= 0)
-            {  // it is inside S otherwise it is part of singleton
-                Sx[cSp[srow]++] = (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
-            }
-            else if (srow < 0 && scol >= 0)
-            {  // inside the U singletons
-                PRLEVEL(PR, ("Usingleton newcol = " LD " newrow=" LD "\n", newcol,
-                             newrow));
-                // let the diagonal entries be first
-                Sux[++cSup[newrow]] = (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
-            }
-            else
-            {
-                if (newrow < cs1)
-                {  // inside U singletons CSR
-                    // PRLEVEL(PR, ("Inside U singletons\n"));
-                    if (newcol == newrow)
-                    {  // diagonal entry
-                        Sux[Sup[newrow]] =
-                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
-                    }
-                    else
-                    {
-                        Sux[++cSup[newrow]] =
-                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
-                    }
-                }
-                else
-                {  // inside L singletons CSC
-                    // PRLEVEL(PR, ("Inside L singletons\n"));
-                    if (newcol == newrow)
-                    {  // diagonal entry
-                        Slx[Slp[newcol - cs1]] =
-                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
-                    }
-                    else
-                    {
-                        Slx[++cSlp[newcol - cs1]] =
-                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
-                    }
-                }
-            }
-        }
-    }
-    paru_free(m + 1, sizeof(int64_t), cSp);
-    if (Sym->cs1 > 0) paru_free((cs1 + 1), sizeof(int64_t), cSup);
-    if (Sym->rs1 > 0) paru_free((rs1 + 1), sizeof(int64_t), cSlp);
-        //////////////////Initializing numerics Sx, Sux and Slx
-        /////////////////////}
 #ifdef COUNT_FLOPS
     // flop count info init
     Work->flp_cnt_dgemm = 0.0;
@@ -357,6 +204,7 @@ ParU_Ret paru_init_rowFronts(paru_work *Work,
     // RowList, ColList and elementList are place holders
     // pointers to pointers that are allocated
 
+    int64_t *Sp = Sym->Sp;
     int64_t *Sj = Sym->Sj;
 
     /// ------------------------------------------------------------------------
@@ -418,7 +266,6 @@ ParU_Ret paru_init_rowFronts(paru_work *Work,
     // Activating comments after this parts will break the matlab input matrix
     // allocating row tuples, elements and updating column tuples
 
-    ParU_Ret info;
     int64_t out_of_memory = 0;
 
     //XXX weird situation here:
@@ -0,0 +1,202 @@
+////////////////////////////////////////////////////////////////////////////////
+//////////////////////////  paru_init_values  //////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// ParU, Copyright (c) 2022, Mohsen Aznaveh and Timothy A. Davis,
+// All Rights Reserved.
+// SPDX-License-Identifier: GNU GPL 3.0
+
+/*!  @brief  Computing the numerical values of S and the singletons from A:
+ *         Rs is the row scaling (if Num->Rs is allocated), Sx the values of
+ *         S in the order of Sym->Sj, Sux and Slx the values of U and L
+ *         singletons.  Num->Sx, Num->Sux, Num->Slx and Num->Rs must already
+ *         be allocated; they are overwritten.  This is used by
+ *         paru_init_rowFronts and by ParU_Refactorize.
+ *
+ * @author Aznaveh
+ */
+#include <algorithm>
+
+#include "paru_internal.hpp"
+
+ParU_Ret paru_init_values(cholmod_sparse *A, ParU_Symbolic *Sym,
+                          ParU_Numeric *Num, ParU_Control *Control)
+{
+    DEBUGLEVEL(0);
+    PARU_DEFINE_PRLEVEL;
+
+    int64_t m = Sym->m - Sym->n1;
+    int64_t cs1 = Sym->cs1;
+    int64_t rs1 = Sym->rs1;
+    double *Sx = Num->Sx;
+    double *Sux = Num->Sux;
+    double *Slx = Num->Slx;
+    double *Rs = Num->Rs;
+
+    int64_t *cSp = NULL;  // copy of Sp, temporary for making Sx
+    cSp = static_cast<int64_t*>(paru_alloc(m + 1, sizeof(int64_t)));
+    int64_t *cSup = NULL;  // copy of Sup temporary for making Sux
+    if (cs1 > 0)
+        cSup = static_cast<int64_t*>(paru_alloc(cs1 + 1, sizeof(int64_t)));
+    int64_t *cSlp = NULL;  // copyf of Slp temporary, for making Slx
+    if (rs1 > 0)
+        cSlp = static_cast<int64_t*>(paru_alloc(rs1 + 1, sizeof(int64_t)));
+    if (cSp == NULL || (cs1 > 0 && cSup == NULL) || (rs1 > 0 && cSlp == NULL))
+    {
+        paru_free(m + 1, sizeof(int64_t), cSp);
+        if (cs1 > 0) paru_free((cs1 + 1), sizeof(int64_t), cSup);
+        if (rs1 > 0) paru_free((rs1 + 1), sizeof(int64_t), cSlp);
+        return PARU_OUT_OF_MEMORY;
+    }
+
+    int64_t *Ap = static_cast<int64_t*>(A->p);
+    int64_t *Ai = static_cast<int64_t*>(A->i);
+    double *Ax = static_cast<double*>(A->x);
+    int64_t *Sp = Sym->Sp;
+    int64_t *Slp = NULL;
+    int64_t *Sup = NULL;
+    paru_memcpy(cSp, Sp, (m + 1) * sizeof(int64_t), Control);
+    if (cs1 > 0)
+    {
+        Sup = Sym->ustons.Sup;
+        paru_memcpy(cSup, Sup, (cs1 + 1) * sizeof(int64_t), Control);
+    }
+    if (rs1 > 0)
+    {
+        Slp = Sym->lstons.Slp;
+        paru_memcpy(cSlp, Slp, (rs1 + 1) * sizeof(int64_t), Control);
+    }
+#ifndef NDEBUG
+    PR = 1;
+    PRLEVEL(PR, ("Init Sup and Slp in the middle\n"));
+    if (cs1 > 0)
+    {
+        PRLEVEL(PR, ("(" LD ") Sup =", Num->sunz));
+        for (int64_t k = 0; k <= cs1; k++)
+        {
+            PRLEVEL(PR, ("" LD " ", Sup[k]));
+            PRLEVEL(PR + 2, ("c" LD " ", cSup[k]));
+            if (Sup[k] != cSup[k])
+                PRLEVEL(PR, ("Sup[" LD "] =" LD ", cSup=" LD "", k, Sup[k], cSup[k]));
+            ASSERT(Sup[k] == cSup[k]);
+        }
+        PRLEVEL(PR, ("\n"));
+    }
+    if (rs1 > 0)
+    {
+        PRLEVEL(PR, ("(" LD ") Slp =", Num->slnz));
+        for (int64_t k = 0; k <= rs1; k++)
+        {
+            PRLEVEL(PR, ("" LD " ", Slp[k]));
+            PRLEVEL(PR + 2, ("o" LD " ", cSlp[k]));
+            if (Slp[k] != cSlp[k])
+                PRLEVEL(PR,
+                        ("\nSup[" LD "] =" LD ", cSup=" LD "\n", k, Slp[k], cSlp[k]));
+            ASSERT(Slp[k] == cSlp[k]);
+        }
+        PRLEVEL(PR, ("\n"));
+    }
+#endif
+
+    int64_t n1 = Sym->n1;
+
+    int64_t *Qinit = Sym->Qfill;
+    int64_t *Pinv = Sym->Pinv;
+#ifndef NDEBUG
+    PR = 1;
+    PRLEVEL(PR, ("Iniit Pinv =\n"));
+    for (int64_t i = 0; i < m; i++) PRLEVEL(PR, ("" LD " ", Pinv[i]));
+    PRLEVEL(PR, ("\n"));
+#endif
+
+    if (Rs)
+    {
+        paru_memset(Rs, 0, Sym->m * sizeof(double), Control);
+        for (int64_t newcol = 0; newcol < Sym->n; newcol++)
+        {
+            int64_t oldcol = Qinit[newcol];
+            for (int64_t p = Ap[oldcol]; p < Ap[oldcol + 1]; p++)
+            {
+                int64_t oldrow = Ai[p];
+                Rs[oldrow] = std::max(Rs[oldrow], fabs(Ax[p]));
+            }
+        }
+    }
+
+    PRLEVEL(PR, ("%% Rs:\n["));
+    if (Rs)
+    {  // making sure that every row has at most one element more than zero
+        for (int64_t k = 0; k < m; k++)
+        {
+            PRLEVEL(PR, ("%lf ", Rs[k]));
+            if (Rs[k] <= 0)
+            {
+                PRLEVEL(1, ("ParU: Matrix is singular, row " LD " is zero\n", k));
+                paru_free(m + 1, sizeof(int64_t), cSp);
+                if (cs1 > 0) paru_free((cs1 + 1), sizeof(int64_t), cSup);
+                if (rs1 > 0) paru_free((rs1 + 1), sizeof(int64_t), cSlp);
+                Num->res = PARU_SINGULAR;
+                return PARU_SINGULAR;
+            }
+        }
+    }
+    PRLEVEL(PR, ("]\n"));
+
+    for (int64_t newcol = 0; newcol < Sym->n; newcol++)
+    {
+        int64_t oldcol = Qinit[newcol];
+        for (int64_t p = Ap[oldcol]; p < Ap[oldcol + 1]; p++)
+        {
+            int64_t oldrow = Ai[p];
+            int64_t newrow = Pinv[oldrow];
+            int64_t srow = newrow - n1;
+            int64_t scol = newcol - n1;
+            if (srow >= 0 && scol >= 0)
+            {  // it is inside S otherwise it is part of singleton
+                Sx[cSp[srow]++] = (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
+            }
+            else if (srow < 0 && scol >= 0)
+            {  // inside the U singletons
+                PRLEVEL(PR, ("Usingleton newcol = " LD " newrow=" LD "\n", newcol,
+                             newrow));
+                // let the diagonal entries be first
+                Sux[++cSup[newrow]] = (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
+            }
+            else
+            {
+                if (newrow < cs1)
+                {  // inside U singletons CSR
+                    // PRLEVEL(PR, ("Inside U singletons\n"));
+                    if (newcol == newrow)
+                    {  // diagonal entry
+                        Sux[Sup[newrow]] =
+                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
+                    }
+                    else
+                    {
+                        Sux[++cSup[newrow]] =
+                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
+                    }
+                }
+                else
+                {  // inside L singletons CSC
+                    // PRLEVEL(PR, ("Inside L singletons\n"));
+                    if (newcol == newrow)
+                    {  // diagonal entry
+                        Slx[Slp[newcol - cs1]] =
+                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
+                    }
+                    else
+                    {
+                        Slx[++cSlp[newcol - cs1]] =
+                            (Rs == NULL) ? Ax[p] : Ax[p] / Rs[oldrow];
+                    }
+                }
+            }
+        }
+    }
+    paru_free(m + 1, sizeof(int64_t), cSp);
+    if (cs1 > 0) paru_free((cs1 + 1), sizeof(int64_t), cSup);
+    if (rs1 > 0) paru_free((rs1 + 1), sizeof(int64_t), cSlp);
+    return PARU_SUCCESS;
+}
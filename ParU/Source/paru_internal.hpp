@@ -153,6 +153,22 @@ struct heaps_info
     int64_t sum_size, biggest_Child_size, biggest_Child_id;
 };
 
+// ParU_Lsolve and ParU_Usolve work on blocks of at most PARU_SOLVE_BLOCK
+// columns of X at a time
+#define PARU_SOLVE_BLOCK 32
+
+// shared by the tasks of ParU_Lsolve and ParU_Usolve
+struct paru_solve_work
+{
+    ParU_Symbolic *Sym;
+    ParU_Numeric *Num;
+    double *X;        // m-by-nrhs, the right hand sides
+    int64_t nrhs;
+    double *work;     // workspace of size wsize for each thread
+    int64_t wsize;
+    int64_t blas_ok;  // set to FALSE if an integer is too large for the BLAS
+};
+
 // =============================================================================
 //                   ParU_Tuple, Row data structure
 // =============================================================================
@@ -408,6 +424,8 @@ int64_t paru_bin_srch(int64_t *srt_lst, int64_t l, int64_t r, int64_t num);
 ParU_Ret paru_init_rowFronts(paru_work *Work, ParU_Numeric **Num_handle,
                              cholmod_sparse *A, ParU_Symbolic *Sym,
                              ParU_Control *Control);
+ParU_Ret paru_init_values(cholmod_sparse *A, ParU_Symbolic *Sym,
+                          ParU_Numeric *Num, ParU_Control *Control);
 ParU_Ret paru_front(int64_t f, paru_work *Work, ParU_Numeric *Num);
 
 ParU_Ret paru_pivotal(std::vector<int64_t> &pivotal_elements,
@@ -467,6 +485,11 @@ int64_t paru_gaxpy(cholmod_sparse *A, const double *x, double *y, double alpha);
 double paru_spm_1norm(cholmod_sparse *A);
 double paru_vec_1norm(const double *x, int64_t n);
 double paru_matrix_1norm(const double *x, int64_t m, int64_t n);
+double paru_pivot_growth(ParU_Symbolic *Sym, ParU_Numeric *Num,
+                         ParU_Control *Control);
+ParU_Ret paru_task_deps(ParU_Symbolic *Sym, ParU_Numeric *Num, bool forward,
+                        int64_t *num_deps, int64_t *Depp, int64_t **Dep_handle);
+bool paru_wide_tree(ParU_Symbolic *Sym, int64_t nthreads);
 
 void paru_Diag_update(int64_t pivcol, int64_t pivrow, paru_work *Work);
 int64_t paru_tasked_dgemm(int64_t f, int64_t m, int64_t n, int64_t k, double *A,
@@ -31,21 +31,280 @@
  *     TRSV on triangular part
  *     Then does DGEMV on the rest for 0 to nf
  *
- *           BLAS_DTRSV  is used here but I do not use BLAS_DGEMV explicitly
- *           while it needs space for each thread doing this computation.
- *           I guess using this way can have a good performance.
+ *     The columns of X are done in blocks of PARU_SOLVE_BLOCK, with a
+ *     DTRSM and a DGEMM on each block (DTRSV and DGEMV for a single column).
+ *
+ *     The fronts are done in parallel if the task tree is wide enough: a task
+ *     is started once all the tasks that update its pivot rows are done (see
+ *     paru_task_deps), and the updates to the rows below the pivots are
+ *     atomic.  Otherwise, if there are several blocks of columns, the blocks
+ *     are done in parallel.  Otherwise the fronts are done one at a time with
+ *     a multithreaded BLAS.
  *
  * @author Aznaveh
  * */
 #include "paru_internal.hpp"
 
+//------------------------------------------------------------------------------
+// paru_lsolve_front: X = L\X for the pivot rows of front f
+//------------------------------------------------------------------------------
+
+// X is a block of nrhs columns, with leading dimension m.  The rows of X
+// below the pivots of f are updated with atomics if atomic is true.  Returns
+// FALSE if an integer is too large for the BLAS.
+
+static int64_t paru_lsolve_front(int64_t f, ParU_Symbolic *Sym,
+                                 ParU_Numeric *Num, double *X, int64_t nrhs,
+                                 double *work, bool atomic)
+{
+    DEBUGLEVEL(0);
+    int64_t blas_ok = TRUE;
+    int64_t m = Sym->m;
+    int64_t n1 = Sym->n1;
+    int64_t *Ps = Num->Ps;
+    int64_t rowCount = Num->frowCount[f];
+    int64_t *frowList = Num->frowList[f];
+    int64_t col1 = Sym->Super[f];
+    int64_t col2 = Sym->Super[f + 1];
+    int64_t fp = col2 - col1;
+    double *A = Num->partial_LUs[f].p;
+    double *Xf = X + n1 + col1;
+
+    PRLEVEL(2, ("%% lsolve: Working on DTRSM f=" LD "\n", f));
+    double alpha = 1;
+    if (nrhs == 1)
+    {
+        SUITESPARSE_BLAS_dtrsv("L", "N", "U", fp, A, rowCount, Xf, 1, blas_ok);
+    }
+    else
+    {
+        SUITESPARSE_BLAS_dtrsm("L", "L", "N", "U", fp, nrhs, &alpha, A,
+                               rowCount, Xf, m, blas_ok);
+    }
+
+    int64_t cm = rowCount - fp;
+    if (cm <= 0) return blas_ok;
+
+    PRLEVEL(2, ("%% lsolve: Working on DGEMM f=" LD "\n", f));
+    PRLEVEL(2, ("fp=" LD "  rowCount=" LD "\n", fp, rowCount));
+    double beta = 0;
+    if (nrhs == 1)
+    {
+        SUITESPARSE_BLAS_dgemv("N", cm, fp, &alpha, A + fp, rowCount, Xf, 1,
+                               &beta, work, 1, blas_ok);
+    }
+    else
+    {
+        SUITESPARSE_BLAS_dgemm("N", "N", cm, nrhs, fp, &alpha, A + fp,
+                               rowCount, Xf, m, &beta, work, cm, blas_ok);
+    }
+
+    for (int64_t i = fp; i < rowCount; i++)
+    {
+        int64_t r = Ps[frowList[i]] + n1;
+        for (int64_t l = 0; l < nrhs; l++)
+        {
+            double w = work[i - fp + l * cm];
+            if (atomic)
+            {
+                #pragma omp atomic update
+                X[l * m + r] -= w;
+            }
+            else
+            {
+                X[l * m + r] -= w;
+            }
+        }
+    }
+    return blas_ok;
+}
+
+#if ! defined ( PARU_1TASK )
+
+//------------------------------------------------------------------------------
+// paru_lsolve_task: X = L\X for the fronts of task t
+//------------------------------------------------------------------------------
+
+// The fronts of task t are done in order, on all the blocks of columns of X.
+// Then each task that waits for t, listed in Dep [Depp [t] ... Depp [t+1]-1],
+// is started if t was the last task it was waiting for.
+
+static void paru_lsolve_task(int64_t t, int64_t *Depp, int64_t *Dep,
+                             int64_t *num_deps, paru_solve_work *W)
+{
+    ParU_Symbolic *Sym = W->Sym;
+    int64_t *task_map = Sym->task_map;
+    int64_t m = Sym->m;
+    int64_t nrhs = W->nrhs;
+    double *work = W->work + PARU_OPENMP_GET_THREAD_ID * W->wsize;
+    int64_t blas_ok = TRUE;
+    for (int64_t f = task_map[t] + 1; f <= task_map[t + 1]; f++)
+    {
+        for (int64_t k = 0; k < nrhs; k += PARU_SOLVE_BLOCK)
+        {
+            int64_t nb = std::min(nrhs - k, (int64_t)PARU_SOLVE_BLOCK);
+            blas_ok = paru_lsolve_front(f, Sym, W->Num, W->X + k * m, nb,
+                                        work, true) && blas_ok;
+        }
+    }
+    if (!blas_ok)
+    {
+        #pragma omp atomic write
+        W->blas_ok = FALSE;
+    }
+
+    for (int64_t p = Depp[t]; p < Depp[t + 1]; p++)
+    {
+        int64_t d = Dep[p];
+        int64_t num_rem_deps;
+        #pragma omp atomic capture
+        num_rem_deps = --num_deps[d];
+        if (num_rem_deps == 0)
+        {
+            #pragma omp task priority(Sym->task_depth[d])
+            paru_lsolve_task(d, Depp, Dep, num_deps, W);
+        }
+    }
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// paru_lsolve_fronts: X = L\X for all the fronts
+//------------------------------------------------------------------------------
+
+static ParU_Ret paru_lsolve_fronts(ParU_Symbolic *Sym, ParU_Numeric *Num,
+                                   double *X, int64_t nrhs,
+                                   ParU_Control *Control)
+{
+    DEBUGLEVEL(0);
+    int64_t nf = Sym->nf;
+    if (nf == 0 || nrhs <= 0) return PARU_SUCCESS;
+    int64_t m = Sym->m;
+    int32_t nthreads = control_nthreads(Control);
+    int64_t nb = std::min(nrhs, (int64_t)PARU_SOLVE_BLOCK);
+    int64_t nblocks = (nrhs + nb - 1) / nb;
+
+    bool tree = false;
+#if ! defined ( PARU_1TASK )
+    tree = paru_wide_tree(Sym, nthreads);
+#endif
+    bool parallel = (nthreads > 1) && (tree || nblocks > 1);
+
+    // gather scatter space for dgemm, for each thread
+    paru_solve_work myW;
+    paru_solve_work *W = &myW;
+    W->Sym = Sym;
+    W->Num = Num;
+    W->X = X;
+    W->nrhs = nrhs;
+    W->wsize = Num->max_row_count * nb;
+    W->blas_ok = TRUE;
+    int64_t nwork = parallel ? nthreads : 1;
+    W->work =
+        static_cast<double*>(paru_alloc(nwork * W->wsize, sizeof(double)));
+    if (W->work == NULL)
+    {
+        PRLEVEL(1, ("ParU: out of memory lsolve\n"));
+        return PARU_OUT_OF_MEMORY;
+    }
+
+    ParU_Ret info = PARU_SUCCESS;
+    if (!parallel)
+    {
+        BLAS_set_num_threads(nthreads);
+        for (int64_t k = 0; k < nrhs; k += nb)
+        {
+            int64_t nk = std::min(nrhs - k, nb);
+            for (int64_t f = 0; f < nf; f++)
+            {
+                W->blas_ok = paru_lsolve_front(f, Sym, Num, X + k * m, nk,
+                                               W->work, false) && W->blas_ok;
+            }
+        }
+    }
+#if ! defined ( PARU_1TASK )
+    else if (tree)
+    {
+        PRLEVEL(1, ("%% Parallel lsolve on the task tree\n"));
+        int64_t ntasks = Sym->ntasks;
+        // num_deps, then a copy of it that the tasks count down
+        int64_t *num_deps =
+            static_cast<int64_t*>(paru_alloc(2 * ntasks, sizeof(int64_t)));
+        int64_t *Depp =
+            static_cast<int64_t*>(paru_alloc(ntasks + 1, sizeof(int64_t)));
+        int64_t *Dep = NULL;
+        if (num_deps == NULL || Depp == NULL)
+        {
+            info = PARU_OUT_OF_MEMORY;
+        }
+        else
+        {
+            info = paru_task_deps(Sym, Num, true, num_deps, Depp, &Dep);
+        }
+        if (info == PARU_SUCCESS)
+        {
+            int64_t *task_depth = Sym->task_depth;
+            paru_memcpy(num_deps + ntasks, num_deps, ntasks * sizeof(int64_t),
+                        Control);
+            BLAS_set_num_threads(1);
+            #pragma omp parallel proc_bind(spread) num_threads(nthreads)
+            #pragma omp single nowait
+            for (int64_t t = 0; t < ntasks; t++)
+            {
+                if (num_deps[t] != 0) continue;
+                #pragma omp task priority(task_depth[t])
+                paru_lsolve_task(t, Depp, Dep, num_deps + ntasks, W);
+            }
+            paru_free(Depp[ntasks], sizeof(int64_t), Dep);
+        }
+        else
+        {
+            PRLEVEL(1, ("ParU: out of memory lsolve\n"));
+        }
+        paru_free(2 * ntasks, sizeof(int64_t), num_deps);
+        paru_free(ntasks + 1, sizeof(int64_t), Depp);
+    }
+#endif
+    else
+    {
+        // the blocks of columns of X are independent
+        PRLEVEL(1, ("%% Parallel lsolve on " LD " blocks of X\n", nblocks));
+        BLAS_set_num_threads(1);
+        #pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+        for (int64_t b = 0; b < nblocks; b++)
+        {
+            int64_t k = b * nb;
+            int64_t nk = std::min(nrhs - k, nb);
+            double *work = W->work + PARU_OPENMP_GET_THREAD_ID * W->wsize;
+            int64_t blas_ok = TRUE;
+            for (int64_t f = 0; f < nf; f++)
+            {
+                blas_ok = paru_lsolve_front(f, Sym, Num, X + k * m, nk, work,
+                                            false) && blas_ok;
+            }
+            if (!blas_ok)
+            {
+                #pragma omp atomic write
+                W->blas_ok = FALSE;
+            }
+        }
+    }
+
+    paru_free(nwork * W->wsize, sizeof(double), W->work);
+    if (info != PARU_SUCCESS) return info;
+    return (W->blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+}
+
+//------------------------------------------------------------------------------
+// ParU_Lsolve: x = L\x
+//------------------------------------------------------------------------------
+
 ParU_Ret ParU_Lsolve(ParU_Symbolic *Sym, ParU_Numeric *Num, double *x, ParU_Control *Control)
 {
     DEBUGLEVEL(0);
     if (!x) return PARU_INVALID;
     PARU_DEFINE_PRLEVEL;
-    int64_t nf = Sym->nf;
-    int64_t blas_ok = TRUE;
 #ifndef NDEBUG
     int64_t m = Sym->m;
     PRLEVEL(1, ("%%inside lsolve x is:\n%%"));
@@ -99,85 +358,7 @@ ParU_Ret ParU_Lsolve(ParU_Symbolic *Sym, ParU_Numeric *Num, double *x, ParU_Cont
     PRLEVEL(1, (" \n"));
 #endif
 
-    BLAS_set_num_threads(control_nthreads (Control)) ;
-
-    // gather scatter space for dgemm
-    double *work = static_cast<double*>(paru_alloc((Num->max_row_count), sizeof(double)));
-    if (work == NULL)
-    {
-        PRLEVEL(1, ("ParU: out of memory lsolve\n"));
-        return PARU_OUT_OF_MEMORY;
-    }
-
-    ParU_Factors *LUs = Num->partial_LUs;
-    int64_t *Super = Sym->Super;
-
-    for (int64_t f = 0; f < nf; f++)
-    {
-        int64_t rowCount = Num->frowCount[f];
-        int64_t *frowList = Num->frowList[f];
-        int64_t col1 = Super[f];
-        int64_t col2 = Super[f + 1];
-        int64_t fp = col2 - col1;
-        double *A = LUs[f].p;
-        double *X = x + col1 + n1;
-
-        PRLEVEL(2, ("%% Working on DTRSV\n"));
-        SUITESPARSE_BLAS_dtrsv("L", "N", "U", fp, A, rowCount, X, 1, blas_ok);
-        PRLEVEL(2, ("%% DTRSV is just finished\n"));
-
-#ifndef NDEBUG
-        PR = 2;
-        PRLEVEL(PR, ("%% LUs:\n%%"));
-        for (int64_t r = 0; r < rowCount; r++)
-        {
-            PRLEVEL(PR, ("%% " LD "\t", frowList[r]));
-            for (int64_t c = col1; c < col2; c++)
-                PRLEVEL(PR, (" %2.5lf\t", A[(c - col1) * rowCount + r]));
-            PRLEVEL(PR, ("\n"));
-        }
-
-        PRLEVEL(PR, ("%% lda = " LD "\n%%", rowCount));
-        PRLEVEL(PR, ("%% during lsolve x [" LD "-" LD ")is:\n%%", col1, col2));
-        // for (int64_t k = col1; k < col2; k++)
-        int64_t m = Sym->m;
-        for (int64_t k = 0; k < m; k++)
-        {
-            PRLEVEL(PR, (" %.2lf, ", x[k]));
-        }
-        PRLEVEL(PR, (" \n"));
-#endif
-
-        if (rowCount > fp)
-        {
-            PRLEVEL(2, ("%% lsolve: Working on DGEMV\n%%"));
-            PRLEVEL(2, ("fp=" LD "  rowCount=" LD "\n", fp, rowCount));
-            double alpha = 1;
-            double beta = 0;
-            SUITESPARSE_BLAS_dgemv("N", rowCount - fp, fp, &alpha, A + fp,
-                                   rowCount, x + n1 + col1, 1, &beta, work, 1,
-                                   blas_ok);
-        }
-
-        // don't use parallel loop if using dgemv
-        // pragma omp parallel for
-        for (int64_t i = fp; i < rowCount; i++)
-        {
-            // alternative to dgemv; do not need work if using this
-            // computing the inner product
-            // double i_prod = 0.0;  // inner product
-            // for (int64_t j = col1; j < col2; j++)
-            //{
-            //    i_prod += A[(j - col1) * rowCount + i] * x[j + n1];
-            //}
-
-            double i_prod = work[i - fp];
-            int64_t r = Ps[frowList[i]] + n1;
-            PRLEVEL(2, ("i_prod[" LD "]=%lf  work=%lf r=" LD "\n", i, i_prod,
-                        work[i - fp], r));
-            x[r] -= i_prod;
-        }
-    }
+    ParU_Ret info = paru_lsolve_fronts(Sym, Num, x, 1, Control);
 #ifndef NTIME
     double time = PARU_OPENMP_GET_WTIME;
     time -= start_time;
@@ -191,8 +372,7 @@ ParU_Ret ParU_Lsolve(ParU_Symbolic *Sym, ParU_Numeric *Num, double *x, ParU_Cont
     }
     PRLEVEL(1, (" \n"));
 #endif
-    paru_free(Num->max_row_count, sizeof(double), work);
-    return (blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+    return info;
 }
 
 //////////////// ParU_Lsolve ///multiple right hand side mRHS///////////////////
@@ -204,8 +384,6 @@ ParU_Ret ParU_Lsolve( ParU_Symbolic *Sym, ParU_Numeric *Num,
     PARU_DEFINE_PRLEVEL;
     if (!X) return PARU_INVALID;
     int64_t m = Sym->m;
-    int64_t nf = Sym->nf;
-    int64_t blas_ok = TRUE;
 
 #ifndef NDEBUG
     PR = 2;
@@ -244,7 +422,7 @@ ParU_Ret ParU_Lsolve( ParU_Symbolic *Sym, ParU_Numeric *Num,
             int64_t diag = Slp[j - cs1];
             PRLEVEL(PR, (" X[" LD "]=%.2lf Slx[" LD "]=%.2lf\n", j, X[j * nrhs], diag,
                          Slx[diag]));
-            // pragma omp simd
+#pragma omp simd
             for (int64_t l = 0; l < nrhs; l++)
             {
                 X[l * m + j] /= Slx[diag];
@@ -255,7 +433,7 @@ ParU_Ret ParU_Lsolve( ParU_Symbolic *Sym, ParU_Numeric *Num,
             {
                 int64_t r = Sli[p] < n1 ? Sli[p] : Ps[Sli[p] - n1] + n1;
                 PRLEVEL(PR, (" r=" LD "\n", r));
-                // pragma omp simd
+#pragma omp simd
                 for (int64_t l = 0; l < nrhs; l++)
                 {
                     X[l * m + r] -= Slx[p] * X[l * m + j];
@@ -278,92 +456,7 @@ ParU_Ret ParU_Lsolve( ParU_Symbolic *Sym, ParU_Numeric *Num,
     PRLEVEL(PR, (" \n"));
 #endif
 
-    BLAS_set_num_threads(control_nthreads (Control)) ;
-
-    // gather scatter space for dgemm
-    double *work =
-        static_cast<double*>(paru_alloc((Num->max_row_count * nrhs), sizeof(double)));
-    if (work == NULL)
-    {
-        PRLEVEL(1, ("ParU: out of memory lsolve\n"));
-        return PARU_OUT_OF_MEMORY;
-    }
-
-    ParU_Factors *LUs = Num->partial_LUs;
-    int64_t *Super = Sym->Super;
-
-    for (int64_t f = 0; f < nf; f++)
-    {
-        int64_t rowCount = Num->frowCount[f];
-        int64_t *frowList = Num->frowList[f];
-        int64_t col1 = Super[f];
-        int64_t col2 = Super[f + 1];
-        int64_t fp = col2 - col1;
-        double *A = LUs[f].p;
-        PRLEVEL(2, ("%% mRHS Working on DTRSM f=" LD "\n", f));
-        double alpha = 1;
-        SUITESPARSE_BLAS_dtrsm("L", "L", "N", "U", fp, nrhs, &alpha, A, rowCount,
-                               X + n1 + col1, m, blas_ok);
-        PRLEVEL(2, ("%% mRHS DTRSM is just finished f=" LD "\n", f));
-#ifndef NDEBUG
-        PR = 2;
-        PRLEVEL(PR, ("%% LUs:\n%%"));
-        for (int64_t r = 0; r < rowCount; r++)
-        {
-            PRLEVEL(PR, ("%% " LD "\t", frowList[r]));
-            for (int64_t c = col1; c < col2; c++)
-                PRLEVEL(PR, (" %2.5lf\t", A[(c - col1) * rowCount + r]));
-            PRLEVEL(PR, ("\n"));
-        }
-
-        PRLEVEL(PR, ("%% lda = " LD "\n%%", rowCount));
-        PR = 1;
-        PRLEVEL(PR,
-                ("%% during lsolve X f=" LD "[" LD "-" LD ")is:\n%%", f, col1, col2));
-        for (int64_t k = 0; k < m; k++)
-        {
-            PRLEVEL(1, ("%%"));
-            for (int64_t l = 0; l < nrhs; l++)
-            {
-                PRLEVEL(1, (" %.2lf, ", X[l * m + k]));
-            }
-            PRLEVEL(1, (" \n"));
-        }
-        PRLEVEL(1, (" \n"));
-#endif
-
-        if (rowCount > fp)
-        {
-            PRLEVEL(2, ("%% mRHS lsolve: Working on DGEMM\n%%"));
-            PRLEVEL(2, ("fp=" LD "  rowCount=" LD "\n", fp, rowCount));
-            double beta = 0;
-            SUITESPARSE_BLAS_dgemm("N", "N", rowCount - fp, nrhs, fp, &alpha,
-                                   A + fp, rowCount, X + n1 + col1, m, &beta,
-                                   work, rowCount - fp, blas_ok);
-        }
-
-        // don't use parallel loop if using dgemm
-        // pragma omp parallel for
-        for (int64_t i = fp; i < rowCount; i++)
-        {
-            // alternative to dgemm; do not need work if using this
-            // computing the inner product
-            // double i_prod[nrhs] = {0.0};  // inner product
-            // for (int64_t j = col1; j < col2; j++)
-            //{
-            //    for (int64_t l = 0; l < nrhs; l++)
-            //        i_prod[l] += A[(j - col1) * rowCount + i] * X[l*m +j+n1];
-            //}
-
-            // double* i_prod = work+i-fp;
-            int64_t r = Ps[frowList[i]] + n1;
-            for (int64_t l = 0; l < nrhs; l++)
-            {
-                X[l * m + r] -= work[i - fp + l * (rowCount - fp)];
-                // X[l*m+r] -= i_prod[l];
-            }
-        }
-    }
+    ParU_Ret info = paru_lsolve_fronts(Sym, Num, X, nrhs, Control);
 #ifndef NTIME
     double time = PARU_OPENMP_GET_WTIME;
     time -= start_time;
@@ -382,6 +475,5 @@ ParU_Ret ParU_Lsolve( ParU_Symbolic *Sym, ParU_Numeric *Num,
     }
     PRLEVEL(1, (" \n"));
 #endif
-    paru_free(Num->max_row_count * nrhs, sizeof(double), work);
-    return (blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+    return info;
 }
@@ -7,7 +7,7 @@
 // SPDX-License-Identifier: GNU GPL 3.0
 
 /*! @brief  computing norms: 1-norm for vectors and sparse matrix
- *  and matrix
+ *  and matrix, and the pivot growth of the factorization
  *  @author Aznaveh
  */
 #include <algorithm>
@@ -65,3 +65,50 @@ double paru_matrix_1norm(const double *x, int64_t m, int64_t n)
     PRLEVEL(1, ("matrix 1norm = %.8lf\n", norm));
     return (norm);
 }
+
+// pivot growth of the factorization: max |U| / max |S|, where S is scaled as
+// in Sx.  Singletons are not included; they are not factorized.
+double paru_pivot_growth(ParU_Symbolic *Sym, ParU_Numeric *Num,
+                         ParU_Control *Control)
+{
+    DEBUGLEVEL(0);
+    int64_t nf = Sym->nf;
+    int64_t snz = Num->snz;
+    int64_t *Super = Sym->Super;
+    ParU_Factors *LUs = Num->partial_LUs;
+    ParU_Factors *Us = Num->partial_Us;
+    double *Sx = Num->Sx;
+
+    double max_s = 0;
+    #pragma omp parallel for reduction(max:max_s) if (snz > 65536) \
+    num_threads(Control->paru_max_threads)
+    for (int64_t p = 0; p < snz; p++)
+    {
+        max_s = std::max(max_s, fabs(Sx[p]));
+    }
+
+    double max_u = 0;
+    #pragma omp parallel for reduction(max:max_u) if (nf > 64) \
+    num_threads(Control->paru_max_threads) schedule(dynamic)
+    for (int64_t f = 0; f < nf; f++)
+    {
+        int64_t rowCount = Num->frowCount[f];
+        int64_t fp = Super[f + 1] - Super[f];
+        double *X = LUs[f].p;
+        for (int64_t j = 0; j < fp; j++)
+        {
+            for (int64_t i = 0; i <= j; i++)
+            {
+                max_u = std::max(max_u, fabs(X[rowCount * j + i]));
+            }
+        }
+        int64_t unz = fp * Num->fcolCount[f];
+        double *Ux = Us[f].p;
+        for (int64_t p = 0; p < unz; p++)
+        {
+            max_u = std::max(max_u, fabs(Ux[p]));
+        }
+    }
+    PRLEVEL(1, ("max_u = %e max_s = %e\n", max_u, max_s));
+    return (max_s == 0) ? 1 : max_u / max_s;
+}
@@ -0,0 +1,639 @@
+////////////////////////////////////////////////////////////////////////////////
+//////////////////////////  ParU_Refactorize ///////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// ParU, Copyright (c) 2022, Mohsen Aznaveh and Timothy A. Davis,
+// All Rights Reserved.
+// SPDX-License-Identifier: GNU GPL 3.0
+
+/*! @brief    refactorize a matrix with the same pattern as the one that was
+ *      factorized by ParU_Factorize, reusing its pivot order
+ *
+ *      ParU_Factorize finds the rows and the non-pivotal columns of each front
+ *      while it searches for pivots, and allocates frowList, fcolList,
+ *      partial_LUs and partial_Us as it goes.  ParU_Refactorize keeps all of
+ *      them and the row permutation Ps, and computes the numerical values
+ *      again in place:
+ *
+ *      1. Sx, Sux, Slx and Rs are computed from A (paru_init_values).
+ *      2. Each entry (i,j) of S is added to the front where row i or column j
+ *         is pivotal, whichever comes first: to the pivotal columns of the
+ *         front of column j (partial_LUs), or to the U part of the front of
+ *         row i (partial_Us).
+ *      3. Each front is factorized with the pivot order of the prior
+ *         factorization (no pivot search), its U part is computed with a
+ *         TRSM and its contribution block with a DGEMM; the contribution
+ *         block is then added to later fronts in the same way as in 2.
+ *
+ *      The fronts of a task are factorized in order, and the tasks in
+ *      parallel.  The contribution block of a front goes to the fronts where
+ *      its rows and columns are pivotal, which are not always its ancestors
+ *      (see paru_task_deps), so the task tree alone does not order them.  A
+ *      task is started once all the tasks that contribute to it are done.
+ *      Tasks in different subtrees can still add to the same front at the
+ *      same time, so those updates are atomic.
+ *
+ *      ParU_Factorize does not add a row to a front if its entries in the
+ *      pivotal columns are all numerically zero, so the new values might not
+ *      fit in the pattern of the prior factorization; PARU_PATTERN_CHANGED is
+ *      returned in that case.  PARU_SINGULAR is returned if a pivot is zero,
+ *      and PARU_INVALID if A, Sym and Num do not match.  Num->growth is the
+ *      pivot growth, max |U| / max |S|; it is also computed by ParU_Factorize,
+ *      and a value much larger than the one found there means the old pivot
+ *      order is no longer stable for the new values.
+ *
+ * @author Aznaveh
+ */
+#include <algorithm>
+
+#include "paru_internal.hpp"
+
+// size of a sum of contributions, relative to the magnitude of the terms they
+// were computed from, below which it is taken as zero (see
+// paru_refactor_miss_check)
+#define PARU_REFACTOR_TOL 1e-12
+
+// a contribution v to the entry (i,j), outside the pattern of the factors;
+// the terms that v was computed from have a sum of magnitudes of at most bound
+struct paru_refactor_miss
+{
+    int64_t i, j;
+    double v, bound;
+};
+
+// workspace for ParU_Refactorize
+struct paru_refactor_work
+{
+    ParU_Symbolic *Sym;
+    ParU_Numeric *Num;
+    int64_t panel_width;
+
+    int64_t *colFront;  // size n-n1; column j of S is pivotal in colFront[j]
+
+    // The non-pivotal rows of front f are Li [Lp [f] ... Lp [f+1]-1], in
+    // ascending order, and row Li [p] is frowList [f][Lpos [p]].
+    int64_t *Lp;    // size nf+1
+    int64_t *Li;    // size Lp [nf]
+    int64_t *Lpos;  // size Lp [nf]
+
+    // contributions to entries of front t that are not in its pattern
+    std::vector<paru_refactor_miss> *Miss;  // size nf
+
+    // workspace for the contribution block of a front, of size csize for
+    // each thread; csize is enough for the largest front
+    double *C;
+    size_t csize;
+    int64_t out_of_memory;
+};
+
+//------------------------------------------------------------------------------
+// paru_refactor_row: position of row i of S in front t
+//------------------------------------------------------------------------------
+
+// returns -1 if row i is not in the front
+
+static inline int64_t paru_refactor_row(int64_t i, int64_t t,
+                                        paru_refactor_work *W)
+{
+    int64_t *Super = W->Sym->Super;
+    int64_t k = W->Num->Ps[i] - Super[t];
+    if (k < 0) return -1;  // row i is pivotal in a prior front
+    if (k < Super[t + 1] - Super[t]) return k;  // a pivotal row of front t
+    int64_t p = paru_bin_srch(W->Li, W->Lp[t], W->Lp[t + 1] - 1, i);
+    return (p < 0) ? -1 : W->Lpos[p];
+}
+
+//------------------------------------------------------------------------------
+// paru_refactor_add: add v to the entry (i,j) of the factors
+//------------------------------------------------------------------------------
+
+// If (i,j) is not in the pattern, v is kept aside in W->Miss of the front,
+// with the bound on the magnitude of its terms, to be checked by
+// paru_refactor_miss_check.
+
+static inline void paru_refactor_add(int64_t i, int64_t j, double v,
+                                     double bound, paru_refactor_work *W)
+{
+    ParU_Numeric *Num = W->Num;
+    int64_t *Super = W->Sym->Super;
+    int64_t *colFront = W->colFront;
+    int64_t ti = colFront[Num->Ps[i]];  // front where row i is pivotal
+    int64_t tj = colFront[j];           // front where column j is pivotal
+    double *X = NULL;
+    if (tj <= ti)
+    {  // in the pivotal columns of front tj
+        int64_t r = paru_refactor_row(i, tj, W);
+        if (r >= 0)
+        {
+            X = Num->partial_LUs[tj].p + (j - Super[tj]) * Num->frowCount[tj]
+                + r;
+        }
+    }
+    else
+    {  // in the U part of front ti
+        int64_t c = paru_bin_srch(Num->fcolList[ti], 0,
+                                  Num->fcolCount[ti] - 1, j);
+        if (c >= 0)
+        {
+            int64_t fp = Super[ti + 1] - Super[ti];
+            X = Num->partial_Us[ti].p + c * fp + (Num->Ps[i] - Super[ti]);
+        }
+    }
+    if (X != NULL)
+    {
+        #pragma omp atomic update
+        *X += v;
+    }
+    else if (v != 0)
+    {
+        int64_t t = std::min(ti, tj);
+        #pragma omp critical(paru_refactor_miss)
+        {
+            try
+            {
+                paru_refactor_miss miss = {i, j, v, bound};
+                W->Miss[t].push_back(miss);
+            }
+            catch (std::bad_alloc const &)
+            {
+                W->out_of_memory = 1;
+            }
+        }
+    }
+}
+
+//------------------------------------------------------------------------------
+// paru_refactor_miss_check: check the contributions outside the pattern
+//------------------------------------------------------------------------------
+
+// ParU_Factorize leaves a row out of a front if its entries in the pivotal
+// columns are exactly zero when the front is assembled; with a different
+// order of assembly these entries can be a sum of nonzero contributions that
+// cancel each other, and a single contribution from a DGEMM can itself be
+// such a sum.  The sum of the contributions to each missing entry of front f
+// must thus be zero, up to roundoff in the terms they were computed from;
+// otherwise the new values do not fit in the pattern of the prior
+// factorization.
+
+static bool paru_refactor_miss_check(int64_t f, paru_refactor_work *W)
+{
+    DEBUGLEVEL(0);
+    std::vector<paru_refactor_miss> &Miss = W->Miss[f];
+    if (Miss.empty()) return true;
+    std::sort(Miss.begin(), Miss.end(),
+              [](const paru_refactor_miss &a, const paru_refactor_miss &b)
+              -> bool { return (a.i < b.i) || (a.i == b.i && a.j < b.j); });
+    int64_t nmiss = Miss.size();
+    for (int64_t k1 = 0; k1 < nmiss;)
+    {
+        double sum = 0, sum_bound = 0;
+        int64_t k2 = k1;
+        for (; k2 < nmiss && Miss[k2].i == Miss[k1].i &&
+               Miss[k2].j == Miss[k1].j; k2++)
+        {
+            sum += Miss[k2].v;
+            sum_bound += Miss[k2].bound;
+        }
+        if (fabs(sum) > PARU_REFACTOR_TOL * sum_bound)
+        {
+            PRLEVEL(1, ("ParU: entry (" LD "," LD ") is not in front " LD "\n",
+                        Miss[k1].i, Miss[k1].j, f));
+            return false;
+        }
+        k1 = k2;
+    }
+    std::vector<paru_refactor_miss>().swap(Miss);
+    return true;
+}
+
+//------------------------------------------------------------------------------
+// paru_refactor_front: factorize front f with a fixed pivot order
+//------------------------------------------------------------------------------
+
+static ParU_Ret paru_refactor_front(int64_t f, paru_refactor_work *W)
+{
+    DEBUGLEVEL(0);
+    ParU_Numeric *Num = W->Num;
+    int64_t *Super = W->Sym->Super;
+    int64_t fp = Super[f + 1] - Super[f];
+    int64_t rowCount = Num->frowCount[f];
+    int64_t colCount = Num->fcolCount[f];
+    int64_t panel_width = W->panel_width;
+    double *F = Num->partial_LUs[f].p;
+    double *U = Num->partial_Us[f].p;
+    int64_t blas_ok = TRUE;
+    double one = 1, zero = 0, minus_one = -1;
+
+    PRLEVEL(1, ("%% refactorize front " LD ": " LD "x" LD " fp=" LD "\n", f,
+                rowCount, colCount, fp));
+
+    if (!paru_refactor_miss_check(f, W))
+    {
+        return PARU_PATTERN_CHANGED;
+    }
+
+    // blocked LU of the pivotal columns, like paru_panel_factorize, but
+    // without any pivot search: the pivots are on the diagonal
+    for (int64_t j1 = 0; j1 < fp; j1 += panel_width)
+    {
+        int64_t j2 = std::min(j1 + panel_width, fp);
+        for (int64_t j = j1; j < j2; j++)
+        {
+            double piv = F[j * rowCount + j];
+            if (piv == 0)
+            {
+                PRLEVEL(1, ("ParU: zero pivot in front " LD "\n", f));
+                #pragma omp atomic write
+                Num->res = PARU_SINGULAR;
+                return PARU_SINGULAR;
+            }
+            double *Fj = F + j * rowCount;
+            for (int64_t i = j + 1; i < rowCount; i++) Fj[i] /= piv;
+            for (int64_t c = j + 1; c < j2; c++)
+            {
+                double *Fc = F + c * rowCount;
+                double u = Fc[j];
+                if (u == 0) continue;
+                for (int64_t i = j + 1; i < rowCount; i++) Fc[i] -= Fj[i] * u;
+            }
+        }
+        if (j2 < fp)
+        {
+            SUITESPARSE_BLAS_dtrsm("L", "L", "N", "U", j2 - j1, fp - j2, &one,
+                                   F + j1 * rowCount + j1, rowCount,
+                                   F + j2 * rowCount + j1, rowCount, blas_ok);
+            SUITESPARSE_BLAS_dgemm("N", "N", rowCount - j2, fp - j2, j2 - j1,
+                                   &minus_one, F + j1 * rowCount + j2, rowCount,
+                                   F + j2 * rowCount + j1, rowCount, &one,
+                                   F + j2 * rowCount + j2, rowCount, blas_ok);
+        }
+    }
+    if (colCount == 0) return (blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+
+    // U part
+    SUITESPARSE_BLAS_dtrsm("L", "L", "N", "U", fp, colCount, &one, F,
+                           rowCount, U, fp, blas_ok);
+    if (rowCount == fp) return (blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+
+    // contribution block: C = L21 * U12, in the workspace of this thread, to
+    // be subtracted from later fronts.
+    // |C (r,c)| is computed from terms of magnitude at most
+    // Lmax [r] * Usum [c], with Lmax [r] = max |L21 (r,:)| and
+    // Usum [c] = sum |U12 (:,c)|.
+    int64_t cm = rowCount - fp;
+    double *C = W->C + PARU_OPENMP_GET_THREAD_ID * W->csize;
+    SUITESPARSE_BLAS_dgemm("N", "N", cm, colCount, fp, &one, F + fp, rowCount,
+                           U, fp, &zero, C, cm, blas_ok);
+    double *Lmax = C + cm * colCount;
+    double *Usum = Lmax + cm;
+    for (int64_t r = 0; r < cm; r++) Lmax[r] = 0;
+    for (int64_t k = 0; k < fp; k++)
+    {
+        double *Fk = F + k * rowCount + fp;
+        for (int64_t r = 0; r < cm; r++)
+        {
+            Lmax[r] = std::max(Lmax[r], fabs(Fk[r]));
+        }
+    }
+    for (int64_t c = 0; c < colCount; c++)
+    {
+        double *Uc = U + c * fp;
+        Usum[c] = 0;
+        for (int64_t k = 0; k < fp; k++) Usum[c] += fabs(Uc[k]);
+    }
+
+    int64_t *frowList = Num->frowList[f];
+    int64_t *fcolList = Num->fcolList[f];
+    for (int64_t c = 0; c < colCount; c++)
+    {
+        int64_t j = fcolList[c];
+        double *Cc = C + c * cm;
+        for (int64_t r = 0; r < cm; r++)
+        {
+            paru_refactor_add(frowList[fp + r], j, -Cc[r],
+                              Lmax[r] * Usum[c], W);
+        }
+    }
+    if (W->out_of_memory) return PARU_OUT_OF_MEMORY;
+    return (blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+}
+
+#if ! defined ( PARU_1TASK )
+
+//------------------------------------------------------------------------------
+// paru_refactor_task: refactorize the fronts of task t
+//------------------------------------------------------------------------------
+
+// The fronts of task t are factorized in order.  Then each task that waits for
+// t, listed in Dep [Depp [t] ... Depp [t+1]-1], is started if t was the last
+// task it was waiting for, as in paru_usolve_task.  The first error is
+// returned in info.
+
+static void paru_refactor_task(int64_t t, int64_t *Depp, int64_t *Dep,
+                               int64_t *num_deps, paru_refactor_work *W,
+                               ParU_Ret *info)
+{
+    ParU_Symbolic *Sym = W->Sym;
+    int64_t *task_map = Sym->task_map;
+    ParU_Ret myInfo = PARU_SUCCESS;
+    for (int64_t f = task_map[t] + 1;
+         f <= task_map[t + 1] && myInfo == PARU_SUCCESS; f++)
+    {
+        myInfo = paru_refactor_front(f, W);
+    }
+    if (myInfo != PARU_SUCCESS)
+    {
+        #pragma omp atomic write
+        *info = myInfo;
+        return;
+    }
+
+    for (int64_t p = Depp[t]; p < Depp[t + 1]; p++)
+    {
+        int64_t d = Dep[p];
+        int64_t num_rem_deps;
+        #pragma omp atomic capture
+        num_rem_deps = --num_deps[d];
+        if (num_rem_deps == 0)
+        {
+            #pragma omp task priority(Sym->task_depth[d])
+            paru_refactor_task(d, Depp, Dep, num_deps, W, info);
+        }
+    }
+}
+
+#endif
+
+//------------------------------------------------------------------------------
+// ParU_Refactorize: refactorize A with the pivot order of Num
+//------------------------------------------------------------------------------
+
+ParU_Ret ParU_Refactorize(cholmod_sparse *A, ParU_Symbolic *Sym,
+                          ParU_Numeric *Num, ParU_Control *user_Control)
+{
+    DEBUGLEVEL(0);
+    PARU_DEFINE_PRLEVEL;
+#ifndef NTIME
+    double my_start_time = PARU_OPENMP_GET_WTIME;
+#endif
+    if (A == NULL || Sym == NULL || Num == NULL)
+    {
+        return PARU_INVALID;
+    }
+
+    if (A->xtype != CHOLMOD_REAL)
+    {
+        PRLEVEL(1, ("ParU: input matrix must be real\n"));
+        return PARU_INVALID;
+    }
+
+    if ((int64_t)A->nrow != Sym->m || (int64_t)A->ncol != Sym->n ||
+        static_cast<int64_t*>(A->p)[A->ncol] != Sym->anz ||
+        Num->sym_m != Sym->m || Num->nf != Sym->nf || Num->Ps == NULL)
+    {
+        PRLEVEL(1, ("ParU: A, Sym and Num do not match\n"));
+        return PARU_INVALID;
+    }
+
+    ParU_Control my_Control = *user_Control;
+    {
+        int64_t panel_width = my_Control.panel_width;
+        if (panel_width <= 0 || panel_width > Sym->m)
+            my_Control.panel_width = 32;
+        my_Control.paru_max_threads = control_nthreads(user_Control);
+    }
+    ParU_Control *Control = &my_Control;
+
+    Num->res = PARU_SUCCESS;
+    ParU_Ret info = paru_init_values(A, Sym, Num, Control);
+    if (info != PARU_SUCCESS)
+    {
+        Num->res = info;
+        return info;
+    }
+
+    int64_t nf = Sym->nf;
+    if (nf == 0)
+    {
+        // only singletons; nothing to factorize
+        Num->growth = paru_pivot_growth(Sym, Num, Control);
+        return Num->res;
+    }
+
+    //--------------------------------------------------------------------------
+    // get the workspace
+    //--------------------------------------------------------------------------
+
+    int64_t n = Sym->n - Sym->n1;
+    int64_t m = Sym->m - Sym->n1;
+    int64_t *Super = Sym->Super;
+
+    // the fronts are factorized in parallel if the task tree is wide enough
+    bool sequential = true;
+#if ! defined ( PARU_1TASK )
+    int64_t ntasks = Sym->ntasks;
+    sequential = !paru_wide_tree(Sym, Control->paru_max_threads);
+#endif
+    int64_t nbuf = sequential ? 1 : Control->paru_max_threads;
+
+    paru_refactor_work myW;
+    paru_refactor_work *W = &myW;
+    W->Sym = Sym;
+    W->Num = Num;
+    W->panel_width = Control->panel_width;
+    W->colFront = static_cast<int64_t*>(paru_alloc(n, sizeof(int64_t)));
+    W->Lp = static_cast<int64_t*>(paru_alloc(nf + 1, sizeof(int64_t)));
+    int64_t *Lp = W->Lp;
+    int64_t lnz = 0;
+    W->csize = 0;
+    if (Lp != NULL)
+    {
+        for (int64_t f = 0; f < nf; f++)
+        {
+            int64_t fp = Super[f + 1] - Super[f];
+            int64_t cm = Num->frowCount[f] - fp;
+            int64_t colCount = Num->fcolCount[f];
+            Lp[f] = lnz;
+            lnz += cm;
+            // the contribution block, and Lmax and Usum
+            size_t csize = cm * colCount + cm + colCount;
+            W->csize = std::max(W->csize, csize);
+        }
+        Lp[nf] = lnz;
+    }
+    W->Li = static_cast<int64_t*>(paru_alloc(lnz, sizeof(int64_t)));
+    W->Lpos = static_cast<int64_t*>(paru_alloc(lnz, sizeof(int64_t)));
+    W->C = static_cast<double*>(paru_alloc(nbuf * W->csize, sizeof(double)));
+    std::vector<std::vector<paru_refactor_miss>> Miss;
+    W->out_of_memory = 0;
+    try
+    {
+        Miss.resize(nf);
+    }
+    catch (std::bad_alloc const &)
+    {
+        W->out_of_memory = 1;
+    }
+    W->Miss = Miss.data();
+    if (W->colFront == NULL || Lp == NULL ||
+        (lnz > 0 && (W->Li == NULL || W->Lpos == NULL)) ||
+        (W->csize > 0 && W->C == NULL) || W->out_of_memory)
+    {
+        PRLEVEL(1, ("ParU: out of memory, refactorize\n"));
+        paru_free(n, sizeof(int64_t), W->colFront);
+        paru_free(nf + 1, sizeof(int64_t), W->Lp);
+        paru_free(lnz, sizeof(int64_t), W->Li);
+        paru_free(lnz, sizeof(int64_t), W->Lpos);
+        paru_free(nbuf * W->csize, sizeof(double), W->C);
+        Num->res = PARU_OUT_OF_MEMORY;
+        return PARU_OUT_OF_MEMORY;
+    }
+    int64_t *colFront = W->colFront;
+    int64_t *Li = W->Li;
+    int64_t *Lpos = W->Lpos;
+
+    //--------------------------------------------------------------------------
+    // sort the non-pivotal rows of each front and clear the factors
+    //--------------------------------------------------------------------------
+
+    ParU_Factors *LUs = Num->partial_LUs;
+    ParU_Factors *Us = Num->partial_Us;
+    #pragma omp parallel for schedule(dynamic) \
+    num_threads(Control->paru_max_threads)
+    for (int64_t f = 0; f < nf; f++)
+    {
+        int64_t fp = Super[f + 1] - Super[f];
+        int64_t rowCount = Num->frowCount[f];
+        int64_t *frowList = Num->frowList[f];
+        for (int64_t j = Super[f]; j < Super[f + 1]; j++) colFront[j] = f;
+        for (int64_t p = Lp[f]; p < Lp[f + 1]; p++) Lpos[p] = fp + p - Lp[f];
+        std::sort(Lpos + Lp[f], Lpos + Lp[f + 1],
+                  [frowList](const int64_t &p1, const int64_t &p2) -> bool {
+                      return frowList[p1] < frowList[p2];
+                  });
+        for (int64_t p = Lp[f]; p < Lp[f + 1]; p++) Li[p] = frowList[Lpos[p]];
+        memset(LUs[f].p, 0, rowCount * fp * sizeof(double));
+        if (Us[f].p != NULL)
+        {
+            memset(Us[f].p, 0, fp * Num->fcolCount[f] * sizeof(double));
+        }
+    }
+
+    //--------------------------------------------------------------------------
+    // assemble S into the factors
+    //--------------------------------------------------------------------------
+
+    int64_t *Sp = Sym->Sp;
+    int64_t *Sj = Sym->Sj;
+    double *Sx = Num->Sx;
+    #pragma omp parallel for num_threads(Control->paru_max_threads) \
+    if (m > 4096)
+    for (int64_t i = 0; i < m; i++)
+    {
+        for (int64_t p = Sp[i]; p < Sp[i + 1]; p++)
+        {
+            paru_refactor_add(i, Sj[p], Sx[p], fabs(Sx[p]), W);
+        }
+    }
+    if (W->out_of_memory) info = PARU_OUT_OF_MEMORY;
+
+    //--------------------------------------------------------------------------
+    // factorize the fronts
+    //--------------------------------------------------------------------------
+
+#if ! defined ( PARU_1TASK )
+    if (info == PARU_SUCCESS && !sequential)
+    {
+        PRLEVEL(1, ("Parallel refactorization\n"));
+        // num_deps, then a copy of it that the tasks count down
+        int64_t *num_deps =
+            static_cast<int64_t*>(paru_alloc(2 * ntasks, sizeof(int64_t)));
+        int64_t *Depp =
+            static_cast<int64_t*>(paru_alloc(ntasks + 1, sizeof(int64_t)));
+        int64_t *Dep = NULL;
+        if (num_deps == NULL || Depp == NULL)
+        {
+            info = PARU_OUT_OF_MEMORY;
+        }
+        else
+        {
+            info = paru_task_deps(Sym, Num, true, num_deps, Depp, &Dep);
+        }
+        if (info == PARU_SUCCESS)
+        {
+            int64_t *task_depth = Sym->task_depth;
+            paru_memcpy(num_deps + ntasks, num_deps, ntasks * sizeof(int64_t),
+                        Control);
+            BLAS_set_num_threads(1);
+            #pragma omp parallel proc_bind(spread)                             \
+            num_threads(Control->paru_max_threads)
+            #pragma omp single nowait
+            for (int64_t t = 0; t < ntasks; t++)
+            {
+                if (num_deps[t] != 0) continue;
+                #pragma omp task priority(task_depth[t])
+                paru_refactor_task(t, Depp, Dep, num_deps + ntasks, W,
+                                   &info);
+            }
+            paru_free(Depp[ntasks], sizeof(int64_t), Dep);
+        }
+        else
+        {
+            PRLEVEL(1, ("ParU: out of memory, refactorize\n"));
+        }
+        paru_free(2 * ntasks, sizeof(int64_t), num_deps);
+        paru_free(ntasks + 1, sizeof(int64_t), Depp);
+    }
+#endif
+    if (info == PARU_SUCCESS && sequential)
+    {
+        PRLEVEL(1, ("Sequential refactorization\n"));
+        BLAS_set_num_threads(Control->paru_max_threads);
+        for (int64_t f = 0; f < nf && info == PARU_SUCCESS; f++)
+        {
+            info = paru_refactor_front(f, W);
+        }
+    }
+
+    paru_free(n, sizeof(int64_t), W->colFront);
+    paru_free(nf + 1, sizeof(int64_t), W->Lp);
+    paru_free(lnz, sizeof(int64_t), W->Li);
+    paru_free(lnz, sizeof(int64_t), W->Lpos);
+    paru_free(nbuf * W->csize, sizeof(double), W->C);
+    if (info != PARU_SUCCESS)
+    {
+        Num->res = info;
+        return info;
+    }
+
+    //--------------------------------------------------------------------------
+    // diagonal of U and pivot growth
+    //--------------------------------------------------------------------------
+
+    double min_udiag = fabs(*(LUs[0].p));
+    double max_udiag = min_udiag;
+    for (int64_t f = 0; f < nf; f++)
+    {
+        int64_t rowCount = Num->frowCount[f];
+        int64_t fp = Super[f + 1] - Super[f];
+        double *X = LUs[f].p;
+        for (int64_t i = 0; i < fp; i++)
+        {
+            double udiag = fabs(X[rowCount * i + i]);
+            min_udiag = std::min(min_udiag, udiag);
+            max_udiag = std::max(max_udiag, udiag);
+        }
+    }
+    Num->min_udiag = min_udiag;
+    Num->max_udiag = max_udiag;
+    Num->rcond = min_udiag / max_udiag;
+    Num->growth = paru_pivot_growth(Sym, Num, Control);
+    PRLEVEL(1, ("max_udiag=%e min_udiag=%e rcond=%e growth=%e\n", max_udiag,
+                min_udiag, Num->rcond, Num->growth));
+#ifndef NTIME
+    double time = PARU_OPENMP_GET_WTIME;
+    time -= my_start_time;
+    PRLEVEL(1, ("refactorization time took is %lf\n", time));
+#endif
+    return Num->res;
+}
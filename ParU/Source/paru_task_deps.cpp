@@ -0,0 +1,158 @@
+////////////////////////////////////////////////////////////////////////////////
+//////////////////////////  paru_task_deps ////////////////////////////////////
+////////////////////////////////////////////////////////////////////////////////
+
+// ParU, Copyright (c) 2022, Mohsen Aznaveh and Timothy A. Davis,
+// All Rights Reserved.
+// SPDX-License-Identifier: GNU GPL 3.0
+
+/*! @brief  the dependencies between the tasks of the task tree, found from
+ *          the pattern of the factors
+ *
+ *      The columns of the U part of a front f (fcolList) and the rows below
+ *      its pivots are pivotal in later fronts.  Those are mostly ancestors of
+ *      f, but not always: once all the rows that a column shares with a
+ *      front are pivotal, the column is not assembled into the ancestors any
+ *      more, and it can be pivotal in another subtree (bfwa62, west0497 and
+ *      adder_dcop_05 have such columns).  So the task tree alone does not
+ *      order the work on the fronts; the edges here do.
+ *
+ *      A task t touches a task ot != t if a front of t has a column of its U
+ *      part, or (if forward) a row below its pivots, that is pivotal in a
+ *      front of ot.  Since these are pivotal after the fronts of t, ot > t,
+ *      and the dependencies form a DAG.
+ *
+ *      If forward is false (usolve), t has to wait for the tasks it touches:
+ *      it reads X at its U columns.  If forward is true (refactorization), the
+ *      tasks that t touches have to wait for t: its contribution block is
+ *      added to the fronts where its rows and columns are pivotal.  lsolve
+ *      also uses forward: it updates X at the rows below the pivots of t.
+ *      The edges from the U columns are not needed there, but they are few
+ *      (those columns are mostly pivotal in the ancestors of t anyway).
+ *
+ *      On output, num_deps [t] is the number of tasks that t has to wait for,
+ *      and the tasks that wait for t are Dep [Depp [t] ... Depp [t+1]-1].
+ *      Dep is allocated here, of size Depp [ntasks].
+ *
+ * @author Aznaveh
+ */
+#include "paru_internal.hpp"
+
+ParU_Ret paru_task_deps(ParU_Symbolic *Sym, ParU_Numeric *Num, bool forward,
+                        int64_t *num_deps, int64_t *Depp, int64_t **Dep_handle)
+{
+    DEBUGLEVEL(0);
+    int64_t nf = Sym->nf;
+    int64_t ntasks = Sym->ntasks;
+    int64_t *task_map = Sym->task_map;
+    int64_t *Super = Sym->Super;
+    int64_t *Ps = Num->Ps;
+    int64_t ncols = Super[nf];
+    *Dep_handle = NULL;
+
+    int64_t *colTask =
+        static_cast<int64_t*>(paru_alloc(ncols, sizeof(int64_t)));
+    int64_t *mark = static_cast<int64_t*>(paru_alloc(ntasks, sizeof(int64_t)));
+    if (colTask == NULL || mark == NULL)
+    {
+        paru_free(ncols, sizeof(int64_t), colTask);
+        paru_free(ntasks, sizeof(int64_t), mark);
+        return PARU_OUT_OF_MEMORY;
+    }
+    for (int64_t t = 0; t < ntasks; t++)
+    {
+        for (int64_t c = Super[task_map[t] + 1]; c < Super[task_map[t + 1] + 1];
+             c++)
+        {
+            colTask[c] = t;
+        }
+    }
+
+    // count the dependencies, then list them
+    for (int64_t t = 0; t < ntasks; t++)
+    {
+        num_deps[t] = 0;
+        Depp[t] = 0;
+    }
+    Depp[ntasks] = 0;
+    int64_t *Dep = NULL;
+    for (int64_t pass = 0; pass < 2; pass++)
+    {
+        if (pass == 1)
+        {
+            for (int64_t t = 0; t < ntasks; t++)
+            {
+                Depp[t + 1] += Depp[t];
+            }
+            int64_t ndeps = Depp[ntasks];
+            Dep = static_cast<int64_t*>(paru_alloc(ndeps, sizeof(int64_t)));
+            if (ndeps > 0 && Dep == NULL)
+            {
+                paru_free(ncols, sizeof(int64_t), colTask);
+                paru_free(ntasks, sizeof(int64_t), mark);
+                return PARU_OUT_OF_MEMORY;
+            }
+        }
+        for (int64_t t = 0; t < ntasks; t++)
+        {
+            mark[t] = -1;
+        }
+        for (int64_t t = ntasks - 1; t >= 0; t--)
+        {
+            for (int64_t f = task_map[t] + 1; f <= task_map[t + 1]; f++)
+            {
+                int64_t fp = Super[f + 1] - Super[f];
+                int64_t colCount = Num->fcolCount[f];
+                int64_t rowCount = forward ? Num->frowCount[f] - fp : 0;
+                int64_t *fcolList = Num->fcolList[f];
+                int64_t *frowList = Num->frowList[f] + fp;
+                for (int64_t k = 0; k < colCount + rowCount; k++)
+                {
+                    int64_t c = (k < colCount) ? fcolList[k]
+                                               : Ps[frowList[k - colCount]];
+                    int64_t ot = colTask[c];
+                    ASSERT(ot >= t);
+                    if (ot == t || mark[ot] == t) continue;
+                    mark[ot] = t;
+                    // the task that waits, and the one it waits for
+                    int64_t waits = forward ? ot : t;
+                    int64_t first = forward ? t : ot;
+                    if (pass == 0)
+                    {
+                        num_deps[waits]++;
+                        Depp[first]++;
+                    }
+                    else
+                    {
+                        Dep[--Depp[first]] = waits;
+                    }
+                }
+            }
+        }
+    }
+    // Depp [t] is now the start of the tasks that wait for t
+
+    paru_free(ncols, sizeof(int64_t), colTask);
+    paru_free(ntasks, sizeof(int64_t), mark);
+    *Dep_handle = Dep;
+    return PARU_SUCCESS;
+}
+
+//------------------------------------------------------------------------------
+// paru_wide_tree: true if the task tree is worth working on in parallel
+//------------------------------------------------------------------------------
+
+// The tasks that are not on the path to the root can only run in parallel if
+// the tree has enough leaves to keep the threads busy.  Otherwise the fronts
+// are done one at a time, with a multithreaded BLAS.
+
+bool paru_wide_tree(ParU_Symbolic *Sym, int64_t nthreads)
+{
+    int64_t ntasks = Sym->ntasks;
+    int64_t nleaves = 0;
+    for (int64_t t = 0; t < ntasks; t++)
+    {
+        if (Sym->task_num_child[t] == 0) nleaves++;
+    }
+    return (nleaves * 2 > nthreads);
+}
@@ -30,101 +30,295 @@
  *        does a TRSV on triangular part  Then does DGEMV on the rest
  *       for nf down to 0
  *
- *              BLAS_DTRSV  is used here but I do not use BLAS_DGEMV explicitly
- *              while it needs space for each thread doing this computation.
- *              I guess using this way can have a good performance.
+ *        The columns of X are done in blocks of PARU_SOLVE_BLOCK, with a
+ *        DGEMM and a DTRSM on each block (DGEMV and DTRSV for a single
+ *        column).
+ *
+ *        The fronts are done in parallel if the task tree is wide enough: a
+ *        task is started once all the tasks where its U columns are pivotal
+ *        are done (see paru_task_deps).  A front only writes X at its own
+ *        pivot rows, so no atomics are needed.  Otherwise, if there are
+ *        several blocks of columns, the blocks are done in parallel.
+ *        Otherwise the fronts are done one at a time with a multithreaded
+ *        BLAS.
  *
  * @author Aznaveh
  * */
 
 #include "paru_internal.hpp"
 
-ParU_Ret ParU_Usolve(ParU_Symbolic *Sym, ParU_Numeric *Num,
-    double *x, ParU_Control *Control)
+//------------------------------------------------------------------------------
+// paru_usolve_front: X = U\X for the pivot rows of front f
+//------------------------------------------------------------------------------
+
+// X is a block of nrhs columns, with leading dimension m.  Returns FALSE if an
+// integer is too large for the BLAS.
+
+static int64_t paru_usolve_front(int64_t f, ParU_Symbolic *Sym,
+                                 ParU_Numeric *Num, double *X, int64_t nrhs,
+                                 double *work)
 {
     DEBUGLEVEL(0);
-    // check if input is read
-    if (!x) return PARU_INVALID;
     int64_t blas_ok = TRUE;
-    PARU_DEFINE_PRLEVEL;
-#ifndef NTIME
-    double start_time = PARU_OPENMP_GET_WTIME;
+    int64_t m = Sym->m;
+    int64_t n1 = Sym->n1;
+    int64_t *Ps = Num->Ps;
+    int64_t *frowList = Num->frowList[f];
+    int64_t *fcolList = Num->fcolList[f];
+    int64_t col1 = Sym->Super[f];
+    int64_t col2 = Sym->Super[f + 1];
+    int64_t fp = col2 - col1;
+    int64_t colCount = Num->fcolCount[f];
+    double alpha = 1;
+
+    // do dgemm
+    // performed on Us
+    // I am not calling BLAS_DGEMM on X while the column permutation is
+    // different; X is gathered in Xg
+    double *A2 = Num->partial_Us[f].p;
+    if (A2 != NULL)
+    {
+        PRLEVEL(2, ("%% usolve: Working on DGEMM f=" LD "\n%%", f));
+        double *Xg = work + fp * nrhs;          // size Xg is colCount x nrhs
+        for (int64_t j = 0; j < colCount; j++)  // gathering X in Xg
+        {
+            for (int64_t l = 0; l < nrhs; l++)
+            {
+                Xg[l * colCount + j] = X[l * m + fcolList[j] + n1];
+            }
+        }
+
+        double beta = 0;
+        if (nrhs == 1)
+        {
+            SUITESPARSE_BLAS_dgemv("N", fp, colCount, &alpha, A2, fp, Xg, 1,
+                                   &beta, work, 1, blas_ok);
+        }
+        else
+        {
+            SUITESPARSE_BLAS_dgemm("N", "N", fp, nrhs, colCount, &alpha, A2,
+                                   fp, Xg, colCount, &beta, work, fp, blas_ok);
+        }
+
+        for (int64_t i = 0; i < fp; i++)  // scattering the back in to X
+        {
+            int64_t r = Ps[frowList[i]] + n1;
+            for (int64_t l = 0; l < nrhs; l++)
+            {
+                X[l * m + r] -= work[l * fp + i];
+            }
+        }
+    }
+
+    PRLEVEL(2, ("%% usolve: Working on DTRSM f=" LD "\n", f));
+    int64_t rowCount = Num->frowCount[f];
+    double *A1 = Num->partial_LUs[f].p;
+    if (nrhs == 1)
+    {
+        SUITESPARSE_BLAS_dtrsv("U", "N", "N", fp, A1, rowCount, X + n1 + col1,
+                               1, blas_ok);
+    }
+    else
+    {
+        SUITESPARSE_BLAS_dtrsm("L", "U", "N", "N", fp, nrhs, &alpha, A1,
+                               rowCount, X + n1 + col1, m, blas_ok);
+    }
+    return blas_ok;
+}
+
+#if ! defined ( PARU_1TASK )
+
+//------------------------------------------------------------------------------
+// paru_usolve_task: X = U\X for the fronts of task t
+//------------------------------------------------------------------------------
+
+// The fronts of task t are done in reverse order, on all the blocks of columns
+// of X.  Then each task that waits for t, listed in Dep [Depp [t] ...
+// Depp [t+1]-1], is started if t was the last task it was waiting for.
+
+static void paru_usolve_task(int64_t t, int64_t *Depp, int64_t *Dep,
+                             int64_t *num_deps, paru_solve_work *W)
+{
+    ParU_Symbolic *Sym = W->Sym;
+    int64_t *task_map = Sym->task_map;
+    int64_t m = Sym->m;
+    int64_t nrhs = W->nrhs;
+    double *work = W->work + PARU_OPENMP_GET_THREAD_ID * W->wsize;
+    int64_t blas_ok = TRUE;
+    for (int64_t f = task_map[t + 1]; f > task_map[t]; f--)
+    {
+        for (int64_t k = 0; k < nrhs; k += PARU_SOLVE_BLOCK)
+        {
+            int64_t nb = std::min(nrhs - k, (int64_t)PARU_SOLVE_BLOCK);
+            blas_ok = paru_usolve_front(f, Sym, W->Num, W->X + k * m, nb,
+                                        work) && blas_ok;
+        }
+    }
+    if (!blas_ok)
+    {
+        #pragma omp atomic write
+        W->blas_ok = FALSE;
+    }
+
+    for (int64_t p = Depp[t]; p < Depp[t + 1]; p++)
+    {
+        int64_t d = Dep[p];
+        int64_t num_rem_deps;
+        #pragma omp atomic capture
+        num_rem_deps = --num_deps[d];
+        if (num_rem_deps == 0)
+        {
+            #pragma omp task
+            paru_usolve_task(d, Depp, Dep, num_deps, W);
+        }
+    }
+}
+
 #endif
-    int64_t nf = Sym->nf;
 
-    int64_t n1 = Sym->n1;   // row+col singletons
-    int64_t *Ps = Num->Ps;  // row permutation
+//------------------------------------------------------------------------------
+// paru_usolve_fronts: X = U\X for all the fronts
+//------------------------------------------------------------------------------
 
-    ParU_Factors *LUs = Num->partial_LUs;
-    ParU_Factors *Us = Num->partial_Us;
-    int64_t *Super = Sym->Super;
+static ParU_Ret paru_usolve_fronts(ParU_Symbolic *Sym, ParU_Numeric *Num,
+                                   double *X, int64_t nrhs,
+                                   ParU_Control *Control)
+{
+    DEBUGLEVEL(0);
+    int64_t nf = Sym->nf;
+    if (nf == 0 || nrhs <= 0) return PARU_SUCCESS;
+    int64_t m = Sym->m;
+    int32_t nthreads = control_nthreads(Control);
+    int64_t nb = std::min(nrhs, (int64_t)PARU_SOLVE_BLOCK);
+    int64_t nblocks = (nrhs + nb - 1) / nb;
 
-    BLAS_set_num_threads(control_nthreads (Control)) ;
-    double *work = static_cast<double*>(paru_alloc((Num->max_col_count), sizeof(double)));
-    if (work == NULL)
+    bool tree = false;
+#if ! defined ( PARU_1TASK )
+    tree = paru_wide_tree(Sym, nthreads);
+#endif
+    bool parallel = (nthreads > 1) && (tree || nblocks > 1);
+
+    // gather scatter space for dgemm, for each thread
+    paru_solve_work myW;
+    paru_solve_work *W = &myW;
+    W->Sym = Sym;
+    W->Num = Num;
+    W->X = X;
+    W->nrhs = nrhs;
+    W->wsize = Num->max_col_count * nb;
+    W->blas_ok = TRUE;
+    int64_t nwork = parallel ? nthreads : 1;
+    W->work =
+        static_cast<double*>(paru_alloc(nwork * W->wsize, sizeof(double)));
+    if (W->work == NULL)
     {
         PRLEVEL(1, ("ParU: out of memory usolve\n"));
         return PARU_OUT_OF_MEMORY;
     }
 
-    for (int64_t f = nf - 1; f >= 0; --f)
+    ParU_Ret info = PARU_SUCCESS;
+    if (!parallel)
     {
-        int64_t *frowList = Num->frowList[f];
-        int64_t *fcolList = Num->fcolList[f];
-        int64_t col1 = Super[f];
-        int64_t col2 = Super[f + 1];
-        int64_t fp = col2 - col1;
-        int64_t colCount = Num->fcolCount[f];
-
-        // do dgemv
-        // performed on Us
-        // I am not calling BLAS_DGEMV while the column permutation is different
-
-        double *A2 = Us[f].p;
-        if (A2 != NULL)
+        BLAS_set_num_threads(nthreads);
+        for (int64_t k = 0; k < nrhs; k += nb)
         {
-            PRLEVEL(2, ("%% usolve: Working on DGEMV\n%%"));
-
-            double *xg = &work[0] + fp;         // size Xg is colCount
-            for (int64_t j = 0; j < colCount; j++)  // gathering x in Xg
+            int64_t nk = std::min(nrhs - k, nb);
+            for (int64_t f = nf - 1; f >= 0; --f)
             {
-                xg[j] = x[fcolList[j] + n1];
+                W->blas_ok = paru_usolve_front(f, Sym, Num, X + k * m, nk,
+                                               W->work) && W->blas_ok;
             }
-            double alpha = 1;
-            double beta = 0;
-            SUITESPARSE_BLAS_dgemv("N", fp, colCount, &alpha, A2, fp, xg, 1,
-                                   &beta, work, 1, blas_ok);
-
-            for (int64_t i = 0; i < fp; i++)  // scattering the back in to x
+        }
+    }
+#if ! defined ( PARU_1TASK )
+    else if (tree)
+    {
+        PRLEVEL(1, ("%% Parallel usolve on the task tree\n"));
+        int64_t ntasks = Sym->ntasks;
+        // num_deps, then a copy of it that the tasks count down
+        int64_t *num_deps =
+            static_cast<int64_t*>(paru_alloc(2 * ntasks, sizeof(int64_t)));
+        int64_t *Depp =
+            static_cast<int64_t*>(paru_alloc(ntasks + 1, sizeof(int64_t)));
+        int64_t *Dep = NULL;
+        if (num_deps == NULL || Depp == NULL)
+        {
+            info = PARU_OUT_OF_MEMORY;
+        }
+        else
+        {
+            info = paru_task_deps(Sym, Num, false, num_deps, Depp, &Dep);
+        }
+        if (info == PARU_SUCCESS)
+        {
+            paru_memcpy(num_deps + ntasks, num_deps, ntasks * sizeof(int64_t),
+                        Control);
+            // start the tasks with no dependencies, from the root down
+            BLAS_set_num_threads(1);
+            #pragma omp parallel proc_bind(spread) num_threads(nthreads)
+            #pragma omp single nowait
+            for (int64_t t = ntasks - 1; t >= 0; t--)
             {
-                int64_t r = Ps[frowList[i]] + n1;
-                x[r] -= work[i];
+                if (num_deps[t] != 0) continue;
+                #pragma omp task
+                paru_usolve_task(t, Depp, Dep, num_deps + ntasks, W);
+            }
+            paru_free(Depp[ntasks], sizeof(int64_t), Dep);
+        }
+        else
+        {
+            PRLEVEL(1, ("ParU: out of memory usolve\n"));
+        }
+        paru_free(2 * ntasks, sizeof(int64_t), num_deps);
+        paru_free(ntasks + 1, sizeof(int64_t), Depp);
+    }
+#endif
+    else
+    {
+        // the blocks of columns of X are independent
+        PRLEVEL(1, ("%% Parallel usolve on " LD " blocks of X\n", nblocks));
+        BLAS_set_num_threads(1);
+        #pragma omp parallel for schedule(dynamic) num_threads(nthreads)
+        for (int64_t b = 0; b < nblocks; b++)
+        {
+            int64_t k = b * nb;
+            int64_t nk = std::min(nrhs - k, nb);
+            double *work = W->work + PARU_OPENMP_GET_THREAD_ID * W->wsize;
+            int64_t blas_ok = TRUE;
+            for (int64_t f = nf - 1; f >= 0; --f)
+            {
+                blas_ok = paru_usolve_front(f, Sym, Num, X + k * m, nk, work)
+                          && blas_ok;
+            }
+            if (!blas_ok)
+            {
+                #pragma omp atomic write
+                W->blas_ok = FALSE;
             }
-
-            // pragma omp parallel for
-            // for (int64_t i = 0; i < fp; i++)
-            //{
-            //    PRLEVEL(2, ("%% Usolve: Working on DGEMV\n"));
-            //    // computing the inner product
-            //    double i_prod = 0.0;  // innter product
-            //    for (int64_t j = 0; j < colCount; j++)
-            //    {
-            //        i_prod += A2[fp * j + i] * x[fcolList[j] + n1];
-            //    }
-            //    int64_t r = Ps[frowList[i]] + n1;
-            //    PRLEVEL(2, ("i_prod[" LD "]=%lf  r=" LD "\n", i, i_prod,  r));
-            //    x[r] -= i_prod;
-            //}
         }
+    }
 
-        int64_t rowCount = Num->frowCount[f];
+    paru_free(nwork * W->wsize, sizeof(double), W->work);
+    if (info != PARU_SUCCESS) return info;
+    return (W->blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+}
 
-        double *A1 = LUs[f].p;
-        PRLEVEL(2, ("%% Usolve: Working on DTRSV\n"));
-        SUITESPARSE_BLAS_dtrsv("U", "N", "N", fp, A1, rowCount, x + col1 + n1,
-                               1, blas_ok);
-        PRLEVEL(2, ("%% DTRSV is just finished\n"));
-    }
+//------------------------------------------------------------------------------
+// ParU_Usolve: x = U\x
+//------------------------------------------------------------------------------
+
+ParU_Ret ParU_Usolve(ParU_Symbolic *Sym, ParU_Numeric *Num,
+    double *x, ParU_Control *Control)
+{
+    DEBUGLEVEL(0);
+    // check if input is read
+    if (!x) return PARU_INVALID;
+    PARU_DEFINE_PRLEVEL;
+#ifndef NTIME
+    double start_time = PARU_OPENMP_GET_WTIME;
+#endif
+    ParU_Ret info = paru_usolve_fronts(Sym, Num, x, 1, Control);
+    if (info != PARU_SUCCESS) return info;
 
 #ifndef NDEBUG
     int64_t m = Sym->m;
@@ -175,8 +369,7 @@ ParU_Ret ParU_Usolve(ParU_Symbolic *Sym, ParU_Numeric *Num,
     }
     PRLEVEL(1, (" \n"));
 #endif
-    paru_free(Num->max_col_count, sizeof(double), work);
-    return (blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+    return PARU_SUCCESS;
 }
 
 //////////////// ParU_Usolve ///multiple right hand side mRHS///////////////////
@@ -186,10 +379,8 @@ ParU_Ret ParU_Usolve(ParU_Symbolic *Sym, ParU_Numeric *Num,
     DEBUGLEVEL(0);
     // check if input is read
     if (!X) return PARU_INVALID;
-    int64_t blas_ok = TRUE;
     PARU_DEFINE_PRLEVEL;
     int64_t m = Sym->m;
-    int64_t nf = Sym->nf;
 #ifndef NDEBUG
     PRLEVEL(1, ("%% mRHS inside USolve X is:\n"));
     for (int64_t k = 0; k < m; k++)
@@ -206,91 +397,8 @@ ParU_Ret ParU_Usolve(ParU_Symbolic *Sym, ParU_Numeric *Num,
 #ifndef NTIME
     double start_time = PARU_OPENMP_GET_WTIME;
 #endif
-    int64_t n1 = Sym->n1;   // row+col singletons
-    int64_t *Ps = Num->Ps;  // row permutation
-
-    ParU_Factors *LUs = Num->partial_LUs;
-    ParU_Factors *Us = Num->partial_Us;
-    int64_t *Super = Sym->Super;
-
-    BLAS_set_num_threads(control_nthreads (Control)) ;
-    double *work =
-        static_cast<double*>(paru_alloc((Num->max_col_count * nrhs), sizeof(double)));
-    if (work == NULL)
-    {
-        PRLEVEL(1, ("ParU: out of memory Usolve\n"));
-        return PARU_OUT_OF_MEMORY;
-    }
-
-    for (int64_t f = nf - 1; f >= 0; --f)
-    {
-        int64_t *frowList = Num->frowList[f];
-        int64_t *fcolList = Num->fcolList[f];
-        int64_t col1 = Super[f];
-        int64_t col2 = Super[f + 1];
-        int64_t fp = col2 - col1;
-        int64_t colCount = Num->fcolCount[f];
-
-        // do dgemm
-        // performed on Us
-
-        double *A2 = Us[f].p;
-        if (A2 != NULL)
-        {
-            PRLEVEL(2, ("%% mRHS usolve: Working on DGEMM f=" LD "\n%%", f));
-            double *Xg = &work[0] + fp * nrhs;     // size Xg is colCount x nrhs
-            for (int64_t j = 0; j < colCount; j++)  // gathering X in Xg
-            {
-                for (int64_t l = 0; l < nrhs; l++)
-                {
-                    Xg[l * colCount + j] = X[l * m + fcolList[j] + n1];
-                }
-            }
-
-            double alpha = 1;
-            double beta = 0;
-            SUITESPARSE_BLAS_dgemm("N", "N", fp, nrhs, colCount, &alpha, A2, fp,
-                                   Xg, colCount, &beta, work, fp, blas_ok);
-
-            for (int64_t i = 0; i < fp; i++)  // scattering the back in to X
-            {
-                int64_t r = Ps[frowList[i]] + n1;
-                for (int64_t l = 0; l < nrhs; l++)
-                {
-                    X[l * m + r] -= work[l * fp + i];
-                }
-            }
-
-            // algternative way for dgemm
-            // pragma omp parallel for schedule(static)
-            // for (int64_t i = 0; i < fp; i++)
-            //{
-            //    // computing the inner product
-            //    double i_prod[nrhs] = {0.0};  // inner product
-            //    for (int64_t j = 0; j < colCount; j++)
-            //    {
-            //        for (int64_t l = 0; l < nrhs; l++)
-            //            i_prod[l] += A2[fp * j + i] * X[l*m + fcolList[j] +
-            //            n1];
-            //    }
-            //    int64_t r = Ps[frowList[i]] + n1;
-            //    for (int64_t l = 0; l < nrhs; l++)
-            //    {
-            //        PRLEVEL(2, ("i_prod[" LD "]=%lf  r=" LD "\nrhs", i, i_prod[i], r));
-            //        X[l*m+r] -= i_prod[l];
-            //    }
-            //}
-        }
-
-        int64_t rowCount = Num->frowCount[f];
-
-        PRLEVEL(2, ("%% mRHS Usolve: Working on DTRSM\n"));
-        double *A1 = LUs[f].p;
-        double alpha = 1;
-        SUITESPARSE_BLAS_dtrsm("L", "U", "N", "N", fp, nrhs, &alpha, A1, rowCount,
-                               X + n1 + col1, m, blas_ok);
-        PRLEVEL(2, ("%% mRHS DTRSM is just finished\n"));
-    }
+    ParU_Ret info = paru_usolve_fronts(Sym, Num, X, nrhs, Control);
+    if (info != PARU_SUCCESS) return info;
 
     PRLEVEL(1, ("%% mRHS Usolve working on singletons \n"));
     int64_t cs1 = Sym->cs1;
@@ -339,6 +447,5 @@ ParU_Ret ParU_Usolve(ParU_Symbolic *Sym, ParU_Numeric *Num,
     }
     PRLEVEL(1, (" \n"));
 #endif
-    paru_free(Num->max_col_count * nrhs, sizeof(double), work);
-    return (blas_ok ? PARU_SUCCESS : PARU_TOO_LARGE);
+    return PARU_SUCCESS;
 }
@@ -247,6 +247,159 @@ int main(int argc, char **argv)
     printf("mRhs Residual is |%.2e|\n", resid);
     TEST_ASSERT (resid == 0 || log10 (resid) <= expected_log10_resid) ;
 
+    //~~~~~~~~~~~~~~~~~~~Wide mRHS, on 1 and on 4 threads~~~~~~~~~~~~~~~~~~~~~~
+    // nrhs2 is more than two blocks of PARU_SOLVE_BLOCK columns, with a
+    // partial block at the end.  On 4 threads the solve is done on the task
+    // tree if it is wide enough, or else on the blocks of columns in parallel;
+    // on 1 thread it is sequential.  Both must solve A*X=B.
+
+    free(B);
+    free(X);
+    const int64_t nrhs2 = 2 * PARU_SOLVE_BLOCK + 5;
+    B = (double *)malloc(m * nrhs2 * sizeof(double));
+    X = (double *)malloc(m * nrhs2 * sizeof(double));
+    TEST_ASSERT (B != NULL && X != NULL) ;
+    for (int64_t i = 0; i < m; ++i)
+    {
+        for (int64_t j = 0; j < nrhs2; ++j)
+        {
+            B[j * m + i] = (double)((i * (j + 1)) % 7 + 1);
+        }
+    }
+    int max_threads = omp_get_max_threads();
+    for (int32_t nthreads = 1; nthreads <= 4; nthreads += 3)
+    {
+        Control.paru_max_threads = nthreads;
+        omp_set_num_threads (nthreads);
+        info = ParU_Solve(Sym, Num, nrhs2, B, X, &Control);
+        omp_set_num_threads (max_threads);
+        TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+        info = ParU_Residual(A, X, B, m, nrhs2, resid, anorm, xnorm, &Control);
+        TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+        resid = (anorm == 0 || xnorm == 0 ) ? 0 : (resid/(anorm*xnorm));
+        printf("Wide mRhs Residual on %d threads is |%.2e|\n", nthreads, resid);
+        TEST_ASSERT (resid == 0 || log10 (resid) <= expected_log10_resid) ;
+    }
+
+    //~~~~~~~~~~~~~~~~~~~One rhs, on the task tree~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+    // With one column of X there is a single block of columns, so on 2
+    // threads the solve is done on the task tree if the tree has at least 2
+    // leaves, and sequentially otherwise.  Both must solve A*x=b, and give the
+    // same x up to rounding (updates from different tasks to one front of X
+    // can be added in any order).
+
+    int64_t nleaves = 0;
+    for (int64_t t = 0; t < Sym->ntasks; t++)
+    {
+        if (Sym->task_num_child[t] == 0) nleaves++;
+    }
+    printf("task tree: " LD " tasks, " LD " leaves, tree solve %d\n",
+        Sym->ntasks, nleaves, (int) paru_wide_tree(Sym, 2));
+    for (int32_t nthreads = 1; nthreads <= 2; nthreads++)
+    {
+        for (int64_t i = 0; i < m; ++i)
+        {
+            B[i] = (double)(i % 5 + 1);
+        }
+        Control.paru_max_threads = nthreads;
+        omp_set_num_threads (nthreads);
+        info = ParU_Solve(Sym, Num, 1, B, X + (nthreads - 1) * m, &Control);
+        omp_set_num_threads (max_threads);
+        TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+        info = ParU_Residual(A, X + (nthreads - 1) * m, B, m, 1, resid, anorm,
+            xnorm, &Control);
+        TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+        resid = (anorm == 0 || xnorm == 0 ) ? 0 : (resid/(anorm*xnorm));
+        printf("One rhs Residual on %d threads is |%.2e|\n", nthreads, resid);
+        TEST_ASSERT (resid == 0 || log10 (resid) <= expected_log10_resid) ;
+    }
+    double xdiff = 0, xmax = 0;
+    for (int64_t i = 0; i < m; ++i)
+    {
+        xdiff = std::max(xdiff, fabs(X[i] - X[m + i]));
+        xmax = std::max(xmax, fabs(X[i]));
+    }
+    printf("One rhs difference between 1 and 2 threads |%.2e|\n",
+        (xmax == 0) ? 0 : xdiff / xmax);
+    TEST_ASSERT (xdiff <= 1e-8 * xmax) ;
+    Control.paru_max_threads = 4;
+
+    //~~~~~~~~~~~~~~~~~~~Refactorize, against a fresh factorization~~~~~~~~~~~~
+    // Scale the rows and columns of A, refactorize it with the pivot order
+    // of Num, and factorize it again from scratch.  Both must solve A*x=b to
+    // the same accuracy.  The scale factors are powers of 2, so the entries
+    // that cancel exactly in the factors of A still do, and the new values
+    // fit in the pattern of Num.  The refactorization runs on 4 threads, as
+    // set in Control, even on a smaller machine.
+
+    info = ParU_Refactorize(NULL, Sym, Num, &Control);  // for coverage
+    TEST_ASSERT_INFO (info == PARU_INVALID, info) ;
+
+    int64_t *Ap = (int64_t *)A->p;
+    int64_t *Ai = (int64_t *)A->i;
+    double *Ax = (double *)A->x;
+    for (int64_t j = 0; j < (int64_t) A->ncol; j++)
+    {
+        for (int64_t p = Ap[j]; p < Ap[j + 1]; p++)
+        {
+            Ax[p] = ldexp (Ax[p], (int) (j % 3) - 1 + (int) (Ai[p] % 2));
+        }
+    }
+
+    omp_set_num_threads (Control.paru_max_threads);
+    info = ParU_Refactorize(A, Sym, Num, &Control);
+    omp_set_num_threads (max_threads);
+    TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+    ParU_Numeric *Num2 = NULL;
+    info = ParU_Factorize(A, Sym, &Num2, &Control);
+    TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+
+    b = (double *)malloc(m * sizeof(double));
+    xx = (double *)malloc(m * sizeof(double));
+    TEST_ASSERT (b != NULL && xx != NULL) ;
+    for (int64_t i = 0; i < m; ++i) b[i] = i + 1;
+    for (int64_t k = 0; k < 2; k++)
+    {
+        info = ParU_Solve(Sym, (k == 0) ? Num : Num2, b, xx, &Control);
+        TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+        info = ParU_Residual(A, xx, b, m, resid, anorm, xnorm, &Control);
+        TEST_ASSERT_INFO (info == PARU_SUCCESS, info) ;
+        resid = (anorm == 0 || xnorm == 0 ) ? 0 : (resid/(anorm*xnorm));
+        printf("%s Residual is |%.2e|\n", (k == 0) ? "Refactorize" : "Fresh",
+            resid);
+        TEST_ASSERT (resid == 0 || log10 (resid) <= expected_log10_resid) ;
+    }
+    ParU_Freenum(&Num2, &Control);
+
+    //~~~~~~~~~~~~~~~~~~~Refactorize, with values outside the old pattern~~~~~~
+    // Factorize A with one entry set to zero, then refactorize it with the
+    // entry restored.  ParU_Factorize can leave a row out of a front if the
+    // entry was its only one in the pivotal columns; the refactorization must
+    // then return PARU_PATTERN_CHANGED.  A few entries are tried, spread over
+    // A.
+
+    int64_t anz = Ap[A->ncol];
+    int64_t nchanged = 0;
+    int64_t step = (anz < 16) ? 1 : (anz / 16);
+    for (int64_t p = 0; p < anz; p += step)
+    {
+        double save = Ax[p];
+        Ax[p] = 0;
+        info = ParU_Factorize(A, Sym, &Num2, &Control);
+        Ax[p] = save;
+        if (info != PARU_SUCCESS)
+        {
+            ParU_Freenum(&Num2, &Control);
+            continue;
+        }
+        info = ParU_Refactorize(A, Sym, Num2, &Control);
+        TEST_ASSERT_INFO (info == PARU_SUCCESS || info == PARU_SINGULAR ||
+            info == PARU_PATTERN_CHANGED, info) ;
+        if (info == PARU_PATTERN_CHANGED) nchanged++;
+        ParU_Freenum(&Num2, &Control);
+    }
+    printf("Refactorize: pattern changed " LD " times\n", nchanged);
+
     //~~~~~~~~~~~~~~~~~~~End computation~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     //~~~~~~~~~~~~~~~~~~~Free Everything~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
     TEST_PASSES ;
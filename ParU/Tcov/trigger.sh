@@ -44,6 +44,7 @@ echo "========LFAT5.mtx========"
 ./x_brutal_test <$MAT_PATH/LFAT5.mtx
 echo "========west0067.mtx========"
 ./x_paru_c <$MAT_PATH/west0067.mtx
+./x_quick_test <$MAT_PATH/west0067.mtx
 ./cov
 
 echo "========arrow.mtx========"
@@ -28,6 +28,7 @@ extern "C"
 
 #include <complex>
 typedef std::complex<double> Complex ;
+typedef std::complex<float> FComplex ;
 
 // =============================================================================
 // === spqr_gpu ================================================================
@@ -155,6 +156,9 @@ template <typename Int = int64_t> struct spqr_symbolic
     Int do_rank_detection ; // TRUE: allow for tol >= 0.
                                          // FALSE: ignore tol
 
+    Int do_pivoting ;   // TRUE: restricted column pivoting within each front
+                        // (see SuiteSparseQR_rank_factorize)
+
     // the rest depends on whether or not rank-detection is allowed:
     Int maxstack  ; // max stack size (sequential case)
     Int hisize ;    // size of Hii
@@ -271,6 +275,13 @@ template <typename Entry, typename Int = int64_t> struct spqr_numeric
                         // this is NULL.  If m < n, then at least m-n columns
                         // will be dead.
 
+    Int *Pcol ;         // size n, or NULL if QRsym->do_pivoting is FALSE.
+                        // Column k of R is column Pcol [k] of S, after
+                        // column pivoting within each front.
+    Int *PcolInv ;      // size n, inverse of Pcol.  The global column j in
+                        // QRsym->Rj of a non-pivotal column of a front is
+                        // column PcolInv [j] of R.
+
     Int rank ;      // number of live pivot columns
     Int rank1 ;     // number of live pivot columns in first ntol
                                  // columns of A
@@ -312,9 +323,13 @@ template <typename Entry, typename Int = int64_t> struct spqr_numeric
 } ;
 extern template struct spqr_numeric <double, int32_t>;
 extern template struct spqr_numeric <Complex, int32_t>;
+extern template struct spqr_numeric <float, int32_t>;
+extern template struct spqr_numeric <FComplex, int32_t>;
 
 extern template struct spqr_numeric <double, int64_t>;
 extern template struct spqr_numeric <Complex, int64_t>;
+extern template struct spqr_numeric <float, int64_t>;
+extern template struct spqr_numeric <FComplex, int64_t>;
 
 // =============================================================================
 // === SuiteSparseQR_factorization =============================================
@@ -361,9 +376,101 @@ template <typename Entry, typename Int = int64_t> struct SuiteSparseQR_factoriza
                                  // ranges from 0 to min(m,n)
 
     int allow_tol ;     // if TRUE, do rank detection
+
+    int qless ;         // if TRUE, this object is from
+                        // SuiteSparseQR_stream_finish.  Its Householder
+                        // vectors are those of R, not A, so Q of A is not
+                        // available and SuiteSparseQR_qmult cannot be used.
+
+    void *Blob ;        // NULL, or the blob this object was created from by
+                        // SuiteSparseQR_deserialize.  If not NULL, the arrays
+                        // of this object point into the blob, which is owned
+                        // by the user, and the object is read-only.
+} ;
+
+
+// =============================================================================
+// === SuiteSparseQR_stream ====================================================
+// =============================================================================
+
+// A QR factorization of a tall-and-skinny matrix A = [A1 ; A2 ; ...], and
+// C = Q'*B for B = [B1 ; B2 ; ...], computed one block of rows at a time.
+// Only R and C are kept, not A or B.
+
+template <typename Entry, typename Int = int64_t> struct SuiteSparseQR_stream
+{
+    Int n ;             // number of columns of A
+    Int bncols ;        // number of columns of B (zero if B not present)
+    Int nrows ;         // number of rows of A appended so far
+    int ordering ;      // ordering used for the first block of rows
+
+    Int *Qfill ;        // size n, column ordering.  Column k of R is
+                        // column Qfill [k] of A.
+
+    cholmod_sparse *R ; // e-by-n R factor of the rows appended so far, where
+                        // e <= n.  NULL if no rows have been appended.
+    cholmod_dense *C ;  // e-by-bncols, C = Q'*B.  NULL if bncols is zero.
+
+    // Row form of R and C, used by SuiteSparseQR_stream_updown.  If Rrp is
+    // not NULL, the row form holds the current R and C, and R and C above
+    // are NULL.  Row k of R is either empty (Rrlen [k] == 0) or its leftmost
+    // entry is the diagonal R(k,k), which is real and positive.
+    Int *Rrp ;          // size n, row k of R is held in Rrj and Rrx
+                        // [Rrp [k] ... Rrp [k] + Rrlen [k] - 1], diagonal first
+    Int *Rrlen ;        // size n, number of entries in row k of R
+    Int *Rrj ;          // size rrsize, column indices of R
+    Entry *Rrx ;        // size rrsize, values of R
+    Entry *Crx ;        // size n*bncols, row k of C is Crx [k*bncols ...]
+    Int rrsize ;        // size of Rrj and Rrx
+    Int rrtail ;        // Rrj and Rrx [rrtail ... rrsize-1] are unused
 } ;
 
 
+// =============================================================================
+// === SuiteSparseQR_front_trace ===============================================
+// =============================================================================
+
+// An optional trace of the numeric factorization, with one record per front.
+// A trace function and its user_data can be passed to SuiteSparseQR_factorize
+// and SuiteSparseQR_numeric; it is called once for each front, just after the
+// front is factorized, by that call only.  No global state is used, so
+// factorizations in different threads can use different trace functions.
+// Fronts in different tasks are factorized in parallel, so the trace function
+// must be thread-safe.  The trace is not done on the GPU.
+
+struct SuiteSparseQR_front_trace
+{
+    int64_t front ;         // front f
+    int64_t task ;          // task that factorized the front
+    int64_t stack ;         // stack used by that task
+    int64_t fm ;            // F is fm-by-fn
+    int64_t fn ;
+    int64_t fp ;            // number of pivot columns of F
+    int64_t frank ;         // number of rows in the R block of F
+    double assemble_time ;  // time to find the size of F and assemble it
+    double front_time ;     // time in spqr_front, including spqr_larftb
+    double larftb_time ;    // time in spqr_larftb, within spqr_front
+    int64_t stack_inuse ;   // # of entries in use in the stack, including F
+    int64_t stack_peak ;    // high-water mark of the stack so far (entries)
+    int64_t entry_size ;    // size of each entry, in bytes
+} ;
+
+typedef void (*SuiteSparseQR_front_trace_func)
+(
+    const SuiteSparseQR_front_trace *trace,
+    void *user_data
+) ;
+
+// a trace function that writes one line of CSV to the FILE * user_data
+void SuiteSparseQR_front_trace_csv
+(
+    const SuiteSparseQR_front_trace *trace,
+    void *user_data
+) ;
+
+// write the CSV header line for SuiteSparseQR_front_trace_csv to a FILE *
+void SuiteSparseQR_front_trace_csv_header (FILE *file) ;
+
 // =============================================================================
 // === Simple user-callable SuiteSparseQR functions ============================
 // =============================================================================
@@ -572,6 +679,21 @@ SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_factorize
     cholmod_common *cc
 ) ;
 
+// the same, with a trace of each front (see SuiteSparseQR_front_trace)
+template <typename Entry, typename Int = int64_t>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_factorize
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
 template <typename Entry, typename Int = int64_t> cholmod_dense *SuiteSparseQR_solve    // returns X
 (
     // inputs, not modified:
@@ -640,6 +762,129 @@ template <typename Entry, typename Int = int64_t> cholmod_sparse *SuiteSparseQR_
     cholmod_common *cc
 ) ;
 
+// least-squares solution of A*X=B with a single-precision QR factorization
+// of A, refined in double precision; A and B are double or double complex
+template <typename Entry, typename Int = int64_t> cholmod_dense *SuiteSparseQR_mixed
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol treated as zero
+    int maxrefine,          // maximum number of refinement steps
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense *B,       // m-by-nrhs dense matrix
+    int *p_nrefine,         // number of refinement steps done (may be NULL)
+    cholmod_common *cc
+) ;
+
+// streaming QR factorization, one block of rows at a time
+template <typename Entry, typename Int = int64_t>
+SuiteSparseQR_stream <Entry, Int> *SuiteSparseQR_stream_start
+(
+    // inputs, not modified
+    int ordering,           // ordering to use for the first block of rows
+    Int n,                  // number of columns of A
+    Int bncols,             // number of columns of B (zero if not present)
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template <typename Entry, typename Int = int64_t> int SuiteSparseQR_stream_append
+(
+    // inputs, not modified
+    cholmod_sparse *A,      // next block of rows of A, mk-by-n
+    cholmod_dense *B,       // next block of rows of B, mk-by-bncols
+    // input/output
+    SuiteSparseQR_stream <Entry, Int> *S,
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template <typename Entry, typename Int = int64_t>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_stream_finish
+(
+    // inputs, not modified
+    double tol,             // treat columns with 2-norm <= tol as zero
+    SuiteSparseQR_stream <Entry, Int> *S,
+    // output
+    cholmod_dense **C,      // C = Q'*B, for use in SuiteSparseQR_solve
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+// add (update TRUE) or delete (update FALSE) rows of A and B.  Rows can only
+// be added to or deleted from a stream, not a SuiteSparseQR_factorization.
+template <typename Entry, typename Int = int64_t> int SuiteSparseQR_stream_updown
+(
+    // inputs, not modified
+    int update,             // TRUE: add the rows, FALSE: delete them
+    cholmod_sparse *A,      // rows of A to add or delete, mk-by-n
+    cholmod_dense *B,       // rows of B to add or delete, mk-by-bncols
+    // input/output
+    SuiteSparseQR_stream <Entry, Int> *S,
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template <typename Entry, typename Int = int64_t> int SuiteSparseQR_stream_free
+(
+    SuiteSparseQR_stream <Entry, Int> **S,
+    cholmod_common *cc
+) ;
+
+// rank-revealing QR factorization, with column pivoting within each front
+template <typename Entry, typename Int = int64_t>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_rank_factorize
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_common *cc
+) ;
+
+// returns N of size n-by-(n-rank) with A*N approximately zero, or NULL
+template <typename Entry, typename Int = int64_t> cholmod_dense
+*SuiteSparseQR_nullspace
+(
+    SuiteSparseQR_factorization <Entry, Int> *QR, // of an m-by-n sparse A
+    cholmod_sparse *A,      // the matrix that was factorized
+    cholmod_common *cc
+) ;
+
+// save a QR factorization into a single blob, and use it again in place.
+// Each array in the blob is at an offset that is a multiple of 64 bytes from
+// the start of the blob.  SuiteSparseQR_deserialize uses the blob in place,
+// so the blob must start on an 8-byte boundary (as any malloc'd or mmap'd
+// block does); otherwise it returns NULL with cc->status CHOLMOD_INVALID.
+template <typename Entry, typename Int = int64_t> size_t
+SuiteSparseQR_serialize_size    // returns size of the blob, or 0 on error
+(
+    // input, not modified
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template <typename Entry, typename Int = int64_t> int SuiteSparseQR_serialize
+(
+    // input, not modified
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    // output
+    void *blob,             // size blob_size, at least
+                            // SuiteSparseQR_serialize_size (QR, cc)
+    size_t blob_size,
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template <typename Entry, typename Int = int64_t>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_deserialize
+(
+    // input, not modified; must not be freed until the QR object is freed
+    void *blob,             // size blob_size, on an 8-byte boundary
+    size_t blob_size,
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
 // symbolic QR factorization; no singletons exploited
 template <typename Entry, typename Int = int64_t>
 SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_symbolic
@@ -681,6 +926,24 @@ extern template int SuiteSparseQR_numeric <Complex, int32_t>
     SuiteSparseQR_factorization <Complex, int32_t> *QR,
     cholmod_common *cc      // workspace and parameters
 ) ;
+extern template int SuiteSparseQR_numeric <float, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+extern template int SuiteSparseQR_numeric <FComplex, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
 extern template int SuiteSparseQR_numeric <double, int64_t>
 (
     // inputs:
@@ -700,6 +963,141 @@ extern template int SuiteSparseQR_numeric <Complex, int64_t>
     SuiteSparseQR_factorization <Complex, int64_t> *QR,
     cholmod_common *cc      // workspace and parameters
 ) ;
+extern template int SuiteSparseQR_numeric <float, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+extern template int SuiteSparseQR_numeric <FComplex, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+// the same, with a trace of each front (see SuiteSparseQR_front_trace)
+template <typename Entry, typename Int = int64_t> int SuiteSparseQR_numeric
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+extern template int SuiteSparseQR_numeric <double, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <double, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+extern template int SuiteSparseQR_numeric <Complex, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Complex, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+extern template int SuiteSparseQR_numeric <float, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+extern template int SuiteSparseQR_numeric <FComplex, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+extern template int SuiteSparseQR_numeric <double, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <double, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+extern template int SuiteSparseQR_numeric <Complex, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Complex, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+extern template int SuiteSparseQR_numeric <float, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+extern template int SuiteSparseQR_numeric <FComplex, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
 #endif
 
 #endif
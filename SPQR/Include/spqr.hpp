@@ -127,7 +127,7 @@
 
 #define RETURN_IF_XTYPE_INVALID(A,result) \
 { \
-    if (A->xtype != xtype) \
+    if (A->xtype + A->dtype != xtype) \
     { \
         ERROR (CHOLMOD_INVALID, "invalid xtype") ; \
         return (result) ; \
@@ -218,6 +218,7 @@ template <typename Entry, typename Int = int64_t> struct spqr_work
 
     Int sumfrank ;         // sum of ranks of the fronts in this stack
     Int maxfrank ;         // largest rank of fronts in this stack
+    Int stack_peak ;       // high-water mark of this stack, if traced
 
     // for computing the 2-norm of w, the vector of the dead column norms
     double wscale ;         // scale factor for norm (w (of this stack))
@@ -242,6 +243,8 @@ template <typename Entry, typename Int = int64_t> struct spqr_blob
     Entry *Sx ;
     Int ntol ;
     Int fchunk ;
+    SuiteSparseQR_front_trace_func trace ;  // NULL if fronts not traced
+    void *trace_data ;
     cholmod_common *cc ;
 } ;
 
@@ -280,6 +283,10 @@ template <typename Entry, typename Int = int64_t> spqr_numeric <Entry, Int> *spq
     Int ntol,                      // apply tol only to first ntol columns
     spqr_symbolic <Int> *QRsym,
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -340,6 +347,18 @@ template <typename Entry, typename Int = int64_t> void spqr_freefac
     cholmod_common *cc
 ) ;
 
+template <typename Entry, typename Int = int64_t> int spqr_stream_tocols
+(
+    SuiteSparseQR_stream <Entry, Int> *S,
+    cholmod_common *cc
+) ;
+
+template <typename Entry, typename Int = int64_t> void spqr_stream_freerows
+(
+    SuiteSparseQR_stream <Entry, Int> *S,
+    cholmod_common *cc
+) ;
+
 template <typename Int = int64_t> void spqr_stranspose1
 (
     // input, not modified
@@ -693,6 +712,10 @@ SuiteSparseQR_factorization <Entry, Int> *spqr_1factor
     Int *Bi,               // size bnz = Bp [bncols], row indices of B
     Entry *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -757,12 +780,23 @@ template <typename Int = int64_t> int spqr_happly_work
     Int *p_csize
 ) ;
 
+template <typename Int = int64_t> Int spqr_happly_blocks
+(
+    // input
+    Int nx,         // # of columns (methods 0,1) or rows (methods 2,3) of X
+
+    // output
+    int *p_nthreads,    // # of threads to use
+
+    cholmod_common *cc
+) ;
+
 template <typename Entry, typename Int = int64_t> void spqr_happly
 (
     // input
     int method,     // 0,1,2,3 
 
-    Int m,         // X is m-by-n
+    Int m,         // X is m-by-n with leading dimension ldx
     Int n,
 
     Int nh,        // number of Householder vectors
@@ -774,7 +808,8 @@ template <typename Entry, typename Int = int64_t> void spqr_happly
     Entry *Tau,     // size nh
 
     // input/output
-    Entry *X,       // size m-by-n with leading dimension m
+    Entry *X,       // size m-by-n with leading dimension ldx
+    Int ldx,
 
     // workspace
     Int vmax,
@@ -1057,6 +1092,9 @@ template <typename Entry, typename Int = int64_t> Int spqr_front
                         // and remain zero on output.
     char *Rdead,        // size npiv; all zero on input.  If k is dead,
                         // Rdead [k] is set to 1
+    Int *Pfront,       // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
 
     // output, not defined on input
     Entry *Tau,         // size n, Householder coefficients
@@ -1067,6 +1105,8 @@ template <typename Entry, typename Int = int64_t> Int spqr_front
     // input/output
     double *wscale,
     double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
 
     cholmod_common *cc
 ) ;
@@ -1115,6 +1155,16 @@ inline Complex spqr_conj (Complex x)
     return (std::conj (x)) ;
 }
 
+inline float spqr_conj (float x)
+{
+    return (x) ;
+}
+
+inline FComplex spqr_conj (FComplex x)
+{
+    return (std::conj (x)) ;
+}
+
 
 // =============================================================================
 // === spqr_abs ================================================================
@@ -1130,6 +1180,16 @@ inline double spqr_abs (Complex x)
     return (SuiteSparse_config_hypot (x.real ( ), x.imag ( ))) ;
 }
 
+inline double spqr_abs (float x)
+{
+    return (fabs ((double) x)) ;
+}
+
+inline double spqr_abs (FComplex x)
+{
+    return (SuiteSparse_config_hypot (x.real ( ), x.imag ( ))) ;
+}
+
 
 // =============================================================================
 // === spqr_divide =============================================================
@@ -1148,6 +1208,19 @@ inline Complex spqr_divide (Complex a, Complex b)
     return (Complex (creal, cimag)) ;
 }
 
+inline float spqr_divide (float a, float b)
+{
+    return (a/b) ;
+}
+
+inline FComplex spqr_divide (FComplex a, FComplex b)
+{
+    double creal, cimag ;
+    SuiteSparse_config_divcomplex
+        (a.real(), a.imag(), b.real(), b.imag(), &creal, &cimag) ;
+    return (FComplex ((float) creal, (float) cimag)) ;
+}
+
 
 // =============================================================================
 // === spqr_add ================================================================
@@ -24,6 +24,18 @@ void spqrgpu_kernel
     spqr_blob <Complex, Int> *Blob
 ) ;
 
+template <typename Int = int64_t>
+void spqrgpu_kernel
+(
+    spqr_blob <float, Int> *Blob
+) ;
+
+template <typename Int = int64_t>
+void spqrgpu_kernel
+(
+    spqr_blob <FComplex, Int> *Blob
+) ;
+
 template <typename Int>
 void spqrgpu_computeFrontStaging
 (
@@ -385,6 +385,12 @@ spqr_cpp_src = {
     '../Source/SuiteSparseQR_qmult', ...
     '../Source/SuiteSparseQR', ...
     '../Source/SuiteSparseQR_expert', ...
+    '../Source/SuiteSparseQR_stream', ...
+    '../Source/SuiteSparseQR_updown', ...
+    '../Source/SuiteSparseQR_serialize', ...
+    '../Source/SuiteSparseQR_mixed', ...
+    '../Source/SuiteSparseQR_rank', ...
+    '../Source/SuiteSparseQR_trace', ...
     '../Source/spqr_cholmod_wrappers', ...
     '../MATLAB/spqr_mx' } ;
 
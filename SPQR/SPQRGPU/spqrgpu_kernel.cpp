@@ -753,5 +753,36 @@ void spqrgpu_kernel
 template void spqrgpu_kernel (spqr_blob <Complex, int32_t> *Blob) ;
 template void spqrgpu_kernel (spqr_blob <Complex, int64_t> *Blob) ;
 
+// -------------------------------------------------------------------------
+
+template <typename Int>
+void spqrgpu_kernel
+(
+    spqr_blob <float, Int> *Blob
+)
+{
+    // single precision not yet supported on the GPU
+    cholmod_common *cc = Blob->cc ;
+    ERROR (CHOLMOD_INVALID, "single precision not yet supported on the GPU") ;
+    return ;
+}
+
+template <typename Int>
+void spqrgpu_kernel
+(
+    spqr_blob <FComplex, Int> *Blob
+)
+{
+    // single precision not yet supported on the GPU
+    cholmod_common *cc = Blob->cc ;
+    ERROR (CHOLMOD_INVALID, "single precision not yet supported on the GPU") ;
+    return ;
+}
+
+template void spqrgpu_kernel (spqr_blob <float, int32_t> *Blob) ;
+template void spqrgpu_kernel (spqr_blob <float, int64_t> *Blob) ;
+template void spqrgpu_kernel (spqr_blob <FComplex, int32_t> *Blob) ;
+template void spqrgpu_kernel (spqr_blob <FComplex, int64_t> *Blob) ;
+
 template void spqrgpu_kernel (spqr_blob <double, int32_t> *Blob) ;
 template void spqrgpu_kernel (spqr_blob <double, int64_t> *Blob) ;
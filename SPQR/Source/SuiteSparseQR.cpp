@@ -73,6 +73,52 @@ extern template SuiteSparseQR_factorization <Complex, int32_t> *spqr_1factor <Co
     int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
     Complex *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+extern template SuiteSparseQR_factorization <float, int32_t> *spqr_1factor <float, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int32_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int32_t ldb,               // if dense, the leading dimension of B
+    int32_t *Bp,               // size bncols+1, column pointers of B
+    int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    float *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+extern template SuiteSparseQR_factorization <FComplex, int32_t> *spqr_1factor <FComplex, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int32_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int32_t ldb,               // if dense, the leading dimension of B
+    int32_t *Bp,               // size bncols+1, column pointers of B
+    int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    FComplex *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -92,6 +138,10 @@ extern template SuiteSparseQR_factorization <double, int32_t> *spqr_1factor <dou
     int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
     double *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -110,6 +160,52 @@ extern template SuiteSparseQR_factorization <Complex, int64_t> *spqr_1factor <Co
     int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
     Complex *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+extern template SuiteSparseQR_factorization <float, int64_t> *spqr_1factor <float, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int64_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int64_t ldb,               // if dense, the leading dimension of B
+    int64_t *Bp,               // size bncols+1, column pointers of B
+    int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    float *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+extern template SuiteSparseQR_factorization <FComplex, int64_t> *spqr_1factor <FComplex, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int64_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int64_t ldb,               // if dense, the leading dimension of B
+    int64_t *Bp,               // size bncols+1, column pointers of B
+    int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    FComplex *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -140,6 +236,58 @@ extern template int spqr_1fixed <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+extern template int spqr_1fixed <float, int32_t>
+(
+    // inputs, not modified
+    double tol,             // only accept singletons above tol
+    int32_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // output arrays, neither allocated nor defined on input.
+
+    int32_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int32_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int32_t *p_n1cols,         // number of column singletons found
+    int32_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+extern template int spqr_1fixed <FComplex, int32_t>
+(
+    // inputs, not modified
+    double tol,             // only accept singletons above tol
+    int32_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // output arrays, neither allocated nor defined on input.
+
+    int32_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int32_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int32_t *p_n1cols,         // number of column singletons found
+    int32_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 extern template int spqr_1fixed <Complex, int64_t>
 (
     // inputs, not modified
@@ -166,6 +314,58 @@ extern template int spqr_1fixed <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+extern template int spqr_1fixed <float, int64_t>
+(
+    // inputs, not modified
+    double tol,             // only accept singletons above tol
+    int64_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // output arrays, neither allocated nor defined on input.
+
+    int64_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int64_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int64_t *p_n1cols,         // number of column singletons found
+    int64_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+extern template int spqr_1fixed <FComplex, int64_t>
+(
+    // inputs, not modified
+    double tol,             // only accept singletons above tol
+    int64_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // output arrays, neither allocated nor defined on input.
+
+    int64_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int64_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int64_t *p_n1cols,         // number of column singletons found
+    int64_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 extern template int spqr_1fixed <double, int32_t>
 (
@@ -234,6 +434,10 @@ extern template SuiteSparseQR_factorization <double, int64_t> *spqr_1factor <dou
     int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
     double *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -484,7 +688,8 @@ template <typename Entry, typename Int> Int SuiteSparseQR
     // symbolic and numeric QR factorization of [A B], exploiting singletons
     // -------------------------------------------------------------------------
 
-    QR = spqr_1factor (ordering, tol, bncols, getH, A, ldb, Bp, Bi, Bx, cc) ;
+    QR = spqr_1factor (ordering, tol, bncols, getH, A, ldb, Bp, Bi, Bx,
+        (SuiteSparseQR_front_trace_func) NULL, NULL, cc) ;
 
     if (cc->status < CHOLMOD_OK)
     {
@@ -1308,13 +1513,12 @@ template int32_t SuiteSparseQR <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
-
-template int64_t SuiteSparseQR <Complex, int64_t>
+template int32_t SuiteSparseQR <float, int32_t>
 (
     // inputs, not modified
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // columns with 2-norm <= tol are treated as zero
-    int64_t econ,              // number of rows of C and R to return; a value
+    int32_t econ,              // number of rows of C and R to return; a value
                             // less than the rank r of A is treated as r, and
                             // a value greater than m is treated as m.
 
@@ -1332,56 +1536,197 @@ template int64_t SuiteSparseQR <Complex, int64_t>
     cholmod_sparse **p_Zsparse,
     cholmod_dense  **p_Zdense,
     cholmod_sparse **p_R,   // the R factor
-    int64_t **p_E,             // size n; fill-reducing ordering of A.
+    int32_t **p_E,             // size n; fill-reducing ordering of A.
     cholmod_sparse **p_H,   // the Householder vectors (m-by-nh)
-    int64_t **p_HPinv,         // size m; row permutation for H
+    int32_t **p_HPinv,         // size m; row permutation for H
     cholmod_dense **p_HTau, // size 1-by-nh, Householder coefficients
 
     // workspace and parameters
     cholmod_common *cc
 ) ;
-
-// -----------------------------------------------------------------------------
-// X=A\B where X and B are dense
-// -----------------------------------------------------------------------------
-template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR
+template int32_t SuiteSparseQR <FComplex, int32_t>
 (
+    // inputs, not modified
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // columns with 2-norm <= tol are treated as zero
-    cholmod_sparse *A,      // m-by-n sparse matrix
-    cholmod_dense  *B,      // m-by-nrhs
-    cholmod_common *cc      // workspace and parameters
-)
-{
-    cholmod_dense *X ;
-    SuiteSparseQR <Entry, Int> (ordering, tol, 0, 2, A,   
-        NULL, B, NULL, &X, NULL, NULL, NULL, NULL, NULL, cc) ;
-    return (X) ;
-}
+    int32_t econ,              // number of rows of C and R to return; a value
+                            // less than the rank r of A is treated as r, and
+                            // a value greater than m is treated as m.
+
+    int getCTX,             // if 0: return Z = C of size econ-by-bncols
+                            // if 1: return Z = C' of size bncols-by-econ
+                            // if 2: return Z = X of size econ-by-bncols
 
-template cholmod_dense *SuiteSparseQR <double, int32_t>
-(
-    int ordering,           // all, except 3:given treated as 0:fixed
-    double tol,             // columns with 2-norm <= tol are treated as zero
     cholmod_sparse *A,      // m-by-n sparse matrix
-    cholmod_dense  *B,      // m-by-nrhs
-    cholmod_common *cc      // workspace and parameters
+    cholmod_sparse *Bsparse,
+    cholmod_dense *Bdense,
+
+    // output arrays, neither allocated nor defined on input.
+
+    // Z is the matrix C, C', or X
+    cholmod_sparse **p_Zsparse,
+    cholmod_dense  **p_Zdense,
+    cholmod_sparse **p_R,   // the R factor
+    int32_t **p_E,             // size n; fill-reducing ordering of A.
+    cholmod_sparse **p_H,   // the Householder vectors (m-by-nh)
+    int32_t **p_HPinv,         // size m; row permutation for H
+    cholmod_dense **p_HTau, // size 1-by-nh, Householder coefficients
+
+    // workspace and parameters
+    cholmod_common *cc
 ) ;
-template cholmod_dense *SuiteSparseQR <double, int64_t>
+
+template int64_t SuiteSparseQR <Complex, int64_t>
 (
+    // inputs, not modified
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // number of rows of C and R to return; a value
+                            // less than the rank r of A is treated as r, and
+                            // a value greater than m is treated as m.
+
+    int getCTX,             // if 0: return Z = C of size econ-by-bncols
+                            // if 1: return Z = C' of size bncols-by-econ
+                            // if 2: return Z = X of size econ-by-bncols
+
     cholmod_sparse *A,      // m-by-n sparse matrix
-    cholmod_dense  *B,      // m-by-nrhs
-    cholmod_common *cc      // workspace and parameters
-) ;
+    cholmod_sparse *Bsparse,
+    cholmod_dense *Bdense,
 
-template cholmod_dense *SuiteSparseQR <Complex, int32_t>
+    // output arrays, neither allocated nor defined on input.
+
+    // Z is the matrix C, C', or X
+    cholmod_sparse **p_Zsparse,
+    cholmod_dense  **p_Zdense,
+    cholmod_sparse **p_R,   // the R factor
+    int64_t **p_E,             // size n; fill-reducing ordering of A.
+    cholmod_sparse **p_H,   // the Householder vectors (m-by-nh)
+    int64_t **p_HPinv,         // size m; row permutation for H
+    cholmod_dense **p_HTau, // size 1-by-nh, Householder coefficients
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template int64_t SuiteSparseQR <float, int64_t>
 (
+    // inputs, not modified
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // columns with 2-norm <= tol are treated as zero
-    cholmod_sparse *A,      // m-by-n sparse matrix
-    cholmod_dense  *B,      // m-by-nrhs
+    int64_t econ,              // number of rows of C and R to return; a value
+                            // less than the rank r of A is treated as r, and
+                            // a value greater than m is treated as m.
+
+    int getCTX,             // if 0: return Z = C of size econ-by-bncols
+                            // if 1: return Z = C' of size bncols-by-econ
+                            // if 2: return Z = X of size econ-by-bncols
+
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *Bsparse,
+    cholmod_dense *Bdense,
+
+    // output arrays, neither allocated nor defined on input.
+
+    // Z is the matrix C, C', or X
+    cholmod_sparse **p_Zsparse,
+    cholmod_dense  **p_Zdense,
+    cholmod_sparse **p_R,   // the R factor
+    int64_t **p_E,             // size n; fill-reducing ordering of A.
+    cholmod_sparse **p_H,   // the Householder vectors (m-by-nh)
+    int64_t **p_HPinv,         // size m; row permutation for H
+    cholmod_dense **p_HTau, // size 1-by-nh, Householder coefficients
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template int64_t SuiteSparseQR <FComplex, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // number of rows of C and R to return; a value
+                            // less than the rank r of A is treated as r, and
+                            // a value greater than m is treated as m.
+
+    int getCTX,             // if 0: return Z = C of size econ-by-bncols
+                            // if 1: return Z = C' of size bncols-by-econ
+                            // if 2: return Z = X of size econ-by-bncols
+
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *Bsparse,
+    cholmod_dense *Bdense,
+
+    // output arrays, neither allocated nor defined on input.
+
+    // Z is the matrix C, C', or X
+    cholmod_sparse **p_Zsparse,
+    cholmod_dense  **p_Zdense,
+    cholmod_sparse **p_R,   // the R factor
+    int64_t **p_E,             // size n; fill-reducing ordering of A.
+    cholmod_sparse **p_H,   // the Householder vectors (m-by-nh)
+    int64_t **p_HPinv,         // size m; row permutation for H
+    cholmod_dense **p_HTau, // size 1-by-nh, Householder coefficients
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+// -----------------------------------------------------------------------------
+// X=A\B where X and B are dense
+// -----------------------------------------------------------------------------
+template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    cholmod_dense *X ;
+    SuiteSparseQR <Entry, Int> (ordering, tol, 0, 2, A,   
+        NULL, B, NULL, &X, NULL, NULL, NULL, NULL, NULL, cc) ;
+    return (X) ;
+}
+
+template cholmod_dense *SuiteSparseQR <double, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_dense *SuiteSparseQR <double, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template cholmod_dense *SuiteSparseQR <Complex, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_dense *SuiteSparseQR <float, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_dense *SuiteSparseQR <FComplex, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
     cholmod_common *cc      // workspace and parameters
 ) ;
 template cholmod_dense *SuiteSparseQR <Complex, int64_t>
@@ -1392,6 +1737,22 @@ template cholmod_dense *SuiteSparseQR <Complex, int64_t>
     cholmod_dense  *B,      // m-by-nrhs
     cholmod_common *cc      // workspace and parameters
 ) ;
+template cholmod_dense *SuiteSparseQR <float, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_dense *SuiteSparseQR <FComplex, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 // -----------------------------------------------------------------------------
 // X=A\B where X and B are dense, default ordering and tol
@@ -1428,12 +1789,36 @@ template cholmod_dense *SuiteSparseQR <Complex, int32_t>
     cholmod_dense  *B,      // m-by-nrhs
     cholmod_common *cc      // workspace and parameters
 ) ;
+template cholmod_dense *SuiteSparseQR <float, int32_t>
+(
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_dense *SuiteSparseQR <FComplex, int32_t>
+(
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
 template cholmod_dense *SuiteSparseQR <Complex, int64_t>
 (
     cholmod_sparse *A,      // m-by-n sparse matrix
     cholmod_dense  *B,      // m-by-nrhs
     cholmod_common *cc      // workspace and parameters
 ) ;
+template cholmod_dense *SuiteSparseQR <float, int64_t>
+(
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_dense *SuiteSparseQR <FComplex, int64_t>
+(
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 // -----------------------------------------------------------------------------
 // X=A\B where X and B are sparse 
@@ -1481,6 +1866,22 @@ template cholmod_sparse *SuiteSparseQR <Complex, int32_t>
     cholmod_sparse *B,      // m-by-nrhs
     cholmod_common *cc      // workspace and parameters
 ) ;
+template cholmod_sparse *SuiteSparseQR <float, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_sparse *SuiteSparseQR <FComplex, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 template cholmod_sparse *SuiteSparseQR <Complex, int64_t>
 (
@@ -1490,6 +1891,22 @@ template cholmod_sparse *SuiteSparseQR <Complex, int64_t>
     cholmod_sparse *B,      // m-by-nrhs
     cholmod_common *cc      // workspace and parameters
 ) ;
+template cholmod_sparse *SuiteSparseQR <float, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
+template cholmod_sparse *SuiteSparseQR <FComplex, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 // -----------------------------------------------------------------------------
 // [Q,R,E] = qr(A), returning Q as a sparse matrix
@@ -1531,6 +1948,30 @@ template int32_t SuiteSparseQR <Complex, int32_t>     // returns rank(A) estimat
     int32_t **E,               // permutation of 0:n-1
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int32_t SuiteSparseQR <float, int32_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **Q,     // m-by-e sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int32_t **E,               // permutation of 0:n-1
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int32_t SuiteSparseQR <FComplex, int32_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **Q,     // m-by-e sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int32_t **E,               // permutation of 0:n-1
+    cholmod_common *cc      // workspace and parameters
+) ;
 template int64_t SuiteSparseQR <Complex, int64_t>     // returns rank(A) estimate
 (
     int ordering,           // all, except 3:given treated as 0:fixed
@@ -1543,6 +1984,30 @@ template int64_t SuiteSparseQR <Complex, int64_t>     // returns rank(A) estimat
     int64_t **E,               // permutation of 0:n-1
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int64_t SuiteSparseQR <float, int64_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **Q,     // m-by-e sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int64_t **E,               // permutation of 0:n-1
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int64_t SuiteSparseQR <FComplex, int64_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **Q,     // m-by-e sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int64_t **E,               // permutation of 0:n-1
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 template int32_t SuiteSparseQR <double, int32_t>     // returns rank(A) estimate
 (
@@ -1599,6 +2064,28 @@ template int32_t SuiteSparseQR <Complex, int32_t>     // returns rank(A) estimat
     int32_t **E,               // permutation of 0:n-1, NULL if identity
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int32_t SuiteSparseQR <float, int32_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int32_t SuiteSparseQR <FComplex, int32_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
 template int64_t SuiteSparseQR <Complex, int64_t>     // returns rank(A) estimate
 (
     int ordering,           // all, except 3:given treated as 0:fixed
@@ -1610,6 +2097,28 @@ template int64_t SuiteSparseQR <Complex, int64_t>     // returns rank(A) estimat
     int64_t **E,               // permutation of 0:n-1, NULL if identity
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int64_t SuiteSparseQR <float, int64_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int64_t SuiteSparseQR <FComplex, int64_t>     // returns rank(A) estimate
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // e-by-n sparse matrix
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 template int32_t SuiteSparseQR <double, int32_t>     // returns rank(A) estimate
 (
@@ -1701,6 +2210,34 @@ template int32_t SuiteSparseQR <Complex, int32_t>
     int32_t **E,               // permutation of 0:n-1, NULL if identity
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int32_t SuiteSparseQR <float, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs dense matrix
+    // outputs
+    cholmod_dense  **C,     // C = Q'*B, an e-by-nrhs dense matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int32_t SuiteSparseQR <FComplex, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs dense matrix
+    // outputs
+    cholmod_dense  **C,     // C = Q'*B, an e-by-nrhs dense matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
 template int64_t SuiteSparseQR <Complex, int64_t>
 (
     // inputs, not modified
@@ -1715,6 +2252,34 @@ template int64_t SuiteSparseQR <Complex, int64_t>
     int64_t **E,               // permutation of 0:n-1, NULL if identity
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int64_t SuiteSparseQR <float, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs dense matrix
+    // outputs
+    cholmod_dense  **C,     // C = Q'*B, an e-by-nrhs dense matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int64_t SuiteSparseQR <FComplex, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_dense  *B,      // m-by-nrhs dense matrix
+    // outputs
+    cholmod_dense  **C,     // C = Q'*B, an e-by-nrhs dense matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 // -----------------------------------------------------------------------------
 // [C,R,E] = qr(A,B) where C and B are both sparse
@@ -1784,6 +2349,34 @@ template int32_t SuiteSparseQR <Complex, int32_t>
     int32_t **E,               // permutation of 0:n-1, NULL if identity
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int32_t SuiteSparseQR <float, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs sparse matrix
+    // outputs
+    cholmod_sparse **C,     // C = Q'*B, an e-by-nrhs sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int32_t SuiteSparseQR <FComplex, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs sparse matrix
+    // outputs
+    cholmod_sparse **C,     // C = Q'*B, an e-by-nrhs sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
 template int64_t SuiteSparseQR <Complex, int64_t>
 (
     // inputs, not modified
@@ -1798,6 +2391,34 @@ template int64_t SuiteSparseQR <Complex, int64_t>
     int64_t **E,               // permutation of 0:n-1, NULL if identity
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int64_t SuiteSparseQR <float, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs sparse matrix
+    // outputs
+    cholmod_sparse **C,     // C = Q'*B, an e-by-nrhs sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int64_t SuiteSparseQR <FComplex, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    cholmod_sparse *B,      // m-by-nrhs sparse matrix
+    // outputs
+    cholmod_sparse **C,     // C = Q'*B, an e-by-nrhs sparse matrix
+    cholmod_sparse **R,     // e-by-n sparse matrix where e=max(econ,rank(A))
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 // -----------------------------------------------------------------------------
 // [Q,R,E] = qr(A) where Q is returned in Householder form
@@ -1871,6 +2492,36 @@ template int32_t SuiteSparseQR <Complex, int32_t>
     cholmod_dense **HTau,   // size 1-by-nh, Householder coefficients
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int32_t SuiteSparseQR <float, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // the R factor
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_sparse **H,     // the Householder vectors (m-by-nh)
+    int32_t **HPinv,           // size m; row permutation for H
+    cholmod_dense **HTau,   // size 1-by-nh, Householder coefficients
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int32_t SuiteSparseQR <FComplex, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int32_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // the R factor
+    int32_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_sparse **H,     // the Householder vectors (m-by-nh)
+    int32_t **HPinv,           // size m; row permutation for H
+    cholmod_dense **HTau,   // size 1-by-nh, Householder coefficients
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 template int64_t SuiteSparseQR <Complex, int64_t>
 (
@@ -1887,12 +2538,46 @@ template int64_t SuiteSparseQR <Complex, int64_t>
     cholmod_dense **HTau,   // size 1-by-nh, Householder coefficients
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int64_t SuiteSparseQR <float, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // the R factor
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_sparse **H,     // the Householder vectors (m-by-nh)
+    int64_t **HPinv,           // size m; row permutation for H
+    cholmod_dense **HTau,   // size 1-by-nh, Householder coefficients
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int64_t SuiteSparseQR <FComplex, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol are treated as zero
+    int64_t econ,              // e = max(min(m,econ),rank(A))
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // outputs
+    cholmod_sparse **R,     // the R factor
+    int64_t **E,               // permutation of 0:n-1, NULL if identity
+    cholmod_sparse **H,     // the Householder vectors (m-by-nh)
+    int64_t **HPinv,           // size m; row permutation for H
+    cholmod_dense **HTau,   // size 1-by-nh, Householder coefficients
+    cholmod_common *cc      // workspace and parameters
+) ;
 
 template struct spqr_numeric <double, int32_t>;
 template struct spqr_numeric <Complex, int32_t>;
+template struct spqr_numeric <float, int32_t>;
+template struct spqr_numeric <FComplex, int32_t>;
 
 template struct spqr_numeric <double, int64_t>;
 template struct spqr_numeric <Complex, int64_t>;
+template struct spqr_numeric <float, int64_t>;
+template struct spqr_numeric <FComplex, int64_t>;
 
 // -----------------------------------------------------------------------------
 // SuiteSparseQR_version
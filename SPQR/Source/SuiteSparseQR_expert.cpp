@@ -94,6 +94,8 @@ SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_symbolic
     QR->QRsym = QRsym = spqr_analyze <Int> (A, ordering, NULL, allow_tol, keepH, cc) ;
 
     QR->QRnum = NULL ;          // allocated later, by numeric factorization
+    QR->Blob = NULL ;
+    QR->qless = FALSE ;
 
     // singleton information:
     QR->R1p = NULL ;            // no singletons; these always remain NULL or 0
@@ -176,6 +178,28 @@ SuiteSparseQR_factorization <Complex, int32_t> *SuiteSparseQR_symbolic <Complex,
     cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
     cholmod_common *cc      // workspace and parameters
 ) ;
+
+template
+SuiteSparseQR_factorization <float, int32_t> *SuiteSparseQR_symbolic <float, int32_t>
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template
+SuiteSparseQR_factorization <FComplex, int32_t> *SuiteSparseQR_symbolic <FComplex, int32_t>
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+) ;
 template
 SuiteSparseQR_factorization <double, int64_t> *SuiteSparseQR_symbolic <double, int64_t>
 (
@@ -198,6 +222,28 @@ SuiteSparseQR_factorization <Complex, int64_t> *SuiteSparseQR_symbolic <Complex,
     cholmod_common *cc      // workspace and parameters
 ) ;
 
+template
+SuiteSparseQR_factorization <float, int64_t> *SuiteSparseQR_symbolic <float, int64_t>
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template
+SuiteSparseQR_factorization <FComplex, int64_t> *SuiteSparseQR_symbolic <FComplex, int64_t>
+(
+    // inputs:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    int allow_tol,          // if FALSE, tol is ignored by the numeric
+                            // factorization, and no rank detection is performed
+    cholmod_sparse *A,      // sparse matrix to factorize (A->x ignored)
+    cholmod_common *cc      // workspace and parameters
+) ;
+
 // =============================================================================
 // === SuiteSparseQR_numeric ===================================================
 // =============================================================================
@@ -209,6 +255,9 @@ SuiteSparseQR_factorization <Complex, int64_t> *SuiteSparseQR_symbolic <Complex,
 //
 // Returns TRUE if successful, FALSE otherwise.
 //
+// If trace_func is not NULL, it is called once for each front, just after the
+// front is factorized (see SuiteSparseQR_front_trace).
+//
 // The GPU is not used by this function, since it requires the Householder
 // vectors to be kept.
 
@@ -219,6 +268,9 @@ template <typename Entry, typename Int> int SuiteSparseQR_numeric
     cholmod_sparse *A,      // sparse matrix to factorize
     // input/output
     SuiteSparseQR_factorization <Entry, Int> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     cholmod_common *cc      // workspace and parameters
 )
 {
@@ -239,6 +291,13 @@ template <typename Entry, typename Int> int SuiteSparseQR_numeric
         return (FALSE) ;
     }
 
+    if (QR->Blob != NULL)
+    {
+        // the QR object was created by SuiteSparseQR_deserialize
+        ERROR (CHOLMOD_INVALID, "cannot refactorize a read-only QR object") ;
+        return (FALSE) ;
+    }
+
     int64_t n = A->ncol ;
 
     // -------------------------------------------------------------------------
@@ -268,7 +327,8 @@ template <typename Entry, typename Int> int SuiteSparseQR_numeric
     spqr_freenum (&(QR->QRnum), cc) ;
 
     // compute the new factorization
-    QR->QRnum = spqr_factorize <Entry, Int> (&A, FALSE, tol, n, QR->QRsym, cc) ;
+    QR->QRnum = spqr_factorize <Entry, Int> (&A, FALSE, tol, n, QR->QRsym,
+        trace_func, trace_data, cc) ;
 
     if (cc->status < CHOLMOD_OK)
     {
@@ -279,6 +339,31 @@ template <typename Entry, typename Int> int SuiteSparseQR_numeric
 
     QR->rank = QR->QRnum->rank1 ;
 
+    // -------------------------------------------------------------------------
+    // combine the fill-reducing ordering with the column pivoting
+    // -------------------------------------------------------------------------
+
+    Int *Pcol = QR->QRnum->Pcol ;
+    if (Pcol != NULL)
+    {
+        Int *Qfill = QR->QRsym->Qfill ;
+        if (QR->Q1fill == NULL)
+        {
+            QR->Q1fill = (Int *) spqr_malloc <Int> (n, sizeof (Int), cc) ;
+            if (cc->status < CHOLMOD_OK)
+            {
+                // out of memory; QR factorization remains a symbolic-only
+                // object
+                spqr_freenum (&(QR->QRnum), cc) ;
+                return (FALSE) ;
+            }
+        }
+        for (Int k = 0 ; k < n ; k++)
+        {
+            QR->Q1fill [k] = Qfill ? Qfill [Pcol [k]] : Pcol [k] ;
+        }
+    }
+
     // -------------------------------------------------------------------------
     // find the mapping for the squeezed R, if A is rank deficient
     // -------------------------------------------------------------------------
@@ -303,6 +388,21 @@ template <typename Entry, typename Int> int SuiteSparseQR_numeric
     return (TRUE) ;
 }
 
+// the same, without a front trace
+template <typename Entry, typename Int> int SuiteSparseQR_numeric
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    return (SuiteSparseQR_numeric <Entry, Int> (tol, A, QR,
+        (SuiteSparseQR_front_trace_func) NULL, NULL, cc)) ;
+}
+
 template int SuiteSparseQR_numeric <double, int32_t>
 (
     // inputs:
@@ -322,6 +422,114 @@ template int SuiteSparseQR_numeric <Complex, int32_t>
     SuiteSparseQR_factorization <Complex, int32_t> *QR,
     cholmod_common *cc      // workspace and parameters
 ) ;
+template int SuiteSparseQR_numeric <float, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int SuiteSparseQR_numeric <FComplex, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int SuiteSparseQR_numeric <double, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <double, int64_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_numeric <Complex, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Complex, int64_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int SuiteSparseQR_numeric <float, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+template int SuiteSparseQR_numeric <FComplex, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_numeric <double, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <double, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_numeric <Complex, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <Complex, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_numeric <float, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_numeric <FComplex, int32_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
 template int SuiteSparseQR_numeric <double, int64_t>
 (
     // inputs:
@@ -329,6 +537,9 @@ template int SuiteSparseQR_numeric <double, int64_t>
     cholmod_sparse *A,      // sparse matrix to factorize
     // input/output
     SuiteSparseQR_factorization <double, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     cholmod_common *cc      // workspace and parameters
 ) ;
 
@@ -339,8 +550,38 @@ template int SuiteSparseQR_numeric <Complex, int64_t>
     cholmod_sparse *A,      // sparse matrix to factorize
     // input/output
     SuiteSparseQR_factorization <Complex, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     cholmod_common *cc      // workspace and parameters
 ) ;
+
+template int SuiteSparseQR_numeric <float, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
+template int SuiteSparseQR_numeric <FComplex, int64_t>
+(
+    // inputs:
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // input/output
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    cholmod_common *cc      // workspace and parameters
+) ;
+
 // =============================================================================
 // === SuiteSparseQR_factorize =================================================
 // =============================================================================
@@ -363,6 +604,10 @@ template int SuiteSparseQR_numeric <Complex, int64_t>
 // factorization of A, then use the SuiteSparseQR function instead (which
 // corresponds to the MATLAB statement x=A\B, using a sparse QR factorization).
 //
+// If trace_func is not NULL, it is called once for each front of the
+// singleton-free submatrix, just after the front is factorized (see
+// SuiteSparseQR_front_trace).
+//
 // The GPU is not used because the Householder vectors are always kept.
 
 template <typename Entry, typename Int>
@@ -372,6 +617,9 @@ SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_factorize
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // treat columns with 2-norm <= tol as zero
     cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     cholmod_common *cc      // workspace and parameters
 )
 {
@@ -383,44 +631,199 @@ SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_factorize
     // B is not present, and always keep H:
     int keepH = TRUE ;
     return (spqr_1factor <Entry, Int> (ordering, tol, 0, keepH, A,
-        0, NULL, NULL, NULL, cc)) ;
+        0, NULL, NULL, NULL, trace_func, trace_data, cc)) ;
 }
 
-template SuiteSparseQR_factorization <double, int32_t> *SuiteSparseQR_factorize <double, int32_t>
+// the same, without a front trace
+template <typename Entry, typename Int>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_factorize
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    cholmod_common *cc      // workspace and parameters
+)
+{
+    return (SuiteSparseQR_factorize <Entry, Int> (ordering, tol, A,
+        (SuiteSparseQR_front_trace_func) NULL, NULL, cc)) ;
+}
+
+template SuiteSparseQR_factorization <double, int32_t> *SuiteSparseQR_factorize <double, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <Complex, int32_t> *SuiteSparseQR_factorize<Complex, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int32_t> *SuiteSparseQR_factorize<float, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int32_t> *SuiteSparseQR_factorize<FComplex, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <double, int64_t> *SuiteSparseQR_factorize <double, int64_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <Complex, int64_t> *SuiteSparseQR_factorize<Complex, int64_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int64_t> *SuiteSparseQR_factorize<float, int64_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int64_t> *SuiteSparseQR_factorize<FComplex, int64_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <double, int32_t> *SuiteSparseQR_factorize <double, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <Complex, int32_t> *SuiteSparseQR_factorize<Complex, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <float, int32_t> *SuiteSparseQR_factorize<float, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <FComplex, int32_t> *SuiteSparseQR_factorize<FComplex, int32_t>
+(
+    // inputs, not modified:
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+
+template SuiteSparseQR_factorization <double, int64_t> *SuiteSparseQR_factorize <double, int64_t>
 (
     // inputs, not modified:
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // treat columns with 2-norm <= tol as zero
     cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     // workspace and parameters
     cholmod_common *cc
 ) ;
 
-template SuiteSparseQR_factorization <Complex, int32_t> *SuiteSparseQR_factorize<Complex, int32_t>
+template SuiteSparseQR_factorization <Complex, int64_t> *SuiteSparseQR_factorize<Complex, int64_t>
 (
     // inputs, not modified:
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // treat columns with 2-norm <= tol as zero
     cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     // workspace and parameters
     cholmod_common *cc
 ) ;
-template SuiteSparseQR_factorization <double, int64_t> *SuiteSparseQR_factorize <double, int64_t>
+
+template SuiteSparseQR_factorization <float, int64_t> *SuiteSparseQR_factorize<float, int64_t>
 (
     // inputs, not modified:
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // treat columns with 2-norm <= tol as zero
     cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     // workspace and parameters
     cholmod_common *cc
 ) ;
 
-template SuiteSparseQR_factorization <Complex, int64_t> *SuiteSparseQR_factorize<Complex, int64_t>
+template SuiteSparseQR_factorization <FComplex, int64_t> *SuiteSparseQR_factorize<FComplex, int64_t>
 (
     // inputs, not modified:
     int ordering,           // all, except 3:given treated as 0:fixed
     double tol,             // treat columns with 2-norm <= tol as zero
     cholmod_sparse *A,      // sparse matrix to factorize
+    // front trace:
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -456,6 +859,7 @@ template <typename Entry, typename Int> void spqr_private_rtsolve
         *RmapInv ;
     Entry *R1x, **Rblock, *R, *X1, *X2 ;
     char *Rdead ;
+    Int *PcolInv ;
     Int i, j, k, m, n, p, kk, n1rows, n1cols, rank, nf, f, col1, col2, fp, pr,
         fn, rm, row1, keepH, fm, h, t, live, jj ;
 
@@ -494,6 +898,7 @@ template <typename Entry, typename Int> void spqr_private_rtsolve
     Rj = QRsym->Rj ;
     Super = QRsym->Super ;
     Rdead = QRnum->Rdead ;
+    PcolInv = QRnum->PcolInv ;  // NULL if columns not pivoted
 
     HStair = QRnum->HStair ;
     Hm = QRnum->Hm ;
@@ -682,7 +1087,7 @@ template <typename Entry, typename Int> void spqr_private_rtsolve
 
         for ( ; k < fn ; k++)
         {
-            j = Rj [pr + k] ;
+            j = PcolInv ? PcolInv [Rj [pr + k]] : Rj [pr + k] ;
             ASSERT (j >= col2 && j < QRsym->n) ;
             jj = j + n1cols ;
             if (jj >= n) break ;            // in case [A Binput] was factorized
@@ -851,6 +1256,24 @@ template cholmod_dense *SuiteSparseQR_solve <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_solve <float, int32_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve
+    SuiteSparseQR_factorization <float, int32_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_dense *B,           // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_solve <FComplex, int32_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_dense *B,           // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 template cholmod_dense *SuiteSparseQR_solve <Complex, int64_t>
 (
@@ -861,6 +1284,24 @@ template cholmod_dense *SuiteSparseQR_solve <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_solve <float, int64_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve
+    SuiteSparseQR_factorization <float, int64_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_dense *B,           // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_solve <FComplex, int64_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_dense *B,           // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 template cholmod_dense *SuiteSparseQR_solve <double, int64_t>
 (
@@ -945,6 +1386,24 @@ template cholmod_sparse *SuiteSparseQR_solve <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_solve <float, int32_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve (0,1,2,3)
+    SuiteSparseQR_factorization <float, int32_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_sparse *Bsparse,    // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_solve <FComplex, int32_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve (0,1,2,3)
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_sparse *Bsparse,    // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template cholmod_sparse *SuiteSparseQR_solve <Complex, int64_t>
 (
     // inputs, not modified:
@@ -954,6 +1413,24 @@ template cholmod_sparse *SuiteSparseQR_solve <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_solve <float, int64_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve (0,1,2,3)
+    SuiteSparseQR_factorization <float, int64_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_sparse *Bsparse,    // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_solve <FComplex, int64_t>
+(
+    // inputs, not modified:
+    int system,                 // which system to solve (0,1,2,3)
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,  // of an m-by-n sparse matrix A
+    cholmod_sparse *Bsparse,    // right-hand-side, m-by-nrhs or n-by-nrhs
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 // =============================================================================
 // === spqr_private_get_H_vectors ==============================================
@@ -1115,8 +1592,9 @@ template <typename Entry, typename Int> void spqr_private_Happly
     // input/output
     Int m,
     Int n,
-    Entry *X,               // size m-by-n with leading dimension m; only
+    Entry *X,               // size m-by-n with leading dimension ldx; only
                             // X (n1rows:m-1,:) or X (:,n1rows:n-1) is modified
+    Int ldx,
 
     // workspace, not defined on input or output
     Entry *H_Tau,           // size QRsym->maxfn
@@ -1167,7 +1645,7 @@ template <typename Entry, typename Int> void spqr_private_Happly
     }
     else
     {
-        X2 = X + n1rows * m ;
+        X2 = X + n1rows * ldx ;
         n2 = n - n1rows ; 
         m2 = m ;
     }
@@ -1199,7 +1677,7 @@ template <typename Entry, typename Int> void spqr_private_Happly
                     cc) ;
                 ASSERT (v+h1 <= QR->QRnum->Hm [f]) ;
                 spqr_panel (method, m2, n2, v, h2-h1, Hi+h1, V, H_Tau+h1,
-                    m, X2, C, W, cc) ;
+                    ldx, X2, C, W, cc) ;
             }
         }
     }
@@ -1227,19 +1705,78 @@ template <typename Entry, typename Int> void spqr_private_Happly
                     cc) ;
                 ASSERT (v+h1 <= QR->QRnum->Hm [f]) ;
                 spqr_panel (method, m2, n2, v, h2-h1, Hi+h1, V, H_Tau+h1,
-                    m, X2, C, W, cc) ;
+                    ldx, X2, C, W, cc) ;
             }
         }
     }
 }
 
 
+// =============================================================================
+// === spqr_private_Happly_blocks ==============================================
+// =============================================================================
+
+// Applies the Householder vectors to the m-by-n matrix X (with leading
+// dimension m) in blocks of xchunk columns (methods 0,1) or rows (methods
+// 2,3), using nthreads threads.  Thread t uses H_Tau, H_start, and H_end
+// [t*maxfn ...], V [t*vsize ...], C [t*csize ...], and W [t*wsize ...] as its
+// workspace.
+
+template <typename Entry, typename Int> static void spqr_private_Happly_blocks
+(
+    // inputs
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    Int hchunk,             // apply hchunk Householder vectors at a time
+
+    // input/output
+    Int m,
+    Int n,
+    Entry *X,               // size m-by-n with leading dimension m
+
+    // blocks and workspace
+    Int xchunk,
+    int nthreads,
+    Entry *H_Tau,
+    Int *H_start,
+    Int *H_end,
+    Entry *V,
+    Entry *C,
+    Entry *W,
+    Int maxfn,
+    Int vsize,
+    Int csize,
+    Int wsize,
+    cholmod_common *cc
+)
+{
+    Int nx = (method <= SPQR_QX) ? n : m ;
+    Int nblocks = (nx + xchunk - 1) / xchunk ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+        if (nthreads > 1)
+    for (Int b = 0 ; b < nblocks ; b++)
+    {
+        int t = SUITESPARSE_OPENMP_GET_THREAD_ID ;
+        Int k1 = b * xchunk ;
+        Int k2 = MIN (k1 + xchunk, nx) ;
+        Entry *Xb = (method <= SPQR_QX) ? (X + k1*m) : (X + k1) ;
+        Int mb = (method <= SPQR_QX) ? m : (k2-k1) ;
+        Int nb = (method <= SPQR_QX) ? (k2-k1) : n ;
+        spqr_private_Happly (method, QR, hchunk, mb, nb, Xb, m,
+            H_Tau + t*maxfn, H_start + t*maxfn, H_end + t*maxfn,
+            V + t*vsize, C + t*csize, W + t*wsize, cc) ;
+    }
+}
+
+
 // =============================================================================
 // === SuiteSparseQR_qmult (dense case) ========================================
 // =============================================================================
 
 // Applies Q in Householder form (as stored in the QR factorization object
-// returned by SuiteSparseQR_factorize) to a dense matrix X.
+// returned by SuiteSparseQR_factorize) to a dense matrix X.  Q is not
+// available from a QR object returned by SuiteSparseQR_stream_finish.
 //
 //  method SPQR_QTX (0): Y = Q'*X
 //  method SPQR_QX  (1): Y = Q*X
@@ -1251,12 +1788,20 @@ template <typename Entry, typename Int> void spqr_private_Happly
 #define FREE_WORK \
 { \
     spqr_free_dense <Int> (&Zdense, cc) ; \
+    FREE_THREAD_WORK ; \
+}
+
+#define FREE_THREAD_WORK \
+{ \
     spqr_free_dense <Int> (&Vdense, cc) ; \
     spqr_free_dense <Int> (&Wdense, cc) ; \
     spqr_free_dense <Int> (&Cdense, cc) ; \
-    spqr_free <Int> (maxfn, sizeof (Entry), H_Tau,   cc) ; \
-    spqr_free <Int> (maxfn, sizeof (Int),  H_start, cc) ; \
-    spqr_free <Int> (maxfn, sizeof (Int),  H_end,   cc) ; \
+    spqr_free <Int> (nthreads, maxfn * sizeof (Entry), H_Tau,   cc) ; \
+    spqr_free <Int> (nthreads, maxfn * sizeof (Int),  H_start, cc) ; \
+    spqr_free <Int> (nthreads, maxfn * sizeof (Int),  H_end,   cc) ; \
+    H_Tau = NULL ; \
+    H_start = NULL ; \
+    H_end = NULL ; \
 }
 
 // returns Y of size m-by-n, or NULL on failure
@@ -1274,7 +1819,9 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
     cholmod_dense *Ydense, *Cdense, *Vdense, *Wdense, *Zdense ;
     Entry *X, *Y, *X1, *Y1, *Z1, *C, *V, *Z, *W, *H_Tau ;
     Int *HPinv, *H_start, *H_end ;
-    Int i, k, mh, v, hchunk, ldx, m, n, maxfn, ok ;
+    Int i, k, mh, v, hchunk, ldx, m, n, maxfn, ok, xchunk, csize, vsize,
+        wsize ;
+    int nthreads = 1 ;
 
     // -------------------------------------------------------------------------
     // get inputs
@@ -1289,6 +1836,14 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
     RETURN_IF_XTYPE_INVALID (Xdense, NULL) ;
     cc->status = CHOLMOD_OK ;
 
+    if (QR->qless)
+    {
+        // the Householder vectors of a QR object from
+        // SuiteSparseQR_stream_finish are those of R, not A
+        ERROR (CHOLMOD_INVALID, "Q not available from a stream QR object") ;
+        return (NULL) ;
+    }
+
     // get HPinv from QR->HP1inv if singletons exist, else QR->QRnum->HPinv
     HPinv = (QR->n1cols > 0) ? QR->HP1inv : QR->QRnum->HPinv ;
 
@@ -1350,6 +1905,12 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
 
     Z = NULL ;
     Zdense = NULL ;
+    Cdense = NULL ;
+    Vdense = NULL ;
+    Wdense = NULL ;
+    H_Tau = NULL ;
+    H_start = NULL ;
+    H_end = NULL ;
     ok = TRUE ;
     if (method == SPQR_QX || method == SPQR_XQT)
     {
@@ -1358,20 +1919,7 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         ok = (Zdense != NULL) ;
     }
 
-    hchunk = HCHUNK ;
-    ASSERT (v <= mh) ;
-
-    // C is workspace of size v-by-n or m-by-v
-    Cdense = spqr_allocate_dense <Int> (v, (method <= SPQR_QX) ? n : m,
-        v, xtype, cc) ;
-    Vdense = NULL ;
-    Wdense = NULL ;
-
-    H_Tau   = (Entry *) spqr_malloc <Int> (maxfn, sizeof (Entry), cc) ;
-    H_start = (Int *)  spqr_malloc <Int> (maxfn, sizeof (Int),  cc) ;
-    H_end   = (Int *)  spqr_malloc <Int> (maxfn, sizeof (Int),  cc) ;
-
-    if (!ok || Cdense == NULL || cc->status < CHOLMOD_OK)
+    if (!ok)
     {
         // out of memory; free workspace and result Y
         ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
@@ -1402,43 +1950,59 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
     }
 
     // -------------------------------------------------------------------------
-    // allocate O(hchunk) workspace
+    // allocate O(hchunk) workspace for each thread
     // -------------------------------------------------------------------------
 
-    // V is workspace of size v-by-hchunk
-    Vdense = spqr_allocate_dense <Int> (v, hchunk, v, xtype, cc) ;
+    // The Householder vectors are applied to X in blocks of xchunk columns
+    // (methods 0,1) or rows (methods 2,3), in parallel.  Each thread needs
+    // its own V, C, W, H_Tau, H_start, and H_end workspace for one block.
 
-    // W is workspace of size h*h+n*h or h*h+m*h where h = hchunk
-    Wdense = spqr_allocate_dense <Int> (hchunk,
-        hchunk + ((method <= SPQR_QX) ? n : m), hchunk, xtype, cc) ;
-
-    // -------------------------------------------------------------------------
-    // punt if out of memory
-    // -------------------------------------------------------------------------
+    xchunk = spqr_happly_blocks ((method <= SPQR_QX) ? n : m, &nthreads, cc) ;
+    hchunk = HCHUNK ;
+    ASSERT (v <= mh) ;
 
-    if (Vdense == NULL || Wdense == NULL)
+    for (int punt = 0 ; punt <= 1 ; punt++)
     {
-        // PUNT: out of memory; try again with hchunk = 1
-        cc->status = CHOLMOD_OK ;
-        hchunk = 1 ;
-
-        spqr_free_dense <Int> (&Vdense, cc) ;
-        spqr_free_dense <Int> (&Wdense, cc) ;
-
-        Vdense = spqr_allocate_dense <Int> (v, hchunk, v, xtype, cc) ;
-        Wdense = spqr_allocate_dense <Int> (hchunk,
-            hchunk + ((method <= SPQR_QX) ? n : m), hchunk, xtype, cc) ;
+        if (punt)
+        {
+            // PUNT: out of memory; try again with one thread and hchunk = 1
+            FREE_THREAD_WORK ;
+            cc->status = CHOLMOD_OK ;
+            nthreads = 1 ;
+            hchunk = 1 ;
+        }
 
-        if (Vdense == NULL || Wdense == NULL)
+        // C is v-by-xchunk or xchunk-by-v, V is v-by-hchunk, and W is of size
+        // h*h+xchunk*h where h = hchunk, for each thread
+        csize = v * xchunk ;
+        vsize = v * hchunk ;
+        wsize = hchunk * (hchunk + xchunk) ;
+        Cdense = spqr_allocate_dense <Int> (csize, nthreads, csize, xtype, cc) ;
+        Vdense = spqr_allocate_dense <Int> (vsize, nthreads, vsize, xtype, cc) ;
+        Wdense = spqr_allocate_dense <Int> (wsize, nthreads, wsize, xtype, cc) ;
+        H_Tau   = (Entry *) spqr_malloc <Int> (nthreads, maxfn * sizeof (Entry),
+            cc) ;
+        H_start = (Int *) spqr_malloc <Int> (nthreads, maxfn * sizeof (Int),
+            cc) ;
+        H_end   = (Int *) spqr_malloc <Int> (nthreads, maxfn * sizeof (Int),
+            cc) ;
+        ok = (Cdense != NULL && Vdense != NULL && Wdense != NULL &&
+            H_Tau != NULL && H_start != NULL && H_end != NULL) ;
+        if (ok)
         {
-            // out of memory; free workspace and result Y
-            ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
-            spqr_free_dense <Int> (&Ydense, cc) ;
-            FREE_WORK ;
-            return (NULL) ;
+            break ;
         }
     }
 
+    if (!ok)
+    {
+        // out of memory; free workspace and result Y
+        ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
+        spqr_free_dense <Int> (&Ydense, cc) ;
+        FREE_WORK ;
+        return (NULL) ;
+    }
+
     // the dimension (->nrow, ->ncol, and ->d) of this workspace is not used,
     // just the arrays themselves.
     V = (Entry *) Vdense->x ;
@@ -1472,8 +2036,9 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         }
 
         // apply H to Y
-        spqr_private_Happly (method, QR, hchunk, m, n, Y, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly_blocks (method, QR, hchunk, m, n, Y, xchunk,
+            nthreads, H_Tau, H_start, H_end, V, C, W, maxfn, vsize, csize,
+            wsize, cc) ;
 
     }
     else if (method == SPQR_QX)
@@ -1484,8 +2049,9 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         // ---------------------------------------------------------------------
 
         // apply H to Z
-        spqr_private_Happly (method, QR, hchunk, m, n, Z, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly_blocks (method, QR, hchunk, m, n, Z, xchunk,
+            nthreads, H_Tau, H_start, H_end, V, C, W, maxfn, vsize, csize,
+            wsize, cc) ;
 
         // Y = Z (P,:)
         Z1 = Z ;
@@ -1509,8 +2075,9 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         // ---------------------------------------------------------------------
 
         // apply H to Z
-        spqr_private_Happly (method, QR, hchunk, m, n, Z, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly_blocks (method, QR, hchunk, m, n, Z, xchunk,
+            nthreads, H_Tau, H_start, H_end, V, C, W, maxfn, vsize, csize,
+            wsize, cc) ;
 
         // Y = Z (:,P)
         Y1 = Y ;
@@ -1545,8 +2112,9 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         }
 
         // apply H to Y
-        spqr_private_Happly (method, QR, hchunk, m, n, Y, H_Tau, H_start, H_end,
-            V, C, W, cc) ;
+        spqr_private_Happly_blocks (method, QR, hchunk, m, n, Y, xchunk,
+            nthreads, H_Tau, H_start, H_end, V, C, W, maxfn, vsize, csize,
+            wsize, cc) ;
 
     }
 
@@ -1598,6 +2166,26 @@ template cholmod_dense *SuiteSparseQR_qmult <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_qmult <float, int32_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_qmult <FComplex, int32_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template cholmod_dense *SuiteSparseQR_qmult <Complex, int64_t>
 (
     // inputs, not modified
@@ -1608,6 +2196,26 @@ template cholmod_dense *SuiteSparseQR_qmult <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_qmult <float, int64_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_qmult <FComplex, int64_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 // =============================================================================
 // === SuiteSparseQR_qmult (sparse case) =======================================
@@ -1633,6 +2241,12 @@ template <typename Entry, typename Int> cholmod_sparse *SuiteSparseQR_qmult
     RETURN_IF_XTYPE_INVALID (Xsparse, NULL) ;
     cc->status = CHOLMOD_OK ;
 
+    if (QR->qless)
+    {
+        ERROR (CHOLMOD_INVALID, "Q not available from a stream QR object") ;
+        return (NULL) ;
+    }
+
     Xdense = spqr_sparse_to_dense <Int> (Xsparse, cc) ;
     Ydense = SuiteSparseQR_qmult <Entry, Int> (method, QR, Xdense, cc) ;
     spqr_free_dense <Int> (&Xdense, cc) ;
@@ -1674,6 +2288,24 @@ template cholmod_sparse *SuiteSparseQR_qmult <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_qmult <float, int32_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    cholmod_sparse *Xsparse,    // size m-by-n
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_qmult <FComplex, int32_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    cholmod_sparse *Xsparse,    // size m-by-n
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template cholmod_sparse *SuiteSparseQR_qmult <Complex, int64_t>
 (
     // inputs, not modified
@@ -1683,6 +2315,24 @@ template cholmod_sparse *SuiteSparseQR_qmult <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_qmult <float, int64_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    cholmod_sparse *Xsparse,    // size m-by-n
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_qmult <FComplex, int64_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    cholmod_sparse *Xsparse,    // size m-by-n
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 // =============================================================================
 // === SuiteSparseQR_free ======================================================
@@ -1717,11 +2367,31 @@ template int SuiteSparseQR_free <Complex, int32_t>
     SuiteSparseQR_factorization <Complex, int32_t> **QR,
     cholmod_common *cc
 ) ;
+template int SuiteSparseQR_free <float, int32_t>
+(
+    SuiteSparseQR_factorization <float, int32_t> **QR,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_free <FComplex, int32_t>
+(
+    SuiteSparseQR_factorization <FComplex, int32_t> **QR,
+    cholmod_common *cc
+) ;
 template int SuiteSparseQR_free <Complex, int64_t>
 (
     SuiteSparseQR_factorization <Complex, int64_t> **QR,
     cholmod_common *cc
 ) ;
+template int SuiteSparseQR_free <float, int64_t>
+(
+    SuiteSparseQR_factorization <float, int64_t> **QR,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_free <FComplex, int64_t>
+(
+    SuiteSparseQR_factorization <FComplex, int64_t> **QR,
+    cholmod_common *cc
+) ;
 
 // =============================================================================
 // === SuiteSparseQR_min2norm ==================================================
@@ -1819,6 +2489,22 @@ template cholmod_dense *SuiteSparseQR_min2norm <Complex, int32_t>
     cholmod_dense *B,
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_min2norm <float, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_min2norm <FComplex, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    cholmod_common *cc
+) ;
 template cholmod_dense *SuiteSparseQR_min2norm <Complex, int64_t>
 (
     int ordering,           // all, except 3:given treated as 0:fixed
@@ -1827,6 +2513,22 @@ template cholmod_dense *SuiteSparseQR_min2norm <Complex, int64_t>
     cholmod_dense *B,
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_min2norm <float, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_min2norm <FComplex, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    cholmod_common *cc
+) ;
 
 // =============================================================================
 // === SuiteSparseQR_min2norm (sparse case) ====================================
@@ -1897,6 +2599,22 @@ template cholmod_sparse *SuiteSparseQR_min2norm <Complex, int32_t>
     cholmod_sparse *Bsparse,
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_min2norm <float, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_sparse *Bsparse,
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_min2norm <FComplex, int32_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_sparse *Bsparse,
+    cholmod_common *cc
+) ;
 template cholmod_sparse *SuiteSparseQR_min2norm <Complex, int64_t>
 (
     int ordering,           // all, except 3:given treated as 0:fixed
@@ -1905,5 +2623,21 @@ template cholmod_sparse *SuiteSparseQR_min2norm <Complex, int64_t>
     cholmod_sparse *Bsparse,
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_min2norm <float, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_sparse *Bsparse,
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_min2norm <FComplex, int64_t>
+(
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,
+    cholmod_sparse *A,
+    cholmod_sparse *Bsparse,
+    cholmod_common *cc
+) ;
 
 #endif
@@ -0,0 +1,298 @@
+// =============================================================================
+// === SuiteSparseQR_mixed =====================================================
+// =============================================================================
+
+// SPQR, Copyright (c) 2008-2022, Timothy A Davis. All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+// Mixed-precision least-squares solution of A*X=B.  A and B are double (or
+// double complex), and so is the solution X, but the QR factorization is
+// computed in single precision, which halves the memory required for R and
+// the Householder vectors, and the memory traffic of the factorization.
+//
+// The single-precision solution X is refined with the corrected seminormal
+// equations (CSNE).  Each refinement step computes the residual R = B - A*X
+// and the correction G = A'*R in double precision, and then solves
+// (E*Rf'*Rf*E') * DX = G with the single-precision factor Rf, and E its column
+// permutation.  The normal equations are never formed.
+//
+// Refinement stops when the correction DX is small compared with X, when it
+// no longer decreases by a factor of two or more from one step to the next,
+// or after maxrefine steps.  The limiting accuracy is the same as a double-
+// precision factorization, as long as the 2-norm condition number of A is
+// well below 1/sqrt(eps) in single precision (about 4000); for worse
+// conditioned problems, use SuiteSparseQR in double precision instead.
+//
+// If A is rank deficient, the solution is a basic solution, the same as the
+// one found by SuiteSparseQR.  The refinement is then done on the columns of
+// A that appear in the leading rank columns of R.
+
+#ifndef NEXPERT
+#include "spqr.hpp"
+
+// =============================================================================
+// === spqr_single =============================================================
+// =============================================================================
+
+// The single-precision type of the factorization, for each type of A.
+
+template <typename Entry> struct spqr_single ;
+template <> struct spqr_single <double>  { typedef float    type ; } ;
+template <> struct spqr_single <Complex> { typedef FComplex type ; } ;
+
+// =============================================================================
+// === spqr_private_convert ====================================================
+// =============================================================================
+
+// Y = X, converting each entry of X from type EntryX to type EntryY.  Y has
+// already been allocated, with the same dimensions as X.
+
+template <typename EntryY, typename EntryX, typename Int>
+static void spqr_private_convert
+(
+    cholmod_dense *X,       // input, not modified
+    cholmod_dense *Y        // output
+)
+{
+    Int m = X->nrow ;
+    Int n = X->ncol ;
+    Int ldx = X->d ;
+    Int ldy = Y->d ;
+    EntryX *Xx = (EntryX *) X->x ;
+    EntryY *Yx = (EntryY *) Y->x ;
+    for (Int j = 0 ; j < n ; j++)
+    {
+        for (Int i = 0 ; i < m ; i++)
+        {
+            Yx [i + j*ldy] = (EntryY) Xx [i + j*ldx] ;
+        }
+    }
+}
+
+// =============================================================================
+// === SuiteSparseQR_mixed =====================================================
+// =============================================================================
+
+#define FREE_WORK                                   \
+{                                                   \
+    SuiteSparseQR_free <Single, Int> (&QR, cc) ;    \
+    spqr_free_sparse <Int> (&Af, cc) ;              \
+    spqr_free_dense <Int> (&Bf, cc) ;               \
+    spqr_free_dense <Int> (&Y, cc) ;                \
+    spqr_free_dense <Int> (&Z, cc) ;                \
+    spqr_free_dense <Int> (&Resid, cc) ;            \
+    spqr_free_dense <Int> (&G, cc) ;                \
+}
+
+// returns X of size n-by-nrhs, or NULL on failure
+template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_mixed
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // columns with 2-norm <= tol treated as zero
+    int maxrefine,          // maximum number of refinement steps
+    cholmod_sparse *A,      // m-by-n sparse matrix, double or double complex
+    cholmod_dense *B,       // m-by-nrhs dense matrix, same type as A
+    // output, not defined on input
+    int *p_nrefine,         // number of refinement steps done (may be NULL)
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    typedef typename spqr_single <Entry>::type Single ;
+
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (A, NULL) ;
+    RETURN_IF_NULL (B, NULL) ;
+    int64_t xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (A, NULL) ;
+    RETURN_IF_XTYPE_INVALID (B, NULL) ;
+    if (A->nrow != B->nrow)
+    {
+        ERROR (CHOLMOD_INVALID, "mismatched A and B") ;
+        return (NULL) ;
+    }
+    cc->status = CHOLMOD_OK ;
+    if (p_nrefine != NULL)
+    {
+        *p_nrefine = 0 ;
+    }
+
+    Int n = A->ncol ;
+    Int nrhs = B->ncol ;
+    int64_t sxtype = spqr_type <Single> ( ) ;
+    SuiteSparseQR_factorization <Single, Int> *QR = NULL ;
+    cholmod_sparse *Af = NULL ;
+    cholmod_dense *Bf = NULL, *Y = NULL, *Z = NULL, *Resid = NULL, *G = NULL,
+        *X = NULL ;
+
+    // -------------------------------------------------------------------------
+    // QR factorization of A in single precision
+    // -------------------------------------------------------------------------
+
+    Af = spqr_copy <Int> (A, 0, 1, cc) ;
+    if (Af != NULL && !spqr_sparse_xtype <Int> ((int) sxtype, Af, cc))
+    {
+        spqr_free_sparse <Int> (&Af, cc) ;
+    }
+    if (Af == NULL)
+    {
+        ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
+        return (NULL) ;
+    }
+    QR = SuiteSparseQR_factorize <Single, Int> (ordering, tol, Af, cc) ;
+    spqr_free_sparse <Int> (&Af, cc) ;
+    if (QR == NULL)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // X = E*(Rf\(Qf'*B)) in single precision
+    // -------------------------------------------------------------------------
+
+    Bf = spqr_allocate_dense <Int> (B->nrow, nrhs, B->nrow, sxtype, cc) ;
+    X = spqr_allocate_dense <Int> (n, nrhs, n, xtype, cc) ;
+    Resid = spqr_allocate_dense <Int> (B->nrow, nrhs, B->nrow, xtype, cc) ;
+    G = spqr_allocate_dense <Int> (n, nrhs, n, xtype, cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        FREE_WORK ;
+        spqr_free_dense <Int> (&X, cc) ;
+        return (NULL) ;
+    }
+
+    spqr_private_convert <Single, Entry, Int> (B, Bf) ;
+    Y = SuiteSparseQR_qmult <Single, Int> (SPQR_QTX, QR, Bf, cc) ;
+    spqr_free_dense <Int> (&Bf, cc) ;
+    Z = SuiteSparseQR_solve <Single, Int> (SPQR_RETX_EQUALS_B, QR, Y, cc) ;
+    spqr_free_dense <Int> (&Y, cc) ;
+    if (Z == NULL)
+    {
+        // out of memory
+        FREE_WORK ;
+        spqr_free_dense <Int> (&X, cc) ;
+        return (NULL) ;
+    }
+    spqr_private_convert <Entry, Single, Int> (Z, X) ;
+    spqr_free_dense <Int> (&Z, cc) ;
+
+    // -------------------------------------------------------------------------
+    // refine X with the corrected seminormal equations
+    // -------------------------------------------------------------------------
+
+    Entry *Xx = (Entry *) X->x ;
+    double one [2] = {1,0}, minusone [2] = {-1,0}, zero [2] = {0,0} ;
+    double dxnorm_old = INFINITY ;
+    int nrefine = 0 ;
+
+    for ( ; nrefine < maxrefine ; nrefine++)
+    {
+
+        // Resid = B - A*X, and G = A'*Resid, in double precision
+        spqr_private_convert <Entry, Entry, Int> (B, Resid) ;
+        spqr_sdmult <Int> (A, 0, minusone, one, X, Resid, cc) ;
+        spqr_sdmult <Int> (A, 1, one, zero, Resid, G, cc) ;
+
+        // DX = E*(Rf\(Rf'\(E'*G))) in single precision
+        Bf = spqr_allocate_dense <Int> (n, nrhs, n, sxtype, cc) ;
+        if (Bf == NULL) break ;
+        spqr_private_convert <Single, Entry, Int> (G, Bf) ;
+        Y = SuiteSparseQR_solve <Single, Int> (SPQR_RTX_EQUALS_ETB, QR, Bf,
+            cc) ;
+        spqr_free_dense <Int> (&Bf, cc) ;
+        Z = SuiteSparseQR_solve <Single, Int> (SPQR_RETX_EQUALS_B, QR, Y, cc) ;
+        spqr_free_dense <Int> (&Y, cc) ;
+        if (Z == NULL) break ;
+
+        // stop if DX is not smaller than half the previous correction
+        Single *DXx = (Single *) Z->x ;
+        double dxnorm = 0, xnorm = 0 ;
+        for (Int k = 0 ; k < n * nrhs ; k++)
+        {
+            dxnorm = MAX (dxnorm, spqr_abs (DXx [k])) ;
+        }
+        if (!(dxnorm < 0.5 * dxnorm_old))
+        {
+            spqr_free_dense <Int> (&Z, cc) ;
+            break ;
+        }
+        dxnorm_old = dxnorm ;
+
+        // X = X + DX
+        for (Int k = 0 ; k < n * nrhs ; k++)
+        {
+            Xx [k] += (Entry) DXx [k] ;
+            xnorm = MAX (xnorm, spqr_abs (Xx [k])) ;
+        }
+        spqr_free_dense <Int> (&Z, cc) ;
+
+        // stop if DX is negligible
+        if (dxnorm <= DBL_EPSILON * xnorm)
+        {
+            nrefine++ ;
+            break ;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // free workspace and return result
+    // -------------------------------------------------------------------------
+
+    FREE_WORK ;
+    if (p_nrefine != NULL)
+    {
+        *p_nrefine = nrefine ;
+    }
+    // a refinement step that ran out of memory leaves X as it was, which
+    // is still a valid (if less accurate) solution
+    cc->status = CHOLMOD_OK ;
+    return (X) ;
+}
+
+template cholmod_dense *SuiteSparseQR_mixed <double, int32_t>
+(
+    int ordering,
+    double tol,
+    int maxrefine,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    int *p_nrefine,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_mixed <double, int64_t>
+(
+    int ordering,
+    double tol,
+    int maxrefine,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    int *p_nrefine,
+    cholmod_common *cc
+) ;
+
+template cholmod_dense *SuiteSparseQR_mixed <Complex, int32_t>
+(
+    int ordering,
+    double tol,
+    int maxrefine,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    int *p_nrefine,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_mixed <Complex, int64_t>
+(
+    int ordering,
+    double tol,
+    int maxrefine,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    int *p_nrefine,
+    cholmod_common *cc
+) ;
+#endif
@@ -32,6 +32,72 @@
 
 #define HCHUNK_DENSE 32        // FUTURE: make this an input parameter
 
+// =============================================================================
+// === spqr_private_happly_blocks ==============================================
+// =============================================================================
+
+// Applies H to the m-by-n matrix X (with leading dimension m) in blocks of
+// xchunk columns (methods 0,1) or rows (methods 2,3), using nthreads threads.
+// Thread t uses Wi [t*wisize ...] (with Wmap all EMPTY) and CV [t*cvsize ...]
+// as its workspace.
+
+template <typename Entry, typename Int> static void spqr_private_happly_blocks
+(
+    // inputs, not modified
+    int method,
+    Int m,
+    Int n,
+    Int nh,
+    Int *Hp,
+    Int *Hi,
+    Entry *Hx,
+    Entry *Tau,
+
+    // input/output
+    Entry *X,
+
+    // blocks and workspace
+    Int xchunk,
+    int nthreads,
+    Int vmax,
+    Int hchunk,
+    Int csize,
+    Int wisize,
+    Int cvsize,
+    Int *Wi,
+    Entry *CV,
+    cholmod_common *cc
+)
+{
+    Int nx = (method <= SPQR_QX) ? n : m ;
+    Int nblocks = (nx + xchunk - 1) / xchunk ;
+
+    #pragma omp parallel for num_threads(nthreads) schedule(dynamic,1) \
+        if (nthreads > 1)
+    for (Int b = 0 ; b < nblocks ; b++)
+    {
+        int t = SUITESPARSE_OPENMP_GET_THREAD_ID ;
+        Int *Wi_t = Wi + t * wisize ;
+        Int *Wmap_t = Wi_t + vmax ;
+        Entry *C_t = CV + t * cvsize ;
+        Entry *V_t = C_t + csize ;
+        Int k1 = b * xchunk ;
+        Int k2 = MIN (k1 + xchunk, nx) ;
+        if (method <= SPQR_QX)
+        {
+            // columns k1:k2-1 of X
+            spqr_happly (method, m, k2-k1, nh, Hp, Hi, Hx, Tau, X + k1*m, m,
+                vmax, hchunk, Wi_t, Wmap_t, C_t, V_t, cc) ;
+        }
+        else
+        {
+            // rows k1:k2-1 of X
+            spqr_happly (method, k2-k1, n, nh, Hp, Hi, Hx, Tau, X + k1, m,
+                vmax, hchunk, Wi_t, Wmap_t, C_t, V_t, cc) ;
+        }
+    }
+}
+
 // returns Y of size m-by-n, or NULL on failure
 template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
 (
@@ -47,10 +113,11 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
 )
 {
     cholmod_dense *Ydense ;
-    Entry *X, *Y, *X1, *Y1, *Z1, *Hx, *C, *V, *Z, *CV, *Tau ;
+    Entry *X, *Y, *X1, *Y1, *Z1, *Hx, *Z, *CV, *Tau ;
     Int *Hp, *Hi, *Wi, *Wmap ;
     Int i, k, zsize, nh, mh, vmax, hchunk, vsize, csize, cvsize, wisize, ldx,
-        m, n ;
+        m, n, xchunk ;
+    int nthreads ;
     int ok = TRUE ;
 
     // -------------------------------------------------------------------------
@@ -132,22 +199,10 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         // Z is needed only for methods SPQR_QX and SPQR_XQT
         Z = (Entry *) spqr_malloc <Int> (zsize, sizeof (Entry), cc) ;
     }
-
-    hchunk = MIN (HCHUNK_DENSE, nh) ;
-    ok = spqr_happly_work (method, m, n, nh, Hp, hchunk, &vmax, &vsize, &csize);
-
-    ASSERT (vmax <= mh) ;
-
-    wisize = mh + vmax ;
-    Wi = (Int *) spqr_malloc <Int> (wisize, sizeof (Int), cc) ;
-    Wmap = Wi + vmax ;              // Wmap is of size mh, Wi of size vmax
-
     if (cc->status < CHOLMOD_OK)
     {
-        // out of memory; free workspace and result Y
+        // out of memory; free result Y
         spqr_free_dense <Int> (&Ydense, cc) ;
-        spqr_free <Int> (zsize,  sizeof (Entry), Z,  cc) ;
-        spqr_free <Int> (wisize, sizeof (Int), Wi, cc) ;
         return (NULL) ;
     }
 
@@ -167,60 +222,73 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         }
     }
 
-    for (i = 0 ; i < mh ; i++)
-    {
-        Wmap [i] = EMPTY ;
-    }
-
     // -------------------------------------------------------------------------
-    // allocate O(hchunk) workspace
+    // allocate O(hchunk) workspace for each thread
     // -------------------------------------------------------------------------
 
-    // cvsize = csize + vsize ;
-    cvsize = spqr_add (csize, vsize, &ok) ;
-    CV = NULL ;
-
-    if (ok)
-    {
-        CV = (Entry *) spqr_malloc <Int> (cvsize, sizeof (Entry), cc) ;
-    }
+    // H is applied to X in blocks of xchunk columns (methods 0,1) or rows
+    // (methods 2,3), in parallel.  Each thread needs its own Wi, Wmap, C, and
+    // V workspace for one block.
 
-    // -------------------------------------------------------------------------
-    // punt if out of memory
-    // -------------------------------------------------------------------------
+    xchunk = spqr_happly_blocks ((method <= SPQR_QX) ? n : m, &nthreads, cc) ;
+    hchunk = MIN (HCHUNK_DENSE, nh) ;
+    Wi = NULL ;
+    CV = NULL ;
 
-    if (!ok || cc->status < CHOLMOD_OK)
+    for (int punt = 0 ; punt <= 1 ; punt++)
     {
-        // PUNT: out of memory; try again with hchunk = 1
-        cc->status = CHOLMOD_OK ;
-        ok = TRUE ;
-        hchunk = 1 ;
-        ok = spqr_happly_work (method, m, n, nh, Hp, hchunk,
-            &vmax, &vsize, &csize) ;
-        // note that vmax has changed, but wisize is left as-is
-        // cvsize = csize + vsize ;
+        if (punt)
+        {
+            // PUNT: out of memory; try again with one thread and hchunk = 1
+            cc->status = CHOLMOD_OK ;
+            nthreads = 1 ;
+            hchunk = 1 ;
+        }
+        ok = (method <= SPQR_QX) ?
+            spqr_happly_work (method, m, xchunk, nh, Hp, hchunk,
+                &vmax, &vsize, &csize) :
+            spqr_happly_work (method, xchunk, n, nh, Hp, hchunk,
+                &vmax, &vsize, &csize) ;
+        ASSERT (vmax <= mh) ;
+
+        // wisize = mh + vmax, cvsize = csize + vsize, for each thread
+        wisize = spqr_add (mh, vmax, &ok) ;
         cvsize = spqr_add (csize, vsize, &ok) ;
         if (ok)
         {
-            CV = (Entry *) spqr_malloc <Int> (cvsize, sizeof (Entry), cc) ;
+            Wi = (Int *) spqr_malloc <Int> (nthreads, wisize * sizeof (Int),
+                cc) ;
+            CV = (Entry *) spqr_malloc <Int> (nthreads,
+                cvsize * sizeof (Entry), cc) ;
         }
-        if (!ok || cc->status < CHOLMOD_OK)
+        if (ok && Wi != NULL && CV != NULL)
         {
-            // out of memory (or problem too large); free workspace and result Y
-            spqr_free_dense <Int> (&Ydense, cc) ;
-            spqr_free <Int> (zsize,  sizeof (Entry), Z,  cc) ;
-            spqr_free <Int> (wisize, sizeof (Int), Wi, cc) ;
-            ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
-            return (NULL) ;
+            break ;
         }
+        spqr_free <Int> (nthreads, wisize * sizeof (Int), Wi, cc) ;
+        spqr_free <Int> (nthreads, cvsize * sizeof (Entry), CV, cc) ;
+        Wi = NULL ;
+        CV = NULL ;
     }
 
-    // -------------------------------------------------------------------------
-    // split up workspace
-    // -------------------------------------------------------------------------
+    if (CV == NULL)
+    {
+        // out of memory (or problem too large); free workspace and result Y
+        spqr_free_dense <Int> (&Ydense, cc) ;
+        spqr_free <Int> (zsize,  sizeof (Entry), Z,  cc) ;
+        ERROR (CHOLMOD_OUT_OF_MEMORY, "out of memory") ;
+        return (NULL) ;
+    }
 
-    C = CV ;            // size csize
-    V = C + csize ;     // size vsize
+    for (int t = 0 ; t < nthreads ; t++)
+    {
+        // Wmap for thread t is of size mh, and Wi of size vmax
+        Wmap = Wi + t * wisize + vmax ;
+        for (i = 0 ; i < mh ; i++)
+        {
+            Wmap [i] = EMPTY ;
+        }
+    }
 
     // -------------------------------------------------------------------------
     // Y = Q'*X, Q*X, X*Q, or X*Q'
@@ -254,8 +322,8 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         }
 
         // apply H to Y
-        spqr_happly (method, m, n, nh, Hp, Hi, Hx, Tau, Y,
-            vmax, hchunk, Wi, Wmap, C, V, cc) ;
+        spqr_private_happly_blocks (method, m, n, nh, Hp, Hi, Hx, Tau, Y,
+            xchunk, nthreads, vmax, hchunk, csize, wisize, cvsize, Wi, CV, cc) ;
 
     }
     else if (method == SPQR_QX)
@@ -266,8 +334,8 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         // ---------------------------------------------------------------------
 
         // apply H to Z
-        spqr_happly (method, m, n, nh, Hp, Hi, Hx, Tau, Z,
-            vmax, hchunk, Wi, Wmap, C, V, cc) ;
+        spqr_private_happly_blocks (method, m, n, nh, Hp, Hi, Hx, Tau, Z,
+            xchunk, nthreads, vmax, hchunk, csize, wisize, cvsize, Wi, CV, cc) ;
 
         // Y = Z (P,:)
         Z1 = Z ;
@@ -291,8 +359,8 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         // ---------------------------------------------------------------------
 
         // apply H to Z
-        spqr_happly (method, m, n, nh, Hp, Hi, Hx, Tau, Z,
-            vmax, hchunk, Wi, Wmap, C, V, cc) ;
+        spqr_private_happly_blocks (method, m, n, nh, Hp, Hi, Hx, Tau, Z,
+            xchunk, nthreads, vmax, hchunk, csize, wisize, cvsize, Wi, CV, cc) ;
 
         // Y = Z (:,P)
         Y1 = Y ;
@@ -329,17 +397,17 @@ template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_qmult
         }
 
         // apply H to Y
-        spqr_happly (method, m, n, nh, Hp, Hi, Hx, Tau, Y,
-            vmax, hchunk, Wi, Wmap, C, V, cc) ;
+        spqr_private_happly_blocks (method, m, n, nh, Hp, Hi, Hx, Tau, Y,
+            xchunk, nthreads, vmax, hchunk, csize, wisize, cvsize, Wi, CV, cc) ;
     }
 
     // -------------------------------------------------------------------------
     // free workspace and return Y
     // -------------------------------------------------------------------------
 
-    spqr_free <Int> (cvsize, sizeof (Entry), CV, cc) ;
+    spqr_free <Int> (nthreads, cvsize * sizeof (Entry), CV, cc) ;
     spqr_free <Int> (zsize,  sizeof (Entry), Z,  cc) ;
-    spqr_free <Int> (wisize, sizeof (Int), Wi, cc) ;
+    spqr_free <Int> (nthreads, wisize * sizeof (Int), Wi, cc) ;
 
     if (sizeof (SUITESPARSE_BLAS_INT) < sizeof (Int) && !cc->blas_ok)
     {
@@ -393,6 +461,30 @@ template cholmod_dense *SuiteSparseQR_qmult <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_qmult <float, int64_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    cholmod_sparse *H,      // either m-by-nh or n-by-nh
+    cholmod_dense *HTau,    // size 1-by-nh
+    int64_t *HPinv,            // size mh
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_qmult <FComplex, int64_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    cholmod_sparse *H,      // either m-by-nh or n-by-nh
+    cholmod_dense *HTau,    // size 1-by-nh
+    int64_t *HPinv,            // size mh
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template cholmod_dense *SuiteSparseQR_qmult <Complex, int32_t>
 (
     // inputs, not modified
@@ -405,6 +497,30 @@ template cholmod_dense *SuiteSparseQR_qmult <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_dense *SuiteSparseQR_qmult <float, int32_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    cholmod_sparse *H,      // either m-by-nh or n-by-nh
+    cholmod_dense *HTau,    // size 1-by-nh
+    int32_t *HPinv,            // size mh
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_qmult <FComplex, int32_t>
+(
+    // inputs, not modified
+    int method,             // 0,1,2,3
+    cholmod_sparse *H,      // either m-by-nh or n-by-nh
+    cholmod_dense *HTau,    // size 1-by-nh
+    int32_t *HPinv,            // size mh
+    cholmod_dense *Xdense,  // size m-by-n with leading dimension ldx
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 // =============================================================================
 // === SuiteSparseQR_qmult (sparse) ============================================
@@ -635,7 +751,7 @@ template <typename Entry, typename Int> cholmod_sparse *SuiteSparseQR_qmult
 
             // apply H to W
 
-            spqr_happly (method, m, k2-k1, nh, Hp, Hi, Hx, Tau, W,
+            spqr_happly (method, m, k2-k1, nh, Hp, Hi, Hx, Tau, W, m,
                 vmax, hchunk, Wi, Wmap, C, V, cc) ;
 
             // append W onto Y
@@ -687,7 +803,7 @@ template <typename Entry, typename Int> cholmod_sparse *SuiteSparseQR_qmult
             }
 
             // apply H to W
-            spqr_happly (method, m, k2-k1, nh, Hp, Hi, Hx, Tau, W,
+            spqr_happly (method, m, k2-k1, nh, Hp, Hi, Hx, Tau, W, m,
                 vmax, hchunk, Wi, Wmap, C, V, cc) ;
 
             // append W (P,:) onto Y
@@ -768,6 +884,30 @@ template cholmod_sparse *SuiteSparseQR_qmult <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_qmult <float, int32_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    cholmod_sparse *H,          // size m-by-nh or n-by-nh
+    cholmod_dense *HTau,        // size 1-by-nh
+    int32_t *HPinv,                // size mh
+    cholmod_sparse *Xsparse,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_qmult <FComplex, int32_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    cholmod_sparse *H,          // size m-by-nh or n-by-nh
+    cholmod_dense *HTau,        // size 1-by-nh
+    int32_t *HPinv,                // size mh
+    cholmod_sparse *Xsparse,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template cholmod_sparse *SuiteSparseQR_qmult <Complex, int64_t>
 (
     // inputs, not modified
@@ -780,3 +920,27 @@ template cholmod_sparse *SuiteSparseQR_qmult <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template cholmod_sparse *SuiteSparseQR_qmult <float, int64_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    cholmod_sparse *H,          // size m-by-nh or n-by-nh
+    cholmod_dense *HTau,        // size 1-by-nh
+    int64_t *HPinv,                // size mh
+    cholmod_sparse *Xsparse,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template cholmod_sparse *SuiteSparseQR_qmult <FComplex, int64_t>
+(
+    // inputs, not modified
+    int method,                 // 0,1,2,3
+    cholmod_sparse *H,          // size m-by-nh or n-by-nh
+    cholmod_dense *HTau,        // size 1-by-nh
+    int64_t *HPinv,                // size mh
+    cholmod_sparse *Xsparse,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
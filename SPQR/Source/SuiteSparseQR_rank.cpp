@@ -0,0 +1,308 @@
+// =============================================================================
+// === SuiteSparseQR_rank ======================================================
+// =============================================================================
+
+// SPQR, Copyright (c) 2008-2022, Timothy A Davis. All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+// Rank-revealing QR factorization, and a null-space basis from it.
+//
+//  SuiteSparseQR_rank_factorize    QR factorization with column pivoting
+//  SuiteSparseQR_nullspace         null-space basis N of A, with A*N ~ 0
+//
+// Heath's method (used by SuiteSparseQR by default) flags a column as dead
+// when its norm falls below tol at the time it is reduced, but it does not
+// choose the order in which the columns are reduced.  The rank can then be
+// overestimated, if many columns of moderate norm are accepted before the
+// dependency among them shows up.  SuiteSparseQR_rank_factorize adds
+// restricted column pivoting within each front: before a pivot column is
+// reduced, it is swapped with the remaining pivot column of largest norm that
+// fits in its staircase (see spqr_front).  The swap never causes fill, so the
+// symbolic analysis (and the memory usage) are the same as without pivoting.
+// Pivoting is not done across fronts, so this is not a full rank-revealing QR,
+// but within each front it behaves like LAPACK's dgeqp3.
+//
+// The estimated rank is QR->rank.  The QR object can be used with
+// SuiteSparseQR_solve, SuiteSparseQR_qmult, and SuiteSparseQR_numeric (which
+// keeps pivoting when refactorizing the matrix).
+//
+// With A*E = Q*[R11 R12 ; 0 R22], where R22 holds the dead columns (and is
+// dropped), the null-space basis is N = E*[-R11\R12 ; I], with one column for
+// each dead column of R.  Since R12 is the first rank rows of Q'*A*E for the
+// dead columns, N is computed from the factorization with one application of
+// Q' and one solve with R11, via SuiteSparseQR_qmult and SuiteSparseQR_solve.
+// The norm of A*N (:,k) is the norm of the kth dropped column of R22, which is
+// below tol unless pivoting later increased it.  SuiteSparseQR_nullspace can
+// be used with any QR factorization of A that keeps the Householder vectors,
+// but the basis is better conditioned if the columns were pivoted.
+
+#ifndef NEXPERT
+#include "spqr.hpp"
+
+// =============================================================================
+// === SuiteSparseQR_rank_factorize ============================================
+// =============================================================================
+
+// Returns the QR factorization of A with column pivoting within each front, or
+// NULL on failure.  No singletons are exploited.
+
+template <typename Entry, typename Int>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_rank_factorize
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // treat columns with 2-norm <= tol as zero
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (A, NULL) ;
+    int64_t xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (A, NULL) ;
+    cc->status = CHOLMOD_OK ;
+
+    // symbolic analysis, with rank detection
+    SuiteSparseQR_factorization <Entry, Int> *QR ;
+    QR = SuiteSparseQR_symbolic <Entry, Int> (ordering, TRUE, A, cc) ;
+    if (QR == NULL)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+
+    // numeric factorization, with column pivoting in each front
+    QR->QRsym->do_pivoting = TRUE ;
+    if (!SuiteSparseQR_numeric <Entry, Int> (tol, A, QR, cc))
+    {
+        // out of memory
+        SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+        return (NULL) ;
+    }
+    return (QR) ;
+}
+
+template SuiteSparseQR_factorization <double, int32_t>
+*SuiteSparseQR_rank_factorize <double, int32_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <Complex, int32_t>
+*SuiteSparseQR_rank_factorize <Complex, int32_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int32_t>
+*SuiteSparseQR_rank_factorize <float, int32_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int32_t>
+*SuiteSparseQR_rank_factorize <FComplex, int32_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <double, int64_t>
+*SuiteSparseQR_rank_factorize <double, int64_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <Complex, int64_t>
+*SuiteSparseQR_rank_factorize <Complex, int64_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int64_t>
+*SuiteSparseQR_rank_factorize <float, int64_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int64_t>
+*SuiteSparseQR_rank_factorize <FComplex, int64_t>
+(
+    int ordering,
+    double tol,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === SuiteSparseQR_nullspace =================================================
+// =============================================================================
+
+// Returns N of size n-by-(n-rank), or NULL on failure.  Column k of N is
+// E*[-R11\R12(:,k) ; e_k], which is one in the row of the kth dead column of
+// A (that is, column QR->RmapInv [rank+k] of R), zero in the rows of the
+// other dead columns, and has nonzeros only in the rows of live columns
+// otherwise.
+
+template <typename Entry, typename Int> cholmod_dense *SuiteSparseQR_nullspace
+(
+    // inputs, not modified
+    SuiteSparseQR_factorization <Entry, Int> *QR, // of an m-by-n sparse A
+    cholmod_sparse *A,      // the matrix that was factorized
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (QR, NULL) ;
+    RETURN_IF_NULL (QR->QRnum, NULL) ;
+    RETURN_IF_NULL (A, NULL) ;
+    int64_t xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (A, NULL) ;
+    if ((Int) A->nrow != QR->narows || (Int) A->ncol != QR->nacols
+        || QR->bncols > 0)
+    {
+        ERROR (CHOLMOD_INVALID, "A and QR do not match") ;
+        return (NULL) ;
+    }
+    cc->status = CHOLMOD_OK ;
+
+    Int m = QR->narows ;
+    Int n = QR->nacols ;
+    Int rank = QR->rank ;
+    Int nnull = n - rank ;
+    Int *Q1fill = QR->Q1fill ;
+    Int *RmapInv = QR->RmapInv ;
+
+    if (nnull == 0)
+    {
+        // A has full column rank
+        return (spqr_zeros <Int> (n, 0, xtype, cc)) ;
+    }
+    ASSERT (RmapInv != NULL) ;
+
+    // -------------------------------------------------------------------------
+    // Ad = A (:, dead columns)
+    // -------------------------------------------------------------------------
+
+    cholmod_dense *Ad = spqr_zeros <Int> (m, nnull, xtype, cc) ;
+    if (Ad == NULL)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+
+    Int *Ap = (Int *) A->p ;
+    Int *Ai = (Int *) A->i ;
+    Int *Anz = (Int *) A->nz ;
+    Entry *Ax = (Entry *) A->x ;
+    Entry *Adx = (Entry *) Ad->x ;
+    for (Int k = 0 ; k < nnull ; k++)
+    {
+        Int j = RmapInv [rank + k] ;
+        Int col = Q1fill ? Q1fill [j] : j ;
+        Int pend = A->packed ? Ap [col+1] : Ap [col] + Anz [col] ;
+        for (Int p = Ap [col] ; p < pend ; p++)
+        {
+            Adx [Ai [p] + k*m] += Ax [p] ;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // N = E*(R11\(first rank rows of Q'*Ad))
+    // -------------------------------------------------------------------------
+
+    cholmod_dense *Y = SuiteSparseQR_qmult <Entry, Int> (SPQR_QTX, QR, Ad, cc) ;
+    spqr_free_dense <Int> (&Ad, cc) ;
+    cholmod_dense *N = SuiteSparseQR_solve <Entry, Int> (SPQR_RETX_EQUALS_B,
+        QR, Y, cc) ;
+    spqr_free_dense <Int> (&Y, cc) ;
+    if (N == NULL)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // N = E(:,dead columns) - N
+    // -------------------------------------------------------------------------
+
+    Entry *Nx = (Entry *) N->x ;
+    for (Int k = 0 ; k < nnull ; k++)
+    {
+        Entry *Nk = Nx + k*n ;
+        for (Int i = 0 ; i < n ; i++)
+        {
+            Nk [i] = -Nk [i] ;
+        }
+        Int j = RmapInv [rank + k] ;
+        Nk [Q1fill ? Q1fill [j] : j] = 1 ;
+    }
+    return (N) ;
+}
+
+template cholmod_dense *SuiteSparseQR_nullspace <double, int32_t>
+(
+    SuiteSparseQR_factorization <double, int32_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_nullspace <Complex, int32_t>
+(
+    SuiteSparseQR_factorization <Complex, int32_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_nullspace <float, int32_t>
+(
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_nullspace <FComplex, int32_t>
+(
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_nullspace <double, int64_t>
+(
+    SuiteSparseQR_factorization <double, int64_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_nullspace <Complex, int64_t>
+(
+    SuiteSparseQR_factorization <Complex, int64_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_nullspace <float, int64_t>
+(
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+template cholmod_dense *SuiteSparseQR_nullspace <FComplex, int64_t>
+(
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    cholmod_sparse *A,
+    cholmod_common *cc
+) ;
+#endif
@@ -0,0 +1,869 @@
+// =============================================================================
+// === SuiteSparseQR_serialize =================================================
+// =============================================================================
+
+// SPQR, Copyright (c) 2008-2022, Timothy A Davis. All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+// Save a QR factorization into a single contiguous blob, and create a QR
+// object from a blob without copying its contents.
+//
+//  SuiteSparseQR_serialize_size    size of the blob for a QR factorization
+//  SuiteSparseQR_serialize         write the QR factorization into a blob
+//  SuiteSparseQR_deserialize       create a QR factorization from a blob
+//
+// The blob holds the symbolic analysis, the R factor and Householder vectors
+// (the Rblock stacks, HStair, HTau, Hii, HPinv, ...), the singletons, and all
+// the permutations.  It contains no pointers: each array is held at an offset
+// from the start of the blob that is a multiple of SPQR_BLOB_ALIGN bytes.  The
+// blob can thus be written to a file and later mapped back into memory (with
+// mmap, for example) at any address that is a multiple of SPQR_BLOB_START
+// bytes.  The arrays are then SPQR_BLOB_ALIGN-aligned in memory if the blob is.
+//
+// SuiteSparseQR_deserialize does not copy the arrays.  The QR object it
+// returns points into the blob, so the blob must not be modified or freed
+// until the QR object is freed by SuiteSparseQR_free (which does not free the
+// blob itself).  The QR object can be used by SuiteSparseQR_solve and
+// SuiteSparseQR_qmult, but it is read-only: SuiteSparseQR_numeric cannot
+// refactorize it.  Only O(nf+ns) pointers are allocated, where nf is the
+// number of fronts and ns is the number of stacks.
+//
+// The blob is specific to the Entry and Int types, and to the byte order of
+// the machine that wrote it.  SuiteSparseQR_deserialize checks the header of
+// the blob, and the size and location of each array, before using it.
+//
+// The blob layout is:
+//
+//  header [0 ... SPQR_BLOB_NSCALARS-1]: magic, version, sizeof (Int), xtype,
+//      size of the blob, # of arrays, and the scalars of the QR object
+//  header [SPQR_BLOB_NSCALARS ... ]: the offset and # of entries of each array
+//  the arrays, in the order given by spqr_blob_arrays
+
+#ifndef NEXPERT
+#include "spqr.hpp"
+
+#define SPQR_BLOB_MAGIC     ((int64_t) 0x424F4C4252515053)    // "SPQRBLOB"
+#define SPQR_BLOB_VERSION   2
+#define SPQR_BLOB_ALIGN     64
+#define SPQR_BLOB_START     8
+#define SPQR_BLOB_NSCALARS  64
+
+// round up s to a multiple of SPQR_BLOB_ALIGN
+#define SPQR_BLOB_ROUNDUP(s) \
+    ((((s) + SPQR_BLOB_ALIGN - 1) / SPQR_BLOB_ALIGN) * SPQR_BLOB_ALIGN)
+
+// =============================================================================
+// === spqr_blob_scalars =======================================================
+// =============================================================================
+
+// Copy a scalar to or from the header of the blob
+
+template <typename T> static void spqr_blob_scalar
+(
+    int write,          // if TRUE, copy x into H [k], else H [k] into x
+    int64_t *H,
+    int64_t *k,
+    T *x
+)
+{
+    if (write)
+    {
+        H [*k] = (int64_t) (*x) ;
+    }
+    else
+    {
+        *x = (T) H [*k] ;
+    }
+    (*k)++ ;
+}
+
+static void spqr_blob_scalar
+(
+    int write,
+    int64_t *H,
+    int64_t *k,
+    double *x
+)
+{
+    if (write)
+    {
+        memcpy (H + (*k), x, sizeof (double)) ;
+    }
+    else
+    {
+        memcpy (x, H + (*k), sizeof (double)) ;
+    }
+    (*k)++ ;
+}
+
+// Copy all the scalars of the QR object to or from the header of the blob.
+// Returns the number of scalars.
+
+template <typename Entry, typename Int> static int64_t spqr_blob_scalars
+(
+    int write,
+    int64_t *H,
+    SuiteSparseQR_factorization <Entry, Int> *QR
+)
+{
+    spqr_symbolic <Int> *QRsym = QR->QRsym ;
+    spqr_numeric <Entry, Int> *QRnum = QR->QRnum ;
+    int64_t k = 6 ;     // H [0..5] is the start of the header
+
+    spqr_blob_scalar (write, H, &k, &(QR->tol)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->r1nz)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->n1rows)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->n1cols)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->narows)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->nacols)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->bncols)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->rank)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->allow_tol)) ;
+    spqr_blob_scalar (write, H, &k, &(QR->qless)) ;
+
+    spqr_blob_scalar (write, H, &k, &(QRsym->m)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->n)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->anz)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->nf)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->maxfn)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->rjsize)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->do_rank_detection)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->do_pivoting)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->maxstack)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->hisize)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->keepH)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->ntasks)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->ns)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->maxcsize)) ;
+    spqr_blob_scalar (write, H, &k, &(QRsym->maxesize)) ;
+
+    spqr_blob_scalar (write, H, &k, &(QRnum->hisize)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->n)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->m)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->nf)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->ntasks)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->ns)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->maxstack)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->rank)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->rank1)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->maxfrank)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->norm_E_fro)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->keepH)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->rjsize)) ;
+    spqr_blob_scalar (write, H, &k, &(QRnum->maxfm)) ;
+
+    ASSERT (k <= SPQR_BLOB_NSCALARS) ;
+    return (k) ;
+}
+
+// =============================================================================
+// === spqr_blob_arrays ========================================================
+// =============================================================================
+
+// Visit each array of the QR object, in the order they appear in the blob.
+// The sizes of the arrays depend only on the scalars of the QR object.  The
+// Stacks hold the R factor and the Householder vectors, and Rloc [2*f] and
+// Rloc [2*f+1] give the stack and the offset in that stack of Rblock [f].
+
+template <typename Entry, typename Int, class Visitor> static void
+spqr_blob_arrays
+(
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    int64_t *&Rloc,         // size 2*nf
+    Visitor &visit
+)
+{
+    spqr_symbolic <Int> *QRsym = QR->QRsym ;
+    spqr_numeric <Entry, Int> *QRnum = QR->QRnum ;
+
+    int64_t m = QRsym->m ;
+    int64_t n = QRsym->n ;
+    int64_t nf = QRsym->nf ;
+    int64_t ntasks = QRsym->ntasks ;
+    int64_t ns = QRsym->ns ;
+
+    // symbolic analysis
+    visit (QRsym->Sp,             m+1) ;
+    visit (QRsym->Sj,             QRsym->anz) ;
+    visit (QRsym->Qfill,          n) ;
+    visit (QRsym->PLinv,          m) ;
+    visit (QRsym->Sleft,          n+2) ;
+    visit (QRsym->Parent,         nf+1) ;
+    visit (QRsym->Child,          nf+1) ;
+    visit (QRsym->Childp,         nf+2) ;
+    visit (QRsym->Super,          nf+1) ;
+    visit (QRsym->Rp,             nf+1) ;
+    visit (QRsym->Rj,             QRsym->rjsize) ;
+    visit (QRsym->Post,           nf+1) ;
+    visit (QRsym->Hip,            nf+1) ;
+    visit (QRsym->TaskChildp,     ntasks+2) ;
+    visit (QRsym->TaskChild,      ntasks+1) ;
+    visit (QRsym->TaskStack,      ntasks+1) ;
+    visit (QRsym->TaskFront,      nf+1) ;
+    visit (QRsym->TaskFrontp,     ntasks+2) ;
+    visit (QRsym->On_stack,       nf+1) ;
+    visit (QRsym->Stack_maxstack, ns+2) ;
+    visit (QRsym->Fm,             nf+1) ;
+    visit (QRsym->Cm,             nf+1) ;
+    visit (QRsym->ColCount,       n) ;
+
+    // numeric factorization
+    visit (QRnum->Rdead,          QRnum->n) ;
+    visit (QRnum->Pcol,           QRnum->n) ;
+    visit (QRnum->PcolInv,        QRnum->n) ;
+    visit (QRnum->HStair,         QRnum->rjsize) ;
+    visit (QRnum->HTau,           QRnum->rjsize) ;
+    visit (QRnum->Hii,            QRnum->hisize) ;
+    visit (QRnum->HPinv,          QRnum->m) ;
+    visit (QRnum->Hm,             QRnum->nf) ;
+    visit (QRnum->Hr,             QRnum->nf) ;
+    visit (QRnum->Stack_size,     QRnum->ns) ;
+    for (int64_t stack = 0 ; stack < QRnum->ns ; stack++)
+    {
+        // the Stack_size array is visited first
+        visit (QRnum->Stacks [stack], (QRnum->Stack_size == NULL) ? 0 :
+            (int64_t) QRnum->Stack_size [stack]) ;
+    }
+    visit (Rloc,                  2*QRnum->nf) ;
+
+    // singletons and combined permutations
+    visit (QR->R1p,               QR->n1rows+1) ;
+    visit (QR->R1j,               QR->r1nz) ;
+    visit (QR->R1x,               QR->r1nz) ;
+    visit (QR->Q1fill,            QR->nacols + QR->bncols) ;
+    visit (QR->P1inv,             QR->narows) ;
+    visit (QR->HP1inv,            QR->narows) ;
+    visit (QR->Rmap,              QR->nacols) ;
+    visit (QR->RmapInv,           QR->nacols) ;
+}
+
+// =============================================================================
+// === spqr_blob_layout ========================================================
+// =============================================================================
+
+// Determine the location of each array in the blob, and optionally copy it
+// there.  Absent (NULL) arrays take no space and are recorded with a zero
+// offset.  Arrays that are present but empty also take no space, but are
+// recorded with a nonzero offset so that they are not NULL when attached.
+
+struct spqr_blob_layout
+{
+    int64_t *T ;            // array table: T [2*k] = offset, T [2*k+1] = count
+    int64_t narrays ;
+    size_t size ;           // size of the blob so far
+    uint8_t *blob ;         // if not NULL, copy each array into the blob
+    int ok ;
+
+    template <typename T_array> void operator ( )
+    (
+        T_array *&X,
+        int64_t count
+    )
+    {
+        int64_t offset = 0 ;
+        if (X != NULL && count <= 0)
+        {
+            // present but empty
+            offset = (int64_t) size ;
+            count = 0 ;
+        }
+        else if (X != NULL)
+        {
+            offset = (int64_t) size ;
+            size_t s = ((size_t) count) * sizeof (T_array) ;
+            if (s / sizeof (T_array) != (size_t) count) ok = FALSE ;
+            size += SPQR_BLOB_ROUNDUP (s) ;
+            if (blob != NULL)
+            {
+                // copy the array and clear its padding, so that the same
+                // QR object always gives the same blob
+                memcpy (blob + offset, X, s) ;
+                memset (blob + offset + s, 0, size - offset - s) ;
+            }
+        }
+        else
+        {
+            count = 0 ;
+        }
+        if (T != NULL)
+        {
+            T [2*narrays  ] = offset ;
+            T [2*narrays+1] = count ;
+        }
+        narrays++ ;
+    }
+} ;
+
+// =============================================================================
+// === spqr_blob_attach ========================================================
+// =============================================================================
+
+// Point each array of the QR object into the blob, checking its location
+
+struct spqr_blob_attach
+{
+    int64_t *T ;            // array table from the blob header
+    int64_t narrays ;       // # of arrays in the table
+    int64_t k ;             // current array
+    uint8_t *blob ;
+    size_t blob_size ;
+    int ok ;
+
+    template <typename T_array> void operator ( )
+    (
+        T_array *&X,
+        int64_t count
+    )
+    {
+        X = NULL ;
+        if (!ok || k >= narrays)
+        {
+            ok = FALSE ;
+            return ;
+        }
+        int64_t offset = T [2*k] ;
+        int64_t bcount = T [2*k+1] ;
+        k++ ;
+        if (offset == 0 && bcount == 0)
+        {
+            // the array is not present
+            return ;
+        }
+        size_t s = ((size_t) bcount) * sizeof (T_array) ;
+        if (bcount != count || offset <= 0 || offset % SPQR_BLOB_ALIGN != 0
+            || s / sizeof (T_array) != (size_t) bcount
+            || (size_t) offset > blob_size || s > blob_size - offset)
+        {
+            // the array does not match the QR object, or is out of bounds
+            ok = FALSE ;
+            return ;
+        }
+        X = (T_array *) (blob + offset) ;
+    }
+} ;
+
+// =============================================================================
+// === spqr_blob_header_size ===================================================
+// =============================================================================
+
+template <typename Entry, typename Int> static size_t spqr_blob_header_size
+(
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    int64_t *p_narrays
+)
+{
+    // count the arrays
+    int64_t *Rloc = NULL ;
+    spqr_blob_layout L ;
+    L.T = NULL ;
+    L.narrays = 0 ;
+    L.size = 0 ;
+    L.blob = NULL ;
+    L.ok = TRUE ;
+    spqr_blob_arrays (QR, Rloc, L) ;
+    (*p_narrays) = L.narrays ;
+    return (SPQR_BLOB_ROUNDUP ((SPQR_BLOB_NSCALARS + 2 * L.narrays)
+        * sizeof (int64_t))) ;
+}
+
+// =============================================================================
+// === spqr_blob_Rloc ==========================================================
+// =============================================================================
+
+// Find the stack holding each Rblock, and its offset in that stack
+
+template <typename Entry, typename Int> static void spqr_blob_Rloc
+(
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    int64_t *Rloc       // size 2*nf
+)
+{
+    spqr_symbolic <Int> *QRsym = QR->QRsym ;
+    spqr_numeric <Entry, Int> *QRnum = QR->QRnum ;
+    Int nf = QRnum->nf ;
+    Int ntasks = QRnum->ntasks ;
+    for (Int f = 0 ; f < nf ; f++)
+    {
+        Rloc [2*f  ] = EMPTY ;
+        Rloc [2*f+1] = 0 ;
+    }
+    for (Int task = 0 ; task < ntasks ; task++)
+    {
+        Int kfirst, klast, stack ;
+        if (ntasks == 1)
+        {
+            // sequential case
+            kfirst = 0 ;
+            klast = nf ;
+            stack = 0 ;
+        }
+        else
+        {
+            kfirst = QRsym->TaskFrontp [task] ;
+            klast  = QRsym->TaskFrontp [task+1] ;
+            stack  = QRsym->TaskStack [task] ;
+        }
+        for (Int kf = kfirst ; kf < klast ; kf++)
+        {
+            Int f = (ntasks == 1) ? kf : QRsym->TaskFront [kf] ;
+            if (QRnum->Rblock [f] != NULL)
+            {
+                Rloc [2*f  ] = stack ;
+                Rloc [2*f+1] = QRnum->Rblock [f] - QRnum->Stacks [stack] ;
+            }
+        }
+    }
+}
+
+// =============================================================================
+// === SuiteSparseQR_serialize_size ============================================
+// =============================================================================
+
+// Returns the size in bytes of the blob needed to hold the QR factorization,
+// or zero on error.
+
+template <typename Entry, typename Int> size_t SuiteSparseQR_serialize_size
+(
+    // input, not modified
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (0) ;
+    RETURN_IF_NULL (QR, 0) ;
+    RETURN_IF_NULL (QR->QRsym, 0) ;
+    RETURN_IF_NULL (QR->QRnum, 0) ;
+    RETURN_IF_NULL (QR->QRnum->Stacks, 0) ;
+    cc->status = CHOLMOD_OK ;
+
+    int64_t narrays ;
+    size_t hsize = spqr_blob_header_size (QR, &narrays) ;
+
+    // a placeholder Rloc, so that its size is included
+    int64_t Rloc_placeholder = 0 ;
+    int64_t *Rloc = &Rloc_placeholder ;
+    spqr_blob_layout L ;
+    L.T = NULL ;
+    L.narrays = 0 ;
+    L.size = hsize ;
+    L.blob = NULL ;
+    L.ok = TRUE ;
+    spqr_blob_arrays (QR, Rloc, L) ;
+    if (!L.ok)
+    {
+        ERROR (CHOLMOD_TOO_LARGE, "problem too large") ;
+        return (0) ;
+    }
+    return (L.size) ;
+}
+
+template size_t SuiteSparseQR_serialize_size <double, int32_t>
+(
+    SuiteSparseQR_factorization <double, int32_t> *QR,
+    cholmod_common *cc
+) ;
+template size_t SuiteSparseQR_serialize_size <Complex, int32_t>
+(
+    SuiteSparseQR_factorization <Complex, int32_t> *QR,
+    cholmod_common *cc
+) ;
+template size_t SuiteSparseQR_serialize_size <float, int32_t>
+(
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    cholmod_common *cc
+) ;
+template size_t SuiteSparseQR_serialize_size <FComplex, int32_t>
+(
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    cholmod_common *cc
+) ;
+template size_t SuiteSparseQR_serialize_size <double, int64_t>
+(
+    SuiteSparseQR_factorization <double, int64_t> *QR,
+    cholmod_common *cc
+) ;
+template size_t SuiteSparseQR_serialize_size <Complex, int64_t>
+(
+    SuiteSparseQR_factorization <Complex, int64_t> *QR,
+    cholmod_common *cc
+) ;
+template size_t SuiteSparseQR_serialize_size <float, int64_t>
+(
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    cholmod_common *cc
+) ;
+template size_t SuiteSparseQR_serialize_size <FComplex, int64_t>
+(
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === SuiteSparseQR_serialize =================================================
+// =============================================================================
+
+// Write the QR factorization into the blob, which must have a size of at
+// least SuiteSparseQR_serialize_size (QR, cc) bytes.  Returns TRUE if
+// successful, FALSE otherwise.  To be used in place by
+// SuiteSparseQR_deserialize, the blob must start on an SPQR_BLOB_START (8)
+// byte boundary, which is true of any malloc'd or mmap'd block.
+
+template <typename Entry, typename Int> int SuiteSparseQR_serialize
+(
+    // input, not modified
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    // output
+    void *blob,                 // size blob_size
+    size_t blob_size,
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (QR, FALSE) ;
+    RETURN_IF_NULL (QR->QRsym, FALSE) ;
+    RETURN_IF_NULL (QR->QRnum, FALSE) ;
+    RETURN_IF_NULL (blob, FALSE) ;
+    cc->status = CHOLMOD_OK ;
+
+    size_t size = SuiteSparseQR_serialize_size (QR, cc) ;
+    if (size == 0)
+    {
+        return (FALSE) ;
+    }
+    if (blob_size < size)
+    {
+        ERROR (CHOLMOD_INVALID, "blob too small") ;
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // find the location of each R block
+    // -------------------------------------------------------------------------
+
+    Int nf = QR->QRnum->nf ;
+    int64_t *Rloc = (int64_t *) spqr_malloc <Int> (2*nf, sizeof (int64_t), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        return (FALSE) ;
+    }
+    spqr_blob_Rloc (QR, Rloc) ;
+
+    // -------------------------------------------------------------------------
+    // write the header and the arrays
+    // -------------------------------------------------------------------------
+
+    uint8_t *B = (uint8_t *) blob ;
+    int64_t narrays ;
+    size_t hsize = spqr_blob_header_size (QR, &narrays) ;
+    memset (B, 0, hsize) ;
+    int64_t *H = (int64_t *) B ;
+
+    H [0] = SPQR_BLOB_MAGIC ;
+    H [1] = SPQR_BLOB_VERSION ;
+    H [2] = sizeof (Int) ;
+    H [3] = spqr_type <Entry> ( ) ;
+    H [4] = (int64_t) size ;
+    H [5] = narrays ;
+    spqr_blob_scalars (TRUE, H, QR) ;
+
+    spqr_blob_layout L ;
+    L.T = H + SPQR_BLOB_NSCALARS ;
+    L.narrays = 0 ;
+    L.size = hsize ;
+    L.blob = B ;
+    L.ok = TRUE ;
+    spqr_blob_arrays (QR, Rloc, L) ;
+    ASSERT (L.size == size && L.narrays == narrays) ;
+
+    spqr_free <Int> (2*nf, sizeof (int64_t), Rloc, cc) ;
+    return (TRUE) ;
+}
+
+template int SuiteSparseQR_serialize <double, int32_t>
+(
+    SuiteSparseQR_factorization <double, int32_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_serialize <Complex, int32_t>
+(
+    SuiteSparseQR_factorization <Complex, int32_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_serialize <float, int32_t>
+(
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_serialize <FComplex, int32_t>
+(
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_serialize <double, int64_t>
+(
+    SuiteSparseQR_factorization <double, int64_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_serialize <Complex, int64_t>
+(
+    SuiteSparseQR_factorization <Complex, int64_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_serialize <float, int64_t>
+(
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_serialize <FComplex, int64_t>
+(
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === SuiteSparseQR_deserialize ===============================================
+// =============================================================================
+
+// Create a read-only QR factorization from a blob written by
+// SuiteSparseQR_serialize.  The arrays of the QR object point into the blob,
+// which is not modified.  Returns NULL if the blob is invalid or does not
+// start on an SPQR_BLOB_START byte boundary (with cc->status set to
+// CHOLMOD_INVALID), or if out of memory.
+
+#define FREE_ALL \
+{ \
+    if (QRnum != NULL) \
+    { \
+        spqr_free <Int> (QRnum->nf, sizeof (Entry *), QRnum->Rblock, cc) ; \
+        spqr_free <Int> (QRnum->ns, sizeof (Entry *), QRnum->Stacks, cc) ; \
+    } \
+    spqr_free <Int> (1, sizeof (spqr_numeric <Entry, Int>), QRnum, cc) ; \
+    spqr_free <Int> (1, sizeof (spqr_symbolic <Int>), QRsym, cc) ; \
+    spqr_free <Int> (1, sizeof (SuiteSparseQR_factorization <Entry, Int>), \
+        QR, cc) ; \
+}
+
+template <typename Entry, typename Int>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_deserialize
+(
+    // input, not modified
+    void *blob,                 // size blob_size
+    size_t blob_size,
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (blob, NULL) ;
+    cc->status = CHOLMOD_OK ;
+
+    // -------------------------------------------------------------------------
+    // check the header
+    // -------------------------------------------------------------------------
+
+    uint8_t *B = (uint8_t *) blob ;
+    int64_t *H = (int64_t *) B ;
+    if (((uintptr_t) B) % SPQR_BLOB_START != 0)
+    {
+        ERROR (CHOLMOD_INVALID, "blob not aligned") ;
+        return (NULL) ;
+    }
+    if (blob_size < SPQR_BLOB_NSCALARS * sizeof (int64_t)
+        || H [0] != SPQR_BLOB_MAGIC || H [1] != SPQR_BLOB_VERSION
+        || H [4] < 0 || (size_t) H [4] > blob_size
+        || H [5] < 0 || H [5] > (int64_t) blob_size)
+    {
+        ERROR (CHOLMOD_INVALID, "invalid blob") ;
+        return (NULL) ;
+    }
+    if (H [2] != (int64_t) sizeof (Int) || H [3] != spqr_type <Entry> ( ))
+    {
+        ERROR (CHOLMOD_INVALID, "blob has the wrong Entry or Int type") ;
+        return (NULL) ;
+    }
+    blob_size = (size_t) H [4] ;
+    int64_t narrays = H [5] ;
+    if ((SPQR_BLOB_NSCALARS + 2 * narrays) * sizeof (int64_t) > blob_size)
+    {
+        ERROR (CHOLMOD_INVALID, "invalid blob") ;
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // allocate the QR, QRsym, and QRnum objects, and get their scalars
+    // -------------------------------------------------------------------------
+
+    SuiteSparseQR_factorization <Entry, Int> *QR ;
+    spqr_symbolic <Int> *QRsym ;
+    spqr_numeric <Entry, Int> *QRnum ;
+    QR = (SuiteSparseQR_factorization <Entry, Int> *)
+        spqr_calloc <Int> (1, sizeof (SuiteSparseQR_factorization <Entry, Int>),
+        cc) ;
+    QRsym = (spqr_symbolic <Int> *)
+        spqr_calloc <Int> (1, sizeof (spqr_symbolic <Int>), cc) ;
+    QRnum = (spqr_numeric <Entry, Int> *)
+        spqr_calloc <Int> (1, sizeof (spqr_numeric <Entry, Int>), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        FREE_ALL ;
+        return (NULL) ;
+    }
+    QR->QRsym = QRsym ;
+    QR->QRnum = QRnum ;
+    spqr_blob_scalars (FALSE, H, QR) ;
+
+    Int nf = QRnum->nf ;
+    Int ns = QRnum->ns ;
+    if (nf < 0 || ns < 0 || nf != QRsym->nf || ns > MAX (QRsym->ns, 1)
+        || QRnum->ntasks > MAX (QRsym->ntasks, 1))
+    {
+        QRnum->nf = 0 ;
+        QRnum->ns = 0 ;
+        ERROR (CHOLMOD_INVALID, "invalid blob") ;
+        FREE_ALL ;
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // allocate the Rblock and Stacks pointers
+    // -------------------------------------------------------------------------
+
+    QRnum->Rblock = (Entry **) spqr_calloc <Int> (nf, sizeof (Entry *), cc) ;
+    QRnum->Stacks = (Entry **) spqr_calloc <Int> (ns, sizeof (Entry *), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        FREE_ALL ;
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // point each array into the blob
+    // -------------------------------------------------------------------------
+
+    int64_t *Rloc = NULL ;
+    spqr_blob_attach A ;
+    A.T = H + SPQR_BLOB_NSCALARS ;
+    A.narrays = narrays ;
+    A.k = 0 ;
+    A.blob = B ;
+    A.blob_size = blob_size ;
+    A.ok = TRUE ;
+    spqr_blob_arrays (QR, Rloc, A) ;
+    int ok = A.ok && (A.k == narrays) && (nf == 0 || Rloc != NULL) ;
+
+    // -------------------------------------------------------------------------
+    // find the Rblock pointers
+    // -------------------------------------------------------------------------
+
+    for (Int f = 0 ; ok && f < nf ; f++)
+    {
+        int64_t stack = Rloc [2*f] ;
+        int64_t offset = Rloc [2*f+1] ;
+        if (stack == EMPTY)
+        {
+            // this front has no R block
+            continue ;
+        }
+        if (stack < 0 || stack >= ns || QRnum->Stacks [stack] == NULL
+            || QRnum->Stack_size == NULL
+            || offset < 0 || offset > (int64_t) QRnum->Stack_size [stack])
+        {
+            ok = FALSE ;
+            break ;
+        }
+        QRnum->Rblock [f] = QRnum->Stacks [stack] + offset ;
+    }
+
+    if (!ok)
+    {
+        ERROR (CHOLMOD_INVALID, "invalid blob") ;
+        FREE_ALL ;
+        return (NULL) ;
+    }
+
+    QRsym->QRgpu = NULL ;
+    QR->Blob = blob ;
+    return (QR) ;
+}
+
+template SuiteSparseQR_factorization <double, int32_t> *
+SuiteSparseQR_deserialize <double, int32_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <Complex, int32_t> *
+SuiteSparseQR_deserialize <Complex, int32_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int32_t> *
+SuiteSparseQR_deserialize <float, int32_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int32_t> *
+SuiteSparseQR_deserialize <FComplex, int32_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <double, int64_t> *
+SuiteSparseQR_deserialize <double, int64_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <Complex, int64_t> *
+SuiteSparseQR_deserialize <Complex, int64_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int64_t> *
+SuiteSparseQR_deserialize <float, int64_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int64_t> *
+SuiteSparseQR_deserialize <FComplex, int64_t>
+(
+    void *blob,
+    size_t blob_size,
+    cholmod_common *cc
+) ;
+
+#endif
@@ -0,0 +1,664 @@
+// =============================================================================
+// === SuiteSparseQR_stream ====================================================
+// =============================================================================
+
+// SPQR, Copyright (c) 2008-2022, Timothy A Davis. All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+// Streaming QR factorization of a tall-and-skinny matrix A, given one block of
+// rows at a time.  A = [A1 ; A2 ; ... ] is never held in memory all at once,
+// and neither is B = [B1 ; B2 ; ...], the optional right-hand-side.  Only the
+// R factor of the rows seen so far is kept, along with C = Q'*B, so the memory
+// required depends on nnz(R) and the size of a single block, not on nnz(A).
+//
+//      SuiteSparseQR_stream_start   create an empty stream for an m-by-n
+//                                   matrix A (m need not be known)
+//      SuiteSparseQR_stream_append  fold the next block of rows into R and C
+//      SuiteSparseQR_stream_finish  return a QR object of R, and Q'*C
+//      SuiteSparseQR_stream_free    free the stream
+//
+// Rows can also be added to or deleted from R one at a time, with
+// SuiteSparseQR_stream_updown (see SuiteSparseQR_updown.cpp), but not to or
+// from a SuiteSparseQR_factorization object.
+//
+// Each call to SuiteSparseQR_stream_append computes the QR factorization of
+// [R ; Ak] with the multifrontal method (spqr_factorize and spqr_kernel), and
+// replaces R with the new R factor.  The column ordering is found from the
+// nonzero pattern of the first block, A1, so the first block should be
+// representative of the structure of A.  Later blocks use the same ordering.
+// No rank detection is done while the rows are being folded in.
+//
+// SuiteSparseQR_stream_finish factorizes R once more, this time with rank
+// detection, and returns the result as a SuiteSparseQR_factorization object
+// for the matrix A.  The Householder vectors of this QR object are those of R,
+// not A, so the QR object is marked as Q-less (QR->qless is TRUE) and
+// SuiteSparseQR_qmult returns NULL if used with it.  Its R factor and column
+// permutation are those of A, however, and SuiteSparseQR_solve can be used
+// with it.  The least-squares solution to A*X=B is then:
+//
+//      S = SuiteSparseQR_stream_start <double> (ordering, n, nrhs, cc) ;
+//      for each block k:
+//          SuiteSparseQR_stream_append <double> (Ak, Bk, S, cc) ;
+//      QR = SuiteSparseQR_stream_finish <double> (tol, S, &C, cc) ;
+//      X = SuiteSparseQR_solve (SPQR_RETX_EQUALS_B, QR, C, cc) ;
+//
+// The stream is not modified by SuiteSparseQR_stream_finish, so more rows can
+// be appended afterwards.
+
+#ifndef NEXPERT
+#include "spqr.hpp"
+
+// =============================================================================
+// === SuiteSparseQR_stream_start ==============================================
+// =============================================================================
+
+// Returns an empty stream for a matrix A with n columns, and a right-hand-side
+// B with bncols columns (bncols may be zero), or NULL on failure.
+
+template <typename Entry, typename Int>
+SuiteSparseQR_stream <Entry, Int> *SuiteSparseQR_stream_start
+(
+    // inputs, not modified
+    int ordering,           // ordering to use for the first block of rows
+    Int n,                  // number of columns of A
+    Int bncols,             // number of columns of B
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (NULL) ;
+    cc->status = CHOLMOD_OK ;
+
+    if (n < 0 || bncols < 0)
+    {
+        ERROR (CHOLMOD_INVALID, "invalid dimensions") ;
+        return (NULL) ;
+    }
+
+    SuiteSparseQR_stream <Entry, Int> *S ;
+    S = (SuiteSparseQR_stream <Entry, Int> *)
+        spqr_malloc <Int> (1, sizeof (SuiteSparseQR_stream <Entry, Int>), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+
+    S->n = n ;
+    S->bncols = bncols ;
+    S->nrows = 0 ;
+    S->ordering = ordering ;
+    S->R = NULL ;
+    S->C = NULL ;
+    S->Rrp = NULL ;
+    S->Rrlen = NULL ;
+    S->Rrj = NULL ;
+    S->Rrx = NULL ;
+    S->Crx = NULL ;
+    S->rrsize = 0 ;
+    S->rrtail = 0 ;
+
+    // the column ordering is the identity until the first block is seen
+    S->Qfill = (Int *) spqr_malloc <Int> (n, sizeof (Int), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        SuiteSparseQR_stream_free (&S, cc) ;
+        return (NULL) ;
+    }
+    for (Int k = 0 ; k < n ; k++)
+    {
+        S->Qfill [k] = k ;
+    }
+
+    return (S) ;
+}
+
+template SuiteSparseQR_stream <double, int32_t> *SuiteSparseQR_stream_start
+    <double, int32_t>
+(
+    int ordering,
+    int32_t n,
+    int32_t bncols,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_stream <Complex, int32_t> *SuiteSparseQR_stream_start
+    <Complex, int32_t>
+(
+    int ordering,
+    int32_t n,
+    int32_t bncols,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_stream <float, int32_t> *SuiteSparseQR_stream_start
+    <float, int32_t>
+(
+    int ordering,
+    int32_t n,
+    int32_t bncols,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_stream <FComplex, int32_t> *SuiteSparseQR_stream_start
+    <FComplex, int32_t>
+(
+    int ordering,
+    int32_t n,
+    int32_t bncols,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_stream <double, int64_t> *SuiteSparseQR_stream_start
+    <double, int64_t>
+(
+    int ordering,
+    int64_t n,
+    int64_t bncols,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_stream <Complex, int64_t> *SuiteSparseQR_stream_start
+    <Complex, int64_t>
+(
+    int ordering,
+    int64_t n,
+    int64_t bncols,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_stream <float, int64_t> *SuiteSparseQR_stream_start
+    <float, int64_t>
+(
+    int ordering,
+    int64_t n,
+    int64_t bncols,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_stream <FComplex, int64_t> *SuiteSparseQR_stream_start
+    <FComplex, int64_t>
+(
+    int ordering,
+    int64_t n,
+    int64_t bncols,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === SuiteSparseQR_stream_append =============================================
+// =============================================================================
+
+// Fold the next block of rows of A and B into R and C.  Returns TRUE if
+// successful, FALSE otherwise.  On failure, the stream is not modified.
+
+#define FREE_WORK \
+        spqr_free_sparse <Int> (&W, cc) ; \
+        spqr_free_dense <Int> (&WB, cc) ;
+
+template <typename Entry, typename Int> int SuiteSparseQR_stream_append
+(
+    // inputs, not modified
+    cholmod_sparse *A,      // next block of rows of A, mk-by-n
+    cholmod_dense *B,       // next block of rows of B, mk-by-bncols.
+                            // Ignored if bncols is zero.
+    // input/output
+    SuiteSparseQR_stream <Entry, Int> *S,
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *W = NULL, *Rnew = NULL ;
+    cholmod_dense *WB = NULL, *Cnew = NULL ;
+    Int *E = NULL ;
+
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (A, FALSE) ;
+    RETURN_IF_NULL (S, FALSE) ;
+    int64_t xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (A, FALSE) ;
+    cc->status = CHOLMOD_OK ;
+
+    Int n = S->n ;
+    Int bncols = S->bncols ;
+    Int mk = A->nrow ;
+    if ((Int) A->ncol != n || !A->packed || A->stype != 0)
+    {
+        ERROR (CHOLMOD_INVALID, "invalid block of rows of A") ;
+        return (FALSE) ;
+    }
+    if (bncols > 0 && (B == NULL || (Int) B->nrow != mk ||
+        (Int) B->ncol != bncols || B->xtype + B->dtype != xtype))
+    {
+        ERROR (CHOLMOD_INVALID, "invalid block of rows of B") ;
+        return (FALSE) ;
+    }
+    if (mk == 0)
+    {
+        // nothing to do
+        return (TRUE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // get the current R and C
+    // -------------------------------------------------------------------------
+
+    // convert R and C back from the row form, if SuiteSparseQR_stream_updown
+    // has been used since the last call
+    if (!spqr_stream_tocols (S, cc))
+    {
+        // out of memory
+        return (FALSE) ;
+    }
+
+    Int *Ap = (Int *) A->p ;
+    Int *Ai = (Int *) A->i ;
+    Entry *Ax = (Entry *) A->x ;
+    Int *Qfill = S->Qfill ;
+
+    // R is e-by-n, and C is e-by-bncols, where e <= n
+    Int e = 0, rnz = 0 ;
+    Int *Rp = NULL, *Ri = NULL ;
+    Entry *Rx = NULL ;
+    if (S->R != NULL)
+    {
+        e = S->R->nrow ;
+        Rp = (Int *) S->R->p ;
+        Ri = (Int *) S->R->i ;
+        Rx = (Entry *) S->R->x ;
+        rnz = Rp [n] ;
+    }
+
+    // -------------------------------------------------------------------------
+    // construct W = [R ; A(:,Qfill)] and WB = [C ; B]
+    // -------------------------------------------------------------------------
+
+    Int wm = e + mk ;
+    W = spqr_allocate_sparse <Int> (wm, n, rnz + Ap [n], FALSE, TRUE, 0,
+        xtype, cc) ;
+    if (bncols > 0)
+    {
+        WB = spqr_allocate_dense <Int> (wm, bncols, wm, xtype, cc) ;
+    }
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        FREE_WORK ;
+        return (FALSE) ;
+    }
+
+    Int *Wp = (Int *) W->p ;
+    Int *Wi = (Int *) W->i ;
+    Entry *Wx = (Entry *) W->x ;
+    Int wnz = 0 ;
+    for (Int k = 0 ; k < n ; k++)
+    {
+        Wp [k] = wnz ;
+        if (Rp != NULL)
+        {
+            for (Int p = Rp [k] ; p < Rp [k+1] ; p++)
+            {
+                Wi [wnz] = Ri [p] ;
+                Wx [wnz] = Rx [p] ;
+                wnz++ ;
+            }
+        }
+        Int j = Qfill [k] ;
+        for (Int p = Ap [j] ; p < Ap [j+1] ; p++)
+        {
+            Wi [wnz] = Ai [p] + e ;
+            Wx [wnz] = Ax [p] ;
+            wnz++ ;
+        }
+    }
+    Wp [n] = wnz ;
+
+    if (bncols > 0)
+    {
+        Entry *WBx = (Entry *) WB->x ;
+        Entry *Bx = (Entry *) B->x ;
+        Entry *Cx = (S->C == NULL) ? NULL : ((Entry *) S->C->x) ;
+        Int ldb = B->d ;
+        for (Int k = 0 ; k < bncols ; k++)
+        {
+            for (Int i = 0 ; i < e ; i++)
+            {
+                WBx [i + k*wm] = Cx [i + k*e] ;
+            }
+            for (Int i = 0 ; i < mk ; i++)
+            {
+                WBx [e + i + k*wm] = Bx [i + k*ldb] ;
+            }
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // [C,R,E] = qr ([R ; A(:,Qfill)], [C ; B]), with no rank detection
+    // -------------------------------------------------------------------------
+
+    // The ordering of the first block becomes the column ordering of the
+    // stream.  Later blocks use a fixed ordering, but column singletons can
+    // still be permuted to the front, so E need not be the identity.
+    int ordering = (S->nrows == 0) ? S->ordering : SPQR_ORDERING_FIXED ;
+
+    SuiteSparseQR <Entry, Int> (ordering, SPQR_NO_TOL, n, 0, W, NULL, WB,
+        NULL, (bncols > 0) ? &Cnew : NULL, &Rnew, &E, NULL, NULL, NULL, cc) ;
+
+    FREE_WORK ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory, or the problem is too large for the BLAS
+        spqr_free_sparse <Int> (&Rnew, cc) ;
+        spqr_free_dense <Int> (&Cnew, cc) ;
+        spqr_free <Int> (n+bncols, sizeof (Int), E, cc) ;
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // replace R and C, and combine the column orderings
+    // -------------------------------------------------------------------------
+
+    if (E != NULL)
+    {
+        // column k of Rnew is column E [k] of W, and column Qfill [E [k]] of A
+        for (Int k = 0 ; k < n ; k++)
+        {
+            E [k] = Qfill [E [k]] ;
+        }
+        for (Int k = 0 ; k < n ; k++)
+        {
+            Qfill [k] = E [k] ;
+        }
+        spqr_free <Int> (n+bncols, sizeof (Int), E, cc) ;
+    }
+
+    spqr_free_sparse <Int> (&(S->R), cc) ;
+    spqr_free_dense <Int> (&(S->C), cc) ;
+    S->R = Rnew ;
+    S->C = Cnew ;
+    S->nrows += mk ;
+    return (TRUE) ;
+}
+
+template int SuiteSparseQR_stream_append <double, int32_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <double, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_append <Complex, int32_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <Complex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_append <float, int32_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <float, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_append <FComplex, int32_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <FComplex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_append <double, int64_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <double, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_append <Complex, int64_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <Complex, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_append <float, int64_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <float, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_append <FComplex, int64_t>
+(
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <FComplex, int64_t> *S,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === SuiteSparseQR_stream_finish =============================================
+// =============================================================================
+
+// Returns a QR object for the matrix A, with rank detection, or NULL on
+// failure.  If bncols > 0 and C is not NULL, the right-hand-side for
+// SuiteSparseQR_solve is returned in *C.
+
+template <typename Entry, typename Int>
+SuiteSparseQR_factorization <Entry, Int> *SuiteSparseQR_stream_finish
+(
+    // inputs, not modified
+    double tol,             // treat columns with 2-norm <= tol as zero
+    SuiteSparseQR_stream <Entry, Int> *S,
+    // output
+    cholmod_dense **C,      // C = Q'*B, for use in SuiteSparseQR_solve
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (NULL) ;
+    RETURN_IF_NULL (S, NULL) ;
+    cc->status = CHOLMOD_OK ;
+
+    if (C != NULL)
+    {
+        *C = NULL ;
+    }
+    if (!spqr_stream_tocols (S, cc))
+    {
+        // out of memory
+        return (NULL) ;
+    }
+    if (S->R == NULL)
+    {
+        ERROR (CHOLMOD_INVALID, "no rows have been appended") ;
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // factorize R, with rank detection
+    // -------------------------------------------------------------------------
+
+    // R is upper triangular unless it was found to be structurally rank
+    // deficient, so most of its columns are usually singletons and this is
+    // much cheaper than the factorizations done by SuiteSparseQR_stream_append.
+    SuiteSparseQR_factorization <Entry, Int> *QR ;
+    QR = SuiteSparseQR_factorize <Entry, Int> (SPQR_ORDERING_FIXED, tol, S->R,
+        cc) ;
+    if (QR == NULL)
+    {
+        // out of memory
+        return (NULL) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // combine the column ordering of R with the ordering of the stream
+    // -------------------------------------------------------------------------
+
+    // QR is the factorization of R(:,Q1fill) = A(:,Qfill(Q1fill))
+    Int n = S->n ;
+    Int *Q1fill = (Int *) spqr_malloc <Int> (n, sizeof (Int), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        spqr_freefac (&QR, cc) ;
+        return (NULL) ;
+    }
+    for (Int k = 0 ; k < n ; k++)
+    {
+        Q1fill [k] = S->Qfill [QR->Q1fill ? QR->Q1fill [k] : k] ;
+    }
+    spqr_free <Int> (n + QR->bncols, sizeof (Int), QR->Q1fill, cc) ;
+    QR->Q1fill = Q1fill ;
+
+    // -------------------------------------------------------------------------
+    // apply the Q of R to C
+    // -------------------------------------------------------------------------
+
+    if (C != NULL && S->C != NULL)
+    {
+        *C = SuiteSparseQR_qmult <Entry, Int> (SPQR_QTX, QR, S->C, cc) ;
+        if (*C == NULL)
+        {
+            // out of memory
+            spqr_freefac (&QR, cc) ;
+            return (NULL) ;
+        }
+    }
+
+    // the Householder vectors are those of R, not A
+    QR->qless = TRUE ;
+    return (QR) ;
+}
+
+template SuiteSparseQR_factorization <double, int32_t>
+    *SuiteSparseQR_stream_finish <double, int32_t>
+(
+    double tol,
+    SuiteSparseQR_stream <double, int32_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <Complex, int32_t>
+    *SuiteSparseQR_stream_finish <Complex, int32_t>
+(
+    double tol,
+    SuiteSparseQR_stream <Complex, int32_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int32_t>
+    *SuiteSparseQR_stream_finish <float, int32_t>
+(
+    double tol,
+    SuiteSparseQR_stream <float, int32_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int32_t>
+    *SuiteSparseQR_stream_finish <FComplex, int32_t>
+(
+    double tol,
+    SuiteSparseQR_stream <FComplex, int32_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <double, int64_t>
+    *SuiteSparseQR_stream_finish <double, int64_t>
+(
+    double tol,
+    SuiteSparseQR_stream <double, int64_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <Complex, int64_t>
+    *SuiteSparseQR_stream_finish <Complex, int64_t>
+(
+    double tol,
+    SuiteSparseQR_stream <Complex, int64_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int64_t>
+    *SuiteSparseQR_stream_finish <float, int64_t>
+(
+    double tol,
+    SuiteSparseQR_stream <float, int64_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int64_t>
+    *SuiteSparseQR_stream_finish <FComplex, int64_t>
+(
+    double tol,
+    SuiteSparseQR_stream <FComplex, int64_t> *S,
+    cholmod_dense **C,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === SuiteSparseQR_stream_free ===============================================
+// =============================================================================
+
+template <typename Entry, typename Int> int SuiteSparseQR_stream_free
+(
+    SuiteSparseQR_stream <Entry, Int> **S_handle,
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    if (S_handle == NULL || *S_handle == NULL)
+    {
+        // nothing to do; caller probably ran out of memory
+        return (TRUE) ;
+    }
+
+    SuiteSparseQR_stream <Entry, Int> *S = *S_handle ;
+    spqr_free <Int> (S->n, sizeof (Int), S->Qfill, cc) ;
+    spqr_free_sparse <Int> (&(S->R), cc) ;
+    spqr_free_dense <Int> (&(S->C), cc) ;
+    spqr_stream_freerows (S, cc) ;
+    spqr_free <Int> (1, sizeof (SuiteSparseQR_stream <Entry, Int>), S, cc) ;
+    *S_handle = NULL ;
+    return (TRUE) ;
+}
+
+template int SuiteSparseQR_stream_free <double, int32_t>
+(
+    SuiteSparseQR_stream <double, int32_t> **S_handle,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_free <Complex, int32_t>
+(
+    SuiteSparseQR_stream <Complex, int32_t> **S_handle,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_free <float, int32_t>
+(
+    SuiteSparseQR_stream <float, int32_t> **S_handle,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_free <FComplex, int32_t>
+(
+    SuiteSparseQR_stream <FComplex, int32_t> **S_handle,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_free <double, int64_t>
+(
+    SuiteSparseQR_stream <double, int64_t> **S_handle,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_free <Complex, int64_t>
+(
+    SuiteSparseQR_stream <Complex, int64_t> **S_handle,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_free <float, int64_t>
+(
+    SuiteSparseQR_stream <float, int64_t> **S_handle,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_free <FComplex, int64_t>
+(
+    SuiteSparseQR_stream <FComplex, int64_t> **S_handle,
+    cholmod_common *cc
+) ;
+
+#endif
@@ -0,0 +1,67 @@
+// =============================================================================
+// === SuiteSparseQR_trace =====================================================
+// =============================================================================
+
+// SPQR, Copyright (c) 2008-2022, Timothy A Davis. All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+// Per-front trace of the numeric factorization.
+//
+//  SuiteSparseQR_front_trace_csv           trace function that writes CSV
+//  SuiteSparseQR_front_trace_csv_header    write the CSV header line
+//
+// The trace function is passed to SuiteSparseQR_factorize or
+// SuiteSparseQR_numeric, so it applies only to that factorization.
+// spqr_factorize passes it to spqr_kernel in the spqr_blob.
+//
+// Example, to write the trace of one factorization to a file:
+//
+//      FILE *f = fopen ("trace.csv", "w") ;
+//      SuiteSparseQR_front_trace_csv_header (f) ;
+//      QR = SuiteSparseQR_factorize <double> (ordering, tol, A,
+//          SuiteSparseQR_front_trace_csv, f, cc) ;
+//      fclose (f) ;
+
+#include "spqr.hpp"
+
+// =============================================================================
+// === SuiteSparseQR_front_trace_csv ===========================================
+// =============================================================================
+
+// Each record is written with a single fprintf, which does not interleave
+// with the fprintf of another thread on the same FILE.
+
+void SuiteSparseQR_front_trace_csv
+(
+    const SuiteSparseQR_front_trace *trace,
+    void *user_data
+)
+{
+    FILE *file = (FILE *) user_data ;
+    if (trace == NULL || file == NULL)
+    {
+        return ;
+    }
+    fprintf (file, "%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64 ",%" PRId64
+        ",%" PRId64 ",%" PRId64 ",%.9g,%.9g,%.9g,%" PRId64 ",%" PRId64
+        ",%" PRId64 "\n",
+        trace->front, trace->task, trace->stack, trace->fm, trace->fn,
+        trace->fp, trace->frank, trace->assemble_time, trace->front_time,
+        trace->larftb_time, trace->stack_inuse, trace->stack_peak,
+        trace->entry_size) ;
+}
+
+// =============================================================================
+// === SuiteSparseQR_front_trace_csv_header ====================================
+// =============================================================================
+
+void SuiteSparseQR_front_trace_csv_header (FILE *file)
+{
+    if (file != NULL)
+    {
+        fprintf (file, "front,task,stack,fm,fn,fp,frank,assemble_time,"
+            "front_time,larftb_time,stack_inuse,stack_peak,entry_size\n") ;
+    }
+}
@@ -0,0 +1,1089 @@
+// =============================================================================
+// === SuiteSparseQR_updown ====================================================
+// =============================================================================
+
+// SPQR, Copyright (c) 2008-2022, Timothy A Davis. All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+// Add rows to, or delete rows from, the Q-less QR factorization R and C = Q'*B
+// held in a SuiteSparseQR_stream object.  This allows a sliding-window least
+// squares problem to be solved without refactorizing A each time a row arrives
+// or expires.
+//
+// Each row w of A (and the matching row of B) is applied to R with a sweep of
+// plane rotations, one for each column k where w is nonzero, from left to
+// right.  Row k of R and w are replaced with:
+//
+//      update (add w):      Givens rotation, so that R'*R becomes R'*R + w'*w
+//      downdate (delete w): hyperbolic rotation, so that R'*R becomes
+//                           R'*R - w'*w
+//
+// Row k of R and w take on the union of their nonzero patterns, so the
+// pattern of R grows as needed, including the case when w has an entry in a
+// column where R is still empty.  In that case, w becomes that row of R.  The
+// work for each row of A depends only on the rows of R it touches, not on the
+// size of A or of R as a whole.
+//
+// To allow for the growth of each row, R and C are held in a row form while
+// rows are being added or deleted (see the SuiteSparseQR_stream object).  The
+// diagonal of R is kept real and positive in this form.  R and C are converted
+// back to column form, in O(nnz(R)) time, the next time
+// SuiteSparseQR_stream_append or SuiteSparseQR_stream_finish is called.
+//
+// A row can only be deleted if R'*R - w'*w remains positive definite (on the
+// nonzero rows of R).  If it does not, the status is set to CHOLMOD_NOT_POSDEF,
+// and that row and any rows after it are not deleted.  R and C are not
+// modified by a row that cannot be deleted.  This cannot occur, apart from
+// roundoff, if w is a row that had been added to R before.  Downdating is less
+// stable than updating, so R should be recomputed from time to time if many
+// rows are deleted.
+//
+// The multifrontal R held in a SuiteSparseQR_factorization object is not
+// modified directly, since its structure is fixed by the symbolic analysis.
+// Instead, a new QR object with the updated R is obtained from
+// SuiteSparseQR_stream_finish.  Since R is upper triangular, this is usually
+// no more costly than a solve with R.
+
+#ifndef NEXPERT
+#include "spqr.hpp"
+
+// =============================================================================
+// === spqr_updown_work ========================================================
+// =============================================================================
+
+// workspace for SuiteSparseQR_stream_updown
+
+template <typename Entry, typename Int> struct spqr_updown_work
+{
+    Entry *Wx ;         // size n, the row w being applied, in dense form
+    Entry *X ;          // size n, the row of R being rotated, in dense form
+    Int *Wflag ;        // size n, Wflag [j] = 1 if j is in Wlist
+    Int *Wlist ;        // size n, nonzero pattern of w
+    Entry *Wc ;         // size bncols, the row of B being applied
+
+    // new rows of R and C computed by a sweep, not yet in the row form
+    Int *Tk ;           // size n+1, the sweep computes new rows Tk [0..nt-1]
+    Int *Tp ;           // size n+1, new row Tk [t] is Tj, Tx [Tp [t]...]
+    Entry *Tc ;         // size n*bncols, new row Tk [t] of C is Tc [t*bncols]
+    Int *Tj ;           // size tsize
+    Entry *Tx ;         // size tsize
+    size_t tsize ;
+} ;
+
+// =============================================================================
+// === spqr_stream_freerows ====================================================
+// =============================================================================
+
+// Free the row form of R and C
+
+template <typename Entry, typename Int> void spqr_stream_freerows
+(
+    SuiteSparseQR_stream <Entry, Int> *S,
+    cholmod_common *cc
+)
+{
+    Int n = S->n ;
+    spqr_free <Int> (n, sizeof (Int), S->Rrp, cc) ;
+    spqr_free <Int> (n, sizeof (Int), S->Rrlen, cc) ;
+    spqr_free <Int> (S->rrsize, sizeof (Int), S->Rrj, cc) ;
+    spqr_free <Int> (S->rrsize, sizeof (Entry), S->Rrx, cc) ;
+    spqr_free <Int> (n * S->bncols, sizeof (Entry), S->Crx, cc) ;
+    S->Rrp = NULL ;
+    S->Rrlen = NULL ;
+    S->Rrj = NULL ;
+    S->Rrx = NULL ;
+    S->Crx = NULL ;
+    S->rrsize = 0 ;
+    S->rrtail = 0 ;
+}
+
+template void spqr_stream_freerows <double, int32_t>
+(
+    SuiteSparseQR_stream <double, int32_t> *S,
+    cholmod_common *cc
+) ;
+template void spqr_stream_freerows <Complex, int32_t>
+(
+    SuiteSparseQR_stream <Complex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template void spqr_stream_freerows <float, int32_t>
+(
+    SuiteSparseQR_stream <float, int32_t> *S,
+    cholmod_common *cc
+) ;
+template void spqr_stream_freerows <FComplex, int32_t>
+(
+    SuiteSparseQR_stream <FComplex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template void spqr_stream_freerows <double, int64_t>
+(
+    SuiteSparseQR_stream <double, int64_t> *S,
+    cholmod_common *cc
+) ;
+template void spqr_stream_freerows <Complex, int64_t>
+(
+    SuiteSparseQR_stream <Complex, int64_t> *S,
+    cholmod_common *cc
+) ;
+template void spqr_stream_freerows <float, int64_t>
+(
+    SuiteSparseQR_stream <float, int64_t> *S,
+    cholmod_common *cc
+) ;
+template void spqr_stream_freerows <FComplex, int64_t>
+(
+    SuiteSparseQR_stream <FComplex, int64_t> *S,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === spqr_stream_tocols ======================================================
+// =============================================================================
+
+// Convert R and C from row form to column form.  R becomes an n-by-n upper
+// triangular matrix with sorted columns (some of its rows may be empty), and C
+// becomes n-by-bncols.  Returns TRUE if successful, or if R and C are already
+// in column form.  Returns FALSE if out of memory, in which case R and C are
+// left in row form.
+
+template <typename Entry, typename Int> int spqr_stream_tocols
+(
+    SuiteSparseQR_stream <Entry, Int> *S,
+    cholmod_common *cc
+)
+{
+    if (S->Rrp == NULL)
+    {
+        // R and C are already in column form
+        return (TRUE) ;
+    }
+
+    Int n = S->n ;
+    Int bncols = S->bncols ;
+    Int *Rrp = S->Rrp ;
+    Int *Rrlen = S->Rrlen ;
+    Int *Rrj = S->Rrj ;
+    Entry *Rrx = S->Rrx ;
+    Entry *Crx = S->Crx ;
+    int64_t xtype = spqr_type <Entry> ( ) ;
+
+    Int rnz = 0 ;
+    for (Int k = 0 ; k < n ; k++)
+    {
+        rnz += Rrlen [k] ;
+    }
+
+    cholmod_sparse *R = spqr_allocate_sparse <Int> (n, n, rnz, TRUE, TRUE, 0,
+        xtype, cc) ;
+    cholmod_dense *C = NULL ;
+    if (bncols > 0)
+    {
+        C = spqr_allocate_dense <Int> (n, bncols, n, xtype, cc) ;
+    }
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        spqr_free_sparse <Int> (&R, cc) ;
+        spqr_free_dense <Int> (&C, cc) ;
+        return (FALSE) ;
+    }
+
+    // count the entries in each column of R
+    Int *Rp = (Int *) R->p ;
+    Int *Ri = (Int *) R->i ;
+    Entry *Rx = (Entry *) R->x ;
+    for (Int j = 0 ; j <= n ; j++)
+    {
+        Rp [j] = 0 ;
+    }
+    for (Int k = 0 ; k < n ; k++)
+    {
+        for (Int p = Rrp [k] ; p < Rrp [k] + Rrlen [k] ; p++)
+        {
+            Rp [Rrj [p]]++ ;
+        }
+    }
+    spqr_cumsum (n, Rp) ;
+
+    // place the rows in order, so each column of R is sorted
+    for (Int k = 0 ; k < n ; k++)
+    {
+        for (Int p = Rrp [k] ; p < Rrp [k] + Rrlen [k] ; p++)
+        {
+            Int q = Rp [Rrj [p]]++ ;
+            Ri [q] = k ;
+            Rx [q] = Rrx [p] ;
+        }
+    }
+    spqr_shift (n, Rp) ;
+
+    if (bncols > 0)
+    {
+        Entry *Cx = (Entry *) C->x ;
+        for (Int k = 0 ; k < n ; k++)
+        {
+            for (Int j = 0 ; j < bncols ; j++)
+            {
+                Cx [k + j*n] = Crx [k*bncols + j] ;
+            }
+        }
+    }
+
+    spqr_stream_freerows (S, cc) ;
+    S->R = R ;
+    S->C = C ;
+    return (TRUE) ;
+}
+
+template int spqr_stream_tocols <double, int32_t>
+(
+    SuiteSparseQR_stream <double, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int spqr_stream_tocols <Complex, int32_t>
+(
+    SuiteSparseQR_stream <Complex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int spqr_stream_tocols <float, int32_t>
+(
+    SuiteSparseQR_stream <float, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int spqr_stream_tocols <FComplex, int32_t>
+(
+    SuiteSparseQR_stream <FComplex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int spqr_stream_tocols <double, int64_t>
+(
+    SuiteSparseQR_stream <double, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int spqr_stream_tocols <Complex, int64_t>
+(
+    SuiteSparseQR_stream <Complex, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int spqr_stream_tocols <float, int64_t>
+(
+    SuiteSparseQR_stream <float, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int spqr_stream_tocols <FComplex, int64_t>
+(
+    SuiteSparseQR_stream <FComplex, int64_t> *S,
+    cholmod_common *cc
+) ;
+
+// =============================================================================
+// === spqr_rows_grow ==========================================================
+// =============================================================================
+
+// Ensure the row form of R has room for at least need more entries at its
+// tail.  If not, the rows are copied into a larger array, in order, which also
+// removes the space left behind by rows that have been moved to the tail.
+// Returns FALSE if out of memory, in which case the row form is unchanged.
+
+template <typename Entry, typename Int> static int spqr_rows_grow
+(
+    SuiteSparseQR_stream <Entry, Int> *S,
+    Int need,
+    cholmod_common *cc
+)
+{
+    if (S->rrtail + need <= S->rrsize)
+    {
+        // enough space
+        return (TRUE) ;
+    }
+
+    Int n = S->n ;
+    Int live = 0 ;
+    for (Int k = 0 ; k < n ; k++)
+    {
+        live += S->Rrlen [k] ;
+    }
+    Int newsize = 2 * (live + need) + n ;
+
+    Int *Rrj = (Int *) spqr_malloc <Int> (newsize, sizeof (Int), cc) ;
+    Entry *Rrx = (Entry *) spqr_malloc <Int> (newsize, sizeof (Entry), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        spqr_free <Int> (newsize, sizeof (Int), Rrj, cc) ;
+        spqr_free <Int> (newsize, sizeof (Entry), Rrx, cc) ;
+        return (FALSE) ;
+    }
+
+    Int tail = 0 ;
+    for (Int k = 0 ; k < n ; k++)
+    {
+        Int p1 = S->Rrp [k] ;
+        S->Rrp [k] = tail ;
+        for (Int p = p1 ; p < p1 + S->Rrlen [k] ; p++)
+        {
+            Rrj [tail] = S->Rrj [p] ;
+            Rrx [tail] = S->Rrx [p] ;
+            tail++ ;
+        }
+    }
+
+    spqr_free <Int> (S->rrsize, sizeof (Int), S->Rrj, cc) ;
+    spqr_free <Int> (S->rrsize, sizeof (Entry), S->Rrx, cc) ;
+    S->Rrj = Rrj ;
+    S->Rrx = Rrx ;
+    S->rrsize = newsize ;
+    S->rrtail = tail ;
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === spqr_sweep_push =========================================================
+// =============================================================================
+
+// Ensure the new rows computed by a sweep have room for need more entries
+
+template <typename Entry, typename Int> static int spqr_sweep_push
+(
+    spqr_updown_work <Entry, Int> *Work,
+    size_t need,
+    cholmod_common *cc
+)
+{
+    if (need <= Work->tsize)
+    {
+        return (TRUE) ;
+    }
+    size_t newsize = 2 * need ;
+    Int *Tj = (Int *) spqr_malloc <Int> (newsize, sizeof (Int), cc) ;
+    Entry *Tx = (Entry *) spqr_malloc <Int> (newsize, sizeof (Entry), cc) ;
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        spqr_free <Int> (newsize, sizeof (Int), Tj, cc) ;
+        spqr_free <Int> (newsize, sizeof (Entry), Tx, cc) ;
+        return (FALSE) ;
+    }
+    memcpy (Tj, Work->Tj, Work->tsize * sizeof (Int)) ;
+    memcpy (Tx, Work->Tx, Work->tsize * sizeof (Entry)) ;
+    spqr_free <Int> (Work->tsize, sizeof (Int), Work->Tj, cc) ;
+    spqr_free <Int> (Work->tsize, sizeof (Entry), Work->Tx, cc) ;
+    Work->Tj = Tj ;
+    Work->Tx = Tx ;
+    Work->tsize = newsize ;
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === spqr_sweep ==============================================================
+// =============================================================================
+
+// Apply one row w of A, and the row wc of B, to R and C in row form.  w is
+// given as a list of wlen column indices Wj (already permuted by Qfill) and
+// values Wval; duplicates are summed.  Returns TRUE if successful, or FALSE if
+// out of memory or if a downdate fails.  R and C are unchanged on failure.
+
+template <typename Entry, typename Int> static int spqr_sweep
+(
+    int update,
+    Int wlen,
+    Int *Wj,
+    Entry *Wval,
+    Entry *wc,              // size bncols, row of B (not accessed if bncols 0)
+    SuiteSparseQR_stream <Entry, Int> *S,
+    spqr_updown_work <Entry, Int> *Work,
+    cholmod_common *cc
+)
+{
+    Int bncols = S->bncols ;
+    Int *Rrp = S->Rrp ;
+    Int *Rrlen = S->Rrlen ;
+    Entry *Crx = S->Crx ;
+
+    Entry *Wx = Work->Wx ;
+    Entry *X = Work->X ;
+    Int *Wflag = Work->Wflag ;
+    Int *Wlist = Work->Wlist ;
+    Entry *Wc = Work->Wc ;
+    Int *Tk = Work->Tk ;
+    Int *Tp = Work->Tp ;
+    Entry *Tc = Work->Tc ;
+
+    // -------------------------------------------------------------------------
+    // scatter w into Wx
+    // -------------------------------------------------------------------------
+
+    Int nw = 0 ;
+    for (Int p = 0 ; p < wlen ; p++)
+    {
+        Int j = Wj [p] ;
+        if (!Wflag [j])
+        {
+            Wflag [j] = 1 ;
+            Wx [j] = 0 ;
+            Wlist [nw++] = j ;
+        }
+        Wx [j] += Wval [p] ;
+    }
+    for (Int j = 0 ; j < bncols ; j++)
+    {
+        Wc [j] = wc [j] ;
+    }
+
+    // -------------------------------------------------------------------------
+    // compute the new rows of R and C, from left to right
+    // -------------------------------------------------------------------------
+
+    int ok = TRUE ;
+    Int nt = 0 ;
+    size_t tnz = 0 ;
+    Tp [0] = 0 ;
+
+    while (ok)
+    {
+
+        // ---------------------------------------------------------------------
+        // find the leftmost nonzero k in w, and prune the zeros from Wlist
+        // ---------------------------------------------------------------------
+
+        Int k = EMPTY ;
+        Int nlive = 0 ;
+        for (Int p = 0 ; p < nw ; p++)
+        {
+            Int j = Wlist [p] ;
+            if (Wx [j] == (Entry) 0)
+            {
+                Wflag [j] = 0 ;
+            }
+            else
+            {
+                Wlist [nlive++] = j ;
+                if (k == EMPTY || j < k) k = j ;
+            }
+        }
+        nw = nlive ;
+        if (k == EMPTY)
+        {
+            // w is now zero; the sweep is done
+            break ;
+        }
+
+        Entry a = Wx [k] ;
+        Int rlen = Rrlen [k] ;
+        if (!spqr_sweep_push (Work, tnz + nw + rlen + 1, cc))
+        {
+            // out of memory
+            ok = FALSE ;
+            break ;
+        }
+        Int *Tj = Work->Tj ;
+        Entry *Tx = Work->Tx ;
+        Entry *Tck = Tc + nt * bncols ;
+        Tk [nt] = k ;
+
+        if (rlen == 0)
+        {
+
+            // -----------------------------------------------------------------
+            // row k of R is empty: w becomes row k of R
+            // -----------------------------------------------------------------
+
+            if (!update)
+            {
+                // R'*R - w'*w is not positive definite
+                ERROR (CHOLMOD_NOT_POSDEF, "cannot delete row") ;
+                ok = FALSE ;
+                break ;
+            }
+
+            // scale w so that its leftmost entry is real and positive
+            double anorm = spqr_abs (a) ;
+            Entry phase = spqr_conj (a) / (Entry) anorm ;
+            Tj [tnz] = k ;
+            Tx [tnz] = anorm ;
+            tnz++ ;
+            for (Int p = 0 ; p < nw ; p++)
+            {
+                Int j = Wlist [p] ;
+                if (j != k)
+                {
+                    Tj [tnz] = j ;
+                    Tx [tnz] = phase * Wx [j] ;
+                    tnz++ ;
+                }
+                Wx [j] = 0 ;
+                Wflag [j] = 0 ;
+            }
+            nw = 0 ;
+            for (Int j = 0 ; j < bncols ; j++)
+            {
+                Tck [j] = phase * Wc [j] ;
+            }
+            Tp [++nt] = tnz ;
+            break ;
+        }
+
+        // ---------------------------------------------------------------------
+        // scatter row k of R into X, and add its pattern to w
+        // ---------------------------------------------------------------------
+
+        Int *Rrj = S->Rrj ;
+        Entry *Rrx = S->Rrx ;
+        for (Int p = Rrp [k] ; p < Rrp [k] + rlen ; p++)
+        {
+            Int j = Rrj [p] ;
+            X [j] = Rrx [p] ;
+            if (!Wflag [j])
+            {
+                Wflag [j] = 1 ;
+                Wx [j] = 0 ;
+                Wlist [nw++] = j ;
+            }
+        }
+        double rho = spqr_abs (Rrx [Rrp [k]]) ;     // R(k,k), real positive
+
+        // ---------------------------------------------------------------------
+        // rotate row k of R and w, so that w(k) becomes zero
+        // ---------------------------------------------------------------------
+
+        // The new row k of R and the new w are [r ; w] = G * [r ; w], where
+        // G = [c conj(s) ; -s c] for an update, or G = [1 -conj(s) ; -s 1] / c
+        // for a downdate.  The new R(k,k) is real and positive in both cases.
+
+        double c ;
+        Entry s ;
+        if (update)
+        {
+            double nrm = SuiteSparse_config_hypot (rho, spqr_abs (a)) ;
+            c = rho / nrm ;
+            s = a / (Entry) nrm ;
+        }
+        else
+        {
+            s = a / (Entry) rho ;
+            double t = spqr_abs (s) ;
+            if (!(t < 1))
+            {
+                // R'*R - w'*w is not positive definite
+                ERROR (CHOLMOD_NOT_POSDEF, "cannot delete row") ;
+                ok = FALSE ;
+                break ;
+            }
+            c = sqrt ((1 - t) * (1 + t)) ;
+        }
+        Entry sconj = spqr_conj (s) ;
+        Entry ce = (Entry) c ;
+
+        // the diagonal comes first in the new row k of R
+        Tj [tnz] = k ;
+        tnz++ ;
+        Int pdiag = tnz - 1 ;
+        for (Int p = 0 ; p < nw ; p++)
+        {
+            Int j = Wlist [p] ;
+            Entry rj = X [j] ;
+            Entry wj = Wx [j] ;
+            Entry r2, w2 ;
+            if (update)
+            {
+                r2 = ce * rj + sconj * wj ;
+                w2 = ce * wj - s * rj ;
+            }
+            else
+            {
+                r2 = (rj - sconj * wj) / ce ;
+                w2 = (wj - s * rj) / ce ;
+            }
+            X [j] = 0 ;
+            if (j == k)
+            {
+                // keep the diagonal real, and w(k) exactly zero
+                Tx [pdiag] = update ? (c * rho + spqr_abs (a) * spqr_abs (s))
+                                    : (c * rho) ;
+                Wx [j] = 0 ;
+            }
+            else
+            {
+                Wx [j] = w2 ;
+                if (r2 != (Entry) 0)
+                {
+                    Tj [tnz] = j ;
+                    Tx [tnz] = r2 ;
+                    tnz++ ;
+                }
+            }
+        }
+        Entry *Crk = Crx + k * bncols ;
+        for (Int j = 0 ; j < bncols ; j++)
+        {
+            Entry cj = Crk [j] ;
+            Entry wj = Wc [j] ;
+            if (update)
+            {
+                Tck [j] = ce * cj + sconj * wj ;
+                Wc [j] = ce * wj - s * cj ;
+            }
+            else
+            {
+                Tck [j] = (cj - sconj * wj) / ce ;
+                Wc [j] = (wj - s * cj) / ce ;
+            }
+        }
+        Tp [++nt] = tnz ;
+    }
+
+    // clear the workspace
+    for (Int p = 0 ; p < nw ; p++)
+    {
+        Int j = Wlist [p] ;
+        Wx [j] = 0 ;
+        Wflag [j] = 0 ;
+    }
+    if (!ok)
+    {
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // replace the rows of R and C
+    // -------------------------------------------------------------------------
+
+    Int need = 0 ;
+    for (Int t = 0 ; t < nt ; t++)
+    {
+        Int len = Tp [t+1] - Tp [t] ;
+        if (len > Rrlen [Tk [t]])
+        {
+            need += len ;
+        }
+    }
+    if (!spqr_rows_grow (S, need, cc))
+    {
+        // out of memory
+        return (FALSE) ;
+    }
+
+    Int *Rrj = S->Rrj ;
+    Entry *Rrx = S->Rrx ;
+    Int *Tj = Work->Tj ;
+    Entry *Tx = Work->Tx ;
+    for (Int t = 0 ; t < nt ; t++)
+    {
+        Int k = Tk [t] ;
+        Int len = Tp [t+1] - Tp [t] ;
+        if (len > Rrlen [k])
+        {
+            // move row k to the tail
+            Rrp [k] = S->rrtail ;
+            S->rrtail += len ;
+        }
+        Rrlen [k] = len ;
+        Int q = Rrp [k] ;
+        for (Int p = Tp [t] ; p < Tp [t+1] ; p++)
+        {
+            Rrj [q] = Tj [p] ;
+            Rrx [q] = Tx [p] ;
+            q++ ;
+        }
+        for (Int j = 0 ; j < bncols ; j++)
+        {
+            Crx [k*bncols + j] = Tc [t*bncols + j] ;
+        }
+    }
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === spqr_stream_torows ======================================================
+// =============================================================================
+
+// Convert R and C from column form to row form.  R is e-by-n, with e <= n.
+// Each nonzero row i of R is placed in row k of the row form, where k is the
+// column index of its leftmost nonzero, and scaled so that R(k,k) is real and
+// positive.  If R is not upper trapezoidal, two rows of R can have the same
+// leftmost column; all but the first such row are then applied as updates.
+
+template <typename Entry, typename Int> static int spqr_stream_torows
+(
+    SuiteSparseQR_stream <Entry, Int> *S,
+    spqr_updown_work <Entry, Int> *Work,
+    cholmod_common *cc
+)
+{
+    if (S->Rrp != NULL)
+    {
+        // R and C are already in row form
+        return (TRUE) ;
+    }
+
+    Int n = S->n ;
+    Int bncols = S->bncols ;
+    Int e = 0, rnz = 0 ;
+    Int *Rp = NULL, *Ri = NULL ;
+    Entry *Rx = NULL, *Cx = NULL ;
+    Int ldc = 0 ;
+    if (S->R != NULL)
+    {
+        e = S->R->nrow ;
+        Rp = (Int *) S->R->p ;
+        Ri = (Int *) S->R->i ;
+        Rx = (Entry *) S->R->x ;
+        rnz = Rp [n] ;
+        if (S->C != NULL)
+        {
+            Cx = (Entry *) S->C->x ;
+            ldc = S->C->d ;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // allocate the row form, and workspace for the transpose of R
+    // -------------------------------------------------------------------------
+
+    S->rrsize = 2 * rnz + n ;
+    S->rrtail = 0 ;
+    S->Rrp   = (Int *) spqr_malloc <Int> (n, sizeof (Int), cc) ;
+    S->Rrlen = (Int *) spqr_calloc <Int> (n, sizeof (Int), cc) ;
+    S->Rrj   = (Int *) spqr_malloc <Int> (S->rrsize, sizeof (Int), cc) ;
+    S->Rrx   = (Entry *) spqr_malloc <Int> (S->rrsize, sizeof (Entry), cc) ;
+    S->Crx   = (Entry *) spqr_calloc <Int> (n*bncols, sizeof (Entry), cc) ;
+    Int *Tp  = (Int *) spqr_calloc <Int> (e+1, sizeof (Int), cc) ;
+    Int *Tj  = (Int *) spqr_malloc <Int> (rnz, sizeof (Int), cc) ;
+    Entry *Tx = (Entry *) spqr_malloc <Int> (rnz, sizeof (Entry), cc) ;
+
+    #define FREE_TRANSPOSE \
+        spqr_free <Int> (e+1, sizeof (Int), Tp, cc) ; \
+        spqr_free <Int> (rnz, sizeof (Int), Tj, cc) ; \
+        spqr_free <Int> (rnz, sizeof (Entry), Tx, cc) ;
+
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        spqr_stream_freerows (S, cc) ;
+        FREE_TRANSPOSE ;
+        return (FALSE) ;
+    }
+    for (Int k = 0 ; k < n ; k++)
+    {
+        S->Rrp [k] = 0 ;
+    }
+
+    // -------------------------------------------------------------------------
+    // Tp, Tj, Tx = the rows of R, with explicit zeros removed
+    // -------------------------------------------------------------------------
+
+    for (Int j = 0 ; j < n && Rp != NULL ; j++)
+    {
+        for (Int p = Rp [j] ; p < Rp [j+1] ; p++)
+        {
+            if (Rx [p] != (Entry) 0) Tp [Ri [p]]++ ;
+        }
+    }
+    spqr_cumsum (e, Tp) ;
+    for (Int j = 0 ; j < n && Rp != NULL ; j++)
+    {
+        for (Int p = Rp [j] ; p < Rp [j+1] ; p++)
+        {
+            if (Rx [p] != (Entry) 0)
+            {
+                Int q = Tp [Ri [p]]++ ;
+                Tj [q] = j ;
+                Tx [q] = Rx [p] ;
+            }
+        }
+    }
+    spqr_shift (e, Tp) ;
+
+    // -------------------------------------------------------------------------
+    // place each row of R by its leftmost column index
+    // -------------------------------------------------------------------------
+
+    // Columns of R are visited in order, so the leftmost entry of each row of
+    // R comes first in Tj, Tx.
+    int ok = TRUE ;
+    Entry *Ck = Work->Wc + bncols ;     // size bncols workspace
+    for (Int i = 0 ; ok && i < e ; i++)
+    {
+        Int len = Tp [i+1] - Tp [i] ;
+        if (len == 0)
+        {
+            // row i is empty; its row of C only adds to the residual
+            continue ;
+        }
+        for (Int j = 0 ; j < bncols ; j++)
+        {
+            Ck [j] = Cx [i + j*ldc] ;
+        }
+        Int k = Tj [Tp [i]] ;
+        if (S->Rrlen [k] == 0)
+        {
+            // row i becomes row k, scaled so that R(k,k) is real and positive
+            Entry a = Tx [Tp [i]] ;
+            Entry phase = spqr_conj (a) / (Entry) spqr_abs (a) ;
+            Int q = S->rrtail ;
+            S->Rrp [k] = q ;
+            S->Rrlen [k] = len ;
+            S->Rrj [q] = k ;
+            S->Rrx [q] = spqr_abs (a) ;
+            for (Int p = Tp [i] + 1 ; p < Tp [i+1] ; p++)
+            {
+                q++ ;
+                S->Rrj [q] = Tj [p] ;
+                S->Rrx [q] = phase * Tx [p] ;
+            }
+            S->rrtail += len ;
+            for (Int j = 0 ; j < bncols ; j++)
+            {
+                S->Crx [k*bncols + j] = phase * Ck [j] ;
+            }
+        }
+        else
+        {
+            // row k is already taken; apply row i as an update
+            ok = spqr_sweep (TRUE, len, Tj + Tp [i], Tx + Tp [i], Ck, S, Work,
+                cc) ;
+        }
+    }
+
+    FREE_TRANSPOSE ;
+    if (!ok)
+    {
+        // out of memory
+        spqr_stream_freerows (S, cc) ;
+        return (FALSE) ;
+    }
+
+    spqr_free_sparse <Int> (&(S->R), cc) ;
+    spqr_free_dense <Int> (&(S->C), cc) ;
+    return (TRUE) ;
+}
+
+// =============================================================================
+// === SuiteSparseQR_stream_updown =============================================
+// =============================================================================
+
+// Add (update TRUE) or delete (update FALSE) the rows of A and B.  Returns TRUE
+// if successful, FALSE otherwise.  If out of memory, or if a row cannot be
+// deleted, the rows before it have been applied and S->nrows is updated to
+// reflect them; the row that failed and the rows after it are not applied.
+
+#define FREE_ALL \
+        spqr_free <Int> (n, sizeof (Entry), Work.Wx, cc) ; \
+        spqr_free <Int> (n, sizeof (Entry), Work.X, cc) ; \
+        spqr_free <Int> (n, sizeof (Int), Work.Wflag, cc) ; \
+        spqr_free <Int> (n, sizeof (Int), Work.Wlist, cc) ; \
+        spqr_free <Int> (2*bncols, sizeof (Entry), Work.Wc, cc) ; \
+        spqr_free <Int> (n+1, sizeof (Int), Work.Tk, cc) ; \
+        spqr_free <Int> (n+1, sizeof (Int), Work.Tp, cc) ; \
+        spqr_free <Int> (n*bncols, sizeof (Entry), Work.Tc, cc) ; \
+        spqr_free <Int> (Work.tsize, sizeof (Int), Work.Tj, cc) ; \
+        spqr_free <Int> (Work.tsize, sizeof (Entry), Work.Tx, cc) ; \
+        spqr_free <Int> (mk+1, sizeof (Int), Ar_p, cc) ; \
+        spqr_free <Int> (anz, sizeof (Int), Ar_j, cc) ; \
+        spqr_free <Int> (anz, sizeof (Entry), Ar_x, cc) ; \
+        spqr_free <Int> (bncols, sizeof (Entry), Bi, cc) ;
+
+template <typename Entry, typename Int> int SuiteSparseQR_stream_updown
+(
+    // inputs, not modified
+    int update,             // TRUE: add the rows, FALSE: delete them
+    cholmod_sparse *A,      // rows of A to add or delete, mk-by-n
+    cholmod_dense *B,       // rows of B to add or delete, mk-by-bncols.
+                            // Ignored if bncols is zero.
+    // input/output
+    SuiteSparseQR_stream <Entry, Int> *S,
+    // workspace and parameters
+    cholmod_common *cc
+)
+{
+    RETURN_IF_NULL_COMMON (FALSE) ;
+    RETURN_IF_NULL (A, FALSE) ;
+    RETURN_IF_NULL (S, FALSE) ;
+    int64_t xtype = spqr_type <Entry> ( ) ;
+    RETURN_IF_XTYPE_INVALID (A, FALSE) ;
+    cc->status = CHOLMOD_OK ;
+
+    Int n = S->n ;
+    Int bncols = S->bncols ;
+    Int mk = A->nrow ;
+    if ((Int) A->ncol != n || !A->packed || A->stype != 0)
+    {
+        ERROR (CHOLMOD_INVALID, "invalid rows of A") ;
+        return (FALSE) ;
+    }
+    if (bncols > 0 && (B == NULL || (Int) B->nrow != mk ||
+        (Int) B->ncol != bncols || B->xtype + B->dtype != xtype))
+    {
+        ERROR (CHOLMOD_INVALID, "invalid rows of B") ;
+        return (FALSE) ;
+    }
+    if (mk == 0)
+    {
+        // nothing to do
+        return (TRUE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // allocate workspace
+    // -------------------------------------------------------------------------
+
+    Int *Ap = (Int *) A->p ;
+    Int *Ai = (Int *) A->i ;
+    Entry *Ax = (Entry *) A->x ;
+    Int anz = Ap [n] ;
+
+    spqr_updown_work <Entry, Int> Work ;
+    Work.Wx    = (Entry *) spqr_calloc <Int> (n, sizeof (Entry), cc) ;
+    Work.X     = (Entry *) spqr_calloc <Int> (n, sizeof (Entry), cc) ;
+    Work.Wflag = (Int *) spqr_calloc <Int> (n, sizeof (Int), cc) ;
+    Work.Wlist = (Int *) spqr_malloc <Int> (n, sizeof (Int), cc) ;
+    Work.Wc    = (Entry *) spqr_malloc <Int> (2*bncols, sizeof (Entry), cc) ;
+    Work.Tk    = (Int *) spqr_malloc <Int> (n+1, sizeof (Int), cc) ;
+    Work.Tp    = (Int *) spqr_malloc <Int> (n+1, sizeof (Int), cc) ;
+    Work.Tc    = (Entry *) spqr_malloc <Int> (n*bncols, sizeof (Entry), cc) ;
+    Work.tsize = n + 1 ;
+    Work.Tj    = (Int *) spqr_malloc <Int> (Work.tsize, sizeof (Int), cc) ;
+    Work.Tx    = (Entry *) spqr_malloc <Int> (Work.tsize, sizeof (Entry), cc) ;
+
+    // the rows of A(:,Qfill), in row form
+    Int *Ar_p  = (Int *) spqr_calloc <Int> (mk+1, sizeof (Int), cc) ;
+    Int *Ar_j  = (Int *) spqr_malloc <Int> (anz, sizeof (Int), cc) ;
+    Entry *Ar_x = (Entry *) spqr_malloc <Int> (anz, sizeof (Entry), cc) ;
+    Entry *Bi  = (Entry *) spqr_malloc <Int> (bncols, sizeof (Entry), cc) ;
+
+    if (cc->status < CHOLMOD_OK)
+    {
+        // out of memory
+        FREE_ALL ;
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // convert R and C to row form, if not already
+    // -------------------------------------------------------------------------
+
+    if (!spqr_stream_torows (S, &Work, cc))
+    {
+        // out of memory
+        FREE_ALL ;
+        return (FALSE) ;
+    }
+
+    // -------------------------------------------------------------------------
+    // transpose A(:,Qfill)
+    // -------------------------------------------------------------------------
+
+    Int *Qfill = S->Qfill ;
+    for (Int p = 0 ; p < anz ; p++)
+    {
+        Ar_p [Ai [p]]++ ;
+    }
+    spqr_cumsum (mk, Ar_p) ;
+    for (Int k = 0 ; k < n ; k++)
+    {
+        Int j = Qfill [k] ;
+        for (Int p = Ap [j] ; p < Ap [j+1] ; p++)
+        {
+            Int q = Ar_p [Ai [p]]++ ;
+            Ar_j [q] = k ;
+            Ar_x [q] = Ax [p] ;
+        }
+    }
+    spqr_shift (mk, Ar_p) ;
+
+    // -------------------------------------------------------------------------
+    // apply each row
+    // -------------------------------------------------------------------------
+
+    Entry *Bx = (bncols > 0) ? ((Entry *) B->x) : NULL ;
+    Int ldb = (bncols > 0) ? ((Int) B->d) : 0 ;
+    int ok = TRUE ;
+    for (Int i = 0 ; ok && i < mk ; i++)
+    {
+        for (Int j = 0 ; j < bncols ; j++)
+        {
+            Bi [j] = Bx [i + j*ldb] ;
+        }
+        ok = spqr_sweep (update, Ar_p [i+1] - Ar_p [i], Ar_j + Ar_p [i],
+            Ar_x + Ar_p [i], Bi, S, &Work, cc) ;
+        if (ok)
+        {
+            S->nrows += update ? 1 : (-1) ;
+        }
+    }
+
+    FREE_ALL ;
+    return (ok) ;
+}
+
+template int SuiteSparseQR_stream_updown <double, int32_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <double, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_updown <Complex, int32_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <Complex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_updown <float, int32_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <float, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_updown <FComplex, int32_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <FComplex, int32_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_updown <double, int64_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <double, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_updown <Complex, int64_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <Complex, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_updown <float, int64_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <float, int64_t> *S,
+    cholmod_common *cc
+) ;
+template int SuiteSparseQR_stream_updown <FComplex, int64_t>
+(
+    int update,
+    cholmod_sparse *A,
+    cholmod_dense *B,
+    SuiteSparseQR_stream <FComplex, int64_t> *S,
+    cholmod_common *cc
+) ;
+
+#endif
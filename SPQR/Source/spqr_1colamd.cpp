@@ -781,6 +781,68 @@ template int spqr_1colamd <Complex, int32_t>  // TRUE if OK, FALSE otherwise
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template int spqr_1colamd <float, int32_t>  // TRUE if OK, FALSE otherwise
+(
+    // inputs, not modified
+    int ordering,           // all available, except 0:fixed and 3:given
+                            // treated as 1:natural
+    double tol,             // only accept singletons above tol
+    int32_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // outputs, neither allocated nor defined on input
+
+    int32_t **p_Q1fill,        // size n+bncols, fill-reducing
+                            // or natural ordering
+
+    int32_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int32_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int32_t *p_n1cols,         // number of column singletons found
+    int32_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template int spqr_1colamd <FComplex, int32_t>  // TRUE if OK, FALSE otherwise
+(
+    // inputs, not modified
+    int ordering,           // all available, except 0:fixed and 3:given
+                            // treated as 1:natural
+    double tol,             // only accept singletons above tol
+    int32_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // outputs, neither allocated nor defined on input
+
+    int32_t **p_Q1fill,        // size n+bncols, fill-reducing
+                            // or natural ordering
+
+    int32_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int32_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int32_t *p_n1cols,         // number of column singletons found
+    int32_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 
 template  int spqr_1colamd <double, int64_t> // TRUE if OK, FALSE otherwise
 (
@@ -845,3 +907,65 @@ template int spqr_1colamd <Complex, int64_t> // TRUE if OK, FALSE otherwise
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template int spqr_1colamd <float, int64_t> // TRUE if OK, FALSE otherwise
+(
+    // inputs, not modified
+    int ordering,           // all available, except 0:fixed and 3:given
+                            // treated as 1:natural
+    double tol,             // only accept singletons above tol
+    int64_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // outputs, neither allocated nor defined on input
+
+    int64_t **p_Q1fill,        // size n+bncols, fill-reducing
+                            // or natural ordering
+
+    int64_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int64_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int64_t *p_n1cols,         // number of column singletons found
+    int64_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template int spqr_1colamd <FComplex, int64_t> // TRUE if OK, FALSE otherwise
+(
+    // inputs, not modified
+    int ordering,           // all available, except 0:fixed and 3:given
+                            // treated as 1:natural
+    double tol,             // only accept singletons above tol
+    int64_t bncols,            // number of columns of B
+    cholmod_sparse *A,      // m-by-n sparse matrix
+
+    // outputs, neither allocated nor defined on input
+
+    int64_t **p_Q1fill,        // size n+bncols, fill-reducing
+                            // or natural ordering
+
+    int64_t **p_R1p,           // size n1rows+1, R1p [k] = # of nonzeros in kth
+                            // row of R1.  NULL if n1cols == 0.
+    int64_t **p_P1inv,         // size m, singleton row inverse permutation.
+                            // If row i of A is the kth singleton row, then
+                            // P1inv [i] = k.  NULL if n1cols is zero.
+
+    cholmod_sparse **p_Y,   // on output, only the first n-n1cols+1 entries of
+                            // Y->p are defined (if Y is not NULL), where
+                            // Y = [A B] or Y = [A2 B2].  If B is empty and
+                            // there are no column singletons, Y is NULL
+
+    int64_t *p_n1cols,         // number of column singletons found
+    int64_t *p_n1rows,         // number of corresponding rows found
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
@@ -100,6 +100,10 @@ template <typename Entry, typename Int> SuiteSparseQR_factorization <Entry, Int>
     Int *Bi,               // size bnz = Bp [bncols], row indices of B
     Entry *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 )
@@ -137,6 +141,8 @@ template <typename Entry, typename Int> SuiteSparseQR_factorization <Entry, Int>
 
     QR->QRsym = NULL ;
     QR->QRnum = NULL ;
+    QR->Blob = NULL ;
+    QR->qless = FALSE ;
 
     QR->R1p = NULL ;
     QR->R1j = NULL ;
@@ -633,7 +639,8 @@ template <typename Entry, typename Int> SuiteSparseQR_factorization <Entry, Int>
         QRsym = spqr_analyze (A, SPQR_ORDERING_GIVEN, Q1fill,
             tol >= 0, keepH, cc) ;
         t1 = SUITESPARSE_TIME ;
-        QRnum = spqr_factorize <Entry, Int> (&A, FALSE, tol, n, QRsym, cc) ;
+        QRnum = spqr_factorize <Entry, Int> (&A, FALSE, tol, n, QRsym,
+            trace_func, trace_data, cc) ;
     }
     else
     {
@@ -641,7 +648,8 @@ template <typename Entry, typename Int> SuiteSparseQR_factorization <Entry, Int>
         QRsym = spqr_analyze <Int> (Y, SPQR_ORDERING_FIXED, NULL,
             tol >= 0, keepH, cc) ;
         t1 = SUITESPARSE_TIME ;
-        QRnum = spqr_factorize <Entry, Int> (&Y, TRUE, tol, n2, QRsym, cc) ;
+        QRnum = spqr_factorize <Entry, Int> (&Y, TRUE, tol, n2, QRsym,
+            trace_func, trace_data, cc) ;
         // Y has been freed
         ASSERT (Y == NULL) ;
     }
@@ -771,6 +779,52 @@ template SuiteSparseQR_factorization <Complex, int32_t> *spqr_1factor <Complex,
     int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
     Complex *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int32_t> *spqr_1factor <float, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int32_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int32_t ldb,               // if dense, the leading dimension of B
+    int32_t *Bp,               // size bncols+1, column pointers of B
+    int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    float *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int32_t> *spqr_1factor <FComplex, int32_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int32_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int32_t ldb,               // if dense, the leading dimension of B
+    int32_t *Bp,               // size bncols+1, column pointers of B
+    int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    FComplex *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -790,6 +844,10 @@ template SuiteSparseQR_factorization <double, int32_t> *spqr_1factor <double, in
     int32_t *Bi,               // size bnz = Bp [bncols], row indices of B
     double *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -808,6 +866,52 @@ template SuiteSparseQR_factorization <Complex, int64_t> *spqr_1factor <Complex,
     int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
     Complex *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <float, int64_t> *spqr_1factor <float, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int64_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int64_t ldb,               // if dense, the leading dimension of B
+    int64_t *Bp,               // size bncols+1, column pointers of B
+    int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    float *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template SuiteSparseQR_factorization <FComplex, int64_t> *spqr_1factor <FComplex, int64_t>
+(
+    // inputs, not modified
+    int ordering,           // all, except 3:given treated as 0:fixed
+    double tol,             // only accept singletons above tol.  If tol <= -2,
+                            // then use the default tolerance
+    int64_t bncols,            // number of columns of B
+    int keepH,              // if TRUE, keep the Householder vectors
+    cholmod_sparse *A,      // m-by-n sparse matrix
+    int64_t ldb,               // if dense, the leading dimension of B
+    int64_t *Bp,               // size bncols+1, column pointers of B
+    int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
+    FComplex *Bx,              // size bnz, numerical values of B
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -827,6 +931,10 @@ template SuiteSparseQR_factorization <double, int64_t> *spqr_1factor <double, in
     int64_t *Bi,               // size bnz = Bp [bncols], row indices of B
     double *Bx,              // size bnz, numerical values of B
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -93,7 +93,7 @@ template <typename Int> spqr_symbolic <Int> *spqr_analyze
 
     do_parallel_analysis = (cc->SPQR_grain > 1) ;
 
-    // The analysis for TBB parallelism attempts to construct a task graph with
+    // The analysis for task-tree parallelism attempts to construct a task graph with
     // leaf nodes with flop counts >= max ((total flops) / cc->SPQR_grain,
     // cc->SPQR_small).  If cc->SPQR_grain <= 1, or if the total flop
     // count is less than cc->SPQR_small, then no parallelism will be
@@ -121,9 +121,10 @@ template <typename Int> spqr_symbolic <Int> *spqr_analyze
     }
 
     // Disable the GPU if the Householder vectors are requested, if we're
-    // using TBB, if rank detection is requested, or if A is not real
+    // using the task tree, if rank detection is requested, or if A is not
+    // real double
     if (keepH || do_parallel_analysis || do_rank_detection ||
-        A->xtype != CHOLMOD_REAL)
+        A->xtype != CHOLMOD_REAL || A->dtype != CHOLMOD_DOUBLE)
     {
         useGPU = FALSE ;
     }
@@ -345,6 +346,7 @@ template <typename Int> spqr_symbolic <Int> *spqr_analyze
     QRsym->m = m ;
     QRsym->n = n ;
     QRsym->do_rank_detection = do_rank_detection ;
+    QRsym->do_pivoting = FALSE ;
     QRsym->anz = anz ;
     QRsym->nf = nf = Sc->nsuper ;       // number of supernodes / fronts
     QRsym->rjsize = Sc->ssize ;         // size of int part of supernodal R
@@ -121,6 +121,7 @@ template <typename Entry, typename Int> spqr_work <Entry, Int> *get_Work
             (Entry *) spqr_malloc <Int> (wtsize, sizeof (Entry), cc) ;
         Work [stack].sumfrank = 0 ;
         Work [stack].maxfrank = 0 ;
+        Work [stack].stack_peak = 0 ;
 
         Work [stack].wscale = 0 ;
         Work [stack].wssq   = 0 ;
@@ -179,6 +180,10 @@ template <typename Entry, typename Int> spqr_numeric <Entry, Int> *spqr_factoriz
     Int ntol,                      // apply tol only to first ntol columns
     spqr_symbolic <Int> *QRsym,
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 )
@@ -327,6 +332,18 @@ template <typename Entry, typename Int> spqr_numeric <Entry, Int> *spqr_factoriz
     Stacks     = (Entry **) spqr_calloc <Int> (ns, sizeof (Entry *), cc) ;
     Stack_size = (Int *)   spqr_calloc <Int> (ns, sizeof (Int),    cc) ;
 
+    if (QRsym->do_pivoting)
+    {
+        // column permutation found by pivoting within each front
+        QRnum->Pcol    = (Int *) spqr_malloc <Int> (n, sizeof (Int), cc) ;
+        QRnum->PcolInv = (Int *) spqr_malloc <Int> (n, sizeof (Int), cc) ;
+    }
+    else
+    {
+        QRnum->Pcol = NULL ;
+        QRnum->PcolInv = NULL ;
+    }
+
     QRnum->Rblock     = Rblock ;
     QRnum->Rdead      = Rdead ;
     QRnum->Stacks     = Stacks ;
@@ -470,6 +487,15 @@ template <typename Entry, typename Int> spqr_numeric <Entry, Int> *spqr_factoriz
     // create the Blob : everything the numeric factorization kernel needs
     // -------------------------------------------------------------------------
 
+    if (QRnum->Pcol != NULL)
+    {
+        // each front starts with its pivot columns in their symbolic order
+        for (j = 0 ; j < n ; j++)
+        {
+            QRnum->Pcol [j] = j ;
+        }
+    }
+
     spqr_blob <Entry, Int> Blob ;
     Blob.QRsym = QRsym ;
     Blob.QRnum = QRnum ;
@@ -480,6 +506,8 @@ template <typename Entry, typename Int> spqr_numeric <Entry, Int> *spqr_factoriz
     Blob.Sx = Sx ;
     Blob.ntol = ntol ;
     Blob.fchunk = fchunk ;
+    Blob.trace = trace_func ;
+    Blob.trace_data = trace_data ;
     Blob.cc = cc ;
 
     // -------------------------------------------------------------------------
@@ -496,23 +524,15 @@ template <typename Entry, typename Int> spqr_numeric <Entry, Int> *spqr_factoriz
 
     if (ntasks == 1)
     {
-        // Just one task, with or without TBB installed: don't use TBB
+        // Just one task: factorize all the fronts with a single stack
         spqr_kernel <Entry, Int> (0, &Blob) ;        // sequential case
     }
     else
     {
-#if 0 /* ifdef HAVE_TBB (TBB removed) */
-        // parallel case: TBB is installed, and there is more than one task
+        // the work is split into multiple tasks, each with its own stack.
+        // Use OpenMP if available; otherwise the tasks are done in order.
         int nthreads = MAX (0, cc->SPQR_nthreads) ;
         spqr_parallel (ntasks, nthreads, &Blob) ;
-#else
-        // TBB not installed, but the work is still split into multiple tasks.
-        // do tasks 0 to ntasks-2 (skip the placeholder root task id = ntasks-1)
-        for (Int id = 0 ; id < ntasks-1 ; id++)
-        {
-            spqr_kernel (id, &Blob) ;
-        }
-#endif
     }
 
     PR (("] did the kernel\n")) ;
@@ -719,6 +739,18 @@ template <typename Entry, typename Int> spqr_numeric <Entry, Int> *spqr_factoriz
         // Wi no longer needed ]
     }
 
+    // -------------------------------------------------------------------------
+    // invert the column permutation found by pivoting
+    // -------------------------------------------------------------------------
+
+    if (QRnum->Pcol != NULL)
+    {
+        for (j = 0 ; j < n ; j++)
+        {
+            QRnum->PcolInv [QRnum->Pcol [j]] = j ;
+        }
+    }
+
     // -------------------------------------------------------------------------
     // find the rank and return the result
     // -------------------------------------------------------------------------
@@ -758,6 +790,10 @@ template spqr_numeric <double, int32_t> *spqr_factorize <double, int32_t>
     int32_t ntol,                      // apply tol only to first ntol columns
     spqr_symbolic <int32_t> *QRsym,
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -772,6 +808,46 @@ template spqr_numeric <Complex, int32_t> *spqr_factorize <Complex, int32_t>
     int32_t ntol,                      // apply tol only to first ntol columns
     spqr_symbolic <int32_t> *QRsym,
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template spqr_numeric <float, int32_t> *spqr_factorize <float, int32_t>
+(
+    // input, optionally freed on output
+    cholmod_sparse **Ahandle,
+
+    // inputs, not modified
+    int32_t freeA,                     // if TRUE, free A on output
+    double tol,                     // for rank detection
+    int32_t ntol,                      // apply tol only to first ntol columns
+    spqr_symbolic <int32_t> *QRsym,
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template spqr_numeric <FComplex, int32_t> *spqr_factorize <FComplex, int32_t>
+(
+    // input, optionally freed on output
+    cholmod_sparse **Ahandle,
+
+    // inputs, not modified
+    int32_t freeA,                     // if TRUE, free A on output
+    double tol,                     // for rank detection
+    int32_t ntol,                      // apply tol only to first ntol columns
+    spqr_symbolic <int32_t> *QRsym,
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -786,6 +862,10 @@ template spqr_numeric <double, int64_t> *spqr_factorize <double, int64_t>
     int64_t ntol,                      // apply tol only to first ntol columns
     spqr_symbolic <int64_t> *QRsym,
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
@@ -800,6 +880,46 @@ template spqr_numeric <Complex, int64_t> *spqr_factorize <Complex, int64_t>
     int64_t ntol,                      // apply tol only to first ntol columns
     spqr_symbolic <int64_t> *QRsym,
 
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template spqr_numeric <float, int64_t> *spqr_factorize <float, int64_t>
+(
+    // input, optionally freed on output
+    cholmod_sparse **Ahandle,
+
+    // inputs, not modified
+    int64_t freeA,                     // if TRUE, free A on output
+    double tol,                     // for rank detection
+    int64_t ntol,                      // apply tol only to first ntol columns
+    spqr_symbolic <int64_t> *QRsym,
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template spqr_numeric <FComplex, int64_t> *spqr_factorize <FComplex, int64_t>
+(
+    // input, optionally freed on output
+    cholmod_sparse **Ahandle,
+
+    // inputs, not modified
+    int64_t freeA,                     // if TRUE, free A on output
+    double tol,                     // for rank detection
+    int64_t ntol,                      // apply tol only to first ntol columns
+    spqr_symbolic <int64_t> *QRsym,
+
+    // front trace
+    SuiteSparseQR_front_trace_func trace_func,  // NULL if not traced
+    void *trace_data,       // passed to trace_func
+
     // workspace and parameters
     cholmod_common *cc
 ) ;
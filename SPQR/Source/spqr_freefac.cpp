@@ -35,6 +35,21 @@ template <typename Entry, typename Int> void spqr_freefac
     n1rows = QR->n1rows ;
     r1nz   = QR->r1nz ;
 
+    if (QR->Blob != NULL)
+    {
+        // The arrays are held in the blob, which is owned by the user.  Only
+        // the objects and the Rblock and Stacks pointers are freed here.
+        spqr_numeric <Entry, Int> *QRnum = QR->QRnum ;
+        spqr_free <Int> (QRnum->nf, sizeof (Entry *), QRnum->Rblock, cc) ;
+        spqr_free <Int> (QRnum->ns, sizeof (Entry *), QRnum->Stacks, cc) ;
+        spqr_free <Int> (1, sizeof (spqr_numeric <Entry, Int>), QRnum, cc) ;
+        spqr_free <Int> (1, sizeof (spqr_symbolic <Int>), QR->QRsym, cc) ;
+        spqr_free <Int> (1, sizeof (SuiteSparseQR_factorization <Entry, Int>),
+            QR, cc) ;
+        *QR_handle = NULL ;
+        return ;
+    }
+
     spqr_freenum (& (QR->QRnum), cc) ;
     spqr_freesym (& (QR->QRsym), cc) ;
 
@@ -66,6 +81,20 @@ template void spqr_freefac <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template void spqr_freefac <float, int32_t>
+(
+    SuiteSparseQR_factorization <float, int32_t> **QR_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template void spqr_freefac <FComplex, int32_t>
+(
+    SuiteSparseQR_factorization <FComplex, int32_t> **QR_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template void spqr_freefac <double, int64_t>
 (
     SuiteSparseQR_factorization <double, int64_t> **QR_handle,
@@ -80,3 +109,17 @@ template void spqr_freefac <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template void spqr_freefac <float, int64_t>
+(
+    SuiteSparseQR_factorization <float, int64_t> **QR_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template void spqr_freefac <FComplex, int64_t>
+(
+    SuiteSparseQR_factorization <FComplex, int64_t> **QR_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
@@ -39,6 +39,8 @@ template <typename Entry, typename Int> void spqr_freenum
 
     spqr_free <Int> (nf, sizeof (Entry *), QRnum->Rblock, cc) ;
     spqr_free <Int> (n,  sizeof (char),    QRnum->Rdead,  cc) ;
+    spqr_free <Int> (n,  sizeof (Int),     QRnum->Pcol,    cc) ;
+    spqr_free <Int> (n,  sizeof (Int),     QRnum->PcolInv, cc) ;
 
     if (QRnum->keepH)
     {
@@ -89,6 +91,20 @@ template void spqr_freenum <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template void spqr_freenum <float, int32_t>
+(
+    spqr_numeric <float, int32_t> **QRnum_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template void spqr_freenum <FComplex, int32_t>
+(
+    spqr_numeric <FComplex, int32_t> **QRnum_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template void spqr_freenum <Complex, int64_t>
 (
     spqr_numeric <Complex, int64_t> **QRnum_handle,
@@ -96,4 +112,18 @@ template void spqr_freenum <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template void spqr_freenum <float, int64_t>
+(
+    spqr_numeric <float, int64_t> **QRnum_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template void spqr_freenum <FComplex, int64_t>
+(
+    spqr_numeric <FComplex, int64_t> **QRnum_handle,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 // =============================================================================
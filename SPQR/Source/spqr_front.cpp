@@ -98,6 +98,17 @@
     the norms are ignored; a column is never flagged dead.  The default tol
     is set elsewhere as 20 * (m+1) * eps * max column 2-norm of A.
 
+    If Pfront is not NULL, restricted column pivoting is done.  Before
+    column k is reduced, it is swapped with the column j of largest norm
+    F (g:t-1,j) among the pivot columns k+1:ntol-1 with Stair [j] <= t, where
+    t is the staircase of column k.  Since the staircase is monotonic, the
+    swapped columns are those with the same staircase as column k, and the
+    swap causes no fill: the staircase is unchanged, and so are the sizes of
+    the R, H, and C blocks found by the symbolic analysis.  If Householder
+    updates are pending, only columns in the current panel are up to date,
+    so the search is limited to the panel.  Pfront is permuted along with
+    the columns of F.
+
     LAPACK's dlarf* routines are used to construct and apply the Householder
     reflections.  The panel size (block size) is provided as an input
     parameter, which defines the number of Householder vectors in a panel.
@@ -169,6 +180,32 @@ inline Complex spqr_private_larfg (int32_t n, Complex *X, cholmod_common *cc)
     return (tau) ;
 }
 
+inline float spqr_private_larfg (int64_t n, float *X, cholmod_common *cc)
+{
+    float tau = 0 ;
+    SUITESPARSE_LAPACK_slarfg (n, X, X + 1, 1, &tau, cc->blas_ok) ;
+    return (tau) ;
+}
+inline float spqr_private_larfg (int32_t n, float *X, cholmod_common *cc)
+{
+    float tau = 0 ;
+    SUITESPARSE_LAPACK_slarfg (n, X, X + 1, 1, &tau, cc->blas_ok) ;
+    return (tau) ;
+}
+
+inline FComplex spqr_private_larfg (int64_t n, FComplex *X, cholmod_common *cc)
+{
+    FComplex tau = 0 ;
+    SUITESPARSE_LAPACK_clarfg (n, X, X + 1, 1, &tau, cc->blas_ok) ;
+    return (tau) ;
+}
+inline FComplex spqr_private_larfg (int32_t n, FComplex *X, cholmod_common *cc)
+{
+    FComplex tau = 0 ;
+    SUITESPARSE_LAPACK_clarfg (n, X, X + 1, 1, &tau, cc->blas_ok) ;
+    return (tau) ;
+}
+
 template <typename Entry, typename Int> Entry spqr_private_house  // returns tau
 (
     // inputs, not modified
@@ -233,6 +270,36 @@ inline void spqr_private_larf (int32_t m, int32_t n, Complex *V, Complex tau,
         cc->blas_ok) ;
 }
 
+inline void spqr_private_larf (int64_t m, int64_t n, float *V, float tau,
+    float *C, int64_t ldc, float *W, cholmod_common *cc)
+{
+    char left = 'L' ;
+    SUITESPARSE_LAPACK_slarf (&left, m, n, V, 1, &tau, C, ldc, W, cc->blas_ok) ;
+}
+inline void spqr_private_larf (int32_t m, int32_t n, float *V, float tau,
+    float *C, int32_t ldc, float *W, cholmod_common *cc)
+{
+    char left = 'L' ;
+    SUITESPARSE_LAPACK_slarf (&left, m, n, V, 1, &tau, C, ldc, W, cc->blas_ok) ;
+}
+
+inline void spqr_private_larf (int64_t m, int64_t n, FComplex *V,
+    FComplex tau, FComplex *C, int64_t ldc, FComplex *W, cholmod_common *cc)
+{
+    char left = 'L' ;
+    FComplex conj_tau = spqr_conj (tau) ;
+    SUITESPARSE_LAPACK_clarf (&left, m, n, V, 1, &conj_tau, C, ldc, W,
+        cc->blas_ok) ;
+}
+inline void spqr_private_larf (int32_t m, int32_t n, FComplex *V,
+    FComplex tau, FComplex *C, int32_t ldc, FComplex *W, cholmod_common *cc)
+{
+    char left = 'L' ;
+    FComplex conj_tau = spqr_conj (tau) ;
+    SUITESPARSE_LAPACK_clarf (&left, m, n, V, 1, &conj_tau, C, ldc, W,
+        cc->blas_ok) ;
+}
+
 template <typename Entry, typename Int> void spqr_private_apply1
 (
     // inputs, not modified
@@ -263,6 +330,61 @@ template <typename Entry, typename Int> void spqr_private_apply1
 }
 
 
+// =============================================================================
+// === spqr_private_pivot ======================================================
+// =============================================================================
+
+// Restricted column pivoting: find the column j of largest 2-norm of
+// F (g:t-1,j) for j = k:jlast-1, considering only columns with Stair [j] <= t
+// that fit in the staircase of column k, and swap it with column k.
+
+template <typename Entry, typename Int> void spqr_private_pivot
+(
+    Int m,
+    Int g,
+    Int t,
+    Int k,
+    Int jlast,
+    Entry *F,
+    Int *Stair,
+    Int *Pfront
+)
+{
+    Int i, j, jbest = k ;
+    double wbest = -1 ;
+    for (j = k ; j < jlast && (j == k || Stair [j] <= t) ; j++)
+    {
+        double wj = 0 ;
+        Entry *Fj = &F [INDEX (g,j,m)] ;
+        for (i = 0 ; i < t-g ; i++)
+        {
+            double a = spqr_abs (Fj [i]) ;
+            wj += a * a ;
+        }
+        if (wj > wbest)
+        {
+            wbest = wj ;
+            jbest = j ;
+        }
+    }
+
+    if (jbest != k)
+    {
+        // swap columns k and jbest of F, including their R part in rows 0:g-1
+        Entry *Fk = &F [INDEX (0,k,m)] ;
+        Entry *Fj = &F [INDEX (0,jbest,m)] ;
+        for (i = 0 ; i < t ; i++)
+        {
+            Entry fik = Fk [i] ;
+            Fk [i] = Fj [i] ;
+            Fj [i] = fik ;
+        }
+        j = Pfront [k] ;
+        Pfront [k] = Pfront [jbest] ;
+        Pfront [jbest] = j ;
+    }
+}
+
 // =============================================================================
 // === spqr_front ==============================================================
 // =============================================================================
@@ -290,6 +412,9 @@ template <typename Entry, typename Int> Int spqr_front
                         // for each k = 0:n-1, and remain zero on output.
     char *Rdead,        // size npiv; all zero on input.  If k is dead,
                         // Rdead [k] is set to 1
+    Int *Pfront,       // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
 
     // output, not defined on input
     Entry *Tau,         // size n, Householder coefficients
@@ -300,6 +425,8 @@ template <typename Entry, typename Int> Int spqr_front
     // input/output
     double *wscale,
     double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
 
     cholmod_common *cc
 )
@@ -395,6 +522,7 @@ template <typename Entry, typename Int> Int spqr_front
             {
                 // apply pending block of Householder reflections
                 PR (("(1) apply k1 %ld k2 %ld\n", k1, k2)) ;
+                double tstart = (tlarftb == NULL) ? 0 : SUITESPARSE_TIME ;
                 spqr_larftb (
                     0,                          // method 0: Left, Transpose
                     t0-g1, n-k2, nv, m, m,
@@ -402,11 +530,22 @@ template <typename Entry, typename Int> Int spqr_front
                     &Tau [k1],                  // Tau (k1:k-1)
                     &F [INDEX (g1,k2,m)],       // F (g1:t-1, k2:n-1)
                     W, cc) ;                    // size nv*nv + nv*(n-k2)
+                if (tlarftb != NULL) (*tlarftb) += SUITESPARSE_TIME - tstart ;
                 nv = 0 ;        // clear queued-up Householder reflections
                 vzeros = 0 ;
             }
         }
 
+        // ---------------------------------------------------------------------
+        // restricted column pivoting
+        // ---------------------------------------------------------------------
+
+        if (Pfront != NULL && k < ntol)
+        {
+            spqr_private_pivot (m, g, t, k, (nv > 0) ? MIN (ntol, k2) : ntol,
+                F, Stair, Pfront) ;
+        }
+
         // ---------------------------------------------------------------------
         // find a Householder reflection that reduces column k
         // ---------------------------------------------------------------------
@@ -461,6 +600,7 @@ template <typename Entry, typename Int> Int spqr_front
             {
                 // apply pending block of Householder reflections
                 PR (("(2) apply k1 %ld k2 %ld\n", k1, k2)) ;
+                double tstart = (tlarftb == NULL) ? 0 : SUITESPARSE_TIME ;
                 spqr_larftb (
                     0,                          // method 0: Left, Transpose
                     t0-g1, n-k2, nv, m, m,
@@ -468,6 +608,7 @@ template <typename Entry, typename Int> Int spqr_front
                     &Tau [k1],                  // Tau (k1:k-1)
                     &F [INDEX (g1,k2,m)],       // F (g1:t-1, k2:n-1)
                     W, cc) ;                    // size nv*nv + nv*(n-k2)
+                if (tlarftb != NULL) (*tlarftb) += SUITESPARSE_TIME - tstart ;
                 nv = 0 ;        // clear queued-up Householder reflections
                 vzeros = 0 ;
             }
@@ -539,6 +680,7 @@ template <typename Entry, typename Int> Int spqr_front
             {
                 // apply pending block of Householder reflections
                 PR (("(3) apply k1 %ld k2 %ld\n", k1, k2)) ;
+                double tstart = (tlarftb == NULL) ? 0 : SUITESPARSE_TIME ;
                 spqr_larftb (
                     0,                          // method 0: Left, Transpose
                     t-g1, n-k2, nv, m, m,
@@ -546,6 +688,7 @@ template <typename Entry, typename Int> Int spqr_front
                     &Tau [k1],                  // Tau (k1:k2-1)
                     &F [INDEX (g1,k2,m)],       // F (g1:t-1, k2:n-1)
                     W, cc) ;                    // size nv*nv + nv*(n-k2)
+                if (tlarftb != NULL) (*tlarftb) += SUITESPARSE_TIME - tstart ;
                 nv = 0 ;        // clear queued-up Householder reflections
                 vzeros = 0 ;
             }
@@ -593,6 +736,9 @@ template int32_t spqr_front <double, int32_t>
                         // for each k = 0:n-1, and remain zero on output.
     char *Rdead,        // size npiv; all zero on input.  If k is dead,
                         // Rdead [k] is set to 1
+    int32_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
 
     // output, not defined on input
     double *Tau,         // size n, Householder coefficients
@@ -603,6 +749,8 @@ template int32_t spqr_front <double, int32_t>
     // input/output
     double *wscale,
     double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
 
     cholmod_common *cc
 ) ;
@@ -623,6 +771,9 @@ template int32_t spqr_front <Complex, int32_t>
                         // for each k = 0:n-1, and remain zero on output.
     char *Rdead,        // size npiv; all zero on input.  If k is dead,
                         // Rdead [k] is set to 1
+    int32_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
 
     // output, not defined on input
     Complex *Tau,         // size n, Householder coefficients
@@ -633,6 +784,78 @@ template int32_t spqr_front <Complex, int32_t>
     // input/output
     double *wscale,
     double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
+
+    cholmod_common *cc
+) ;
+template int32_t spqr_front <float, int32_t>
+(
+    // input, not modified
+    int32_t m,             // F is m-by-n with leading dimension m
+    int32_t n,
+    int32_t npiv,          // number of pivot columns
+    double tol,         // a column is flagged as dead if its norm is <= tol
+    int32_t ntol,          // apply tol only to first ntol pivot columns
+    int32_t fchunk,        // block size for compact WY Householder reflections,
+                        // treated as 1 if fchunk <= 1
+
+    // input/output
+    float *F,           // frontal matrix F of size m-by-n
+    int32_t *Stair,        // size n, entries F (Stair[k]:m-1, k) are all zero,
+                        // for each k = 0:n-1, and remain zero on output.
+    char *Rdead,        // size npiv; all zero on input.  If k is dead,
+                        // Rdead [k] is set to 1
+    int32_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
+
+    // output, not defined on input
+    float *Tau,         // size n, Householder coefficients
+
+    // workspace, undefined on input and output
+    float *W,           // size b*n, where b = min (fchunk,n,m)
+
+    // input/output
+    double *wscale,
+    double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
+
+    cholmod_common *cc
+) ;
+template int32_t spqr_front <FComplex, int32_t>
+(
+    // input, not modified
+    int32_t m,             // F is m-by-n with leading dimension m
+    int32_t n,
+    int32_t npiv,          // number of pivot columns
+    double tol,         // a column is flagged as dead if its norm is <= tol
+    int32_t ntol,          // apply tol only to first ntol pivot columns
+    int32_t fchunk,        // block size for compact WY Householder reflections,
+                        // treated as 1 if fchunk <= 1
+
+    // input/output
+    FComplex *F,           // frontal matrix F of size m-by-n
+    int32_t *Stair,        // size n, entries F (Stair[k]:m-1, k) are all zero,
+                        // for each k = 0:n-1, and remain zero on output.
+    char *Rdead,        // size npiv; all zero on input.  If k is dead,
+                        // Rdead [k] is set to 1
+    int32_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
+
+    // output, not defined on input
+    FComplex *Tau,         // size n, Householder coefficients
+
+    // workspace, undefined on input and output
+    FComplex *W,           // size b*n, where b = min (fchunk,n,m)
+
+    // input/output
+    double *wscale,
+    double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
 
     cholmod_common *cc
 ) ;
@@ -653,6 +876,9 @@ template int64_t spqr_front <double, int64_t>
                         // for each k = 0:n-1, and remain zero on output.
     char *Rdead,        // size npiv; all zero on input.  If k is dead,
                         // Rdead [k] is set to 1
+    int64_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
 
     // output, not defined on input
     double *Tau,         // size n, Householder coefficients
@@ -663,6 +889,8 @@ template int64_t spqr_front <double, int64_t>
     // input/output
     double *wscale,
     double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
 
     cholmod_common *cc
 ) ;
@@ -683,6 +911,9 @@ template int64_t spqr_front <Complex, int64_t>
                         // for each k = 0:n-1, and remain zero on output.
     char *Rdead,        // size npiv; all zero on input.  If k is dead,
                         // Rdead [k] is set to 1
+    int64_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
 
     // output, not defined on input
     Complex *Tau,         // size n, Householder coefficients
@@ -693,6 +924,78 @@ template int64_t spqr_front <Complex, int64_t>
     // input/output
     double *wscale,
     double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
+
+    cholmod_common *cc
+) ;
+template int64_t spqr_front <float, int64_t>
+(
+    // input, not modified
+    int64_t m,             // F is m-by-n with leading dimension m
+    int64_t n,
+    int64_t npiv,          // number of pivot columns
+    double tol,         // a column is flagged as dead if its norm is <= tol
+    int64_t ntol,          // apply tol only to first ntol pivot columns
+    int64_t fchunk,        // block size for compact WY Householder reflections,
+                        // treated as 1 if fchunk <= 1
+
+    // input/output
+    float *F,           // frontal matrix F of size m-by-n
+    int64_t *Stair,        // size n, entries F (Stair[k]:m-1, k) are all zero,
+                        // for each k = 0:n-1, and remain zero on output.
+    char *Rdead,        // size npiv; all zero on input.  If k is dead,
+                        // Rdead [k] is set to 1
+    int64_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
+
+    // output, not defined on input
+    float *Tau,         // size n, Householder coefficients
+
+    // workspace, undefined on input and output
+    float *W,           // size b*n, where b = min (fchunk,n,m)
+
+    // input/output
+    double *wscale,
+    double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
+
+    cholmod_common *cc
+) ;
+template int64_t spqr_front <FComplex, int64_t>
+(
+    // input, not modified
+    int64_t m,             // F is m-by-n with leading dimension m
+    int64_t n,
+    int64_t npiv,          // number of pivot columns
+    double tol,         // a column is flagged as dead if its norm is <= tol
+    int64_t ntol,          // apply tol only to first ntol pivot columns
+    int64_t fchunk,        // block size for compact WY Householder reflections,
+                        // treated as 1 if fchunk <= 1
+
+    // input/output
+    FComplex *F,           // frontal matrix F of size m-by-n
+    int64_t *Stair,        // size n, entries F (Stair[k]:m-1, k) are all zero,
+                        // for each k = 0:n-1, and remain zero on output.
+    char *Rdead,        // size npiv; all zero on input.  If k is dead,
+                        // Rdead [k] is set to 1
+    int64_t *Pfront,   // size npiv, or NULL.  If not NULL, the columns
+                        // are pivoted, and Pfront [0:npiv-1] is permuted
+                        // in the same way as the columns of F
+
+    // output, not defined on input
+    FComplex *Tau,         // size n, Householder coefficients
+
+    // workspace, undefined on input and output
+    FComplex *W,           // size b*n, where b = min (fchunk,n,m)
+
+    // input/output
+    double *wscale,
+    double *wssq,
+    double *tlarftb,    // if not NULL, the time spent in spqr_larftb is
+                        // added to *tlarftb
 
     cholmod_common *cc
 ) ;
@@ -52,10 +52,11 @@ template <typename Entry, typename Int> void spqr_private_do_panel
     Entry *Hx,
 
     Entry *Tau,         // Householder coefficients (size nh)
+    Int ldx,           // leading dimension of X
 
     // input/output
     Int *Wmap,         // inverse of Wi on input, set to all EMPTY on output
-    Entry *X,           // m-by-n with leading dimension m
+    Entry *X,           // m-by-n with leading dimension ldx
 
     // workspace, undefined on input and output
     Entry *V,           // dense panel
@@ -99,7 +100,7 @@ template <typename Entry, typename Int> void spqr_private_do_panel
     // apply the panel
     // -------------------------------------------------------------------------
 
-    spqr_panel (method, m, n, v, h2-h1, Wi, V, Tau+h1, m, X, C, W, cc) ;
+    spqr_panel (method, m, n, v, h2-h1, Wi, V, Tau+h1, ldx, X, C, W, cc) ;
 
     // -------------------------------------------------------------------------
     // clear the panel mapping
@@ -122,7 +123,7 @@ template <typename Entry, typename Int> void spqr_happly
     // input
     int method,     // 0,1,2,3
 
-    Int m,         // X is m-by-n with leading dimension m
+    Int m,         // X is m-by-n with leading dimension ldx
     Int n,
 
     // FUTURE : make H cholmod_sparse:
@@ -135,7 +136,8 @@ template <typename Entry, typename Int> void spqr_happly
     Entry *Tau,     // size nh
 
     // input/output
-    Entry *X,       // size m-by-n with leading dimension m
+    Entry *X,       // size m-by-n with leading dimension ldx
+    Int ldx,
 
     // workspace
     Int vmax,
@@ -255,7 +257,7 @@ template <typename Entry, typename Int> void spqr_happly
             // -----------------------------------------------------------------
 
             spqr_private_do_panel (method, m, n, v, Wi, h1, h2, Hp, Hi, Hx, Tau,
-                Wmap, X, V, C, W, cc) ;
+                ldx, Wmap, X, V, C, W, cc) ;
         }
 
     }
@@ -379,7 +381,7 @@ template <typename Entry, typename Int> void spqr_happly
             // -----------------------------------------------------------------
 
             spqr_private_do_panel (method, m, n, v, Wi, h1, h2, Hp, Hi, Hx, Tau,
-                Wmap, X, V, C, W, cc) ;
+                ldx, Wmap, X, V, C, W, cc) ;
         }
     }
 }
@@ -401,10 +403,11 @@ template void spqr_private_do_panel <double, int32_t>
     double *Hx,
 
     double *Tau,         // Householder coefficients (size nh)
+    int32_t ldx,           // leading dimension of X
 
     // input/output
     int32_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
-    double *X,           // m-by-n with leading dimension m
+    double *X,           // m-by-n with leading dimension ldx
 
     // workspace, undefined on input and output
     double *V,           // dense panel
@@ -430,10 +433,11 @@ template void spqr_private_do_panel <double, int64_t>
     double *Hx,
 
     double *Tau,         // Householder coefficients (size nh)
+    int64_t ldx,           // leading dimension of X
 
     // input/output
     int64_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
-    double *X,           // m-by-n with leading dimension m
+    double *X,           // m-by-n with leading dimension ldx
 
     // workspace, undefined on input and output
     double *V,           // dense panel
@@ -459,10 +463,11 @@ template void spqr_private_do_panel <Complex, int32_t>
     Complex *Hx,
 
     Complex *Tau,         // Householder coefficients (size nh)
+    int32_t ldx,           // leading dimension of X
 
     // input/output
     int32_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
-    Complex *X,           // m-by-n with leading dimension m
+    Complex *X,           // m-by-n with leading dimension ldx
 
     // workspace, undefined on input and output
     Complex *V,           // dense panel
@@ -470,6 +475,64 @@ template void spqr_private_do_panel <Complex, int32_t>
     Complex *W,           // workspace
     cholmod_common *cc
 ) ;
+template void spqr_private_do_panel <float, int32_t>
+(
+    // inputs, not modified
+    int method,         // which method to use (0,1,2,3)
+    int32_t m,
+    int32_t n,
+    int32_t v,             // number of Householder vectors in the panel
+    int32_t *Wi,           // Wi [0:v-1] defines the pattern of the panel
+    int32_t h1,            // load H (h1) to H (h2-1) into V
+    int32_t h2,
+
+    // FUTURE : make H cholmod_sparse:
+    int32_t *Hp,           // Householder vectors: mh-by-nh sparse matrix
+    int32_t *Hi,
+    float *Hx,
+
+    float *Tau,         // Householder coefficients (size nh)
+    int32_t ldx,           // leading dimension of X
+
+    // input/output
+    int32_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
+    float *X,           // m-by-n with leading dimension ldx
+
+    // workspace, undefined on input and output
+    float *V,           // dense panel
+    float *C,           // workspace
+    float *W,           // workspace
+    cholmod_common *cc
+) ;
+template void spqr_private_do_panel <FComplex, int32_t>
+(
+    // inputs, not modified
+    int method,         // which method to use (0,1,2,3)
+    int32_t m,
+    int32_t n,
+    int32_t v,             // number of Householder vectors in the panel
+    int32_t *Wi,           // Wi [0:v-1] defines the pattern of the panel
+    int32_t h1,            // load H (h1) to H (h2-1) into V
+    int32_t h2,
+
+    // FUTURE : make H cholmod_sparse:
+    int32_t *Hp,           // Householder vectors: mh-by-nh sparse matrix
+    int32_t *Hi,
+    FComplex *Hx,
+
+    FComplex *Tau,         // Householder coefficients (size nh)
+    int32_t ldx,           // leading dimension of X
+
+    // input/output
+    int32_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
+    FComplex *X,           // m-by-n with leading dimension ldx
+
+    // workspace, undefined on input and output
+    FComplex *V,           // dense panel
+    FComplex *C,           // workspace
+    FComplex *W,           // workspace
+    cholmod_common *cc
+) ;
 
 template void spqr_private_do_panel <Complex, int64_t>
 (
@@ -488,10 +551,11 @@ template void spqr_private_do_panel <Complex, int64_t>
     Complex *Hx,
 
     Complex *Tau,         // Householder coefficients (size nh)
+    int64_t ldx,           // leading dimension of X
 
     // input/output
     int64_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
-    Complex *X,           // m-by-n with leading dimension m
+    Complex *X,           // m-by-n with leading dimension ldx
 
     // workspace, undefined on input and output
     Complex *V,           // dense panel
@@ -499,12 +563,70 @@ template void spqr_private_do_panel <Complex, int64_t>
     Complex *W,           // workspace
     cholmod_common *cc
 ) ;
+template void spqr_private_do_panel <float, int64_t>
+(
+    // inputs, not modified
+    int method,         // which method to use (0,1,2,3)
+    int64_t m,
+    int64_t n,
+    int64_t v,             // number of Householder vectors in the panel
+    int64_t *Wi,           // Wi [0:v-1] defines the pattern of the panel
+    int64_t h1,            // load H (h1) to H (h2-1) into V
+    int64_t h2,
+
+    // FUTURE : make H cholmod_sparse:
+    int64_t *Hp,           // Householder vectors: mh-by-nh sparse matrix
+    int64_t *Hi,
+    float *Hx,
+
+    float *Tau,         // Householder coefficients (size nh)
+    int64_t ldx,           // leading dimension of X
+
+    // input/output
+    int64_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
+    float *X,           // m-by-n with leading dimension ldx
+
+    // workspace, undefined on input and output
+    float *V,           // dense panel
+    float *C,           // workspace
+    float *W,           // workspace
+    cholmod_common *cc
+) ;
+template void spqr_private_do_panel <FComplex, int64_t>
+(
+    // inputs, not modified
+    int method,         // which method to use (0,1,2,3)
+    int64_t m,
+    int64_t n,
+    int64_t v,             // number of Householder vectors in the panel
+    int64_t *Wi,           // Wi [0:v-1] defines the pattern of the panel
+    int64_t h1,            // load H (h1) to H (h2-1) into V
+    int64_t h2,
+
+    // FUTURE : make H cholmod_sparse:
+    int64_t *Hp,           // Householder vectors: mh-by-nh sparse matrix
+    int64_t *Hi,
+    FComplex *Hx,
+
+    FComplex *Tau,         // Householder coefficients (size nh)
+    int64_t ldx,           // leading dimension of X
+
+    // input/output
+    int64_t *Wmap,         // inverse of Wi on input, set to all EMPTY on output
+    FComplex *X,           // m-by-n with leading dimension ldx
+
+    // workspace, undefined on input and output
+    FComplex *V,           // dense panel
+    FComplex *C,           // workspace
+    FComplex *W,           // workspace
+    cholmod_common *cc
+) ;
 template void spqr_happly <double, int32_t>
 (
     // input
     int method,     // 0,1,2,3
 
-    int32_t m,         // X is m-by-n with leading dimension m
+    int32_t m,         // X is m-by-n with leading dimension ldx
     int32_t n,
 
     // FUTURE : make H cholmod_sparse:
@@ -517,7 +639,8 @@ template void spqr_happly <double, int32_t>
     double *Tau,     // size nh
 
     // input/output
-    double *X,       // size m-by-n with leading dimension m
+    double *X,       // size m-by-n with leading dimension ldx
+    int32_t ldx,
 
     // workspace
     int32_t vmax,
@@ -533,7 +656,7 @@ template void spqr_happly <Complex, int32_t>
     // input
     int method,     // 0,1,2,3
 
-    int32_t m,         // X is m-by-n with leading dimension m
+    int32_t m,         // X is m-by-n with leading dimension ldx
     int32_t n,
 
     // FUTURE : make H cholmod_sparse:
@@ -546,7 +669,8 @@ template void spqr_happly <Complex, int32_t>
     Complex *Tau,     // size nh
 
     // input/output
-    Complex *X,       // size m-by-n with leading dimension m
+    Complex *X,       // size m-by-n with leading dimension ldx
+    int32_t ldx,
 
     // workspace
     int32_t vmax,
@@ -557,12 +681,72 @@ template void spqr_happly <Complex, int32_t>
     Complex *V,       // size vsize
     cholmod_common *cc
 ) ;
+template void spqr_happly <float, int32_t>
+(
+    // input
+    int method,     // 0,1,2,3
+
+    int32_t m,         // X is m-by-n with leading dimension ldx
+    int32_t n,
+
+    // FUTURE : make H cholmod_sparse:
+    int32_t nh,        // number of Householder vectors
+    int32_t *Hp,       // size nh+1, column pointers for H
+    int32_t *Hi,       // size hnz = Hp [nh], row indices of H
+    float *Hx,      // size hnz, Householder values.  Note that the first
+                    // entry in each column must be equal to 1.0
+
+    float *Tau,     // size nh
+
+    // input/output
+    float *X,       // size m-by-n with leading dimension ldx
+    int32_t ldx,
+
+    // workspace
+    int32_t vmax,
+    int32_t hchunk,
+    int32_t *Wi,       // size vmax
+    int32_t *Wmap,     // size MAX(mh,1) where H is mh-by-nh; all EMPTY
+    float *C,       // size csize
+    float *V,       // size vsize
+    cholmod_common *cc
+) ;
+template void spqr_happly <FComplex, int32_t>
+(
+    // input
+    int method,     // 0,1,2,3
+
+    int32_t m,         // X is m-by-n with leading dimension ldx
+    int32_t n,
+
+    // FUTURE : make H cholmod_sparse:
+    int32_t nh,        // number of Householder vectors
+    int32_t *Hp,       // size nh+1, column pointers for H
+    int32_t *Hi,       // size hnz = Hp [nh], row indices of H
+    FComplex *Hx,      // size hnz, Householder values.  Note that the first
+                    // entry in each column must be equal to 1.0
+
+    FComplex *Tau,     // size nh
+
+    // input/output
+    FComplex *X,       // size m-by-n with leading dimension ldx
+    int32_t ldx,
+
+    // workspace
+    int32_t vmax,
+    int32_t hchunk,
+    int32_t *Wi,       // size vmax
+    int32_t *Wmap,     // size MAX(mh,1) where H is mh-by-nh; all EMPTY
+    FComplex *C,       // size csize
+    FComplex *V,       // size vsize
+    cholmod_common *cc
+) ;
 template void spqr_happly <double, int64_t>
 (
     // input
     int method,     // 0,1,2,3
 
-    int64_t m,         // X is m-by-n with leading dimension m
+    int64_t m,         // X is m-by-n with leading dimension ldx
     int64_t n,
 
     // FUTURE : make H cholmod_sparse:
@@ -575,7 +759,8 @@ template void spqr_happly <double, int64_t>
     double *Tau,     // size nh
 
     // input/output
-    double *X,       // size m-by-n with leading dimension m
+    double *X,       // size m-by-n with leading dimension ldx
+    int64_t ldx,
 
     // workspace
     int64_t vmax,
@@ -591,7 +776,7 @@ template void spqr_happly <Complex, int64_t>
     // input
     int method,     // 0,1,2,3
 
-    int64_t m,         // X is m-by-n with leading dimension m
+    int64_t m,         // X is m-by-n with leading dimension ldx
     int64_t n,
 
     // FUTURE : make H cholmod_sparse:
@@ -604,7 +789,8 @@ template void spqr_happly <Complex, int64_t>
     Complex *Tau,     // size nh
 
     // input/output
-    Complex *X,       // size m-by-n with leading dimension m
+    Complex *X,       // size m-by-n with leading dimension ldx
+    int64_t ldx,
 
     // workspace
     int64_t vmax,
@@ -615,3 +801,63 @@ template void spqr_happly <Complex, int64_t>
     Complex *V,       // size vsize
     cholmod_common *cc
 ) ;
+template void spqr_happly <float, int64_t>
+(
+    // input
+    int method,     // 0,1,2,3
+
+    int64_t m,         // X is m-by-n with leading dimension ldx
+    int64_t n,
+
+    // FUTURE : make H cholmod_sparse:
+    int64_t nh,        // number of Householder vectors
+    int64_t *Hp,       // size nh+1, column pointers for H
+    int64_t *Hi,       // size hnz = Hp [nh], row indices of H
+    float *Hx,      // size hnz, Householder values.  Note that the first
+                    // entry in each column must be equal to 1.0
+
+    float *Tau,     // size nh
+
+    // input/output
+    float *X,       // size m-by-n with leading dimension ldx
+    int64_t ldx,
+
+    // workspace
+    int64_t vmax,
+    int64_t hchunk,
+    int64_t *Wi,       // size vmax
+    int64_t *Wmap,     // size MAX(mh,1) where H is mh-by-nh; all EMPTY
+    float *C,       // size csize
+    float *V,       // size vsize
+    cholmod_common *cc
+) ;
+template void spqr_happly <FComplex, int64_t>
+(
+    // input
+    int method,     // 0,1,2,3
+
+    int64_t m,         // X is m-by-n with leading dimension ldx
+    int64_t n,
+
+    // FUTURE : make H cholmod_sparse:
+    int64_t nh,        // number of Householder vectors
+    int64_t *Hp,       // size nh+1, column pointers for H
+    int64_t *Hi,       // size hnz = Hp [nh], row indices of H
+    FComplex *Hx,      // size hnz, Householder values.  Note that the first
+                    // entry in each column must be equal to 1.0
+
+    FComplex *Tau,     // size nh
+
+    // input/output
+    FComplex *X,       // size m-by-n with leading dimension ldx
+    int64_t ldx,
+
+    // workspace
+    int64_t vmax,
+    int64_t hchunk,
+    int64_t *Wi,       // size vmax
+    int64_t *Wmap,     // size MAX(mh,1) where H is mh-by-nh; all EMPTY
+    FComplex *C,       // size csize
+    FComplex *V,       // size vsize
+    cholmod_common *cc
+) ;
@@ -136,3 +136,71 @@ template int spqr_happly_work <int64_t>
     int64_t *p_vsize, 
     int64_t *p_csize
 ) ;
+
+// =============================================================================
+// === spqr_happly_blocks ======================================================
+// =============================================================================
+
+// Determines how X is split into blocks when applying H.  The columns of X
+// (for Q'*X and Q*X) or the rows of X (for X*Q' and X*Q) are independent of
+// each other, so X is split into blocks of xchunk columns or rows, and the
+// blocks are done in parallel, each with its own workspace.  A block is wide
+// enough to keep spqr_larftb in BLAS-3, and narrow enough to keep its panel
+// workspace C in cache.  Returns xchunk.
+
+#define XCHUNK_MIN 64
+#define XCHUNK_MAX 1024
+
+template <typename Int> Int spqr_happly_blocks
+(
+    // input
+    Int nx,         // # of columns (methods 0,1) or rows (methods 2,3) of X
+
+    // output
+    int *p_nthreads,    // # of threads to use
+
+    cholmod_common *cc
+)
+{
+    int nthreads = MAX (0, cc->SPQR_nthreads) ;
+#ifdef _OPENMP
+    if (nthreads <= 0)
+    {
+        nthreads = SUITESPARSE_OPENMP_MAX_THREADS ;
+    }
+#else
+    nthreads = 1 ;
+#endif
+    nthreads = MAX (nthreads, 1) ;
+
+    Int xchunk = (nx + nthreads - 1) / nthreads ;
+    xchunk = MAX (xchunk, XCHUNK_MIN) ;
+    xchunk = MIN (xchunk, XCHUNK_MAX) ;
+    xchunk = MIN (xchunk, nx) ;
+    xchunk = MAX (xchunk, 1) ;
+
+    Int nblocks = (nx + xchunk - 1) / xchunk ;
+    *p_nthreads = (int) MIN ((Int) nthreads, nblocks) ;
+    return (xchunk) ;
+}
+
+template int32_t spqr_happly_blocks <int32_t>
+(
+    // input
+    int32_t nx,
+
+    // output
+    int *p_nthreads,
+
+    cholmod_common *cc
+) ;
+template int64_t spqr_happly_blocks <int64_t>
+(
+    // input
+    int64_t nx,
+
+    // output
+    int *p_nthreads,
+
+    cholmod_common *cc
+) ;
@@ -78,6 +78,7 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
 
     Entry ** Rblock = QRnum->Rblock ;
     char *   Rdead = QRnum->Rdead ;
+    Int *   Pcol = QRnum->Pcol ;        // only used if columns are pivoted
     Int *   HStair = QRnum->HStair ;
     Entry *  HTau = QRnum->HTau ;
     Int *   Hii = QRnum->Hii ;          // only used if H is kept
@@ -86,6 +87,13 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
     Int     keepH = QRnum->keepH ;
     Int     ntasks = QRnum->ntasks ;    // number of tasks
 
+    // -------------------------------------------------------------------------
+    // get the front trace function, if any
+    // -------------------------------------------------------------------------
+
+    SuiteSparseQR_front_trace_func trace = Blob->trace ;
+    void *trace_data = Blob->trace_data ;
+
     // -------------------------------------------------------------------------
     // get the stack for this task and the head/top pointers
     // -------------------------------------------------------------------------
@@ -128,6 +136,11 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
     Int    sumfrank = Work [stack].sumfrank ;
     Int    maxfrank = Work [stack].maxfrank ;
 
+    // for the front trace
+    Entry * Stack_base = QRnum->Stacks [stack] ;
+    Int    Stack_end = QRnum->Stack_size [stack] ;
+    Int    stack_peak = Work [stack].stack_peak ;
+
     // for keeping track of norm(w) for dead column 2-norms
     double wscale = Work [stack].wscale ;
     double wssq   = Work [stack].wssq   ;
@@ -161,6 +174,7 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
         // determine the size of F, its staircase, and its Fmap
         // ---------------------------------------------------------------------
 
+        double tassemble = (trace == NULL) ? 0 : SUITESPARSE_TIME ;
         Int fm = spqr_fsize (f, Super, Rp, Rj, Sleft, Child, Childp, Cm,
             Fmap, Stair) ;
         Int fn = Rp [f+1] - Rp [f] ;        // F is fm-by-fn
@@ -216,6 +230,19 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
 #endif
 #endif
 
+        // ---------------------------------------------------------------------
+        // find the stack usage with F and the C blocks of its children
+        // ---------------------------------------------------------------------
+
+        Int stack_inuse = 0 ;
+        if (trace != NULL)
+        {
+            tassemble = SUITESPARSE_TIME - tassemble ;
+            stack_inuse = (Int) (Stack_head - Stack_base)
+                + (Int) ((Stack_base + Stack_end) - Stack_top) ;
+            stack_peak = MAX (stack_peak, stack_inuse) ;
+        }
+
         // ---------------------------------------------------------------------
         // free the C blocks of the children of F
         // ---------------------------------------------------------------------
@@ -240,9 +267,15 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
         // factorize the front F
         // ---------------------------------------------------------------------
 
+        double tlarftb = 0 ;
+        double tfront = (trace == NULL) ? 0 : SUITESPARSE_TIME ;
         Int frank = spqr_front (fm, fn, fp, tol, ntol - col1,
-            fchunk, F, Stair, Rdead + col1, Tau, W,
-            &wscale, &wssq, cc) ;
+            fchunk, F, Stair, Rdead + col1, Pcol ? Pcol + col1 : NULL,
+            Tau, W, &wscale, &wssq, (trace == NULL) ? NULL : &tlarftb, cc) ;
+        if (trace != NULL)
+        {
+            tfront = SUITESPARSE_TIME - tfront ;
+        }
 
 #ifndef NDEBUG
 #ifndef NPRINT
@@ -261,6 +294,29 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
         sumfrank += frank ;
         maxfrank = MAX (maxfrank, frank) ;
 
+        // ---------------------------------------------------------------------
+        // trace the front
+        // ---------------------------------------------------------------------
+
+        if (trace != NULL)
+        {
+            SuiteSparseQR_front_trace t ;
+            t.front = f ;
+            t.task = task ;
+            t.stack = stack ;
+            t.fm = fm ;
+            t.fn = fn ;
+            t.fp = fp ;
+            t.frank = frank ;
+            t.assemble_time = tassemble ;
+            t.front_time = tfront ;
+            t.larftb_time = tlarftb ;
+            t.stack_inuse = stack_inuse ;
+            t.stack_peak = stack_peak ;
+            t.entry_size = sizeof (Entry) ;
+            trace (&t, trace_data) ;
+        }
+
         // ---------------------------------------------------------------------
         // pack the C block of front F on stack
         // ---------------------------------------------------------------------
@@ -333,6 +389,7 @@ template <typename Entry, typename Int> void spqr_kernel // _worker
     Work [stack].Stack_top = Stack_top ;
     Work [stack].sumfrank = sumfrank ;  // sum rank of fronts for this stack
     Work [stack].maxfrank = maxfrank ;  // max rank of fronts for this stack
+    Work [stack].stack_peak = stack_peak ;
 
     // for keeping track of norm(w) for dead column 2-norms
     Work [stack].wscale = wscale ;
@@ -349,6 +406,16 @@ template void spqr_kernel <Complex, int32_t> // _worker
     int32_t task,
     spqr_blob <Complex, int32_t> *Blob
 ) ;
+template void spqr_kernel <float, int32_t> // _worker
+(
+    int32_t task,
+    spqr_blob <float, int32_t> *Blob
+) ;
+template void spqr_kernel <FComplex, int32_t> // _worker
+(
+    int32_t task,
+    spqr_blob <FComplex, int32_t> *Blob
+) ;
 template void spqr_kernel <double, int64_t> // _worker
 (
     int64_t task,
@@ -359,3 +426,13 @@ template void spqr_kernel <Complex, int64_t> // _worker
     int64_t task,
     spqr_blob <Complex, int64_t> *Blob
 ) ;
+template void spqr_kernel <float, int64_t> // _worker
+(
+    int64_t task,
+    spqr_blob <float, int64_t> *Blob
+) ;
+template void spqr_kernel <FComplex, int64_t> // _worker
+(
+    int64_t task,
+    spqr_blob <FComplex, int64_t> *Blob
+) ;
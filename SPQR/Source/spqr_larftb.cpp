@@ -55,6 +55,22 @@ template <typename Int> inline void spqr_private_larft (char direct, char storev
         cc->blas_ok) ;
 }
 
+template <typename Int> inline void spqr_private_larft (char direct, char storev, Int n, Int k,
+    float *V, Int ldv, float *Tau, float *T, Int ldt,
+    cholmod_common *cc)
+{
+    SUITESPARSE_LAPACK_slarft (&direct, &storev, n, k, V, ldv, Tau, T, ldt,
+        cc->blas_ok) ;
+}
+
+template <typename Int> inline void spqr_private_larft (char direct, char storev, Int n, Int k,
+    FComplex *V, Int ldv, FComplex *Tau, FComplex *T, Int ldt,
+    cholmod_common *cc)
+{
+    SUITESPARSE_LAPACK_clarft (&direct, &storev, n, k, V, ldv, Tau, T, ldt,
+        cc->blas_ok) ;
+}
+
 
 template <typename Int> inline void spqr_private_larfb (char side, char trans, char direct, char storev,
     Int m, Int n, Int k, double *V, Int ldv, double *T,
@@ -77,6 +93,27 @@ template <typename Int> inline void spqr_private_larfb (char side, char trans, c
 }
 
 
+template <typename Int> inline void spqr_private_larfb (char side, char trans, char direct, char storev,
+    Int m, Int n, Int k, float *V, Int ldv, float *T,
+    Int ldt, float *C, Int ldc, float *Work, Int ldwork,
+    cholmod_common *cc)
+{
+    SUITESPARSE_LAPACK_slarfb (&side, &trans, &direct, &storev, m, n, k,
+        V, ldv, T, ldt, C, ldc, Work, ldwork, cc->blas_ok) ;
+}
+
+
+template <typename Int> inline void spqr_private_larfb (char side, char trans, char direct, char storev,
+    Int m, Int n, Int k, FComplex *V, Int ldv, FComplex *T,
+    Int ldt, FComplex *C, Int ldc, FComplex *Work, Int ldwork,
+    cholmod_common *cc)
+{
+    char tr = (trans == 'T') ? 'C' : 'N' ;      // change T to C
+    SUITESPARSE_LAPACK_clarfb (&side, &tr, &direct, &storev, m, n, k,
+        V, ldv, T, ldt, C, ldc, Work, ldwork, cc->blas_ok) ;
+}
+
+
 // =============================================================================
 
 template <typename Entry, typename Int> void spqr_larftb
@@ -200,6 +237,50 @@ template void spqr_larftb <Complex, int32_t>
                     // for methods 2,3: size k*k + m*k
     cholmod_common *cc
 ) ;
+template void spqr_larftb <float, int32_t>
+(
+    // inputs, not modified (V is modified and then restored on output)
+    int method,     // 0,1,2,3
+    int32_t m,         // C is m-by-n
+    int32_t n,
+    int32_t k,         // V is v-by-k
+                    // for methods 0 and 1, v = m,
+                    // for methods 2 and 3, v = n
+    int32_t ldc,       // leading dimension of C
+    int32_t ldv,       // leading dimension of V
+    float *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    float *Tau,     // size k, the k Householder coefficients
+
+    // input/output
+    float *C,       // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    float *W,       // for methods 0,1: size k*k + n*k
+                    // for methods 2,3: size k*k + m*k
+    cholmod_common *cc
+) ;
+template void spqr_larftb <FComplex, int32_t>
+(
+    // inputs, not modified (V is modified and then restored on output)
+    int method,     // 0,1,2,3
+    int32_t m,         // C is m-by-n
+    int32_t n,
+    int32_t k,         // V is v-by-k
+                    // for methods 0 and 1, v = m,
+                    // for methods 2 and 3, v = n
+    int32_t ldc,       // leading dimension of C
+    int32_t ldv,       // leading dimension of V
+    FComplex *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    FComplex *Tau,     // size k, the k Householder coefficients
+
+    // input/output
+    FComplex *C,       // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    FComplex *W,       // for methods 0,1: size k*k + n*k
+                    // for methods 2,3: size k*k + m*k
+    cholmod_common *cc
+) ;
 template void spqr_larftb <double, int64_t>
 (
     // inputs, not modified (V is modified and then restored on output)
@@ -244,3 +325,47 @@ template void spqr_larftb <Complex, int64_t>
                     // for methods 2,3: size k*k + m*k
     cholmod_common *cc
 ) ;
+template void spqr_larftb <float, int64_t>
+(
+    // inputs, not modified (V is modified and then restored on output)
+    int method,     // 0,1,2,3
+    int64_t m,         // C is m-by-n
+    int64_t n,
+    int64_t k,         // V is v-by-k
+                    // for methods 0 and 1, v = m,
+                    // for methods 2 and 3, v = n
+    int64_t ldc,       // leading dimension of C
+    int64_t ldv,       // leading dimension of V
+    float *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    float *Tau,     // size k, the k Householder coefficients
+
+    // input/output
+    float *C,       // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    float *W,       // for methods 0,1: size k*k + n*k
+                    // for methods 2,3: size k*k + m*k
+    cholmod_common *cc
+) ;
+template void spqr_larftb <FComplex, int64_t>
+(
+    // inputs, not modified (V is modified and then restored on output)
+    int method,     // 0,1,2,3
+    int64_t m,         // C is m-by-n
+    int64_t n,
+    int64_t k,         // V is v-by-k
+                    // for methods 0 and 1, v = m,
+                    // for methods 2 and 3, v = n
+    int64_t ldc,       // leading dimension of C
+    int64_t ldv,       // leading dimension of V
+    FComplex *V,       // V is v-by-k, unit lower triangular (diag not stored)
+    FComplex *Tau,     // size k, the k Householder coefficients
+
+    // input/output
+    FComplex *C,       // C is m-by-n, with leading dimension ldc
+
+    // workspace, not defined on input or output
+    FComplex *W,       // for methods 0,1: size k*k + n*k
+                    // for methods 2,3: size k*k + m*k
+    cholmod_common *cc
+) ;
@@ -25,6 +25,20 @@ template <typename Int> inline double spqr_private_nrm2 (Int n, Complex *X, chol
     return (norm) ;
 }
 
+template <typename Int> inline double spqr_private_nrm2 (Int n, float *X, cholmod_common *cc)
+{
+    float norm ;
+    SUITESPARSE_BLAS_snrm2 (norm, n, X, 1, cc->blas_ok) ;
+    return ((double) norm) ;
+}
+
+template <typename Int> inline double spqr_private_nrm2 (Int n, FComplex *X, cholmod_common *cc)
+{
+    float norm ;
+    SUITESPARSE_BLAS_scnrm2 (norm, n, X, 1, cc->blas_ok) ;
+    return ((double) norm) ;
+}
+
 
 // =============================================================================
 // === spqr_maxcolnorm =========================================================
@@ -85,6 +99,22 @@ template double spqr_maxcolnorm <Complex, int32_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template double spqr_maxcolnorm <float, int32_t>
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template double spqr_maxcolnorm <FComplex, int32_t>
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
 template double spqr_maxcolnorm <double, int64_t>
 (
     // inputs, not modified
@@ -101,3 +131,19 @@ template double spqr_maxcolnorm <Complex, int64_t>
     // workspace and parameters
     cholmod_common *cc
 ) ;
+template double spqr_maxcolnorm <float, int64_t>
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
+template double spqr_maxcolnorm <FComplex, int64_t>
+(
+    // inputs, not modified
+    cholmod_sparse *A,
+
+    // workspace and parameters
+    cholmod_common *cc
+) ;
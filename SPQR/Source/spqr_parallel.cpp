@@ -7,79 +7,61 @@
 
 //------------------------------------------------------------------------------
 
-// Factorize all the tasks in parallel with TBB.
+// Factorize all the tasks in parallel with OpenMP tasks.
 // The GPU is not used.
 
-#if 0 /* ifdef HAVE_TBB (TBB removed) */
-#include "spqr.hpp"
-#include <tbb/task_scheduler_init.h>
-#include <tbb/task.h>
+// The task tree is constructed by spqr_analyze.  Each task is a set of fronts
+// that is factorized by spqr_kernel, and each task uses one of the stacks
+// (TaskStack [task]).  A task can start only when all of its children are
+// done.  Two tasks that use the same stack are always an ancestor and a
+// descendant of each other in the task tree, so they never run at the same
+// time, and each stack is used by one thread at a time.  The root task
+// (id = ntasks-1) is a placeholder with no fronts of its own.
 
-using namespace tbb ;
+#include "spqr.hpp"
 
 // =============================================================================
 // === spqr_zippy ==============================================================
 // =============================================================================
 
-template <typename Entry, typename Int> class spqr_zippy: public task
+// Factorize the task id and all of its descendants.
+
+template <typename Entry, typename Int> static void spqr_zippy
+(
+    Int id,
+    Int ntasks,
+    spqr_blob <Entry, Int> *Blob
+)
 {
-  public:
 
     // -------------------------------------------------------------------------
-    // spqr_zippy state
+    // spawn my children
     // -------------------------------------------------------------------------
 
-    const Int id ;
-    spqr_blob <Entry> *Blob ;
+    Int *TaskChildp = Blob->QRsym->TaskChildp ;
+    Int *TaskChild  = Blob->QRsym->TaskChild ;
+    Int pfirst = TaskChildp [id] ;
+    Int plast  = TaskChildp [id+1] ;
 
-    // -------------------------------------------------------------------------
-    // spqr_zippy constructor
-    // -------------------------------------------------------------------------
+    for (Int p = pfirst ; p < plast ; p++)
+    {
+        Int child = TaskChild [p] ;
+        #pragma omp task firstprivate (child)
+        spqr_zippy (child, ntasks, Blob) ;
+    }
 
-    spqr_zippy (Int id_, spqr_blob <Entry> *Blob_) : id (id_), Blob (Blob_) { }
+    // wait for all of my children to finish
+    #pragma omp taskwait
 
     // -------------------------------------------------------------------------
-    // spqr_zippy task
+    // children are done, do my own task
     // -------------------------------------------------------------------------
 
-    task* execute ( )
+    if (id < ntasks-1)
     {
-
-        // ---------------------------------------------------------------------
-        // spawn my children
-        // ---------------------------------------------------------------------
-
-        Int *TaskChildp = Blob->QRsym->TaskChildp ;
-        Int *TaskChild  = Blob->QRsym->TaskChild ;
-        Int pfirst = TaskChildp [id] ;
-        Int plast  = TaskChildp [id+1] ;
-        Int nchildren = plast - pfirst ;
-
-        if (nchildren > 0)
-        {
-            // create a list of TBB tasks, one for each child
-            task_list TasksToDo ;
-            for (Int i = 0 ; i < nchildren ; i++)
-            {
-                Int child = TaskChild [pfirst+i] ;
-                TasksToDo.push_back (*new (allocate_child ( ))
-                    spqr_zippy (child, Blob)) ;
-            }
-            // spawn all children and wait for all of them to finish
-            set_ref_count (nchildren + 1) ;
-            spawn_and_wait_for_all (TasksToDo) ;
-        }
-
-        // ---------------------------------------------------------------------
-        // chilren are done, do my own task
-        // ---------------------------------------------------------------------
-
         spqr_kernel (id, Blob) ;
-
-        return (NULL) ;
     }
-} ;
-
+}
 
 // =============================================================================
 // === spqr_parallel ===========================================================
@@ -88,17 +70,39 @@ template <typename Entry, typename Int> class spqr_zippy: public task
 template <typename Entry, typename Int> void spqr_parallel
 (
     Int ntasks,
-    int nthreads,
+    int nthreads,       // # of threads to use; <= 0 for the OpenMP default
     spqr_blob <Entry, Int> *Blob
 )
 {
-    // fire up TBB on the task tree, starting at the root id = ntasks-1
-    task_scheduler_init
-        init (nthreads <= 0 ? (task_scheduler_init::automatic) : nthreads) ;
-    spqr_zippy <Entry> & a = *new (task::allocate_root ( ))
-        spqr_zippy <Entry, Int> (ntasks-1, Blob) ;
-    task::spawn_root_and_wait (a) ;
+#ifdef _OPENMP
+    if (nthreads <= 0)
+    {
+        nthreads = SUITESPARSE_OPENMP_MAX_THREADS ;
+    }
+#else
+    nthreads = 1 ;
+#endif
+    nthreads = (int) MIN ((Int) nthreads, ntasks-1) ;
+
+    if (nthreads <= 1)
+    {
+        // one thread: do tasks 0 to ntasks-2 in order (skip the placeholder
+        // root task id = ntasks-1).  Each child task is numbered before its
+        // parent, so this is a valid postorder of the task tree.
+        for (Int id = 0 ; id < ntasks-1 ; id++)
+        {
+            spqr_kernel (id, Blob) ;
+        }
+    }
+    else
+    {
+        // start at the root id = ntasks-1 and work down the task tree
+        #pragma omp parallel num_threads(nthreads)
+        #pragma omp single nowait
+        spqr_zippy (ntasks-1, ntasks, Blob) ;
+    }
 }
+
 template void spqr_parallel <double, int32_t>
 (
     int32_t ntasks,
@@ -111,6 +115,18 @@ template void spqr_parallel <Complex, int32_t>
     int nthreads,
     spqr_blob <Complex, int32_t> *Blob
 ) ;
+template void spqr_parallel <float, int32_t>
+(
+    int32_t ntasks,
+    int nthreads,
+    spqr_blob <float, int32_t> *Blob
+) ;
+template void spqr_parallel <FComplex, int32_t>
+(
+    int32_t ntasks,
+    int nthreads,
+    spqr_blob <FComplex, int32_t> *Blob
+) ;
 template void spqr_parallel <double, int64_t>
 (
     int64_t ntasks,
@@ -123,4 +139,15 @@ template void spqr_parallel <Complex, int64_t>
     int nthreads,
     spqr_blob <Complex, int64_t> *Blob
 ) ;
-#endif
+template void spqr_parallel <float, int64_t>
+(
+    int64_t ntasks,
+    int nthreads,
+    spqr_blob <float, int64_t> *Blob
+) ;
+template void spqr_parallel <FComplex, int64_t>
+(
+    int64_t ntasks,
+    int nthreads,
+    spqr_blob <FComplex, int64_t> *Blob
+) ;
@@ -123,6 +123,16 @@ template int spqr_rmap <Complex, int32_t>
     SuiteSparseQR_factorization <Complex, int32_t> *QR,
     cholmod_common *cc
 ) ;
+template int spqr_rmap <float, int32_t>
+(
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    cholmod_common *cc
+) ;
+template int spqr_rmap <FComplex, int32_t>
+(
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    cholmod_common *cc
+) ;
 
 template int spqr_rmap <double, int64_t>
 (
@@ -134,3 +144,13 @@ template int spqr_rmap <Complex, int64_t>
     SuiteSparseQR_factorization <Complex, int64_t> *QR,
     cholmod_common *cc
 ) ;
+template int spqr_rmap <float, int64_t>
+(
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    cholmod_common *cc
+) ;
+template int spqr_rmap <FComplex, int64_t>
+(
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    cholmod_common *cc
+) ;
@@ -92,6 +92,7 @@ template <typename Entry, typename Int> void spqr_rsolve
     Entry **Rblock, *R, *W1, *B1, *X1 ;
     Int *Rp, *Rj, *Super, *HStair, *Hm, *Stair ;
     char *Rdead ;
+    Int *PcolInv ;
     Int nf, // m,
         rank, j, f, col1, col2, fp, pr, fn, rm, k, i, row1, row2, ii,
         keepH, fm, h, t, live, kk ;
@@ -119,6 +120,7 @@ template <typename Entry, typename Int> void spqr_rsolve
     Rj = QRsym->Rj ;
     Super = QRsym->Super ;
     Rdead = QRnum->Rdead ;
+    PcolInv = QRnum->PcolInv ;  // NULL if columns not pivoted
     rank = QR->rank ;   // R22 is R(n1rows:rank-1,n1cols:n-1) of
                         // the global R.
     HStair = QRnum->HStair ;
@@ -264,7 +266,7 @@ template <typename Entry, typename Int> void spqr_rsolve
 
         for ( ; k < fn ; k++)
         {
-            j = Rj [pr + k] ;
+            j = PcolInv ? PcolInv [Rj [pr + k]] : Rj [pr + k] ;
             ASSERT (j >= col2 && j < QRsym->n) ;
             ii = Q1fill ? Q1fill [j+n1cols] : j+n1cols ;
             ASSERT ((ii < n) == (j+n1cols < n)) ;
@@ -422,6 +424,46 @@ template void spqr_rsolve <Complex, int32_t>
 
     cholmod_common *cc
 ) ;
+template void spqr_rsolve <float, int32_t>
+(
+    // inputs
+    SuiteSparseQR_factorization <float, int32_t> *QR,
+    int use_Q1fill,         // if TRUE, do X=E*(R\B), otherwise do X=R\B
+
+    int32_t nrhs,              // number of columns of B
+    int32_t ldb,               // leading dimension of B
+    float *B,               // size m-by-nrhs with leading dimesion ldb
+
+    // output
+    float *X,               // size n-by-nrhs with leading dimension n
+
+    // workspace
+    float **Rcolp,          // size QRnum->maxfrank
+    int32_t *Rlive,            // size QRnum->maxfrank
+    float *W,               // size QRnum->maxfrank * nrhs
+
+    cholmod_common *cc
+) ;
+template void spqr_rsolve <FComplex, int32_t>
+(
+    // inputs
+    SuiteSparseQR_factorization <FComplex, int32_t> *QR,
+    int use_Q1fill,         // if TRUE, do X=E*(R\B), otherwise do X=R\B
+
+    int32_t nrhs,              // number of columns of B
+    int32_t ldb,               // leading dimension of B
+    FComplex *B,               // size m-by-nrhs with leading dimesion ldb
+
+    // output
+    FComplex *X,               // size n-by-nrhs with leading dimension n
+
+    // workspace
+    FComplex **Rcolp,          // size QRnum->maxfrank
+    int32_t *Rlive,            // size QRnum->maxfrank
+    FComplex *W,               // size QRnum->maxfrank * nrhs
+
+    cholmod_common *cc
+) ;
 
 template void spqr_rsolve <double, int64_t>
 (
@@ -463,3 +505,43 @@ template void spqr_rsolve <Complex, int64_t>
 
     cholmod_common *cc
 ) ;
+template void spqr_rsolve <float, int64_t>
+(
+    // inputs
+    SuiteSparseQR_factorization <float, int64_t> *QR,
+    int use_Q1fill,         // if TRUE, do X=E*(R\B), otherwise do X=R\B
+
+    int64_t nrhs,              // number of columns of B
+    int64_t ldb,               // leading dimension of B
+    float *B,               // size m-by-nrhs with leading dimesion ldb
+
+    // output
+    float *X,               // size n-by-nrhs with leading dimension n
+
+    // workspace
+    float **Rcolp,          // size QRnum->maxfrank
+    int64_t *Rlive,            // size QRnum->maxfrank
+    float *W,               // size QRnum->maxfrank * nrhs
+
+    cholmod_common *cc
+) ;
+template void spqr_rsolve <FComplex, int64_t>
+(
+    // inputs
+    SuiteSparseQR_factorization <FComplex, int64_t> *QR,
+    int use_Q1fill,         // if TRUE, do X=E*(R\B), otherwise do X=R\B
+
+    int64_t nrhs,              // number of columns of B
+    int64_t ldb,               // leading dimension of B
+    FComplex *B,               // size m-by-nrhs with leading dimesion ldb
+
+    // output
+    FComplex *X,               // size n-by-nrhs with leading dimension n
+
+    // workspace
+    FComplex **Rcolp,          // size QRnum->maxfrank
+    int64_t *Rlive,            // size QRnum->maxfrank
+    FComplex *W,               // size QRnum->maxfrank * nrhs
+
+    cholmod_common *cc
+) ;
@@ -102,6 +102,42 @@ template void spqr_stranspose2 <Complex, int32_t>
     // workspace, not defined on input or output
     int32_t *W             // size m
 ) ;
+template void spqr_stranspose2 <float, int32_t>
+(
+    // input, not modified
+    cholmod_sparse *A,  // m-by-n
+    int32_t *Qfill,        // size n, fill-reducing column permutation;
+                        // Qfill [k] = j
+                        // if the kth column of S is the jth column of A.
+                        // Identity permutation is used if Qfill is NULL.
+
+    int32_t *Sp,           // size m+1, row pointers of S
+    int32_t *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+
+    // output, contents not defined on input
+    float *Sx,          // size nz, numerical values of S
+
+    // workspace, not defined on input or output
+    int32_t *W             // size m
+) ;
+template void spqr_stranspose2 <FComplex, int32_t>
+(
+    // input, not modified
+    cholmod_sparse *A,  // m-by-n
+    int32_t *Qfill,        // size n, fill-reducing column permutation;
+                        // Qfill [k] = j
+                        // if the kth column of S is the jth column of A.
+                        // Identity permutation is used if Qfill is NULL.
+
+    int32_t *Sp,           // size m+1, row pointers of S
+    int32_t *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+
+    // output, contents not defined on input
+    FComplex *Sx,          // size nz, numerical values of S
+
+    // workspace, not defined on input or output
+    int32_t *W             // size m
+) ;
 
 template void spqr_stranspose2 <double, int64_t>
 (
@@ -139,3 +175,39 @@ template void spqr_stranspose2 <Complex, int64_t>
     // workspace, not defined on input or output
     int64_t *W             // size m
 ) ;
+template void spqr_stranspose2 <float, int64_t>
+(
+    // input, not modified
+    cholmod_sparse *A,  // m-by-n
+    int64_t *Qfill,        // size n, fill-reducing column permutation;
+                        // Qfill [k] = j
+                        // if the kth column of S is the jth column of A.
+                        // Identity permutation is used if Qfill is NULL.
+
+    int64_t *Sp,           // size m+1, row pointers of S
+    int64_t *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+
+    // output, contents not defined on input
+    float *Sx,          // size nz, numerical values of S
+
+    // workspace, not defined on input or output
+    int64_t *W             // size m
+) ;
+template void spqr_stranspose2 <FComplex, int64_t>
+(
+    // input, not modified
+    cholmod_sparse *A,  // m-by-n
+    int64_t *Qfill,        // size n, fill-reducing column permutation;
+                        // Qfill [k] = j
+                        // if the kth column of S is the jth column of A.
+                        // Identity permutation is used if Qfill is NULL.
+
+    int64_t *Sp,           // size m+1, row pointers of S
+    int64_t *PLinv,        // size m, inverse row permutation, PLinv [i] = k
+
+    // output, contents not defined on input
+    FComplex *Sx,          // size nz, numerical values of S
+
+    // workspace, not defined on input or output
+    int64_t *W             // size m
+) ;
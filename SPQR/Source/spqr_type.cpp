@@ -8,7 +8,10 @@
 //------------------------------------------------------------------------------
 
 // Return the CHOLMOD type, based on the SuiteSparseQR template Entry type.
-// Note that CHOLMOD_REAL is 1 an CHOLMOD_COMPLEX is 2.
+// Note that CHOLMOD_REAL is 1 an CHOLMOD_COMPLEX is 2.  The result is the
+// xtype plus the dtype (CHOLMOD_DOUBLE is 0 and CHOLMOD_SINGLE is 4), so it
+// can be passed directly to the CHOLMOD allocation functions, and compared
+// with A->xtype + A->dtype of an input matrix.
 
 #include "spqr.hpp"
 
@@ -21,3 +24,13 @@ template <> int spqr_type <Complex> (void)
 {
     return (CHOLMOD_COMPLEX) ;
 }
+
+template <> int spqr_type <float> (void)
+{
+    return (CHOLMOD_REAL + CHOLMOD_SINGLE) ;
+}
+
+template <> int spqr_type <FComplex> (void)
+{
+    return (CHOLMOD_COMPLEX + CHOLMOD_SINGLE) ;
+}
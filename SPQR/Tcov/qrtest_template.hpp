@@ -977,6 +977,55 @@ template <typename Entry, typename Int> cholmod_sparse *permute_columns
 }
 
 
+// =============================================================================
+// === get_rows ================================================================
+// =============================================================================
+
+// compute A(i1:i2-1,:)
+
+template <typename Entry, typename Int> cholmod_sparse *get_rows
+(
+    cholmod_sparse *A,
+    Int i1,
+    Int i2,
+    cholmod_common *cc
+)
+{
+    Int n = A->ncol ;
+    int xtype = spqr_type <Entry> ( ) ;
+    Int *Ap = (Int *) A->p ;
+    Int *Ai = (Int *) A->i ;
+    Entry *Ax = (Entry *) A->x ;
+    cholmod_sparse *C ;
+
+    // allocate empty matrix C with space for all of A
+    C = spqr_allocate_sparse <Int> (i2-i1, n, Ap [n], TRUE, TRUE, 0, xtype,
+        cc) ;
+    Int *Cp = (Int *) C->p ;
+    Int *Ci = (Int *) C->i ;
+    Entry *Cx = (Entry *) C->x ;
+
+    // copy the entries in rows i1 to i2-1 from A to C
+    Int cnz = 0 ;
+    for (Int j = 0 ; j < n ; j++)
+    {
+        Cp [j] = cnz ;
+        for (Int p = Ap [j] ; p < Ap [j+1] ; p++)
+        {
+            Int i = Ai [p] ;
+            if (i >= i1 && i < i2)
+            {
+                Ci [cnz] = i - i1 ;
+                Cx [cnz] = Ax [p] ;
+                cnz++ ;
+            }
+        }
+    }
+    Cp [n] = cnz ;
+    return (C) ;
+}
+
+
 // =============================================================================
 // === sparse_multiply =========================================================
 // =============================================================================
@@ -1645,6 +1694,817 @@ template <typename Entry, typename Int> cholmod_dense *transpose
     return (Ydense) ;
 }
 
+// =============================================================================
+// === check_parallel ==========================================================
+// =============================================================================
+
+// Factorize A with a task tree, once with one thread and once with four, and
+// return norm (R1-R2,1) / norm (R1,1).  The tasks are scheduled differently,
+// but each front is factorized in the same way, so R1 and R2 should be equal.
+// SPQR_small is set to zero so that even the small test matrices are split
+// into several tasks.
+
+template <typename Entry, typename Int> double check_parallel
+(
+    cholmod_sparse *A,
+    cholmod_common *cc
+)
+{
+    cholmod_sparse *R [2] = { NULL, NULL } ;
+    Int *E [2] = { NULL, NULL } ;
+    int nthreads [2] = { 1, 4 } ;
+    Int n = A->ncol ;
+    double save_grain = cc->SPQR_grain ;
+    double save_small = cc->SPQR_small ;
+    int save_nthreads = cc->SPQR_nthreads ;
+
+    cc->SPQR_grain = 16 ;
+    cc->SPQR_small = 0 ;
+    for (int t = 0 ; t < 2 ; t++)
+    {
+        cc->SPQR_nthreads = nthreads [t] ;
+        SuiteSparseQR <Entry, Int> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL,
+            A->nrow, 0, A, NULL, NULL, NULL, NULL, &R [t], &E [t], NULL, NULL,
+            NULL, cc) ;
+        printf ("parallel QR: %d threads, %d tasks\n", nthreads [t],
+            (int) cc->SPQR_istat [3]) ;
+    }
+    cc->SPQR_grain = save_grain ;
+    cc->SPQR_small = save_small ;
+    cc->SPQR_nthreads = save_nthreads ;
+
+    double err = 1 ;
+    if (R [0] != NULL && R [1] != NULL)
+    {
+        // the column orderings must match exactly
+        err = 0 ;
+        for (Int k = 0 ; k < n ; k++)
+        {
+            Int e0 = E [0] ? E [0][k] : k ;
+            Int e1 = E [1] ? E [1][k] : k ;
+            if (e0 != e1) err = 1 ;
+        }
+        if (err == 0)
+        {
+            cholmod_sparse *D = sparse_diff <Entry,Int> (R [0], R [1], cc) ;
+            double rnorm = spqr_norm_sparse <Int> (R [0], 1, cc) ;
+            if (rnorm == 0) rnorm = 1 ;
+            err = spqr_norm_sparse <Int> (D, 1, cc) / rnorm ;
+            spqr_free_sparse <Int> (&D, cc) ;
+        }
+    }
+
+    for (int t = 0 ; t < 2 ; t++)
+    {
+        spqr_free_sparse <Int> (&R [t], cc) ;
+        spqr_free <Int> (n, sizeof (Int), E [t], cc) ;
+    }
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === check_rc_stream =========================================================
+// =============================================================================
+
+// Returns the larger of the relative errors in R'*R = A(:,Q)'*A(:,Q) and
+// R'*C = A(:,Q)'*B, where R, C, and Q are held in a stream.
+
+template <typename Entry, typename Int> double check_rc_stream
+(
+    SuiteSparseQR_stream <Entry, Int> *S,
+    cholmod_sparse *A,
+    cholmod_dense *Bdense,
+    cholmod_common *cc
+)
+{
+    if (S->R == NULL)
+    {
+        return (A->nrow == 0 ? 0 : 1) ;
+    }
+
+    // check that R'*R = A(:,Q)'*A(:,Q)
+    double err = check_r_factor <Entry,Int> (S->R, A, S->Qfill, cc) ;
+
+    // check that R'*C = A(:,Q)'*B
+    Int n = A->ncol ;
+    Int m = A->nrow ;
+    Int nb = S->bncols ;
+    Int *Ap = (Int *) A->p ;
+    Int *Ai = (Int *) A->i ;
+    Entry *Ax = (Entry *) A->x ;
+    Int *Rp = (Int *) S->R->p ;
+    Int *Ri = (Int *) S->R->i ;
+    Entry *Rx = (Entry *) S->R->x ;
+    Entry *B = (Entry *) Bdense->x ;
+    Entry *C = (Entry *) S->C->x ;
+    Int ldc = S->C->d ;
+    double anorm = spqr_norm_sparse <Int> (A, 1, cc) ;
+    double bnorm = spqr_norm_dense <Int> (Bdense, 1, cc) ;
+    double ab = (anorm * bnorm == 0) ? 1 : (anorm * bnorm) ;
+    for (Int k = 0 ; k < n ; k++)
+    {
+        Int j = S->Qfill [k] ;
+        for (Int t = 0 ; t < nb ; t++)
+        {
+            Entry y = 0, z = 0 ;
+            for (Int p = Ap [j] ; p < Ap [j+1] ; p++)
+            {
+                y += spqr_conj (Ax [p]) * B [Ai [p] + t*m] ;
+            }
+            for (Int p = Rp [k] ; p < Rp [k+1] ; p++)
+            {
+                z += spqr_conj (Rx [p]) * C [Ri [p] + t*ldc] ;
+            }
+            err = MAX (err, spqr_abs (y - z) / ab) ;
+        }
+    }
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === check_stream ============================================================
+// =============================================================================
+
+// Factorize A and B = rand (m,2) with a stream, given A and B in three blocks
+// of rows, and check R and C.  Then get the QR object from the stream and
+// solve with it.
+
+template <typename Entry, typename Int> double check_stream
+(
+    cholmod_sparse *A,
+    cholmod_common *cc
+)
+{
+    Int m = A->nrow ;
+    Int n = A->ncol ;
+    Int nb = 2 ;
+    int xtype = spqr_type <Entry> ( ) ;
+    Entry range = (Entry) 1.0 ;
+
+    cholmod_dense *Bdense = spqr_zeros <Int> (m, nb, xtype, cc) ;
+    Entry *B = (Entry *) Bdense->x ;
+    for (Int k = 0 ; k < m*nb ; k++)
+    {
+        B [k] = erand (range) ;
+    }
+
+    SuiteSparseQR_stream <Entry, Int> *S ;
+    S = SuiteSparseQR_stream_start <Entry, Int> (SPQR_ORDERING_DEFAULT, n, nb,
+        cc) ;
+    if (S == NULL)
+    {
+        spqr_free_dense <Int> (&Bdense, cc) ;
+        return (1) ;
+    }
+
+    // append A and B in three blocks of rows
+    double err = 0 ;
+    Int i1 = 0 ;
+    for (Int block = 1 ; block <= 3 ; block++)
+    {
+        Int i2 = (block * m) / 3 ;
+        cholmod_sparse *Ak = get_rows <Entry,Int> (A, i1, i2, cc) ;
+        cholmod_dense *Bk = spqr_zeros <Int> (i2-i1, nb, xtype, cc) ;
+        Entry *Bkx = (Entry *) Bk->x ;
+        for (Int t = 0 ; t < nb ; t++)
+        {
+            for (Int i = i1 ; i < i2 ; i++)
+            {
+                Bkx [(i-i1) + t*(i2-i1)] = B [i + t*m] ;
+            }
+        }
+        if (!SuiteSparseQR_stream_append <Entry, Int> (Ak, Bk, S, cc))
+        {
+            err = 1 ;
+        }
+        spqr_free_sparse <Int> (&Ak, cc) ;
+        spqr_free_dense <Int> (&Bk, cc) ;
+        i1 = i2 ;
+    }
+    if (S->nrows != m) err = 1 ;
+    double e1 = check_rc_stream <Entry,Int> (S, A, Bdense, cc) ;
+    err = MAX (err, e1) ;
+    printf ("stream: R'R-(A*Q)'(A*Q), R'C-(A*Q)'B: %g\n", err) ;
+
+    // get the QR object and solve with it
+    if (m > 0)
+    {
+        cholmod_dense *C = NULL, *X = NULL ;
+        SuiteSparseQR_factorization <Entry, Int> *QR ;
+        QR = SuiteSparseQR_stream_finish <Entry, Int> (SPQR_DEFAULT_TOL, S, &C,
+            cc) ;
+        if (QR == NULL || C == NULL)
+        {
+            err = 1 ;
+        }
+        else
+        {
+            X = SuiteSparseQR_solve <Entry, Int> (SPQR_RETX_EQUALS_B, QR, C,
+                cc) ;
+            if (X == NULL || (Int) X->nrow != n) err = 1 ;
+        }
+        spqr_free_dense <Int> (&X, cc) ;
+        spqr_free_dense <Int> (&C, cc) ;
+        SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+    }
+
+    SuiteSparseQR_stream_free <Entry, Int> (&S, cc) ;
+    spqr_free_dense <Int> (&Bdense, cc) ;
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === well_conditioned ========================================================
+// =============================================================================
+
+// Returns a well-conditioned m-by-n sparse matrix, with m >= n.  Row i has an
+// entry of 4 in column i % n, plus two random entries between -1 and 1.
+
+template <typename Entry, typename Int> cholmod_sparse *well_conditioned
+(
+    Int m,
+    Int n,
+    cholmod_common *cc
+)
+{
+    int xtype = spqr_type <Entry> ( ) ;
+    Entry range = (Entry) 1.0 ;
+    cholmod_dense *Xdense = spqr_zeros <Int> (m, n, xtype, cc) ;
+    Entry *X = (Entry *) Xdense->x ;
+    for (Int i = 0 ; i < m ; i++)
+    {
+        X [i + (i % n) * m] = 4 ;
+        X [i + nrand (n) * m] += erand (range) ;
+        X [i + nrand (n) * m] += erand (range) ;
+    }
+    cholmod_sparse *A = spqr_dense_to_sparse <Int> (Xdense, TRUE, cc) ;
+    spqr_free_dense <Int> (&Xdense, cc) ;
+    return (A) ;
+}
+
+
+// =============================================================================
+// === dense_diff ==============================================================
+// =============================================================================
+
+// Returns norm (X-Y,1) / norm (Y,1), or 1 if X or Y is NULL
+
+template <typename Entry, typename Int> double dense_diff
+(
+    cholmod_dense *Xdense,
+    cholmod_dense *Ydense,
+    cholmod_common *cc
+)
+{
+    if (Xdense == NULL || Ydense == NULL || Xdense->nrow != Ydense->nrow ||
+        Xdense->ncol != Ydense->ncol)
+    {
+        return (1) ;
+    }
+    Int m = Xdense->nrow ;
+    Int n = Xdense->ncol ;
+    Entry *X = (Entry *) Xdense->x ;
+    Entry *Y = (Entry *) Ydense->x ;
+    double err = 0, ynorm = 0 ;
+    for (Int j = 0 ; j < n ; j++)
+    {
+        double e = 0, y = 0 ;
+        for (Int i = 0 ; i < m ; i++)
+        {
+            e += spqr_abs (X [i + j*Xdense->d] - Y [i + j*Ydense->d]) ;
+            y += spqr_abs (Y [i + j*Ydense->d]) ;
+        }
+        err = MAX (err, e) ;
+        ynorm = MAX (ynorm, y) ;
+    }
+    if (ynorm == 0) ynorm = 1 ;
+    return (CHECK_NAN (err / ynorm)) ;
+}
+
+
+// =============================================================================
+// === check_updown ============================================================
+// =============================================================================
+
+// Add rows to, and delete rows from, a stream, and compare the results with
+// fresh factorizations.  A = [A1 ; W] is a well-conditioned 40-by-12 matrix,
+// where W holds the last 10 rows.
+
+template <typename Entry, typename Int> double check_updown
+(
+    cholmod_common *cc
+)
+{
+    Int m = 40, m1 = 30, n = 12, nb = 1 ;
+    int xtype = spqr_type <Entry> ( ) ;
+    Entry range = (Entry) 1.0 ;
+    SuiteSparseQR_factorization <Entry, Int> *QR ;
+    cholmod_dense *C, *Y ;
+    double err = 0, e1 ;
+
+    cholmod_sparse *A = well_conditioned <Entry,Int> (m, n, cc) ;
+    cholmod_sparse *A1 = get_rows <Entry,Int> (A, 0, m1, cc) ;
+    cholmod_sparse *W = get_rows <Entry,Int> (A, m1, m, cc) ;
+    cholmod_dense *Bdense = spqr_zeros <Int> (m, nb, xtype, cc) ;
+    cholmod_dense *B1 = spqr_zeros <Int> (m1, nb, xtype, cc) ;
+    cholmod_dense *BW = spqr_zeros <Int> (m-m1, nb, xtype, cc) ;
+    Entry *B = (Entry *) Bdense->x ;
+    for (Int i = 0 ; i < m ; i++)
+    {
+        B [i] = erand (range) ;
+        if (i < m1)
+        {
+            ((Entry *) B1->x) [i] = B [i] ;
+        }
+        else
+        {
+            ((Entry *) BW->x) [i-m1] = B [i] ;
+        }
+    }
+
+    // -------------------------------------------------------------------------
+    // add W and then delete it from a stream of A1 and B1
+    // -------------------------------------------------------------------------
+
+    SuiteSparseQR_stream <Entry, Int> *S ;
+    S = SuiteSparseQR_stream_start <Entry, Int> (SPQR_ORDERING_DEFAULT, n, nb,
+        cc) ;
+    if (!SuiteSparseQR_stream_append <Entry, Int> (A1, B1, S, cc)) err = 1 ;
+    if (!SuiteSparseQR_stream_updown <Entry, Int> (TRUE, W, BW, S, cc)) err = 1;
+
+    // the row form of R and C is converted back to column form by finish
+    QR = SuiteSparseQR_stream_finish <Entry, Int> (SPQR_DEFAULT_TOL, S, &C,
+        cc) ;
+    if (QR == NULL || C == NULL || !QR->qless) err = 1 ;
+
+    // Q of a QR object from a stream is not available
+    Y = SuiteSparseQR_qmult <Entry, Int> (SPQR_QTX, QR, C, cc) ;
+    if (Y != NULL || cc->status != CHOLMOD_INVALID) err = 1 ;
+    cholmod_sparse *Csparse = spqr_dense_to_sparse <Int> (C, TRUE, cc) ;
+    if (SuiteSparseQR_qmult <Entry, Int> (SPQR_QX, QR, Csparse, cc) != NULL
+        || cc->status != CHOLMOD_INVALID)
+    {
+        err = 1 ;
+    }
+    printf ("updown: qmult of stream QR, status %d\n", cc->status) ;
+    spqr_free_sparse <Int> (&Csparse, cc) ;
+    spqr_free_dense <Int> (&C, cc) ;
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+
+    e1 = check_rc_stream <Entry,Int> (S, A, Bdense, cc) ;
+    printf ("updown: add rows to stream: %g\n", e1) ;
+    err = MAX (err, e1) ;
+
+    if (!SuiteSparseQR_stream_updown <Entry, Int> (FALSE, W, BW, S, cc)) err=1;
+    QR = SuiteSparseQR_stream_finish <Entry, Int> (SPQR_DEFAULT_TOL, S, NULL,
+        cc) ;
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+    e1 = check_rc_stream <Entry,Int> (S, A1, B1, cc) ;
+    printf ("updown: delete rows from stream: %g\n", e1) ;
+    err = MAX (err, e1) ;
+    if (S->nrows != m1) err = 1 ;
+
+    // -------------------------------------------------------------------------
+    // a row that was never added cannot be deleted
+    // -------------------------------------------------------------------------
+
+    cholmod_sparse *W100 = spqr_copy <Int> (W, 0, 1, cc) ;
+    Entry *W100x = (Entry *) W100->x ;
+    for (Int p = 0 ; p < ((Int *) W100->p) [n] ; p++)
+    {
+        W100x [p] *= 100 ;
+    }
+    // the status is CHOLMOD_NOT_POSDEF, but ERROR reports it as
+    // CHOLMOD_INVALID when cc->itype is CHOLMOD_INT
+    if (SuiteSparseQR_stream_updown <Entry, Int> (FALSE, W100, BW, S, cc) ||
+        cc->status == CHOLMOD_OK)
+    {
+        err = 1 ;
+    }
+    printf ("updown: invalid delete, status %d\n", cc->status) ;
+    spqr_free_sparse <Int> (&W100, cc) ;
+
+    // the stream is not modified by the rows that cannot be deleted
+    QR = SuiteSparseQR_stream_finish <Entry, Int> (SPQR_DEFAULT_TOL, S, NULL,
+        cc) ;
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+    e1 = check_rc_stream <Entry,Int> (S, A1, B1, cc) ;
+    printf ("updown: stream after invalid delete: %g\n", e1) ;
+    err = MAX (err, e1) ;
+    SuiteSparseQR_stream_free <Entry, Int> (&S, cc) ;
+
+    spqr_free_sparse <Int> (&A, cc) ;
+    spqr_free_sparse <Int> (&A1, cc) ;
+    spqr_free_sparse <Int> (&W, cc) ;
+    spqr_free_dense <Int> (&Bdense, cc) ;
+    spqr_free_dense <Int> (&B1, cc) ;
+    spqr_free_dense <Int> (&BW, cc) ;
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === check_qmult_parallel ====================================================
+// =============================================================================
+
+// Apply Q to a dense X with 150 columns (methods 0,1) or rows (methods 2,3),
+// once with one thread and once with four, both with the QR object and with
+// H in sparse form.  X is split into blocks of at least 64 columns or rows,
+// so three threads are used.  Returns the largest relative difference.
+
+template <typename Entry, typename Int> double check_qmult_parallel
+(
+    cholmod_sparse *A,
+    cholmod_common *cc
+)
+{
+    Int m = A->nrow ;
+    Int n = A->ncol ;
+    Int nx = 150 ;
+    int xtype = spqr_type <Entry> ( ) ;
+    Entry range = (Entry) 1.0 ;
+    int save_nthreads = cc->SPQR_nthreads ;
+    double err = 0 ;
+
+    if (m == 0 || n == 0)
+    {
+        return (0) ;
+    }
+
+    // QR object, and Q in Householder form
+    SuiteSparseQR_factorization <Entry, Int> *QR ;
+    QR = SuiteSparseQR_factorize <Entry, Int> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, A, cc) ;
+    cholmod_sparse *R = NULL, *H = NULL ;
+    cholmod_dense *HTau = NULL ;
+    Int *E = NULL, *HPinv = NULL ;
+    SuiteSparseQR <Entry, Int> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL, m, 0,
+        A, NULL, NULL, NULL, NULL, &R, &E, &H, &HPinv, &HTau, cc) ;
+    if (QR == NULL || H == NULL)
+    {
+        err = 1 ;
+    }
+
+    for (int method = 0 ; err == 0 && method <= 3 ; method++)
+    {
+        Int xm = (method <= SPQR_QX) ? m : nx ;
+        Int xn = (method <= SPQR_QX) ? nx : m ;
+        cholmod_dense *Xdense = spqr_zeros <Int> (xm, xn, xtype, cc) ;
+        Entry *X = (Entry *) Xdense->x ;
+        for (Int k = 0 ; k < xm*xn ; k++)
+        {
+            X [k] = erand (range) ;
+        }
+        cholmod_dense *Y [2][2] ;
+        int nthreads [2] = { 1, 4 } ;
+        for (int t = 0 ; t < 2 ; t++)
+        {
+            cc->SPQR_nthreads = nthreads [t] ;
+            Y [t][0] = SuiteSparseQR_qmult <Entry, Int> (method, QR, Xdense,
+                cc) ;
+            Y [t][1] = SuiteSparseQR_qmult <Entry, Int> (method, H, HTau,
+                HPinv, Xdense, cc) ;
+        }
+        cc->SPQR_nthreads = save_nthreads ;
+        for (int k = 0 ; k < 2 ; k++)
+        {
+            double e1 = dense_diff <Entry,Int> (Y [1][k], Y [0][k], cc) ;
+            printf ("qmult method %d %s: 4 threads vs 1: %g\n", method,
+                (k == 0) ? "QR" : "H", e1) ;
+            err = MAX (err, e1) ;
+            spqr_free_dense <Int> (&Y [0][k], cc) ;
+            spqr_free_dense <Int> (&Y [1][k], cc) ;
+        }
+        spqr_free_dense <Int> (&Xdense, cc) ;
+    }
+
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+    spqr_free_sparse <Int> (&R, cc) ;
+    spqr_free_sparse <Int> (&H, cc) ;
+    spqr_free_dense <Int> (&HTau, cc) ;
+    spqr_free <Int> (n, sizeof (Int), E, cc) ;
+    spqr_free <Int> (m, sizeof (Int), HPinv, cc) ;
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === serialize_solve =========================================================
+// =============================================================================
+
+// Returns X = E*(R\(Q'*B)) for a QR object
+
+template <typename Entry, typename Int> cholmod_dense *serialize_solve
+(
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    cholmod_dense *Bdense,
+    cholmod_common *cc
+)
+{
+    if (QR == NULL)
+    {
+        return (NULL) ;
+    }
+    cholmod_dense *Cdense, *Xdense ;
+    Cdense = SuiteSparseQR_qmult <Entry, Int> (SPQR_QTX, QR, Bdense, cc) ;
+    Xdense = SuiteSparseQR_solve <Entry, Int> (SPQR_RETX_EQUALS_B, QR, Cdense,
+        cc) ;
+    spqr_free_dense <Int> (&Cdense, cc) ;
+    return (Xdense) ;
+}
+
+
+// =============================================================================
+// === check_serialize =========================================================
+// =============================================================================
+
+// Save the QR factorization of A in a blob, use it in place, and check that
+// it gives the same solution as the original QR object.  The blob is also
+// used from an address 8 bytes past the start of the buffer, which must
+// work, and 4 bytes past, which must be rejected.  A blob that is too small,
+// or has been corrupted, must also be rejected.
+
+template <typename Entry, typename Int> double check_serialize
+(
+    cholmod_sparse *A,
+    cholmod_common *cc
+)
+{
+    Int m = A->nrow ;
+    int xtype = spqr_type <Entry> ( ) ;
+    Entry range = (Entry) 1.0 ;
+    double err = 0, e1 ;
+
+    SuiteSparseQR_factorization <Entry, Int> *QR, *QR2 ;
+    QR = SuiteSparseQR_factorize <Entry, Int> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, A, cc) ;
+    size_t size = SuiteSparseQR_serialize_size <Entry, Int> (QR, cc) ;
+    if (QR == NULL || size == 0)
+    {
+        SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+        return (1) ;
+    }
+
+    // two buffers, with room to shift the blob by 8 bytes
+    uint8_t *blob = (uint8_t *) spqr_malloc <Int> (size + 8, 1, cc) ;
+    uint8_t *blob2 = (uint8_t *) spqr_malloc <Int> (size + 8, 1, cc) ;
+    cholmod_dense *Bdense = spqr_zeros <Int> (m, 2, xtype, cc) ;
+    Entry *B = (Entry *) Bdense->x ;
+    for (Int k = 0 ; k < 2*m ; k++)
+    {
+        B [k] = erand (range) ;
+    }
+    cholmod_dense *X = serialize_solve <Entry,Int> (QR, Bdense, cc) ;
+
+    // a blob that is too small cannot be written
+    if (SuiteSparseQR_serialize <Entry, Int> (QR, blob, size-1, cc)) err = 1 ;
+    if (!SuiteSparseQR_serialize <Entry, Int> (QR, blob, size, cc)) err = 1 ;
+
+    // use the blob in place
+    QR2 = SuiteSparseQR_deserialize <Entry, Int> (blob, size, cc) ;
+    cholmod_dense *X2 = serialize_solve <Entry,Int> (QR2, Bdense, cc) ;
+    e1 = dense_diff <Entry,Int> (X2, X, cc) ;
+    err = MAX (err, e1) ;
+    spqr_free_dense <Int> (&X2, cc) ;
+
+    // the QR object from the blob gives the same blob
+    memset (blob2, 0, size) ;
+    if (!SuiteSparseQR_serialize <Entry, Int> (QR2, blob2, size, cc) ||
+        memcmp (blob, blob2, size) != 0)
+    {
+        err = 1 ;
+    }
+    SuiteSparseQR_free <Entry, Int> (&QR2, cc) ;
+    printf ("serialize: blob size %g, x-x2 %g\n", (double) size, e1) ;
+
+    // the blob can start on any 8-byte boundary
+    memcpy (blob2 + 8, blob, size) ;
+    QR2 = SuiteSparseQR_deserialize <Entry, Int> (blob2 + 8, size, cc) ;
+    X2 = serialize_solve <Entry,Int> (QR2, Bdense, cc) ;
+    e1 = dense_diff <Entry,Int> (X2, X, cc) ;
+    err = MAX (err, e1) ;
+    spqr_free_dense <Int> (&X2, cc) ;
+    SuiteSparseQR_free <Entry, Int> (&QR2, cc) ;
+
+    // but not on a 4-byte boundary
+    memmove (blob2 + 4, blob2 + 8, size) ;
+    QR2 = SuiteSparseQR_deserialize <Entry, Int> (blob2 + 4, size, cc) ;
+    if (QR2 != NULL || cc->status != CHOLMOD_INVALID) err = 1 ;
+    SuiteSparseQR_free <Entry, Int> (&QR2, cc) ;
+
+    // a blob that is too small, or corrupted, is rejected
+    QR2 = SuiteSparseQR_deserialize <Entry, Int> (blob, size-1, cc) ;
+    if (QR2 != NULL || cc->status != CHOLMOD_INVALID) err = 1 ;
+    SuiteSparseQR_free <Entry, Int> (&QR2, cc) ;
+    blob [0]++ ;
+    QR2 = SuiteSparseQR_deserialize <Entry, Int> (blob, size, cc) ;
+    if (QR2 != NULL || cc->status != CHOLMOD_INVALID) err = 1 ;
+    SuiteSparseQR_free <Entry, Int> (&QR2, cc) ;
+
+    spqr_free_dense <Int> (&X, cc) ;
+    spqr_free_dense <Int> (&Bdense, cc) ;
+    spqr_free <Int> (size + 8, 1, blob, cc) ;
+    spqr_free <Int> (size + 8, 1, blob2, cc) ;
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === check_mixed =============================================================
+// =============================================================================
+
+// Solve A*x=b with a single-precision QR factorization, first without
+// refinement and then with it, and compare both with the solution from a
+// double-precision factorization.  A is a well-conditioned 60-by-20 matrix,
+// so the unrefined solution is accurate to about single precision, and the
+// refined solution to about double precision.
+
+template <typename Entry, typename Int> double check_mixed
+(
+    cholmod_common *cc
+)
+{
+    Int m = 60, n = 20 ;
+    int xtype = spqr_type <Entry> ( ) ;
+    Entry range = (Entry) 1.0 ;
+    int nrefine0 = -1, nrefine = -1 ;
+    double err = 0, e0, e1 ;
+
+    cholmod_sparse *A = well_conditioned <Entry,Int> (m, n, cc) ;
+    cholmod_dense *Bdense = spqr_zeros <Int> (m, 1, xtype, cc) ;
+    Entry *B = (Entry *) Bdense->x ;
+    for (Int i = 0 ; i < m ; i++)
+    {
+        B [i] = erand (range) ;
+    }
+
+    cholmod_dense *X, *X0, *X1 ;
+    X = SuiteSparseQR <Entry, Int> (SPQR_ORDERING_DEFAULT, SPQR_DEFAULT_TOL,
+        A, Bdense, cc) ;
+    X0 = SuiteSparseQR_mixed <Entry, Int> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, 0, A, Bdense, &nrefine0, cc) ;
+    X1 = SuiteSparseQR_mixed <Entry, Int> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, 10, A, Bdense, &nrefine, cc) ;
+    e0 = dense_diff <Entry,Int> (X0, X, cc) ;
+    e1 = dense_diff <Entry,Int> (X1, X, cc) ;
+    printf ("mixed: unrefined %g, refined %g in %d steps\n", e0, e1,
+        nrefine) ;
+
+    // the single-precision solution is accurate to about 1e-6, and the
+    // refined solution to about 1e-15
+    if (nrefine0 != 0 || e0 > 1e-4 || nrefine < 1 || nrefine > 10)
+    {
+        err = 1 ;
+    }
+    err = MAX (err, e1) ;
+
+    spqr_free_dense <Int> (&X, cc) ;
+    spqr_free_dense <Int> (&X0, cc) ;
+    spqr_free_dense <Int> (&X1, cc) ;
+    spqr_free_dense <Int> (&Bdense, cc) ;
+    spqr_free_sparse <Int> (&A, cc) ;
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === check_rank ==============================================================
+// =============================================================================
+
+// Find the rank and null space of a 50-by-16 matrix of rank 12.  The first 12
+// columns are those of a well-conditioned matrix, and each of the last 4 is
+// the sum of two of the first 12.
+
+template <typename Entry, typename Int> double check_rank
+(
+    cholmod_common *cc
+)
+{
+    Int m = 50, n = 16, r = 12 ;
+    int xtype = spqr_type <Entry> ( ) ;
+    Entry range = (Entry) 1.0 ;
+    double one [2] = {1,0}, zero [2] = {0,0} ;
+    double err = 0 ;
+
+    cholmod_dense *Xdense = spqr_zeros <Int> (m, n, xtype, cc) ;
+    Entry *X = (Entry *) Xdense->x ;
+    for (Int i = 0 ; i < m ; i++)
+    {
+        X [i + (i % r) * m] = 4 ;
+        X [i + nrand (r) * m] += erand (range) ;
+        X [i + nrand (r) * m] += erand (range) ;
+    }
+    for (Int j = r ; j < n ; j++)
+    {
+        for (Int i = 0 ; i < m ; i++)
+        {
+            X [i + j*m] = X [i + (j-r)*m] + X [i + ((j-r+1) % r)*m] ;
+        }
+    }
+    cholmod_sparse *A = spqr_dense_to_sparse <Int> (Xdense, TRUE, cc) ;
+    spqr_free_dense <Int> (&Xdense, cc) ;
+
+    SuiteSparseQR_factorization <Entry, Int> *QR ;
+    QR = SuiteSparseQR_rank_factorize <Entry, Int> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, A, cc) ;
+    cholmod_dense *N = SuiteSparseQR_nullspace <Entry, Int> (QR, A, cc) ;
+    if (QR == NULL || QR->rank != r || N == NULL || (Int) N->nrow != n
+        || (Int) N->ncol != n-r)
+    {
+        err = 1 ;
+    }
+    else
+    {
+        // err = norm (A*N,1) / (norm (A,1) * norm (N,1))
+        cholmod_dense *AN = spqr_zeros <Int> (m, n-r, xtype, cc) ;
+        spqr_sdmult <Int> (A, FALSE, one, zero, N, AN, cc) ;
+        err = spqr_norm_dense <Int> (AN, 1, cc) /
+            (spqr_norm_sparse <Int> (A, 1, cc) *
+             spqr_norm_dense <Int> (N, 1, cc)) ;
+        spqr_free_dense <Int> (&AN, cc) ;
+    }
+    printf ("rank: %g (expected %g), A*N %g\n",
+        (QR == NULL) ? -1. : (double) QR->rank, (double) r, err) ;
+
+    spqr_free_dense <Int> (&N, cc) ;
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+    spqr_free_sparse <Int> (&A, cc) ;
+    return (CHECK_NAN (err)) ;
+}
+
+
+// =============================================================================
+// === check_trace =============================================================
+// =============================================================================
+
+// A trace function that counts the fronts, and sums their ids.  Fronts in
+// different tasks are traced in parallel.
+
+static void trace_count
+(
+    const SuiteSparseQR_front_trace *trace,
+    void *user_data
+)
+{
+    int64_t *count = (int64_t *) user_data ;
+    #pragma omp atomic
+    count [0]++ ;
+    #pragma omp atomic
+    count [1] += trace->front ;
+}
+
+// Returns TRUE if each front of QR was traced exactly once
+template <typename Entry, typename Int> int traced_once
+(
+    SuiteSparseQR_factorization <Entry, Int> *QR,
+    int64_t *count
+)
+{
+    if (QR == NULL || QR->QRsym == NULL) return (FALSE) ;
+    int64_t nf = QR->QRsym->nf ;
+    return (count [0] == nf && count [1] == nf * (nf-1) / 2) ;
+}
+
+// Factorize A with a trace, with SuiteSparseQR_factorize and with
+// SuiteSparseQR_symbolic and SuiteSparseQR_numeric, and check that each front
+// is traced once.  Then refactorize A without a trace, which must not call the
+// trace function.
+
+template <typename Entry, typename Int> double check_trace
+(
+    cholmod_sparse *A,
+    cholmod_common *cc
+)
+{
+    int64_t count [2] = { 0, 0 } ;
+    double err = 0 ;
+
+    SuiteSparseQR_factorization <Entry, Int> *QR ;
+    QR = SuiteSparseQR_factorize <Entry, Int> (SPQR_ORDERING_DEFAULT,
+        SPQR_DEFAULT_TOL, A, trace_count, count, cc) ;
+    if (!traced_once <Entry, Int> (QR, count)) err = 1 ;
+    printf ("trace: factorize %g fronts\n", (double) count [0]) ;
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+
+    QR = SuiteSparseQR_symbolic <Entry, Int> (SPQR_ORDERING_DEFAULT, TRUE, A,
+        cc) ;
+    count [0] = count [1] = 0 ;
+    int ok = SuiteSparseQR_numeric <Entry, Int> (SPQR_DEFAULT_TOL, A, QR,
+        trace_count, count, cc) ;
+    if (!ok || !traced_once <Entry, Int> (QR, count)) err = 1 ;
+    printf ("trace: numeric %g fronts\n", (double) count [0]) ;
+    count [0] = count [1] = 0 ;
+    ok = SuiteSparseQR_numeric <Entry, Int> (SPQR_DEFAULT_TOL, A, QR, cc) ;
+    if (!ok || count [0] != 0) err = 1 ;
+    SuiteSparseQR_free <Entry, Int> (&QR, cc) ;
+    return (err) ;
+}
+
+
 // =============================================================================
 // === qrtest ==================================================================
 // =============================================================================
@@ -2481,6 +3341,70 @@ template <typename Entry, typename Int> void qrtest
     maxerr = MAX (maxerr, err) ;     // rank should be EMPTY
     printf (" ... error handling done\n\n") ;
 
+    // -------------------------------------------------------------------------
+    // test the parallel factorization of the task tree
+    // -------------------------------------------------------------------------
+
+    err = check_parallel <Entry,Int> (A, cc) ;
+    printf ("parallel task tree : R1-R2    Err17: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
+    // -------------------------------------------------------------------------
+    // test the streaming factorization
+    // -------------------------------------------------------------------------
+
+    err = check_stream <Entry,Int> (A, cc) ;
+    printf ("stream : R and C              Err18: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
+    // -------------------------------------------------------------------------
+    // test row updates and downdates
+    // -------------------------------------------------------------------------
+
+    err = check_updown <Entry,Int> (cc) ;
+    printf ("updown : stream R and C       Err19: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
+    // -------------------------------------------------------------------------
+    // test the parallel application of Q
+    // -------------------------------------------------------------------------
+
+    err = check_qmult_parallel <Entry,Int> (A, cc) ;
+    printf ("qmult : 4 threads vs 1        Err20: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
+    // -------------------------------------------------------------------------
+    // test the serialized QR factorization
+    // -------------------------------------------------------------------------
+
+    err = check_serialize <Entry,Int> (A, cc) ;
+    printf ("serialize : round trip        Err21: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
+    // -------------------------------------------------------------------------
+    // test the mixed-precision solver
+    // -------------------------------------------------------------------------
+
+    err = check_mixed <Entry,Int> (cc) ;
+    printf ("mixed : single vs double      Err22: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
+    // -------------------------------------------------------------------------
+    // test the rank-revealing factorization and the null space
+    // -------------------------------------------------------------------------
+
+    err = check_rank <Entry,Int> (cc) ;
+    printf ("rank : rank and A*N           Err23: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
+    // -------------------------------------------------------------------------
+    // test the per-front trace
+    // -------------------------------------------------------------------------
+
+    err = check_trace <Entry,Int> (A, cc) ;
+    printf ("trace : fronts traced once    Err24: %g\n", err) ;
+    maxerr = MAX (maxerr, err) ;
+
     // -------------------------------------------------------------------------
     // test non-user callable functions
     // -------------------------------------------------------------------------
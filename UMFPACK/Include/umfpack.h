@@ -74,23 +74,23 @@
  * below.
  */
 
-#define UMFPACK_DATE "Mar 22, 2024"
+#define UMFPACK_DATE "Oct 18, 2026"
 #define UMFPACK_MAIN_VERSION   6
-#define UMFPACK_SUB_VERSION    3
-#define UMFPACK_SUBSUB_VERSION 3
+#define UMFPACK_SUB_VERSION    4
+#define UMFPACK_SUBSUB_VERSION 0
 
 #define UMFPACK_VER_CODE(main,sub) SUITESPARSE_VER_CODE(main,sub)
-#define UMFPACK_VER UMFPACK_VER_CODE(6,3)
+#define UMFPACK_VER UMFPACK_VER_CODE(6,4)
 
-#define UMFPACK__VERSION SUITESPARSE__VERCODE(6,3,3)
+#define UMFPACK__VERSION SUITESPARSE__VERCODE(6,4,0)
 #if !defined (SUITESPARSE__VERSION) || \
     (SUITESPARSE__VERSION < SUITESPARSE__VERCODE(7,7,0))
-#error "UMFPACK 6.3.3 requires SuiteSparse_config 7.7.0 or later"
+#error "UMFPACK 6.4.0 requires SuiteSparse_config 7.7.0 or later"
 #endif
 
 #if !defined (AMD__VERSION) || \
     (AMD__VERSION < SUITESPARSE__VERCODE(3,3,2))
-#error "UMFPACK 6.3.3 requires AMD 3.3.2 or later"
+#error "UMFPACK 6.4.0 requires AMD 3.3.2 or later"
 #endif
 
 // user code should not directly use GB_STR or GB_XSTR
@@ -212,11 +212,66 @@
 #define UMFPACK_SOLVE_FLOPS 84      /* flop count for solve */
 #define UMFPACK_SOLVE_TIME 85       /* solve time (seconds) */
 #define UMFPACK_SOLVE_WALLTIME 86   /* solve time (wall clock, seconds) */
+#define UMFPACK_FALLBACK_TO_DOUBLE 87 /* 1 if umfpack_s*_solve used a */
+                                    /* double precision factorization */
 
-/* Info [87, 88, 89] unused */
+/* Info [88, 89] unused */
 
 /* Unused parts of Info may be used in future versions of UMFPACK. */
 
+/* -------------------------------------------------------------------------- */
+/* contents of Profile, computed by umfpack_*_numeric_profile */
+/* -------------------------------------------------------------------------- */
+
+#define UMFPACK_PROFILE 80          /* size of Profile array */
+
+/* wall clock time (seconds) of each phase of the numerical factorization: */
+#define UMFPACK_PROFILE_NUMERIC_TIME 0      /* all of umfpack_*_numeric */
+#define UMFPACK_PROFILE_INIT_TIME 1         /* load and scale A */
+#define UMFPACK_PROFILE_PIVOT_SEARCH_TIME 2 /* pivot row and column search */
+#define UMFPACK_PROFILE_FRONT_TIME 3        /* create, extend, and finish */
+                                            /* frontal matrices */
+#define UMFPACK_PROFILE_ASSEMBLE_TIME 4     /* assembly and pivot scaling */
+#define UMFPACK_PROFILE_BLAS3_TIME 5        /* dense updates of the front */
+#define UMFPACK_PROFILE_STORE_LU_TIME 6     /* store pivots in LU factors */
+#define UMFPACK_PROFILE_GC_TIME 7           /* garbage collection (not */
+                                            /* included in other phases) */
+#define UMFPACK_PROFILE_WRAPUP_TIME 8       /* finalize the LU factors */
+
+/* counters: */
+#define UMFPACK_PROFILE_NFRONTS 9           /* # of frontal matrices */
+#define UMFPACK_PROFILE_NEXTEND 10          /* # of front extensions */
+#define UMFPACK_PROFILE_NGROW 11            /* # of front (re)allocations */
+#define UMFPACK_PROFILE_NGARBAGE 12         /* # of garbage collections */
+#define UMFPACK_PROFILE_NUPDATES 13         /* # of dense updates */
+#define UMFPACK_PROFILE_UPDATE_FLOPS 14     /* flops in dense updates */
+#define UMFPACK_PROFILE_MAX_FRONT_SIZE 15   /* largest front (# entries) */
+#define UMFPACK_PROFILE_MAX_UPDATE_NROWS 16 /* largest m of dense updates */
+#define UMFPACK_PROFILE_MAX_UPDATE_NCOLS 17 /* largest n of dense updates */
+
+/* parameters used: */
+#define UMFPACK_PROFILE_BLOCK_SIZE 18       /* block size, from Symbolic */
+#define UMFPACK_PROFILE_FRONT_ALLOC_INIT 19 /* front allocation parameter */
+
+/* histograms of the dense updates C = C - L*U, with C m-by-n, L m-by-k: */
+#define UMFPACK_PROFILE_NHIST 16            /* # of buckets in each */
+#define UMFPACK_PROFILE_UPDATE_K_HIST 20    /* Profile [20+b]: # of updates */
+                                            /* with k in [2^b, 2^(b+1)) */
+#define UMFPACK_PROFILE_UPDATE_MN_HIST 36   /* Profile [36+b]: # of updates */
+                                            /* with m*n in [4^b, 4^(b+1)) */
+
+/* time of the factorization of each front (all phases): */
+#define UMFPACK_PROFILE_MAX_FRONT_TIME 52   /* longest time for one front */
+#define UMFPACK_PROFILE_FRONT_TIME_HIST 53  /* Profile [53+b]: # of fronts */
+                                            /* taking [2^b, 2^(b+1)) usec */
+                                            /* (bucket 0: < 2 usec) */
+
+/* Profile [69 ... 79] unused */
+
+/* formats for umfpack_export_profile */
+#define UMFPACK_PROFILE_JSON 0
+#define UMFPACK_PROFILE_CSV 1
+
 /* -------------------------------------------------------------------------- */
 /* contents of Control */
 /* -------------------------------------------------------------------------- */
@@ -299,6 +354,7 @@
 #define UMFPACK_DEFAULT_ALLOC_INIT 0.7
 #define UMFPACK_DEFAULT_FRONT_ALLOC_INIT 0.5
 #define UMFPACK_DEFAULT_IRSTEP 2
+#define UMFPACK_DEFAULT_IRSTEP_SINGLE 10    /* for umfpack_s*_solve */
 #define UMFPACK_DEFAULT_SCALE UMFPACK_SCALE_SUM
 #define UMFPACK_DEFAULT_STRATEGY UMFPACK_STRATEGY_AUTO
 #define UMFPACK_DEFAULT_AMD_DENSE AMD_DEFAULT_DENSE
@@ -1782,6 +1838,292 @@ Arguments:
         Future versions might modify different parts of Info.
 */
 
+//------------------------------------------------------------------------------
+// umfpack_solve_sparse
+//------------------------------------------------------------------------------
+
+int umfpack_di_solve_sparse
+(
+    int sys,
+    int32_t bnz,
+    const int32_t Bi [ ],
+    const double Bx [ ],
+    int32_t nout,
+    const int32_t Out [ ],
+    int32_t *xnz,
+    int32_t Xi [ ],
+    double Xx [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int32_t Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_dl_solve_sparse
+(
+    int sys,
+    int64_t bnz,
+    const int64_t Bi [ ],
+    const double Bx [ ],
+    int64_t nout,
+    const int64_t Out [ ],
+    int64_t *xnz,
+    int64_t Xi [ ],
+    double Xx [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int64_t Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_zi_solve_sparse
+(
+    int sys,
+    int32_t bnz,
+    const int32_t Bi [ ],
+    const double Bx [ ], const double Bz [ ],
+    int32_t nout,
+    const int32_t Out [ ],
+    int32_t *xnz,
+    int32_t Xi [ ],
+    double Xx [ ],       double Xz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int32_t Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_zl_solve_sparse
+(
+    int sys,
+    int64_t bnz,
+    const int64_t Bi [ ],
+    const double Bx [ ], const double Bz [ ],
+    int64_t nout,
+    const int64_t Out [ ],
+    int64_t *xnz,
+    int64_t Xi [ ],
+    double Xx [ ],       double Xz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int64_t Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_di_solve_sparse_setup
+(
+    void *Numeric
+) ;
+
+int umfpack_dl_solve_sparse_setup
+(
+    void *Numeric
+) ;
+
+int umfpack_zi_solve_sparse_setup
+(
+    void *Numeric
+) ;
+
+int umfpack_zl_solve_sparse_setup
+(
+    void *Numeric
+) ;
+
+/*
+double int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int32_t bnz, *Bi, nout, *Out, xnz, *Xi, *Wi ;
+    double *Bx, *Xx, *W, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    int status = umfpack_di_solve_sparse_setup (Numeric) ;
+    status = umfpack_di_solve_sparse (UMFPACK_A, bnz, Bi, Bx, nout, Out,
+        &xnz, Xi, Xx, Numeric, Control, Info, Wi, W) ;
+
+double int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int64_t bnz, *Bi, nout, *Out, xnz, *Xi, *Wi ;
+    double *Bx, *Xx, *W, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    int status = umfpack_dl_solve_sparse_setup (Numeric) ;
+    status = umfpack_dl_solve_sparse (UMFPACK_A, bnz, Bi, Bx, nout, Out,
+        &xnz, Xi, Xx, Numeric, Control, Info, Wi, W) ;
+
+complex int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int32_t bnz, *Bi, nout, *Out, xnz, *Xi, *Wi ;
+    double *Bx, *Bz, *Xx, *Xz, *W, Info [UMFPACK_INFO],
+        Control [UMFPACK_CONTROL] ;
+    int status = umfpack_zi_solve_sparse_setup (Numeric) ;
+    status = umfpack_zi_solve_sparse (UMFPACK_A, bnz, Bi, Bx, Bz, nout,
+        Out, &xnz, Xi, Xx, Xz, Numeric, Control, Info, Wi, W) ;
+
+complex int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int64_t bnz, *Bi, nout, *Out, xnz, *Xi, *Wi ;
+    double *Bx, *Bz, *Xx, *Xz, *W, Info [UMFPACK_INFO],
+        Control [UMFPACK_CONTROL] ;
+    int status = umfpack_zl_solve_sparse_setup (Numeric) ;
+    status = umfpack_zl_solve_sparse (UMFPACK_A, bnz, Bi, Bx, Bz, nout,
+        Out, &xnz, Xi, Xx, Xz, Numeric, Control, Info, Wi, W) ;
+
+packed complex Syntax:
+
+    Same as above, except Bz and Xz are NULL.
+
+Purpose:
+
+    Given LU factors computed by umfpack_*_numeric, solves Ax=b where the
+    right-hand side b is sparse, and returns the solution x as a sparse
+    vector.  The work is proportional to the number of floating-point
+    operations needed, not to n: only the columns of L and U reachable from
+    the nonzero pattern of b are accessed.  If only a few entries of x are
+    needed, they can be listed in Out, and the solve is then further limited
+    to the columns of L and U that those entries depend on.  Iterative
+    refinement is not performed.  Only square systems are handled.
+
+    The solve needs the LU factors in a compressed-column form.
+    umfpack_*_solve_sparse_setup copies them into that form (with
+    umfpack_*_get_numeric) and keeps them in the Numeric object, where they
+    are freed by umfpack_*_free_numeric; it takes time and memory comparable
+    to umfpack_*_get_numeric, and returns UMFPACK_OK, or
+    UMFPACK_ERROR_invalid_Numeric_object, UMFPACK_ERROR_invalid_system (A not
+    square), or UMFPACK_ERROR_out_of_memory.  The setup must be done once
+    before the first call to umfpack_*_solve_sparse; without it,
+    umfpack_*_solve_sparse returns UMFPACK_ERROR_invalid_Numeric_object.
+
+    umfpack_*_solve_sparse does not modify the Numeric object, and its
+    workspace is provided by the caller.  Once the setup has been done, it
+    may be called on the same Numeric object by several threads at once, each
+    with its own Wi and W.  umfpack_*_solve_sparse_setup itself must not be
+    called at the same time as any other use of the Numeric object.
+
+Returns:
+
+    The status code is returned.  See Info [UMFPACK_STATUS], below.
+
+Arguments:
+
+    int sys ;           Input argument.
+
+        Must be UMFPACK_A.  Other systems are not yet supported.
+
+    Int bnz ;           Input argument.
+
+        The number of entries in b.
+
+    Int Bi [bnz] ;      Input argument, not modified.
+    double Bx [bnz] ;   Input argument, not modified.
+                        Size 2*bnz for packed complex case.
+    double Bz [bnz] ;   Input argument, not modified, for complex versions.
+
+        The right-hand side b:  Bx [k] (and Bz [k]) is the value of b (Bi [k]).
+        The row indices must be in the range 0 to n-1, but need not be sorted.
+        Duplicates are summed.
+
+    Int nout ;          Input argument.
+    Int Out [nout] ;    Input argument, not modified.
+
+        If Out is NULL or nout < 0, then all entries of x are computed.
+        Otherwise, only the entries x (Out [0..nout-1]) are computed and
+        returned.  Duplicates in Out are ignored.
+
+    Int *xnz ;          Output argument.
+    Int Xi [n] ;        Output argument.
+    double Xx [n] ;     Output argument.
+                        Size 2*n for packed complex case.
+    double Xz [n] ;     Output argument, for complex versions.
+
+        The solution x, with x (Xi [k]) equal to Xx [k] (and Xz [k]) for k = 0
+        to *xnz-1.  Entries of x that are structurally zero are not returned,
+        but some of the returned entries may be numerically zero.  Xi is not
+        sorted.  If Out is present, *xnz <= nout, and Xi, Xx, and Xz need only
+        be of size nout.
+
+    void *Numeric ;     Input argument.
+
+        Numeric must point to a valid Numeric object, computed by
+        umfpack_*_numeric.  It is not modified.
+
+    double Control [UMFPACK_CONTROL] ;  Input argument, not modified.
+
+        Not used at present, and may be NULL.  It is reserved for future
+        use.  Control [UMFPACK_IRSTEP] is ignored, since iterative refinement
+        needs the matrix A and dense residuals, which would defeat the
+        purpose of a sparse solve.  Control [UMFPACK_PRL] is ignored, since
+        nothing is printed.
+
+    double Info [UMFPACK_INFO] ;        Output argument.
+
+        If a (double *) NULL pointer is passed, then no statistics are
+        returned in Info.  The following statistics are computed:
+
+        Info [UMFPACK_STATUS]: status code.  This is also the return value,
+            whether or not Info is present.
+
+            UMFPACK_OK
+
+                The linear system was successfully solved.
+
+            UMFPACK_WARNING_singular_matrix
+
+                The matrix is singular.  The solution may contain Inf's and/or
+                NaN's.
+
+            UMFPACK_ERROR_argument_missing
+
+                xnz, Xi, Xx, Wi, or W is missing, or Bi or Bx is missing and
+                bnz > 0, or Out is missing and nout > 0.
+
+            UMFPACK_ERROR_invalid_matrix
+
+                An index in Bi or Out is out of range.
+
+            UMFPACK_ERROR_invalid_system
+
+                sys is not UMFPACK_A, or the matrix A is not square.
+
+            UMFPACK_ERROR_invalid_Numeric_object
+
+                The Numeric object is not valid, or
+                umfpack_*_solve_sparse_setup has not been called for it.
+
+        Info [UMFPACK_NROW], Info [UMFPACK_NCOL]:  the dimensions of A.
+
+        Info [UMFPACK_IR_TAKEN], Info [UMFPACK_IR_ATTEMPTED]:  zero.
+
+        Info [UMFPACK_SOLVE_FLOPS]:  the number of floating point operations
+            performed.
+
+        Info [UMFPACK_SOLVE_TIME]:  The time taken, in seconds.
+
+        Info [UMFPACK_SOLVE_WALLTIME]:  The wallclock time taken, in seconds.
+
+        Only the above listed Info [...] entries are accessed.
+
+    Int Wi [10*n] ;     Workspace.
+    double W [c*n] ;    Workspace, where c is 1 for the real versions and 2
+                        for the complex versions.
+
+        The Wi and W arguments are workspace used by umfpack_*_solve_sparse.
+        Wi [0..4*n-1] must be zero on input (Wi may come from calloc, for
+        example), and umfpack_*_solve_sparse leaves it zero on output, in time
+        proportional to the work of the solve, so the same Wi can be passed to
+        any number of calls without clearing it.  The rest of Wi, and W, need
+        not be initialized, and their contents are undefined on output.
+        Concurrent calls must each use their own Wi and W.
+*/
+
 //------------------------------------------------------------------------------
 // umfpack_free_symbolic
 //------------------------------------------------------------------------------
@@ -2293,17 +2635,617 @@ void umfpack_zi_paru_free_sw
     void **SW
 ) ;
 
-void umfpack_zl_paru_free_sw
+void umfpack_zl_paru_free_sw
+(
+    void **SW
+) ;
+
+
+//------------------------------------------------------------------------------
+// umfpack_wsolve
+//------------------------------------------------------------------------------
+
+int umfpack_di_wsolve
+(
+    int sys,
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ],
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int32_t Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_dl_wsolve
+(
+    int sys,
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ],
+    double X [ ],
+    const double B [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int64_t Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_zi_wsolve
+(
+    int32_t sys,
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    double Xx [ ],       double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int32_t Wi [ ],
+    double W [ ]
+) ;
+
+int umfpack_zl_wsolve
+(
+    int sys,
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    double Xx [ ],       double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    void *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    int64_t Wi [ ],
+    double W [ ]
+) ;
+
+/*
+double int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int32_t *Ap, *Ai, *Wi ;
+    int sys ;
+    double *B, *X, *Ax, *W, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    int status = umfpack_di_wsolve (sys, Ap, Ai, Ax, X, B, Numeric,
+        Control, Info, Wi, W) ;
+
+double int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int64_t *Ap, *Ai, *Wi ;
+    int sys ;
+    double *B, *X, *Ax, *W, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    int status = umfpack_dl_wsolve (sys, Ap, Ai, Ax, X, B, Numeric,
+        Control, Info, Wi, W) ;
+
+complex int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int32_t *Ap, *Ai, *Wi ; 
+    int sys ;
+    double *Bx, *Bz, *Xx, *Xz, *Ax, *Az, *W,
+        Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    int status = umfpack_zi_wsolve (sys, Ap, Ai, Ax, Az, Xx, Xz, Bx, Bz,
+        Numeric, Control, Info, Wi, W) ;
+
+complex int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Numeric ;
+    int64_t *Ap, *Ai, *Wi ;
+    int sys ;
+    double *Bx, *Bz, *Xx, *Xz, *Ax, *Az, *W,
+        Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
+    int status = umfpack_zl_wsolve (sys, Ap, Ai, Ax, Az, Xx, Xz, Bx, Bz,
+        Numeric, Control, Info, Wi, W) ;
+
+packed complex Syntax:
+
+    Same as above, except Az, Xz, and Bz are NULL.
+
+Purpose:
+
+    Given LU factors computed by umfpack_*_numeric (PAQ=LU) and the
+    right-hand-side, B, solve a linear system for the solution X.  Iterative
+    refinement is optionally performed.  This routine is identical to
+    umfpack_*_solve, except that it does not dynamically allocate any workspace.
+    When you have many linear systems to solve, this routine is faster than
+    umfpack_*_solve, since the workspace (Wi, W) needs to be allocated only
+    once, prior to calling umfpack_*_wsolve.
+
+Returns:
+
+    The status code is returned.  See Info [UMFPACK_STATUS], below.
+
+Arguments:
+
+    Int sys ;           Input argument, not modified.
+    Int Ap [n+1] ;      Input argument, not modified.
+    Int Ai [nz] ;       Input argument, not modified.
+    double Ax [nz] ;    Input argument, not modified.
+                        Size 2*nz in packed complex case.
+    double X [n] ;      Output argument.
+    double B [n] ;      Input argument, not modified.
+    void *Numeric ;     Input argument, not modified.
+    double Control [UMFPACK_CONTROL] ;  Input argument, not modified.
+    double Info [UMFPACK_INFO] ;        Output argument.
+
+    for complex versions:
+    double Az [nz] ;    Input argument, not modified, imaginary part
+    double Xx [n] ;     Output argument, real part.
+                        Size 2*n in packed complex case.
+    double Xz [n] ;     Output argument, imaginary part
+    double Bx [n] ;     Input argument, not modified, real part.
+                        Size 2*n in packed complex case.
+    double Bz [n] ;     Input argument, not modified, imaginary part
+
+        The above arguments are identical to umfpack_*_solve, except that the
+        error code UMFPACK_ERROR_out_of_memory will not be returned in
+        Info [UMFPACK_STATUS], since umfpack_*_wsolve does not allocate any
+        memory.
+
+    Int Wi [n] ;                Workspace.
+    double W [c*n] ;            Workspace, where c is defined below.
+
+        The Wi and W arguments are workspace used by umfpack_*_wsolve.  They
+        need not be initialized on input, and their contents are undefined on
+        output.  The size of W depends on whether or not iterative refinement is
+        used, and which version (real or complex) is called.  Iterative
+        refinement is performed if Ax=b, A'x=b, or A.'x=b is being solved,
+        Control [UMFPACK_IRSTEP] > 0, and A is nonsingular.  The size of W is
+        given below:
+
+                                no iter.        with iter.
+                                refinement      refinement
+        umfpack_di_wsolve       n               5*n
+        umfpack_dl_wsolve       n               5*n
+        umfpack_zi_wsolve       4*n             10*n
+        umfpack_zl_wsolve       4*n             10*n
+*/
+
+//------------------------------------------------------------------------------
+// umfpack_numeric_profile
+//------------------------------------------------------------------------------
+
+int umfpack_di_numeric_profile
+(
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    double Profile [UMFPACK_PROFILE]
+) ;
+
+int umfpack_dl_numeric_profile
+(
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    double Profile [UMFPACK_PROFILE]
+) ;
+
+int umfpack_zi_numeric_profile
+(
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ],
+    const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    double Profile [UMFPACK_PROFILE]
+) ;
+
+int umfpack_zl_numeric_profile
+(
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ],
+    const double Az [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    double Profile [UMFPACK_PROFILE]
+) ;
+
+/*
+double int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int32_t *Ap, *Ai ;
+    double *Ax, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO],
+        Profile [UMFPACK_PROFILE] ;
+    int status = umfpack_di_numeric_profile (Ap, Ai, Ax, Symbolic, &Numeric,
+        Control, Info, Profile) ;
+
+double int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int64_t *Ap, *Ai ;
+    double *Ax, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO],
+        Profile [UMFPACK_PROFILE] ;
+    int status = umfpack_dl_numeric_profile (Ap, Ai, Ax, Symbolic, &Numeric,
+        Control, Info, Profile) ;
+
+complex int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int32_t *Ap, *Ai ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO],
+        Profile [UMFPACK_PROFILE] ;
+    int status = umfpack_zi_numeric_profile (Ap, Ai, Ax, Az, Symbolic,
+        &Numeric, Control, Info, Profile) ;
+
+complex int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, *Numeric ;
+    int64_t *Ap, *Ai ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO],
+        Profile [UMFPACK_PROFILE] ;
+    int status = umfpack_zl_numeric_profile (Ap, Ai, Ax, Az, Symbolic,
+        &Numeric, Control, Info, Profile) ;
+
+Purpose:
+
+    Identical to umfpack_*_numeric, except that it also returns a profile of
+    the numerical factorization in Profile: the wall clock time spent in each
+    phase of the factorization, counts of the frontal matrices and their
+    dense updates, and histograms of the dimensions of the dense updates
+    sent to the BLAS.  This can be used to select Control [UMFPACK_BLOCK_SIZE]
+    (see the UMFPACK_PROFILE_UPDATE_K_HIST histogram) and
+    Control [UMFPACK_FRONT_ALLOC_INIT] (see UMFPACK_PROFILE_NGROW) for a
+    family of matrices.  umfpack_*_numeric is the same as
+    umfpack_*_numeric_profile with Profile passed as NULL.
+
+    Timing each phase adds a call to the wall clock timer for each pivot, so
+    the factorization time is slightly higher than without the profile.  Each
+    phase is charged only for its own time: a garbage collection triggered
+    while a front is created or the LU factors are stored is counted in
+    UMFPACK_PROFILE_GC_TIME alone.  The phase times thus add up to the time
+    spent in the numerical factorization itself, which is a little less than
+    UMFPACK_PROFILE_NUMERIC_TIME, since that also includes the setup and
+    workspace allocation in umfpack_*_numeric.
+
+    The time for each front of the column elimination tree (all phases,
+    including the start of its chain if it is the first front in a chain,
+    and the end of the chain if it is the last) is summarized by the longest
+    time for a single front and by a histogram of the front times.
+
+    The profile can be exported as JSON or CSV text with
+    umfpack_export_profile.
+
+Arguments:
+
+    All arguments except Profile are the same as umfpack_*_numeric.
+
+    double Profile [UMFPACK_PROFILE] ;  Output argument.
+
+        If Profile is (double *) NULL, no profile is computed.  Otherwise,
+        Profile is cleared on input and holds the profile on output (see the
+        UMFPACK_PROFILE_* definitions in umfpack.h for its contents).  If the
+        factorization fails, Profile holds the statistics gathered up to the
+        point of failure.
+*/
+
+//==============================================================================
+//==== Batch factorization =====================================================
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// umfpack_numeric_batch
+//------------------------------------------------------------------------------
+
+int umfpack_di_numeric_batch
+(
+    int32_t nbatch,
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void *Numeric [ ],
+    double X [ ],
+    const double B [ ],
+    int nthreads,
+    double memory_limit,
+    const double Control [UMFPACK_CONTROL],
+    double Info [ ]
+) ;
+
+int umfpack_dl_numeric_batch
+(
+    int64_t nbatch,
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void *Numeric [ ],
+    double X [ ],
+    const double B [ ],
+    int nthreads,
+    double memory_limit,
+    const double Control [UMFPACK_CONTROL],
+    double Info [ ]
+) ;
+
+int umfpack_zi_numeric_batch
+(
+    int32_t nbatch,
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void *Numeric [ ],
+    double Xx [ ],       double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    int nthreads,
+    double memory_limit,
+    const double Control [UMFPACK_CONTROL],
+    double Info [ ]
+) ;
+
+int umfpack_zl_numeric_batch
+(
+    int64_t nbatch,
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ], const double Az [ ],
+    void *Symbolic,
+    void *Numeric [ ],
+    double Xx [ ],       double Xz [ ],
+    const double Bx [ ], const double Bz [ ],
+    int nthreads,
+    double memory_limit,
+    const double Control [UMFPACK_CONTROL],
+    double Info [ ]
+) ;
+
+/*
+double int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, **Numeric ;
+    int32_t nbatch, *Ap, *Ai ;
+    int nthreads ;
+    double *Ax, *X, *B, memory_limit, *Info, Control [UMFPACK_CONTROL] ;
+    int status = umfpack_di_numeric_batch (nbatch, Ap, Ai, Ax, Symbolic,
+        Numeric, X, B, nthreads, memory_limit, Control, Info) ;
+
+double int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, **Numeric ;
+    int64_t nbatch, *Ap, *Ai ;
+    int nthreads ;
+    double *Ax, *X, *B, memory_limit, *Info, Control [UMFPACK_CONTROL] ;
+    int status = umfpack_dl_numeric_batch (nbatch, Ap, Ai, Ax, Symbolic,
+        Numeric, X, B, nthreads, memory_limit, Control, Info) ;
+
+complex int32_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, **Numeric ;
+    int32_t nbatch, *Ap, *Ai ;
+    int nthreads ;
+    double *Ax, *Az, *Xx, *Xz, *Bx, *Bz, memory_limit, *Info,
+        Control [UMFPACK_CONTROL] ;
+    int status = umfpack_zi_numeric_batch (nbatch, Ap, Ai, Ax, Az, Symbolic,
+        Numeric, Xx, Xz, Bx, Bz, nthreads, memory_limit, Control, Info) ;
+
+complex int64_t Syntax:
+
+    #include "umfpack.h"
+    void *Symbolic, **Numeric ;
+    int64_t nbatch, *Ap, *Ai ;
+    int nthreads ;
+    double *Ax, *Az, *Xx, *Xz, *Bx, *Bz, memory_limit, *Info,
+        Control [UMFPACK_CONTROL] ;
+    int status = umfpack_zl_numeric_batch (nbatch, Ap, Ai, Ax, Az, Symbolic,
+        Numeric, Xx, Xz, Bx, Bz, nthreads, memory_limit, Control, Info) ;
+
+packed complex Syntax:
+
+    Same as above, except Az, Xz, and Bz are NULL.
+
+Purpose:
+
+    Factorizes a batch of nbatch matrices A_0, ..., A_{nbatch-1} that all have
+    the same nonzero pattern, using a single Symbolic object computed by
+    umfpack_*_symbolic or umfpack_*_qsymbolic for that pattern.  This is
+    typical of a frequency sweep, where K + i*w*C is factorized for many
+    values of w.  Each factorization is the same as umfpack_*_numeric.  The
+    LU factors can be returned, or A_k x_k = b_k can be solved for each k
+    (with umfpack_*_solve and sys = UMFPACK_A), or both.
+
+    If UMFPACK has been compiled with OpenMP, several matrices are factorized
+    at the same time, one per thread.  The number of threads is limited by
+    nthreads, by nbatch, and by memory_limit.  If the BLAS is multithreaded,
+    it is best to use a single-threaded BLAS, or to limit its number of
+    threads, since each factorization calls the BLAS.  Without OpenMP, the
+    matrices are factorized one at a time.
+
+Returns:
+
+    UMFPACK_OK if all matrices were factorized (and solved, if requested).
+    Otherwise, the status of the first matrix (in order of k) that failed
+    with an error, or if none failed, that of the first matrix that gave a
+    warning.  The status of each matrix is in Info [k*UMFPACK_INFO +
+    UMFPACK_STATUS], if Info is present.  The following errors are returned
+    for the batch as a whole, before any matrix is factorized:
+
+    UMFPACK_ERROR_invalid_Symbolic_object
+
+        Symbolic is not valid.
+
+    UMFPACK_ERROR_argument_missing
+
+        Ap, Ai, or Ax is missing, or both Numeric and X (Xx) are missing, or
+        X (Xx) is present but B (Bx) is not.
+
+    UMFPACK_ERROR_n_nonpositive
+
+        nbatch is negative.
+
+    UMFPACK_ERROR_invalid_system
+
+        X (Xx) is present but the matrix is not square.
+
+    UMFPACK_ERROR_invalid_matrix
+
+        Ap [n_col] is negative.
+
+Arguments:
+
+    Int nbatch ;        Input argument.
+
+        The number of matrices.
+
+    Int Ap [n_col+1] ;  Input argument, not modified.
+    Int Ai [nz] ;       Input argument, not modified.
+
+        The nonzero pattern common to all the matrices, where nz = Ap [n_col].
+        See umfpack_*_numeric.
+
+    double Ax [nbatch*nz] ;     Input argument, not modified.
+                                Size 2*nbatch*nz for packed complex case.
+    double Az [nbatch*nz] ;     Input argument, not modified, complex versions.
+
+        The numerical values of the matrices.  The values of A_k are in
+        Ax [k*nz ... (k+1)*nz-1] (and the same part of Az), or in
+        Ax [2*k*nz ... 2*(k+1)*nz-1] for the packed complex case.
+
+    void *Symbolic ;    Input argument, not modified.
+
+        The Symbolic object for the pattern of the matrices.
+
+    void *Numeric [nbatch] ;    Output argument.
+
+        If present, Numeric [k] is the Numeric object for A_k, which must be
+        freed with umfpack_*_free_numeric.  Numeric [k] is NULL if the
+        factorization (or solve) of A_k failed.  If Numeric is NULL, each
+        Numeric object is freed as soon as it is no longer needed.
+
+    double X [nbatch*n] ;       Output argument.
+    or:
+    double Xx [nbatch*n] ;      Output argument, real part.
+                                Size 2*nbatch*n for packed complex case.
+    double Xz [nbatch*n] ;      Output argument, imaginary part.
+
+        If present, x_k is returned in X [k*n ... (k+1)*n-1] (and the same
+        part of Xz), or Xx [2*k*n ... 2*(k+1)*n-1] for the packed complex
+        case.  The matrix must be square.  If Xx is NULL, no solve is done and
+        B is not accessed.  As in umfpack_*_solve, if iterative refinement is
+        done, Az and Xz must either both be present or both be NULL.
+
+    double B [nbatch*n] ;       Input argument, not modified.
+    or:
+    double Bx [nbatch*n] ;      Input argument, not modified, real part.
+                                Size 2*nbatch*n for packed complex case.
+    double Bz [nbatch*n] ;      Input argument, not modified, imaginary part.
+
+        The right-hand sides b_k, stored in the same way as X.
+
+    int nthreads ;      Input argument.
+
+        The maximum number of matrices to factorize at the same time.  If
+        nthreads <= 0, the default number of OpenMP threads is used.
+
+    double memory_limit ;       Input argument.
+
+        If memory_limit > 0, the number of matrices factorized at the same
+        time is limited so that the sum of their estimated peak memory usage
+        (Info [UMFPACK_PEAK_MEMORY_ESTIMATE] as returned by
+        umfpack_*_symbolic, converted to bytes) is at most memory_limit
+        bytes, but at least one matrix is always factorized.  This limit
+        does not include the Numeric objects returned in Numeric [k], which
+        are the responsibility of the caller.
+
+    double Control [UMFPACK_CONTROL] ;  Input argument, not modified.
+
+        Passed to umfpack_*_numeric and umfpack_*_solve for each matrix.
+
+    double Info [nbatch*UMFPACK_INFO] ;  Output argument.
+
+        If present, Info [k*UMFPACK_INFO ... (k+1)*UMFPACK_INFO-1] holds the
+        statistics from umfpack_*_numeric (and umfpack_*_solve) for A_k.
+*/
+
+//==============================================================================
+//==== Single precision LU factors =============================================
+//==============================================================================
+
+//------------------------------------------------------------------------------
+// umfpack_s*_numeric, umfpack_s*_solve: mixed precision factor and solve
+//------------------------------------------------------------------------------
+
+int umfpack_si_numeric
+(
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_sl_numeric
+(
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+
+int umfpack_si_numeric_profile
+(
+    const int32_t Ap [ ],
+    const int32_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    double Profile [UMFPACK_PROFILE]
+) ;
+
+int umfpack_sl_numeric_profile
 (
-    void **SW
+    const int64_t Ap [ ],
+    const int64_t Ai [ ],
+    const double Ax [ ],
+    void *Symbolic,
+    void **Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO],
+    double Profile [UMFPACK_PROFILE]
 ) ;
 
-
-//------------------------------------------------------------------------------
-// umfpack_wsolve
-//------------------------------------------------------------------------------
-
-int umfpack_di_wsolve
+int umfpack_si_solve
 (
     int sys,
     const int32_t Ap [ ],
@@ -2313,12 +3255,10 @@ int umfpack_di_wsolve
     const double B [ ],
     void *Numeric,
     const double Control [UMFPACK_CONTROL],
-    double Info [UMFPACK_INFO],
-    int32_t Wi [ ],
-    double W [ ]
+    double Info [UMFPACK_INFO]
 ) ;
 
-int umfpack_dl_wsolve
+int umfpack_sl_solve
 (
     int sys,
     const int64_t Ap [ ],
@@ -2328,146 +3268,147 @@ int umfpack_dl_wsolve
     const double B [ ],
     void *Numeric,
     const double Control [UMFPACK_CONTROL],
-    double Info [UMFPACK_INFO],
-    int64_t Wi [ ],
-    double W [ ]
+    double Info [UMFPACK_INFO]
 ) ;
 
-int umfpack_zi_wsolve
+int umfpack_si_numeric_fallback
 (
-    int32_t sys,
     const int32_t Ap [ ],
     const int32_t Ai [ ],
-    const double Ax [ ], const double Az [ ],
-    double Xx [ ],       double Xz [ ],
-    const double Bx [ ], const double Bz [ ],
+    const double Ax [ ],
     void *Numeric,
     const double Control [UMFPACK_CONTROL],
-    double Info [UMFPACK_INFO],
-    int32_t Wi [ ],
-    double W [ ]
+    double Info [UMFPACK_INFO]
 ) ;
 
-int umfpack_zl_wsolve
+int umfpack_sl_numeric_fallback
 (
-    int sys,
     const int64_t Ap [ ],
     const int64_t Ai [ ],
-    const double Ax [ ], const double Az [ ],
-    double Xx [ ],       double Xz [ ],
-    const double Bx [ ], const double Bz [ ],
+    const double Ax [ ],
     void *Numeric,
     const double Control [UMFPACK_CONTROL],
-    double Info [UMFPACK_INFO],
-    int64_t Wi [ ],
-    double W [ ]
+    double Info [UMFPACK_INFO]
 ) ;
 
-/*
-double int32_t Syntax:
+void umfpack_si_free_numeric
+(
+    void **Numeric
+) ;
 
-    #include "umfpack.h"
-    void *Numeric ;
-    int32_t *Ap, *Ai, *Wi ;
-    int sys ;
-    double *B, *X, *Ax, *W, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
-    int status = umfpack_di_wsolve (sys, Ap, Ai, Ax, X, B, Numeric,
-        Control, Info, Wi, W) ;
+void umfpack_sl_free_numeric
+(
+    void **Numeric
+) ;
 
-double int64_t Syntax:
+void umfpack_si_defaults
+(
+    double Control [UMFPACK_CONTROL]
+) ;
 
-    #include "umfpack.h"
-    void *Numeric ;
-    int64_t *Ap, *Ai, *Wi ;
-    int sys ;
-    double *B, *X, *Ax, *W, Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
-    int status = umfpack_dl_wsolve (sys, Ap, Ai, Ax, X, B, Numeric,
-        Control, Info, Wi, W) ;
+void umfpack_sl_defaults
+(
+    double Control [UMFPACK_CONTROL]
+) ;
 
-complex int32_t Syntax:
+/*
+single int32_t Syntax:
 
     #include "umfpack.h"
-    void *Numeric ;
-    int32_t *Ap, *Ai, *Wi ; 
-    int sys ;
-    double *Bx, *Bz, *Xx, *Xz, *Ax, *Az, *W,
-        Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
-    int status = umfpack_zi_wsolve (sys, Ap, Ai, Ax, Az, Xx, Xz, Bx, Bz,
-        Numeric, Control, Info, Wi, W) ;
+    void *Symbolic, *Numeric ;
+    int32_t *Ap, *Ai, status ;
+    double *Ax, *X, *B, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    umfpack_si_defaults (Control) ;
+    status = umfpack_di_symbolic (n, n, Ap, Ai, Ax, &Symbolic, Control, Info) ;
+    status = umfpack_si_numeric (Ap, Ai, Ax, Symbolic, &Numeric, Control,
+        Info) ;
+    umfpack_di_free_symbolic (&Symbolic) ;
+    status = umfpack_si_solve (UMFPACK_A, Ap, Ai, Ax, X, B, Numeric, Control,
+        Info) ;
+    umfpack_si_free_numeric (&Numeric) ;
 
-complex int64_t Syntax:
+single int64_t Syntax:
 
     #include "umfpack.h"
-    void *Numeric ;
-    int64_t *Ap, *Ai, *Wi ;
-    int sys ;
-    double *Bx, *Bz, *Xx, *Xz, *Ax, *Az, *W,
-        Info [UMFPACK_INFO], Control [UMFPACK_CONTROL] ;
-    int status = umfpack_zl_wsolve (sys, Ap, Ai, Ax, Az, Xx, Xz, Bx, Bz,
-        Numeric, Control, Info, Wi, W) ;
-
-packed complex Syntax:
-
-    Same as above, except Az, Xz, and Bz are NULL.
+    void *Symbolic, *Numeric ;
+    int64_t *Ap, *Ai ;
+    int status ;
+    double *Ax, *X, *B, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO] ;
+    umfpack_sl_defaults (Control) ;
+    status = umfpack_dl_symbolic (n, n, Ap, Ai, Ax, &Symbolic, Control, Info) ;
+    status = umfpack_sl_numeric (Ap, Ai, Ax, Symbolic, &Numeric, Control,
+        Info) ;
+    umfpack_dl_free_symbolic (&Symbolic) ;
+    status = umfpack_sl_solve (UMFPACK_A, Ap, Ai, Ax, X, B, Numeric, Control,
+        Info) ;
+    umfpack_sl_free_numeric (&Numeric) ;
 
 Purpose:
 
-    Given LU factors computed by umfpack_*_numeric (PAQ=LU) and the
-    right-hand-side, B, solve a linear system for the solution X.  Iterative
-    refinement is optionally performed.  This routine is identical to
-    umfpack_*_solve, except that it does not dynamically allocate any workspace.
-    When you have many linear systems to solve, this routine is faster than
-    umfpack_*_solve, since the workspace (Wi, W) needs to be allocated only
-    once, prior to calling umfpack_*_wsolve.
-
-Returns:
-
-    The status code is returned.  See Info [UMFPACK_STATUS], below.
-
-Arguments:
-
-    Int sys ;           Input argument, not modified.
-    Int Ap [n+1] ;      Input argument, not modified.
-    Int Ai [nz] ;       Input argument, not modified.
-    double Ax [nz] ;    Input argument, not modified.
-                        Size 2*nz in packed complex case.
-    double X [n] ;      Output argument.
-    double B [n] ;      Input argument, not modified.
-    void *Numeric ;     Input argument, not modified.
-    double Control [UMFPACK_CONTROL] ;  Input argument, not modified.
-    double Info [UMFPACK_INFO] ;        Output argument.
-
-    for complex versions:
-    double Az [nz] ;    Input argument, not modified, imaginary part
-    double Xx [n] ;     Output argument, real part.
-                        Size 2*n in packed complex case.
-    double Xz [n] ;     Output argument, imaginary part
-    double Bx [n] ;     Input argument, not modified, real part.
-                        Size 2*n in packed complex case.
-    double Bz [n] ;     Input argument, not modified, imaginary part
-
-        The above arguments are identical to umfpack_*_solve, except that the
-        error code UMFPACK_ERROR_out_of_memory will not be returned in
-        Info [UMFPACK_STATUS], since umfpack_*_wsolve does not allocate any
-        memory.
-
-    Int Wi [n] ;                Workspace.
-    double W [c*n] ;            Workspace, where c is defined below.
-
-        The Wi and W arguments are workspace used by umfpack_*_wsolve.  They
-        need not be initialized on input, and their contents are undefined on
-        output.  The size of W depends on whether or not iterative refinement is
-        used, and which version (real or complex) is called.  Iterative
-        refinement is performed if Ax=b, A'x=b, or A.'x=b is being solved,
-        Control [UMFPACK_IRSTEP] > 0, and A is nonsingular.  The size of W is
-        given below:
-
-                                no iter.        with iter.
-                                refinement      refinement
-        umfpack_di_wsolve       n               5*n
-        umfpack_dl_wsolve       n               5*n
-        umfpack_zi_wsolve       4*n             10*n
-        umfpack_zl_wsolve       4*n             10*n
+    Mixed precision factorization and solve of a real double precision sparse
+    matrix A.  umfpack_s*_numeric computes the same LU factorization as
+    umfpack_d*_numeric, except that the numerical values of the LU factors
+    are held (and computed) in single precision.  This halves the size of the
+    factors, and the single precision BLAS are used for the frontal matrix
+    updates.  The matrix A, the right-hand side B, and the solution X are all
+    in double precision.
+
+    The Symbolic object is the one computed by umfpack_di_*symbolic (for
+    umfpack_si_numeric) or umfpack_dl_*symbolic (for umfpack_sl_numeric).
+    umfpack_s*_numeric keeps its own copy of the Symbolic object in the
+    Numeric object, so the Symbolic object may be freed once the Numeric
+    object has been computed.
+
+    umfpack_s*_solve solves the system with the single precision factors,
+    and then performs iterative refinement in double precision for Ax=b,
+    A'x=b, or A.'x=b, with the residual computed with the original matrix
+    A.  At most Control [UMFPACK_IRSTEP] steps are taken; the default for
+    umfpack_s*_defaults is UMFPACK_DEFAULT_IRSTEP_SINGLE (10), rather than 2.
+    For matrices that are not too ill-conditioned (roughly, a condition
+    number less than 1e6) the result has the same sparse backward error as a
+    double precision solve.
+
+    If the refinement does not reduce the sparse backward error
+    (Info [UMFPACK_OMEGA1] + Info [UMFPACK_OMEGA2]) to about 1e3 times
+    machine epsilon, or if the single precision factors are singular,
+    umfpack_s*_solve solves the system again with a double precision
+    factorization of A, computed by umfpack_d*_numeric with the same Symbolic
+    object and Control parameters.  If umfpack_s*_numeric_fallback has been
+    called, the double precision factorization it keeps in the Numeric object
+    is used, and Info [UMFPACK_FALLBACK_TO_DOUBLE] is 1.  Otherwise a
+    temporary double precision factorization is computed and freed before
+    umfpack_s*_solve returns, and Info [UMFPACK_FALLBACK_TO_DOUBLE] is 2; a
+    caller that sees this value and has more systems to solve should call
+    umfpack_s*_numeric_fallback, so that the factorization is done only once.
+    Info [UMFPACK_FALLBACK_TO_DOUBLE] is 0 if the single precision factors
+    were sufficient.  umfpack_s*_solve never modifies the Numeric object, so
+    concurrent calls with the same Numeric object are safe.
+
+    umfpack_s*_numeric_fallback (Ap, Ai, Ax, Numeric, Control, Info) computes
+    the double precision factorization of A and keeps it in the Numeric
+    object; Ap, Ai, and Ax must be the same matrix given to
+    umfpack_s*_numeric.  It returns UMFPACK_OK at once if the factorization
+    already exists.  It modifies the Numeric object, so it must not be called
+    while another thread is using the same Numeric object.
+
+    Systems other than Ax=b, A'x=b and A.'x=b (solves with L or U only, or
+    with iterative refinement disabled) always use the single precision
+    factors.  Since A is real, A'x=b and A.'x=b are the same.
+
+    The arguments and return values are the same as umfpack_di_numeric and
+    umfpack_di_solve (or umfpack_dl_*), except that the fallback to double
+    precision can return UMFPACK_ERROR_out_of_memory from umfpack_s*_solve.
+    The memory usage statistics returned in Info by umfpack_s*_numeric are
+    for the single precision factors.
+
+    umfpack_s*_numeric_profile is the single precision version of
+    umfpack_*_numeric_profile.
+
+    umfpack_s*_free_numeric frees the Numeric object, including its copy of
+    the Symbolic object and the double precision factorization, if any.
+
+    Only the routines above are provided for single precision LU factors.
+    The Numeric object cannot be passed to any other umfpack_* routine.
 */
 
 //==============================================================================
@@ -4416,6 +5357,111 @@ Arguments:
         Size of the blob, in bytes.
 */
 
+//------------------------------------------------------------------------------
+// umfpack_deserialize_numeric_wrap
+//------------------------------------------------------------------------------
+
+int umfpack_di_deserialize_numeric_wrap
+(
+    void **Numeric,         // output: Numeric object that uses the blob
+    const int8_t *blob,     // input: serialized blob, not modified
+    int64_t blobsize        // size of the blob in bytes
+) ;
+
+int umfpack_dl_deserialize_numeric_wrap
+(
+    void **Numeric,         // output: Numeric object that uses the blob
+    const int8_t *blob,     // input: serialized blob, not modified
+    int64_t blobsize        // size of the blob in bytes
+) ;
+
+int umfpack_zi_deserialize_numeric_wrap
+(
+    void **Numeric,         // output: Numeric object that uses the blob
+    const int8_t *blob,     // input: serialized blob, not modified
+    int64_t blobsize        // size of the blob in bytes
+) ;
+
+int umfpack_zl_deserialize_numeric_wrap
+(
+    void **Numeric,         // output: Numeric object that uses the blob
+    const int8_t *blob,     // input: serialized blob, not modified
+    int64_t blobsize        // size of the blob in bytes
+) ;
+
+/*
+double int32_t Syntax:
+
+    #include "umfpack.h"
+    int64_t blobsize ;
+    const int8_t *blob ;
+    void *Numeric ;
+    int status = umfpack_di_deserialize_numeric_wrap (&Numeric, blob,
+        blobsize) ;
+
+double int64_t Syntax:
+
+    #include "umfpack.h"
+    int64_t blobsize ;
+    const int8_t *blob ;
+    void *Numeric ;
+    int status = umfpack_dl_deserialize_numeric_wrap (&Numeric, blob,
+        blobsize) ;
+
+complex int32_t Syntax:
+
+    #include "umfpack.h"
+    int64_t blobsize ;
+    const int8_t *blob ;
+    void *Numeric ;
+    int status = umfpack_zi_deserialize_numeric_wrap (&Numeric, blob,
+        blobsize) ;
+
+complex int64_t Syntax:
+
+    #include "umfpack.h"
+    int64_t blobsize ;
+    const int8_t *blob ;
+    void *Numeric ;
+    int status = umfpack_zl_deserialize_numeric_wrap (&Numeric, blob,
+        blobsize) ;
+
+Purpose:
+
+    Constructs a new Numeric object that uses the serialized "blob" in place,
+    without copying it.  Only the small header of the Numeric object is
+    allocated; the LU factors, permutations, and scale factors all remain in
+    the blob.  This allows the blob to be a read-only memory-mapped file
+    (mmap with PROT_READ), so that many processes can share a single copy
+    of the factorization through the page cache, and only the pages touched
+    by a solve are read from the file.
+
+    The blob is not modified, and it must remain valid and unmodified until
+    the Numeric object is freed by umfpack_*_free_numeric.  The blob is not
+    freed by umfpack_*_free_numeric; the caller must free (or munmap) it
+    after freeing the Numeric object.  Each array in the blob starts at an
+    offset that is a multiple of 64 bytes from the start of the blob, so the
+    blob itself need only start at an address that is a multiple of 8 bytes
+    (any malloc'd or mmap'd array is suitable).  UMFPACK_ERROR_invalid_blob
+    is returned otherwise.
+
+    The Numeric object can be used with any UMFPACK routine that takes a
+    Numeric object as input (umfpack_*_solve, umfpack_*_get_numeric,
+    umfpack_*_serialize_numeric, and so on).
+
+Returns:
+
+    UMFPACK_OK if successful.
+    UMFPACK_ERROR_argument_missing if blob or Numeric are NULL.
+    UMFPACK_ERROR_invalid_Numeric_object if Numeric is not valid.
+    UMFPACK_ERROR_invalid_blob if blob is too small, or not aligned.
+    UMFPACK_ERROR_out_of_memory if not enough memory is available.
+
+Arguments:
+
+    The arguments are the same as umfpack_*_deserialize_numeric.
+*/
+
 //------------------------------------------------------------------------------
 // umfpack_save_symbolic
 //------------------------------------------------------------------------------
@@ -6229,6 +7275,75 @@ Arguments:
         stats [1]:  (same; was CPU time in prior versions)
 */
 
+//------------------------------------------------------------------------------
+// umfpack_export_profile
+//------------------------------------------------------------------------------
+
+int umfpack_export_profile
+(
+    const double Profile [UMFPACK_PROFILE],
+    int format,
+    void (*write_text) (void *user_data, const char *text),
+    void *user_data
+) ;
+
+/*
+Syntax (for all versions: di, dl, zi, zl, si, and sl):
+
+    #include "umfpack.h"
+    double Profile [UMFPACK_PROFILE] ;
+    void write_text (void *user_data, const char *text)
+    {
+        fputs (text, (FILE *) user_data) ;
+    }
+    ...
+    status = umfpack_di_numeric_profile (Ap, Ai, Ax, Symbolic, &Numeric,
+        Control, Info, Profile) ;
+    status = umfpack_export_profile (Profile, UMFPACK_PROFILE_JSON,
+        write_text, stdout) ;
+
+Purpose:
+
+    Writes a Profile computed by umfpack_*_numeric_profile as text, in either
+    JSON or CSV format, by passing the text in pieces to a user callback.
+    This allows the profile to be written to a file, a log, or a string
+    buffer without any dependence on the C I/O library.
+
+    The JSON format is a single object: one member for each timer, counter,
+    and parameter, plus one array for each histogram.  The CSV format has a
+    header line "name,value", followed by one line per entry; histogram
+    buckets are named update_k_hist_<b>, update_mn_hist_<b>, and
+    front_time_hist_<b>.
+
+Returns:
+
+    UMFPACK_OK if successful.
+    UMFPACK_ERROR_argument_missing if Profile is NULL, or if format is not
+        UMFPACK_PROFILE_CSV or UMFPACK_PROFILE_JSON.  Nothing is written.
+
+Arguments:
+
+    double Profile [UMFPACK_PROFILE] ;  Input argument, not modified.
+
+        A profile computed by umfpack_*_numeric_profile.
+
+    int format ;                        Input argument, not modified.
+
+        UMFPACK_PROFILE_CSV for CSV, or UMFPACK_PROFILE_JSON for JSON.
+
+    void (*write_text) (void *user_data, const char *text) ;
+
+        A callback that receives each piece of the text, as a
+        null-terminated string.  The pieces are concatenated to form the
+        full text; each piece is at most one line.  If NULL, the text is
+        printed with the SuiteSparse printf function, as used by the
+        umfpack_*_report_* routines.
+
+    void *user_data ;                   Input argument.
+
+        Passed unchanged to each call of write_text.
+*/
+
 #ifdef __cplusplus
 }
 #endif
@@ -26,6 +26,8 @@ void UMF_blas3_update
     Int blas_ok = TRUE ;
 #endif
 
+    UMF_PROFILE_TIC (t) ;
+
     DEBUG5 (("In UMF_blas3_update "ID" "ID" "ID"\n",
 	Work->fnpiv, Work->fnrows, Work->fncols)) ;
 
@@ -39,6 +41,30 @@ void UMF_blas3_update
     m = Work->fnrows ;
     n = Work->fncols ;
 
+    if (Work->Profile != (double *) NULL)
+    {
+	/* histogram of the rank-k updates: k in [2^b, 2^(b+1)) goes in
+	 * bucket b of the k histogram, and m*n in [4^b, 4^(b+1)) in bucket b
+	 * of the m*n histogram (the last bucket of each is open-ended) */
+	double *Profile = Work->Profile ;
+	double mn = ((double) m) * ((double) n) ;
+	Int b ;
+	for (b = 0 ; b < UMFPACK_PROFILE_NHIST - 1 && (k >> (b+1)) > 0 ; b++) ;
+	Profile [UMFPACK_PROFILE_UPDATE_K_HIST + b]++ ;
+	for (b = 0 ; b < UMFPACK_PROFILE_NHIST - 1 && mn >= 4 ; b++)
+	{
+	    mn /= 4 ;
+	}
+	Profile [UMFPACK_PROFILE_UPDATE_MN_HIST + b]++ ;
+	Profile [UMFPACK_PROFILE_NUPDATES]++ ;
+	Profile [UMFPACK_PROFILE_UPDATE_FLOPS] +=
+	    MULTSUB_FLOPS * ((double) m) * ((double) n) * ((double) k) ;
+	Profile [UMFPACK_PROFILE_MAX_UPDATE_NROWS] =
+	    MAX (Profile [UMFPACK_PROFILE_MAX_UPDATE_NROWS], m) ;
+	Profile [UMFPACK_PROFILE_MAX_UPDATE_NCOLS] =
+	    MAX (Profile [UMFPACK_PROFILE_MAX_UPDATE_NCOLS], n) ;
+    }
+
     d = Work->fnr_curr ;
     dc = Work->fnc_curr ;
     nb = Work->nb ;
@@ -166,4 +192,5 @@ void UMF_blas3_update
 #endif
 
     DEBUG2 (("blas3 "ID" "ID" "ID"\n", k, Work->fnrows, Work->fncols)) ;
+    UMF_PROFILE_TOC (t, UMFPACK_PROFILE_BLAS3_TIME) ;
 }
@@ -138,6 +138,13 @@
     SUITESPARSE_BLAS_zgemm ("N", "T", m, n, k, alpha, A, ldac, B, ldb, \
         beta, C, ldac, ok) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_GEMM(m,n,k,A,B,ldb,C,ldac,ok) \
+{ \
+    float alpha = -1, beta = 1 ; \
+    SUITESPARSE_BLAS_sgemm ("N", "T", m, n, k, &alpha, A, ldac, B, ldb, \
+        &beta, C, ldac, ok) ; \
+}
 #else
 #define BLAS_GEMM(m,n,k,A,B,ldb,C,ldac,ok) \
 { \
@@ -162,6 +169,12 @@
     double alpha [2] = {-1,0} ; \
     SUITESPARSE_BLAS_zgeru (m, n, alpha, x, 1, y, 1, A, d, ok) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_GER(m,n,x,y,A,d,ok) \
+{ \
+    float alpha = -1 ; \
+    SUITESPARSE_BLAS_sger (m, n, &alpha, x, 1, y, 1, A, d, ok) ; \
+}
 #else
 #define BLAS_GER(m,n,x,y,A,d,ok) \
 { \
@@ -184,6 +197,12 @@
     double alpha [2] = {-1,0}, beta [2] = {1,0} ; \
     SUITESPARSE_BLAS_zgemv ("N", m, n, alpha, A, d, x, 1, beta, y, 1, ok) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_GEMV(m,n,A,x,y,d,ok) \
+{ \
+    float alpha = -1, beta = 1 ; \
+    SUITESPARSE_BLAS_sgemv ("N", m, n, &alpha, A, d, x, 1, &beta, y, 1, ok) ; \
+}
 #else
 #define BLAS_GEMV(m,n,A,x,y,d,ok) \
 { \
@@ -205,6 +224,11 @@
 { \
     SUITESPARSE_BLAS_ztrsv ("L", "N", "U", m, A, d, b, 1, ok) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_TRSV(m,A,b,d,ok) \
+{ \
+    SUITESPARSE_BLAS_strsv ("L", "N", "U", m, A, d, b, 1, ok) ; \
+}
 #else
 #define BLAS_TRSV(m,A,b,d,ok) \
 { \
@@ -227,6 +251,13 @@
     SUITESPARSE_BLAS_ztrsm ("R", "L", "T", "U", m, n, alpha, A, \
         lda, B, ldb, ok) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_TRSM_RIGHT(m,n,A,lda,B,ldb,ok) \
+{ \
+    float alpha = 1 ; \
+    SUITESPARSE_BLAS_strsm ("R", "L", "T", "U", m, n, &alpha, A, \
+        lda, B, ldb, ok) ; \
+}
 #else
 #define BLAS_TRSM_RIGHT(m,n,A,lda,B,ldb,ok) \
 { \
@@ -250,6 +281,12 @@
     alpha [1] = IMAG_COMPONENT (s) ; \
     SUITESPARSE_BLAS_zscal (n, alpha, x, 1, ok) ; \
 }
+#elif defined (SINGLE)
+#define BLAS_SCAL(n,s,x,ok) \
+{ \
+    float alpha = REAL_COMPONENT (s) ; \
+    SUITESPARSE_BLAS_sscal (n, &alpha, x, 1, ok) ; \
+}
 #else
 #define BLAS_SCAL(n,s,x,ok) \
 { \
@@ -76,6 +76,9 @@ void UMF_garbage_collection
     /* get parameters */
     /* ---------------------------------------------------------------------- */
 
+    UMF_PROFILE_TIC (t) ;
+    UMF_PROFILE_COUNT (UMFPACK_PROFILE_NGARBAGE) ;
+
     Col_degree = Numeric->Cperm ;	/* for NON_PIVOTAL_COL macro */
     Row_degree = Numeric->Rperm ;	/* for NON_PIVOTAL_ROW macro */
     Row_tuples = Numeric->Uip ;
@@ -692,4 +695,5 @@ void UMF_garbage_collection
 #endif
 
     DEBUG8 (("::::GARBAGE COLLECTION DONE::::\n")) ;
+    UMF_PROFILE_TOC (t, UMFPACK_PROFILE_GC_TIME) ;
 }
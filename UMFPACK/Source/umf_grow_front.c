@@ -285,6 +285,13 @@ Int UMF_grow_front
     Work->fcurr_size = newsize ;    /* including LU, L, U, and C blocks */
     Work->do_grow = FALSE ;	    /* the front has just been grown */
 
+    if (Work->Profile != (double *) NULL)
+    {
+	Work->Profile [UMFPACK_PROFILE_NGROW]++ ;
+	Work->Profile [UMFPACK_PROFILE_MAX_FRONT_SIZE] =
+	    MAX (Work->Profile [UMFPACK_PROFILE_MAX_FRONT_SIZE], newsize) ;
+    }
+
     ASSERT (Work->fnr_curr >= 0) ;
     ASSERT (Work->fnr_curr % 2 == 1) ;
     DEBUG0 (("Newly grown front: "ID"+"ID" by "ID"+"ID"\n", Work->fnr_curr,
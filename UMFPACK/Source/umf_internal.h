@@ -190,7 +190,7 @@
 /* integer type for AMD: int32_t or int64_t */
 /* ------------------------------------------------------------------------- */
 
-#if defined (DLONG) || defined (ZLONG)
+#if defined (DLONG) || defined (ZLONG) || defined (SLONG)
 
     #define Int int64_t
     #define UInt uint64_t
@@ -491,6 +491,10 @@ typedef union Unit_union Unit ;
     the code to ensure that all routines that operate on the objects are of the
     same release.  The values themselves are purely arbitrary.  They are less
     than the ANSI C required minimums of INT_MAX and LONG_MAX, respectively.
+
+    The single precision versions (umfpack_si_* and umfpack_sl_*) have their
+    own Numeric objects, but use the Symbolic objects of umfpack_di_* and
+    umfpack_dl_*, respectively, since the Symbolic object holds no values.
 */
 
 #ifdef DINT
@@ -509,6 +513,32 @@ typedef union Unit_union Unit ;
 #define NUMERIC_VALID  129987754
 #define SYMBOLIC_VALID 110291734
 #endif
+#ifdef SINT
+#define NUMERIC_VALID  19739
+#define SYMBOLIC_VALID 41937
+#endif
+#ifdef SLONG
+#define NUMERIC_VALID  318820735
+#define SYMBOLIC_VALID 399192713
+#endif
+
+/* Single precision LU factors are accepted by the solve if iterative
+ * refinement brings the sparse backward error below this tolerance.
+ * Otherwise, the matrix is refactorized in double precision. */
+#define UMF_SINGLE_OMEGA_TOL (1e3 * DBL_EPSILON)
+
+/* LU factors in compressed-column form, and workspace, for
+ * UMFPACK_solve_sparse.  Held in a single block of memory. */
+typedef struct	/* SparseSolveType */
+{
+    Int *Lp, *Li ;	/* strictly lower part of L, by column */
+    Int *Lrp, *Lrj ;	/* pattern of strictly lower part of L, by row */
+    Int *Up, *Ui ;	/* strictly upper part of U, by column */
+    Int *Urp, *Urj ;	/* pattern of strictly upper part of U, by row */
+    Entry *Lx, *Ux ;
+    Int *Pinv, *Q, *Qinv ;	/* row and column permutations */
+
+} SparseSolveType ;
 
 typedef struct	/* NumericType */
 {
@@ -595,8 +625,31 @@ typedef struct	/* NumericType */
 
     Int maxnrows, maxncols ;	/* not the same as Symbolic->maxnrows/cols* */
 
+    Int wrapped ;	/* TRUE if D, Rperm, ..., Memory are held in a */
+			/* user-owned blob, from UMFPACK_deserialize_numeric_wrap. */
+			/* UMFPACK_free_numeric then frees only this struct. */
+
+    SparseSolveType *Sparse ;	/* column form of the factors, created */
+			/* by UMFPACK_solve_sparse_setup */
+
+#ifdef SINGLE
+    void *Symbolic ;	/* copy of the Symbolic object, for the fallback */
+    void *Fallback ;	/* double precision Numeric object, if refinement */
+			/* with the single precision factors has failed */
+#endif
+
 } NumericType ;
 
+/* Each array in a serialized Numeric blob starts at a multiple of
+ * UMF_BLOB_ALIGN bytes from the start of the blob, so that the blob can be used
+ * in place if the blob itself starts on a UMF_BLOB_START byte boundary.  The
+ * arrays only need 8-byte alignment; 64 bytes (a cache line) keeps each array
+ * off the cache lines of its neighbors when the blob is shared. */
+#define UMF_BLOB_ALIGN 64
+#define UMF_BLOB_START 8
+#define UMF_BLOB_PAD(nbytes) \
+    ((((nbytes) + UMF_BLOB_ALIGN - 1) / UMF_BLOB_ALIGN) * UMF_BLOB_ALIGN)
+
 
 
 /* -------------------------------------------------------------------------- */
@@ -830,6 +883,10 @@ typedef struct	/* WorkType */
 	pivrow_in_front,	/* true if current pivot row in Frows */
 	pivcol_in_front ;	/* true if current pivot column in Fcols */
 
+    double *Profile ;	/* UMFPACK_numeric_profile output, or NULL if the */
+			/* factorization is not being profiled */
+    double profile_charged ;	/* time charged to the phases so far */
+
     /* ----------------------------------------------------------------------
      * Current frontal matrix
      * ----------------------------------------------------------------------
@@ -862,6 +919,39 @@ typedef struct	/* WorkType */
 
 } WorkType ;
 
+/* -------------------------------------------------------------------------- */
+/* profiling of the numerical factorization */
+/* -------------------------------------------------------------------------- */
+
+/* These do nothing unless Work->Profile is present (UMFPACK_numeric_profile).
+ * Times are wall clock times, in seconds.  Phases can nest (a garbage
+ * collection can be triggered while a front is created or the LU factors are
+ * stored), so each phase is charged only for the time not already charged to
+ * a phase nested inside it.  The phase times then add up. */
+
+#define UMF_PROFILE_TIC(t) \
+    double t = (Work->Profile != (double *) NULL) ? SUITESPARSE_TIME : 0 ; \
+    double t ## _charged = Work->profile_charged
+
+#define UMF_PROFILE_TOC(t,phase) \
+{ \
+    if (Work->Profile != (double *) NULL) \
+    { \
+	double t ## _elapsed = SUITESPARSE_TIME - t ; \
+	Work->Profile [phase] += \
+	    t ## _elapsed - (Work->profile_charged - t ## _charged) ; \
+	Work->profile_charged = t ## _charged + t ## _elapsed ; \
+    } \
+}
+
+#define UMF_PROFILE_COUNT(what) \
+{ \
+    if (Work->Profile != (double *) NULL) \
+    { \
+	Work->Profile [what]++ ; \
+    } \
+}
+
 
 /* -------------------------------------------------------------------------- */
 /* Symbolic */
@@ -33,6 +33,36 @@
 /* perform an action, and return if out of memory */
 #define DO(action) { if (! (action)) { return (UMFPACK_ERROR_out_of_memory) ; }}
 
+/* perform an action, and add its time to one phase of the profile, if any */
+#define PHASE(phase,action) \
+{ \
+    UMF_PROFILE_TIC (t) ; \
+    action ; \
+    UMF_PROFILE_TOC (t, phase) ; \
+}
+
+/* add the time since t to the per-front times of the profile, if any, and
+ * restart t for the next front.  A front whose factorization takes less than
+ * 2 microseconds goes in bucket 0 of the histogram, a front that takes
+ * [2^b, 2^(b+1)) microseconds goes in bucket b (the last is open-ended). */
+#define PROFILE_FRONT(t) \
+{ \
+    if (Work->Profile != (double *) NULL) \
+    { \
+	double *Profile = Work->Profile, now = SUITESPARSE_TIME ; \
+	double usec = 1e6 * (now - t) ; \
+	Int b ; \
+	Profile [UMFPACK_PROFILE_MAX_FRONT_TIME] = \
+	    MAX (Profile [UMFPACK_PROFILE_MAX_FRONT_TIME], now - t) ; \
+	for (b = 0 ; b < UMFPACK_PROFILE_NHIST - 1 && usec >= 2 ; b++) \
+	{ \
+	    usec /= 2 ; \
+	} \
+	Profile [UMFPACK_PROFILE_FRONT_TIME_HIST + b]++ ; \
+	t = now ; \
+    } \
+}
+
 Int UMF_kernel
 (
     const Int Ap [ ],
@@ -52,17 +82,21 @@ Int UMF_kernel
     /* ---------------------------------------------------------------------- */
 
     Int j, f1, f2, chain, nchains, *Chain_start, status, fixQ, evaporate,
-	*Front_npivcol, jmax, nb, drop ;
+	*Front_npivcol, jmax, nb, drop, ok ;
+    double t_front ;
 
     /* ---------------------------------------------------------------------- */
     /* initialize memory space and load the matrix. Optionally scale. */
     /* ---------------------------------------------------------------------- */
 
-    if (!UMF_kernel_init (Ap, Ai, Ax,
+    UMF_PROFILE_TIC (t_init) ;
+    ok = UMF_kernel_init (Ap, Ai, Ax,
 #ifdef COMPLEX
 	Az,
 #endif
-	Numeric, Work, Symbolic))
+	Numeric, Work, Symbolic) ;
+    UMF_PROFILE_TOC (t_init, UMFPACK_PROFILE_INIT_TIME) ;
+    if (!ok)
     {
 	/* UMF_kernel_init is guaranteed to succeed, since UMFPACK_numeric */
 	/* either allocates enough space or if not, UMF_kernel does not get */
@@ -111,7 +145,12 @@ Int UMF_kernel
 	/* get the initial frontal matrix size for this chain */
 	/* ------------------------------------------------------------------ */
 
-	DO (UMF_start_front (chain, Numeric, Work, Symbolic)) ;
+	/* the time for each front, including the chain setup for the first
+	 * front and the chain wrapup for the last */
+	t_front = (Work->Profile != (double *) NULL) ? SUITESPARSE_TIME : 0 ;
+	PHASE (UMFPACK_PROFILE_FRONT_TIME,
+	    DO (UMF_start_front (chain, Numeric, Work, Symbolic))) ;
+	UMF_PROFILE_COUNT (UMFPACK_PROFILE_NFRONTS) ;
 
 	/* ------------------------------------------------------------------ */
 	/* factorize each front in the chain */
@@ -156,7 +195,8 @@ Int UMF_kernel
 		/* get the pivot row and column */
 		/* ---------------------------------------------------------- */
 
-		status = UMF_local_search (Numeric, Work, Symbolic) ;
+		PHASE (UMFPACK_PROFILE_PIVOT_SEARCH_TIME,
+		    status = UMF_local_search (Numeric, Work, Symbolic)) ;
 		if (status == UMFPACK_ERROR_different_pattern)
 		{
 		    /* :: pattern change detected in umf_local_search :: */
@@ -179,11 +219,13 @@ Int UMF_kernel
 		    UMF_blas3_update (Work) ;
 		    if (drop)
 		    {
-			DO (UMF_store_lu_drop (Numeric, Work)) ;
+			PHASE (UMFPACK_PROFILE_STORE_LU_TIME,
+			    DO (UMF_store_lu_drop (Numeric, Work))) ;
 		    }
 		    else
 		    {
-			DO (UMF_store_lu (Numeric, Work)) ;
+			PHASE (UMFPACK_PROFILE_STORE_LU_TIME,
+			    DO (UMF_store_lu (Numeric, Work))) ;
 		    }
 		}
 
@@ -194,19 +236,24 @@ Int UMF_kernel
 		if (Work->do_extend)
 		{
 		    /* extend the current front */
-		    DO (UMF_extend_front (Numeric, Work)) ;
+		    PHASE (UMFPACK_PROFILE_FRONT_TIME,
+			DO (UMF_extend_front (Numeric, Work))) ;
+		    UMF_PROFILE_COUNT (UMFPACK_PROFILE_NEXTEND) ;
 		}
 		else
 		{
 		    /* finish the current front (if any) and start a new one */
-		    DO (UMF_create_element (Numeric, Work, Symbolic)) ;
-		    DO (UMF_init_front (Numeric, Work)) ;
+		    PHASE (UMFPACK_PROFILE_FRONT_TIME,
+			DO (UMF_create_element (Numeric, Work, Symbolic)) ;
+			DO (UMF_init_front (Numeric, Work))) ;
+		    UMF_PROFILE_COUNT (UMFPACK_PROFILE_NFRONTS) ;
 		}
 
 		/* ---------------------------------------------------------- */
 		/* Numerical & symbolic assembly into current frontal matrix */
 		/* ---------------------------------------------------------- */
 
+		UMF_PROFILE_TIC (t_assemble) ;
 		if (fixQ)
 		{
 		    UMF_assemble_fixq (Numeric, Work) ;
@@ -221,6 +268,7 @@ Int UMF_kernel
 		/* ---------------------------------------------------------- */
 
 		UMF_scale_column (Numeric, Work) ;
+		UMF_PROFILE_TOC (t_assemble, UMFPACK_PROFILE_ASSEMBLE_TIME) ;
 
 		/* ---------------------------------------------------------- */
 		/* Numerical update if enough pivots accumulated */
@@ -232,11 +280,13 @@ Int UMF_kernel
 		    UMF_blas3_update (Work) ;
 		    if (drop)
 		    {
-			DO (UMF_store_lu_drop (Numeric, Work)) ;
+			PHASE (UMFPACK_PROFILE_STORE_LU_TIME,
+			    DO (UMF_store_lu_drop (Numeric, Work))) ;
 		    }
 		    else
 		    {
-			DO (UMF_store_lu (Numeric, Work)) ;
+			PHASE (UMFPACK_PROFILE_STORE_LU_TIME,
+			    DO (UMF_store_lu (Numeric, Work))) ;
 		    }
 
 		}
@@ -258,6 +308,11 @@ Int UMF_kernel
 		    Work->fncols = 0 ;
 		}
 	    }
+
+	    if (Work->frontid < f2)
+	    {
+		PROFILE_FRONT (t_front) ;
+	    }
 	}
 
 	/* ------------------------------------------------------------------
@@ -270,15 +325,19 @@ Int UMF_kernel
 	UMF_blas3_update (Work) ;
 	if (drop)
 	{
-	    DO (UMF_store_lu_drop (Numeric, Work)) ;
+	    PHASE (UMFPACK_PROFILE_STORE_LU_TIME,
+		DO (UMF_store_lu_drop (Numeric, Work))) ;
 	}
 	else
 	{
-	    DO (UMF_store_lu (Numeric, Work)) ;
+	    PHASE (UMFPACK_PROFILE_STORE_LU_TIME,
+		DO (UMF_store_lu (Numeric, Work))) ;
 	}
 	Work->fnrows_new = Work->fnrows ;
 	Work->fncols_new = Work->fncols ;
-	DO (UMF_create_element (Numeric, Work, Symbolic)) ;
+	PHASE (UMFPACK_PROFILE_FRONT_TIME,
+	    DO (UMF_create_element (Numeric, Work, Symbolic))) ;
+	PROFILE_FRONT (t_front) ;
 
 	/* ------------------------------------------------------------------ */
 	/* current front is now empty */
@@ -292,7 +351,8 @@ Int UMF_kernel
     /* end the last Lchain and Uchain and finalize the LU factors */
     /* ---------------------------------------------------------------------- */
 
-    UMF_kernel_wrapup (Numeric, Symbolic, Work) ;
+    PHASE (UMFPACK_PROFILE_WRAPUP_TIME,
+	UMF_kernel_wrapup (Numeric, Symbolic, Work)) ;
 
     /* note that the matrix may be singular (this is OK) */
     return (UMFPACK_OK) ;
@@ -0,0 +1,652 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source/umf_solve_mixed: solve with single precision LU factors
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+/*
+    Not user-callable.  The SINT and SLONG version of UMF_solve, for the
+    single precision LU factors computed by umfpack_s*_numeric.  The right-hand
+    side B, the solution X, and the matrix A are all in double precision.
+    Only the triangular solves with L and U are done in single precision.
+
+    For Ax=b, A'x=b and A.'x=b, iterative refinement is done in double
+    precision, with the residual computed against the original double
+    precision matrix A:
+
+	x = x + Q (U \ (L \ (P R (b - A x))))
+
+    so that x converges to the accuracy of a double precision solve if A is
+    not too ill-conditioned.  The same sparse backward error estimate as
+    umf_solve.c (Arioli, Demmel, and Duff) is used to decide when to stop.
+    The residual computed for the backward error is reused as the right-hand
+    side of the next refinement step, so each step costs one matrix-vector
+    multiply with A and one pair of single precision triangular solves.
+    UMFPACK_solve checks Info [UMFPACK_OMEGA1] and Info [UMFPACK_OMEGA2] on
+    return, and falls back to a double precision factorization if the
+    refinement did not converge.
+
+    Returns UMFPACK_OK if successful, UMFPACK_ERROR_argument_missing if
+    required arguments are missing, UMFPACK_ERROR_invalid_system if the sys
+    string is not valid, or UMFPACK_WARNING_singular_matrix.
+
+    SolveWork is of size 6*n doubles if irstep > 0, or n doubles otherwise.
+*/
+
+#include "umf_internal.h"
+#include "umf_solve.h"
+#include "umf_lsolve.h"
+#include "umf_usolve.h"
+#include "umf_ltsolve.h"
+#include "umf_utsolve.h"
+
+PRIVATE Int do_step
+(
+    double omega [3],
+    Int step,
+    const double B2 [ ],
+    double X [ ],
+    const double R [ ],
+    const double Y [ ],
+    const double Z2 [ ],
+    double S [ ],
+    Int n,
+    double Info [UMFPACK_INFO]
+) ;
+
+/* ========================================================================== */
+/* === UMF_solve ============================================================ */
+/* ========================================================================== */
+
+Int UMF_solve
+(
+    int sys,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+    double Xx [ ],
+    const double Bx [ ],
+    NumericType *Numeric,
+    Int irstep,
+    double Info [UMFPACK_INFO],
+    Int Pattern [ ],		/* size n */
+    double SolveWork [ ]	/* if irstep>0: size 6*n, otherwise size n */
+)
+{
+    /* ---------------------------------------------------------------------- */
+    /* local variables */
+    /* ---------------------------------------------------------------------- */
+
+    double omega [3], d, ri, z2i, yi, xj, axx, flops ;
+    double *X, *R, *S, *Y, *B2, *Z2, *Rs ;
+    Entry *W ;
+    Int *Rperm, *Cperm, i, n, p, p2, j, step, nz, status, do_scale ;
+#ifndef NRECIPROCAL
+    Int do_recip = Numeric->do_recip ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* initializations */
+    /* ---------------------------------------------------------------------- */
+
+    ASSERT (Numeric && Xx && Bx && Pattern && SolveWork && Info) ;
+
+    nz = 0 ;
+    omega [0] = 0. ;
+    omega [1] = 0. ;
+    omega [2] = 0. ;
+    Rperm = Numeric->Rperm ;
+    Cperm = Numeric->Cperm ;
+    Rs = Numeric->Rs ;		/* row scale factors */
+    do_scale = (Rs != (double *) NULL) ;
+    flops = 0 ;
+    Info [UMFPACK_SOLVE_FLOPS] = 0 ;
+    Info [UMFPACK_IR_TAKEN] = 0 ;
+    Info [UMFPACK_IR_ATTEMPTED] = 0 ;
+
+    /* UMFPACK_solve does not call this routine if A is rectangular */
+    ASSERT (Numeric->n_row == Numeric->n_col) ;
+    n = Numeric->n_row ;
+    if (Numeric->nnzpiv < n
+	|| SCALAR_IS_ZERO (Numeric->rcond) || SCALAR_IS_NAN (Numeric->rcond))
+    {
+	DEBUGm4 (("Note, matrix is singular in umf_solve_mixed\n")) ;
+	status = UMFPACK_WARNING_singular_matrix ;
+	irstep = 0 ;
+    }
+    else
+    {
+	status = UMFPACK_OK ;
+    }
+    irstep = MAX (0, irstep) ;
+
+    X = Xx ;					/* double X [0..n-1] */
+    W = (Entry *) SolveWork ;			/* Entry W [0..n-1] */
+    R = (double *) NULL ;			/* unused if no refinement */
+    S = (double *) NULL ;
+    Y = (double *) NULL ;
+    B2 = (double *) NULL ;
+    Z2 = (double *) NULL ;
+
+    if (irstep > 0)
+    {
+	if (!Ap || !Ai || !Ax)
+	{
+	    return (UMFPACK_ERROR_argument_missing) ;
+	}
+	R  = SolveWork + n ;			/* double R [0..n-1] */
+	S  = SolveWork + 2*n ;			/* double S [0..n-1] */
+	Y  = SolveWork + 3*n ;			/* double Y [0..n-1] */
+	B2 = SolveWork + 4*n ;			/* double B2 [0..n-1] */
+	Z2 = SolveWork + 5*n ;			/* double Z2 [0..n-1] */
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* determine which system to solve */
+    /* ---------------------------------------------------------------------- */
+
+    if (sys == UMFPACK_A)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* solve A x = b with optional iterative refinement */
+	/* ------------------------------------------------------------------ */
+
+	if (irstep > 0)
+	{
+	    /* Y (i) = ||R A_i||, 1-norm of row i of R A, and B2 = abs (B) */
+	    nz = Ap [n] ;
+	    Info [UMFPACK_NZ] = nz ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		Y [i] = 0. ;
+		B2 [i] = SCALAR_ABS (Bx [i]) ;
+	    }
+	    flops += nz ;
+	    for (p = 0 ; p < nz ; p++)
+	    {
+		Y [Ai [p]] += SCALAR_ABS (Ax [p]) ;
+	    }
+	    if (do_scale)
+	    {
+#ifndef NRECIPROCAL
+		if (do_recip)
+		{
+		    for (i = 0 ; i < n ; i++)
+		    {
+			Y [i]  *= Rs [i] ;
+			B2 [i] *= Rs [i] ;
+		    }
+		}
+		else
+#endif
+		{
+		    for (i = 0 ; i < n ; i++)
+		    {
+			Y [i]  /= Rs [i] ;
+			B2 [i] /= Rs [i] ;
+		    }
+		}
+		flops += 2 * n ;
+	    }
+	}
+
+	for (step = 0 ; step <= irstep ; step++)
+	{
+
+	    /* -------------------------------------------------------------- */
+	    /* step 0:  x = Q (U \ (L \ (P R b))) */
+	    /* step k:  x = x + Q (U \ (L \ (P R (b - A x)))) */
+	    /* -------------------------------------------------------------- */
+
+	    if (step == 0)
+	    {
+		/* W = P R b, rounded to single precision */
+		if (do_scale)
+		{
+#ifndef NRECIPROCAL
+		    if (do_recip)
+		    {
+			for (i = 0 ; i < n ; i++)
+			{
+			    W [i] = (Entry) (Bx [Rperm [i]] * Rs [Rperm [i]]) ;
+			}
+		    }
+		    else
+#endif
+		    {
+			for (i = 0 ; i < n ; i++)
+			{
+			    W [i] = (Entry) (Bx [Rperm [i]] / Rs [Rperm [i]]) ;
+			}
+		    }
+		    flops += n ;
+		}
+		else
+		{
+		    for (i = 0 ; i < n ; i++)
+		    {
+			W [i] = (Entry) Bx [Rperm [i]] ;
+		    }
+		}
+	    }
+	    else
+	    {
+		/* W = P R (b - A x); R already holds the scaled residual
+		 * computed for the backward error of the prior step */
+		for (i = 0 ; i < n ; i++)
+		{
+		    W [i] = (Entry) R [Rperm [i]] ;
+		}
+	    }
+
+	    flops += UMF_lsolve (Numeric, W, Pattern) ;
+	    flops += UMF_usolve (Numeric, W, Pattern) ;
+
+	    if (step == 0)
+	    {
+		for (i = 0 ; i < n ; i++)
+		{
+		    X [Cperm [i]] = (double) W [i] ;
+		}
+	    }
+	    else
+	    {
+		flops += n ;
+		for (i = 0 ; i < n ; i++)
+		{
+		    X [Cperm [i]] += (double) W [i] ;
+		}
+	    }
+
+	    /* -------------------------------------------------------------- */
+	    /* sparse backward error estimate, in double precision */
+	    /* -------------------------------------------------------------- */
+
+	    if (irstep > 0)
+	    {
+		/* R (i) = R (b - A x)_i, and Z2 (i) = R (|A||x|)_i */
+		for (i = 0 ; i < n ; i++)
+		{
+		    R [i] = Bx [i] ;
+		    Z2 [i] = 0. ;
+		}
+		flops += 4 * nz ;
+		for (j = 0 ; j < n ; j++)
+		{
+		    xj = X [j] ;
+		    p2 = Ap [j+1] ;
+		    for (p = Ap [j] ; p < p2 ; p++)
+		    {
+			i = Ai [p] ;
+			axx = Ax [p] * xj ;
+			R [i] -= axx ;
+			Z2 [i] += SCALAR_ABS (axx) ;
+		    }
+		}
+		if (do_scale)
+		{
+#ifndef NRECIPROCAL
+		    if (do_recip)
+		    {
+			for (i = 0 ; i < n ; i++)
+			{
+			    R [i]  *= Rs [i] ;
+			    Z2 [i] *= Rs [i] ;
+			}
+		    }
+		    else
+#endif
+		    {
+			for (i = 0 ; i < n ; i++)
+			{
+			    R [i]  /= Rs [i] ;
+			    Z2 [i] /= Rs [i] ;
+			}
+		    }
+		    flops += 2 * n ;
+		}
+
+		flops += 5 * n ;
+		if (do_step (omega, step, B2, X, R, Y, Z2, S, n, Info))
+		{
+		    /* iterative refinement is done */
+		    break ;
+		}
+	    }
+	}
+
+    }
+    else if (sys == UMFPACK_At || sys == UMFPACK_Aat)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* solve A' x = b with optional iterative refinement */
+	/* ------------------------------------------------------------------ */
+
+	/* A' and A.' are the same, since A is real */
+
+	if (irstep > 0)
+	{
+	    /* Y (i) = ||(A' R)_i||, 1-norm of row i of A' R, B2 = abs (B) */
+	    nz = Ap [n] ;
+	    Info [UMFPACK_NZ] = nz ;
+	    flops += 2 * nz ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		yi = 0. ;
+		p2 = Ap [i+1] ;
+		for (p = Ap [i] ; p < p2 ; p++)
+		{
+		    d = SCALAR_ABS (Ax [p]) ;
+		    if (do_scale)
+		    {
+#ifndef NRECIPROCAL
+			if (do_recip)
+			{
+			    d *= Rs [Ai [p]] ;
+			}
+			else
+#endif
+			{
+			    d /= Rs [Ai [p]] ;
+			}
+		    }
+		    yi += d ;
+		}
+		Y [i] = yi ;
+		B2 [i] = SCALAR_ABS (Bx [i]) ;
+	    }
+	}
+
+	for (step = 0 ; step <= irstep ; step++)
+	{
+
+	    /* -------------------------------------------------------------- */
+	    /* step 0:  x = R P' (L' \ (U' \ (Q' b))) */
+	    /* step k:  x = x + R P' (L' \ (U' \ (Q' (b - A' x)))) */
+	    /* -------------------------------------------------------------- */
+
+	    for (i = 0 ; i < n ; i++)
+	    {
+		/* W = Q' b, or Q' (b - A' x) from the prior step */
+		W [i] = (Entry) ((step == 0) ? Bx [Cperm [i]] : R [Cperm [i]]) ;
+	    }
+
+	    flops += UMF_uhsolve (Numeric, W, Pattern) ;
+	    flops += UMF_lhsolve (Numeric, W, Pattern) ;
+
+	    /* X = R P' W (step 0), or X += R P' W (step > 0) */
+	    flops += 2 * n ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		j = Rperm [i] ;
+		d = (double) W [i] ;
+		if (do_scale)
+		{
+#ifndef NRECIPROCAL
+		    if (do_recip)
+		    {
+			d *= Rs [j] ;
+		    }
+		    else
+#endif
+		    {
+			d /= Rs [j] ;
+		    }
+		}
+		X [j] = (step == 0) ? d : (X [j] + d) ;
+	    }
+
+	    /* -------------------------------------------------------------- */
+	    /* sparse backward error estimate, in double precision */
+	    /* -------------------------------------------------------------- */
+
+	    if (irstep > 0)
+	    {
+		/* R (i) = (b - A' x)_i, and Z2 (i) = (|A'||x|)_i */
+		flops += 4 * nz ;
+		for (i = 0 ; i < n ; i++)
+		{
+		    ri = Bx [i] ;
+		    z2i = 0. ;
+		    p2 = Ap [i+1] ;
+		    for (p = Ap [i] ; p < p2 ; p++)
+		    {
+			axx = Ax [p] * X [Ai [p]] ;
+			ri -= axx ;
+			z2i += SCALAR_ABS (axx) ;
+		    }
+		    R [i] = ri ;
+		    Z2 [i] = z2i ;
+		}
+
+		flops += 5 * n ;
+		if (do_step (omega, step, B2, X, R, Y, Z2, S, n, Info))
+		{
+		    /* iterative refinement is done */
+		    break ;
+		}
+	    }
+	}
+
+    }
+    else if (sys == UMFPACK_Pt_L || sys == UMFPACK_L)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* Solve P'Lx=b:  x = L \ Pb, or Lx=b:  x = L \ b */
+	/* ------------------------------------------------------------------ */
+
+	for (i = 0 ; i < n ; i++)
+	{
+	    W [i] = (Entry) Bx [(sys == UMFPACK_L) ? i : Rperm [i]] ;
+	}
+	flops = UMF_lsolve (Numeric, W, Pattern) ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    X [i] = (double) W [i] ;
+	}
+	status = UMFPACK_OK ;
+
+    }
+    else if (sys == UMFPACK_Lt_P || sys == UMFPACK_Lat_P
+	  || sys == UMFPACK_Lt   || sys == UMFPACK_Lat)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* Solve L'Px=b:  x = P' (L' \ b), or L'x=b:  x = L' \ b */
+	/* ------------------------------------------------------------------ */
+
+	for (i = 0 ; i < n ; i++)
+	{
+	    W [i] = (Entry) Bx [i] ;
+	}
+	flops = UMF_lhsolve (Numeric, W, Pattern) ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    X [(sys == UMFPACK_Lt_P || sys == UMFPACK_Lat_P) ? Rperm [i] : i]
+		= (double) W [i] ;
+	}
+	status = UMFPACK_OK ;
+
+    }
+    else if (sys == UMFPACK_U_Qt || sys == UMFPACK_U)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* Solve UQ'x=b:  x = Q (U \ b), or Ux=b:  x = U \ b */
+	/* ------------------------------------------------------------------ */
+
+	for (i = 0 ; i < n ; i++)
+	{
+	    W [i] = (Entry) Bx [i] ;
+	}
+	flops = UMF_usolve (Numeric, W, Pattern) ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    X [(sys == UMFPACK_U_Qt) ? Cperm [i] : i] = (double) W [i] ;
+	}
+
+    }
+    else if (sys == UMFPACK_Q_Ut || sys == UMFPACK_Q_Uat
+	  || sys == UMFPACK_Ut   || sys == UMFPACK_Uat)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* Solve QU'x=b:  x = U' \ Q'b, or U'x=b:  x = U' \ b */
+	/* ------------------------------------------------------------------ */
+
+	for (i = 0 ; i < n ; i++)
+	{
+	    W [i] = (Entry)
+		Bx [(sys == UMFPACK_Q_Ut || sys == UMFPACK_Q_Uat) ? Cperm [i] : i];
+	}
+	flops = UMF_uhsolve (Numeric, W, Pattern) ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    X [i] = (double) W [i] ;
+	}
+
+    }
+    else
+    {
+	return (UMFPACK_ERROR_invalid_system) ;
+    }
+
+    /* return UMFPACK_OK, or UMFPACK_WARNING_singular_matrix */
+    /* Note that systems involving just L will return UMFPACK_OK */
+    Info [UMFPACK_SOLVE_FLOPS] = flops ;
+    return (status) ;
+}
+
+
+/* ========================================================================== */
+/* === do_step ============================================================== */
+/* ========================================================================== */
+
+/* Perform one step of iterative refinement, for A x = b or A' x = b.  This is
+ * the same as do_step in umf_solve.c, except that X, R, and S are always
+ * real and double precision. */
+
+PRIVATE Int do_step		/* return TRUE if iterative refinement done */
+(
+    double omega [3],
+    Int step,			/* which step of iterative refinement to do */
+    const double B2 [ ],	/* abs (B) */
+    double X [ ],
+    const double R [ ],		/* residual */
+    const double Y [ ],
+    const double Z2 [ ],
+    double S [ ],
+    Int n,
+    double Info [UMFPACK_INFO]
+)
+{
+    double last_omega [3], tau, nctau, d1, wd1, d2, wd2, xi, yix, wi, xnorm ;
+    Int i ;
+
+    nctau = 1000 * n * DBL_EPSILON ;
+
+    last_omega [0] = omega [0] ;
+    last_omega [1] = omega [1] ;
+    last_omega [2] = omega [2] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* compute sparse backward errors: omega [1] and omega [2] */
+    /* ---------------------------------------------------------------------- */
+
+    xnorm = 0.0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+	xi = SCALAR_ABS (X [i]) ;
+	if (SCALAR_IS_NAN (xi))
+	{
+	    xnorm = xi ;
+	    break ;
+	}
+	xnorm = MAX (xnorm, xi) ;
+    }
+
+    omega [1] = 0. ;
+    omega [2] = 0. ;
+    for (i = 0 ; i < n ; i++)
+    {
+	yix = Y [i] * xnorm ;
+	tau = (yix + B2 [i]) * nctau ;
+	d1 = Z2 [i] + B2 [i] ;
+	wi = SCALAR_ABS (R [i]) ;
+	if (SCALAR_IS_NAN (d1))
+	{
+	    omega [1] = d1 ;
+	    omega [2] = d1 ;
+	    break ;
+	}
+	if (SCALAR_IS_NAN (tau))
+	{
+	    omega [1] = tau ;
+	    omega [2] = tau ;
+	    break ;
+	}
+	if (d1 > tau)
+	{
+	    wd1 = wi / d1 ;
+	    omega [1] = MAX (omega [1], wd1) ;
+	}
+	else if (tau > 0.0)
+	{
+	    d2 = Z2 [i] + yix ;
+	    wd2 = wi / d2 ;
+	    omega [2] = MAX (omega [2], wd2) ;
+	}
+    }
+
+    omega [0] = omega [1] + omega [2] ;
+    Info [UMFPACK_OMEGA1] = omega [1] ;
+    Info [UMFPACK_OMEGA2] = omega [2] ;
+
+    /* ---------------------------------------------------------------------- */
+    /* stop the iterations if the backward error is small, or NaN */
+    /* ---------------------------------------------------------------------- */
+
+    Info [UMFPACK_IR_TAKEN] = step ;
+    Info [UMFPACK_IR_ATTEMPTED] = step ;
+
+    if (SCALAR_IS_NAN (omega [0]) || omega [0] < DBL_EPSILON)
+    {
+	return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* stop if insufficient decrease in omega */
+    /* ---------------------------------------------------------------------- */
+
+    if (step > 0 && omega [0] > last_omega [0] / 2)
+    {
+	if (omega [0] > last_omega [0])
+	{
+	    /* last iteration better than this one, reinstate it */
+	    for (i = 0 ; i < n ; i++)
+	    {
+		X [i] = S [i] ;
+	    }
+	    Info [UMFPACK_OMEGA1] = last_omega [1] ;
+	    Info [UMFPACK_OMEGA2] = last_omega [2] ;
+	}
+	Info [UMFPACK_IR_TAKEN] = step - 1 ;
+	return (TRUE) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* save current solution in case we need to reinstate */
+    /* ---------------------------------------------------------------------- */
+
+    for (i = 0 ; i < n ; i++)
+    {
+	S [i] = X [i] ;
+    }
+    return (FALSE) ;
+}
@@ -14,10 +14,19 @@
    DLONG:	double precision, int64_t integers
    ZLONG:	complex double precision, int64_t integers
    ZINT:	complex double precision, int32_t integers
+   SINT:	single precision LU factors, int32_t integers
+   SLONG:	single precision LU factors, int64_t integers
+
+   The SINT and SLONG versions factorize a real double precision matrix A,
+   but hold the LU factors in single precision.  Their solve refines the
+   solution in double precision against the original A.  Only the factor
+   and solve routines are compiled for these versions; the Symbolic object
+   is shared with the DINT and DLONG versions.
 */
 
 /* Set DINT as the default, if nothing is defined */
-#if !defined (DLONG) && !defined (DINT) && !defined (ZLONG) && !defined (ZINT)
+#if !defined (DLONG) && !defined (DINT) && !defined (ZLONG) && !defined (ZINT) \
+    && !defined (SLONG) && !defined (SINT)
 #define DINT
 #endif
 
@@ -26,11 +35,16 @@
 #define COMPLEX
 #endif
 
+/* Determine if the LU factors are held in single precision */
+#if defined (SLONG) || defined (SINT)
+#define SINGLE
+#endif
+
 /* -------------------------------------------------------------------------- */
 /* integer type (Int is int32_t or int64_t) defined in umf_internal.h */
 /* -------------------------------------------------------------------------- */
 
-#if defined (DLONG) || defined (ZLONG)
+#if defined (DLONG) || defined (ZLONG) || defined (SLONG)
 #define LONG_INTEGER
 #endif
 
@@ -108,7 +122,11 @@ SCALAR_IS_LTZERO(x):
 
 #ifndef COMPLEX
 
+#ifdef SINGLE
+#define Entry float
+#else
 #define Entry double
+#endif
 
 #define SPLIT(s)    		    (1)
 #define REAL_COMPONENT(c)	    (c)
@@ -487,6 +505,8 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_di_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_di_get_determinant
 #define UMFPACK_numeric		 umfpack_di_numeric
+#define UMFPACK_numeric_profile umfpack_di_numeric_profile
+#define UMFPACK_numeric_batch	 umfpack_di_numeric_batch
 #define UMFPACK_qsymbolic	 umfpack_di_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_di_fsymbolic
 #define UMFPACK_paru_symbolic	 umfpack_di_paru_symbolic
@@ -506,6 +526,8 @@ typedef struct
 #define UMFPACK_load_symbolic	 umfpack_di_load_symbolic
 #define UMFPACK_scale		 umfpack_di_scale
 #define UMFPACK_solve		 umfpack_di_solve
+#define UMFPACK_solve_sparse	 umfpack_di_solve_sparse
+#define UMFPACK_solve_sparse_setup umfpack_di_solve_sparse_setup
 #define UMFPACK_symbolic	 umfpack_di_symbolic
 #define UMFPACK_transpose	 umfpack_di_transpose
 #define UMFPACK_triplet_to_col	 umfpack_di_triplet_to_col
@@ -517,6 +539,7 @@ typedef struct
 #define UMFPACK_serialize_symbolic_size umfpack_di_serialize_symbolic_size
 #define UMFPACK_serialize_numeric       umfpack_di_serialize_numeric
 #define UMFPACK_deserialize_numeric     umfpack_di_deserialize_numeric
+#define UMFPACK_deserialize_numeric_wrap umfpack_di_deserialize_numeric_wrap
 #define UMFPACK_serialize_numeric_size  umfpack_di_serialize_numeric_size
 #define UMFPACK_copy_symbolic	        umfpack_di_copy_symbolic
 #define UMFPACK_copy_numeric	        umfpack_di_copy_numeric
@@ -615,6 +638,8 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_dl_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_dl_get_determinant
 #define UMFPACK_numeric		 umfpack_dl_numeric
+#define UMFPACK_numeric_profile umfpack_dl_numeric_profile
+#define UMFPACK_numeric_batch	 umfpack_dl_numeric_batch
 #define UMFPACK_qsymbolic	 umfpack_dl_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_dl_fsymbolic
 #define UMFPACK_paru_symbolic	 umfpack_dl_paru_symbolic
@@ -634,6 +659,8 @@ typedef struct
 #define UMFPACK_load_symbolic	 umfpack_dl_load_symbolic
 #define UMFPACK_scale		 umfpack_dl_scale
 #define UMFPACK_solve		 umfpack_dl_solve
+#define UMFPACK_solve_sparse	 umfpack_dl_solve_sparse
+#define UMFPACK_solve_sparse_setup umfpack_dl_solve_sparse_setup
 #define UMFPACK_symbolic	 umfpack_dl_symbolic
 #define UMFPACK_transpose	 umfpack_dl_transpose
 #define UMFPACK_triplet_to_col	 umfpack_dl_triplet_to_col
@@ -645,6 +672,7 @@ typedef struct
 #define UMFPACK_serialize_symbolic_size umfpack_dl_serialize_symbolic_size
 #define UMFPACK_serialize_numeric       umfpack_dl_serialize_numeric
 #define UMFPACK_deserialize_numeric     umfpack_dl_deserialize_numeric
+#define UMFPACK_deserialize_numeric_wrap umfpack_dl_deserialize_numeric_wrap
 #define UMFPACK_serialize_numeric_size  umfpack_dl_serialize_numeric_size
 #define UMFPACK_copy_symbolic	        umfpack_dl_copy_symbolic
 #define UMFPACK_copy_numeric	        umfpack_dl_copy_numeric
@@ -743,6 +771,8 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_zi_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_zi_get_determinant
 #define UMFPACK_numeric		 umfpack_zi_numeric
+#define UMFPACK_numeric_profile umfpack_zi_numeric_profile
+#define UMFPACK_numeric_batch	 umfpack_zi_numeric_batch
 #define UMFPACK_qsymbolic	 umfpack_zi_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_zi_fsymbolic
 #define UMFPACK_paru_symbolic	 umfpack_zi_paru_symbolic
@@ -762,6 +792,8 @@ typedef struct
 #define UMFPACK_load_symbolic	 umfpack_zi_load_symbolic
 #define UMFPACK_scale		 umfpack_zi_scale
 #define UMFPACK_solve		 umfpack_zi_solve
+#define UMFPACK_solve_sparse	 umfpack_zi_solve_sparse
+#define UMFPACK_solve_sparse_setup umfpack_zi_solve_sparse_setup
 #define UMFPACK_symbolic	 umfpack_zi_symbolic
 #define UMFPACK_transpose	 umfpack_zi_transpose
 #define UMFPACK_triplet_to_col	 umfpack_zi_triplet_to_col
@@ -773,6 +805,7 @@ typedef struct
 #define UMFPACK_serialize_symbolic_size umfpack_zi_serialize_symbolic_size
 #define UMFPACK_serialize_numeric       umfpack_zi_serialize_numeric
 #define UMFPACK_deserialize_numeric     umfpack_zi_deserialize_numeric
+#define UMFPACK_deserialize_numeric_wrap umfpack_zi_deserialize_numeric_wrap
 #define UMFPACK_serialize_numeric_size  umfpack_zi_serialize_numeric_size
 #define UMFPACK_copy_symbolic	        umfpack_zi_copy_symbolic
 #define UMFPACK_copy_numeric	        umfpack_zi_copy_numeric
@@ -871,6 +904,8 @@ typedef struct
 #define UMFPACK_get_symbolic	 umfpack_zl_get_symbolic
 #define UMFPACK_get_determinant	 umfpack_zl_get_determinant
 #define UMFPACK_numeric		 umfpack_zl_numeric
+#define UMFPACK_numeric_profile umfpack_zl_numeric_profile
+#define UMFPACK_numeric_batch	 umfpack_zl_numeric_batch
 #define UMFPACK_qsymbolic	 umfpack_zl_qsymbolic
 #define UMFPACK_fsymbolic	 umfpack_zl_fsymbolic
 #define UMFPACK_paru_symbolic	 umfpack_zl_paru_symbolic
@@ -890,6 +925,8 @@ typedef struct
 #define UMFPACK_load_symbolic	 umfpack_zl_load_symbolic
 #define UMFPACK_scale		 umfpack_zl_scale
 #define UMFPACK_solve		 umfpack_zl_solve
+#define UMFPACK_solve_sparse	 umfpack_zl_solve_sparse
+#define UMFPACK_solve_sparse_setup umfpack_zl_solve_sparse_setup
 #define UMFPACK_symbolic	 umfpack_zl_symbolic
 #define UMFPACK_transpose	 umfpack_zl_transpose
 #define UMFPACK_triplet_to_col	 umfpack_zl_triplet_to_col
@@ -901,6 +938,7 @@ typedef struct
 #define UMFPACK_serialize_symbolic_size umfpack_zl_serialize_symbolic_size
 #define UMFPACK_serialize_numeric       umfpack_zl_serialize_numeric
 #define UMFPACK_deserialize_numeric     umfpack_zl_deserialize_numeric
+#define UMFPACK_deserialize_numeric_wrap umfpack_zl_deserialize_numeric_wrap
 #define UMFPACK_serialize_numeric_size  umfpack_zl_serialize_numeric_size
 #define UMFPACK_copy_symbolic	        umfpack_zl_copy_symbolic
 #define UMFPACK_copy_numeric	        umfpack_zl_copy_numeric
@@ -925,3 +963,193 @@ typedef struct
 #define UMF_dump_diagonal_map	 umfzl_dump_diagonal_map
 
 #endif
+
+/* -------------------------------------------------------------------------- */
+/* Single precision LU factors, with int32_t integers */
+/* -------------------------------------------------------------------------- */
+
+#ifdef SINT
+
+#define UMF_analyze		 umf_i_analyze
+#define UMF_apply_order		 umf_i_apply_order
+#define UMF_assemble		 umfsi_assemble
+#define UMF_assemble_fixq	 umfsi_assemble_fixq
+#define UMF_blas3_update	 umfsi_blas3_update
+#define UMF_build_tuples	 umfsi_build_tuples
+#define UMF_build_tuples_usage	 umfsi_build_tuples_usage
+#define UMF_colamd		 umf_i_colamd
+#define UMF_colamd_set_defaults	 umf_i_colamd_set_defaults
+#define UMF_create_element	 umfsi_create_element
+#define UMF_extend_front	 umfsi_extend_front
+#define UMF_free		 umf_i_free
+#define UMF_fsize		 umf_i_fsize
+#define UMF_garbage_collection	 umfsi_garbage_collection
+#define UMF_get_memory		 umfsi_get_memory
+#define UMF_grow_front		 umfsi_grow_front
+#define UMF_init_front		 umfsi_init_front
+#define UMF_is_permutation	 umf_i_is_permutation
+#define UMF_kernel		 umfsi_kernel
+#define UMF_kernel_init		 umfsi_kernel_init
+#define UMF_kernel_init_usage	 umfsi_kernel_init_usage
+#define UMF_kernel_wrapup	 umfsi_kernel_wrapup
+#define UMF_local_search	 umfsi_local_search
+#define UMF_lsolve		 umfsi_lsolve
+#define UMF_ltsolve		 umfsi_ltsolve
+#define UMF_lhsolve		 umfsi_lhsolve
+#define UMF_malloc		 umf_i_malloc
+#define UMF_mem_alloc_element	 umfsi_mem_alloc_element
+#define UMF_mem_alloc_head_block umfsi_mem_alloc_head_block
+#define UMF_mem_alloc_tail_block umfsi_mem_alloc_tail_block
+#define UMF_mem_free_tail_block	 umfsi_mem_free_tail_block
+#define UMF_mem_init_memoryspace umfsi_mem_init_memoryspace
+#define UMF_realloc		 umf_i_realloc
+#define UMF_report_perm		 umf_i_report_perm
+#define UMF_report_vector	 umfsi_report_vector
+#define UMF_row_search		 umfsi_row_search
+#define UMF_scale		 umfsi_scale
+#define UMF_scale_column	 umfsi_scale_column
+#define UMF_set_stats		 umfsi_set_stats
+#define UMF_singletons		 umf_i_singletons
+#define UMF_solve		 umfsi_solve
+#define UMF_start_front		 umfsi_start_front
+#define UMF_store_lu		 umfsi_store_lu
+#define UMF_store_lu_drop	 umfsi_store_lu_drop
+#define UMF_symbolic_usage	 umfsi_symbolic_usage
+#define UMF_tuple_lengths	 umfsi_tuple_lengths
+#define UMF_usolve		 umfsi_usolve
+#define UMF_utsolve		 umfsi_utsolve
+#define UMF_uhsolve		 umfsi_uhsolve
+#define UMF_valid_numeric	 umfsi_valid_numeric
+#define UMF_valid_symbolic	 umfsi_valid_symbolic
+#define UMF_cholmod		 umf_i_cholmod
+
+#define UMFPACK_defaults	 umfpack_si_defaults
+#define UMFPACK_free_numeric	 umfpack_si_free_numeric
+#define UMFPACK_numeric		 umfpack_si_numeric
+#define UMFPACK_numeric_fallback umfpack_si_numeric_fallback
+#define UMFPACK_numeric_profile umfpack_si_numeric_profile
+#define UMFPACK_solve		 umfpack_si_solve
+
+/* double precision routines used for the fallback factorization: */
+#define UMFPACK_double_copy_symbolic  umfpack_di_copy_symbolic
+#define UMFPACK_double_free_symbolic  umfpack_di_free_symbolic
+#define UMFPACK_double_defaults       umfpack_di_defaults
+#define UMFPACK_double_numeric        umfpack_di_numeric
+#define UMFPACK_double_free_numeric   umfpack_di_free_numeric
+#define UMFPACK_double_solve          umfpack_di_solve
+
+/* for debugging only: */
+#define UMF_malloc_count	 umf_i_malloc_count
+#define UMF_debug		 umfsi_debug
+#define UMF_allocfail		 umfsi_allocfail
+#define UMF_gprob		 umfsi_gprob
+#define UMF_dump_dense		 umfsi_dump_dense
+#define UMF_dump_element	 umfsi_dump_element
+#define UMF_dump_rowcol		 umfsi_dump_rowcol
+#define UMF_dump_matrix		 umfsi_dump_matrix
+#define UMF_dump_current_front	 umfsi_dump_current_front
+#define UMF_dump_lu		 umfsi_dump_lu
+#define UMF_dump_memory		 umfsi_dump_memory
+#define UMF_dump_packed_memory	 umfsi_dump_packed_memory
+#define UMF_dump_col_matrix	 umfsi_dump_col_matrix
+#define UMF_dump_chain		 umfsi_dump_chain
+#define UMF_dump_start		 umfsi_dump_start
+#define UMF_dump_rowmerge	 umfsi_dump_rowmerge
+#define UMF_dump_diagonal_map	 umfsi_dump_diagonal_map
+
+#endif
+
+/* -------------------------------------------------------------------------- */
+/* Single precision LU factors, with int64_t integers */
+/* -------------------------------------------------------------------------- */
+
+#ifdef SLONG
+
+#define UMF_analyze		 umf_l_analyze
+#define UMF_apply_order		 umf_l_apply_order
+#define UMF_assemble		 umfsl_assemble
+#define UMF_assemble_fixq	 umfsl_assemble_fixq
+#define UMF_blas3_update	 umfsl_blas3_update
+#define UMF_build_tuples	 umfsl_build_tuples
+#define UMF_build_tuples_usage	 umfsl_build_tuples_usage
+#define UMF_colamd		 umf_l_colamd
+#define UMF_colamd_set_defaults	 umf_l_colamd_set_defaults
+#define UMF_create_element	 umfsl_create_element
+#define UMF_extend_front	 umfsl_extend_front
+#define UMF_free		 umf_l_free
+#define UMF_fsize		 umf_l_fsize
+#define UMF_garbage_collection	 umfsl_garbage_collection
+#define UMF_get_memory		 umfsl_get_memory
+#define UMF_grow_front		 umfsl_grow_front
+#define UMF_init_front		 umfsl_init_front
+#define UMF_is_permutation	 umf_l_is_permutation
+#define UMF_kernel		 umfsl_kernel
+#define UMF_kernel_init		 umfsl_kernel_init
+#define UMF_kernel_init_usage	 umfsl_kernel_init_usage
+#define UMF_kernel_wrapup	 umfsl_kernel_wrapup
+#define UMF_local_search	 umfsl_local_search
+#define UMF_lsolve		 umfsl_lsolve
+#define UMF_ltsolve		 umfsl_ltsolve
+#define UMF_lhsolve		 umfsl_lhsolve
+#define UMF_malloc		 umf_l_malloc
+#define UMF_mem_alloc_element	 umfsl_mem_alloc_element
+#define UMF_mem_alloc_head_block umfsl_mem_alloc_head_block
+#define UMF_mem_alloc_tail_block umfsl_mem_alloc_tail_block
+#define UMF_mem_free_tail_block	 umfsl_mem_free_tail_block
+#define UMF_mem_init_memoryspace umfsl_mem_init_memoryspace
+#define UMF_realloc		 umf_l_realloc
+#define UMF_report_perm		 umf_l_report_perm
+#define UMF_report_vector	 umfsl_report_vector
+#define UMF_row_search		 umfsl_row_search
+#define UMF_scale		 umfsl_scale
+#define UMF_scale_column	 umfsl_scale_column
+#define UMF_set_stats		 umfsl_set_stats
+#define UMF_singletons		 umf_l_singletons
+#define UMF_solve		 umfsl_solve
+#define UMF_start_front		 umfsl_start_front
+#define UMF_store_lu		 umfsl_store_lu
+#define UMF_store_lu_drop	 umfsl_store_lu_drop
+#define UMF_symbolic_usage	 umfsl_symbolic_usage
+#define UMF_tuple_lengths	 umfsl_tuple_lengths
+#define UMF_usolve		 umfsl_usolve
+#define UMF_utsolve		 umfsl_utsolve
+#define UMF_uhsolve		 umfsl_uhsolve
+#define UMF_valid_numeric	 umfsl_valid_numeric
+#define UMF_valid_symbolic	 umfsl_valid_symbolic
+#define UMF_cholmod		 umf_l_cholmod
+
+#define UMFPACK_defaults	 umfpack_sl_defaults
+#define UMFPACK_free_numeric	 umfpack_sl_free_numeric
+#define UMFPACK_numeric		 umfpack_sl_numeric
+#define UMFPACK_numeric_fallback umfpack_sl_numeric_fallback
+#define UMFPACK_numeric_profile umfpack_sl_numeric_profile
+#define UMFPACK_solve		 umfpack_sl_solve
+
+/* double precision routines used for the fallback factorization: */
+#define UMFPACK_double_copy_symbolic  umfpack_dl_copy_symbolic
+#define UMFPACK_double_free_symbolic  umfpack_dl_free_symbolic
+#define UMFPACK_double_defaults       umfpack_dl_defaults
+#define UMFPACK_double_numeric        umfpack_dl_numeric
+#define UMFPACK_double_free_numeric   umfpack_dl_free_numeric
+#define UMFPACK_double_solve          umfpack_dl_solve
+
+/* for debugging only: */
+#define UMF_malloc_count	 umf_l_malloc_count
+#define UMF_debug		 umfsl_debug
+#define UMF_allocfail		 umfsl_allocfail
+#define UMF_gprob		 umfsl_gprob
+#define UMF_dump_dense		 umfsl_dump_dense
+#define UMF_dump_element	 umfsl_dump_element
+#define UMF_dump_rowcol		 umfsl_dump_rowcol
+#define UMF_dump_matrix		 umfsl_dump_matrix
+#define UMF_dump_current_front	 umfsl_dump_current_front
+#define UMF_dump_lu		 umfsl_dump_lu
+#define UMF_dump_memory		 umfsl_dump_memory
+#define UMF_dump_packed_memory	 umfsl_dump_packed_memory
+#define UMF_dump_col_matrix	 umfsl_dump_col_matrix
+#define UMF_dump_chain		 umfsl_dump_chain
+#define UMF_dump_start		 umfsl_dump_start
+#define UMF_dump_rowmerge	 umfsl_dump_rowmerge
+#define UMF_dump_diagonal_map	 umfsl_dump_diagonal_map
+
+#endif
@@ -80,6 +80,8 @@ int UMFPACK_copy_numeric
     Numeric->Rs       = (double *) NULL ;
     Numeric->Memory   = (Unit *) NULL ;
     Numeric->Upattern = (Int *) NULL ;
+    Numeric->wrapped  = FALSE ;
+    Numeric->Sparse   = (SparseSolveType *) NULL ;
 
     // umfpack_free_numeric can now be safely called if an error occurs
 
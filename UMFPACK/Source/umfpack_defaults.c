@@ -60,7 +60,11 @@ void UMFPACK_defaults
      UMFPACK_DEFAULT_STRATEGY_THRESH_NNZDIAG ;
 
     /* used in UMFPACK_*solve: */
+#ifdef SINGLE
+    Control [UMFPACK_IRSTEP] = UMFPACK_DEFAULT_IRSTEP_SINGLE ;
+#else
     Control [UMFPACK_IRSTEP] = UMFPACK_DEFAULT_IRSTEP ;
+#endif
 
     /* ---------------------------------------------------------------------- */
     /* compile-time settings: cannot be modified at run-time */
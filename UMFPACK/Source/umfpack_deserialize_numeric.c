@@ -11,6 +11,13 @@
     User-callable.  Loads a Numeric object from a serialized blob created by
     umfpack_*_serialize_numeric.
     Initial contribution by Will Kimmerer (MIT); revised by Tim Davis.
+
+    UMFPACK_deserialize_numeric copies each array from the blob into newly
+    allocated memory.  UMFPACK_deserialize_numeric_wrap allocates only the
+    small Numeric header, and points the arrays of the Numeric object into
+    the blob itself, so the blob can be a read-only memory-mapped file shared
+    by many processes.  The blob must then remain valid and unmodified until
+    the Numeric object is freed, and UMFPACK_free_numeric does not free it.
 */
 
 #include "umf_internal.h"
@@ -18,17 +25,30 @@
 #include "umf_malloc.h"
 #include "umf_free.h"
 
-// get a component of the Numeric object from the blob
+// get a component of the Numeric object from the blob: either copy it, or
+// point to it in place
 #define DESERIALIZE(object,type,n)                          \
 {                                                           \
-    object = (type *) UMF_malloc (n, sizeof (type)) ;       \
-    if (object == (type *) NULL)                            \
+    if (offset + (int64_t) ((n) * sizeof (type)) > required) \
     {                                                       \
 	UMFPACK_free_numeric ((void **) &Numeric) ;         \
-	return (UMFPACK_ERROR_out_of_memory) ;              \
+	return (UMFPACK_ERROR_invalid_blob) ;               \
+    }                                                       \
+    if (wrap)                                               \
+    {                                                       \
+        object = (type *) (blob + offset) ;                 \
+    }                                                       \
+    else                                                    \
+    {                                                       \
+        object = (type *) UMF_malloc (n, sizeof (type)) ;   \
+        if (object == (type *) NULL)                        \
+        {                                                   \
+            UMFPACK_free_numeric ((void **) &Numeric) ;     \
+            return (UMFPACK_ERROR_out_of_memory) ;          \
+        }                                                   \
+        memcpy (object, blob + offset, (n) * sizeof (type)) ; \
     }                                                       \
-    memcpy (object, blob + offset, (n) * sizeof (type)) ;   \
-    offset += (n) * sizeof (type) ;                         \
+    offset += UMF_BLOB_PAD ((n) * sizeof (type)) ;          \
 }
 
 // get a single scalar from the blob
@@ -42,14 +62,15 @@
     offset += sizeof (type) ;                               \
 
 //==============================================================================
-//==== UMFPACK_deserialize_numeric =============================================
+//==== deserialize_numeric =====================================================
 //==============================================================================
 
-int UMFPACK_deserialize_numeric
+PRIVATE int deserialize_numeric
 (
     void **NumericHandle,   // output: Numeric object created from the blob
     int8_t *blob,           // input: serialized blob, not modified
-    int64_t blobsize        // size of the blob in bytes
+    int64_t blobsize,       // size of the blob in bytes
+    int wrap                // if true, use the blob in place
 )
 {
 
@@ -66,6 +87,12 @@ int UMFPACK_deserialize_numeric
     (*NumericHandle) = (void *) NULL ;
     int64_t offset = 0 ;
 
+    if (wrap && (((uintptr_t) blob) % UMF_BLOB_START) != 0)
+    {
+        // the arrays in the blob would not be properly aligned
+        return (UMFPACK_ERROR_invalid_blob) ;
+    }
+
     // read the blob header:
     DESERIALIZE_SCALAR (int64_t, required) ;
     DESERIALIZE_SCALAR (int32_t, valid) ;
@@ -89,6 +116,11 @@ int UMFPACK_deserialize_numeric
     {
         return (UMFPACK_ERROR_invalid_blob) ;
     }
+    offset = UMF_BLOB_PAD (offset) ;
+    if (offset + (int64_t) sizeof (NumericType) > required)
+    {
+        return (UMFPACK_ERROR_invalid_blob) ;
+    }
 
     //--------------------------------------------------------------------------
     // read the Numeric header from the blob
@@ -100,7 +132,7 @@ int UMFPACK_deserialize_numeric
 	return (UMFPACK_ERROR_out_of_memory) ;
     }
     memcpy (Numeric, blob + offset, sizeof (NumericType)) ;
-    offset += sizeof (NumericType) ;
+    offset += UMF_BLOB_PAD (sizeof (NumericType)) ;
 
     if (Numeric->valid != NUMERIC_VALID || Numeric->n_row <= 0 ||
 	Numeric->n_col <= 0 || Numeric->npiv < 0 || Numeric->ulen < 0 ||
@@ -123,6 +155,8 @@ int UMFPACK_deserialize_numeric
     Numeric->Rs       = (double *) NULL ;
     Numeric->Memory   = (Unit *) NULL ;
     Numeric->Upattern = (Int *) NULL ;
+    Numeric->wrapped  = wrap ;
+    Numeric->Sparse   = (SparseSolveType *) NULL ;
 
     // UMFPACK_free_numeric can now be safely called if an error occurs
 
@@ -158,3 +192,32 @@ int UMFPACK_deserialize_numeric
     return (UMFPACK_OK) ;
 }
 
+//==============================================================================
+//==== UMFPACK_deserialize_numeric =============================================
+//==============================================================================
+
+int UMFPACK_deserialize_numeric
+(
+    void **NumericHandle,   // output: Numeric object created from the blob
+    int8_t *blob,           // input: serialized blob, not modified
+    int64_t blobsize        // size of the blob in bytes
+)
+{
+    return (deserialize_numeric (NumericHandle, blob, blobsize, FALSE)) ;
+}
+
+//==============================================================================
+//==== UMFPACK_deserialize_numeric_wrap ========================================
+//==============================================================================
+
+int UMFPACK_deserialize_numeric_wrap
+(
+    void **NumericHandle,   // output: Numeric object that uses the blob
+    const int8_t *blob,     // input: serialized blob, not modified
+    int64_t blobsize        // size of the blob in bytes
+)
+{
+    return (deserialize_numeric (NumericHandle, (int8_t *) blob, blobsize,
+        TRUE)) ;
+}
+
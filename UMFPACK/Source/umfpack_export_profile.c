@@ -0,0 +1,155 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source/umfpack_export_profile: write a Profile as JSON or CSV
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+/*
+    User-callable.  Writes the Profile computed by umfpack_*_numeric_profile
+    as JSON or CSV text, one line at a time, through a user callback.  See
+    umfpack.h for details.
+*/
+
+#include "umf_internal.h"
+
+/* scalar entries of the Profile, in the order they are written */
+static const struct
+{
+    const char *name ;
+    int index ;
+}
+Profile_entries [ ] =
+{
+    { "numeric_time",       UMFPACK_PROFILE_NUMERIC_TIME },
+    { "init_time",          UMFPACK_PROFILE_INIT_TIME },
+    { "pivot_search_time",  UMFPACK_PROFILE_PIVOT_SEARCH_TIME },
+    { "front_time",         UMFPACK_PROFILE_FRONT_TIME },
+    { "assemble_time",      UMFPACK_PROFILE_ASSEMBLE_TIME },
+    { "blas3_time",         UMFPACK_PROFILE_BLAS3_TIME },
+    { "store_lu_time",      UMFPACK_PROFILE_STORE_LU_TIME },
+    { "gc_time",            UMFPACK_PROFILE_GC_TIME },
+    { "wrapup_time",        UMFPACK_PROFILE_WRAPUP_TIME },
+    { "nfronts",            UMFPACK_PROFILE_NFRONTS },
+    { "nextend",            UMFPACK_PROFILE_NEXTEND },
+    { "ngrow",              UMFPACK_PROFILE_NGROW },
+    { "ngarbage",           UMFPACK_PROFILE_NGARBAGE },
+    { "nupdates",           UMFPACK_PROFILE_NUPDATES },
+    { "update_flops",       UMFPACK_PROFILE_UPDATE_FLOPS },
+    { "max_front_size",     UMFPACK_PROFILE_MAX_FRONT_SIZE },
+    { "max_update_nrows",   UMFPACK_PROFILE_MAX_UPDATE_NROWS },
+    { "max_update_ncols",   UMFPACK_PROFILE_MAX_UPDATE_NCOLS },
+    { "block_size",         UMFPACK_PROFILE_BLOCK_SIZE },
+    { "front_alloc_init",   UMFPACK_PROFILE_FRONT_ALLOC_INIT },
+    { "max_front_time",     UMFPACK_PROFILE_MAX_FRONT_TIME }
+} ;
+
+#define NENTRIES ((int) (sizeof (Profile_entries) / sizeof (Profile_entries [0])))
+
+/* histograms of the Profile */
+static const struct
+{
+    const char *name ;
+    int index ;
+}
+Profile_hists [ ] =
+{
+    { "update_k_hist",  UMFPACK_PROFILE_UPDATE_K_HIST },
+    { "update_mn_hist", UMFPACK_PROFILE_UPDATE_MN_HIST },
+    { "front_time_hist", UMFPACK_PROFILE_FRONT_TIME_HIST }
+} ;
+
+#define NHISTS ((int) (sizeof (Profile_hists) / sizeof (Profile_hists [0])))
+
+/* write one line of text, via the callback or the SuiteSparse printf */
+#define WRITE(text)                                         \
+{                                                           \
+    if (write_text != NULL)                                 \
+    {                                                       \
+        write_text (user_data, text) ;                      \
+    }                                                       \
+    else                                                    \
+    {                                                       \
+        PRINTF (("%s", text)) ;                             \
+    }                                                       \
+}
+
+int umfpack_export_profile
+(
+    const double Profile [UMFPACK_PROFILE],
+    int format,
+    void (*write_text) (void *user_data, const char *text),
+    void *user_data
+)
+{
+    char line [256] ;
+    int k, h, b ;
+
+    if (Profile == NULL
+        || (format != UMFPACK_PROFILE_CSV && format != UMFPACK_PROFILE_JSON))
+    {
+        return (UMFPACK_ERROR_argument_missing) ;
+    }
+
+    if (format == UMFPACK_PROFILE_CSV)
+    {
+
+        //----------------------------------------------------------------------
+        // CSV: one name,value pair per line
+        //----------------------------------------------------------------------
+
+        WRITE ("name,value\n") ;
+        for (k = 0 ; k < NENTRIES ; k++)
+        {
+            snprintf (line, sizeof (line), "%s,%.17g\n",
+                Profile_entries [k].name,
+                Profile [Profile_entries [k].index]) ;
+            WRITE (line) ;
+        }
+        for (h = 0 ; h < NHISTS ; h++)
+        {
+            for (b = 0 ; b < UMFPACK_PROFILE_NHIST ; b++)
+            {
+                snprintf (line, sizeof (line), "%s_%d,%.17g\n",
+                    Profile_hists [h].name, b,
+                    Profile [Profile_hists [h].index + b]) ;
+                WRITE (line) ;
+            }
+        }
+
+    }
+    else
+    {
+
+        //----------------------------------------------------------------------
+        // JSON: a single object
+        //----------------------------------------------------------------------
+
+        WRITE ("{\n") ;
+        for (k = 0 ; k < NENTRIES ; k++)
+        {
+            snprintf (line, sizeof (line), "  \"%s\": %.17g,\n",
+                Profile_entries [k].name,
+                Profile [Profile_entries [k].index]) ;
+            WRITE (line) ;
+        }
+        for (h = 0 ; h < NHISTS ; h++)
+        {
+            snprintf (line, sizeof (line), "  \"%s\": [",
+                Profile_hists [h].name) ;
+            WRITE (line) ;
+            for (b = 0 ; b < UMFPACK_PROFILE_NHIST ; b++)
+            {
+                snprintf (line, sizeof (line), "%s%.17g", (b > 0) ? ", " : "",
+                    Profile [Profile_hists [h].index + b]) ;
+                WRITE (line) ;
+            }
+            WRITE ((h < NHISTS - 1) ? "],\n" : "]\n") ;
+        }
+        WRITE ("}\n") ;
+    }
+
+    return (UMFPACK_OK) ;
+}
@@ -31,6 +31,18 @@ void UMFPACK_free_numeric
 	return ;
     }
 
+    /* the factors kept by UMFPACK_solve_sparse_setup, if present */
+    (void) UMF_free ((void *) Numeric->Sparse) ;
+
+    if (Numeric->wrapped)
+    {
+	/* the arrays are owned by the blob passed to
+	 * UMFPACK_deserialize_numeric_wrap; free just the header */
+	(void) UMF_free ((void *) Numeric) ;
+	*NumericHandle = (void *) NULL ;
+	return ;
+    }
+
     /* these 9 objects always exist */
     (void) UMF_free ((void *) Numeric->D) ;
     (void) UMF_free ((void *) Numeric->Rperm) ;
@@ -48,6 +60,12 @@ void UMFPACK_free_numeric
     /* Upattern can only exist for singular or rectangular matrices */
     (void) UMF_free ((void *) Numeric->Upattern) ;
 
+#ifdef SINGLE
+    /* the Symbolic copy and the double precision fallback, if present */
+    UMFPACK_double_free_symbolic (&(Numeric->Symbolic)) ;
+    UMFPACK_double_free_numeric (&(Numeric->Fallback)) ;
+#endif
+
     /* these 2 objects always exist */
     (void) UMF_free ((void *) Numeric->Memory) ;
     (void) UMF_free ((void *) Numeric) ;
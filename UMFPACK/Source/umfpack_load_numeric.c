@@ -119,6 +119,8 @@ int UMFPACK_load_numeric
     Numeric->Rs       = (double *) NULL ;
     Numeric->Memory   = (Unit *) NULL ;
     Numeric->Upattern = (Int *) NULL ;
+    Numeric->wrapped  = FALSE ;
+    Numeric->Sparse   = (SparseSolveType *) NULL ;
 
     /* umfpack_free_numeric can now be safely called if an error occurs */
 
@@ -73,6 +73,37 @@ int UMFPACK_numeric
     const double Control [UMFPACK_CONTROL],
     double User_Info [UMFPACK_INFO]
 )
+{
+    return (UMFPACK_numeric_profile (Ap, Ai, Ax,
+#ifdef COMPLEX
+	Az,
+#endif
+	SymbolicHandle, NumericHandle, Control, User_Info,
+	(double *) NULL)) ;
+}
+
+
+/* ========================================================================== */
+/* === UMFPACK_numeric_profile ============================================== */
+/* ========================================================================== */
+
+/* Same as UMFPACK_numeric, except that a profile of the factorization is
+ * returned in Profile, if present. */
+
+int UMFPACK_numeric_profile
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    void *SymbolicHandle,
+    void **NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO],
+    double Profile [UMFPACK_PROFILE]
+)
 {
 
     /* ---------------------------------------------------------------------- */
@@ -94,6 +125,14 @@ int UMFPACK_numeric
 
     umfpack_tic (stats) ;
 
+    if (Profile != (double *) NULL)
+    {
+	for (i = 0 ; i < UMFPACK_PROFILE ; i++)
+	{
+	    Profile [i] = 0 ;
+	}
+    }
+
     /* ---------------------------------------------------------------------- */
     /* initialize and check inputs */
     /* ---------------------------------------------------------------------- */
@@ -214,6 +253,8 @@ int UMFPACK_numeric
      */
 
     Work = &WorkSpace ;
+    Work->Profile = Profile ;
+    Work->profile_charged = 0 ;
     Work->n_row = n_row ;
     Work->n_col = n_col ;
     Work->nfr = Symbolic->nfr ;
@@ -508,6 +549,19 @@ int UMFPACK_numeric
 	+ (ulen > 0)			    /* Numeric->Upattern */
 	+ (scale != UMFPACK_SCALE_NONE)) ;  /* Numeric->Rs */
 
+#ifdef SINGLE
+    /* keep a copy of the Symbolic object, in case the solve needs to fall
+     * back to a double precision factorization of A */
+    if (UMFPACK_double_copy_symbolic (&(Numeric->Symbolic), SymbolicHandle)
+	!= UMFPACK_OK)
+    {
+	DEBUGm4 (("out of memory: Symbolic copy\n")) ;
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_out_of_memory ;
+	UMFPACK_free_numeric (NumericHandle) ;
+	return (UMFPACK_ERROR_out_of_memory) ;
+    }
+#endif
+
     /* ---------------------------------------------------------------------- */
     /* get the time used by UMFPACK_numeric */
     /* ---------------------------------------------------------------------- */
@@ -516,6 +570,13 @@ int UMFPACK_numeric
     Info [UMFPACK_NUMERIC_WALLTIME] = stats [0] ;
     Info [UMFPACK_NUMERIC_TIME] = stats [1] ;
 
+    if (Profile != (double *) NULL)
+    {
+	Profile [UMFPACK_PROFILE_NUMERIC_TIME] = stats [0] ;
+	Profile [UMFPACK_PROFILE_BLOCK_SIZE] = Symbolic->nb ;
+	Profile [UMFPACK_PROFILE_FRONT_ALLOC_INIT] = front_alloc_init ;
+    }
+
     /* return UMFPACK_OK or UMFPACK_WARNING_singular_matrix */
     return (status) ;
 
@@ -556,6 +617,12 @@ PRIVATE Int numeric_alloc
 	return (FALSE) ;	/* out of memory */
     }
     Numeric->valid = 0 ;
+    Numeric->wrapped = FALSE ;
+    Numeric->Sparse = (SparseSolveType *) NULL ;
+#ifdef SINGLE
+    Numeric->Symbolic = (void *) NULL ;
+    Numeric->Fallback = (void *) NULL ;
+#endif
     *NumericHandle = Numeric ;
 
     /* 9 allocations:  accounted for in UMF_set_stats (num_On_size1),
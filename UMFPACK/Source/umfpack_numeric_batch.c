@@ -0,0 +1,219 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source/umfpack_numeric_batch: factorize many matrices of one pattern
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+/*
+    User-callable.  Factorizes a batch of matrices A_0, ..., A_{nbatch-1} that
+    all have the same nonzero pattern (Ap, Ai), such as K + i*w*C for a sweep
+    over the frequency w, using a single Symbolic object.  Optionally solves
+    A_k x_k = b_k for each matrix.  See umfpack.h for more details.
+
+    UMFPACK_numeric does not modify the Symbolic object and uses no global
+    state, so the factorizations can be done in parallel.  If UMFPACK is
+    compiled with OpenMP, up to nthreads factorizations are in progress at any
+    one time, limited further so that their estimated peak memory usage
+    (Info [UMFPACK_PEAK_MEMORY_ESTIMATE] from UMFPACK_*symbolic, each) does
+    not exceed memory_limit bytes.  Each factorization is itself sequential,
+    apart from any parallelism in the BLAS.
+
+    Dynamic memory usage:  that of UMFPACK_numeric (and UMFPACK_solve, if b is
+    present) for each factorization in progress.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_symbolic.h"
+#include "umf_set_stats.h"
+
+int UMFPACK_numeric_batch
+(
+    Int nbatch,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+#ifdef COMPLEX
+    const double Az [ ],
+#endif
+    void *SymbolicHandle,
+    void *NumericHandles [ ],
+    double Xx [ ],
+#ifdef COMPLEX
+    double Xz [ ],
+#endif
+    const double Bx [ ],
+#ifdef COMPLEX
+    const double Bz [ ],
+#endif
+    int nthreads,
+    double memory_limit,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [ ]
+)
+{
+
+    /* ---------------------------------------------------------------------- */
+    /* local variables */
+    /* ---------------------------------------------------------------------- */
+
+    SymbolicType *Symbolic ;
+    Int n, nz, k, first_error, first_warning ;
+    size_t anz, bn, xn ;
+    int error_status, warning_status, nth ;
+#ifdef COMPLEX
+    Int asplit = SPLIT (Az) ;
+    Int bsplit = SPLIT (Bz) ;
+    Int xsplit = SPLIT (Xz) ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    Symbolic = (SymbolicType *) SymbolicHandle ;
+    if (!UMF_valid_symbolic (Symbolic))
+    {
+	return (UMFPACK_ERROR_invalid_Symbolic_object) ;
+    }
+    if (!Ap || !Ai || !Ax || (!NumericHandles && !Xx) || (Xx && !Bx))
+    {
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+    if (nbatch < 0)
+    {
+	return (UMFPACK_ERROR_n_nonpositive) ;
+    }
+    n = Symbolic->n_col ;
+    if (Xx != (double *) NULL && Symbolic->n_row != n)
+    {
+	/* only square systems can be solved */
+	return (UMFPACK_ERROR_invalid_system) ;
+    }
+    if (NumericHandles != (void **) NULL)
+    {
+	for (k = 0 ; k < nbatch ; k++)
+	{
+	    NumericHandles [k] = (void *) NULL ;
+	}
+    }
+    nz = Ap [n] ;
+    if (nz < 0)
+    {
+	return (UMFPACK_ERROR_invalid_matrix) ;
+    }
+
+    /* offsets of the kth matrix in Ax and Az, and of b_k and x_k, in size_t
+     * since the offsets can exceed the range of Int */
+#ifdef COMPLEX
+    anz = (asplit ? 1 : 2) * ((size_t) nz) ;
+    bn = (bsplit ? 1 : 2) * ((size_t) n) ;
+    xn = (xsplit ? 1 : 2) * ((size_t) n) ;
+#else
+    anz = nz ;
+    bn = n ;
+    xn = n ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* determine the number of factorizations to do at the same time */
+    /* ---------------------------------------------------------------------- */
+
+    nth = 1 ;
+#ifdef _OPENMP
+    nth = (nthreads > 0) ? nthreads : SUITESPARSE_OPENMP_MAX_THREADS ;
+    nth = MIN (nth, nbatch) ;
+    if (memory_limit > 0 && nth > 1)
+    {
+	/* estimated peak memory usage of one UMFPACK_numeric, in Units */
+	double Info2 [UMFPACK_INFO], peak ;
+	Int n_inner = MIN (Symbolic->n_row, Symbolic->n_col) ;
+	UMF_set_stats (Info2, Symbolic,
+	    Symbolic->num_mem_usage_est, Symbolic->num_mem_size_est, 0, 0, 0,
+	    ((double) Symbolic->maxnrows) * ((double) Symbolic->maxncols),
+	    (double) Symbolic->n_col, (double) n_inner,
+	    (double) Symbolic->maxnrows, (double) Symbolic->maxncols,
+	    TRUE, Symbolic->prefer_diagonal, ESTIMATE) ;
+	peak = Info2 [UMFPACK_PEAK_MEMORY_ESTIMATE] * sizeof (Unit) ;
+	if (peak > 0 && memory_limit / peak < nth)
+	{
+	    nth = (int) MAX (1, floor (memory_limit / peak)) ;
+	}
+    }
+    nth = MAX (nth, 1) ;
+#endif
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize each matrix, and solve if requested */
+    /* ---------------------------------------------------------------------- */
+
+    first_error = nbatch ;
+    first_warning = nbatch ;
+    error_status = UMFPACK_OK ;
+    warning_status = UMFPACK_OK ;
+
+    #pragma omp parallel for num_threads(nth) schedule(dynamic,1)
+    for (k = 0 ; k < nbatch ; k++)
+    {
+	double Info3 [UMFPACK_INFO], *Info ;
+	void *Numeric = (void *) NULL ;
+	int status ;
+
+	Info = (User_Info != (double *) NULL) ?
+	    (User_Info + ((size_t) k) * UMFPACK_INFO) : Info3 ;
+
+	status = UMFPACK_numeric (Ap, Ai, Ax + ((size_t) k) * anz,
+#ifdef COMPLEX
+	    asplit ? (Az + ((size_t) k) * anz) : (double *) NULL,
+#endif
+	    SymbolicHandle, &Numeric, Control, Info) ;
+
+	if (status >= UMFPACK_OK && Xx != (double *) NULL)
+	{
+	    status = UMFPACK_solve (UMFPACK_A, Ap, Ai, Ax + ((size_t) k) * anz,
+#ifdef COMPLEX
+		asplit ? (Az + ((size_t) k) * anz) : (double *) NULL,
+		Xx + ((size_t) k) * xn,
+		xsplit ? (Xz + ((size_t) k) * n) : (double *) NULL,
+		Bx + ((size_t) k) * bn,
+		bsplit ? (Bz + ((size_t) k) * n) : (double *) NULL,
+#else
+		Xx + ((size_t) k) * xn,
+		Bx + ((size_t) k) * bn,
+#endif
+		Numeric, Control, Info) ;
+	}
+
+	if (NumericHandles != (void **) NULL && status >= UMFPACK_OK)
+	{
+	    NumericHandles [k] = Numeric ;
+	}
+	else
+	{
+	    UMFPACK_free_numeric (&Numeric) ;
+	}
+
+	if (status != UMFPACK_OK)
+	{
+	    #pragma omp critical (umfpack_numeric_batch)
+	    {
+		/* keep the status of the first matrix that failed, or if none
+		 * failed, of the first that gave a warning */
+		if (status < UMFPACK_OK && k < first_error)
+		{
+		    first_error = k ;
+		    error_status = status ;
+		}
+		else if (status > UMFPACK_OK && k < first_warning)
+		{
+		    first_warning = k ;
+		    warning_status = status ;
+		}
+	    }
+	}
+    }
+
+    return ((error_status != UMFPACK_OK) ? error_status : warning_status) ;
+}
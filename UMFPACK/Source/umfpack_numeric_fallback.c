@@ -0,0 +1,83 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source/umfpack_numeric_fallback: double precision factors of A
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+/*
+    User-callable.  For single precision LU factors only (umfpack_s*_*).
+    Computes the double precision factorization of A that umfpack_s*_solve
+    uses when iterative refinement with the single precision factors does not
+    converge, and keeps it in the Numeric object.  The factorization uses the
+    copy of the Symbolic object kept in the Numeric object, and the same
+    numerical parameters as the single precision factorization.  Does nothing
+    if the Numeric object already holds a double precision factorization.
+
+    This is the only routine that modifies a single precision Numeric object
+    once umfpack_s*_numeric has returned, so that concurrent calls to
+    umfpack_s*_solve with the same Numeric object are safe.
+
+    Dynamic memory usage:  the same as umfpack_d*_numeric.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_numeric.h"
+
+int UMFPACK_numeric_fallback
+(
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+    void *NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO]
+)
+{
+    double Control2 [UMFPACK_CONTROL], Info2 [UMFPACK_INFO], *Info ;
+    NumericType *Numeric ;
+    int status ;
+
+    /* ---------------------------------------------------------------------- */
+    /* check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    Info = (User_Info != (double *) NULL) ? User_Info : Info2 ;
+    UMFPACK_double_defaults (Control2) ;
+    Control2 [UMFPACK_PRL] = GET_CONTROL (UMFPACK_PRL, UMFPACK_DEFAULT_PRL) ;
+
+    Numeric = (NumericType *) NumericHandle ;
+    if (!UMF_valid_numeric (Numeric) || Numeric->Symbolic == (void *) NULL)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_Numeric_object ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    if (Numeric->Fallback != (void *) NULL)
+    {
+	/* the double precision factorization already exists */
+	Info [UMFPACK_STATUS] = UMFPACK_OK ;
+	return (UMFPACK_OK) ;
+    }
+
+    if (!Ap || !Ai || !Ax)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_argument_missing ;
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* factorize A in double precision */
+    /* ---------------------------------------------------------------------- */
+
+    Control2 [UMFPACK_PIVOT_TOLERANCE] = Numeric->relpt ;
+    Control2 [UMFPACK_SYM_PIVOT_TOLERANCE] = Numeric->relpt2 ;
+    Control2 [UMFPACK_DROPTOL] = Numeric->droptol ;
+    Control2 [UMFPACK_SCALE] = Numeric->scale ;
+    Control2 [UMFPACK_FRONT_ALLOC_INIT] = Numeric->front_alloc_init ;
+    status = UMFPACK_double_numeric (Ap, Ai, Ax, Numeric->Symbolic,
+	&(Numeric->Fallback), Control2, Info) ;
+    return (status) ;
+}
@@ -44,36 +44,38 @@ int UMFPACK_serialize_numeric_size
 	return (UMFPACK_ERROR_invalid_Numeric_object) ;
     }
 
+    // each component is padded to a multiple of UMF_BLOB_ALIGN bytes
+
     // blob header
-    (*blobsize) += sizeof (int64_t) + 10 * sizeof (int32_t) ;
+    (*blobsize) += UMF_BLOB_PAD (sizeof (int64_t) + 10 * sizeof (int32_t)) ;
 
     // Numeric header struct:
-    (*blobsize) += sizeof (NumericType) ;
+    (*blobsize) += UMF_BLOB_PAD (sizeof (NumericType)) ;
 
     // Lpos, Lilen, Lip, Upos, Uilen, and Uip:
-    (*blobsize) += 6*(Numeric->npiv+1) * sizeof (Int) ;
+    (*blobsize) += 6 * UMF_BLOB_PAD ((Numeric->npiv+1) * sizeof (Int)) ;
 
     // Rperm and Cperm:
-    (*blobsize) += (Numeric->n_row+1) * sizeof (Int) ;
-    (*blobsize) += (Numeric->n_col+1) * sizeof (Int) ;
+    (*blobsize) += UMF_BLOB_PAD ((Numeric->n_row+1) * sizeof (Int)) ;
+    (*blobsize) += UMF_BLOB_PAD ((Numeric->n_col+1) * sizeof (Int)) ;
 
     // D:
     Int n_inner = MIN (Numeric->n_row, Numeric->n_col) ;
-    (*blobsize) += (n_inner+1) * sizeof (Entry) ;
+    (*blobsize) += UMF_BLOB_PAD ((n_inner+1) * sizeof (Entry)) ;
 
     // Rs, if present:
     if (Numeric->scale != UMFPACK_SCALE_NONE)
     {
-        (*blobsize) += (Numeric->n_row) * sizeof (double) ;
+        (*blobsize) += UMF_BLOB_PAD ((Numeric->n_row) * sizeof (double)) ;
     }
     // Upattern, if present:
     if (Numeric->ulen > 0)
     {
-        (*blobsize) += (Numeric->ulen+1) * sizeof (Int) ;
+        (*blobsize) += UMF_BLOB_PAD ((Numeric->ulen+1) * sizeof (Int)) ;
     }
 
     // Numeric->Memory
-    (*blobsize) += (Numeric->size) * sizeof (Unit) ;
+    (*blobsize) += UMF_BLOB_PAD ((Numeric->size) * sizeof (Unit)) ;
 
     return (UMFPACK_OK) ;
 }
@@ -88,6 +90,21 @@ int UMFPACK_serialize_numeric_size
     offset += (n) * sizeof (type) ;                         \
 }
 
+// zero-fill the blob up to the next multiple of UMF_BLOB_ALIGN bytes
+#define SERIALIZE_PAD                                       \
+{                                                           \
+    int64_t padded = UMF_BLOB_PAD (offset) ;                \
+    memset (blob + offset, 0, padded - offset) ;            \
+    offset = padded ;                                       \
+}
+
+// write one array of the Numeric object, then pad it
+#define SERIALIZE_ARRAY(object, type, n)                    \
+{                                                           \
+    SERIALIZE (object, type, n) ;                           \
+    SERIALIZE_PAD ;                                         \
+}
+
 #define SERIALIZE_INT32(x)                                  \
 {                                                           \
     int32_t scalar = (int32_t) (x) ;                        \
@@ -137,33 +154,34 @@ int UMFPACK_serialize_numeric
     SERIALIZE_INT32 (sizeof (Unit)) ;
     SERIALIZE_INT32 (sizeof (double)) ;
     SERIALIZE_INT32 (sizeof (void *)) ;         // 32-bit vs 64-bit OS
+    SERIALIZE_PAD ;
 
     // write the Numeric object to the blob
     Int n_inner = MIN (Numeric->n_row, Numeric->n_col) ;
-    SERIALIZE (Numeric,             NumericType, 1) ;
-    SERIALIZE (Numeric->D,          Entry, n_inner+1) ;
-    SERIALIZE (Numeric->Rperm,      Int, Numeric->n_row+1) ;
-    SERIALIZE (Numeric->Cperm,      Int, Numeric->n_col+1) ;
-    SERIALIZE (Numeric->Lpos,       Int, Numeric->npiv+1) ;
-    SERIALIZE (Numeric->Lilen,      Int, Numeric->npiv+1) ;
-    SERIALIZE (Numeric->Lip,        Int, Numeric->npiv+1) ;
-    SERIALIZE (Numeric->Upos,       Int, Numeric->npiv+1) ;
-    SERIALIZE (Numeric->Uilen,      Int, Numeric->npiv+1) ;
-    SERIALIZE (Numeric->Uip,        Int, Numeric->npiv+1) ;
+    SERIALIZE_ARRAY (Numeric,           NumericType, 1) ;
+    SERIALIZE_ARRAY (Numeric->D,        Entry, n_inner+1) ;
+    SERIALIZE_ARRAY (Numeric->Rperm,    Int, Numeric->n_row+1) ;
+    SERIALIZE_ARRAY (Numeric->Cperm,    Int, Numeric->n_col+1) ;
+    SERIALIZE_ARRAY (Numeric->Lpos,     Int, Numeric->npiv+1) ;
+    SERIALIZE_ARRAY (Numeric->Lilen,    Int, Numeric->npiv+1) ;
+    SERIALIZE_ARRAY (Numeric->Lip,      Int, Numeric->npiv+1) ;
+    SERIALIZE_ARRAY (Numeric->Upos,     Int, Numeric->npiv+1) ;
+    SERIALIZE_ARRAY (Numeric->Uilen,    Int, Numeric->npiv+1) ;
+    SERIALIZE_ARRAY (Numeric->Uip,      Int, Numeric->npiv+1) ;
     if (Numeric->scale != UMFPACK_SCALE_NONE)
     {
 	/* only when dense rows are present */
-	SERIALIZE (Numeric->Rs, double, Numeric->n_row) ;
+	SERIALIZE_ARRAY (Numeric->Rs, double, Numeric->n_row) ;
     }
     if (Numeric->ulen > 0)
     {
 	/* only when diagonal pivoting is prefered */
-	SERIALIZE (Numeric->Upattern, Int, Numeric->ulen+1) ;
+	SERIALIZE_ARRAY (Numeric->Upattern, Int, Numeric->ulen+1) ;
     }
     /* It is possible that some parts of Numeric->Memory are
        unitialized and unused; this is OK, but it can generate
        a valgrind warning. */
-    SERIALIZE (Numeric->Memory, Unit, Numeric->size) ;
+    SERIALIZE_ARRAY (Numeric->Memory, Unit, Numeric->size) ;
 
     return (UMFPACK_OK) ;
 }
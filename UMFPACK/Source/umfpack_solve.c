@@ -25,6 +25,16 @@
     solved, and the matrix A is not singular, then c is 5 for the real version
     and 10 for the complex version.  Otherwise, c is 1 for the real version and
     4 for the complex version.
+
+    For umfpack_s*_solve (single precision LU factors):
+	c is 6 if iterative refinement is done, and 1 otherwise.  If the
+	single precision solve fails to reach a small backward error (or if
+	the single precision factors are singular), the system is solved with
+	the double precision factors kept by UMFPACK_numeric_fallback, or, if
+	there are none, with a temporary double precision factorization that
+	is freed on return.  The Numeric object is not modified, so concurrent
+	solves with the same Numeric object are safe.  There is no
+	umfpack_s*_wsolve.
 */
 
 #include "umf_internal.h"
@@ -39,6 +49,25 @@ PRIVATE Int init_count ;
 #endif
 #endif
 
+#if defined (SINGLE) && defined (WSOLVE)
+#error "umfpack_wsolve is not available for single precision LU factors"
+#endif
+
+#ifdef SINGLE
+PRIVATE int solve_double
+(
+    int sys,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+    double Xx [ ],
+    const double Bx [ ],
+    NumericType *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+) ;
+#endif
+
 int
 #ifdef WSOLVE
 UMFPACK_wsolve
@@ -78,6 +107,9 @@ UMFPACK_solve
     double *Info ;
     NumericType *Numeric ;
     Int n, i, irstep, status ;
+#ifdef SINGLE
+    Int refine ;
+#endif
 #ifndef WSOLVE
     Int *Pattern, wsize ;
     double *W ;
@@ -99,7 +131,11 @@ UMFPACK_solve
     /* get parameters */
     /* ---------------------------------------------------------------------- */
 
+#ifdef SINGLE
+    irstep = GET_CONTROL (UMFPACK_IRSTEP, UMFPACK_DEFAULT_IRSTEP_SINGLE) ;
+#else
     irstep = GET_CONTROL (UMFPACK_IRSTEP, UMFPACK_DEFAULT_IRSTEP) ;
+#endif
 
     if (User_Info != (double *) NULL)
     {
@@ -141,6 +177,20 @@ UMFPACK_solve
 	return (UMFPACK_ERROR_invalid_system) ;
     }
     n = Numeric->n_row ;
+
+#ifdef SINGLE
+    /* the fallback applies only if refinement is requested for A x = b,
+     * A' x = b, or A.' x = b */
+    refine = (sys < UMFPACK_Pt_L && irstep > 0) ;
+    Info [UMFPACK_FALLBACK_TO_DOUBLE] = 0 ;
+    if (Numeric->Fallback != (void *) NULL && refine)
+    {
+	/* UMFPACK_numeric_fallback has factorized A in double precision */
+	return (solve_double (sys, Ap, Ai, Ax, Xx, Bx, Numeric, Control,
+	    Info)) ;
+    }
+#endif
+
     if (Numeric->nnzpiv < n
 	|| SCALAR_IS_ZERO (Numeric->rcond) || SCALAR_IS_NAN (Numeric->rcond))
     {
@@ -184,6 +234,15 @@ UMFPACK_solve
     {
 	wsize = 4*n ;		/* W, X */
     }
+#elif defined (SINGLE)
+    if (irstep > 0)
+    {
+	wsize = 6*n ;		/* W, R, S, Y, B2, Z2 */
+    }
+    else
+    {
+	wsize = n ;		/* W */
+    }
 #else
     if (irstep > 0)
     {
@@ -228,6 +287,21 @@ UMFPACK_solve
     ASSERT (UMF_malloc_count == init_count) ;
 #endif
 
+#ifdef SINGLE
+    /* ---------------------------------------------------------------------- */
+    /* refactorize in double precision if the single precision solve failed */
+    /* ---------------------------------------------------------------------- */
+
+    if (refine && (status == UMFPACK_WARNING_singular_matrix ||
+	!(Info [UMFPACK_OMEGA1] + Info [UMFPACK_OMEGA2]
+	<= UMF_SINGLE_OMEGA_TOL)))
+    {
+	DEBUGm4 (("single precision solve did not converge, use double\n")) ;
+	return (solve_double (sys, Ap, Ai, Ax, Xx, Bx, Numeric, Control,
+	    Info)) ;
+    }
+#endif
+
     /* ---------------------------------------------------------------------- */
     /* get the time used by UMFPACK_*solve */
     /* ---------------------------------------------------------------------- */
@@ -242,3 +316,73 @@ UMFPACK_solve
 
     return (status) ;
 }
+
+
+#ifdef SINGLE
+
+/* ========================================================================== */
+/* === solve_double ========================================================= */
+/* ========================================================================== */
+
+/* Solve the system with a double precision factorization of A.  If
+ * umfpack_s*_numeric_fallback has kept one in the Numeric object, it is used.
+ * Otherwise a temporary one is computed, with the Symbolic object and the
+ * numerical parameters of the single precision factorization, and freed
+ * before returning.  The Numeric object is never modified. */
+
+PRIVATE int solve_double
+(
+    int sys,
+    const Int Ap [ ],
+    const Int Ai [ ],
+    const double Ax [ ],
+    double Xx [ ],
+    const double Bx [ ],
+    NumericType *Numeric,
+    const double Control [UMFPACK_CONTROL],
+    double Info [UMFPACK_INFO]
+)
+{
+    double Control2 [UMFPACK_CONTROL], Info2 [UMFPACK_INFO] ;
+    void *Fallback ;
+    int status ;
+
+    UMFPACK_double_defaults (Control2) ;
+    Control2 [UMFPACK_PRL] = GET_CONTROL (UMFPACK_PRL, UMFPACK_DEFAULT_PRL) ;
+    Control2 [UMFPACK_IRSTEP] =
+	GET_CONTROL (UMFPACK_IRSTEP, UMFPACK_DEFAULT_IRSTEP) ;
+
+    if (Numeric->Fallback != (void *) NULL)
+    {
+	status = UMFPACK_double_solve (sys, Ap, Ai, Ax, Xx, Bx,
+	    Numeric->Fallback, Control2, Info) ;
+	Info [UMFPACK_FALLBACK_TO_DOUBLE] = 1 ;
+	return (status) ;
+    }
+
+    if (!Ap || !Ai || !Ax)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_argument_missing ;
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+    Control2 [UMFPACK_PIVOT_TOLERANCE] = Numeric->relpt ;
+    Control2 [UMFPACK_SYM_PIVOT_TOLERANCE] = Numeric->relpt2 ;
+    Control2 [UMFPACK_DROPTOL] = Numeric->droptol ;
+    Control2 [UMFPACK_SCALE] = Numeric->scale ;
+    Control2 [UMFPACK_FRONT_ALLOC_INIT] = Numeric->front_alloc_init ;
+    Fallback = (void *) NULL ;
+    status = UMFPACK_double_numeric (Ap, Ai, Ax, Numeric->Symbolic,
+	&Fallback, Control2, Info2) ;
+    if (status < UMFPACK_OK)
+    {
+	Info [UMFPACK_STATUS] = status ;
+	return (status) ;
+    }
+
+    status = UMFPACK_double_solve (sys, Ap, Ai, Ax, Xx, Bx, Fallback,
+	Control2, Info) ;
+    UMFPACK_double_free_numeric (&Fallback) ;
+    Info [UMFPACK_FALLBACK_TO_DOUBLE] = 2 ;
+    return (status) ;
+}
+#endif
@@ -0,0 +1,779 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source/umfpack_solve_sparse: solve Ax=b with a sparse b
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+//------------------------------------------------------------------------------
+
+/*
+    User-callable.  Solves Ax=b where b is sparse, and returns x as a sparse
+    vector, using the numerical factorization computed by UMFPACK_numeric.
+    See umfpack.h for more details.
+
+    The LU factors in the Numeric object are held in a compressed chained
+    form that must be traversed from the start of each chain, so they cannot
+    be used to find the nonzero pattern of x.  UMFPACK_solve_sparse_setup
+    extracts L and U in compressed-column form (and the patterns of L and U
+    in compressed-row form) with UMFPACK_get_numeric, and keeps them in
+    Numeric->Sparse, which is freed by UMFPACK_free_numeric.  The setup must
+    be done before UMFPACK_solve_sparse is called; building the column form
+    takes O(lnz+unz) time, which would defeat the purpose of a sparse solve
+    if it were done for each b.  UMFPACK_solve_sparse never modifies the
+    Numeric object.
+
+    With x = Q (U \ (L \ (P R b))), the nonzero pattern of y = L \ (P R b) is
+    the set of nodes reachable from the pattern of P R b in the graph of L,
+    and the pattern of x is the set reachable from the pattern of y in the
+    graph of U (Gilbert and Peierls).  Both are found by depth-first search,
+    which also gives a topological order for the two sparse triangular
+    solves.  The time taken is proportional to the number of floating-point
+    operations, plus the size of b.
+
+    If only some entries of x are requested (Out is present), the solve is
+    restricted further to the nodes of the reach that the requested entries
+    depend on.  These are found by a depth-first search from the requested
+    entries in the transposed graphs of U and then L, limited to the nodes
+    already reached from b.
+
+    The O(n) workspace is provided by the caller, so that concurrent solves
+    with the same Numeric object are safe.  Its first 4*n integers hold marks
+    that are zero on input, and they are cleared again before returning, in
+    time proportional to the number of nodes visited.
+
+    Dynamic memory usage:  UMFPACK_solve_sparse_setup allocates about
+    lnz + unz entries plus 2*(lnz + unz) + 7*n integers.  UMFPACK_solve_sparse
+    allocates no memory.
+*/
+
+#include "umf_internal.h"
+#include "umf_valid_numeric.h"
+#include "umf_malloc.h"
+#include "umf_free.h"
+
+PRIVATE Int build_sparse
+(
+    NumericType *Numeric,
+    SparseSolveType **SparseHandle
+) ;
+
+PRIVATE Int reach
+(
+    Int top,
+    Int start,
+    const Int Gp [ ],
+    const Int Gi [ ],
+    Int Mark [ ],
+    Int stamp,
+    const Int Allowed [ ],
+    Int List [ ],
+    Int Stack [ ],
+    Int Pstack [ ]
+) ;
+
+/* ========================================================================== */
+/* === UMFPACK_solve_sparse ================================================= */
+/* ========================================================================== */
+
+int UMFPACK_solve_sparse
+(
+    int sys,
+    Int bnz,
+    const Int Bi [ ],
+    const double Bx [ ],
+#ifdef COMPLEX
+    const double Bz [ ],
+#endif
+    Int nout,
+    const Int Out [ ],
+    Int *xnz,
+    Int Xi [ ],
+    double Xx [ ],
+#ifdef COMPLEX
+    double Xz [ ],
+#endif
+    void *NumericHandle,
+    const double Control [UMFPACK_CONTROL],
+    double User_Info [UMFPACK_INFO],
+    Int Wi [ ],
+    double W [ ]
+)
+{
+
+    /* ---------------------------------------------------------------------- */
+    /* local variables */
+    /* ---------------------------------------------------------------------- */
+
+    double Info2 [UMFPACK_INFO], stats [2], flops ;
+    double *Info, *Rs ;
+    Entry *Y, *Lx, *Ux, *D, bk ;
+    NumericType *Numeric ;
+    SparseSolveType *Sparse ;
+    Int *Lp, *Li, *Up, *Ui, *Lrp, *Lrj, *Urp, *Urj, *Pinv, *Q, *Qinv,
+	*MarkL, *MarkU, *NeedL, *NeedU, *ListL, *ListU, *ListN, *Stack, *Pstack,
+	n, i, j, k, p, s, stamp, topL, topU, topN, topNL, status,
+	do_restrict ;
+#ifdef COMPLEX
+    Int bsplit = SPLIT (Bz), xsplit = SPLIT (Xz) ;
+#endif
+
+    umfpack_tic (stats) ;
+
+    /* Control is reserved for future use.  No iterative refinement is done
+     * (Control [UMFPACK_IRSTEP] is ignored), and nothing is printed. */
+    (void) Control ;
+
+    /* ---------------------------------------------------------------------- */
+    /* get the Info array, and check inputs */
+    /* ---------------------------------------------------------------------- */
+
+    if (User_Info != (double *) NULL)
+    {
+	/* return Info in user's array */
+	Info = User_Info ;
+	/* clear the parts of Info that are set by UMFPACK_solve */
+	for (i = UMFPACK_IR_TAKEN ; i <= UMFPACK_SOLVE_TIME ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+    }
+    else
+    {
+	/* no Info array passed - use local one instead */
+	Info = Info2 ;
+	for (i = 0 ; i < UMFPACK_INFO ; i++)
+	{
+	    Info [i] = EMPTY ;
+	}
+    }
+
+    Info [UMFPACK_STATUS] = UMFPACK_OK ;
+    Info [UMFPACK_SOLVE_FLOPS] = 0 ;
+
+    Numeric = (NumericType *) NumericHandle ;
+    if (!UMF_valid_numeric (Numeric))
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_Numeric_object ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    Info [UMFPACK_NROW] = Numeric->n_row ;
+    Info [UMFPACK_NCOL] = Numeric->n_col ;
+
+    if (Numeric->n_row != Numeric->n_col || sys != UMFPACK_A)
+    {
+	/* only square systems Ax=b can be handled */
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_system ;
+	return (UMFPACK_ERROR_invalid_system) ;
+    }
+    n = Numeric->n_row ;
+
+    if (Numeric->Sparse == (SparseSolveType *) NULL)
+    {
+	/* UMFPACK_solve_sparse_setup has not been called */
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_Numeric_object ;
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+
+    if (!xnz || !Xi || !Xx || (bnz > 0 && (!Bi || !Bx)) || (nout > 0 && !Out)
+	|| !Wi || !W)
+    {
+	Info [UMFPACK_STATUS] = UMFPACK_ERROR_argument_missing ;
+	return (UMFPACK_ERROR_argument_missing) ;
+    }
+    *xnz = 0 ;
+
+    for (k = 0 ; k < bnz ; k++)
+    {
+	if (Bi [k] < 0 || Bi [k] >= n)
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_matrix ;
+	    return (UMFPACK_ERROR_invalid_matrix) ;
+	}
+    }
+    for (k = 0 ; k < nout ; k++)
+    {
+	if (Out [k] < 0 || Out [k] >= n)
+	{
+	    Info [UMFPACK_STATUS] = UMFPACK_ERROR_invalid_matrix ;
+	    return (UMFPACK_ERROR_invalid_matrix) ;
+	}
+    }
+
+    if (Numeric->nnzpiv < n
+	|| SCALAR_IS_ZERO (Numeric->rcond) || SCALAR_IS_NAN (Numeric->rcond))
+    {
+	status = UMFPACK_WARNING_singular_matrix ;
+    }
+    else
+    {
+	status = UMFPACK_OK ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get the column-form factors, from UMFPACK_solve_sparse_setup */
+    /* ---------------------------------------------------------------------- */
+
+    Sparse = Numeric->Sparse ;
+    Lp = Sparse->Lp ; Li = Sparse->Li ; Lx = Sparse->Lx ;
+    Up = Sparse->Up ; Ui = Sparse->Ui ; Ux = Sparse->Ux ;
+    Lrp = Sparse->Lrp ; Lrj = Sparse->Lrj ;
+    Urp = Sparse->Urp ; Urj = Sparse->Urj ;
+    Pinv = Sparse->Pinv ; Q = Sparse->Q ; Qinv = Sparse->Qinv ;
+    D = Numeric->D ;
+    Rs = Numeric->Rs ;
+
+    /* the workspace provided by the caller; the marks (Wi [0..4n-1]) are
+     * zero on input, and are cleared again before returning */
+    MarkL  = Wi ;
+    MarkU  = Wi + n ;
+    NeedL  = Wi + 2*n ;
+    NeedU  = Wi + 3*n ;
+    ListL  = Wi + 4*n ;
+    ListU  = Wi + 5*n ;
+    ListN  = Wi + 6*n ;	    /* size 2*n */
+    Stack  = Wi + 8*n ;
+    Pstack = Wi + 9*n ;
+    Y = (Entry *) W ;
+    stamp = 1 ;
+
+    /* ---------------------------------------------------------------------- */
+    /* find the pattern of y = L \ (P R b), and then of U \ y */
+    /* ---------------------------------------------------------------------- */
+
+    /* ListL [topL..n-1] is the reach of P R b in the graph of L, and
+     * ListU [topU..n-1] is the reach of ListL in the graph of U, each in
+     * topological order */
+    topL = n ;
+    for (k = 0 ; k < bnz ; k++)
+    {
+	j = Pinv [Bi [k]] ;
+	if (MarkL [j] != stamp)
+	{
+	    topL = reach (topL, j, Lp, Li, MarkL, stamp, (Int *) NULL, ListL,
+		Stack, Pstack) ;
+	}
+    }
+    topU = n ;
+    for (k = topL ; k < n ; k++)
+    {
+	j = ListL [k] ;
+	if (MarkU [j] != stamp)
+	{
+	    topU = reach (topU, j, Up, Ui, MarkU, stamp, (Int *) NULL, ListU,
+		Stack, Pstack) ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* restrict the solves to the nodes that the requested entries need */
+    /* ---------------------------------------------------------------------- */
+
+    do_restrict = (Out != (Int *) NULL && nout >= 0) ;
+    topN = n ;
+    topNL = 2*n ;
+    if (do_restrict)
+    {
+	/* NeedU: the nodes of the U reach that a requested entry depends on, in
+	 * the graph of U transpose.  ListN [topN..n-1] holds these nodes. */
+	for (k = 0 ; k < nout ; k++)
+	{
+	    j = Qinv [Out [k]] ;
+	    if (MarkU [j] == stamp && NeedU [j] != stamp)
+	    {
+		topN = reach (topN, j, Urp, Urj, NeedU, stamp, MarkU, ListN,
+		    Stack, Pstack) ;
+	    }
+	}
+	/* NeedL: the nodes of the L reach that a node of NeedU depends on, in
+	 * the graph of L transpose.  Only the marks are needed; the nodes are
+	 * placed in ListN [n..2n-1]. */
+	for (k = topN ; k < n ; k++)
+	{
+	    j = ListN [k] ;
+	    if (MarkL [j] == stamp && NeedL [j] != stamp)
+	    {
+		topNL = reach (topNL, j, Lrp, Lrj, NeedL, stamp, MarkL, ListN,
+		    Stack, Pstack) ;
+	    }
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* y = P R b */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = topU ; k < n ; k++)
+    {
+	CLEAR (Y [ListU [k]]) ;
+    }
+    flops = 0 ;
+    for (k = 0 ; k < bnz ; k++)
+    {
+	i = Bi [k] ;
+#ifdef COMPLEX
+	ASSIGN (bk, Bx, Bz, k, bsplit) ;
+#else
+	bk = Bx [k] ;
+#endif
+	if (Rs != (double *) NULL)
+	{
+#ifndef NRECIPROCAL
+	    if (Numeric->do_recip)
+	    {
+		SCALE (bk, Rs [i]) ;
+	    }
+	    else
+#endif
+	    {
+		SCALE_DIV (bk, Rs [i]) ;
+	    }
+	    flops += SCALE_FLOPS ;
+	}
+	/* duplicate entries in b are summed */
+	ASSEMBLE (Y [Pinv [i]], bk) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* y = L \ y, in topological order */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = topL ; k < n ; k++)
+    {
+	Entry yj ;
+	j = ListL [k] ;
+	if (do_restrict && NeedL [j] != stamp) continue ;
+	yj = Y [j] ;
+	if (IS_NONZERO (yj))
+	{
+	    for (p = Lp [j] ; p < Lp [j+1] ; p++)
+	    {
+		MULT_SUB (Y [Li [p]], Lx [p], yj) ;
+	    }
+	    flops += MULTSUB_FLOPS * (Lp [j+1] - Lp [j]) ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* x = Q (U \ y), in topological order */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = topU ; k < n ; k++)
+    {
+	Entry yj ;
+	j = ListU [k] ;
+	if (do_restrict && NeedU [j] != stamp) continue ;
+	DIV (yj, Y [j], D [j]) ;
+	Y [j] = yj ;
+	flops += DIV_FLOPS ;
+	if (IS_NONZERO (yj))
+	{
+	    for (p = Up [j] ; p < Up [j+1] ; p++)
+	    {
+		MULT_SUB (Y [Ui [p]], Ux [p], yj) ;
+	    }
+	    flops += MULTSUB_FLOPS * (Up [j+1] - Up [j]) ;
+	}
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* return the sparse solution */
+    /* ---------------------------------------------------------------------- */
+
+    s = 0 ;
+    if (do_restrict)
+    {
+	for (k = 0 ; k < nout ; k++)
+	{
+	    i = Out [k] ;
+	    j = Qinv [i] ;
+	    if (NeedU [j] == stamp)
+	    {
+		/* each requested entry is returned once */
+		NeedU [j] = 0 ;
+		Xi [s] = i ;
+#ifdef COMPLEX
+		if (xsplit)
+		{
+		    Xx [s] = REAL_COMPONENT (Y [j]) ;
+		    Xz [s] = IMAG_COMPONENT (Y [j]) ;
+		}
+		else
+		{
+		    Xx [2*s  ] = REAL_COMPONENT (Y [j]) ;
+		    Xx [2*s+1] = IMAG_COMPONENT (Y [j]) ;
+		}
+#else
+		Xx [s] = Y [j] ;
+#endif
+		s++ ;
+	    }
+	}
+    }
+    else
+    {
+	for (k = topU ; k < n ; k++)
+	{
+	    j = ListU [k] ;
+	    Xi [s] = Q [j] ;
+#ifdef COMPLEX
+	    if (xsplit)
+	    {
+		Xx [s] = REAL_COMPONENT (Y [j]) ;
+		Xz [s] = IMAG_COMPONENT (Y [j]) ;
+	    }
+	    else
+	    {
+		Xx [2*s  ] = REAL_COMPONENT (Y [j]) ;
+		Xx [2*s+1] = IMAG_COMPONENT (Y [j]) ;
+	    }
+#else
+	    Xx [s] = Y [j] ;
+#endif
+	    s++ ;
+	}
+    }
+    *xnz = s ;
+
+    /* ---------------------------------------------------------------------- */
+    /* clear the marks in the workspace */
+    /* ---------------------------------------------------------------------- */
+
+    for (k = topL ; k < n ; k++)
+    {
+	MarkL [ListL [k]] = 0 ;
+    }
+    for (k = topU ; k < n ; k++)
+    {
+	MarkU [ListU [k]] = 0 ;
+    }
+    for (k = topN ; k < n ; k++)
+    {
+	NeedU [ListN [k]] = 0 ;
+    }
+    for (k = topNL ; k < 2*n ; k++)
+    {
+	NeedL [ListN [k]] = 0 ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get the time used by UMFPACK_solve_sparse */
+    /* ---------------------------------------------------------------------- */
+
+    Info [UMFPACK_IR_TAKEN] = 0 ;
+    Info [UMFPACK_IR_ATTEMPTED] = 0 ;
+    Info [UMFPACK_SOLVE_FLOPS] = flops ;
+    Info [UMFPACK_STATUS] = status ;
+    umfpack_toc (stats) ;
+    Info [UMFPACK_SOLVE_WALLTIME] = stats [0] ;
+    Info [UMFPACK_SOLVE_TIME] = stats [1] ;
+    return (status) ;
+}
+
+
+/* ========================================================================== */
+/* === UMFPACK_solve_sparse_setup =========================================== */
+/* ========================================================================== */
+
+/* Computes the column-form factors used by UMFPACK_solve_sparse and keeps them
+ * in the Numeric object.  Does nothing if they already exist. */
+
+int UMFPACK_solve_sparse_setup
+(
+    void *NumericHandle
+)
+{
+    NumericType *Numeric ;
+
+    Numeric = (NumericType *) NumericHandle ;
+    if (!UMF_valid_numeric (Numeric))
+    {
+	return (UMFPACK_ERROR_invalid_Numeric_object) ;
+    }
+    if (Numeric->n_row != Numeric->n_col)
+    {
+	return (UMFPACK_ERROR_invalid_system) ;
+    }
+    if (Numeric->Sparse != (SparseSolveType *) NULL)
+    {
+	return (UMFPACK_OK) ;
+    }
+    return (build_sparse (Numeric, &(Numeric->Sparse))) ;
+}
+
+
+/* ========================================================================== */
+/* === reach ================================================================ */
+/* ========================================================================== */
+
+/* Non-recursive depth-first search from node start in the graph G, where
+ * the neighbors of node j are Gi [Gp [j] ... Gp [j+1]-1].  Nodes visited are
+ * marked with Mark [j] = stamp.  If Allowed is present, only nodes j with
+ * Allowed [j] == stamp are visited.  The nodes are placed in List
+ * [top-1 ... ] in reverse postorder, and the new top is returned.  On
+ * return, List [newtop..top-1] is in topological order. */
+
+PRIVATE Int reach
+(
+    Int top,
+    Int start,
+    const Int Gp [ ],
+    const Int Gi [ ],
+    Int Mark [ ],
+    Int stamp,
+    const Int Allowed [ ],
+    Int List [ ],
+    Int Stack [ ],
+    Int Pstack [ ]
+)
+{
+    Int head, j, i, p, done ;
+
+    head = 0 ;
+    Stack [0] = start ;
+    while (head >= 0)
+    {
+	j = Stack [head] ;
+	if (Mark [j] != stamp)
+	{
+	    /* first visit of node j */
+	    Mark [j] = stamp ;
+	    Pstack [head] = Gp [j] ;
+	}
+	done = TRUE ;
+	for (p = Pstack [head] ; p < Gp [j+1] ; p++)
+	{
+	    i = Gi [p] ;
+	    if (Mark [i] == stamp) continue ;
+	    if (Allowed != (Int *) NULL && Allowed [i] != stamp) continue ;
+	    /* descend to node i, and resume at p+1 when done */
+	    Pstack [head] = p + 1 ;
+	    Stack [++head] = i ;
+	    done = FALSE ;
+	    break ;
+	}
+	if (done)
+	{
+	    head-- ;
+	    List [--top] = j ;
+	}
+    }
+    return (top) ;
+}
+
+
+/* ========================================================================== */
+/* === build_sparse ========================================================= */
+/* ========================================================================== */
+
+/* Extract the LU factors in the column-oriented form used by
+ * UMFPACK_solve_sparse, and return them in *SparseHandle. */
+
+#define SPARSE_MALLOC(object,type,size)				    \
+{								    \
+    object = (type *) UMF_malloc (size, sizeof (type)) ;	    \
+    ok = ok && (object != (type *) NULL) ;			    \
+}
+
+PRIVATE Int build_sparse
+(
+    NumericType *Numeric,
+    SparseSolveType **SparseHandle
+)
+{
+    SparseSolveType *Sparse ;
+    Entry *Lrx, *Ucx ;
+    Int *Lrp0, *Lrj0, *Ucp, *Uci, *P, *Cnt, lnz, unz, n, i, j, k, p, q,
+	n_row, n_col, nz_udiag, do_recip, ok, status ;
+    size_t hsize ;
+    double nentry, nint, dsize ;
+
+    n = Numeric->n_row ;
+    status = UMFPACK_get_lunz (&lnz, &unz, &n_row, &n_col, &nz_udiag,
+	(void *) Numeric) ;
+    if (status != UMFPACK_OK)
+    {
+	return (status) ;
+    }
+
+    /* ---------------------------------------------------------------------- */
+    /* get L (row form) and U (column form), including their diagonals */
+    /* ---------------------------------------------------------------------- */
+
+    ok = TRUE ;
+    SPARSE_MALLOC (Lrp0, Int,   n+1) ;
+    SPARSE_MALLOC (Lrj0, Int,   lnz+1) ;
+    SPARSE_MALLOC (Lrx,  Entry, lnz+1) ;
+    SPARSE_MALLOC (Ucp,  Int,   n+1) ;
+    SPARSE_MALLOC (Uci,  Int,   unz+1) ;
+    SPARSE_MALLOC (Ucx,  Entry, unz+1) ;
+    SPARSE_MALLOC (P,    Int,   n+1) ;
+    SPARSE_MALLOC (Cnt,  Int,   n+1) ;
+
+    /* the cache is a single block: the header, then the Entry arrays, and
+     * then the Int arrays, so that it can be freed with a single UMF_free */
+    nentry = ((double) lnz + 1) + ((double) unz + 1) ;
+    nint = 2 * ((double) lnz + 1) + 2 * ((double) unz + 1) + 4 * ((double) n + 1)
+	+ 3 * ((double) n) ;
+    hsize = UNITS (SparseSolveType, 1) * sizeof (Unit) ;
+    dsize = ((double) hsize) + nentry * sizeof (Entry) + nint * sizeof (Int) ;
+    Sparse = (SparseSolveType *) NULL ;
+    if (dsize < ((double) Int_MAX) * sizeof (Unit))
+    {
+	Sparse = (SparseSolveType *)
+	    UMF_malloc (UNITS (char, (size_t) dsize), sizeof (Unit)) ;
+    }
+    ok = ok && (Sparse != (SparseSolveType *) NULL) ;
+    if (Sparse != (SparseSolveType *) NULL)
+    {
+	Entry *Xp = (Entry *) (((char *) Sparse) + hsize) ;
+	Int *Ip ;
+	Sparse->Lx = Xp ; Xp += lnz + 1 ;
+	Sparse->Ux = Xp ; Xp += unz + 1 ;
+	Ip = (Int *) Xp ;
+	Sparse->Lp     = Ip ; Ip += n + 1 ;
+	Sparse->Li     = Ip ; Ip += lnz + 1 ;
+	Sparse->Lrp    = Ip ; Ip += n + 1 ;
+	Sparse->Lrj    = Ip ; Ip += lnz + 1 ;
+	Sparse->Up     = Ip ; Ip += n + 1 ;
+	Sparse->Ui     = Ip ; Ip += unz + 1 ;
+	Sparse->Urp    = Ip ; Ip += n + 1 ;
+	Sparse->Urj    = Ip ; Ip += unz + 1 ;
+	Sparse->Pinv   = Ip ; Ip += n ;
+	Sparse->Q      = Ip ; Ip += n ;
+	Sparse->Qinv   = Ip ;
+    }
+
+    if (ok)
+    {
+	/* Lz, Uz, and Dz are NULL, so complex values are packed into Entry */
+	status = UMFPACK_get_numeric (Lrp0, Lrj0, (double *) Lrx,
+#ifdef COMPLEX
+	    (double *) NULL,
+#endif
+	    Ucp, Uci, (double *) Ucx,
+#ifdef COMPLEX
+	    (double *) NULL,
+#endif
+	    P, Sparse->Q, (double *) NULL,
+#ifdef COMPLEX
+	    (double *) NULL,
+#endif
+	    &do_recip, (double *) NULL, (void *) Numeric) ;
+	ok = (status == UMFPACK_OK) ;
+    }
+
+    if (ok)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* strictly lower part of L, in column form, and its row pattern */
+	/* ------------------------------------------------------------------ */
+
+	for (j = 0 ; j < n ; j++)
+	{
+	    Cnt [j] = 0 ;
+	}
+	q = 0 ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    Sparse->Lrp [i] = q ;
+	    for (p = Lrp0 [i] ; p < Lrp0 [i+1] ; p++)
+	    {
+		j = Lrj0 [p] ;
+		if (j != i)
+		{
+		    Sparse->Lrj [q++] = j ;
+		    Cnt [j]++ ;
+		}
+	    }
+	}
+	Sparse->Lrp [n] = q ;
+	Sparse->Lp [0] = 0 ;
+	for (j = 0 ; j < n ; j++)
+	{
+	    Sparse->Lp [j+1] = Sparse->Lp [j] + Cnt [j] ;
+	    Cnt [j] = Sparse->Lp [j] ;
+	}
+	for (i = 0 ; i < n ; i++)
+	{
+	    for (p = Lrp0 [i] ; p < Lrp0 [i+1] ; p++)
+	    {
+		j = Lrj0 [p] ;
+		if (j != i)
+		{
+		    q = Cnt [j]++ ;
+		    Sparse->Li [q] = i ;
+		    Sparse->Lx [q] = Lrx [p] ;
+		}
+	    }
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* strictly upper part of U, in column form, and its row pattern */
+	/* ------------------------------------------------------------------ */
+
+	for (i = 0 ; i < n ; i++)
+	{
+	    Cnt [i] = 0 ;
+	}
+	q = 0 ;
+	for (j = 0 ; j < n ; j++)
+	{
+	    Sparse->Up [j] = q ;
+	    for (p = Ucp [j] ; p < Ucp [j+1] ; p++)
+	    {
+		i = Uci [p] ;
+		if (i != j)
+		{
+		    Sparse->Ui [q] = i ;
+		    Sparse->Ux [q] = Ucx [p] ;
+		    q++ ;
+		    Cnt [i]++ ;
+		}
+	    }
+	}
+	Sparse->Up [n] = q ;
+	Sparse->Urp [0] = 0 ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    Sparse->Urp [i+1] = Sparse->Urp [i] + Cnt [i] ;
+	    Cnt [i] = Sparse->Urp [i] ;
+	}
+	for (j = 0 ; j < n ; j++)
+	{
+	    for (p = Sparse->Up [j] ; p < Sparse->Up [j+1] ; p++)
+	    {
+		Sparse->Urj [Cnt [Sparse->Ui [p]]++] = j ;
+	    }
+	}
+
+	/* ------------------------------------------------------------------ */
+	/* inverse permutations */
+	/* ------------------------------------------------------------------ */
+
+	for (k = 0 ; k < n ; k++)
+	{
+	    Sparse->Pinv [P [k]] = k ;
+	    Sparse->Qinv [Sparse->Q [k]] = k ;
+	}
+    }
+
+    (void) UMF_free ((void *) Lrp0) ;
+    (void) UMF_free ((void *) Lrj0) ;
+    (void) UMF_free ((void *) Lrx) ;
+    (void) UMF_free ((void *) Ucp) ;
+    (void) UMF_free ((void *) Uci) ;
+    (void) UMF_free ((void *) Ucx) ;
+    (void) UMF_free ((void *) P) ;
+    (void) UMF_free ((void *) Cnt) ;
+
+    if (!ok)
+    {
+	(void) UMF_free ((void *) Sparse) ;
+	return ((status == UMFPACK_OK) ? UMFPACK_ERROR_out_of_memory : status) ;
+    }
+    *SparseHandle = Sparse ;
+    return (UMFPACK_OK) ;
+}
@@ -40,11 +40,13 @@ UMFPACK = {
    'umfpack_col_to_triplet', 'umfpack_defaults', 'umfpack_free_numeric', ...
    'umfpack_free_symbolic', 'umfpack_get_numeric', 'umfpack_get_lunz', ...
    'umfpack_get_symbolic', 'umfpack_get_determinant', 'umfpack_numeric', ...
+   'umfpack_numeric_batch', ...
    'umfpack_qsymbolic', 'umfpack_report_control', 'umfpack_report_info', ...
    'umfpack_report_matrix', 'umfpack_report_numeric', 'umfpack_report_perm', ...
    'umfpack_report_status', 'umfpack_report_symbolic', ...
    'umfpack_report_triplet', ...
-   'umfpack_report_vector', 'umfpack_solve', 'umfpack_symbolic', ...
+   'umfpack_report_vector', 'umfpack_solve', 'umfpack_solve_sparse', ...
+   'umfpack_symbolic', ...
    'umfpack_transpose', 'umfpack_triplet_to_col', 'umfpack_scale', ...
    'umfpack_load_numeric', 'umfpack_save_numeric', 'umfpack_copy_numeric', ...
    'umfpack_serialize_numeric', 'umfpack_deserialize_numeric', ...
@@ -57,7 +59,7 @@ UMFPACKW = { 'umfpack_wsolve' }'
 
 UMFUSER = [UMFPACKW ; UMFPACK ]
 
-GENERIC = { 'umfpack_timer', 'umfpack_tictoc' }'
+GENERIC = { 'umfpack_timer', 'umfpack_tictoc', 'umfpack_export_profile' }'
 
 %-------------------------------------------------------------------------------
 % four versions of each file (di, dl, zi, zl):
@@ -225,6 +227,77 @@ for kk = 1:length (kinds)
     fclose (f) ;
 end
 
+%-------------------------------------------------------------------------------
+% two versions of each file (si, sl), for single precision LU factors:
+%-------------------------------------------------------------------------------
+
+UMFSINGLE = {
+   'umf_assemble', 'umf_blas3_update', 'umf_build_tuples', ...
+   'umf_create_element', ...
+   'umf_dump', 'umf_extend_front', 'umf_garbage_collection', ...
+   'umf_get_memory', ...
+   'umf_init_front', 'umf_kernel', 'umf_kernel_init', 'umf_kernel_wrapup', ...
+   'umf_local_search', 'umf_lsolve', 'umf_mem_alloc_element', ...
+   'umf_mem_alloc_head_block', 'umf_mem_alloc_tail_block', ...
+   'umf_mem_free_tail_block', 'umf_mem_init_memoryspace', ...
+   'umf_row_search', 'umf_scale_column', ...
+   'umf_set_stats', 'umf_solve_mixed', 'umf_symbolic_usage', ...
+   'umf_tuple_lengths', 'umf_usolve', 'umf_valid_numeric', ...
+   'umf_valid_symbolic', 'umf_grow_front', 'umf_start_front', ...
+   'umf_store_lu', 'umf_scale', ...
+   'umfpack_defaults', 'umfpack_free_numeric', 'umfpack_numeric', ...
+   'umfpack_numeric_fallback', 'umfpack_solve'
+}'
+
+% special cases: { newfile suffix, extra #define, source file }
+SINGLE_CREATED = {
+    '_lhsolve',       'CONJUGATE_SOLVE', 'umf_ltsolve' ;
+    '_uhsolve',       'CONJUGATE_SOLVE', 'umf_utsolve' ;
+    '_assemble_fixq', 'FIXQ',            'umf_assemble' ;
+    '_store_lu_drop', 'DROP',            'umf_store_lu' } ;
+
+kinds = { 'si', 'sl' } ;
+defs1 = { 'SINT', 'SLONG' } ;
+whats = { 'single int32_t', 'single int64_t' } ;
+U = UMFSINGLE
+for k = 1:(length (U) + size (SINGLE_CREATED, 1))
+    for kk = 1:length (kinds)
+        kind = kinds {kk} ;
+        what = whats {kk} ;
+        if (k <= length (U))
+            file = U {k} ;
+            def2 = '' ;
+            if (isequal (file (1:4), 'umf_'))
+                % umf_*
+                newfile = [file(1:4), kind, file(4:end), '.c' ] ;
+            else
+                % umfpack_*
+                newfile = [file(1:8), kind, file(8:end), '.c'] ;
+            end
+        else
+            kc = k - length (U) ;
+            file = SINGLE_CREATED {kc,3} ;
+            def2 = sprintf ('#define %s\n', SINGLE_CREATED {kc,2}) ;
+            newfile = ['umf_', kind, SINGLE_CREATED{kc,1}, '.c'] ;
+        end
+        fprintf ('%s\n', newfile) ;
+        f = fopen (newfile, 'w') ;
+        fprintf (f, '//------------------------------------------------------------------------------\n') ;
+        fprintf (f, '// UMFPACK/Source2/%s:\n// %s version of %s\n', ...
+            newfile, what, file) ;
+        fprintf (f, '//------------------------------------------------------------------------------\n') ;
+        fprintf (f, '\n') ;
+        fprintf (f, '// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.\n') ;
+        fprintf (f, '// SPDX-License-Identifier: GPL-2.0+\n') ;
+        fprintf (f, '\n') ;
+        fprintf (f, '#define %s\n', defs1 {kk}) ;
+        fprintf (f, '%s', def2) ;
+        fprintf (f, '#include "%s.c"\n', file) ;
+        fprintf (f, '\n') ;
+        fclose (f) ;
+    end
+end
+
 %-------------------------------------------------------------------------------
 % two versions of each file (i, l):
 %-------------------------------------------------------------------------------
@@ -0,0 +1,10 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source2/umfpack_di_numeric_batch.c:
+// double int32_t version of umfpack_numeric_batch
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+#define DINT
+#include "umfpack_numeric_batch.c"
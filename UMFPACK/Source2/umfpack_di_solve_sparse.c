@@ -0,0 +1,10 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source2/umfpack_di_solve_sparse.c:
+// double int32_t version of umfpack_solve_sparse
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) 2005-2023, Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+#define DINT
+#include "umfpack_solve_sparse.c"
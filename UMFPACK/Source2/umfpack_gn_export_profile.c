@@ -0,0 +1,10 @@
+//------------------------------------------------------------------------------
+// UMFPACK/Source2/umfpack_gn_export_profile.c:
+// generic version of umfpack_export_profile
+//------------------------------------------------------------------------------
+
+// UMFPACK, Copyright (c) Timothy A. Davis, All Rights Reserved.
+// SPDX-License-Identifier: GPL-2.0+
+
+#include "umfpack_export_profile.c"
+
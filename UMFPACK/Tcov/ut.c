@@ -2448,6 +2448,73 @@ static double do_symnum
         Numeric_copy = NULL ;
     }
 
+    //--------------------------------------------------------------------------
+    // test deserialize_numeric_wrap
+    //--------------------------------------------------------------------------
+
+    // the wrapped Numeric object must give the same solution as the Numeric
+    // object it was serialized from
+    if (n_row == n_col)
+    {
+        int umf_fail_save [3], s1, s2 ;
+        void *Numeric_wrap = NULL ;
+        double *X1, *X2, *X1z, *X2z ;
+        int8_t *N_blob2 ;
+
+        umf_fail_save [0] = umf_fail ;
+        umf_fail_save [1] = umf_fail_lo ;
+        umf_fail_save [2] = umf_fail_hi ;
+        umf_fail = -1 ;
+        umf_fail_lo = 0 ;
+        umf_fail_hi = 0 ;
+
+        status = UMFPACK_serialize_numeric (N_blob, N_blobsize, Numeric) ;
+        if (status != UMFPACK_OK)
+        {
+            error ("serialize numeric failed (wrap)\n", 0.) ;
+        }
+        status = UMFPACK_deserialize_numeric_wrap (&Numeric_wrap, N_blob,
+            N_blobsize) ;
+        if (status != UMFPACK_OK)
+        {
+            error ("deserialize numeric wrap failed\n", 0.) ;
+        }
+
+        // X has the same split/merged complex form as A
+        X1 = (double *) calloc (2*n, sizeof (double)) ;
+        X2 = (double *) calloc (2*n, sizeof (double)) ;
+        if (!X1 || !X2) error ("out of memory (wrap)", 0.) ;
+        X1z = Az ? (X1 + n) : DNULL ;
+        X2z = Az ? (X2 + n) : DNULL ;
+        s1 = UMFPACK_solve (UMFPACK_A, Ap, Ai, CARG(Ax,Az), CARG(X1,X1z),
+            CARG(b,bz), Numeric, Control, DNULL) ;
+        s2 = UMFPACK_solve (UMFPACK_A, Ap, Ai, CARG(Ax,Az), CARG(X2,X2z),
+            CARG(b,bz), Numeric_wrap, Control, DNULL) ;
+        if (s1 != s2 || memcmp (X1, X2, 2*n * sizeof (double)) != 0)
+        {
+            error ("wrapped Numeric solve differs\n", 0.) ;
+        }
+        free (X1) ;
+        free (X2) ;
+        UMFPACK_free_numeric (&Numeric_wrap) ;
+
+        // a misaligned blob cannot be used in place
+        N_blob2 = malloc (N_blobsize + 1) ;
+        if (!N_blob2) error ("out of memory (wrap)", 0.) ;
+        memcpy (N_blob2 + 1, N_blob, N_blobsize) ;
+        status = UMFPACK_deserialize_numeric_wrap (&Numeric_wrap, N_blob2 + 1,
+            N_blobsize) ;
+        if (status != UMFPACK_ERROR_invalid_blob || Numeric_wrap != NULL)
+        {
+            error ("misaligned wrap should have failed\n", 0.) ;
+        }
+        free (N_blob2) ;
+
+        umf_fail    = umf_fail_save [0] ;
+        umf_fail_lo = umf_fail_save [1] ;
+        umf_fail_hi = umf_fail_save [2] ;
+    }
+
     free (N_blob) ;
 
     /* ---------------------------------------------------------------------- */
@@ -4906,6 +4973,732 @@ static double do_file
     return (maxrnorm) ;
 }
 
+/* ========================================================================== */
+/* do_profile: test umfpack_*_numeric_profile and umfpack_export_profile */
+/* ========================================================================== */
+
+static void count_lines (void *user_data, const char *text)
+{
+    size_t len = strlen (text) ;
+    if (len > 0 && text [len-1] == '\n') (*((int *) user_data))++ ;
+}
+
+static void do_profile (void)
+{
+    Int n, *Ap, *Ai, b, nfronts, i, j, p ;
+    double *Ax, *Az, Control [UMFPACK_CONTROL], Info [UMFPACK_INFO],
+	Profile [UMFPACK_PROFILE], tsum ;
+    void *Symbolic, *Numeric ;
+    int s, k, nlines ;
+
+    printf ("\nnumeric profile:\n") ;
+
+    /* a banded matrix with two dense rows and columns, whose factorization
+     * needs a garbage collection if the initial allocation is small */
+    n = 400 ;
+    Ap = (Int *) malloc ((n+1) * sizeof (Int)) ;
+    Ai = (Int *) malloc ((n*n) * sizeof (Int)) ;
+    Ax = (double *) malloc ((n*n) * sizeof (double)) ;
+    Az = (double *) calloc ((n*n), sizeof (double)) ;
+    if (!Ap || !Ai || !Ax || !Az) error ("out of memory (profile)", 0.) ;
+    p = 0 ;
+    for (j = 0 ; j < n ; j++)
+    {
+	Ap [j] = p ;
+	for (i = 0 ; i < n ; i++)
+	{
+	    if ((i < j-3 || i > j+3) && i > 1 && j > 1) continue ;
+	    Ai [p] = i ;
+	    Ax [p] = (i == j) ? 10 : (1.0 / (1+i+j)) ;
+	    p++ ;
+	}
+    }
+    Ap [n] = p ;
+    UMFPACK_defaults (Control) ;
+    Control [UMFPACK_ALLOC_INIT] = -1 ;	/* the smallest initial allocation */
+
+    s = UMFPACK_symbolic (n, n, Ap, Ai, CARG (Ax, Az), &Symbolic, Control,
+	Info) ;
+    if (s != UMFPACK_OK) error ("profile symbolic", (double) s) ;
+    s = UMFPACK_numeric_profile (Ap, Ai, CARG (Ax, Az), Symbolic, &Numeric,
+	Control, Info, Profile) ;
+    if (s != UMFPACK_OK) error ("profile numeric", (double) s) ;
+
+    /* the phases do not overlap, so they add up to at most the total time */
+    tsum = 0 ;
+    for (k = UMFPACK_PROFILE_INIT_TIME ; k <= UMFPACK_PROFILE_WRAPUP_TIME ; k++)
+    {
+	if (Profile [k] < -1e-12) error ("profile phase time", Profile [k]) ;
+	tsum += Profile [k] ;
+    }
+    printf ("phases %g numeric %g ngarbage %g gc %g\n", tsum,
+	Profile [UMFPACK_PROFILE_NUMERIC_TIME],
+	Profile [UMFPACK_PROFILE_NGARBAGE], Profile [UMFPACK_PROFILE_GC_TIME]) ;
+    if (tsum > Profile [UMFPACK_PROFILE_NUMERIC_TIME] + 1e-9)
+    {
+	error ("profile phases exceed the numeric time", tsum) ;
+    }
+    if (Profile [UMFPACK_PROFILE_NGARBAGE] < 1)
+    {
+	error ("profile: no garbage collection", 0.) ;
+    }
+
+    /* each front of the Symbolic object is timed once */
+    nfronts = 0 ;
+    for (b = 0 ; b < UMFPACK_PROFILE_NHIST ; b++)
+    {
+	nfronts += Profile [UMFPACK_PROFILE_FRONT_TIME_HIST + b] ;
+    }
+    if (nfronts != ((SymbolicType *) Symbolic)->nfr)
+    {
+	error ("profile front count", (double) nfronts) ;
+    }
+    if (Profile [UMFPACK_PROFILE_MAX_FRONT_TIME] >
+	Profile [UMFPACK_PROFILE_NUMERIC_TIME])
+    {
+	error ("profile max front time", 0.) ;
+    }
+
+    /* CSV: a header, 21 scalars, and 3 histograms */
+    nlines = 0 ;
+    s = umfpack_export_profile (Profile, UMFPACK_PROFILE_CSV, count_lines,
+	&nlines) ;
+    if (s != UMFPACK_OK || nlines != 1 + 21 + 3 * UMFPACK_PROFILE_NHIST)
+    {
+	error ("profile csv", (double) nlines) ;
+    }
+    /* JSON: braces, 21 scalars, and 3 histograms */
+    nlines = 0 ;
+    s = umfpack_export_profile (Profile, UMFPACK_PROFILE_JSON, count_lines,
+	&nlines) ;
+    if (s != UMFPACK_OK || nlines != 2 + 21 + 3)
+    {
+	error ("profile json", (double) nlines) ;
+    }
+    s = umfpack_export_profile (DNULL, UMFPACK_PROFILE_JSON, count_lines,
+	&nlines) ;
+    if (s != UMFPACK_ERROR_argument_missing) error ("profile null", 0.) ;
+    nlines = 0 ;
+    s = umfpack_export_profile (Profile, 2, count_lines, &nlines) ;
+    if (s != UMFPACK_ERROR_argument_missing || nlines != 0)
+    {
+	error ("profile format", (double) nlines) ;
+    }
+
+    UMFPACK_free_numeric (&Numeric) ;
+    UMFPACK_free_symbolic (&Symbolic) ;
+    free (Ap) ;
+    free (Ai) ;
+    free (Ax) ;
+    free (Az) ;
+}
+
+#if defined (DINT) || defined (DLONG)
+
+/* ========================================================================== */
+/* do_single: test the single precision factors and the double fallback */
+/* ========================================================================== */
+
+#ifdef DINT
+#define UMFPACK_single_defaults         umfpack_si_defaults
+#define UMFPACK_single_numeric          umfpack_si_numeric
+#define UMFPACK_single_numeric_fallback umfpack_si_numeric_fallback
+#define UMFPACK_single_solve            umfpack_si_solve
+#define UMFPACK_single_free_numeric     umfpack_si_free_numeric
+#else
+#define UMFPACK_single_defaults         umfpack_sl_defaults
+#define UMFPACK_single_numeric          umfpack_sl_numeric
+#define UMFPACK_single_numeric_fallback umfpack_sl_numeric_fallback
+#define UMFPACK_single_solve            umfpack_sl_solve
+#define UMFPACK_single_free_numeric     umfpack_sl_free_numeric
+#endif
+
+/* norm (b-A*x,inf) / (norm (A,1) * norm (x,inf) + norm (b,inf)) */
+
+static double single_resid
+(
+    Int n,
+    Int Ap [ ],
+    Int Ai [ ],
+    double Ax [ ],
+    double x [ ],
+    double b [ ],
+    double r [ ]
+)
+{
+    Int i, j, p ;
+    double anorm, xnorm, bnorm, rnorm, colnorm ;
+    anorm = 0 ;
+    xnorm = 0 ;
+    bnorm = 0 ;
+    rnorm = 0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+	r [i] = b [i] ;
+    }
+    for (j = 0 ; j < n ; j++)
+    {
+	colnorm = 0 ;
+	for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	{
+	    r [Ai [p]] -= Ax [p] * x [j] ;
+	    colnorm += fabs (Ax [p]) ;
+	}
+	anorm = MAX (anorm, colnorm) ;
+	xnorm = MAX (xnorm, fabs (x [j])) ;
+    }
+    for (i = 0 ; i < n ; i++)
+    {
+	bnorm = MAX (bnorm, fabs (b [i])) ;
+	rnorm = MAX (rnorm, fabs (r [i])) ;
+    }
+    return (rnorm / (anorm * xnorm + bnorm)) ;
+}
+
+/* Factorizes a well-conditioned tridiagonal matrix and an ill-conditioned
+ * Hilbert matrix with umfpack_s*_numeric.  The first is solved with the
+ * single precision factors alone.  The second falls back to a temporary double
+ * precision factorization until umfpack_s*_numeric_fallback is called, and
+ * then uses the kept one.  Both must match the double precision solve. */
+
+static void do_single (void)
+{
+    Int n, i, j, p, *Ap, *Ai ;
+    double *Ax, *b, *x, *x2, *x3, *r, Control [UMFPACK_CONTROL],
+	Info [UMFPACK_INFO], rnorm ;
+    void *Symbolic, *Numeric, *DNumeric ;
+    int s, k ;
+
+    printf ("\nsingle precision factors:\n") ;
+    UMFPACK_single_defaults (Control) ;
+
+    for (k = 0 ; k <= 1 ; k++)
+    {
+
+	/* ------------------------------------------------------------------ */
+	/* k = 0: tridiagonal (n = 100), k = 1: Hilbert (n = 9) */
+	/* ------------------------------------------------------------------ */
+
+	n = (k == 0) ? 100 : 9 ;
+	Ap = (Int *) malloc ((n+1) * sizeof (Int)) ;
+	Ai = (Int *) malloc ((n*n) * sizeof (Int)) ;
+	Ax = (double *) malloc ((n*n) * sizeof (double)) ;
+	b  = (double *) malloc (n * sizeof (double)) ;
+	x  = (double *) malloc (n * sizeof (double)) ;
+	x2 = (double *) malloc (n * sizeof (double)) ;
+	x3 = (double *) malloc (n * sizeof (double)) ;
+	r  = (double *) malloc (n * sizeof (double)) ;
+	if (!Ap || !Ai || !Ax || !b || !x || !x2 || !x3 || !r)
+	{
+	    error ("out of memory (single)", 0.) ;
+	}
+	p = 0 ;
+	for (j = 0 ; j < n ; j++)
+	{
+	    Ap [j] = p ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		if (k == 0 && (i < j-1 || i > j+1)) continue ;
+		Ai [p] = i ;
+		Ax [p] = (k == 0) ? ((i == j) ? 4.0 : -1.0) : (1.0 / (i+j+1)) ;
+		p++ ;
+	    }
+	    b [j] = 1 + j ;
+	}
+	Ap [n] = p ;
+
+	s = UMFPACK_symbolic (n, n, Ap, Ai, CARG (Ax, DNULL), &Symbolic,
+	    Control, Info) ;
+	if (s != UMFPACK_OK) error ("single symbolic", (double) s) ;
+	s = UMFPACK_single_numeric (Ap, Ai, Ax, Symbolic, &Numeric, Control,
+	    Info) ;
+	if (s != UMFPACK_OK) error ("single numeric", (double) s) ;
+	s = UMFPACK_numeric (Ap, Ai, CARG (Ax, DNULL), Symbolic, &DNumeric,
+	    DNULL, DNULL) ;
+	if (s != UMFPACK_OK) error ("double numeric", (double) s) ;
+	UMFPACK_free_symbolic (&Symbolic) ;
+
+	/* the double precision solution */
+	s = UMFPACK_solve (UMFPACK_A, Ap, Ai, CARG (Ax, DNULL),
+	    CARG (x3, DNULL), CARG (b, DNULL), DNumeric, DNULL, DNULL) ;
+	if (s != UMFPACK_OK) error ("double solve", (double) s) ;
+
+	/* solve with the single precision factors */
+	s = UMFPACK_single_solve (UMFPACK_A, Ap, Ai, Ax, x, b, Numeric, Control,
+	    Info) ;
+	rnorm = single_resid (n, Ap, Ai, Ax, x, b, r) ;
+	printf ("single "ID": status %d fallback %g resid %g\n", n, s,
+	    Info [UMFPACK_FALLBACK_TO_DOUBLE], rnorm) ;
+	if (s != UMFPACK_OK) error ("single solve", (double) s) ;
+	if (rnorm > 1e-14) error ("single resid", rnorm) ;
+	if (Info [UMFPACK_FALLBACK_TO_DOUBLE] != ((k == 0) ? 0 : 2))
+	{
+	    error ("single fallback (1)", Info [UMFPACK_FALLBACK_TO_DOUBLE]) ;
+	}
+
+	if (k == 1)
+	{
+	    /* the solve did not keep the temporary double factorization */
+	    s = UMFPACK_single_solve (UMFPACK_A, Ap, Ai, Ax, x2, b, Numeric,
+		Control, Info) ;
+	    if (s != UMFPACK_OK || Info [UMFPACK_FALLBACK_TO_DOUBLE] != 2)
+	    {
+		error ("single fallback (2)", Info [UMFPACK_FALLBACK_TO_DOUBLE]) ;
+	    }
+
+	    /* keep the double factorization in the Numeric object */
+	    s = UMFPACK_single_numeric_fallback (INULL, Ai, Ax, Numeric,
+		Control, Info) ;
+	    if (s != UMFPACK_ERROR_argument_missing) error ("fallback (1)", s) ;
+	    s = UMFPACK_single_numeric_fallback (Ap, Ai, Ax, (void *) NULL,
+		Control, Info) ;
+	    if (s != UMFPACK_ERROR_invalid_Numeric_object)
+	    {
+		error ("fallback (2)", s) ;
+	    }
+	    s = UMFPACK_single_numeric_fallback (Ap, Ai, Ax, Numeric,
+		Control, Info) ;
+	    if (s != UMFPACK_OK) error ("fallback (3)", s) ;
+	    s = UMFPACK_single_numeric_fallback (Ap, Ai, Ax, Numeric,
+		Control, Info) ;
+	    if (s != UMFPACK_OK) error ("fallback (4)", s) ;
+
+	    /* the kept factorization gives the same result */
+	    s = UMFPACK_single_solve (UMFPACK_A, Ap, Ai, Ax, x2, b, Numeric,
+		Control, Info) ;
+	    if (s != UMFPACK_OK || Info [UMFPACK_FALLBACK_TO_DOUBLE] != 1)
+	    {
+		error ("single fallback (3)", Info [UMFPACK_FALLBACK_TO_DOUBLE]) ;
+	    }
+	    for (i = 0 ; i < n ; i++)
+	    {
+		if (x [i] != x2 [i]) error ("single fallback (4)", (double) i) ;
+	    }
+	}
+
+	/* the solution matches the double precision one */
+	for (i = 0 ; i < n ; i++)
+	{
+	    if (fabs (x [i] - x3 [i]) > 1e-6 * fabs (x3 [i]))
+	    {
+		error ("single vs double", (double) i) ;
+	    }
+	}
+
+	UMFPACK_single_free_numeric (&Numeric) ;
+	UMFPACK_free_numeric (&DNumeric) ;
+	free (Ap) ;
+	free (Ai) ;
+	free (Ax) ;
+	free (b) ;
+	free (x) ;
+	free (x2) ;
+	free (x3) ;
+	free (r) ;
+    }
+
+#if defined (UMF_MALLOC_COUNT) || !defined (NDEBUG)
+    if (UMF_malloc_count != 0) error ("single memory leak", 0.) ;
+#endif
+}
+#endif
+
+/* ========================================================================== */
+/* do_solve_sparse: test umfpack_*_solve_sparse against umfpack_*_solve */
+/* ========================================================================== */
+
+/* Solves Ax=b with a sparse b, twice, for all of x and for a few requested
+ * entries, and compares with the solution from umfpack_*_solve with b held as
+ * a dense vector.  The marks in the workspace, Wi [0..4n-1], must be zero
+ * after each call.  umfpack_*_solve_sparse fails without the setup. */
+
+static void do_solve_sparse (void)
+{
+    Int n, i, j, k, p, nb, nout, xnz, *Ap, *Ai, *Bi, *Xi, *Wi, *Mark, Out [4] ;
+    double *Ax, *Az, *b, *bz, *x, *xz, *Bx, *Bz, *Xx, *Xz, *W,
+	Control [UMFPACK_CONTROL], Info [UMFPACK_INFO], xnorm, err ;
+    void *Symbolic, *Numeric ;
+    int s, trial, umf_fail_save [3] ;
+
+    printf ("\nsolve sparse:\n") ;
+    n = 300 ;
+    /* lower triangular, so x is nonzero only below the first entry of b, and
+     * with a large diagonal, so that x is well scaled */
+    matgen_band (n, 3, 0, 0, 0, 0, 0, &Ap, &Ai, &Ax, &Az) ;
+    for (j = 0 ; j < n ; j++)
+    {
+	for (p = Ap [j] ; p < Ap [j+1] ; p++)
+	{
+	    if (Ai [p] == j) Ax [p] += 10 ;
+	}
+    }
+    UMFPACK_defaults (Control) ;
+    Control [UMFPACK_IRSTEP] = 0 ;
+
+    s = UMFPACK_symbolic (n, n, Ap, Ai, CARG (Ax, Az), &Symbolic, Control,
+	Info) ;
+    if (s != UMFPACK_OK) error ("solve sparse symbolic", (double) s) ;
+    s = UMFPACK_numeric (Ap, Ai, CARG (Ax, Az), Symbolic, &Numeric, Control,
+	Info) ;
+    if (s != UMFPACK_OK) error ("solve sparse numeric", (double) s) ;
+    UMFPACK_free_symbolic (&Symbolic) ;
+
+    b  = (double *) calloc (n, sizeof (double)) ;
+    bz = (double *) calloc (n, sizeof (double)) ;
+    x  = (double *) calloc (n, sizeof (double)) ;
+    xz = (double *) calloc (n, sizeof (double)) ;
+    Bi = (Int *) malloc (4 * sizeof (Int)) ;
+    Bx = (double *) malloc (4 * sizeof (double)) ;
+    Bz = (double *) malloc (4 * sizeof (double)) ;
+    Xi = (Int *) malloc (n * sizeof (Int)) ;
+    Xx = (double *) malloc (n * sizeof (double)) ;
+    Xz = (double *) malloc (n * sizeof (double)) ;
+    Wi = (Int *) calloc (10*n, sizeof (Int)) ;
+    W  = (double *) malloc (2*n * sizeof (double)) ;
+    Mark = (Int *) calloc (n, sizeof (Int)) ;
+    if (!b || !bz || !x || !xz || !Bi || !Bx || !Bz || !Xi || !Xx || !Xz
+	|| !Wi || !W || !Mark)
+    {
+	error ("out of memory (solve sparse)", 0.) ;
+    }
+
+    /* a sparse b, with a duplicate entry, and the same b as a dense vector */
+    nb = 4 ;
+    Bi [0] = n-3 ; Bx [0] = 1 ;   Bz [0] = -1 ;
+    Bi [1] = n/2 ; Bx [1] = 2 ;   Bz [1] = 0.5 ;
+    Bi [2] = n-3 ; Bx [2] = 0.5 ; Bz [2] = 2 ;
+    Bi [3] = n-1 ; Bx [3] = -3 ;  Bz [3] = 1 ;
+    for (k = 0 ; k < nb ; k++)
+    {
+	b [Bi [k]] += Bx [k] ;
+	bz [Bi [k]] += Bz [k] ;
+    }
+    s = UMFPACK_solve (UMFPACK_A, Ap, Ai, CARG (Ax, Az), CARG (x, xz),
+	CARG (b, bz), Numeric, Control, Info) ;
+    if (s != UMFPACK_OK) error ("solve sparse: dense solve", (double) s) ;
+    xnorm = 0 ;
+    for (i = 0 ; i < n ; i++)
+    {
+	xnorm = MAX (xnorm, fabs (x [i])) ;
+#ifdef COMPLEX
+	xnorm = MAX (xnorm, fabs (xz [i])) ;
+#endif
+    }
+
+    /* requested entries: two from the pattern of x, one duplicate */
+    nout = 4 ;
+    Out [0] = n-1 ;
+    Out [1] = 0 ;
+    Out [2] = n-1 ;
+    Out [3] = n/2 ;
+
+    s = UMFPACK_solve_sparse (UMFPACK_A, nb, Bi, CARG (Bx, Bz), -1, INULL,
+	&xnz, Xi, CARG (Xx, Xz), Numeric, Control, Info, Wi, W) ;
+    if (s != UMFPACK_ERROR_invalid_Numeric_object)
+    {
+	error ("solve sparse without setup", (double) s) ;
+    }
+    s = UMFPACK_solve_sparse_setup (Numeric) ;
+    if (s != UMFPACK_OK) error ("solve sparse setup", (double) s) ;
+    s = UMFPACK_solve_sparse_setup (Numeric) ;
+    if (s != UMFPACK_OK) error ("solve sparse setup (2)", (double) s) ;
+
+    for (trial = 0 ; trial <= 1 ; trial++)
+    {
+
+	/* all of x */
+	s = UMFPACK_solve_sparse (UMFPACK_A, nb, Bi, CARG (Bx, Bz), -1, INULL,
+	    &xnz, Xi, CARG (Xx, Xz), Numeric, Control, Info, Wi, W) ;
+	if (s != UMFPACK_OK) error ("solve sparse", (double) s) ;
+	err = 0 ;
+	for (k = 0 ; k < xnz ; k++)
+	{
+	    i = Xi [k] ;
+	    if (i < 0 || i >= n) error ("solve sparse index", (double) i) ;
+	    if (Mark [i] != trial) error ("solve sparse duplicate", (double) i) ;
+	    Mark [i] = trial + 1 ;
+	    err = MAX (err, fabs (Xx [k] - x [i])) ;
+#ifdef COMPLEX
+	    err = MAX (err, fabs (Xz [k] - xz [i])) ;
+#endif
+	}
+	for (i = 0 ; i < n ; i++)
+	{
+	    if (Mark [i] == trial && (x [i] != 0 || xz [i] != 0))
+	    {
+		/* an entry of x is missing from the sparse solution */
+		error ("solve sparse pattern", (double) i) ;
+	    }
+	    Mark [i] = trial + 1 ;
+	}
+	printf ("solve sparse trial %d: xnz "ID" err %g xnorm %g\n", trial, xnz,
+	    err, xnorm) ;
+	if (err > 1e-12 * xnorm) error ("solve sparse error", err) ;
+	if (xnz >= n) error ("solve sparse: x is not sparse", (double) xnz) ;
+
+	/* just the entries listed in Out */
+	s = UMFPACK_solve_sparse (UMFPACK_A, nb, Bi, CARG (Bx, Bz), nout, Out,
+	    &xnz, Xi, CARG (Xx, Xz), Numeric, Control, Info, Wi, W) ;
+	if (s != UMFPACK_OK) error ("solve sparse out", (double) s) ;
+	if (xnz > 3) error ("solve sparse out count", (double) xnz) ;
+	for (k = 0 ; k < xnz ; k++)
+	{
+	    i = Xi [k] ;
+	    if (i != Out [0] && i != Out [1] && i != Out [3])
+	    {
+		error ("solve sparse out index", (double) i) ;
+	    }
+	    err = fabs (Xx [k] - x [i]) ;
+#ifdef COMPLEX
+	    err = MAX (err, fabs (Xz [k] - xz [i])) ;
+#endif
+	    if (err > 1e-12 * xnorm) error ("solve sparse out error", err) ;
+	}
+	for (k = 0 ; k < nout ; k++)
+	{
+	    i = Out [k] ;
+	    if (x [i] == 0 && xz [i] == 0) continue ;
+	    for (p = 0 ; p < xnz && Xi [p] != i ; p++) ;
+	    if (p == xnz) error ("solve sparse out missing", (double) i) ;
+	}
+
+	/* the marks in the workspace are left zero */
+	for (j = 0 ; j < 4*n ; j++)
+	{
+	    if (Wi [j] != 0) error ("solve sparse workspace", (double) j) ;
+	}
+    }
+
+    /* error handling */
+    s = UMFPACK_solve_sparse (UMFPACK_A, nb, Bi, CARG (Bx, Bz), -1, INULL,
+	&xnz, Xi, CARG (Xx, Xz), Numeric, Control, Info, INULL, W) ;
+    if (s != UMFPACK_ERROR_argument_missing) error ("solve sparse Wi", s) ;
+    s = UMFPACK_solve_sparse (UMFPACK_At, nb, Bi, CARG (Bx, Bz), -1, INULL,
+	&xnz, Xi, CARG (Xx, Xz), Numeric, Control, Info, Wi, W) ;
+    if (s != UMFPACK_ERROR_invalid_system) error ("solve sparse sys", s) ;
+    Bi [1] = n ;
+    s = UMFPACK_solve_sparse (UMFPACK_A, nb, Bi, CARG (Bx, Bz), -1, INULL,
+	&xnz, Xi, CARG (Xx, Xz), Numeric, Control, Info, Wi, W) ;
+    if (s != UMFPACK_ERROR_invalid_matrix) error ("solve sparse Bi", s) ;
+    Bi [1] = n/2 ;
+    s = UMFPACK_solve_sparse (UMFPACK_A, nb, Bi, CARG (Bx, Bz), -1, INULL,
+	&xnz, Xi, CARG (Xx, Xz), (void *) NULL, Control, Info, Wi, W) ;
+    if (s != UMFPACK_ERROR_invalid_Numeric_object)
+    {
+	error ("solve sparse Numeric", s) ;
+    }
+    s = UMFPACK_solve_sparse_setup ((void *) NULL) ;
+    if (s != UMFPACK_ERROR_invalid_Numeric_object)
+    {
+	error ("solve sparse setup Numeric", s) ;
+    }
+
+    /* out of memory in the setup */
+    UMFPACK_free_numeric (&Numeric) ;
+    s = UMFPACK_symbolic (n, n, Ap, Ai, CARG (Ax, Az), &Symbolic, Control,
+	Info) ;
+    if (s != UMFPACK_OK) error ("solve sparse symbolic (2)", (double) s) ;
+    s = UMFPACK_numeric (Ap, Ai, CARG (Ax, Az), Symbolic, &Numeric, Control,
+	Info) ;
+    if (s != UMFPACK_OK) error ("solve sparse numeric (2)", (double) s) ;
+    UMFPACK_free_symbolic (&Symbolic) ;
+    umf_fail_save [0] = umf_fail ;
+    umf_fail_save [1] = umf_fail_lo ;
+    umf_fail_save [2] = umf_fail_hi ;
+    umf_fail = 1 ;
+    umf_fail_lo = 0 ;
+    umf_fail_hi = 0 ;
+    s = UMFPACK_solve_sparse_setup (Numeric) ;
+    if (s != UMFPACK_ERROR_out_of_memory) error ("solve sparse setup mem", s) ;
+    umf_fail    = umf_fail_save [0] ;
+    umf_fail_lo = umf_fail_save [1] ;
+    umf_fail_hi = umf_fail_save [2] ;
+
+    UMFPACK_free_numeric (&Numeric) ;
+    free (Ap) ;
+    free (Ai) ;
+    free (Ax) ;
+    free (Az) ;
+    free (b) ;
+    free (bz) ;
+    free (x) ;
+    free (xz) ;
+    free (Bi) ;
+    free (Bx) ;
+    free (Bz) ;
+    free (Xi) ;
+    free (Xx) ;
+    free (Xz) ;
+    free (Wi) ;
+    free (W) ;
+    free (Mark) ;
+
+#if defined (UMF_MALLOC_COUNT) || !defined (NDEBUG)
+    if (UMF_malloc_count != 0) error ("solve sparse memory leak", 0.) ;
+#endif
+}
+
+/* ========================================================================== */
+/* do_numeric_batch: test umfpack_*_numeric_batch */
+/* ========================================================================== */
+
+/* Factorizes and solves a batch of matrices with the same pattern, with
+ * several numbers of threads and a memory limit, and compares each result
+ * with umfpack_*_numeric and umfpack_*_solve for that matrix alone. */
+
+static void do_numeric_batch (void)
+{
+    Int n, nz, nb, i, k, p, *Ap, *Ai ;
+    double *Ax, *Az, *Axb, *Azb, *B, *Bz, *X, *Xz, *X1, *X1z, *Info,
+	Control [UMFPACK_CONTROL], Info1 [UMFPACK_INFO], err, xnorm ;
+    void *Symbolic, *Numeric1, *Numeric [4] ;
+    int s, t, nthreads [3] = { 1, 2, 0 } ;
+
+    printf ("\nnumeric batch:\n") ;
+    n = 200 ;
+    nb = 4 ;
+    matgen_band (n, 2, 3, 1, 20, 1, 20, &Ap, &Ai, &Ax, &Az) ;
+    nz = Ap [n] ;
+    UMFPACK_defaults (Control) ;
+
+    s = UMFPACK_symbolic (n, n, Ap, Ai, CARG (Ax, Az), &Symbolic, Control,
+	DNULL) ;
+    if (s != UMFPACK_OK) error ("batch symbolic", (double) s) ;
+
+    Axb  = (double *) malloc (nb * nz * sizeof (double)) ;
+    Azb  = (double *) malloc (nb * nz * sizeof (double)) ;
+    B    = (double *) malloc (nb * n * sizeof (double)) ;
+    Bz   = (double *) malloc (nb * n * sizeof (double)) ;
+    X    = (double *) malloc (nb * n * sizeof (double)) ;
+    Xz   = (double *) malloc (nb * n * sizeof (double)) ;
+    X1   = (double *) malloc (n * sizeof (double)) ;
+    X1z  = (double *) malloc (n * sizeof (double)) ;
+    Info = (double *) malloc (nb * UMFPACK_INFO * sizeof (double)) ;
+    if (!Axb || !Azb || !B || !Bz || !X || !Xz || !X1 || !X1z || !Info)
+    {
+	error ("out of memory (batch)", 0.) ;
+    }
+
+    /* A_k = A + (k+1) I, and b_k = 1:n + k */
+    for (k = 0 ; k < nb ; k++)
+    {
+	for (p = 0 ; p < nz ; p++)
+	{
+	    Axb [k*nz + p] = Ax [p] ;
+	    Azb [k*nz + p] = (Az != DNULL) ? Az [p] : 0 ;
+	}
+	for (i = 0 ; i < n ; i++)
+	{
+	    for (p = Ap [i] ; p < Ap [i+1] ; p++)
+	    {
+		if (Ai [p] == i) Axb [k*nz + p] += k + 1 ;
+	    }
+	    B [k*n + i] = i + 1 + k ;
+	    Bz [k*n + i] = (double) (k - i) / n ;
+	}
+    }
+
+    for (t = 0 ; t < 3 ; t++)
+    {
+	for (k = 0 ; k < nb ; k++) Numeric [k] = (void *) NULL ;
+	/* with t = 2, the default number of threads, but a memory limit of
+	 * one byte, so the matrices are factorized one at a time */
+	s = UMFPACK_numeric_batch (nb, Ap, Ai, CARG (Axb, Azb), Symbolic,
+	    Numeric, CARG (X, Xz), CARG (B, Bz), nthreads [t],
+	    (t == 2) ? 1 : 0, Control, Info) ;
+	if (s != UMFPACK_OK) error ("batch numeric", (double) s) ;
+
+	for (k = 0 ; k < nb ; k++)
+	{
+	    if (Info [k*UMFPACK_INFO + UMFPACK_STATUS] != UMFPACK_OK)
+	    {
+		error ("batch status", (double) k) ;
+	    }
+
+	    /* the same matrix, factorized and solved on its own */
+	    s = UMFPACK_numeric (Ap, Ai, CARG (Axb + k*nz, Azb + k*nz),
+		Symbolic, &Numeric1, Control, Info1) ;
+	    if (s != UMFPACK_OK) error ("batch numeric (1)", (double) s) ;
+	    s = UMFPACK_solve (UMFPACK_A, Ap, Ai,
+		CARG (Axb + k*nz, Azb + k*nz), CARG (X1, X1z),
+		CARG (B + k*n, Bz + k*n), Numeric1, Control, Info1) ;
+	    if (s != UMFPACK_OK) error ("batch solve (1)", (double) s) ;
+	    if (Info [k*UMFPACK_INFO + UMFPACK_LNZ] != Info1 [UMFPACK_LNZ] ||
+		Info [k*UMFPACK_INFO + UMFPACK_UNZ] != Info1 [UMFPACK_UNZ])
+	    {
+		error ("batch factors", (double) k) ;
+	    }
+	    err = 0 ;
+	    xnorm = 0 ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		err = MAX (err, fabs (X [k*n + i] - X1 [i])) ;
+		xnorm = MAX (xnorm, fabs (X1 [i])) ;
+#ifdef COMPLEX
+		err = MAX (err, fabs (Xz [k*n + i] - X1z [i])) ;
+		xnorm = MAX (xnorm, fabs (X1z [i])) ;
+#endif
+	    }
+	    if (err > 1e-12 * xnorm) error ("batch solution", err) ;
+
+	    /* the returned Numeric object gives the same solution */
+	    s = UMFPACK_solve (UMFPACK_A, Ap, Ai,
+		CARG (Axb + k*nz, Azb + k*nz), CARG (X1, X1z),
+		CARG (B + k*n, Bz + k*n), Numeric [k], Control, Info1) ;
+	    if (s != UMFPACK_OK) error ("batch solve (2)", (double) s) ;
+	    for (i = 0 ; i < n ; i++)
+	    {
+		if (X [k*n + i] != X1 [i]) error ("batch Numeric", (double) i) ;
+	    }
+	    UMFPACK_free_numeric (&Numeric1) ;
+	    UMFPACK_free_numeric (&Numeric [k]) ;
+	}
+	printf ("batch nthreads %d: ok\n", nthreads [t]) ;
+    }
+
+    /* solve only, without returning the Numeric objects */
+    s = UMFPACK_numeric_batch (nb, Ap, Ai, CARG (Axb, Azb), Symbolic,
+	(void **) NULL, CARG (X, Xz), CARG (B, Bz), 2, 0,
+	Control, DNULL) ;
+    if (s != UMFPACK_OK) error ("batch no Numeric", (double) s) ;
+
+    /* error handling */
+    s = UMFPACK_numeric_batch (-1, Ap, Ai, CARG (Axb, Azb), Symbolic,
+	Numeric, CARG (X, Xz), CARG (B, Bz), 1, 0, Control, Info) ;
+    if (s != UMFPACK_ERROR_n_nonpositive) error ("batch nbatch", (double) s) ;
+    s = UMFPACK_numeric_batch (nb, Ap, Ai, CARG (DNULL, DNULL), Symbolic,
+	Numeric, CARG (X, Xz), CARG (B, Bz), 1, 0, Control, Info) ;
+    if (s != UMFPACK_ERROR_argument_missing) error ("batch Ax", (double) s) ;
+    s = UMFPACK_numeric_batch (nb, Ap, Ai, CARG (Axb, Azb), Symbolic,
+	Numeric, CARG (X, Xz), CARG (DNULL, DNULL), 1, 0, Control, Info) ;
+    if (s != UMFPACK_ERROR_argument_missing) error ("batch B", (double) s) ;
+    s = UMFPACK_numeric_batch (nb, Ap, Ai, CARG (Axb, Azb), (void *) NULL,
+	Numeric, CARG (X, Xz), CARG (B, Bz), 1, 0, Control, Info) ;
+    if (s != UMFPACK_ERROR_invalid_Symbolic_object)
+    {
+	error ("batch Symbolic", (double) s) ;
+    }
+
+    UMFPACK_free_symbolic (&Symbolic) ;
+    free (Ap) ;
+    free (Ai) ;
+    free (Ax) ;
+    free (Az) ;
+    free (Axb) ;
+    free (Azb) ;
+    free (B) ;
+    free (Bz) ;
+    free (X) ;
+    free (Xz) ;
+    free (X1) ;
+    free (X1z) ;
+    free (Info) ;
+
+#if defined (UMF_MALLOC_COUNT) || !defined (NDEBUG)
+    if (UMF_malloc_count != 0) error ("batch memory leak", 0.) ;
+#endif
+}
+
 /* ========================================================================== */
 /* main */
 /* ========================================================================== */
@@ -5060,6 +5853,13 @@ int main (int argc, char **argv)
 	error ("load numeric failed (2)\n", 0.) ;
     }
 
+#if defined (DINT) || defined (DLONG)
+    do_single ( ) ;
+#endif
+    do_profile ( ) ;
+    do_solve_sparse ( ) ;
+    do_numeric_batch ( ) ;
+
     /* ---------------------------------------------------------------------- */
     /* reset rand ( ) */
     /* ---------------------------------------------------------------------- */